@@ -0,0 +1,300 @@
+import 'dart:convert';
+import 'dart:ffi';
+import 'dart:io';
+import 'dart:math' as math;
+
+import 'package:floating_palette/floating_palette.dart';
+import 'package:flutter/widgets.dart';
+
+import '../palette_setup.dart';
+
+/// End-to-end latency harness for the Windows example app.
+///
+/// Measures what users feel, from input to the composed frame on screen:
+///
+/// - `hotkeyToFirstPixel`: Shift+Win+Space injected → Spotlight visible.
+/// - `createToVisible`: show() on a cooled-down palette → visible.
+/// - `resizeToPresent`: resize() → the window at its new size on screen.
+/// - `dragInputToPhoton`: a mouse move during a drag → the window at its
+///   new position on screen.
+///
+/// Run on one monitor with nothing else in front of the app:
+///
+/// ```bash
+/// flutter run -d windows --release -a --latency-bench \
+///     -a --latency-bench-out=latency.json
+/// ```
+///
+/// The runner (windows/runner/latency_probe.cpp) injects the input and
+/// watches the windows from a background thread; both sides timestamp
+/// with the QueryPerformanceCounter clock behind
+/// `FloatingPalette_GetCurrentTime`. "On screen" is the DWM estimate for
+/// the composition after the change: the next vblank plus one refresh
+/// period (`DwmGetCompositionTimingInfo`).
+class LatencyBench {
+  LatencyBench({this.iterations = 20});
+
+  /// Samples per scenario (drag: moves in one drag).
+  final int iterations;
+
+  final _probe = _LatencyProbe();
+
+  static const _timeout = 2.0;
+
+  /// Run every scenario and return the report.
+  Future<Map<String, Object>> run() async {
+    final palette = Palettes.spotlight;
+    final results = <LatencySummary>[];
+
+    await palette.warmUp();
+    results.add(await _measure('hotkeyToFirstPixel', () async {
+      if (!_probe.watchForNewWindow(_timeout)) return null;
+      final injected = _probe.injectHotkey();
+      final visible = await _probe.result();
+      return _sinceInput(injected, visible);
+    }, after: () => palette.hide(animate: false)));
+
+    results.add(await _measure('createToVisible', () async {
+      await palette.coolDown();
+      if (!_probe.watchForNewWindow(_timeout)) return null;
+      final start = _probe.currentTime();
+      await palette.show(
+        position: PalettePosition.centerScreen(yOffset: -100),
+        animate: false,
+      );
+      final visible = await _probe.result();
+      return _sinceInput(start, visible);
+    }, after: () => palette.hide(animate: false)));
+
+    await palette.show(
+      position: PalettePosition.centerScreen(yOffset: -100),
+      animate: false,
+    );
+    var wide = false;
+    results.add(await _measure('resizeToPresent', () async {
+      final point = await _physicalPoint(palette, top: false);
+      if (!_probe.watchResize(point.x, point.y, _timeout)) return null;
+      wide = !wide;
+      final start = _probe.currentTime();
+      await palette.resize(width: wide ? 700 : 640);
+      final resized = await _probe.result();
+      return _sinceInput(start, resized);
+    }));
+
+    results.add(await _measureDrag(palette));
+    await palette.hide(animate: false);
+
+    return {
+      'context': {
+        'date': DateTime.now().toIso8601String(),
+        'iterations': iterations,
+        'refreshPeriodMs': _probe.refreshPeriod() * 1000,
+        'devicePixelRatio': _devicePixelRatio,
+        'buildMode': kReleaseMode ? 'release' : 'debug',
+      },
+      'results': [for (final r in results) r.toJson()],
+    };
+  }
+
+  Future<LatencySummary> _measure(
+    String name,
+    Future<double?> Function() sample, {
+    Future<void> Function()? after,
+  }) async {
+    final samples = <double>[];
+    var failures = 0;
+    for (var i = 0; i < iterations; i++) {
+      final seconds = await sample();
+      if (seconds == null) {
+        failures++;
+      } else {
+        samples.add(seconds * 1000);
+      }
+      await after?.call();
+      // Let the previous frame settle so samples don't overlap.
+      await Future<void>.delayed(const Duration(milliseconds: 150));
+    }
+    return LatencySummary.fromSamples(name, samples, failures: failures);
+  }
+
+  Future<LatencySummary> _measureDrag(PaletteController palette) async {
+    final point = await _physicalPoint(palette, top: true);
+    if (!_probe.startDrag(point.x, point.y, iterations, 8, _timeout * 4)) {
+      return LatencySummary.fromSamples('dragInputToPhoton', const [],
+          failures: iterations);
+    }
+    await _probe.result();
+    final samples = [
+      for (var i = 0; i < _probe.dragSampleCount(); i++)
+        _probe.dragSample(i) * 1000,
+    ];
+    return LatencySummary.fromSamples('dragInputToPhoton', samples,
+        failures: iterations - samples.length);
+  }
+
+  /// Input → photon, or null if the watch timed out.
+  double? _sinceInput(double start, double changed) {
+    if (changed <= 0) return null;
+    return _probe.photonTimeAfter(changed) - start;
+  }
+
+  /// A point inside the palette, in physical screen pixels: near the top
+  /// edge (where a drag starts) or at the center.
+  Future<({int x, int y})> _physicalPoint(
+    PaletteController palette, {
+    required bool top,
+  }) async {
+    final bounds = await palette.bounds;
+    final ratio = _devicePixelRatio;
+    final y = top ? bounds.top + 12 : bounds.center.dy;
+    return (
+      x: (bounds.center.dx * ratio).round(),
+      y: (y * ratio).round(),
+    );
+  }
+
+  double get _devicePixelRatio =>
+      WidgetsBinding.instance.platformDispatcher.views.first.devicePixelRatio;
+}
+
+/// Percentiles of one scenario's samples, in milliseconds.
+class LatencySummary {
+  LatencySummary({
+    required this.name,
+    required this.samples,
+    required this.failures,
+    required this.mean,
+    required this.p50,
+    required this.p90,
+    required this.p99,
+    required this.max,
+  });
+
+  factory LatencySummary.fromSamples(
+    String name,
+    List<double> samples, {
+    int failures = 0,
+  }) {
+    final sorted = [...samples]..sort();
+    double percentile(double p) {
+      if (sorted.isEmpty) return 0;
+      final index = (p * (sorted.length - 1)).round();
+      return sorted[index];
+    }
+
+    return LatencySummary(
+      name: name,
+      samples: sorted.length,
+      failures: failures,
+      mean: sorted.isEmpty
+          ? 0
+          : sorted.reduce((a, b) => a + b) / sorted.length,
+      p50: percentile(0.5),
+      p90: percentile(0.9),
+      p99: percentile(0.99),
+      max: sorted.isEmpty ? 0 : sorted.last,
+    );
+  }
+
+  final String name;
+  final int samples;
+
+  /// Iterations whose change never showed up within the timeout.
+  final int failures;
+  final double mean;
+  final double p50;
+  final double p90;
+  final double p99;
+  final double max;
+
+  Map<String, Object> toJson() => {
+        'name': name,
+        'unit': 'ms',
+        'samples': samples,
+        'failures': failures,
+        'mean': mean,
+        'p50': p50,
+        'p90': p90,
+        'p99': p99,
+        'max': max,
+      };
+}
+
+/// Run the harness if `--latency-bench` is in [args]: print the JSON report,
+/// write it to `--latency-bench-out=<path>` if given, and exit.
+Future<bool> maybeRunLatencyBench(List<String> args) async {
+  if (!Platform.isWindows || !args.contains('--latency-bench')) return false;
+
+  // Start from a shown, idle main window.
+  await WidgetsBinding.instance.endOfFrame;
+  await Future<void>.delayed(const Duration(seconds: 1));
+
+  final report = await LatencyBench().run();
+  final json = const JsonEncoder.withIndent('  ').convert(report);
+  stdout.writeln(json);
+  const outFlag = '--latency-bench-out=';
+  for (final arg in args) {
+    if (arg.startsWith(outFlag)) {
+      File(arg.substring(outFlag.length)).writeAsStringSync(json);
+    }
+  }
+  exit(0);
+}
+
+typedef _NowNative = Double Function();
+typedef _NowDart = double Function();
+typedef _WatchNative = Bool Function(Double);
+typedef _WatchDart = bool Function(double);
+typedef _WatchAtNative = Bool Function(Int32, Int32, Double);
+typedef _WatchAtDart = bool Function(int, int, double);
+typedef _DragNative = Bool Function(Int32, Int32, Int32, Int32, Double);
+typedef _DragDart = bool Function(int, int, int, int, double);
+typedef _PhotonNative = Double Function(Double);
+typedef _PhotonDart = double Function(double);
+typedef _CountNative = Int32 Function();
+typedef _CountDart = int Function();
+typedef _SampleNative = Double Function(Int32);
+typedef _SampleDart = double Function(int);
+
+/// Bindings to the runner's LatencyProbe_* exports, plus the plugin's
+/// clock they share.
+class _LatencyProbe {
+  _LatencyProbe()
+      : _exe = DynamicLibrary.executable(),
+        _plugin = DynamicLibrary.open('floating_palette_plugin.dll');
+
+  final DynamicLibrary _exe;
+  final DynamicLibrary _plugin;
+
+  late final currentTime = _plugin
+      .lookupFunction<_NowNative, _NowDart>('FloatingPalette_GetCurrentTime');
+  late final injectHotkey = _exe
+      .lookupFunction<_NowNative, _NowDart>('LatencyProbe_InjectHotkey');
+  late final refreshPeriod = _exe
+      .lookupFunction<_NowNative, _NowDart>('LatencyProbe_RefreshPeriod');
+  late final photonTimeAfter = _exe.lookupFunction<_PhotonNative,
+      _PhotonDart>('LatencyProbe_PhotonTimeAfter');
+  late final watchForNewWindow = _exe.lookupFunction<_WatchNative,
+      _WatchDart>('LatencyProbe_WatchForNewWindow');
+  late final watchResize = _exe.lookupFunction<_WatchAtNative,
+      _WatchAtDart>('LatencyProbe_WatchResize');
+  late final startDrag =
+      _exe.lookupFunction<_DragNative, _DragDart>('LatencyProbe_StartDrag');
+  late final _result =
+      _exe.lookupFunction<_NowNative, _NowDart>('LatencyProbe_Result');
+  late final dragSampleCount = _exe.lookupFunction<_CountNative,
+      _CountDart>('LatencyProbe_DragSampleCount');
+  late final dragSample = _exe
+      .lookupFunction<_SampleNative, _SampleDart>('LatencyProbe_DragSample');
+
+  /// Wait for the running watch without blocking the isolate: the palette
+  /// commands it is timing still need their replies.
+  Future<double> result() async {
+    var value = _result();
+    while (value < 0) {
+      await Future<void>.delayed(const Duration(milliseconds: 1));
+      value = _result();
+    }
+    return math.max(value, 0);
+  }
+}
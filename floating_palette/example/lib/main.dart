@@ -7,13 +7,14 @@ import 'examples/notion/notion_screen.dart';
 import 'examples/glass/glass_demo_screen.dart';
 import 'examples/chat/chat_screen.dart';
 import 'examples/clock/clock_screen.dart';
+import 'bench/latency_bench.dart';
 import 'palette_setup.dart';
 import 'theme/brand.dart';
 
 // Export for native to find paletteMain entry point (defined in palette_setup.g.dart)
 export 'palette_setup.dart';
 
-void main() async {
+void main(List<String> args) async {
   WidgetsFlutterBinding.ensureInitialized();
 
   // Initialize PaletteHost - events are auto-registered from @FloatingPaletteApp
@@ -29,6 +30,9 @@ void main() async {
   await _setupSpotlightHotkey();
 
   runApp(const ExampleApp());
+
+  // `flutter run -d windows -a --latency-bench`: see bench/latency_bench.dart.
+  await maybeRunLatencyBench(args);
 }
 
 /// Register Shift+Cmd+Space as global hotkey for Spotlight.
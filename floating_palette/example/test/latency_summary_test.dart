@@ -0,0 +1,40 @@
+import 'package:flutter_test/flutter_test.dart';
+
+import 'package:example/bench/latency_bench.dart';
+
+void main() {
+  group('LatencySummary', () {
+    test('sorts samples and picks percentiles by rounded rank', () {
+      final summary = LatencySummary.fromSamples(
+        'drag',
+        [for (var i = 100; i >= 1; i--) i.toDouble()],
+        failures: 2,
+      );
+
+      expect(summary.samples, 100);
+      expect(summary.failures, 2);
+      expect(summary.p50, 51);
+      expect(summary.p90, 90);
+      expect(summary.p99, 99);
+      expect(summary.max, 100);
+      expect(summary.mean, closeTo(50.5, 1e-9));
+    });
+
+    test('reports zeros when nothing was measured', () {
+      final summary =
+          LatencySummary.fromSamples('hotkey', const [], failures: 20);
+
+      expect(summary.toJson(), {
+        'name': 'hotkey',
+        'unit': 'ms',
+        'samples': 0,
+        'failures': 20,
+        'mean': 0.0,
+        'p50': 0.0,
+        'p90': 0.0,
+        'p99': 0.0,
+        'max': 0.0,
+      });
+    });
+  });
+}
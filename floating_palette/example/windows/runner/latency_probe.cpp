@@ -0,0 +1,289 @@
+#include "latency_probe.h"
+
+#include <dwmapi.h>
+#include <windows.h>
+
+#include <atomic>
+#include <cmath>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Longest a single drag move may take to show up before it is dropped.
+constexpr double kMoveTimeout = 0.25;
+// Moves allowed to get past the palette's pan slop before the window must
+// start following.
+constexpr int kSlopMoves = 12;
+
+struct Probe {
+  std::thread thread;
+  std::atomic<double> result{0};
+  // Written by the probe thread before |result| is published.
+  std::vector<double> drag_samples;
+};
+
+// Seconds on the FloatingPalette_GetCurrentTime clock.
+double Now() {
+  static const double frequency = [] {
+    LARGE_INTEGER freq;
+    ::QueryPerformanceFrequency(&freq);
+    return static_cast<double>(freq.QuadPart);
+  }();
+  LARGE_INTEGER counter;
+  ::QueryPerformanceCounter(&counter);
+  return static_cast<double>(counter.QuadPart) / frequency;
+}
+
+Probe& GetProbe() {
+  static Probe* probe = new Probe();
+  return *probe;
+}
+
+bool IsShown(HWND hwnd) {
+  if (!::IsWindowVisible(hwnd)) {
+    return false;
+  }
+  BOOL cloaked = FALSE;
+  if (SUCCEEDED(::DwmGetWindowAttribute(hwnd, DWMWA_CLOAKED, &cloaked,
+                                        sizeof(cloaked))) &&
+      cloaked) {
+    return false;
+  }
+  return true;
+}
+
+bool IsOwnWindow(HWND hwnd) {
+  DWORD process_id = 0;
+  ::GetWindowThreadProcessId(hwnd, &process_id);
+  return process_id == ::GetCurrentProcessId();
+}
+
+std::set<HWND> ShownWindows() {
+  std::set<HWND> windows;
+  ::EnumWindows(
+      [](HWND hwnd, LPARAM param) -> BOOL {
+        if (IsOwnWindow(hwnd) && IsShown(hwnd)) {
+          reinterpret_cast<std::set<HWND>*>(param)->insert(hwnd);
+        }
+        return TRUE;
+      },
+      reinterpret_cast<LPARAM>(&windows));
+  return windows;
+}
+
+HWND OwnWindowAt(int32_t x, int32_t y) {
+  HWND hwnd = ::WindowFromPoint(POINT{x, y});
+  hwnd = hwnd ? ::GetAncestor(hwnd, GA_ROOT) : nullptr;
+  return hwnd && IsOwnWindow(hwnd) ? hwnd : nullptr;
+}
+
+RECT WindowRect(HWND hwnd) {
+  RECT rect = {};
+  ::GetWindowRect(hwnd, &rect);
+  return rect;
+}
+
+// Runs |body| on the probe thread; false if a watch is still running.
+template <typename Body>
+bool StartWatch(Body body) {
+  Probe& probe = GetProbe();
+  if (probe.thread.joinable()) {
+    if (probe.result.load() < 0) {
+      return false;
+    }
+    probe.thread.join();
+  }
+  probe.result.store(-1);
+  probe.thread = std::thread([body, &probe] {
+    double result = body();
+    probe.result.store(result, std::memory_order_release);
+  });
+  return true;
+}
+
+void SendMouse(DWORD flags, int32_t x = 0, int32_t y = 0) {
+  INPUT input = {};
+  input.type = INPUT_MOUSE;
+  input.mi.dwFlags = flags;
+  if (flags & MOUSEEVENTF_ABSOLUTE) {
+    // Absolute coordinates are normalized to 0..65535 over the virtual
+    // desktop; relative moves would go through pointer acceleration.
+    int left = ::GetSystemMetrics(SM_XVIRTUALSCREEN);
+    int top = ::GetSystemMetrics(SM_YVIRTUALSCREEN);
+    int width = ::GetSystemMetrics(SM_CXVIRTUALSCREEN);
+    int height = ::GetSystemMetrics(SM_CYVIRTUALSCREEN);
+    input.mi.dx = ::MulDiv(x - left, 65535, width - 1);
+    input.mi.dy = ::MulDiv(y - top, 65535, height - 1);
+    input.mi.dwFlags |= MOUSEEVENTF_VIRTUALDESK;
+  }
+  ::SendInput(1, &input, sizeof(input));
+}
+
+void MoveTo(int32_t x, int32_t y) {
+  SendMouse(MOUSEEVENTF_MOVE | MOUSEEVENTF_ABSOLUTE, x, y);
+}
+
+// Spins until the window's left edge differs from |left|; the time it did,
+// or 0 after |timeout| seconds.
+double WaitForMove(HWND hwnd, LONG left, double timeout) {
+  double deadline = Now() + timeout;
+  while (Now() < deadline) {
+    if (WindowRect(hwnd).left != left) {
+      return Now();
+    }
+    ::Sleep(0);
+  }
+  return 0;
+}
+
+}  // namespace
+
+double LatencyProbe_InjectHotkey(void) {
+  INPUT inputs[6] = {};
+  const WORD keys[3] = {VK_SHIFT, VK_LWIN, VK_SPACE};
+  for (int i = 0; i < 3; ++i) {
+    inputs[i].type = INPUT_KEYBOARD;
+    inputs[i].ki.wVk = keys[i];
+    inputs[5 - i].type = INPUT_KEYBOARD;
+    inputs[5 - i].ki.wVk = keys[i];
+    inputs[5 - i].ki.dwFlags = KEYEVENTF_KEYUP;
+  }
+  double now = Now();
+  ::SendInput(6, inputs, sizeof(INPUT));
+  return now;
+}
+
+double LatencyProbe_PhotonTimeAfter(double seconds) {
+  DWM_TIMING_INFO timing = {};
+  timing.cbSize = sizeof(timing);
+  LARGE_INTEGER frequency;
+  ::QueryPerformanceFrequency(&frequency);
+  if (FAILED(::DwmGetCompositionTimingInfo(nullptr, &timing)) ||
+      timing.qpcRefreshPeriod == 0) {
+    return seconds;
+  }
+  double freq = static_cast<double>(frequency.QuadPart);
+  double vblank = static_cast<double>(timing.qpcVBlank) / freq;
+  double period = static_cast<double>(timing.qpcRefreshPeriod) / freq;
+  double frames = std::ceil((seconds - vblank) / period);
+  if (frames < 0) {
+    frames = 0;
+  }
+  return vblank + (frames + 1) * period;
+}
+
+double LatencyProbe_RefreshPeriod(void) {
+  DWM_TIMING_INFO timing = {};
+  timing.cbSize = sizeof(timing);
+  LARGE_INTEGER frequency;
+  ::QueryPerformanceFrequency(&frequency);
+  if (FAILED(::DwmGetCompositionTimingInfo(nullptr, &timing))) {
+    return 0;
+  }
+  return static_cast<double>(timing.qpcRefreshPeriod) /
+         static_cast<double>(frequency.QuadPart);
+}
+
+bool LatencyProbe_WatchForNewWindow(double timeout) {
+  std::set<HWND> before = ShownWindows();
+  return StartWatch([before, timeout] {
+    double deadline = Now() + timeout;
+    while (Now() < deadline) {
+      for (HWND hwnd : ShownWindows()) {
+        if (!before.count(hwnd)) {
+          return Now();
+        }
+      }
+      ::Sleep(0);
+    }
+    return 0.0;
+  });
+}
+
+bool LatencyProbe_WatchResize(int32_t x, int32_t y, double timeout) {
+  HWND hwnd = OwnWindowAt(x, y);
+  if (!hwnd) {
+    return false;
+  }
+  RECT before = WindowRect(hwnd);
+  return StartWatch([hwnd, before, timeout] {
+    double deadline = Now() + timeout;
+    while (Now() < deadline) {
+      RECT rect = WindowRect(hwnd);
+      if (rect.right - rect.left != before.right - before.left ||
+          rect.bottom - rect.top != before.bottom - before.top) {
+        return Now();
+      }
+      ::Sleep(0);
+    }
+    return 0.0;
+  });
+}
+
+bool LatencyProbe_StartDrag(int32_t x, int32_t y, int32_t moves,
+                            int32_t step, double timeout) {
+  HWND hwnd = OwnWindowAt(x, y);
+  if (!hwnd || moves <= 0 || step <= 0) {
+    return false;
+  }
+  return StartWatch([hwnd, x, y, moves, step, timeout] {
+    Probe& probe = GetProbe();
+    probe.drag_samples.clear();
+    double deadline = Now() + timeout;
+
+    MoveTo(x, y);
+    SendMouse(MOUSEEVENTF_LEFTDOWN);
+
+    // Push past the palette's pan slop until its drag loop has the window.
+    int32_t cursor_x = x;
+    bool engaged = false;
+    for (int i = 0; i < kSlopMoves && !engaged; ++i) {
+      LONG left = WindowRect(hwnd).left;
+      cursor_x += step;
+      MoveTo(cursor_x, y);
+      engaged = WaitForMove(hwnd, left, 0.05) != 0;
+    }
+
+    // Alternate direction so the window stays where it started.
+    for (int32_t i = 0; engaged && i < moves; ++i) {
+      if (Now() > deadline) {
+        break;
+      }
+      LONG left = WindowRect(hwnd).left;
+      cursor_x += (i % 2 == 0) ? -step : step;
+      double injected = Now();
+      MoveTo(cursor_x, y);
+      double moved = WaitForMove(hwnd, left, kMoveTimeout);
+      if (moved != 0) {
+        probe.drag_samples.push_back(LatencyProbe_PhotonTimeAfter(moved) -
+                                     injected);
+      }
+      // One move per frame, as a hand would; back-to-back moves would be
+      // coalesced by the input queue.
+      ::Sleep(16);
+    }
+
+    SendMouse(MOUSEEVENTF_LEFTUP);
+    return engaged ? Now() : 0.0;
+  });
+}
+
+double LatencyProbe_Result(void) {
+  return GetProbe().result.load(std::memory_order_acquire);
+}
+
+int32_t LatencyProbe_DragSampleCount(void) {
+  if (LatencyProbe_Result() < 0) {
+    return 0;
+  }
+  return static_cast<int32_t>(GetProbe().drag_samples.size());
+}
+
+double LatencyProbe_DragSample(int32_t index) {
+  if (index < 0 || index >= LatencyProbe_DragSampleCount()) {
+    return 0;
+  }
+  return GetProbe().drag_samples[index];
+}
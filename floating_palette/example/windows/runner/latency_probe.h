@@ -0,0 +1,60 @@
+#ifndef RUNNER_LATENCY_PROBE_H_
+#define RUNNER_LATENCY_PROBE_H_
+
+#include <stdint.h>
+
+// Native half of the example app's latency benchmark (lib/bench/).
+//
+// Exported from the runner executable so Dart can bind them with
+// DynamicLibrary.executable(). Every time is in seconds on the same
+// QueryPerformanceCounter clock as FloatingPalette_GetCurrentTime, so
+// timestamps from either side subtract directly.
+//
+// Watches run on a background thread, one at a time: start one, drive the
+// palette from Dart, then poll LatencyProbe_Result().
+
+#define LATENCY_PROBE_EXPORT extern "C" __declspec(dllexport)
+
+// Types the example's Spotlight hotkey (Shift+Win+Space) with SendInput and
+// returns the time just before the key-down was injected.
+LATENCY_PROBE_EXPORT double LatencyProbe_InjectHotkey(void);
+
+// Estimated time the frame composed after |seconds| reaches the display:
+// the first DWM vblank at or after |seconds| starts the composition, which
+// scans out one refresh period later (DwmGetCompositionTimingInfo).
+// Returns |seconds| if DWM timing is unavailable.
+LATENCY_PROBE_EXPORT double LatencyProbe_PhotonTimeAfter(double seconds);
+
+// DWM refresh period in seconds, or 0 if unavailable.
+LATENCY_PROBE_EXPORT double LatencyProbe_RefreshPeriod(void);
+
+// Starts watching for a top-level window of this process that becomes
+// visible and uncloaked and wasn't before. Result: the time it did.
+LATENCY_PROBE_EXPORT bool LatencyProbe_WatchForNewWindow(double timeout);
+
+// Starts watching the top-level window under the physical screen point
+// (|x|, |y|) for a size change. Result: the time its size changed. Returns
+// false if no window of this process is there.
+LATENCY_PROBE_EXPORT bool LatencyProbe_WatchResize(int32_t x,
+                                                   int32_t y,
+                                                   double timeout);
+
+// Presses the left button at the physical screen point (|x|, |y|) and drags
+// the window there |moves| times by |step| pixels, timing each move from
+// injection to the estimated photon time of the composition that shows
+// the window at its new position. Result: the time the drag finished.
+LATENCY_PROBE_EXPORT bool LatencyProbe_StartDrag(int32_t x,
+                                                 int32_t y,
+                                                 int32_t moves,
+                                                 int32_t step,
+                                                 double timeout);
+
+// -1 while the current watch runs, 0 if it timed out or failed, otherwise
+// the time it reports.
+LATENCY_PROBE_EXPORT double LatencyProbe_Result(void);
+
+// Per-move input-to-photon latencies of the last finished drag, seconds.
+LATENCY_PROBE_EXPORT int32_t LatencyProbe_DragSampleCount(void);
+LATENCY_PROBE_EXPORT double LatencyProbe_DragSample(int32_t index);
+
+#endif  // RUNNER_LATENCY_PROBE_H_
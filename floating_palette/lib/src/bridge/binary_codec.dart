@@ -0,0 +1,129 @@
+import 'dart:typed_data';
+
+/// Opcodes of the `floating_palette/binary` channel.
+///
+/// Must stay in sync with windows/core/binary_codec.h.
+abstract final class BinaryOpcode {
+  // Requests. Payloads in logical pixels.
+
+  /// Payload x, y (top-left).
+  static const int setPosition = 1;
+
+  /// Payload width, height.
+  static const int setSize = 2;
+
+  /// Payload x, y, width, height.
+  static const int setBounds = 3;
+
+  /// Reply payload x, y, width, height.
+  static const int getBounds = 4;
+
+  /// Payload property index, to, from.
+  static const int animate = 5;
+
+  /// Payload property index, or [BinaryFlags.allProperties].
+  static const int stopAnimation = 6;
+
+  // Events.
+
+  /// Payload x, y.
+  static const int dragMoved = 0x81;
+
+  /// Arg target handle; payload snap distance, x, y, width, height.
+  static const int followerDragging = 0x82;
+}
+
+/// Request flags. The curve index rides in the high byte ([curve]).
+abstract final class BinaryFlags {
+  static const int animate = 1 << 0;
+  static const int hasFrom = 1 << 1;
+  static const int allProperties = 1 << 2;
+
+  /// Curve indices, matching native AnimationCurve.
+  static const _curves = {
+    'linear': 0,
+    'easeOut': 1,
+    'easeOutCubic': 2,
+    'easeInOut': 3,
+    'easeIn': 4,
+  };
+
+  /// Flags bits for the curve named [name], or null if native has no
+  /// index for it.
+  static int? curve(String name) {
+    final index = _curves[name];
+    return index == null ? null : index << 8;
+  }
+}
+
+/// Reply status, in [BinaryMessage.flags].
+abstract final class BinaryStatus {
+  static const int ok = 0;
+  static const int notFound = 1;
+  static const int invalidParams = 2;
+  static const int unknownOpcode = 3;
+}
+
+/// One fixed-layout message of the `floating_palette/binary` channel.
+///
+/// Every message is [size] bytes, little-endian: opcode (u16), flags (u16),
+/// window handle (i32), arg (i32), then six float32 of payload.
+class BinaryMessage {
+  /// Encoded size of every message.
+  static const int size = 36;
+
+  /// Number of float32 payload slots.
+  static const int payloadLength = 6;
+
+  final int opcode;
+
+  /// Request options, or a [BinaryStatus] in a reply.
+  final int flags;
+
+  /// Native window handle (see `frame/bindBinary`).
+  final int handle;
+
+  /// Duration in ms, or a second window handle.
+  final int arg;
+
+  /// Payload values; missing trailing slots encode as 0.
+  final List<double> payload;
+
+  const BinaryMessage({
+    required this.opcode,
+    required this.handle,
+    this.flags = 0,
+    this.arg = 0,
+    this.payload = const [],
+  });
+
+  /// Decode [data]; null unless it is exactly one message.
+  static BinaryMessage? decode(ByteData data) {
+    if (data.lengthInBytes != size) return null;
+    return BinaryMessage(
+      opcode: data.getUint16(0, Endian.little),
+      flags: data.getUint16(2, Endian.little),
+      handle: data.getInt32(4, Endian.little),
+      arg: data.getInt32(8, Endian.little),
+      payload: [
+        for (var i = 0; i < payloadLength; i++)
+          data.getFloat32(12 + i * 4, Endian.little),
+      ],
+    );
+  }
+
+  ByteData encode() {
+    assert(payload.length <= payloadLength);
+    final data = ByteData(size)
+      ..setUint16(0, opcode, Endian.little)
+      ..setUint16(2, flags, Endian.little)
+      ..setInt32(4, handle, Endian.little)
+      ..setInt32(8, arg, Endian.little);
+    for (var i = 0; i < payload.length; i++) {
+      data.setFloat32(12 + i * 4, payload[i], Endian.little);
+    }
+    return data;
+  }
+
+  bool get ok => flags == BinaryStatus.ok;
+}
@@ -1,7 +1,9 @@
 /// Bridge layer for native communication.
 library;
 
+export 'binary_codec.dart';
 export 'command.dart';
 export 'event.dart';
 export 'native_bridge.dart';
+export 'read_only_queries.dart';
 export 'service_client.dart';
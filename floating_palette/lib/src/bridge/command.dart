@@ -26,3 +26,40 @@ class NativeCommand {
         'params': params,
       };
 }
+
+/// Outcome of one command in a [NativeBridge.sendBatch] call.
+///
+/// Each command in a batch succeeds or fails on its own; a failed command
+/// carries the same error code it would have raised when sent alone.
+class NativeBatchResult {
+  /// Whether the command succeeded.
+  final bool ok;
+
+  /// The command's return value (null on failure or for void commands).
+  final Object? value;
+
+  /// Error code when [ok] is false (e.g. `NOT_FOUND`).
+  final String? code;
+
+  /// Error message when [ok] is false.
+  final String? message;
+
+  const NativeBatchResult.success(this.value)
+      : ok = true,
+        code = null,
+        message = null;
+
+  const NativeBatchResult.failure({required String this.code, this.message})
+      : ok = false,
+        value = null;
+
+  factory NativeBatchResult.fromMap(Map<dynamic, dynamic> map) {
+    if (map['ok'] == true) {
+      return NativeBatchResult.success(map['value']);
+    }
+    return NativeBatchResult.failure(
+      code: map['code'] as String? ?? 'UNKNOWN',
+      message: map['message'] as String?,
+    );
+  }
+}
@@ -1,10 +1,13 @@
 import 'dart:async';
+import 'dart:typed_data';
 
 import 'package:flutter/foundation.dart' show debugPrint;
 import 'package:flutter/services.dart';
 
+import 'binary_codec.dart';
 import 'command.dart';
 import 'event.dart';
+import 'read_only_queries.dart';
 
 /// Callback for native events.
 typedef NativeEventCallback = void Function(NativeEvent event);
@@ -26,25 +29,70 @@ class NativeBridge {
   ///
   /// In most cases, you should use [PaletteHost.bridge] instead of
   /// creating your own instance.
+  ///
+  /// [queries] answers read-only commands without the platform thread
+  /// (see [ReadOnlyQueries]); without it every command goes to native.
   NativeBridge({
     String channelName = 'floating_palette',
     this.commandTimeout = const Duration(seconds: 5),
-  }) : _channel = MethodChannel(channelName) {
+    ReadOnlyQueries? queries,
+  }) : _channel = MethodChannel(channelName),
+       _binaryChannelName = '$channelName/binary',
+       _queries = queries {
     _channel.setMethodCallHandler(_handleMethodCall);
+    _channel.binaryMessenger
+        .setMessageHandler(_binaryChannelName, _handleBinaryMessage);
   }
 
+  /// Fixed-layout channel for frame, animation and drag traffic
+  /// (see [BinaryMessage]).
+  final String _binaryChannelName;
+
+  final ReadOnlyQueries? _queries;
+
+  /// Commands sent and not yet answered, by target window (null for
+  /// commands without one, batches included). A read-only query for a
+  /// window with one of these in flight goes through the channel behind
+  /// it, so it still observes that command's effect.
+  final _inFlight = <String?, int>{};
+
+  /// Whether read-only commands are answered locally when they can be, so
+  /// sending them is cheaper than any channel (binary included).
+  bool get answersQueriesLocally => _queries != null;
+
   /// Event callbacks by service name.
   final _eventCallbacks = <String, List<NativeEventCallback>>{};
 
   /// Global event callbacks (receive all events).
   final _globalCallbacks = <NativeEventCallback>[];
 
+  /// Listener count per declared interest, and the interests each callback
+  /// declared, so native is told only about the first and last listener.
+  final _interestCounts = <_EventInterest, int>{};
+  final _callbackInterests = <NativeEventCallback, List<_EventInterest>>{};
+
+  /// Windows bound to the binary channel, both ways, and whether the
+  /// platform turned out not to have one.
+  final _binaryHandles = <String, int>{};
+  final _binaryIds = <int, String>{};
+  bool _binaryUnavailable = false;
+
   // ════════════════════════════════════════════════════════════════════════
   // Commands
   // ════════════════════════════════════════════════════════════════════════
 
   /// Send a command to native.
+  ///
+  /// Read-only commands ([ReadOnlyQueries.isReadOnly]) are answered without
+  /// the channel when this bridge has [ReadOnlyQueries] that can serve them.
   Future<T?> send<T>(NativeCommand command) async {
+    final readOnly = ReadOnlyQueries.isReadOnly(command);
+    if (readOnly && _queries != null && !_isBusy(command.windowId)) {
+      if (_queries.answer(command) case final answer?) {
+        return answer.value as T?;
+      }
+    }
+    if (!readOnly) _begin(command.windowId);
     try {
       final result = await _channel.invokeMethod<T>(
         'command',
@@ -71,6 +119,8 @@ class NativeBridge {
         ),
         stackTrace,
       );
+    } finally {
+      if (!readOnly) _end(command.windowId);
     }
   }
 
@@ -80,9 +130,165 @@ class NativeBridge {
     return result?.cast<String, dynamic>();
   }
 
+  /// Send several commands in one platform-channel hop.
+  ///
+  /// Native runs the commands in order within a single platform-thread turn
+  /// and returns one [NativeBatchResult] per command. A failing command does
+  /// not stop the ones after it. Throws [NativeBridgeException] only if the
+  /// batch itself fails (timeout, or a platform without `batch` support).
+  Future<List<NativeBatchResult>> sendBatch(
+    List<NativeCommand> commands,
+  ) async {
+    if (commands.isEmpty) return const [];
+    const batchCommand = NativeCommand(service: 'bridge', command: 'batch');
+    _begin(null);
+    try {
+      final result = await _channel.invokeMethod<List<dynamic>>(
+        'batch',
+        {'commands': [for (final command in commands) command.toMap()]},
+      ).timeout(commandTimeout);
+      return [
+        for (final entry in result ?? const [])
+          NativeBatchResult.fromMap(entry as Map),
+      ];
+    } on TimeoutException catch (e, stackTrace) {
+      Error.throwWithStackTrace(
+        NativeBridgeException(
+          command: batchCommand,
+          message: 'Batch timed out after ${commandTimeout.inSeconds}s',
+          code: 'TIMEOUT',
+          originalException: e,
+        ),
+        stackTrace,
+      );
+    } on PlatformException catch (e, stackTrace) {
+      Error.throwWithStackTrace(
+        NativeBridgeException(
+          command: batchCommand,
+          message: e.message ?? 'Unknown error',
+          code: e.code,
+          originalException: e,
+        ),
+        stackTrace,
+      );
+    } on MissingPluginException catch (e, stackTrace) {
+      Error.throwWithStackTrace(
+        NativeBridgeException(
+          command: batchCommand,
+          message: e.message ?? 'batch not supported',
+          code: 'NOT_IMPLEMENTED',
+          originalException: e,
+        ),
+        stackTrace,
+      );
+    } finally {
+      _end(null);
+    }
+  }
+
   /// Send a command, fire and forget (no result expected).
   void sendFireAndForget(NativeCommand command) {
-    _channel.invokeMethod<void>('command', command.toMap());
+    _begin(command.windowId);
+    _channel
+        .invokeMethod<void>('command', command.toMap())
+        .whenComplete(() => _end(command.windowId));
+  }
+
+  /// Whether a command that may change [windowId]'s state is in flight.
+  /// Window-free queries (the cursor) don't depend on any command.
+  bool _isBusy(String? windowId) =>
+      windowId != null &&
+      (_inFlight.containsKey(null) || _inFlight.containsKey(windowId));
+
+  void _begin(String? windowId) {
+    if (_queries == null) return;
+    _inFlight[windowId] = (_inFlight[windowId] ?? 0) + 1;
+  }
+
+  void _end(String? windowId) {
+    if (_queries == null) return;
+    final count = (_inFlight[windowId] ?? 1) - 1;
+    if (count > 0) {
+      _inFlight[windowId] = count;
+    } else {
+      _inFlight.remove(windowId);
+    }
+  }
+
+  /// Send a fixed-layout request for [windowId] on the binary channel.
+  ///
+  /// Binds the window on first use (`frame/bindBinary`), after which its
+  /// drag and snap-follower updates arrive on the binary channel too and
+  /// are dispatched like any other event. Returns the successful reply, or
+  /// null when the request didn't run there: no binary channel on this
+  /// platform, a window that doesn't exist (any more), or a request native
+  /// rejected. Callers then send the equivalent command, which reports
+  /// errors the usual way.
+  Future<BinaryMessage?> sendBinary(
+    String windowId,
+    int opcode, {
+    int flags = 0,
+    int arg = 0,
+    List<double> payload = const [],
+  }) async {
+    if (_binaryUnavailable) return null;
+    final handle = _binaryHandles[windowId] ?? await _bindBinary(windowId);
+    if (handle == null) return null;
+
+    final request = BinaryMessage(
+      opcode: opcode,
+      handle: handle,
+      flags: flags,
+      arg: arg,
+      payload: payload,
+    );
+    final ByteData? data;
+    _begin(windowId);
+    try {
+      data = await _channel.binaryMessenger
+          .send(_binaryChannelName, request.encode())
+          .timeout(commandTimeout);
+    } on TimeoutException {
+      return null;
+    } finally {
+      _end(windowId);
+    }
+    if (data == null) {
+      // Nothing registered the channel.
+      _binaryUnavailable = true;
+      return null;
+    }
+    final reply = BinaryMessage.decode(data);
+    if (reply == null) return null;
+    if (reply.flags == BinaryStatus.notFound) _forgetBinary(windowId);
+    return reply.ok ? reply : null;
+  }
+
+  Future<int?> _bindBinary(String windowId) async {
+    try {
+      final handle = await send<int>(NativeCommand(
+        service: 'frame',
+        command: 'bindBinary',
+        windowId: windowId,
+      ));
+      if (handle == null || handle == 0) return null;
+      _binaryHandles[windowId] = handle;
+      _binaryIds[handle] = windowId;
+      return handle;
+    } on NativeBridgeException catch (e) {
+      if (e.code == 'UNKNOWN_COMMAND' || e.code == 'NOT_IMPLEMENTED') {
+        _binaryUnavailable = true;
+      }
+      return null;
+    } on MissingPluginException {
+      _binaryUnavailable = true;
+      return null;
+    }
+  }
+
+  void _forgetBinary(String windowId) {
+    final handle = _binaryHandles.remove(windowId);
+    if (handle != null) _binaryIds.remove(handle);
   }
 
   // ════════════════════════════════════════════════════════════════════════
@@ -90,23 +296,72 @@ class NativeBridge {
   // ════════════════════════════════════════════════════════════════════════
 
   /// Subscribe to events from a specific service.
-  void subscribe(String service, NativeEventCallback callback) {
+  ///
+  /// [event] and [windowId] narrow what native needs to send for this
+  /// callback (it still receives every event of [service]): once anything
+  /// subscribes, native skips events nobody declared interest in.
+  void subscribe(
+    String service,
+    NativeEventCallback callback, {
+    String? event,
+    String? windowId,
+  }) {
     _eventCallbacks.putIfAbsent(service, () => []).add(callback);
+    _declareInterest(callback, _EventInterest(service, event ?? '*', windowId));
   }
 
   /// Unsubscribe from events.
   void unsubscribe(String service, NativeEventCallback callback) {
-    _eventCallbacks[service]?.remove(callback);
+    if (_eventCallbacks[service]?.remove(callback) ?? false) {
+      _withdrawInterest(callback, service);
+    }
   }
 
   /// Subscribe to all events (global listener).
   void subscribeAll(NativeEventCallback callback) {
     _globalCallbacks.add(callback);
+    _declareInterest(callback, const _EventInterest('*', '*', null));
   }
 
   /// Unsubscribe from all events.
   void unsubscribeAll(NativeEventCallback callback) {
-    _globalCallbacks.remove(callback);
+    if (_globalCallbacks.remove(callback)) _withdrawInterest(callback, '*');
+  }
+
+  void _declareInterest(NativeEventCallback callback, _EventInterest interest) {
+    _callbackInterests.putIfAbsent(callback, () => []).add(interest);
+    final count = _interestCounts[interest] ?? 0;
+    _interestCounts[interest] = count + 1;
+    if (count == 0) _sendInterest('subscribe', interest);
+  }
+
+  void _withdrawInterest(NativeEventCallback callback, String service) {
+    final interests = _callbackInterests[callback];
+    final index = interests?.indexWhere((i) => i.service == service) ?? -1;
+    if (index < 0) return;
+    final interest = interests!.removeAt(index);
+    if (interests.isEmpty) _callbackInterests.remove(callback);
+    final count = (_interestCounts[interest] ?? 1) - 1;
+    if (count > 0) {
+      _interestCounts[interest] = count;
+      return;
+    }
+    _interestCounts.remove(interest);
+    _sendInterest('unsubscribe', interest);
+  }
+
+  /// Best effort: a platform without host/subscribe keeps sending every
+  /// event, which is what the callbacks expect anyway.
+  void _sendInterest(String command, _EventInterest interest) {
+    final message = NativeCommand(
+      service: 'host',
+      command: command,
+      windowId: interest.windowId,
+      params: {'service': interest.service, 'event': interest.event},
+    );
+    _channel
+        .invokeMethod<void>('command', message.toMap())
+        .catchError((Object _) {});
   }
 
   Future<dynamic> _handleMethodCall(MethodCall call) async {
@@ -115,6 +370,51 @@ class NativeBridge {
         Map<String, dynamic>.from(call.arguments as Map),
       );
       _dispatchEvent(event);
+    } else if (call.method == 'events') {
+      // Coalesced delivery: a list of events, in the order native queued them.
+      for (final entry in call.arguments as List) {
+        _dispatchEvent(
+          NativeEvent.fromMap(Map<String, dynamic>.from(entry as Map)),
+        );
+      }
+    }
+    return null;
+  }
+
+  Future<ByteData?> _handleBinaryMessage(ByteData? data) async {
+    final message = data == null ? null : BinaryMessage.decode(data);
+    final event = message == null ? null : _binaryEvent(message);
+    if (event != null) _dispatchEvent(event);
+    return null;
+  }
+
+  /// The event a binary message stands for, shaped like its method-channel
+  /// counterpart; null for unknown opcodes or unbound windows.
+  NativeEvent? _binaryEvent(BinaryMessage message) {
+    final windowId = _binaryIds[message.handle];
+    if (windowId == null) return null;
+    final p = message.payload;
+    switch (message.opcode) {
+      case BinaryOpcode.dragMoved:
+        return NativeEvent(
+          service: 'frame',
+          event: 'moved',
+          windowId: windowId,
+          data: {'x': p[0], 'y': p[1]},
+        );
+      case BinaryOpcode.followerDragging:
+        final targetId = _binaryIds[message.arg];
+        if (targetId == null) return null;
+        return NativeEvent(
+          service: 'snap',
+          event: 'followerDragging',
+          windowId: windowId,
+          data: {
+            'targetId': targetId,
+            'snapDistance': p[0],
+            'frame': {'x': p[1], 'y': p[2], 'width': p[3], 'height': p[4]},
+          },
+        );
     }
     return null;
   }
@@ -148,10 +448,36 @@ class NativeBridge {
   void dispose() {
     _eventCallbacks.clear();
     _globalCallbacks.clear();
+    _interestCounts.clear();
+    _callbackInterests.clear();
+    _binaryHandles.clear();
+    _binaryIds.clear();
+    _inFlight.clear();
     _channel.setMethodCallHandler(null);
+    _channel.binaryMessenger.setMessageHandler(_binaryChannelName, null);
   }
 }
 
+/// A (service, event, window) the bridge told native it listens to.
+/// `'*'` matches any service or event; a null [windowId] any window.
+class _EventInterest {
+  final String service;
+  final String event;
+  final String? windowId;
+
+  const _EventInterest(this.service, this.event, this.windowId);
+
+  @override
+  bool operator ==(Object other) =>
+      other is _EventInterest &&
+      other.service == service &&
+      other.event == event &&
+      other.windowId == windowId;
+
+  @override
+  int get hashCode => Object.hash(service, event, windowId);
+}
+
 /// Exception thrown when a native command fails.
 class NativeBridgeException implements Exception {
   final NativeCommand command;
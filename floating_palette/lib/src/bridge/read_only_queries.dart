@@ -0,0 +1,36 @@
+import 'command.dart';
+
+/// A command result produced without a channel round trip. A record, so
+/// a null result stays distinguishable from "couldn't answer".
+typedef LocalAnswer = ({Object? value});
+
+/// Read-only commands, and a way to answer them off the platform thread.
+///
+/// A read-only command only reports state native already caches (window
+/// frames, visibility, focus, the cursor). Sent as a command it still waits
+/// its turn on the platform thread behind animation ticks, capture setup
+/// and whatever else is in flight. [NativeBridge] first offers these to its
+/// [ReadOnlyQueries], which answers from the same caches over FFI with the
+/// same result shape, so layout code polling them doesn't stall.
+///
+/// Anything [answer] can't serve (unavailable FFI, an unknown window where
+/// the command would fail with `NOT_FOUND`) still goes to native as a
+/// command, so errors surface exactly as before.
+abstract interface class ReadOnlyQueries {
+  /// Read-only commands by service.
+  static const commands = <String, Set<String>>{
+    'frame': {'getBounds'},
+    'visibility': {'isVisible'},
+    'focus': {'isFocused'},
+    'window': {'exists'},
+    'screen': {'getCursorPosition'},
+  };
+
+  /// Whether [command] is read-only.
+  static bool isReadOnly(NativeCommand command) =>
+      commands[command.service]?.contains(command.command) ?? false;
+
+  /// [command]'s result as the channel would return it, or null to send it
+  /// to native instead. Only called for read-only commands.
+  LocalAnswer? answer(NativeCommand command);
+}
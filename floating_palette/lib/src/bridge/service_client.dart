@@ -67,7 +67,7 @@ abstract class ServiceClient {
     }
 
     _subscriptions.add(handler);
-    _bridge.subscribe(serviceName, handler);
+    _bridge.subscribe(serviceName, handler, event: eventName);
   }
 
   /// Subscribe to events for a specific window.
@@ -83,7 +83,12 @@ abstract class ServiceClient {
     }
 
     _subscriptions.add(handler);
-    _bridge.subscribe(serviceName, handler);
+    _bridge.subscribe(
+      serviceName,
+      handler,
+      event: eventName,
+      windowId: windowId,
+    );
   }
 
   /// Clean up all subscriptions.
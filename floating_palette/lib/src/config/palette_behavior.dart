@@ -49,6 +49,15 @@ class PaletteBehavior {
   /// loss. Use for always-on palettes (clocks, status monitors, ambient animations).
   final bool keepAlive;
 
+  /// How long a hidden [keepAlive] palette stays warm before its engine is
+  /// suspended (Windows), or null to never suspend.
+  ///
+  /// Hidden keep-alive palettes stop producing frames right away. Once
+  /// suspended they also release their GPU surfaces and image cache, and
+  /// the next show costs one extra frame. Native reports both transitions
+  /// as the window `suspended` and `resumed` events.
+  final Duration? suspendAfter;
+
   /// What happens to focus when this palette is hidden.
   final FocusRestoreMode onHideFocus;
 
@@ -66,6 +75,9 @@ class PaletteBehavior {
   /// See [PaletteGroup] for built-in groups like [PaletteGroup.menu].
   final PaletteGroup? group;
 
+  /// Default [suspendAfter].
+  static const defaultSuspendAfter = Duration(seconds: 30);
+
   const PaletteBehavior({
     this.hideOnClickOutside = true,
     this.hideOnEscape = true,
@@ -73,6 +85,7 @@ class PaletteBehavior {
     this.focusPolicy = FocusPolicy.steal,
     this.draggable = false,
     this.keepAlive = false,
+    this.suspendAfter = defaultSuspendAfter,
     this.alwaysOnTop = false,
     this.onHideFocus = FocusRestoreMode.mainWindow,
     this.group,
@@ -86,6 +99,7 @@ class PaletteBehavior {
         focusPolicy = FocusPolicy.steal,
         draggable = false,
         keepAlive = false,
+        suspendAfter = defaultSuspendAfter,
         alwaysOnTop = false,
         onHideFocus = FocusRestoreMode.mainWindow,
         group = null;
@@ -98,6 +112,7 @@ class PaletteBehavior {
         focusPolicy = FocusPolicy.none,
         draggable = false,
         keepAlive = false,
+        suspendAfter = defaultSuspendAfter,
         alwaysOnTop = false,
         onHideFocus = FocusRestoreMode.none,
         group = null;
@@ -110,6 +125,7 @@ class PaletteBehavior {
         focusPolicy = FocusPolicy.request,
         draggable = true,
         keepAlive = true,
+        suspendAfter = defaultSuspendAfter,
         alwaysOnTop = false,
         onHideFocus = FocusRestoreMode.none,
         group = null;
@@ -122,6 +138,7 @@ class PaletteBehavior {
         focusPolicy = FocusPolicy.steal,
         draggable = false,
         keepAlive = false,
+        suspendAfter = defaultSuspendAfter,
         alwaysOnTop = false,
         onHideFocus = FocusRestoreMode.previousApp,
         group = null;
@@ -137,6 +154,7 @@ class PaletteBehavior {
         focusPolicy = FocusPolicy.steal,
         draggable = false,
         keepAlive = false,
+        suspendAfter = defaultSuspendAfter,
         alwaysOnTop = false,
         onHideFocus = FocusRestoreMode.mainWindow,
         group = PaletteGroup.menu;
@@ -148,6 +166,7 @@ class PaletteBehavior {
     FocusPolicy? focusPolicy,
     bool? draggable,
     bool? keepAlive,
+    Duration? suspendAfter,
     bool? alwaysOnTop,
     FocusRestoreMode? onHideFocus,
     PaletteGroup? group,
@@ -159,6 +178,7 @@ class PaletteBehavior {
       focusPolicy: focusPolicy ?? this.focusPolicy,
       draggable: draggable ?? this.draggable,
       keepAlive: keepAlive ?? this.keepAlive,
+      suspendAfter: suspendAfter ?? this.suspendAfter,
       alwaysOnTop: alwaysOnTop ?? this.alwaysOnTop,
       onHideFocus: onHideFocus ?? this.onHideFocus,
       group: group ?? this.group,
@@ -172,6 +192,7 @@ class PaletteBehavior {
         'focusPolicy': focusPolicy.name,
         'draggable': draggable,
         'keepAlive': keepAlive,
+        'suspendAfterMs': suspendAfter?.inMilliseconds,
         'alwaysOnTop': alwaysOnTop,
         'onHideFocus': onHideFocus.name,
         'group': group?.name,
@@ -210,6 +210,7 @@ class PaletteController<TArgs> implements PaletteIdentifiable {
         appearance: _config.appearance,
         size: _config.size,
         keepAlive: _config.behavior.keepAlive,
+        suspendAfter: _config.behavior.suspendAfter,
       );
     } catch (e) {
       // Window may already exist after hot restart - that's fine
@@ -312,7 +313,14 @@ class PaletteController<TArgs> implements PaletteIdentifiable {
         await _frame.setSize(id, Size(sz.width, sz.minHeight));
       }
       final pos = position ?? _config.position;
-      await _frame.setPosition(id, await _resolvePosition(pos), anchor: pos.anchor.name);
+      final placed = _positionResolver.place(
+        id,
+        pos,
+        size: sz.resizable ? Size(sz.width, sz.minHeight) : null,
+      );
+      if (!placed) {
+        await _frame.setPosition(id, await _resolvePosition(pos), anchor: pos.anchor.name);
+      }
 
       // Show window
       final effectiveFocus = focus ?? _config.behavior.shouldFocus;
@@ -2,6 +2,7 @@ import 'dart:io' show Platform;
 import 'dart:ui';
 
 import '../config/palette_position.dart';
+import '../ffi/native_bridge.dart' show SyncNativeBridge;
 import '../services/screen_client.dart';
 
 /// Resolves [PalettePosition] to screen coordinates.
@@ -46,4 +47,22 @@ class PositionResolver {
         return position.customPosition ?? Offset.zero;
     }
   }
+
+  /// Place window [windowId] at [position] in one synchronous native call:
+  /// cursor, monitor, scale, edge avoidance and the move together.
+  ///
+  /// Returns false where there is no native solver (macOS, tests) and for
+  /// [Target.custom], whose point is in setPosition units rather than
+  /// native screen units; the caller then uses [resolve] and setPosition.
+  bool place(String windowId, PalettePosition position, {Size? size}) {
+    if (!Platform.isWindows || position.target == Target.custom) return false;
+    try {
+      final bridge = SyncNativeBridge.instance;
+      return bridge.isAvailable &&
+          bridge.solvePlacement(windowId, position, size: size) != null;
+    } catch (_) {
+      // FFI not available; fall back to the channel path.
+      return false;
+    }
+  }
 }
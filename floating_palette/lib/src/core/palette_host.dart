@@ -7,6 +7,7 @@ import '../bridge/command.dart';
 import '../bridge/native_bridge.dart';
 import '../config/config.dart';
 import '../controller/palette_controller.dart';
+import '../ffi/native_queries.dart';
 import '../input/input_manager.dart';
 import '../services/focus_client.dart';
 import '../services/screen_client.dart';
@@ -66,13 +67,14 @@ class PaletteHost {
   /// Initialize the palette host.
   ///
   /// This should be called once at app startup, before using any palettes.
-  /// Creates the NativeBridge, InputManager, and fetches capabilities.
+  /// Creates the NativeBridge (answering read-only queries over FFI where
+  /// the platform allows), InputManager, and fetches capabilities.
   ///
   /// Throws [ProtocolMismatchError] if the native plugin version is incompatible.
   static Future<PaletteHost> initialize() async {
     if (_instance != null) return _instance!;
 
-    final bridge = NativeBridge();
+    final bridge = NativeBridge(queries: NativeQueries.create());
 
     // Verify protocol compatibility
     try {
@@ -6,11 +6,23 @@
 /// Key features:
 /// - [SyncNativeBridge] - High-level API for synchronous FFI calls
 /// - [GlassPathBridge] - Low-level FFI for glass mask effects
+/// - [HitTestMaskBridge] - Pointer passthrough masks (Windows)
 /// - Window resizing (for SizeReporter)
 /// - Cursor position queries
 /// - Screen bounds queries
 /// - Active app bounds queries
+/// - Window state queries that skip the platform thread
 library;
 
 export 'glass_path_bridge.dart' show GlassPathBridge, GlassPathCommand;
-export 'native_bridge.dart' show SyncNativeBridge, Point, NativeRect;
+export 'hit_test_mask_bridge.dart'
+    show HitTestMaskBridge, HitTestMaskBuffer, PassthroughMode;
+export 'native_bridge.dart'
+    show SyncNativeBridge, Point, NativeRect, NativeWindowState;
+export 'message_ring_bridge.dart'
+    show
+        MessageRingBridge,
+        MessageRing,
+        MessageRingChannel,
+        MessageRingStats,
+        MessageRingWriteResult;
@@ -322,6 +322,71 @@ class FFIBindings {
         )
       >(isLeaf: true);
 
+  /// Handle variant of FloatingPalette_GetWindowFrame.
+  ///
+  /// @param handle     Handle from FloatingPalette_ResolveHandle
+  /// @param out_x      Output: X position (screen coordinates)
+  /// @param out_y      Output: Y position (screen coordinates)
+  /// @param out_width  Output: Window width
+  /// @param out_height Output: Window height
+  /// @return           true if the handle is valid, false otherwise
+  bool GetWindowFrameByHandle(
+    int handle,
+    ffi.Pointer<ffi.Double> out_x,
+    ffi.Pointer<ffi.Double> out_y,
+    ffi.Pointer<ffi.Double> out_width,
+    ffi.Pointer<ffi.Double> out_height,
+  ) {
+    return _GetWindowFrameByHandle(handle, out_x, out_y, out_width, out_height);
+  }
+
+  late final _GetWindowFrameByHandlePtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Bool Function(
+            ffi.Int32,
+            ffi.Pointer<ffi.Double>,
+            ffi.Pointer<ffi.Double>,
+            ffi.Pointer<ffi.Double>,
+            ffi.Pointer<ffi.Double>,
+          )
+        >
+      >('FloatingPalette_GetWindowFrameByHandle');
+  late final _GetWindowFrameByHandle =
+      _GetWindowFrameByHandlePtr.asFunction<
+        bool Function(
+          int,
+          ffi.Pointer<ffi.Double>,
+          ffi.Pointer<ffi.Double>,
+          ffi.Pointer<ffi.Double>,
+          ffi.Pointer<ffi.Double>,
+        )
+      >(isLeaf: true);
+
+  /// Read the frames of several palette windows in one call.
+  ///
+  /// @param frames  In: handle of each entry. Out: its frame; an entry with a
+  /// stale handle gets handle 0 and a zero frame
+  /// @param count   Number of entries in frames
+  /// @return        Number of entries whose handle was valid
+  int GetWindowFramesByHandle(
+    ffi.Pointer<FloatingPaletteFrame> frames,
+    int count,
+  ) {
+    return _GetWindowFramesByHandle(frames, count);
+  }
+
+  late final _GetWindowFramesByHandlePtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Int32 Function(ffi.Pointer<FloatingPaletteFrame>, ffi.Int32)
+        >
+      >('FloatingPalette_GetWindowFramesByHandle');
+  late final _GetWindowFramesByHandle = _GetWindowFramesByHandlePtr
+      .asFunction<int Function(ffi.Pointer<FloatingPaletteFrame>, int)>(
+        isLeaf: true,
+      );
+
   /// Check if a palette window is currently visible.
   ///
   /// @param window_id  The palette window identifier
@@ -339,6 +404,48 @@ class FFIBindings {
         isLeaf: true,
       );
 
+  /// Handle variant of FloatingPalette_IsWindowVisible.
+  ///
+  /// @param handle  Handle from FloatingPalette_ResolveHandle
+  /// @return        true if the handle is valid and the window is visible
+  bool IsWindowVisibleByHandle(int handle) {
+    return _IsWindowVisibleByHandle(handle);
+  }
+
+  late final _IsWindowVisibleByHandlePtr =
+      _lookup<ffi.NativeFunction<ffi.Bool Function(ffi.Int32)>>(
+        'FloatingPalette_IsWindowVisibleByHandle',
+      );
+  late final _IsWindowVisibleByHandle = _IsWindowVisibleByHandlePtr
+      .asFunction<bool Function(int)>(isLeaf: true);
+
+  /// Read a palette's bounds, visibility and focus in one call. Windows only.
+  ///
+  /// @param handle     Handle from FloatingPalette_ResolveHandle
+  /// @param out_state  Output: the window's state
+  /// @return           false if the handle is stale (the window doesn't
+  /// exist), in which case out_state is zeroed
+  bool QueryWindow(
+    int handle,
+    ffi.Pointer<FloatingPaletteWindowState> out_state,
+  ) {
+    return _QueryWindow(handle, out_state);
+  }
+
+  late final _QueryWindowPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Bool Function(
+            ffi.Int32,
+            ffi.Pointer<FloatingPaletteWindowState>,
+          )
+        >
+      >('FloatingPalette_QueryWindow');
+  late final _QueryWindow = _QueryWindowPtr
+      .asFunction<
+        bool Function(int, ffi.Pointer<FloatingPaletteWindowState>)
+      >(isLeaf: true);
+
   /// Resize a palette window synchronously.
   /// Called by SizeReporter when content size changes.
   ///
@@ -364,6 +471,41 @@ class FFIBindings {
         void Function(ffi.Pointer<ffi.Char>, double, double)
       >(isLeaf: true);
 
+  /// Handle variant of FloatingPalette_ResizeWindow.
+  ///
+  /// @param handle  Handle from FloatingPalette_ResolveHandle
+  /// @param width   New width in logical pixels
+  /// @param height  New height in logical pixels
+  /// @return        false if the handle is stale (re-resolve), true otherwise
+  bool ResizeWindowByHandle(int handle, double width, double height) {
+    return _ResizeWindowByHandle(handle, width, height);
+  }
+
+  late final _ResizeWindowByHandlePtr =
+      _lookup<
+        ffi.NativeFunction<ffi.Bool Function(ffi.Int32, ffi.Double, ffi.Double)>
+      >('FloatingPalette_ResizeWindowByHandle');
+  late final _ResizeWindowByHandle = _ResizeWindowByHandlePtr
+      .asFunction<bool Function(int, double, double)>(isLeaf: true);
+
+  /// Resolve a palette window id to an integer handle.
+  /// The handle stays valid until the window is destroyed; after that the
+  /// ..._ByHandle functions treat it as unknown (it is never reused for a
+  /// different window).
+  ///
+  /// @param window_id  The palette window identifier
+  /// @return           Handle (> 0), or 0 if the window does not exist
+  int ResolveHandle(ffi.Pointer<ffi.Char> window_id) {
+    return _ResolveHandle(window_id);
+  }
+
+  late final _ResolveHandlePtr =
+      _lookup<ffi.NativeFunction<ffi.Int32 Function(ffi.Pointer<ffi.Char>)>>(
+        'FloatingPalette_ResolveHandle',
+      );
+  late final _ResolveHandle = _ResolveHandlePtr
+      .asFunction<int Function(ffi.Pointer<ffi.Char>)>(isLeaf: true);
+
   /// Enable or disable the glass effect for a palette window.
   /// When enabled, creates NSVisualEffectView and starts CVDisplayLink polling.
   ///
@@ -398,4 +540,147 @@ class FFIBindings {
       _SetGlassMaterialPtr.asFunction<
         void Function(ffi.Pointer<ffi.Char>, int)
       >(isLeaf: true);
+
+  /// Move and size several palette windows as one arrangement.
+  /// The whole set is applied in a single window-manager transaction, so the
+  /// compositor never shows it half moved. On Windows the change is applied
+  /// on the platform thread shortly after this returns.
+  ///
+  /// @param frames  Target frames, in the units FloatingPalette_GetWindowFrame
+  /// reports
+  /// @param count   Number of entries in frames
+  /// @return        false if any handle is stale, in which case nothing moves
+  bool SetWindowFramesByHandle(
+    ffi.Pointer<FloatingPaletteFrame> frames,
+    int count,
+  ) {
+    return _SetWindowFramesByHandle(frames, count);
+  }
+
+  late final _SetWindowFramesByHandlePtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Bool Function(ffi.Pointer<FloatingPaletteFrame>, ffi.Int32)
+        >
+      >('FloatingPalette_SetWindowFramesByHandle');
+  late final _SetWindowFramesByHandle = _SetWindowFramesByHandlePtr
+      .asFunction<bool Function(ffi.Pointer<FloatingPaletteFrame>, int)>(
+        isLeaf: true,
+      );
+
+  /// Solve an anchored palette frame against the monitor the target is on:
+  /// anchor, offset, flip away from work-area edges that would clip it, and
+  /// clamp into the work area. Optionally applies it. Windows only.
+  ///
+  /// @param placement  The anchor spec
+  /// @param out_frame  Output: the frame, in the units
+  /// FloatingPalette_GetWindowFrame reports (may be NULL)
+  /// @return           false if the handle is stale or there is no screen
+  bool SolvePlacement(
+    ffi.Pointer<FloatingPalettePlacement> placement,
+    ffi.Pointer<FloatingPaletteFrame> out_frame,
+  ) {
+    return _SolvePlacement(placement, out_frame);
+  }
+
+  late final _SolvePlacementPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Bool Function(
+            ffi.Pointer<FloatingPalettePlacement>,
+            ffi.Pointer<FloatingPaletteFrame>,
+          )
+        >
+      >('FloatingPalette_SolvePlacement');
+  late final _SolvePlacement = _SolvePlacementPtr
+      .asFunction<
+        bool Function(
+          ffi.Pointer<FloatingPalettePlacement>,
+          ffi.Pointer<FloatingPaletteFrame>,
+        )
+      >(isLeaf: true);
+}
+
+/// One palette frame for the batched frame calls. Must match Dart.
+final class FloatingPaletteFrame extends ffi.Struct {
+  /// From FloatingPalette_ResolveHandle
+  @ffi.Int32()
+  external int handle;
+
+  /// Screen coordinates, as FloatingPalette_GetWindowFrame
+  @ffi.Double()
+  external double x;
+
+  @ffi.Double()
+  external double y;
+
+  @ffi.Double()
+  external double width;
+
+  @ffi.Double()
+  external double height;
+}
+
+/// Anchor spec for FloatingPalette_SolvePlacement. Must match Dart.
+final class FloatingPalettePlacement extends ffi.Struct {
+  /// From FloatingPalette_ResolveHandle
+  @ffi.Int32()
+  external int handle;
+
+  /// 0 cursor, 1 primary screen center, 2 (x, y)
+  @ffi.Int32()
+  external int target;
+
+  /// Dart Anchor index: 0 topLeft ... 8 bottomRight
+  @ffi.Int32()
+  external int anchor;
+
+  /// FLOATING_PALETTE_PLACEMENT_* bits
+  @ffi.Int32()
+  external int flags;
+
+  /// Target 2 only, as FloatingPalette_GetCursorPosition
+  @ffi.Double()
+  external double x;
+
+  @ffi.Double()
+  external double y;
+
+  /// From the target point, logical pixels
+  @ffi.Double()
+  external double offset_x;
+
+  @ffi.Double()
+  external double offset_y;
+
+  /// Logical pixels; 0 keeps the window's current size
+  @ffi.Double()
+  external double width;
+
+  @ffi.Double()
+  external double height;
+}
+
+/// One palette's state for FloatingPalette_QueryWindow. Must match Dart.
+final class FloatingPaletteWindowState extends ffi.Struct {
+  /// From FloatingPalette_ResolveHandle
+  @ffi.Int32()
+  external int handle;
+
+  /// FLOATING_PALETTE_WINDOW_* bits
+  @ffi.Int32()
+  external int flags;
+
+  /// Logical pixels, as frame/getBounds
+  @ffi.Double()
+  external double x;
+
+  @ffi.Double()
+  external double y;
+
+  @ffi.Double()
+  external double width;
+
+  @ffi.Double()
+  external double height;
 }
@@ -0,0 +1,181 @@
+import 'dart:ffi';
+import 'dart:io';
+import 'dart:ui' show Rect;
+
+import 'package:ffi/ffi.dart';
+
+/// Meaning of the rects in a hit-test mask. Must match native
+/// PassthroughMode.
+enum PassthroughMode {
+  /// Every point hits the palette.
+  none, // 0
+
+  /// Points inside a rect pass through to the window underneath.
+  regions, // 1
+
+  /// Only points inside a rect hit the palette; the rest passes through.
+  interactive, // 2
+
+  /// Every point passes through.
+  all, // 3
+}
+
+/// FFI struct matching native HitTestMaskBuffer.
+///
+/// Memory layout (packed, no padding):
+/// - frameId: 8 bytes (uint64) at offset 0
+/// - mode: 4 bytes (uint32) at offset 8
+/// - rectCount: 4 bytes (uint32) at offset 12
+/// - rects: 2048 bytes (float[512]) at offset 16
+/// - frameIdPost: 8 bytes (uint64) at offset 2064
+///
+/// Total: 2072 bytes (packed). Up to 128 rects of x, y, width, height in
+/// logical pixels relative to the palette's top-left corner.
+@Packed(1)
+final class HitTestMaskBuffer extends Struct {
+  static const int maxRects = 128;
+
+  @Uint64()
+  external int frameId;
+
+  @Uint32()
+  external int mode;
+
+  @Uint32()
+  external int rectCount;
+
+  @Array(512)
+  external Array<Float> rects;
+
+  @Uint64()
+  external int frameIdPost;
+}
+
+typedef _CreateMaskNative = Pointer<Void> Function(Pointer<Char>);
+typedef _CreateMaskDart = Pointer<Void> Function(Pointer<Char>);
+
+typedef _DestroyMaskNative = Void Function(Pointer<Char>);
+typedef _DestroyMaskDart = void Function(Pointer<Char>);
+
+/// Low-level FFI bridge for pointer passthrough masks (Windows).
+///
+/// A palette publishes which parts of its window let clicks through, and
+/// native code answers every hit test from that cached mask. Publishing is
+/// a memory write, so a mask can follow layout every frame without a
+/// channel message per change or per pointer move.
+///
+/// Masked points reach the app's own windows beneath the palette; Windows
+/// doesn't forward them to other apps. Use setPassthrough without regions
+/// to let the whole palette pass clicks to other apps.
+///
+/// Same publish protocol as [GlassPathBridge]: frameIdPost first, then the
+/// rects, then frameId; native skips a read where the two differ.
+class HitTestMaskBridge {
+  static HitTestMaskBridge? _instance;
+  static HitTestMaskBridge get instance {
+    _instance ??= HitTestMaskBridge._();
+    return _instance!;
+  }
+
+  _CreateMaskDart? _create;
+  _DestroyMaskDart? _destroy;
+
+  /// Active buffers per window ID.
+  final Map<String, Pointer<HitTestMaskBuffer>> _buffers = {};
+
+  /// Frame IDs per window ID (incremented on each publish).
+  final Map<String, int> _frameIds = {};
+
+  HitTestMaskBridge._() {
+    _initialize();
+  }
+
+  void _initialize() {
+    // Hit-test masks are native to the Windows plugin.
+    if (!Platform.isWindows) return;
+
+    try {
+      final lib = DynamicLibrary.open('floating_palette_plugin.dll');
+      _create = lib
+          .lookup<NativeFunction<_CreateMaskNative>>(
+            'FloatingPalette_CreateHitTestMask',
+          )
+          .asFunction(isLeaf: true);
+      _destroy = lib
+          .lookup<NativeFunction<_DestroyMaskNative>>(
+            'FloatingPalette_DestroyHitTestMask',
+          )
+          .asFunction(isLeaf: true);
+    } catch (_) {
+      // Older plugin build without hit-test masks.
+      _create = null;
+    }
+  }
+
+  /// Whether hit-test masks are available.
+  bool get isAvailable => _create != null;
+
+  /// Publish the passthrough mask for [windowId], creating its buffer on
+  /// first use. [rects] beyond [HitTestMaskBuffer.maxRects] are ignored.
+  /// Returns false if masks are unavailable or the window doesn't exist.
+  bool publish(String windowId, PassthroughMode mode, List<Rect> rects) {
+    final buffer = _buffers[windowId] ?? _createBuffer(windowId);
+    if (buffer == null) return false;
+
+    final frameId = (_frameIds[windowId] ?? 0) + 1;
+    _frameIds[windowId] = frameId;
+
+    // Signal write in progress
+    buffer.ref.frameIdPost = frameId;
+
+    buffer.ref.mode = mode.index;
+    final count = rects.length < HitTestMaskBuffer.maxRects
+        ? rects.length
+        : HitTestMaskBuffer.maxRects;
+    buffer.ref.rectCount = count;
+    for (int i = 0; i < count; i++) {
+      final rect = rects[i];
+      buffer.ref.rects[i * 4] = rect.left;
+      buffer.ref.rects[i * 4 + 1] = rect.top;
+      buffer.ref.rects[i * 4 + 2] = rect.width;
+      buffer.ref.rects[i * 4 + 3] = rect.height;
+    }
+
+    // Signal write complete
+    buffer.ref.frameId = frameId;
+    return true;
+  }
+
+  /// Stop using the published mask for [windowId]; the one set through
+  /// `InputClient.setPassthrough` applies again.
+  void destroy(String windowId) {
+    if (!isAvailable) return;
+    _buffers.remove(windowId);
+    _frameIds.remove(windowId);
+
+    final idPtr = windowId.toNativeUtf8().cast<Char>();
+    try {
+      _destroy!(idPtr);
+    } finally {
+      calloc.free(idPtr);
+    }
+  }
+
+  /// Check if a mask buffer exists for a window.
+  bool hasBuffer(String windowId) => _buffers.containsKey(windowId);
+
+  Pointer<HitTestMaskBuffer>? _createBuffer(String windowId) {
+    if (!isAvailable) return null;
+    final idPtr = windowId.toNativeUtf8().cast<Char>();
+    try {
+      final ptr = _create!(idPtr);
+      if (ptr == nullptr) return null;
+      final buffer = ptr.cast<HitTestMaskBuffer>();
+      _buffers[windowId] = buffer;
+      _frameIds[windowId] = 0;
+      return buffer;
+    } finally {
+      calloc.free(idPtr);
+    }
+  }
+}
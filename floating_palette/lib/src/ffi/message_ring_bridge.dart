@@ -0,0 +1,332 @@
+import 'dart:ffi';
+import 'dart:io';
+import 'dart:typed_data';
+
+import 'package:ffi/ffi.dart';
+
+/// Result of [MessageRing.write]. Must match native MessageRingWriteResult.
+enum MessageRingWriteResult {
+  /// Queued.
+  ok, // 0
+
+  /// The ring is full right now; the message was not queued.
+  overflowed, // 1
+
+  /// The message is larger than the ring; it can never be queued.
+  dropped, // 2
+}
+
+/// Well-known ring channels for a palette window.
+abstract final class MessageRingChannel {
+  /// Host engine writes, palette engine reads.
+  static const int hostToPalette = 0;
+
+  /// Palette engine writes, host engine reads.
+  static const int paletteToHost = 1;
+}
+
+/// Counters for one ring.
+class MessageRingStats {
+  /// Messages queued by the producer.
+  final int sent;
+
+  /// Messages taken by the consumer.
+  final int received;
+
+  /// Messages rejected for being larger than the ring.
+  final int dropped;
+
+  /// Messages rejected because the ring was full.
+  final int overflowed;
+
+  const MessageRingStats({
+    required this.sent,
+    required this.received,
+    required this.dropped,
+    required this.overflowed,
+  });
+}
+
+typedef _CreateRingNative = Pointer<Void> Function(Pointer<Char>, Int32, Uint32);
+typedef _CreateRingDart = Pointer<Void> Function(Pointer<Char>, int, int);
+
+typedef _CloseRingNative = Void Function(Pointer<Void>);
+typedef _CloseRingDart = void Function(Pointer<Void>);
+
+typedef _DestroyRingNative = Void Function(Pointer<Char>, Int32);
+typedef _DestroyRingDart = void Function(Pointer<Char>, int);
+
+typedef _WriteNative = Int32 Function(Pointer<Void>, Pointer<Uint8>, Uint32);
+typedef _WriteDart = int Function(Pointer<Void>, Pointer<Uint8>, int);
+
+typedef _ReadNative = Int32 Function(
+  Pointer<Void>,
+  Pointer<Uint8>,
+  Uint32,
+  Pointer<Uint32>,
+);
+typedef _ReadDart = int Function(
+  Pointer<Void>,
+  Pointer<Uint8>,
+  int,
+  Pointer<Uint32>,
+);
+
+typedef _DoorbellNative = Void Function();
+typedef _SetDoorbellNative = Void Function(
+  Pointer<Void>,
+  Pointer<NativeFunction<_DoorbellNative>>,
+);
+typedef _SetDoorbellDart = void Function(
+  Pointer<Void>,
+  Pointer<NativeFunction<_DoorbellNative>>,
+);
+
+typedef _StatsNative = Void Function(
+  Pointer<Void>,
+  Pointer<Uint64>,
+  Pointer<Uint64>,
+  Pointer<Uint64>,
+  Pointer<Uint64>,
+);
+typedef _StatsDart = void Function(
+  Pointer<Void>,
+  Pointer<Uint64>,
+  Pointer<Uint64>,
+  Pointer<Uint64>,
+  Pointer<Uint64>,
+);
+
+/// Low-level FFI bridge for shared-memory message rings (Windows).
+///
+/// A ring is a single-producer, single-consumer byte queue in native
+/// memory, shared by two engines in the process. Writes and reads are
+/// direct FFI calls on the calling isolate's thread, so high-rate traffic
+/// between the host and a palette never waits on the platform thread or
+/// goes through a codec.
+class MessageRingBridge {
+  static MessageRingBridge? _instance;
+  static MessageRingBridge get instance {
+    _instance ??= MessageRingBridge._();
+    return _instance!;
+  }
+
+  _CreateRingDart? _create;
+  _CloseRingDart? _close;
+  NativeFinalizer? _closeFinalizer;
+  _DestroyRingDart? _destroy;
+  _WriteDart? _write;
+  _ReadDart? _read;
+  _SetDoorbellDart? _setDoorbell;
+  _StatsDart? _stats;
+
+  MessageRingBridge._() {
+    _initialize();
+  }
+
+  void _initialize() {
+    // The rings are native to the Windows plugin.
+    if (!Platform.isWindows) return;
+
+    try {
+      final lib = DynamicLibrary.open('floating_palette_plugin.dll');
+      _create = lib
+          .lookup<NativeFunction<_CreateRingNative>>(
+            'FloatingPalette_CreateMessageRingChannel',
+          )
+          .asFunction(isLeaf: true);
+      final close = lib.lookup<NativeFunction<_CloseRingNative>>(
+        'FloatingPalette_CloseMessageRing',
+      );
+      _close = close.asFunction(isLeaf: true);
+      // Closes ends the isolate never closed, including on engine shutdown.
+      _closeFinalizer = NativeFinalizer(close.cast());
+      _destroy = lib
+          .lookup<NativeFunction<_DestroyRingNative>>(
+            'FloatingPalette_DestroyMessageRing',
+          )
+          .asFunction(isLeaf: true);
+      // Not a leaf call: it may ring the consumer's doorbell.
+      _write = lib
+          .lookup<NativeFunction<_WriteNative>>(
+            'FloatingPalette_MessageRingWrite',
+          )
+          .asFunction();
+      _read = lib
+          .lookup<NativeFunction<_ReadNative>>(
+            'FloatingPalette_MessageRingRead',
+          )
+          .asFunction(isLeaf: true);
+      _setDoorbell = lib
+          .lookup<NativeFunction<_SetDoorbellNative>>(
+            'FloatingPalette_SetMessageRingDoorbell',
+          )
+          .asFunction(isLeaf: true);
+      _stats = lib
+          .lookup<NativeFunction<_StatsNative>>(
+            'FloatingPalette_GetMessageRingStats',
+          )
+          .asFunction(isLeaf: true);
+    } catch (_) {
+      // Older plugin build without message rings.
+      _create = null;
+    }
+  }
+
+  /// Whether message rings are available.
+  bool get isAvailable => _create != null;
+
+  /// Open the ring for [windowId] and [channel] (see [MessageRingChannel]),
+  /// creating it with [capacity] bytes if the other end hasn't yet. The
+  /// ring stays valid until the returned end is closed.
+  /// Returns null if rings are unavailable.
+  MessageRing? open(
+    String windowId, {
+    int channel = MessageRingChannel.hostToPalette,
+    int capacity = 256 * 1024,
+  }) {
+    if (!isAvailable) return null;
+    final idPtr = windowId.toNativeUtf8().cast<Char>();
+    try {
+      final ring = _create!(idPtr, channel, capacity);
+      if (ring == nullptr) return null;
+      return MessageRing._(this, windowId, channel, ring);
+    } finally {
+      calloc.free(idPtr);
+    }
+  }
+
+  /// Free the ring for [windowId] and [channel] once both ends have closed
+  /// it; an end still open keeps it valid until then. Rings are also
+  /// destroyed with their window.
+  void destroy(
+    String windowId, {
+    int channel = MessageRingChannel.hostToPalette,
+  }) {
+    if (!isAvailable) return;
+    final idPtr = windowId.toNativeUtf8().cast<Char>();
+    try {
+      _destroy!(idPtr, channel);
+    } finally {
+      calloc.free(idPtr);
+    }
+  }
+}
+
+/// One end of a message ring. Use it either as the producer ([write]) or
+/// the consumer ([read], [listen]), never both.
+class MessageRing implements Finalizable {
+  final MessageRingBridge _bridge;
+
+  /// The window the ring belongs to.
+  final String windowId;
+
+  /// The ring's channel.
+  final int channel;
+
+  final Pointer<Void> _ring;
+
+  Pointer<Uint8> _scratch = nullptr;
+  int _scratchSize = 0;
+  final Pointer<Uint32> _length = calloc<Uint32>();
+  NativeCallable<_DoorbellNative>? _doorbell;
+  bool _closed = false;
+
+  MessageRing._(this._bridge, this.windowId, this.channel, this._ring) {
+    _bridge._closeFinalizer!.attach(this, _ring, detach: this);
+  }
+
+  Pointer<Uint8> _ensureScratch(int size) {
+    if (size > _scratchSize) {
+      if (_scratch != nullptr) malloc.free(_scratch);
+      _scratchSize = size < 4096 ? 4096 : size;
+      _scratch = malloc<Uint8>(_scratchSize);
+    }
+    return _scratch;
+  }
+
+  /// Queue [message] for the other end.
+  MessageRingWriteResult write(Uint8List message) {
+    if (_closed) return MessageRingWriteResult.dropped;
+    final buffer = _ensureScratch(message.length);
+    buffer.asTypedList(message.length).setAll(0, message);
+    final result = _bridge._write!(_ring, buffer, message.length);
+    return MessageRingWriteResult.values[result];
+  }
+
+  /// Take the oldest queued message, or null if the ring is empty. An empty
+  /// read arms the doorbell set by [listen].
+  Uint8List? read() {
+    if (_closed) return null;
+    var buffer = _ensureScratch(0);
+    var result = _bridge._read!(_ring, buffer, _scratchSize, _length);
+    if (result == 2) {
+      buffer = _ensureScratch(_length.value);
+      result = _bridge._read!(_ring, buffer, _scratchSize, _length);
+    }
+    if (result != 1) return null;
+    return Uint8List.fromList(buffer.asTypedList(_length.value));
+  }
+
+  /// Take every queued message.
+  List<Uint8List> drain() {
+    final messages = <Uint8List>[];
+    for (var message = read(); message != null; message = read()) {
+      messages.add(message);
+    }
+    return messages;
+  }
+
+  /// Consumer side: call [onMessages] with each burst of messages. The
+  /// producer rings the doorbell once per burst, after the ring was found
+  /// empty, so an idle ring costs nothing.
+  void listen(void Function(List<Uint8List> messages) onMessages) {
+    if (_closed) return;
+    _doorbell?.close();
+    final doorbell = NativeCallable<_DoorbellNative>.listener(() {
+      if (_closed) return;
+      final messages = drain();
+      if (messages.isNotEmpty) onMessages(messages);
+    });
+    _doorbell = doorbell;
+    _bridge._setDoorbell!(_ring, doorbell.nativeFunction);
+    // Pick up anything written before the doorbell was set; this also arms it.
+    final pending = drain();
+    if (pending.isNotEmpty) onMessages(pending);
+  }
+
+  /// Counters for the ring (shared by both ends).
+  MessageRingStats get stats {
+    final out = calloc<Uint64>(4);
+    try {
+      _bridge._stats!(_ring, out, out + 1, out + 2, out + 3);
+      return MessageRingStats(
+        sent: out[0],
+        received: out[1],
+        dropped: out[2],
+        overflowed: out[3],
+      );
+    } finally {
+      calloc.free(out);
+    }
+  }
+
+  /// Close this end and release its resources. The ring itself is freed
+  /// once both ends have closed and it has been destroyed (see
+  /// [MessageRingBridge.destroy]); an end dropped without closing is closed
+  /// when it is garbage collected or its engine shuts down.
+  void close() {
+    if (_closed) return;
+    _closed = true;
+    if (_doorbell != null) {
+      _bridge._setDoorbell!(_ring, nullptr);
+      _doorbell!.close();
+      _doorbell = null;
+    }
+    if (_scratch != nullptr) malloc.free(_scratch);
+    _scratch = nullptr;
+    calloc.free(_length);
+    _bridge._closeFinalizer!.detach(this);
+    _bridge._close!(_ring);
+  }
+}
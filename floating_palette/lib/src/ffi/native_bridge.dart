@@ -1,8 +1,10 @@
 import 'dart:ffi';
 import 'dart:io';
+import 'dart:ui' show Offset, Size;
 
 import 'package:ffi/ffi.dart';
 
+import '../config/palette_position.dart';
 import 'ffi_bindings.g.dart';
 
 /// High-level Dart API for synchronous FFI calls.
@@ -80,7 +82,52 @@ class SyncNativeBridge {
   /// This is the critical FFI call used by [SizeReporter] to resize
   /// the native window in the same frame as content measurement,
   /// avoiding flicker.
+  ///
+  /// Resolves [windowId] to a native handle on first use; later calls skip
+  /// string marshalling and the native id lookup entirely.
   void resizeWindow(String windowId, double width, double height) {
+    _resizeByHandle(windowId, width, height);
+  }
+
+  /// Handles resolved by [_handleFor], keyed by window id.
+  final _handles = <String, int>{};
+
+  /// Native handle for [windowId], resolved once and then cached.
+  ///
+  /// Returns 0 if the window doesn't exist (not cached, so a window created
+  /// later still resolves).
+  int _handleFor(String windowId) {
+    final cached = _handles[windowId];
+    if (cached != null) return cached;
+
+    final idPtr = windowId.toNativeUtf8().cast<Char>();
+    try {
+      final handle = _bindings.ResolveHandle(idPtr);
+      if (handle != 0) _handles[windowId] = handle;
+      return handle;
+    } finally {
+      calloc.free(idPtr);
+    }
+  }
+
+  /// Resize via the cached handle, re-resolving once if it went stale
+  /// (window destroyed and recreated under the same id).
+  ///
+  /// Falls back to the id-based call while the window isn't stored yet, so
+  /// a resize racing window creation behaves as before.
+  void _resizeByHandle(String windowId, double width, double height) {
+    final cached = _handles[windowId];
+    if (cached != null) {
+      if (_bindings.ResizeWindowByHandle(cached, width, height)) return;
+      _handles.remove(windowId);
+    }
+
+    final handle = _handleFor(windowId);
+    if (handle != 0) {
+      _bindings.ResizeWindowByHandle(handle, width, height);
+      return;
+    }
+
     final idPtr = windowId.toNativeUtf8().cast<Char>();
     try {
       _bindings.ResizeWindow(idPtr, width, height);
@@ -124,6 +171,121 @@ class SyncNativeBridge {
     }
   }
 
+  /// Move and size several palette windows as one arrangement (Windows).
+  ///
+  /// [frames] are in the units [getWindowFrame] reports. The whole set is
+  /// applied in one window-manager transaction, so it is never composed
+  /// half moved. Returns false, moving nothing, if any window doesn't exist
+  /// or the platform has no batched frame call.
+  bool setWindowFrames(Map<String, NativeRect> frames) {
+    if (!Platform.isWindows) return false;
+    if (frames.isEmpty) return true;
+
+    final buffer = calloc<FloatingPaletteFrame>(frames.length);
+    try {
+      // Retry once with fresh handles if a cached one went stale.
+      for (var attempt = 0; attempt < 2; attempt++) {
+        var index = 0;
+        for (final MapEntry(key: id, value: rect) in frames.entries) {
+          final handle = _handleFor(id);
+          if (handle == 0) return false;
+          buffer[index++]
+            ..handle = handle
+            ..x = rect.x
+            ..y = rect.y
+            ..width = rect.width
+            ..height = rect.height;
+        }
+        if (_bindings.SetWindowFramesByHandle(buffer, frames.length)) {
+          return true;
+        }
+        frames.keys.forEach(_handles.remove);
+      }
+      return false;
+    } finally {
+      calloc.free(buffer);
+    }
+  }
+
+  /// Current frames of several palette windows in one native call.
+  ///
+  /// Windows that don't exist are left out of the result.
+  Map<String, NativeRect> getWindowFrames(List<String> windowIds) {
+    if (!Platform.isWindows) {
+      return {
+        for (final id in windowIds)
+          if (getWindowFrame(id) case final frame?) id: frame,
+      };
+    }
+    if (windowIds.isEmpty) return {};
+
+    final buffer = calloc<FloatingPaletteFrame>(windowIds.length);
+    try {
+      for (var i = 0; i < windowIds.length; i++) {
+        buffer[i].handle = _handleFor(windowIds[i]);
+      }
+      _bindings.GetWindowFramesByHandle(buffer, windowIds.length);
+      final frames = <String, NativeRect>{};
+      for (var i = 0; i < windowIds.length; i++) {
+        final frame = buffer[i];
+        if (frame.handle == 0) {
+          // Stale or unknown; resolve afresh next time.
+          _handles.remove(windowIds[i]);
+          continue;
+        }
+        frames[windowIds[i]] =
+            NativeRect(frame.x, frame.y, frame.width, frame.height);
+      }
+      return frames;
+    } finally {
+      calloc.free(buffer);
+    }
+  }
+
+  // ═══════════════════════════════════════════════════════════════════════════
+  // WINDOW QUERIES
+  // ═══════════════════════════════════════════════════════════════════════════
+
+  /// Bounds, visibility and focus of [windowId] in one call, read from
+  /// native's window cache on this thread (Windows).
+  ///
+  /// Unlike the commands it mirrors (`frame/getBounds`,
+  /// `visibility/isVisible`, `focus/isFocused`, `window/exists`), this
+  /// never waits for the platform thread. Bounds are logical pixels, as
+  /// those commands report. Returns null if the window doesn't exist or
+  /// the platform can't answer this way.
+  NativeWindowState? queryWindow(String windowId) {
+    if (!Platform.isWindows) return null;
+
+    final state = calloc<FloatingPaletteWindowState>();
+    try {
+      // Retry once with a fresh handle if the cached one went stale.
+      for (var attempt = 0; attempt < 2; attempt++) {
+        final handle = _handleFor(windowId);
+        if (handle == 0) return null;
+        if (_bindings.QueryWindow(handle, state)) {
+          final s = state.ref;
+          return NativeWindowState(
+            bounds: s.flags & windowHasFrame != 0
+                ? NativeRect(s.x, s.y, s.width, s.height)
+                : null,
+            visible: s.flags & windowVisible != 0,
+            focused: s.flags & windowFocused != 0,
+          );
+        }
+        _handles.remove(windowId);
+      }
+      return null;
+    } finally {
+      calloc.free(state);
+    }
+  }
+
+  /// FLOATING_PALETTE_WINDOW_* flags of [FloatingPaletteWindowState].
+  static const windowVisible = 1;
+  static const windowFocused = 2;
+  static const windowHasFrame = 4;
+
   // ═══════════════════════════════════════════════════════════════════════════
   // CURSOR POSITION
   // ═══════════════════════════════════════════════════════════════════════════
@@ -254,6 +416,85 @@ class SyncNativeBridge {
       calloc.free(buffer);
     }
   }
+
+  // ═══════════════════════════════════════════════════════════════════════════
+  // PLACEMENT
+  // ═══════════════════════════════════════════════════════════════════════════
+
+  /// Solve [position] for [windowId] natively and, if [apply], move the
+  /// window there, all in one call (Windows).
+  ///
+  /// The cursor, monitor work area and scale are read natively, and with
+  /// [PalettePosition.avoidEdges] the anchor flips away from an edge the
+  /// palette would cross before it is clamped into the work area. [size]
+  /// is in logical pixels; null keeps the window's current size. A
+  /// [Target.custom] position is in the units [getCursorPosition] reports.
+  ///
+  /// Returns the frame, in the units [getWindowFrame] reports, or null if
+  /// the window doesn't exist or the platform has no native solver.
+  NativeRect? solvePlacement(
+    String windowId,
+    PalettePosition position, {
+    Size? size,
+    bool apply = true,
+  }) {
+    if (!Platform.isWindows) return null;
+
+    final placement = calloc<FloatingPalettePlacement>();
+    final frame = calloc<FloatingPaletteFrame>();
+    try {
+      final custom = position.customPosition ?? Offset.zero;
+      placement.ref
+        ..target = position.target.index
+        ..anchor = position.anchor.index
+        ..flags = (position.avoidEdges ? placementAvoidEdges : 0) |
+            (apply ? placementApply : 0)
+        ..x = custom.dx
+        ..y = custom.dy
+        ..offset_x = position.offset.dx
+        ..offset_y = position.offset.dy
+        ..width = size?.width ?? 0
+        ..height = size?.height ?? 0;
+
+      // Retry once with a fresh handle if the cached one went stale.
+      for (var attempt = 0; attempt < 2; attempt++) {
+        final handle = _handleFor(windowId);
+        if (handle == 0) return null;
+        placement.ref.handle = handle;
+        if (_bindings.SolvePlacement(placement, frame)) {
+          final f = frame.ref;
+          return NativeRect(f.x, f.y, f.width, f.height);
+        }
+        _handles.remove(windowId);
+      }
+      return null;
+    } finally {
+      calloc.free(placement);
+      calloc.free(frame);
+    }
+  }
+
+  /// FLOATING_PALETTE_PLACEMENT_* flags of [FloatingPalettePlacement].
+  static const placementAvoidEdges = 1;
+  static const placementApply = 2;
+}
+
+/// A palette's state from [SyncNativeBridge.queryWindow].
+class NativeWindowState {
+  /// Logical pixels; null until native has read the window's frame.
+  final NativeRect? bounds;
+  final bool visible;
+  final bool focused;
+
+  const NativeWindowState({
+    required this.bounds,
+    required this.visible,
+    required this.focused,
+  });
+
+  @override
+  String toString() =>
+      'NativeWindowState($bounds, visible: $visible, focused: $focused)';
 }
 
 /// A simple point with x and y coordinates.
@@ -0,0 +1,58 @@
+import 'dart:io';
+
+import '../bridge/command.dart';
+import '../bridge/read_only_queries.dart';
+import 'native_bridge.dart';
+
+/// [ReadOnlyQueries] served over FFI from native's caches (Windows).
+///
+/// Window queries take one [SyncNativeBridge.queryWindow] call; the cursor
+/// is read directly. Results have the shape the channel returns, so
+/// clients can't tell which path answered.
+class NativeQueries implements ReadOnlyQueries {
+  NativeQueries._(this._native);
+
+  final SyncNativeBridge _native;
+
+  /// Null where FFI can't answer (other platforms, or the plugin library
+  /// didn't load), leaving every command on the channel.
+  static NativeQueries? create() {
+    if (!Platform.isWindows) return null;
+    try {
+      final native = SyncNativeBridge.instance;
+      return native.isAvailable ? NativeQueries._(native) : null;
+    } catch (_) {
+      return null;
+    }
+  }
+
+  @override
+  LocalAnswer? answer(NativeCommand command) {
+    if (command.service == 'screen') {
+      final cursor = _native.getCursorPosition();
+      return (value: <String, dynamic>{'x': cursor.x, 'y': cursor.y});
+    }
+
+    final windowId = command.windowId;
+    if (windowId == null) return null;
+    final state = _native.queryWindow(windowId);
+    return switch (command.service) {
+      'window' => (value: state != null),
+      'visibility' => (value: state?.visible ?? false),
+      'focus' => (value: state?.focused ?? false),
+      // No frame yet (or no window): the command reports NOT_FOUND.
+      'frame' => switch (state?.bounds) {
+        final bounds? => (
+          value: <String, dynamic>{
+            'x': bounds.x,
+            'y': bounds.y,
+            'width': bounds.width,
+            'height': bounds.height,
+          },
+        ),
+        null => null,
+      },
+      _ => null,
+    };
+  }
+}
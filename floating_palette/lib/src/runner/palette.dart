@@ -1,7 +1,10 @@
+import 'dart:typed_data';
+
 import 'package:flutter/services.dart';
 
 import '../events/palette_event.dart';
 import '../snap/snap_types.dart';
+import 'palette_channel.dart';
 
 /// Callback for receiving typed events from host.
 typedef EventCallback<T extends PaletteEvent> = void Function(T event);
@@ -9,6 +12,9 @@ typedef EventCallback<T extends PaletteEvent> = void Function(T event);
 /// Callback for receiving untyped messages from host.
 typedef MessageCallback = void Function(String type, Map<String, dynamic> data);
 
+/// Callback for receiving binary messages from host.
+typedef BytesCallback = void Function(String type, Uint8List data);
+
 /// Provides access to the current palette from within a palette widget.
 ///
 /// Use this to communicate with the host app:
@@ -48,11 +54,12 @@ class PaletteContext {
   // ═══════════════════════════════════════════════════════════════════════════
 
   final String _id;
-  static const _channel = MethodChannel('floating_palette/messenger');
+  static const _channel = PaletteChannel('floating_palette/messenger');
 
   // Callback storage
   final _typedCallbacks = <Type, List<Function>>{};
   final _messageCallbacks = <MessageCallback>[];
+  final _bytesCallbacks = <BytesCallback>[];
 
   PaletteContext._(this._id) {
     _setupMessageHandler();
@@ -63,6 +70,13 @@ class PaletteContext {
       if (call.method == 'receive') {
         final args = call.arguments as Map<dynamic, dynamic>;
         final type = args['type'] as String;
+        final bytes = args['data'];
+        if (bytes is Uint8List) {
+          for (final callback in _bytesCallbacks) {
+            callback(type, bytes);
+          }
+          return;
+        }
         final data = Map<String, dynamic>.from(args['data'] as Map? ?? {});
         _handleIncomingMessage(type, data);
       }
@@ -109,6 +123,7 @@ class PaletteContext {
   void _dispose() {
     _typedCallbacks.clear();
     _messageCallbacks.clear();
+    _bytesCallbacks.clear();
     _channel.setMethodCallHandler(null);
   }
 
@@ -205,6 +220,23 @@ class PaletteContext {
     _messageCallbacks.remove(callback);
   }
 
+  /// Listen for binary messages from the host
+  /// (see `MessageClient.sendBytesToPalette`).
+  ///
+  /// ```dart
+  /// PaletteContext.current.onBytes((type, bytes) {
+  ///   if (type == 'selection') _selection = Selection.decode(bytes);
+  /// });
+  /// ```
+  void onBytes(BytesCallback callback) {
+    _bytesCallbacks.add(callback);
+  }
+
+  /// Remove a binary message listener.
+  void offBytes(BytesCallback callback) {
+    _bytesCallbacks.remove(callback);
+  }
+
   // ═══════════════════════════════════════════════════════════════════════════
   // Snap API (for palette-to-palette snapping from within a palette)
   // ═══════════════════════════════════════════════════════════════════════════
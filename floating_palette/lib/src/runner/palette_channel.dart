@@ -0,0 +1,58 @@
+import 'package:flutter/foundation.dart' show visibleForTesting;
+import 'package:flutter/services.dart';
+
+/// A palette-side method channel whose native end is opened on first use.
+///
+/// On Windows, the native messenger and self channels aren't registered
+/// when a palette engine starts; the first outgoing call asks native to
+/// open the channel over `floating_palette/entry`, then goes through.
+/// Platforms that set every channel up eagerly don't implement
+/// `openChannel`, which is treated as already open.
+class PaletteChannel extends MethodChannel {
+  const PaletteChannel(super.name);
+
+  static const _entry = MethodChannel('floating_palette/entry');
+
+  /// Channels opened (or opening) by this engine, by name.
+  static final _opened = <String, Future<void>>{};
+
+  Future<void> _ensureOpen() {
+    return _opened[name] ??= _open();
+  }
+
+  Future<void> _open() async {
+    try {
+      await _entry.invokeMethod<void>('openChannel', name);
+    } on MissingPluginException {
+      // Native sets this channel up eagerly.
+    } catch (_) {
+      // Let a later call retry.
+      _opened.remove(name);
+      rethrow;
+    }
+  }
+
+  @override
+  Future<T?> invokeMethod<T>(String method, [dynamic arguments]) async {
+    await _ensureOpen();
+    return super.invokeMethod<T>(method, arguments);
+  }
+
+  @override
+  Future<List<T>?> invokeListMethod<T>(String method,
+      [dynamic arguments]) async {
+    await _ensureOpen();
+    return super.invokeListMethod<T>(method, arguments);
+  }
+
+  @override
+  Future<Map<K, V>?> invokeMapMethod<K, V>(String method,
+      [dynamic arguments]) async {
+    await _ensureOpen();
+    return super.invokeMapMethod<K, V>(method, arguments);
+  }
+
+  /// Forget which channels are open (tests).
+  @visibleForTesting
+  static void resetForTesting() => _opened.clear();
+}
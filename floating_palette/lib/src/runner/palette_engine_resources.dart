@@ -0,0 +1,114 @@
+import 'dart:async';
+import 'dart:ui' as ui;
+
+import 'package:flutter/painting.dart';
+import 'package:flutter/services.dart';
+
+/// Resource budgets and warm-up for a palette's own Flutter engine.
+///
+/// Every palette runs in a separate engine, and the embedder gives each one
+/// its own GPU context: caches and compiled shader pipelines can't be
+/// shared with the host engine. What a palette engine can do is keep those
+/// caches sized for a small window instead of a full-screen app, and
+/// compile its common pipelines while it sits warm in the native engine
+/// pool, before it's asked to draw anything visible.
+class PaletteEngineResources {
+  PaletteEngineResources._();
+
+  /// GPU resource cache cap (Skia). The engine default is sized for a
+  /// full-screen window; a palette needs a fraction of that.
+  static const gpuCacheBytes = 8 << 20;
+
+  /// Decoded image cache caps. Flutter's defaults are 100 MB / 1000 images.
+  static const imageCacheBytes = 16 << 20;
+  static const imageCacheEntries = 100;
+
+  /// Apply the budgets to this engine.
+  static Future<void> configure() async {
+    PaintingBinding.instance.imageCache
+      ..maximumSizeBytes = imageCacheBytes
+      ..maximumSize = imageCacheEntries;
+    try {
+      await SystemChannels.skia.invokeMethod<void>(
+        'Skia.setResourceCacheMaxBytes',
+        gpuCacheBytes,
+      );
+    } on MissingPluginException {
+      // Renderer without a Skia resource cache (e.g. Impeller).
+    }
+  }
+
+  /// Rasterize the drawing operations palettes use most, offscreen, so
+  /// their shader pipelines are compiled before the first visible frame.
+  static Future<void> warmUpShaders() async {
+    const size = 64.0;
+    final recorder = ui.PictureRecorder();
+    final canvas = Canvas(recorder);
+    final rrect = RRect.fromRectAndRadius(
+      const Rect.fromLTWH(4, 4, size - 8, size - 8),
+      const Radius.circular(12),
+    );
+
+    // Rounded, clipped content with a shadow: the palette surface.
+    canvas.drawShadow(
+        Path()..addRRect(rrect), const Color(0xFF000000), 8, false);
+    canvas.save();
+    canvas.clipRRect(rrect);
+    canvas.drawRRect(rrect, Paint()..color = const Color(0xF0FFFFFF));
+    canvas.drawRect(
+      rrect.outerRect,
+      Paint()
+        ..shader = ui.Gradient.linear(
+          Offset.zero,
+          const Offset(0, size),
+          const [Color(0x20000000), Color(0x00000000)],
+        ),
+    );
+    canvas.restore();
+
+    // Borders, dividers and focus rings.
+    canvas.drawRRect(
+      rrect,
+      Paint()
+        ..style = PaintingStyle.stroke
+        ..strokeWidth = 1
+        ..color = const Color(0x40000000),
+    );
+    canvas.drawCircle(
+      const Offset(size / 2, size / 2),
+      8,
+      Paint()..maskFilter = const MaskFilter.blur(BlurStyle.normal, 4),
+    );
+
+    // Blurred layers (frosted backgrounds, transitions).
+    canvas.saveLayer(
+      rrect.outerRect,
+      Paint()..imageFilter = ui.ImageFilter.blur(sigmaX: 4, sigmaY: 4),
+    );
+    canvas.drawRect(rrect.outerRect, Paint()..color = const Color(0x80808080));
+    canvas.restore();
+
+    // Text: glyph atlas upload and sampling.
+    final builder = ui.ParagraphBuilder(ui.ParagraphStyle(fontSize: 13))
+      ..addText('Aa');
+    final paragraph = builder.build()
+      ..layout(const ui.ParagraphConstraints(width: size));
+    canvas.drawParagraph(paragraph, const Offset(8, 8));
+
+    final picture = recorder.endRecording();
+    try {
+      final image = await picture.toImage(size.toInt(), size.toInt());
+      image.dispose();
+    } finally {
+      picture.dispose();
+      paragraph.dispose();
+    }
+  }
+
+  /// Configure the engine and start the warm-up without waiting for it;
+  /// the raster thread finishes it ahead of the palette's first frame.
+  static void prepare() {
+    unawaited(configure());
+    unawaited(warmUpShaders());
+  }
+}
@@ -1,6 +1,7 @@
 import 'package:flutter/services.dart';
 import 'package:flutter/widgets.dart';
 
+import 'palette_engine_resources.dart';
 import 'palette_runner.dart';
 
 /// Method channel for palette entry point communication.
@@ -19,6 +20,7 @@ const _channel = MethodChannel('floating_palette/entry');
 @pragma('vm:entry-point')
 void floatingPaletteMain() async {
   WidgetsFlutterBinding.ensureInitialized();
+  PaletteEngineResources.prepare();
 
   // Get palette ID from native
   final paletteId = await _channel.invokeMethod<String>('getPaletteId');
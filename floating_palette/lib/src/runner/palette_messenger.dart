@@ -1,6 +1,7 @@
 import 'package:flutter/services.dart';
 
 import '../events/palette_event.dart';
+import 'palette_channel.dart';
 
 /// Messenger for palette-to-host communication.
 ///
@@ -15,7 +16,7 @@ import '../events/palette_event.dart';
 /// PaletteMessenger.send('my-event', {'key': 'value'});
 /// ```
 class PaletteMessenger {
-  static const _channel = MethodChannel('floating_palette/messenger');
+  static const _channel = PaletteChannel('floating_palette/messenger');
 
   /// Send a typed event to the host app.
   ///
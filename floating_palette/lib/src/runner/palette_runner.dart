@@ -5,6 +5,7 @@ import 'package:flutter/widgets.dart';
 
 import '../widgets/size_reporter.dart';
 import 'palette.dart';
+import 'palette_engine_resources.dart';
 import 'palette_self.dart';
 
 /// Key event data received from native.
@@ -83,6 +84,10 @@ void initPaletteEngine(
 }) async {
   WidgetsFlutterBinding.ensureInitialized();
 
+  // Small-window cache budgets and shader warm-up; pooled engines do this
+  // while waiting for their palette ID.
+  PaletteEngineResources.prepare();
+
   // Register events for typed event handling (Palette.on<T>())
   registerEvents?.call();
 
@@ -4,6 +4,7 @@ import 'package:flutter/scheduler.dart';
 import 'package:flutter/services.dart';
 
 import '../positioning/screen_rect.dart';
+import 'palette_channel.dart';
 
 /// Query methods for a palette to get information about itself.
 ///
@@ -32,7 +33,7 @@ import '../positioning/screen_rect.dart';
 /// }
 /// ```
 class PaletteSelf {
-  static const _channel = MethodChannel('floating_palette/self');
+  static const _channel = PaletteChannel('floating_palette/self');
 
   /// Callbacks for focus events.
   static final List<void Function()> _focusGainedCallbacks = [];
@@ -83,6 +84,8 @@ class PaletteSelf {
           for (final callback in List.from(_focusLostCallbacks)) {
             callback();
           }
+        case 'setLifecycleState':
+          _setHibernationState(call.arguments as String);
       }
       return null;
     });
@@ -90,6 +93,18 @@ class PaletteSelf {
 
   static bool _lifecycleOverrideInstalled = false;
 
+  /// Set while native has this palette hidden or suspended (Windows
+  /// keep-alive hibernation); engine lifecycle updates wait until it ends.
+  static bool _hibernating = false;
+
+  /// Apply a lifecycle state chosen by native hibernation. Unlike the
+  /// engine's own states, hidden/paused here do stop frame scheduling.
+  static void _setHibernationState(String name) {
+    final state = AppLifecycleState.values.byName(name);
+    _hibernating = state != AppLifecycleState.resumed;
+    SchedulerBinding.instance.handleAppLifecycleStateChanged(state); // ignore: invalid_use_of_protected_member
+  }
+
   /// Replace the default `flutter/lifecycle` handler to prevent the engine
   /// from freezing palette rendering when the app loses focus.
   ///
@@ -126,6 +141,7 @@ class PaletteSelf {
         case AppLifecycleState.resumed:
         case AppLifecycleState.inactive:
           // Forward — both keep frames enabled
+          if (_hibernating) return null;
           SchedulerBinding.instance.handleAppLifecycleStateChanged(state); // ignore: invalid_use_of_protected_member
           return null;
       }
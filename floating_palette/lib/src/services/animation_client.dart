@@ -2,6 +2,7 @@ import 'dart:async';
 
 import 'package:flutter/foundation.dart' show debugPrint;
 
+import '../bridge/binary_codec.dart';
 import '../bridge/service_client.dart';
 
 /// Animatable properties.
@@ -37,6 +38,19 @@ class AnimationClient extends ServiceClient {
     int repeat = 1,
     bool autoReverse = false,
   }) async {
+    // One plain run of a native property takes the binary channel.
+    final index = _binaryProperty(property);
+    final curveFlags = BinaryFlags.curve(curve);
+    if (index != null && curveFlags != null && repeat == 1 && !autoReverse) {
+      final reply = await bridge.sendBinary(
+        id,
+        BinaryOpcode.animate,
+        flags: curveFlags | BinaryFlags.hasFrom,
+        arg: durationMs,
+        payload: [index.toDouble(), to, from],
+      );
+      if (reply != null) return;
+    }
     await send<void>('animate', windowId: id, params: {
       'property': property.name,
       'from': from,
@@ -62,8 +76,33 @@ class AnimationClient extends ServiceClient {
     });
   }
 
+  /// Animate several windows on one shared timeline.
+  ///
+  /// All groups start together and move in the same native frame, e.g. to
+  /// fan out a toolbar, inspector and tooltips at once.
+  Future<void> animateGroup({
+    required List<WindowAnimations> windows,
+    required int durationMs,
+    String curve = 'easeOut',
+  }) async {
+    await send<void>('animateGroup', params: {
+      'windows': windows.map((w) => w.toMap()).toList(),
+      'durationMs': durationMs,
+      'curve': curve,
+    });
+  }
+
   /// Stop animation on a property.
   Future<void> stop(String id, AnimatableProperty property) async {
+    final index = _binaryProperty(property);
+    if (index != null) {
+      final reply = await bridge.sendBinary(
+        id,
+        BinaryOpcode.stopAnimation,
+        payload: [index.toDouble()],
+      );
+      if (reply != null) return;
+    }
     await send<void>('stop', windowId: id, params: {
       'property': property.name,
     });
@@ -71,6 +110,12 @@ class AnimationClient extends ServiceClient {
 
   /// Stop all animations on a window.
   Future<void> stopAll(String id) async {
+    final reply = await bridge.sendBinary(
+      id,
+      BinaryOpcode.stopAnimation,
+      flags: BinaryFlags.allProperties,
+    );
+    if (reply != null) return;
     await send<void>('stopAll', windowId: id);
   }
 
@@ -86,6 +131,19 @@ class AnimationClient extends ServiceClient {
     return result;
   }
 
+  /// Native AnimatedProperty index, or null for properties only the
+  /// commands handle.
+  static int? _binaryProperty(AnimatableProperty property) {
+    return switch (property) {
+      AnimatableProperty.x => 0,
+      AnimatableProperty.y => 1,
+      AnimatableProperty.width => 2,
+      AnimatableProperty.height => 3,
+      AnimatableProperty.opacity => 4,
+      _ => null,
+    };
+  }
+
   // ════════════════════════════════════════════════════════════════════════
   // Events
   // ════════════════════════════════════════════════════════════════════════
@@ -136,3 +194,19 @@ class PropertyAnimation {
         'to': to,
       };
 }
+
+/// The property animations for one window in an [AnimationClient.animateGroup].
+class WindowAnimations {
+  final String windowId;
+  final List<PropertyAnimation> animations;
+
+  const WindowAnimations({
+    required this.windowId,
+    required this.animations,
+  });
+
+  Map<String, dynamic> toMap() => {
+        'windowId': windowId,
+        'animations': animations.map((a) => a.toMap()).toList(),
+      };
+}
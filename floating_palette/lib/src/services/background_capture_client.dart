@@ -1,8 +1,10 @@
 import 'dart:async';
 
-import 'package:flutter/painting.dart' show EdgeInsets;
+import 'package:flutter/painting.dart' show EdgeInsets, Rect;
 import 'package:flutter/services.dart';
 
+import '../runner/palette_channel.dart';
+
 /// Permission status for screen recording.
 enum BackgroundCapturePermission {
   /// Permission has been granted.
@@ -18,6 +20,17 @@ enum BackgroundCapturePermission {
   restricted,
 }
 
+/// What the captured texture contains.
+enum BackgroundCaptureOutput {
+  /// The backdrop as captured, scaled by [BackgroundCaptureConfig.pixelRatio].
+  raw,
+
+  /// Downsampled and blurred natively on the GPU, for glass effects that
+  /// would otherwise run a BackdropFilter over the full-size texture.
+  /// Supported on Windows; other platforms deliver [raw].
+  blurred,
+}
+
 /// Configuration for background capture.
 class BackgroundCaptureConfig {
   /// Target frame rate in frames per second.
@@ -38,11 +51,42 @@ class BackgroundCaptureConfig {
   /// Useful for effects that extend beyond the window bounds (like liquid glass circles).
   final EdgeInsets capturePadding;
 
+  /// Frame rate cap while the palette is being dragged or moved, so the
+  /// backdrop keeps up with the window. Default: 60 fps.
+  final int dragFrameRate;
+
+  /// Skip frames when nothing changed behind the palette, so a static
+  /// backdrop costs nothing. Default: true.
+  final bool adaptiveFrameRate;
+
+  /// Capture only this rect (logical pixels, relative to the window's
+  /// top-left) instead of the whole window. Follows the window as it moves.
+  /// [capturePadding] still applies. Default: null (whole window).
+  final Rect? region;
+
+  /// Whether the texture is delivered raw or pre-blurred.
+  /// Default: [BackgroundCaptureOutput.raw].
+  final BackgroundCaptureOutput output;
+
+  /// Size reduction per axis for [BackgroundCaptureOutput.blurred]
+  /// (1, 2, 4 or 8). Default: 4.
+  final int downsample;
+
+  /// Blur passes for [BackgroundCaptureOutput.blurred] (0-8); each pass
+  /// widens the blur. Default: 4.
+  final int blurPasses;
+
   const BackgroundCaptureConfig({
     this.frameRate = 30,
     this.pixelRatio = 1.0,
     this.excludeSelf = true,
     this.capturePadding = EdgeInsets.zero,
+    this.dragFrameRate = 60,
+    this.adaptiveFrameRate = true,
+    this.region,
+    this.output = BackgroundCaptureOutput.raw,
+    this.downsample = 4,
+    this.blurPasses = 4,
   });
 
   Map<String, dynamic> toMap() => {
@@ -53,6 +97,18 @@ class BackgroundCaptureConfig {
         'paddingRight': capturePadding.right,
         'paddingBottom': capturePadding.bottom,
         'paddingLeft': capturePadding.left,
+        'dragFrameRate': dragFrameRate,
+        'adaptiveFrameRate': adaptiveFrameRate,
+        'output': output.name,
+        'downsample': downsample,
+        'blurPasses': blurPasses,
+        if (region != null)
+          'region': {
+            'x': region!.left,
+            'y': region!.top,
+            'width': region!.width,
+            'height': region!.height,
+          },
       };
 }
 
@@ -102,7 +158,7 @@ class BackgroundCaptureEvent {
 /// ```
 class BackgroundCaptureClient {
   // Use the 'self' channel which is set up on each palette engine
-  static const _channel = MethodChannel('floating_palette/self');
+  static const _channel = PaletteChannel('floating_palette/self');
 
   final _eventController = StreamController<BackgroundCaptureEvent>.broadcast();
 
@@ -193,6 +249,23 @@ class BackgroundCaptureClient {
     return _channel.invokeMethod<int>('backgroundCapture.getTextureId');
   }
 
+  /// Frame counters for this palette's capture: framesArrived,
+  /// framesCopied, framesThrottled, framesStatic, framesDropped (copied but
+  /// replaced before Flutter drew them), framesPresented and framesLate.
+  /// Returns null if no capture is active or the platform doesn't report
+  /// them (Windows only).
+  Future<Map<String, int>?> getStats() async {
+    try {
+      final result = await _channel
+          .invokeMethod<Map<Object?, Object?>>('backgroundCapture.getStats');
+      return result?.map((key, value) => MapEntry(key as String, value as int));
+    } on PlatformException {
+      return null;
+    } on MissingPluginException {
+      return null;
+    }
+  }
+
   void dispose() {
     _eventController.close();
   }
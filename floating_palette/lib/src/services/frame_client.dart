@@ -3,11 +3,14 @@ import 'dart:ui';
 
 import 'package:flutter/foundation.dart' show debugPrint;
 
+import '../bridge/binary_codec.dart';
 import '../bridge/service_client.dart';
 
 /// Client for FrameService.
 ///
-/// Handles position and size.
+/// Handles position and size. Single-window sets and [getBounds] take the
+/// binary channel when native has one (see `NativeBridge.sendBinary`) and
+/// fall back to commands otherwise.
 class FrameClient extends ServiceClient {
   FrameClient(super.bridge);
 
@@ -26,6 +29,12 @@ class FrameClient extends ServiceClient {
     int? durationMs,
     String? curve,
   }) async {
+    final payload = [position.dx, position.dy];
+    if (anchor == null &&
+        await _sendBinary(id, BinaryOpcode.setPosition, payload, animate,
+            durationMs, curve)) {
+      return;
+    }
     await send<void>('setPosition', windowId: id, params: {
       'x': position.dx,
       'y': position.dy,
@@ -44,6 +53,11 @@ class FrameClient extends ServiceClient {
     int? durationMs,
     String? curve,
   }) async {
+    final payload = [size.width, size.height];
+    if (await _sendBinary(
+        id, BinaryOpcode.setSize, payload, animate, durationMs, curve)) {
+      return;
+    }
     await send<void>('setSize', windowId: id, params: {
       'width': size.width,
       'height': size.height,
@@ -61,6 +75,11 @@ class FrameClient extends ServiceClient {
     int? durationMs,
     String? curve,
   }) async {
+    final payload = [bounds.left, bounds.top, bounds.width, bounds.height];
+    if (await _sendBinary(
+        id, BinaryOpcode.setBounds, payload, animate, durationMs, curve)) {
+      return;
+    }
     await send<void>('setBounds', windowId: id, params: {
       'x': bounds.left,
       'y': bounds.top,
@@ -72,6 +91,52 @@ class FrameClient extends ServiceClient {
     });
   }
 
+  /// Set the bounds of several windows as one arrangement.
+  ///
+  /// Native applies every frame in a single transaction, so a docked layout
+  /// change is composed once instead of window by window. Nothing moves if
+  /// any window is unknown.
+  Future<void> setBoundsMany(
+    Map<String, Rect> frames, {
+    bool animate = false,
+    int? durationMs,
+    String? curve,
+  }) async {
+    await send<void>('setBoundsMany', params: {
+      'frames': [
+        for (final MapEntry(key: id, value: bounds) in frames.entries)
+          {
+            'id': id,
+            'x': bounds.left,
+            'y': bounds.top,
+            'width': bounds.width,
+            'height': bounds.height,
+          },
+      ],
+      'animate': animate,
+      'durationMs': ?durationMs,
+      'curve': ?curve,
+    });
+  }
+
+  /// Get the bounds of several windows in one call.
+  ///
+  /// Windows that don't exist are left out of the result.
+  Future<Map<String, Rect>> getBoundsMany(List<String> ids) async {
+    final result = await sendForMap('getBoundsMany', params: {'ids': ids});
+    if (result == null) return {};
+    return {
+      for (final MapEntry(key: id, value: bounds) in result.entries)
+        if (bounds is Map)
+          id: Rect.fromLTWH(
+            (bounds['x'] as num).toDouble(),
+            (bounds['y'] as num).toDouble(),
+            (bounds['width'] as num).toDouble(),
+            (bounds['height'] as num).toDouble(),
+          ),
+    };
+  }
+
   /// Get current position.
   Future<Offset> getPosition(String id) async {
     final result = await sendForMap('getPosition', windowId: id);
@@ -106,7 +171,17 @@ class FrameClient extends ServiceClient {
   }
 
   /// Get current bounds.
+  ///
+  /// Answered locally when the bridge can (see `ReadOnlyQueries`), else
+  /// over the binary channel, else as a command.
   Future<Rect> getBounds(String id) async {
+    if (!bridge.answersQueriesLocally) {
+      final reply = await bridge.sendBinary(id, BinaryOpcode.getBounds);
+      if (reply != null) {
+        final p = reply.payload;
+        return Rect.fromLTWH(p[0], p[1], p[2], p[3]);
+      }
+    }
     final result = await sendForMap('getBounds', windowId: id);
     if (result == null) {
       debugPrint('[FrameClient] getBounds($id) returned null — using fallback');
@@ -120,6 +195,28 @@ class FrameClient extends ServiceClient {
     );
   }
 
+  /// Send a frame change on the binary channel; false if it has to go as
+  /// a command (no channel, or a curve without a binary index).
+  Future<bool> _sendBinary(
+    String id,
+    int opcode,
+    List<double> payload,
+    bool animate,
+    int? durationMs,
+    String? curve,
+  ) async {
+    final curveFlags = BinaryFlags.curve(curve ?? 'easeInOut');
+    if (curveFlags == null) return false;
+    final reply = await bridge.sendBinary(
+      id,
+      opcode,
+      flags: curveFlags | (animate ? BinaryFlags.animate : 0),
+      arg: durationMs ?? 0,
+      payload: payload,
+    );
+    return reply != null;
+  }
+
   // ════════════════════════════════════════════════════════════════════════
   // Events
   // ════════════════════════════════════════════════════════════════════════
@@ -134,6 +231,39 @@ class FrameClient extends ServiceClient {
     });
   }
 
+  /// Called when a native drag of the window starts, with its position.
+  void onDragStarted(String id, void Function(Offset position) callback) {
+    onWindowEvent(id, 'dragStarted', (event) {
+      callback(Offset(
+        (event.data['x'] as num).toDouble(),
+        (event.data['y'] as num).toDouble(),
+      ));
+    });
+  }
+
+  /// Called when a native drag of the window ends, with its final position
+  /// and the pointer velocity at release (logical pixels per second).
+  /// A cancelled drag (Escape) has returned the window to where it started
+  /// and reports zero velocity.
+  void onDragEnded(
+    String id,
+    void Function(Offset position, Offset velocity, bool cancelled) callback,
+  ) {
+    onWindowEvent(id, 'dragEnded', (event) {
+      callback(
+        Offset(
+          (event.data['x'] as num).toDouble(),
+          (event.data['y'] as num).toDouble(),
+        ),
+        Offset(
+          (event.data['velocityX'] as num?)?.toDouble() ?? 0,
+          (event.data['velocityY'] as num?)?.toDouble() ?? 0,
+        ),
+        event.data['cancelled'] as bool? ?? false,
+      );
+    });
+  }
+
   /// Called when window resizes.
   void onResized(String id, void Function(Size size) callback) {
     onWindowEvent(id, 'resized', (event) {
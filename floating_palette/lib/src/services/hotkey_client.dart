@@ -0,0 +1,89 @@
+import 'package:flutter/services.dart' show LogicalKeyboardKey;
+
+import '../bridge/service_client.dart';
+
+/// Modifier keys for a global hotkey.
+enum HotkeyModifier { control, alt, shift, meta }
+
+/// What native does when a global hotkey fires.
+enum HotkeyAction {
+  /// Only report it ([HotkeyClient.onTriggered]).
+  notify,
+
+  /// Show the bound palette, then report it.
+  show,
+
+  /// Hide the bound palette if shown, otherwise show it, then report it.
+  toggle,
+}
+
+/// What native did when a hotkey fired.
+enum HotkeyOutcome { notified, shown, hidden }
+
+/// Client for HotkeyService.
+///
+/// System-wide hotkeys. A hotkey bound to a palette is handled natively:
+/// the palette is revealed (a warm keep-alive palette is simply uncloaked)
+/// before Dart hears about it, so a show doesn't wait on a round trip.
+class HotkeyClient extends ServiceClient {
+  HotkeyClient(super.bridge);
+
+  @override
+  String get serviceName => 'hotkey';
+
+  /// Register a global hotkey under [hotkeyId], replacing any earlier
+  /// registration with that id.
+  ///
+  /// With [windowId] the hotkey shows that palette ([HotkeyAction.show] by
+  /// default); without one it only notifies. [repeat] lets a held key fire
+  /// repeatedly. Fails with `HOTKEY_IN_USE` if another application owns
+  /// the combination, or `UNSUPPORTED_KEY` for keys without a virtual key.
+  Future<void> register(
+    String hotkeyId,
+    LogicalKeyboardKey key, {
+    Set<HotkeyModifier> modifiers = const {},
+    String? windowId,
+    HotkeyAction? action,
+    bool focus = true,
+    bool repeat = false,
+  }) async {
+    await send<void>('register', windowId: windowId, params: {
+      'hotkeyId': hotkeyId,
+      'keyId': key.keyId,
+      'modifiers': modifiers.map((m) => m.name).toList(),
+      if (action != null) 'action': action.name,
+      'focus': focus,
+      'repeat': repeat,
+    });
+  }
+
+  /// Unregister a hotkey. Unknown ids are ignored.
+  Future<void> unregister(String hotkeyId) async {
+    await send<void>('unregister', params: {'hotkeyId': hotkeyId});
+  }
+
+  /// Unregister every hotkey.
+  Future<void> unregisterAll() async {
+    await send<void>('unregisterAll');
+  }
+
+  // ════════════════════════════════════════════════════════════════════════
+  // Events
+  // ════════════════════════════════════════════════════════════════════════
+
+  /// Called after a hotkey fired and native handled it. [windowId] is the
+  /// bound palette, if any; [outcome] is what was done to it.
+  void onTriggered(
+    void Function(String hotkeyId, String? windowId, HotkeyOutcome outcome)
+        callback,
+  ) {
+    onEvent('triggered', (event) {
+      final outcome = switch (event.data['action']) {
+        'shown' => HotkeyOutcome.shown,
+        'hidden' => HotkeyOutcome.hidden,
+        _ => HotkeyOutcome.notified,
+      };
+      callback(event.data['hotkeyId'] as String, event.windowId, outcome);
+    });
+  }
+}
@@ -15,6 +15,11 @@ class InputClient extends ServiceClient {
   String get serviceName => 'input';
 
   /// Capture keyboard events.
+  ///
+  /// On Windows captured keys are handed natively from the host view to
+  /// the palette's engine, so its focused widgets get them without a trip
+  /// through host Dart. Without [keys] every key is captured, including
+  /// IME composition.
   Future<void> captureKeyboard(
     String id, {
     Set<LogicalKeyboardKey>? keys,
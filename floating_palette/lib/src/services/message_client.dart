@@ -1,3 +1,5 @@
+import 'dart:typed_data';
+
 import '../bridge/native_bridge.dart' show NativeEventCallback;
 import '../bridge/service_client.dart';
 
@@ -109,6 +111,24 @@ class MessageClient extends ServiceClient {
     await send('send', windowId: paletteId, params: {'type': type, 'data': data ?? {}});
   }
 
+  /// Send a binary payload to a palette (Host → Palette).
+  ///
+  /// The bytes are forwarded to the palette as-is, without being walked or
+  /// re-encoded on the way, so this is the cheap path for large, frequent
+  /// state (e.g. serialized selection snapshots). The palette receives them
+  /// through [PaletteContext.onBytes].
+  ///
+  /// ```dart
+  /// await messageClient.sendBytesToPalette('inspector', 'selection', bytes);
+  /// ```
+  Future<void> sendBytesToPalette(
+    String paletteId,
+    String type,
+    Uint8List bytes,
+  ) async {
+    await send('send', windowId: paletteId, params: {'type': type, 'data': bytes});
+  }
+
   @override
   void dispose() {
     bridge.unsubscribe(serviceName, _eventHandler);
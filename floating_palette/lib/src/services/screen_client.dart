@@ -176,6 +176,17 @@ class ScreenClient extends ServiceClient {
     });
   }
 
+  /// Called when the active (frontmost) application window changes, moves
+  /// or resizes.
+  ///
+  /// Native tracks this with system hooks and throttles delivery, so
+  /// listening here replaces polling [getActiveAppBounds].
+  void onActiveAppChanged(void Function(ActiveAppInfo app) callback) {
+    onEvent('activeAppChanged', (event) {
+      callback(ActiveAppInfo.fromMap(event.data));
+    });
+  }
+
   /// Called when a window moves to a different screen.
   void onWindowScreenChanged(String id, void Function(int screenIndex) callback) {
     onWindowEvent(id, 'screenChanged', (event) {
@@ -6,6 +6,7 @@ export 'appearance_client.dart';
 export 'focus_client.dart';
 export 'frame_client.dart';
 export 'glass_effect_service.dart';
+export 'hotkey_client.dart';
 export 'input_client.dart';
 export 'message_client.dart';
 export 'screen_client.dart';
@@ -23,21 +23,36 @@ class WindowClient extends ServiceClient {
     required PaletteSize size,
     String? entryPoint,
     bool keepAlive = false,
+    Duration? suspendAfter = PaletteBehavior.defaultSuspendAfter,
   }) async {
-    final result = await send<String>('create', windowId: id, params: {
-      'id': id,
-      'entryPoint': entryPoint ?? 'paletteMain',
-      'cornerRadius': appearance.cornerRadius,
-      'shadow': appearance.shadow.name,
-      'transparent': appearance.transparent,
-      'debugBorder': appearance.debugBorder,
-      if (appearance.backgroundColor != null)
-        'backgroundColor': appearance.backgroundColor!.toARGB32(),
-      // Size config - stored on native side for runtime queries
-      ...size.toMap(),
-      'keepAlive': keepAlive,
+    final spec = WindowSpec(
+      id,
+      appearance: appearance,
+      size: size,
+      entryPoint: entryPoint,
+      keepAlive: keepAlive,
+      suspendAfter: suspendAfter,
+    );
+    return send<String>('create', windowId: id, params: spec.toMap());
+  }
+
+  /// Create several windows in one call, e.g. when restoring a workspace.
+  ///
+  /// One channel message for the whole set, and every panel is sized in
+  /// one native batch. Engines still start one after another, so this
+  /// saves per-call overhead, not engine startup time. A window that fails
+  /// doesn't fail the others: it's reported in `failed` with its error
+  /// code (`ALREADY_EXISTS`, `ENGINE_FAILED`).
+  Future<({List<String> created, Map<String, String> failed})> createMany(
+    List<WindowSpec> windows,
+  ) async {
+    final result = await sendForMap('createMany', params: {
+      'windows': [for (final spec in windows) spec.toMap()],
     });
-    return result;
+    return (
+      created: _ids(result?['created']),
+      failed: _codes(result?['failed']),
+    );
   }
 
   /// Destroy a window.
@@ -45,6 +60,31 @@ class WindowClient extends ServiceClient {
     await send<void>('destroy', windowId: id);
   }
 
+  /// Destroy several windows in one call.
+  ///
+  /// The panels are hidden together before their engines shut down. Ids
+  /// with no window are reported in `failed` as `NOT_FOUND`; a repeated id
+  /// is destroyed once.
+  Future<({List<String> destroyed, Map<String, String> failed})> destroyMany(
+    List<String> ids,
+  ) async {
+    final result = await sendForMap('destroyMany', params: {'ids': ids});
+    return (
+      destroyed: _ids(result?['destroyed']),
+      failed: _codes(result?['failed']),
+    );
+  }
+
+  static List<String> _ids(Object? value) =>
+      value is List ? value.whereType<String>().toList() : const [];
+
+  static Map<String, String> _codes(Object? codes) => codes is Map
+      ? {
+          for (final MapEntry(:key, :value) in codes.entries)
+            if (key is String && value is String) key: value,
+        }
+      : const {};
+
   /// Check if a window exists.
   Future<bool> exists(String id) async {
     final result = await send<bool>('exists', windowId: id);
@@ -62,6 +102,14 @@ class WindowClient extends ServiceClient {
     });
   }
 
+  /// Keep [size] palette engines pre-warmed so `create` skips engine startup.
+  ///
+  /// Warm engines run the default `paletteMain` entry point and wait for
+  /// their palette ID. Pass 0 to disable. No-op on platforms without a pool.
+  Future<void> configurePool(int size) async {
+    await send<void>('configurePool', params: {'size': size});
+  }
+
   // ════════════════════════════════════════════════════════════════════════
   // Events
   // ════════════════════════════════════════════════════════════════════════
@@ -76,8 +124,59 @@ class WindowClient extends ServiceClient {
     onWindowEvent(id, 'destroyed', (_) => callback());
   }
 
+  /// Called when a hidden keep-alive window's engine is suspended.
+  void onSuspended(String id, void Function() callback) {
+    onWindowEvent(id, 'suspended', (_) => callback());
+  }
+
+  /// Called when a suspended window's engine resumes (on show).
+  void onResumed(String id, void Function() callback) {
+    onWindowEvent(id, 'resumed', (_) => callback());
+  }
+
   /// Called when Flutter content is ready.
   void onContentReady(String id, void Function() callback) {
     onWindowEvent(id, 'contentReady', (_) => callback());
   }
 }
+
+/// Options for one window, as passed to [WindowClient.create] and
+/// [WindowClient.createMany].
+class WindowSpec {
+  const WindowSpec(
+    this.id, {
+    required this.appearance,
+    required this.size,
+    this.entryPoint,
+    this.keepAlive = false,
+    this.suspendAfter = PaletteBehavior.defaultSuspendAfter,
+  });
+
+  final String id;
+  final PaletteAppearance appearance;
+  final PaletteSize size;
+
+  /// Dart entry point; `paletteMain` when null.
+  final String? entryPoint;
+  final bool keepAlive;
+
+  /// Hidden time before a keep-alive engine is suspended; null never
+  /// suspends.
+  final Duration? suspendAfter;
+
+  Map<String, dynamic> toMap() => {
+        'id': id,
+        'entryPoint': entryPoint ?? 'paletteMain',
+        'cornerRadius': appearance.cornerRadius,
+        'shadow': appearance.shadow.name,
+        'transparent': appearance.transparent,
+        'debugBorder': appearance.debugBorder,
+        if (appearance.backgroundColor != null)
+          'backgroundColor': appearance.backgroundColor!.toARGB32(),
+        // Size config - stored on native side for runtime queries
+        ...size.toMap(),
+        'keepAlive': keepAlive,
+        // -1: never suspend.
+        'suspendAfterMs': suspendAfter?.inMilliseconds ?? -1,
+      };
+}
@@ -56,6 +56,17 @@ class ZOrderClient extends ServiceClient {
     });
   }
 
+  /// Stack palettes in [order] (top first) in one transaction.
+  ///
+  /// Only the relative order of the listed palettes is set; other windows
+  /// stay where they are. Native moves the fewest palettes needed, in one
+  /// batch, so reordering a whole stack costs one call and one
+  /// recomposition. Returns how many palettes moved.
+  Future<int> apply(List<String> order) async {
+    final result = await sendForMap('apply', params: {'order': order});
+    return (result?['moved'] as int?) ?? 0;
+  }
+
   /// Pin window to always be on top.
   Future<void> pin(String id, {PinLevel level = PinLevel.abovePalettes}) async {
     await send<void>('pin', windowId: id, params: {
@@ -2,6 +2,7 @@ import 'dart:async';
 
 import 'package:flutter/foundation.dart' show VoidCallback;
 
+import '../bridge/binary_codec.dart';
 import '../bridge/command.dart';
 import '../bridge/event.dart';
 import '../bridge/native_bridge.dart';
@@ -207,6 +208,10 @@ class MockNativeBridge implements NativeBridge {
   // NativeBridge Implementation
   // ════════════════════════════════════════════════════════════════════════════
 
+  /// Every command, read-only ones included, lands in [sentCommands].
+  @override
+  bool get answersQueriesLocally => false;
+
   @override
   Future<T?> send<T>(NativeCommand command) async {
     sentCommands.add(command);
@@ -234,13 +239,43 @@ class MockNativeBridge implements NativeBridge {
     return null;
   }
 
+  /// Runs each command through [send], so batched commands are recorded in
+  /// [sentCommands] and answered from the same stubs.
+  @override
+  Future<List<NativeBatchResult>> sendBatch(
+    List<NativeCommand> commands,
+  ) async {
+    return [
+      for (final command in commands)
+        NativeBatchResult.success(await send<dynamic>(command)),
+    ];
+  }
+
   @override
   void sendFireAndForget(NativeCommand command) {
     sentCommands.add(command);
   }
 
+  /// No binary channel: always null, so clients send the equivalent
+  /// command and it lands in [sentCommands].
+  @override
+  Future<BinaryMessage?> sendBinary(
+    String windowId,
+    int opcode, {
+    int flags = 0,
+    int arg = 0,
+    List<double> payload = const [],
+  }) async {
+    return null;
+  }
+
   @override
-  void subscribe(String service, NativeEventCallback callback) {
+  void subscribe(
+    String service,
+    NativeEventCallback callback, {
+    String? event,
+    String? windowId,
+  }) {
     _eventCallbacks.putIfAbsent(service, () => []).add(callback);
   }
 
@@ -1,5 +1,6 @@
 import 'package:flutter/services.dart';
 
+import '../runner/palette_channel.dart';
 import 'size_reporter.dart';
 
 /// Utility for palettes to control their own window.
@@ -16,7 +17,7 @@ import 'size_reporter.dart';
 /// ```
 class PaletteWindow {
   // Use the 'self' channel which is set up on each palette engine
-  static const _channel = MethodChannel('floating_palette/self');
+  static const _channel = PaletteChannel('floating_palette/self');
 
   PaletteWindow._();
 
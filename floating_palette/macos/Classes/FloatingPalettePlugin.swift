@@ -121,6 +121,11 @@ public class FloatingPalettePlugin: NSObject, FlutterPlugin {
     }
 
     public func handle(_ call: FlutterMethodCall, result: @escaping FlutterResult) {
+        if call.method == "batch" {
+            handleBatch(call.arguments as? [String: Any], result: result)
+            return
+        }
+
         guard call.method == "command",
               let args = call.arguments as? [String: Any],
               let service = args["service"] as? String,
@@ -132,6 +137,55 @@ public class FloatingPalettePlugin: NSObject, FlutterPlugin {
         let windowId = args["windowId"] as? String
         let params = args["params"] as? [String: Any] ?? [:]
 
+        dispatch(service: service, command: command, windowId: windowId, params: params, result: result)
+    }
+
+    /// Run an ordered list of commands in one channel hop.
+    /// Answers with one {ok, value} or {ok, code, message} entry per command.
+    private func handleBatch(_ args: [String: Any]?, result: @escaping FlutterResult) {
+        guard let commands = args?["commands"] as? [Any] else {
+            result(FlutterError(code: "INVALID_PARAMS", message: "batch requires a commands list", details: nil))
+            return
+        }
+        if commands.isEmpty {
+            result([Any]())
+            return
+        }
+
+        var results = [Any](repeating: NSNull(), count: commands.count)
+        var remaining = commands.count
+        for (index, entry) in commands.enumerated() {
+            let complete: FlutterResult = { value in
+                if let error = value as? FlutterError {
+                    results[index] = ["ok": false, "code": error.code, "message": error.message as Any]
+                } else if (value as AnyObject?) === FlutterMethodNotImplemented {
+                    results[index] = ["ok": false, "code": "NOT_IMPLEMENTED", "message": "Command not implemented"]
+                } else {
+                    results[index] = ["ok": true, "value": value ?? NSNull()]
+                }
+                remaining -= 1
+                if remaining == 0 {
+                    result(results)
+                }
+            }
+
+            guard let map = entry as? [String: Any],
+                  let service = map["service"] as? String,
+                  let command = map["command"] as? String else {
+                complete(FlutterError(code: "INVALID_PARAMS", message: "Batch entry \(index) requires service and command", details: nil))
+                continue
+            }
+            dispatch(
+                service: service,
+                command: command,
+                windowId: map["windowId"] as? String,
+                params: map["params"] as? [String: Any] ?? [:],
+                result: complete
+            )
+        }
+    }
+
+    private func dispatch(service: String, command: String, windowId: String?, params: [String: Any], result: @escaping FlutterResult) {
         // Route to appropriate service
         switch service {
         case "window":
@@ -7,6 +7,9 @@ final class WindowStore {
     static let shared = WindowStore()
 
     private var windows: [String: PaletteWindow] = [:]
+    private var handles: [String: Int32] = [:]
+    private var windowsByHandle: [Int32: PaletteWindow] = [:]
+    private var nextHandle: Int32 = 0
     private let lock = NSLock()
 
     private init() {}
@@ -19,6 +22,21 @@ final class WindowStore {
         return windows[id]
     }
 
+    /// Window for an FFI handle, or nil if the handle is stale.
+    func get(handle: Int32) -> PaletteWindow? {
+        lock.lock()
+        defer { lock.unlock() }
+        return windowsByHandle[handle]
+    }
+
+    /// FFI handle for a window id, or 0 if not stored.
+    /// Handles are never reused, so a stale handle can't alias a new window.
+    func handle(for id: String) -> Int32 {
+        lock.lock()
+        defer { lock.unlock() }
+        return handles[id] ?? 0
+    }
+
     func exists(_ id: String) -> Bool {
         lock.lock()
         defer { lock.unlock() }
@@ -36,13 +54,22 @@ final class WindowStore {
     func store(_ id: String, window: PaletteWindow) {
         lock.lock()
         defer { lock.unlock() }
+        if let old = handles[id] {
+            windowsByHandle.removeValue(forKey: old)
+        }
+        nextHandle = nextHandle == Int32.max ? 1 : nextHandle + 1
         windows[id] = window
+        handles[id] = nextHandle
+        windowsByHandle[nextHandle] = window
     }
 
     @discardableResult
     func remove(_ id: String) -> PaletteWindow? {
         lock.lock()
         defer { lock.unlock() }
+        if let handle = handles.removeValue(forKey: id) {
+            windowsByHandle.removeValue(forKey: handle)
+        }
         return windows.removeValue(forKey: id)
     }
 
@@ -50,6 +77,8 @@ final class WindowStore {
         lock.lock()
         defer { lock.unlock() }
         windows.removeAll()
+        handles.removeAll()
+        windowsByHandle.removeAll()
     }
 }
 
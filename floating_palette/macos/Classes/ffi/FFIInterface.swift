@@ -31,35 +31,40 @@ public func FloatingPalette_ResizeWindow(
         guard let window = WindowStore.shared.get(id) else {
             return
         }
+        resizePanel(window, width: width, height: height)
+    }
+}
 
-        let panel = window.panel
-        var frame = panel.frame
+/// Shared body of the id and handle resize entry points. Main thread only.
+private func resizePanel(_ window: PaletteWindow, width: Double, height: Double) {
+    let id = window.id
+    let panel = window.panel
+    var frame = panel.frame
 
-        // Skip if size hasn't changed meaningfully (within 1 pixel)
-        let widthDiff = abs(width - Double(frame.width))
-        let heightDiff = abs(height - Double(frame.height))
+    // Skip if size hasn't changed meaningfully (within 1 pixel)
+    let widthDiff = abs(width - Double(frame.width))
+    let heightDiff = abs(height - Double(frame.height))
 
-        if widthDiff < 1 && heightDiff < 1 {
-            // Size unchanged, but still trigger reveal if pending
-            if window.isPendingReveal {
-                VisibilityService.shared?.reveal(windowId: id)
-            }
-            return
+    if widthDiff < 1 && heightDiff < 1 {
+        // Size unchanged, but still trigger reveal if pending
+        if window.isPendingReveal {
+            VisibilityService.shared?.reveal(windowId: id)
         }
+        return
+    }
 
-        // Resize from top-left (keep origin, adjust for height change)
-        let heightChange = height - Double(frame.height)
-        frame.origin.y -= heightChange
-        frame.size.width = width
-        frame.size.height = height
+    // Resize from top-left (keep origin, adjust for height change)
+    let heightChange = height - Double(frame.height)
+    frame.origin.y -= heightChange
+    frame.size.width = width
+    frame.size.height = height
 
-        panel.setFrame(frame, display: true)
+    panel.setFrame(frame, display: true)
 
-        // Trigger reveal if this is the first resize after show
-        // This enables keyboard focus and sends the "shown" event
-        if window.isPendingReveal {
-            VisibilityService.shared?.reveal(windowId: id)
-        }
+    // Trigger reveal if this is the first resize after show
+    // This enables keyboard focus and sends the "shown" event
+    if window.isPendingReveal {
+        VisibilityService.shared?.reveal(windowId: id)
     }
 }
 
@@ -101,6 +106,67 @@ public func FloatingPalette_IsWindowVisible(
     return window.panel.isVisible
 }
 
+// MARK: - Window Handles
+
+/// Resolve a palette window id to an integer handle (0 if not found).
+@_cdecl("FloatingPalette_ResolveHandle")
+public func FloatingPalette_ResolveHandle(
+    windowId: UnsafePointer<CChar>
+) -> Int32 {
+    return WindowStore.shared.handle(for: String(cString: windowId))
+}
+
+/// Handle variant of FloatingPalette_ResizeWindow.
+/// Returns false if the handle is stale so the caller can re-resolve.
+@_cdecl("FloatingPalette_ResizeWindowByHandle")
+public func FloatingPalette_ResizeWindowByHandle(
+    handle: Int32,
+    width: Double,
+    height: Double
+) -> Bool {
+    guard let window = WindowStore.shared.get(handle: handle) else {
+        return false
+    }
+
+    DispatchQueue.main.async {
+        guard !window.isDestroyed else { return }
+        resizePanel(window, width: width, height: height)
+    }
+    return true
+}
+
+/// Handle variant of FloatingPalette_GetWindowFrame.
+@_cdecl("FloatingPalette_GetWindowFrameByHandle")
+public func FloatingPalette_GetWindowFrameByHandle(
+    handle: Int32,
+    outX: UnsafeMutablePointer<Double>,
+    outY: UnsafeMutablePointer<Double>,
+    outWidth: UnsafeMutablePointer<Double>,
+    outHeight: UnsafeMutablePointer<Double>
+) -> Bool {
+    guard let window = WindowStore.shared.get(handle: handle) else {
+        return false
+    }
+
+    let frame = window.panel.frame
+    outX.pointee = Double(frame.origin.x)
+    outY.pointee = Double(frame.origin.y)
+    outWidth.pointee = Double(frame.width)
+    outHeight.pointee = Double(frame.height)
+
+    return true
+}
+
+/// Handle variant of FloatingPalette_IsWindowVisible.
+@_cdecl("FloatingPalette_IsWindowVisibleByHandle")
+public func FloatingPalette_IsWindowVisibleByHandle(handle: Int32) -> Bool {
+    guard let window = WindowStore.shared.get(handle: handle) else {
+        return false
+    }
+
+    return window.panel.isVisible
+}
+
 // MARK: - Cursor Position
 
 /// Get the current cursor (mouse) position in screen coordinates.
@@ -21,6 +21,8 @@ final class AnimationService {
             animate(windowId: windowId, params: params, result: result)
         case "animateMultiple":
             animateMultiple(windowId: windowId, params: params, result: result)
+        case "animateGroup":
+            animateGroup(params: params, result: result)
         case "stop":
             stop(windowId: windowId, params: params, result: result)
         case "stopAll":
@@ -158,6 +160,25 @@ final class AnimationService {
         }
     }
 
+    // MARK: - Animate Group
+
+    /// Fan out one animateMultiple per window. Core Animation already drives
+    /// every panel from the same display link, so the groups stay in step.
+    private func animateGroup(params: [String: Any], result: @escaping FlutterResult) {
+        guard let windows = params["windows"] as? [[String: Any]] else {
+            result(FlutterError(code: "INVALID_PARAMS", message: "windows array required", details: nil))
+            return
+        }
+
+        for group in windows {
+            guard let id = group["windowId"] as? String, store.get(id) != nil else { continue }
+            var groupParams = params
+            groupParams["animations"] = group["animations"] ?? []
+            animateMultiple(windowId: id, params: groupParams, result: { _ in })
+        }
+        result(nil)
+    }
+
     private func markAnimationStarted(windowId: String, property: String) {
         if activeAnimations[windowId] == nil {
             activeAnimations[windowId] = []
@@ -33,6 +33,9 @@ final class GlassMaskService {
     // Window focus observers (to force redraw when focus changes)
     private var focusObservers: [String: [NSObjectProtocol]] = [:]
 
+    // Geometry reuse across path publishes (main thread only)
+    private let pathCache = GlassPathCache()
+
     private let lock = NSLock()
 
     /// Whether Liquid Glass (macOS 26+) is available
@@ -349,7 +352,7 @@ final class GlassMaskService {
             let preId = buffer.frameId
             let postId = buffer.frameIdPost
             if cmdCount > 0 && preId == postId {
-                initialPath = GlassPathBuilder.buildPath(from: buffer, flipY: false)
+                initialPath = pathCache.path(from: buffer, windowId: windowId, layerId: layerId, flipY: false)
             } else {
                 let rect = CGMutablePath()
                 rect.addRect(bounds)
@@ -499,7 +502,7 @@ final class GlassMaskService {
             let preId = buffer.frameId
             let postId = buffer.frameIdPost
             if cmdCount > 0 && preId == postId {
-                initialPath = GlassPathBuilder.buildPath(from: buffer, flipY: true)
+                initialPath = pathCache.path(from: buffer, windowId: windowId, layerId: layerId, flipY: true)
             } else {
                 let rect = CGMutablePath()
                 rect.addRect(bounds)
@@ -540,6 +543,7 @@ final class GlassMaskService {
         lastFrameIds.removeValue(forKey: windowId)
         usesLiquidGlass.removeValue(forKey: windowId)
         lock.unlock()
+        pathCache.removeAll(windowId: windowId)
 
         // Remove focus observers
         if let obs = observers {
@@ -680,7 +684,7 @@ final class GlassMaskService {
                 let mainBuffer = GlassPathBufferReader(ptr)
 
                 if useLiquidGlass {
-                    let path = GlassPathBuilder.buildPath(from: mainBuffer, flipY: false)
+                    let path = self.pathCache.path(from: mainBuffer, windowId: windowId, layerId: layerId, flipY: false)
 
                     if #available(macOS 26.0, *) {
                         if let glassState = states?[layerId] as? GlassPathState {
@@ -703,7 +707,7 @@ final class GlassMaskService {
                         }
                     }
                 } else {
-                    let path = GlassPathBuilder.buildPath(from: mainBuffer, flipY: true)
+                    let path = self.pathCache.path(from: mainBuffer, windowId: windowId, layerId: layerId, flipY: true)
                     maskLayerMap?[layerId]?.path = path
                 }
             }
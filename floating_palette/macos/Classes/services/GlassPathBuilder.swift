@@ -77,3 +77,137 @@ enum GlassPathBuilder {
         return path
     }
 }
+
+// MARK: - Path Cache
+
+/// Reuses glass mask geometry across path buffer publishes.
+///
+/// Dart republishes the full path on every frameId bump, even when the shape
+/// is unchanged (static rounded-rect palettes) or only moved/resized
+/// uniformly (a palette sliding in). Each publish is fingerprinted twice:
+/// - an exact hash of commands + points: identical path, reuse the CGPath;
+/// - a shape hash of the points normalized to their bounding box: same
+///   shape under translation/uniform scale, reuse the cached unit path
+///   through a CGAffineTransform instead of rebuilding it.
+///
+/// Main thread only (like the mask layers it feeds).
+final class GlassPathCache {
+    private struct Entry {
+        var exactHash: UInt64
+        let shapeHash: UInt64
+        /// Path in unit space: points mapped through (p - origin) / extent.
+        let unitPath: CGPath
+        var path: CGPath
+    }
+
+    private var entries: [String: [Int: Entry]] = [:]
+
+    private(set) var identicalHits: UInt64 = 0
+    private(set) var transformHits: UInt64 = 0
+    private(set) var rebuilds: UInt64 = 0
+
+    func path(from buffer: GlassPathBufferReader, windowId: String, layerId: Int, flipY: Bool) -> CGPath {
+        let commandCount = min(Int(buffer.commandCount), 1024)
+        let windowHeight = CGFloat(buffer.windowHeight)
+
+        // Gather the points actually referenced by the commands, in output
+        // space (flip applied) so translation is detected where it is drawn.
+        var points: [CGPoint] = []
+        points.reserveCapacity(Int(buffer.pointCount))
+        var floatIndex = 0
+        for cmdIndex in 0..<commandCount {
+            let pointsForCommand: Int
+            switch buffer.getCommand(at: cmdIndex) {
+            case 0, 1: pointsForCommand = 1
+            case 2: pointsForCommand = 2
+            case 3: pointsForCommand = 3
+            default: pointsForCommand = 0
+            }
+            for _ in 0..<pointsForCommand {
+                let x = CGFloat(buffer.getPoint(at: floatIndex))
+                let rawY = CGFloat(buffer.getPoint(at: floatIndex + 1))
+                points.append(CGPoint(x: x, y: flipY ? (windowHeight - rawY) : rawY))
+                floatIndex += 2
+            }
+        }
+
+        var exact = GlassPathHash()
+        for cmdIndex in 0..<commandCount { exact.add(buffer.getCommand(at: cmdIndex)) }
+        for p in points {
+            exact.add(Float(p.x).bitPattern)
+            exact.add(Float(p.y).bitPattern)
+        }
+
+        if let entry = entries[windowId]?[layerId], entry.exactHash == exact.value {
+            identicalHits &+= 1
+            return entry.path
+        }
+
+        // Normalize to the bounding box; quantize so float noise from the
+        // translation doesn't defeat the match.
+        var minX = CGFloat.greatestFiniteMagnitude, minY = CGFloat.greatestFiniteMagnitude
+        var maxX = -CGFloat.greatestFiniteMagnitude, maxY = -CGFloat.greatestFiniteMagnitude
+        for p in points {
+            minX = min(minX, p.x); minY = min(minY, p.y)
+            maxX = max(maxX, p.x); maxY = max(maxY, p.y)
+        }
+        let rawExtent = points.isEmpty ? 0 : max(maxX - minX, maxY - minY)
+        let extent = rawExtent.isFinite ? rawExtent : 0
+        let origin = points.isEmpty ? .zero : CGPoint(x: minX, y: minY)
+
+        var shape = GlassPathHash()
+        for cmdIndex in 0..<commandCount { shape.add(buffer.getCommand(at: cmdIndex)) }
+        if extent > 0 {
+            for p in points {
+                shape.add(Int32((Double((p.x - minX) / extent) * 65536).rounded()))
+                shape.add(Int32((Double((p.y - minY) / extent) * 65536).rounded()))
+            }
+        } else {
+            shape.add(exact.value)
+        }
+
+        let placement = CGAffineTransform(translationX: origin.x, y: origin.y)
+            .scaledBy(x: max(extent, 1e-6), y: max(extent, 1e-6))
+
+        if var entry = entries[windowId]?[layerId], entry.shapeHash == shape.value, extent > 0 {
+            transformHits &+= 1
+            var transform = placement
+            let moved = entry.unitPath.copy(using: &transform) ?? entry.unitPath
+            entry.exactHash = exact.value
+            entry.path = moved
+            entries[windowId, default: [:]][layerId] = entry
+            return moved
+        }
+
+        rebuilds &+= 1
+        let path = GlassPathBuilder.buildPath(from: buffer, flipY: flipY)
+        var inverse = placement.inverted()
+        let unitPath = extent > 0 ? (path.copy(using: &inverse) ?? path) : path
+        entries[windowId, default: [:]][layerId] = Entry(
+            exactHash: exact.value,
+            shapeHash: shape.value,
+            unitPath: unitPath,
+            path: path
+        )
+        return path
+    }
+
+    func removeAll(windowId: String) {
+        entries.removeValue(forKey: windowId)
+    }
+}
+
+/// FNV-1a over the path's command and point bytes.
+private struct GlassPathHash {
+    private(set) var value: UInt64 = 0xcbf29ce484222325
+
+    mutating func add<T: FixedWidthInteger>(_ x: T) {
+        var v = x.littleEndian
+        withUnsafeBytes(of: &v) { bytes in
+            for byte in bytes {
+                value ^= UInt64(byte)
+                value = value &* 0x100000001b3
+            }
+        }
+    }
+}
@@ -65,12 +65,19 @@ final class WindowService {
         switch command {
         case "create":
             create(params: params, result: result)
+        case "createMany":
+            createMany(params: params, result: result)
         case "destroy":
             destroy(windowId: windowId, result: result)
+        case "destroyMany":
+            destroyMany(params: params, result: result)
         case "exists":
             exists(windowId: windowId, result: result)
         case "setEntryPoint":
             setEntryPoint(windowId: windowId, params: params, result: result)
+        case "configurePool":
+            // Engine pre-warming is Windows-only; macOS engines start fast enough.
+            result(nil)
         default:
             result(FlutterError(code: "UNKNOWN_COMMAND", message: "Unknown window command: \(command)", details: nil))
         }
@@ -225,6 +232,46 @@ final class WindowService {
         }
     }
 
+    /// Create several windows; each goes through `create`. Reports created
+    /// ids in request order and failures by id with their error code.
+    private func createMany(params: [String: Any], result: @escaping FlutterResult) {
+        guard let specs = params["windows"] as? [[String: Any]] else {
+            result(FlutterError(code: "INVALID_PARAMS", message: "windows (list) required", details: nil))
+            return
+        }
+        let ids = specs.map { $0["id"] as? String }
+        guard !ids.contains(where: { $0 == nil }) else {
+            result(FlutterError(code: "INVALID_PARAMS", message: "Each window needs an id", details: nil))
+            return
+        }
+
+        // `create` stores windows asynchronously, so a repeated id has to be
+        // caught here rather than by its exists check.
+        var started = [String]()
+        var failed = [String: String]()
+        var errors = [String: String]()
+        let group = DispatchGroup()
+        for (spec, id) in zip(specs, ids.compactMap { $0 }) {
+            guard !started.contains(id) else {
+                failed[id] = "ALREADY_EXISTS"
+                continue
+            }
+            started.append(id)
+            group.enter()
+            create(params: spec, result: { value in
+                if let error = value as? FlutterError {
+                    errors[id] = error.code
+                }
+                group.leave()
+            })
+        }
+        group.notify(queue: .main) {
+            failed.merge(errors) { _, code in code }
+            let created = started.filter { errors[$0] == nil }
+            result(["created": created, "failed": failed])
+        }
+    }
+
     /// Recursively ensure view and all sublayers are transparent.
     /// Called after engine starts to catch lazily-created Metal layers.
     private func ensureViewTransparency(_ view: NSView) {
@@ -329,6 +376,36 @@ final class WindowService {
         }
     }
 
+    /// Destroy several windows; each goes through `destroy`.
+    private func destroyMany(params: [String: Any], result: @escaping FlutterResult) {
+        guard let ids = params["ids"] as? [String] else {
+            result(FlutterError(code: "INVALID_PARAMS", message: "ids (list) required", details: nil))
+            return
+        }
+
+        // A repeated id is destroyed once, so it can't also come back NOT_FOUND.
+        var seen = Set<String>()
+        let unique = ids.filter { seen.insert($0).inserted }
+
+        var destroyed = [String]()
+        var failed = [String: String]()
+        let group = DispatchGroup()
+        for id in unique {
+            group.enter()
+            destroy(windowId: id, result: { value in
+                if let error = value as? FlutterError {
+                    failed[id] = error.code
+                } else {
+                    destroyed.append(id)
+                }
+                group.leave()
+            })
+        }
+        group.notify(queue: .main) {
+            result(["destroyed": destroyed, "failed": failed])
+        }
+    }
+
     // MARK: - Exists
 
     private func exists(windowId: String?, result: @escaping FlutterResult) {
@@ -68,6 +68,100 @@ bool FloatingPalette_GetWindowFrame(
  */
 bool FloatingPalette_IsWindowVisible(const char* window_id);
 
+// ═══════════════════════════════════════════════════════════════════════════
+// WINDOW HANDLES
+// Per-frame callers resolve the window id once, then skip string handling
+// ═══════════════════════════════════════════════════════════════════════════
+
+/**
+ * Resolve a palette window id to an integer handle.
+ * The handle stays valid until the window is destroyed; after that the
+ * ..._ByHandle functions treat it as unknown (it is never reused for a
+ * different window).
+ *
+ * @param window_id  The palette window identifier
+ * @return           Handle (> 0), or 0 if the window does not exist
+ */
+int32_t FloatingPalette_ResolveHandle(const char* window_id);
+
+/**
+ * Handle variant of FloatingPalette_ResizeWindow.
+ *
+ * @param handle  Handle from FloatingPalette_ResolveHandle
+ * @param width   New width in logical pixels
+ * @param height  New height in logical pixels
+ * @return        false if the handle is stale (re-resolve), true otherwise
+ */
+bool FloatingPalette_ResizeWindowByHandle(
+    int32_t handle,
+    double width,
+    double height
+);
+
+/**
+ * Handle variant of FloatingPalette_GetWindowFrame.
+ *
+ * @param handle     Handle from FloatingPalette_ResolveHandle
+ * @param out_x      Output: X position (screen coordinates)
+ * @param out_y      Output: Y position (screen coordinates)
+ * @param out_width  Output: Window width
+ * @param out_height Output: Window height
+ * @return           true if the handle is valid, false otherwise
+ */
+bool FloatingPalette_GetWindowFrameByHandle(
+    int32_t handle,
+    double* out_x,
+    double* out_y,
+    double* out_width,
+    double* out_height
+);
+
+/**
+ * Handle variant of FloatingPalette_IsWindowVisible.
+ *
+ * @param handle  Handle from FloatingPalette_ResolveHandle
+ * @return        true if the handle is valid and the window is visible
+ */
+bool FloatingPalette_IsWindowVisibleByHandle(int32_t handle);
+
+/** One palette frame for the batched frame calls. Must match Dart. */
+typedef struct {
+    int32_t handle;  // From FloatingPalette_ResolveHandle
+    double x;        // Screen coordinates, as FloatingPalette_GetWindowFrame
+    double y;
+    double width;
+    double height;
+} FloatingPaletteFrame;
+
+/**
+ * Move and size several palette windows as one arrangement.
+ * The whole set is applied in a single window-manager transaction, so the
+ * compositor never shows it half moved. On Windows the change is applied
+ * on the platform thread shortly after this returns.
+ *
+ * @param frames  Target frames, in the units FloatingPalette_GetWindowFrame
+ *                reports
+ * @param count   Number of entries in frames
+ * @return        false if any handle is stale, in which case nothing moves
+ */
+bool FloatingPalette_SetWindowFramesByHandle(
+    const FloatingPaletteFrame* frames,
+    int32_t count
+);
+
+/**
+ * Read the frames of several palette windows in one call.
+ *
+ * @param frames  In: handle of each entry. Out: its frame; an entry with a
+ *                stale handle gets handle 0 and a zero frame
+ * @param count   Number of entries in frames
+ * @return        Number of entries whose handle was valid
+ */
+int32_t FloatingPalette_GetWindowFramesByHandle(
+    FloatingPaletteFrame* frames,
+    int32_t count
+);
+
 // ═══════════════════════════════════════════════════════════════════════════
 // CURSOR POSITION
 // Critical for .nearCursor() positioning - need exact position at show moment
@@ -182,6 +276,83 @@ int32_t FloatingPalette_GetActiveAppIdentifier(
     int32_t buffer_size
 );
 
+// ═══════════════════════════════════════════════════════════════════════════
+// PLACEMENT
+// Opening a palette at the cursor in one call: no separate cursor, screen,
+// scale and frame queries, and no Dart-side edge math
+// ═══════════════════════════════════════════════════════════════════════════
+
+/** Flip the anchor away from an overflowing edge, then clamp. */
+#define FLOATING_PALETTE_PLACEMENT_AVOID_EDGES 1
+/** Move the window to the solved frame as well. */
+#define FLOATING_PALETTE_PLACEMENT_APPLY 2
+
+/** Anchor spec for FloatingPalette_SolvePlacement. Must match Dart. */
+typedef struct {
+    int32_t handle;    // From FloatingPalette_ResolveHandle
+    int32_t target;    // 0 cursor, 1 primary screen center, 2 (x, y)
+    int32_t anchor;    // Dart Anchor index: 0 topLeft ... 8 bottomRight
+    int32_t flags;     // FLOATING_PALETTE_PLACEMENT_* bits
+    double x;          // Target 2 only, as FloatingPalette_GetCursorPosition
+    double y;
+    double offset_x;   // From the target point, logical pixels
+    double offset_y;
+    double width;      // Logical pixels; 0 keeps the window's current size
+    double height;
+} FloatingPalettePlacement;
+
+/**
+ * Solve an anchored palette frame against the monitor the target is on:
+ * anchor, offset, flip away from work-area edges that would clip it, and
+ * clamp into the work area. Optionally applies it. Windows only.
+ *
+ * @param placement  The anchor spec
+ * @param out_frame  Output: the frame, in the units
+ *                   FloatingPalette_GetWindowFrame reports (may be NULL)
+ * @return           false if the handle is stale or there is no screen
+ */
+bool FloatingPalette_SolvePlacement(
+    const FloatingPalettePlacement* placement,
+    FloatingPaletteFrame* out_frame
+);
+
+// ═══════════════════════════════════════════════════════════════════════════
+// WINDOW QUERIES
+// Read-only window state in the units the method channel reports, answered
+// from native caches on the calling thread instead of queueing behind
+// platform-thread work
+// ═══════════════════════════════════════════════════════════════════════════
+
+/** The window is shown, as visibility/isVisible. */
+#define FLOATING_PALETTE_WINDOW_VISIBLE 1
+/** The window is the foreground window, as focus/isFocused. */
+#define FLOATING_PALETTE_WINDOW_FOCUSED 2
+/** x, y, width and height are set (the frame has been read at least once). */
+#define FLOATING_PALETTE_WINDOW_HAS_FRAME 4
+
+/** One palette's state for FloatingPalette_QueryWindow. Must match Dart. */
+typedef struct {
+    int32_t handle;  // From FloatingPalette_ResolveHandle
+    int32_t flags;   // FLOATING_PALETTE_WINDOW_* bits
+    double x;        // Logical pixels, as frame/getBounds
+    double y;
+    double width;
+    double height;
+} FloatingPaletteWindowState;
+
+/**
+ * Read a palette's bounds, visibility and focus in one call. Windows only.
+ *
+ * @param handle     Handle from FloatingPalette_ResolveHandle
+ * @param out_state  Output: the window's state
+ * @return           false if the handle is stale (the window doesn't
+ *                   exist), in which case out_state is zeroed
+ */
+bool FloatingPalette_QueryWindow(
+    int32_t handle,
+    FloatingPaletteWindowState* out_state
+);
+
 // ═══════════════════════════════════════════════════════════════════════════
 // GLASS MASK EFFECT
 // Native NSVisualEffectView blur masked to arbitrary path from Flutter
@@ -364,6 +535,215 @@ void FloatingPalette_DestroyAnimationBuffer(
     int32_t layer_id
 );
 
+// ═══════════════════════════════════════════════════════════════════════════
+// MESSAGE RINGS (Windows)
+// Single-producer/single-consumer shared-memory rings so two engines in the
+// process (host and palette) can exchange high-rate messages without going
+// through the platform thread. Records are opaque bytes.
+// ═══════════════════════════════════════════════════════════════════════════
+
+/** Result of FloatingPalette_MessageRingWrite. Must match Dart. */
+typedef enum {
+    MessageRingWrite_Ok = 0,
+    MessageRingWrite_Overflowed = 1,  // Ring full; message not written
+    MessageRingWrite_Dropped = 2,     // Larger than the ring; not written
+} MessageRingWriteResult;
+
+/** Result of FloatingPalette_MessageRingRead. Must match Dart. */
+typedef enum {
+    MessageRingRead_Empty = 0,        // Nothing queued; doorbell armed
+    MessageRingRead_Ok = 1,
+    MessageRingRead_TooSmall = 2,     // *out_length is the size needed
+} MessageRingReadResult;
+
+/**
+ * Create (or open) the channel-0 ring for a palette window.
+ * Same as FloatingPalette_CreateMessageRingChannel(window_id, 0, capacity).
+ */
+void* FloatingPalette_CreateMessageRing(
+    const char* window_id,
+    uint32_t capacity
+);
+
+/**
+ * Create the ring for (window_id, channel), or return the existing one.
+ * Channel 0 is host → palette and 1 is palette → host by convention.
+ *
+ * @param window_id  The palette window identifier
+ * @param channel    Channel number
+ * @param capacity   Bytes, rounded up to a power of two (4 KiB - 64 MiB);
+ *                   ignored when the ring already exists
+ * @return           Opaque ring pointer, or NULL on failure
+ */
+void* FloatingPalette_CreateMessageRingChannel(
+    const char* window_id,
+    int32_t channel,
+    uint32_t capacity
+);
+
+/**
+ * Destroy a ring. Both ends must have stopped using it. Rings are also
+ * destroyed with their window.
+ */
+void FloatingPalette_DestroyMessageRing(
+    const char* window_id,
+    int32_t channel
+);
+
+/**
+ * Append one message (producer side). Rings the doorbell if the consumer
+ * is waiting, so this must not be bound as a leaf call.
+ *
+ * @return  MessageRingWriteResult
+ */
+int32_t FloatingPalette_MessageRingWrite(
+    void* ring,
+    const uint8_t* data,
+    uint32_t length
+);
+
+/**
+ * Take the oldest message (consumer side).
+ *
+ * @param out_buffer   Destination
+ * @param buffer_size  Size of out_buffer
+ * @param out_length   Message length (also set for TooSmall)
+ * @return             MessageRingReadResult
+ */
+int32_t FloatingPalette_MessageRingRead(
+    void* ring,
+    uint8_t* out_buffer,
+    uint32_t buffer_size,
+    uint32_t* out_length
+);
+
+/**
+ * Set the consumer's doorbell, called (from the producer's thread) on the
+ * first write after a read found the ring empty. NULL clears it.
+ */
+void FloatingPalette_SetMessageRingDoorbell(
+    void* ring,
+    void (*doorbell)(void)
+);
+
+/**
+ * Message counters for a ring.
+ */
+void FloatingPalette_GetMessageRingStats(
+    void* ring,
+    uint64_t* out_sent,
+    uint64_t* out_received,
+    uint64_t* out_dropped,
+    uint64_t* out_overflowed
+);
+
+// ═══════════════════════════════════════════════════════════════════════════
+// HIT-TEST MASKS (Windows)
+// Pointer passthrough answered natively on every hit test from rects Dart
+// publishes into shared memory, so moving over a transparent area costs no
+// channel message and no window style change from Dart.
+// ═══════════════════════════════════════════════════════════════════════════
+
+/** Meaning of a mask's rects. Must match Dart. */
+typedef enum {
+    PassthroughMode_None = 0,         // Everything hits the palette
+    PassthroughMode_Regions = 1,      // Rects pass through
+    PassthroughMode_Interactive = 2,  // Only rects hit the palette
+    PassthroughMode_All = 3,          // Everything passes through
+} PassthroughMode;
+
+/**
+ * Shared memory for a palette's hit-test mask (packed, 2072 bytes).
+ * Publish like GlassPathBuffer: frameIdPost, payload, then frameId.
+ */
+typedef struct __attribute__((packed)) {
+    uint64_t frameId;
+    uint32_t mode;                    // PassthroughMode
+    uint32_t rectCount;
+    float rects[128 * 4];             // x, y, width, height (logical px)
+    uint64_t frameIdPost;
+} HitTestMaskBuffer;
+
+/**
+ * Start answering hit tests from a shared mask. Until its first publish the
+ * mask set by input/setPassthrough applies.
+ *
+ * @param window_id  The palette window identifier
+ * @return           Buffer pointer (valid until the window is destroyed),
+ *                   or NULL if the window doesn't exist
+ */
+void* FloatingPalette_CreateHitTestMask(
+    const char* window_id
+);
+
+/**
+ * Stop reading the shared mask; input/setPassthrough applies again.
+ */
+void FloatingPalette_DestroyHitTestMask(
+    const char* window_id
+);
+
+// ═══════════════════════════════════════════════════════════════════════════
+// METRICS (Windows)
+// Native cost counters, the same numbers host/getMetrics reports. Reading
+// takes no locks, so a profiler can poll it from any thread.
+// ═══════════════════════════════════════════════════════════════════════════
+
+/** Command latency of one channel service. Must match Dart. */
+typedef struct {
+    uint64_t commands;
+    double p50_ms;                    // Handler time on the platform thread
+    double p99_ms;
+    double max_ms;
+} FloatingPaletteServiceMetrics;
+
+/** Process-wide counters. Must match Dart. */
+typedef struct {
+    uint64_t events_emitted;
+    uint64_t events_coalesced;
+    uint64_t event_flushes;           // Channel messages the events went out in
+    uint64_t window_pos_calls;        // Individual SetWindowPos calls
+    uint64_t window_pos_batches;      // DeferWindowPos transactions
+    uint64_t window_pos_batched_windows;
+    uint64_t animation_frames;
+    uint64_t animation_frames_dropped;
+    uint64_t capture_frames;
+    double capture_fps;               // Over the last full second
+} FloatingPaletteMetrics;
+
+/**
+ * Read the process-wide counters.
+ *
+ * @param out  Destination
+ */
+void FloatingPalette_GetMetrics(
+    FloatingPaletteMetrics* out
+);
+
+/**
+ * Read per-service command latencies, in the order of
+ * FloatingPalette_GetMetricsServiceName.
+ *
+ * @param out       Destination
+ * @param capacity  Number of entries out can hold
+ * @return          Number of services (may exceed capacity)
+ */
+int32_t FloatingPalette_GetServiceMetrics(
+    FloatingPaletteServiceMetrics* out,
+    int32_t capacity
+);
+
+/**
+ * Name of service slot `index` (e.g. "frame"), or NULL past the end. The
+ * last slot collects unknown services. Static storage; do not free.
+ */
+const char* FloatingPalette_GetMetricsServiceName(
+    int32_t index
+);
+
+/** Zero every counter. */
+void FloatingPalette_ResetMetrics(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -108,6 +108,55 @@ void main() {
     });
   });
 
+  // ════════════════════════════════════════════════════════════════════════════
+  // animateGroup
+  // ════════════════════════════════════════════════════════════════════════════
+
+  group('animateGroup', () {
+    test('sends one command covering every window', () async {
+      await client.animateGroup(
+        windows: [
+          const WindowAnimations(
+            windowId: 'toolbar',
+            animations: [
+              PropertyAnimation(property: AnimatableProperty.y, from: 0, to: 40),
+            ],
+          ),
+          const WindowAnimations(
+            windowId: 'inspector',
+            animations: [
+              PropertyAnimation(property: AnimatableProperty.x, from: 0, to: 300),
+              PropertyAnimation(
+                property: AnimatableProperty.opacity,
+                from: 0,
+                to: 1,
+              ),
+            ],
+          ),
+        ],
+        durationMs: 250,
+        curve: 'easeInOut',
+      );
+
+      expect(mock.sentCommands, hasLength(1));
+      final cmd = mock.sentCommands.first;
+      expect(cmd.service, equals('animation'));
+      expect(cmd.command, equals('animateGroup'));
+      expect(cmd.windowId, isNull);
+      expect(cmd.params['durationMs'], equals(250));
+      expect(cmd.params['curve'], equals('easeInOut'));
+
+      final windows = cmd.params['windows'] as List<dynamic>;
+      expect(windows, hasLength(2));
+      expect(windows[0]['windowId'], equals('toolbar'));
+      expect(windows[0]['animations'], hasLength(1));
+      expect(windows[1]['windowId'], equals('inspector'));
+      final inspector = windows[1]['animations'] as List<dynamic>;
+      expect(inspector[1]['property'], equals('opacity'));
+      expect(inspector[1]['to'], equals(1.0));
+    });
+  });
+
   // ════════════════════════════════════════════════════════════════════════════
   // stop
   // ════════════════════════════════════════════════════════════════════════════
@@ -1,4 +1,4 @@
-import 'package:flutter/painting.dart' show EdgeInsets;
+import 'package:flutter/painting.dart' show EdgeInsets, Rect;
 import 'package:flutter/services.dart';
 import 'package:flutter_test/flutter_test.dart';
 
@@ -184,6 +184,74 @@ void main() {
       expect(receivedArgs!['paddingLeft'], equals(10.0));
     });
 
+    test('passes tracking and adaptive rate params', () async {
+      Map<dynamic, dynamic>? receivedArgs;
+      TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+          .setMockMethodCallHandler(channel, (call) async {
+        if (call.method == 'backgroundCapture.start') {
+          receivedArgs = call.arguments as Map<dynamic, dynamic>?;
+          return 1;
+        }
+        return null;
+      });
+
+      await client.startCapture(
+        config: const BackgroundCaptureConfig(
+          dragFrameRate: 45,
+          adaptiveFrameRate: false,
+          region: Rect.fromLTWH(8, 16, 120, 40),
+        ),
+      );
+
+      expect(receivedArgs!['dragFrameRate'], equals(45));
+      expect(receivedArgs!['adaptiveFrameRate'], isFalse);
+      expect(
+        receivedArgs!['region'],
+        equals({'x': 8.0, 'y': 16.0, 'width': 120.0, 'height': 40.0}),
+      );
+    });
+
+    test('omits region by default', () async {
+      Map<dynamic, dynamic>? receivedArgs;
+      TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+          .setMockMethodCallHandler(channel, (call) async {
+        if (call.method == 'backgroundCapture.start') {
+          receivedArgs = call.arguments as Map<dynamic, dynamic>?;
+          return 1;
+        }
+        return null;
+      });
+
+      await client.startCapture();
+
+      expect(receivedArgs!['adaptiveFrameRate'], isTrue);
+      expect(receivedArgs!.containsKey('region'), isFalse);
+    });
+
+    test('passes blurred output params', () async {
+      Map<dynamic, dynamic>? receivedArgs;
+      TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+          .setMockMethodCallHandler(channel, (call) async {
+        if (call.method == 'backgroundCapture.start') {
+          receivedArgs = call.arguments as Map<dynamic, dynamic>?;
+          return 1;
+        }
+        return null;
+      });
+
+      await client.startCapture(
+        config: const BackgroundCaptureConfig(
+          output: BackgroundCaptureOutput.blurred,
+          downsample: 8,
+          blurPasses: 2,
+        ),
+      );
+
+      expect(receivedArgs!['output'], equals('blurred'));
+      expect(receivedArgs!['downsample'], equals(8));
+      expect(receivedArgs!['blurPasses'], equals(2));
+    });
+
     test('emits started event on success', () async {
       TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
           .setMockMethodCallHandler(channel, (call) async {
@@ -339,6 +407,37 @@ void main() {
     });
   });
 
+  // ════════════════════════════════════════════════════════════════════════════
+  // getStats
+  // ════════════════════════════════════════════════════════════════════════════
+
+  group('getStats', () {
+    test('returns frame counters', () async {
+      TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+          .setMockMethodCallHandler(channel, (call) async {
+        if (call.method == 'backgroundCapture.getStats') {
+          return {'framesCopied': 12, 'framesDropped': 3, 'framesLate': 1};
+        }
+        return null;
+      });
+
+      final result = await client.getStats();
+
+      expect(result!['framesCopied'], equals(12));
+      expect(result['framesDropped'], equals(3));
+      expect(result['framesLate'], equals(1));
+    });
+
+    test('returns null when the platform does not report stats', () async {
+      TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+          .setMockMethodCallHandler(channel, (call) async {
+        throw PlatformException(code: 'UNKNOWN_COMMAND');
+      });
+
+      expect(await client.getStats(), isNull);
+    });
+  });
+
   // ════════════════════════════════════════════════════════════════════════════
   // events stream
   // ════════════════════════════════════════════════════════════════════════════
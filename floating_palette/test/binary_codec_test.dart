@@ -0,0 +1,60 @@
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+
+import 'package:floating_palette/src/bridge/binary_codec.dart';
+
+void main() {
+  group('BinaryMessage', () {
+    test('encodes the fixed little-endian layout', () {
+      final data = const BinaryMessage(
+        opcode: BinaryOpcode.setBounds,
+        handle: 0x00010002,
+        flags: BinaryFlags.animate,
+        arg: 250,
+        payload: [10, 20.5, 300, 200],
+      ).encode();
+
+      expect(data.lengthInBytes, BinaryMessage.size);
+      expect(data.getUint16(0, Endian.little), BinaryOpcode.setBounds);
+      expect(data.getUint16(2, Endian.little), BinaryFlags.animate);
+      expect(data.getInt32(4, Endian.little), 0x00010002);
+      expect(data.getInt32(8, Endian.little), 250);
+      expect(data.getFloat32(12, Endian.little), 10);
+      expect(data.getFloat32(16, Endian.little), 20.5);
+      expect(data.getFloat32(32, Endian.little), 0);
+    });
+
+    test('round-trips through decode', () {
+      final decoded = BinaryMessage.decode(const BinaryMessage(
+        opcode: BinaryOpcode.followerDragging,
+        handle: 7,
+        arg: 9,
+        payload: [12.5, 1, 2, 3, 4],
+      ).encode())!;
+
+      expect(decoded.opcode, BinaryOpcode.followerDragging);
+      expect(decoded.handle, 7);
+      expect(decoded.arg, 9);
+      expect(decoded.payload, [12.5, 1, 2, 3, 4, 0]);
+      expect(decoded.ok, isTrue);
+    });
+
+    test('decode rejects anything but one message', () {
+      expect(BinaryMessage.decode(ByteData(BinaryMessage.size - 1)), isNull);
+      expect(BinaryMessage.decode(ByteData(BinaryMessage.size * 2)), isNull);
+    });
+  });
+
+  group('BinaryFlags.curve', () {
+    test('puts known curves in the high byte', () {
+      expect(BinaryFlags.curve('linear'), 0);
+      expect(BinaryFlags.curve('easeInOut'), 3 << 8);
+      expect(BinaryFlags.curve('easeIn'), 4 << 8);
+    });
+
+    test('has no index for other curves', () {
+      expect(BinaryFlags.curve('spring'), isNull);
+    });
+  });
+}
@@ -168,6 +168,7 @@ void main() {
       expect(b.draggable, false);
       expect(b.onHideFocus, FocusRestoreMode.mainWindow);
       expect(b.group, isNull);
+      expect(b.suspendAfter, PaletteBehavior.defaultSuspendAfter);
     });
 
     test('.modal() preset', () {
@@ -246,6 +247,7 @@ void main() {
       expect(map['draggable'], false);
       expect(map['onHideFocus'], 'mainWindow');
       expect(map['group'], isNull);
+      expect(map['suspendAfterMs'], 30000);
     });
   });
 
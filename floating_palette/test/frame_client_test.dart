@@ -196,6 +196,69 @@ void main() {
     });
   });
 
+  // ════════════════════════════════════════════════════════════════════════════
+  // setBoundsMany / getBoundsMany
+  // ════════════════════════════════════════════════════════════════════════════
+
+  group('setBoundsMany', () {
+    test('sends every frame in one command', () async {
+      await client.setBoundsMany({
+        'w1': const Rect.fromLTWH(0, 0, 100, 50),
+        'w2': const Rect.fromLTWH(100, 0, 200, 50),
+      });
+
+      expect(mock.sentCommands, hasLength(1));
+      final cmd = mock.sentCommands.first;
+      expect(cmd.service, equals('frame'));
+      expect(cmd.command, equals('setBoundsMany'));
+      expect(cmd.windowId, isNull);
+      expect(cmd.params['frames'], equals([
+        {'id': 'w1', 'x': 0.0, 'y': 0.0, 'width': 100.0, 'height': 50.0},
+        {'id': 'w2', 'x': 100.0, 'y': 0.0, 'width': 200.0, 'height': 50.0},
+      ]));
+      expect(cmd.params['animate'], isFalse);
+    });
+
+    test('passes animation options', () async {
+      await client.setBoundsMany(
+        {'w1': const Rect.fromLTWH(0, 0, 100, 50)},
+        animate: true,
+        durationMs: 250,
+        curve: 'easeOut',
+      );
+
+      final cmd = mock.sentCommands.first;
+      expect(cmd.params['animate'], isTrue);
+      expect(cmd.params['durationMs'], equals(250));
+      expect(cmd.params['curve'], equals('easeOut'));
+    });
+  });
+
+  group('getBoundsMany', () {
+    test('sends ids and parses frames keyed by id', () async {
+      mock.stubResponse('frame', 'getBoundsMany', {
+        'w1': {'x': 10.0, 'y': 20.0, 'width': 300.0, 'height': 200.0},
+        'w2': {'x': 310.0, 'y': 20, 'width': 100, 'height': 200.0},
+      });
+
+      final result = await client.getBoundsMany(['w1', 'w2', 'missing']);
+
+      final cmd = mock.sentCommands.first;
+      expect(cmd.command, equals('getBoundsMany'));
+      expect(cmd.params['ids'], equals(['w1', 'w2', 'missing']));
+      expect(result, equals({
+        'w1': const Rect.fromLTWH(10, 20, 300, 200),
+        'w2': const Rect.fromLTWH(310, 20, 100, 200),
+      }));
+    });
+
+    test('returns an empty map on null response', () async {
+      final result = await client.getBoundsMany(['w1']);
+
+      expect(result, isEmpty);
+    });
+  });
+
   // ════════════════════════════════════════════════════════════════════════════
   // setDraggable
   // ════════════════════════════════════════════════════════════════════════════
@@ -253,6 +316,64 @@ void main() {
     });
   });
 
+  group('onDragStarted / onDragEnded', () {
+    test('onDragStarted fires with the drag start position', () {
+      Offset? received;
+      client.onDragStarted('w1', (pos) => received = pos);
+
+      mock.simulateEvent(const NativeEvent(
+        service: 'frame',
+        event: 'dragStarted',
+        windowId: 'w1',
+        data: {'x': 5.0, 'y': 6.0},
+      ));
+
+      expect(received, equals(const Offset(5, 6)));
+    });
+
+    test('onDragEnded parses position, velocity and cancelled', () {
+      Offset? position;
+      Offset? velocity;
+      bool? cancelled;
+      client.onDragEnded('w1', (p, v, c) {
+        position = p;
+        velocity = v;
+        cancelled = c;
+      });
+
+      mock.simulateEvent(const NativeEvent(
+        service: 'frame',
+        event: 'dragEnded',
+        windowId: 'w1',
+        data: {
+          'x': 100.0,
+          'y': 200.0,
+          'velocityX': 850.0,
+          'velocityY': -120,
+          'cancelled': false,
+        },
+      ));
+
+      expect(position, equals(const Offset(100, 200)));
+      expect(velocity, equals(const Offset(850, -120)));
+      expect(cancelled, isFalse);
+    });
+
+    test('onDragEnded defaults missing velocity to zero', () {
+      Offset? velocity;
+      client.onDragEnded('w1', (_, v, _) => velocity = v);
+
+      mock.simulateEvent(const NativeEvent(
+        service: 'frame',
+        event: 'dragEnded',
+        windowId: 'w1',
+        data: {'x': 1.0, 'y': 2.0},
+      ));
+
+      expect(velocity, equals(Offset.zero));
+    });
+  });
+
   group('onResized', () {
     test('fires callback with parsed Size', () {
       Size? received;
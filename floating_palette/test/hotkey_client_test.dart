@@ -0,0 +1,133 @@
+import 'package:flutter/services.dart';
+import 'package:flutter_test/flutter_test.dart';
+
+import 'package:floating_palette/src/bridge/event.dart';
+import 'package:floating_palette/src/services/hotkey_client.dart';
+import 'package:floating_palette/src/testing/mock_native_bridge.dart';
+
+void main() {
+  TestWidgetsFlutterBinding.ensureInitialized();
+
+  late MockNativeBridge mock;
+  late HotkeyClient client;
+
+  setUp(() {
+    mock = MockNativeBridge();
+    mock.stubDefaults();
+    client = HotkeyClient(mock);
+  });
+
+  tearDown(() {
+    client.dispose();
+    mock.reset();
+  });
+
+  // ════════════════════════════════════════════════════════════════════════════
+  // register
+  // ════════════════════════════════════════════════════════════════════════════
+
+  group('register', () {
+    test('sends keyId, modifiers and the bound window', () async {
+      await client.register(
+        'launcher',
+        LogicalKeyboardKey.space,
+        modifiers: {HotkeyModifier.alt, HotkeyModifier.shift},
+        windowId: 'w1',
+      );
+
+      expect(mock.sentCommands, hasLength(1));
+      final cmd = mock.sentCommands.first;
+      expect(cmd.service, equals('hotkey'));
+      expect(cmd.command, equals('register'));
+      expect(cmd.windowId, equals('w1'));
+      expect(cmd.params['hotkeyId'], equals('launcher'));
+      expect(cmd.params['keyId'], equals(LogicalKeyboardKey.space.keyId));
+      expect(cmd.params['modifiers'], equals(['alt', 'shift']));
+      expect(cmd.params['focus'], isTrue);
+      expect(cmd.params['repeat'], isFalse);
+      expect(cmd.params.containsKey('action'), isFalse);
+    });
+
+    test('sends action when given', () async {
+      await client.register(
+        'toggle',
+        LogicalKeyboardKey.f1,
+        windowId: 'w1',
+        action: HotkeyAction.toggle,
+        focus: false,
+      );
+
+      final cmd = mock.sentCommands.first;
+      expect(cmd.params['action'], equals('toggle'));
+      expect(cmd.params['focus'], isFalse);
+    });
+  });
+
+  // ════════════════════════════════════════════════════════════════════════════
+  // unregister
+  // ════════════════════════════════════════════════════════════════════════════
+
+  group('unregister', () {
+    test('sends hotkeyId', () async {
+      await client.unregister('launcher');
+
+      final cmd = mock.sentCommands.first;
+      expect(cmd.service, equals('hotkey'));
+      expect(cmd.command, equals('unregister'));
+      expect(cmd.params['hotkeyId'], equals('launcher'));
+    });
+
+    test('unregisterAll sends correct command', () async {
+      await client.unregisterAll();
+
+      final cmd = mock.sentCommands.first;
+      expect(cmd.command, equals('unregisterAll'));
+    });
+  });
+
+  // ════════════════════════════════════════════════════════════════════════════
+  // Events
+  // ════════════════════════════════════════════════════════════════════════════
+
+  group('onTriggered', () {
+    test('reports hotkey, window and outcome', () {
+      String? hotkeyId;
+      String? windowId;
+      HotkeyOutcome? outcome;
+      client.onTriggered((h, w, o) {
+        hotkeyId = h;
+        windowId = w;
+        outcome = o;
+      });
+
+      mock.simulateEvent(const NativeEvent(
+        service: 'hotkey',
+        event: 'triggered',
+        windowId: 'w1',
+        data: {'hotkeyId': 'launcher', 'action': 'hidden'},
+      ));
+
+      expect(hotkeyId, equals('launcher'));
+      expect(windowId, equals('w1'));
+      expect(outcome, equals(HotkeyOutcome.hidden));
+    });
+
+    test('notify-only hotkeys have no window', () {
+      String? windowId = 'unset';
+      HotkeyOutcome? outcome;
+      client.onTriggered((_, w, o) {
+        windowId = w;
+        outcome = o;
+      });
+
+      mock.simulateEvent(const NativeEvent(
+        service: 'hotkey',
+        event: 'triggered',
+        data: {'hotkeyId': 'search', 'action': 'notified'},
+      ));
+
+      expect(windowId, isNull);
+      expect(outcome, equals(HotkeyOutcome.notified));
+    });
+  });
+}
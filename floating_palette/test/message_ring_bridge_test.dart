@@ -0,0 +1,117 @@
+import 'dart:async';
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+
+import 'package:floating_palette/src/ffi/message_ring_bridge.dart';
+
+void main() {
+  final bridge = MessageRingBridge.instance;
+
+  group('MessageRingBridge', () {
+    test('write results match native MessageRingWriteResult', () {
+      expect(MessageRingWriteResult.ok.index, 0);
+      expect(MessageRingWriteResult.overflowed.index, 1);
+      expect(MessageRingWriteResult.dropped.index, 2);
+    });
+
+    test('open returns null when rings are unavailable', () {
+      if (bridge.isAvailable) return;
+      expect(bridge.open('ring-test'), isNull);
+      // destroy() is a no-op rather than a crash.
+      bridge.destroy('ring-test');
+    });
+  });
+
+  // Needs floating_palette_plugin.dll (Windows); skipped elsewhere.
+  group('MessageRing', () {
+    const windowId = 'message-ring-bridge-test';
+    const channel = 7;
+
+    tearDown(() => bridge.destroy(windowId, channel: channel));
+
+    test('both ends share one ring and keep order', () {
+      final producer = bridge.open(windowId, channel: channel)!;
+      final consumer = bridge.open(windowId, channel: channel)!;
+      addTearDown(producer.close);
+      addTearDown(consumer.close);
+
+      for (var i = 0; i < 3; i++) {
+        expect(
+          producer.write(Uint8List.fromList([i, i + 1])),
+          MessageRingWriteResult.ok,
+        );
+      }
+      expect(producer.write(Uint8List(0)), MessageRingWriteResult.ok);
+
+      final messages = consumer.drain();
+      expect(messages.map((m) => m.toList()), [
+        [0, 1],
+        [1, 2],
+        [2, 3],
+        <int>[],
+      ]);
+      expect(consumer.read(), isNull);
+      expect(consumer.stats.sent, 4);
+      expect(consumer.stats.received, 4);
+    }, skip: !bridge.isAvailable);
+
+    test('reads messages larger than the scratch buffer', () {
+      final producer = bridge.open(windowId, channel: channel)!;
+      final consumer = bridge.open(windowId, channel: channel)!;
+      addTearDown(producer.close);
+      addTearDown(consumer.close);
+
+      final large = Uint8List.fromList(List.generate(10000, (i) => i & 0xFF));
+      expect(producer.write(large), MessageRingWriteResult.ok);
+      expect(consumer.read(), large);
+    }, skip: !bridge.isAvailable);
+
+    test('reports dropped for messages larger than the ring', () {
+      final producer =
+          bridge.open(windowId, channel: channel, capacity: 4096)!;
+      addTearDown(producer.close);
+
+      expect(producer.write(Uint8List(8192)), MessageRingWriteResult.dropped);
+      expect(producer.stats.dropped, 1);
+    }, skip: !bridge.isAvailable);
+
+    test('a ring destroyed while open stays usable until closed', () {
+      final producer = bridge.open(windowId, channel: channel)!;
+      final consumer = bridge.open(windowId, channel: channel)!;
+
+      bridge.destroy(windowId, channel: channel);
+      expect(
+        producer.write(Uint8List.fromList([42])),
+        MessageRingWriteResult.ok,
+      );
+      expect(consumer.read(), [42]);
+
+      producer.close();
+      consumer.close();
+      // A closed end refuses further use instead of touching the ring.
+      expect(producer.write(Uint8List(1)), MessageRingWriteResult.dropped);
+      expect(consumer.read(), isNull);
+    }, skip: !bridge.isAvailable);
+
+    test('listen delivers a burst after the doorbell rings', () async {
+      final producer = bridge.open(windowId, channel: channel)!;
+      final consumer = bridge.open(windowId, channel: channel)!;
+      addTearDown(producer.close);
+      addTearDown(consumer.close);
+
+      final received = <int>[];
+      final done = Completer<void>();
+      consumer.listen((messages) {
+        received.addAll(messages.map((m) => m.single));
+        if (received.length == 5) done.complete();
+      });
+      for (var i = 0; i < 5; i++) {
+        producer.write(Uint8List.fromList([i]));
+      }
+      await done.future.timeout(const Duration(seconds: 5));
+
+      expect(received, [0, 1, 2, 3, 4]);
+    }, skip: !bridge.isAvailable);
+  });
+}
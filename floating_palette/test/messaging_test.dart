@@ -1,3 +1,5 @@
+import 'dart:typed_data';
+
 import 'package:flutter_test/flutter_test.dart';
 import 'package:floating_palette/src/bridge/event.dart';
 import 'package:floating_palette/src/events/palette_event.dart';
@@ -145,6 +147,17 @@ void main() {
       expect(cmd.params['data'], equals({}));
     });
 
+    test('sendBytesToPalette forwards bytes as data', () async {
+      final bytes = Uint8List.fromList([9, 8, 7]);
+      await client.sendBytesToPalette('inspector', 'selection', bytes);
+
+      final cmd = mockBridge.sentCommands[0];
+      expect(cmd.command, equals('send'));
+      expect(cmd.windowId, equals('inspector'));
+      expect(cmd.params['type'], equals('selection'));
+      expect(cmd.params['data'], equals([9, 8, 7]));
+    });
+
     test('dispose clears all callbacks', () async {
       client.onMessage((_) {});
       client.on('test', (_) {});
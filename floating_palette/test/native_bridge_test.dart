@@ -1,9 +1,13 @@
+import 'dart:async';
+
 import 'package:flutter/services.dart';
 import 'package:flutter_test/flutter_test.dart';
 
+import 'package:floating_palette/src/bridge/binary_codec.dart';
 import 'package:floating_palette/src/bridge/command.dart';
 import 'package:floating_palette/src/bridge/event.dart';
 import 'package:floating_palette/src/bridge/native_bridge.dart';
+import 'package:floating_palette/src/bridge/read_only_queries.dart';
 
 void main() {
   TestWidgetsFlutterBinding.ensureInitialized();
@@ -420,6 +424,428 @@ void main() {
       expect(str, contains('Unknown error'));
     });
   });
+
+  group('Batched events', () {
+    test('events list is dispatched in order', () async {
+      final events = <NativeEvent>[];
+      bridge.subscribeAll((event) => events.add(event));
+
+      await _simulateNativeEvents(channel, [
+        {
+          'service': 'frame',
+          'event': 'moved',
+          'windowId': 'test-1',
+          'data': <String, dynamic>{'x': 10.0, 'y': 20.0},
+        },
+        {
+          'service': 'visibility',
+          'event': 'hidden',
+          'windowId': 'test-1',
+          'data': <String, dynamic>{},
+        },
+      ]);
+
+      expect(events, hasLength(2));
+      expect(events[0].service, 'frame');
+      expect(events[0].event, 'moved');
+      expect(events[0].data['x'], 10.0);
+      expect(events[1].service, 'visibility');
+      expect(events[1].event, 'hidden');
+    });
+
+    test('events list routes to service subscribers', () async {
+      final frameEvents = <NativeEvent>[];
+      bridge.subscribe('frame', (event) => frameEvents.add(event));
+
+      await _simulateNativeEvents(channel, [
+        {
+          'service': 'visibility',
+          'event': 'shown',
+          'windowId': 'test-1',
+          'data': <String, dynamic>{},
+        },
+        {
+          'service': 'frame',
+          'event': 'resized',
+          'windowId': 'test-1',
+          'data': <String, dynamic>{'width': 300.0, 'height': 200.0},
+        },
+      ]);
+
+      expect(frameEvents, hasLength(1));
+      expect(frameEvents.single.event, 'resized');
+    });
+  });
+
+  group('Event interest', () {
+    late List<Map<String, dynamic>> interest;
+
+    setUp(() {
+      interest = [];
+      TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+          .setMockMethodCallHandler(channel, (call) async {
+        final args = Map<String, dynamic>.from(call.arguments as Map);
+        if (args['service'] == 'host') interest.add(args);
+        return null;
+      });
+    });
+
+    test('first listener subscribes, last one unsubscribes', () async {
+      void first(NativeEvent _) {}
+      void second(NativeEvent _) {}
+
+      bridge.subscribe('frame', first, event: 'moved', windowId: 'w1');
+      bridge.subscribe('frame', second, event: 'moved', windowId: 'w1');
+      await Future<void>.delayed(Duration.zero);
+
+      expect(interest, hasLength(1));
+      expect(interest.single['command'], 'subscribe');
+      expect(interest.single['windowId'], 'w1');
+      expect(interest.single['params']['service'], 'frame');
+      expect(interest.single['params']['event'], 'moved');
+
+      bridge.unsubscribe('frame', first);
+      await Future<void>.delayed(Duration.zero);
+      expect(interest, hasLength(1));
+
+      bridge.unsubscribe('frame', second);
+      await Future<void>.delayed(Duration.zero);
+      expect(interest, hasLength(2));
+      expect(interest.last['command'], 'unsubscribe');
+      expect(interest.last['params']['event'], 'moved');
+    });
+
+    test('service and global listeners declare wildcards', () async {
+      bridge.subscribe('message', (_) {});
+      bridge.subscribeAll((_) {});
+      await Future<void>.delayed(Duration.zero);
+
+      expect(interest, hasLength(2));
+      expect(interest[0]['params'], {'service': 'message', 'event': '*'});
+      expect(interest[0]['windowId'], isNull);
+      expect(interest[1]['params'], {'service': '*', 'event': '*'});
+    });
+  });
+
+  group('Binary channel', () {
+    const binaryName = '$channelName/binary';
+    final messenger =
+        TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger;
+    late List<Map<String, dynamic>> commands;
+
+    setUp(() {
+      commands = [];
+      messenger.setMockMethodCallHandler(channel, (call) async {
+        final args = Map<String, dynamic>.from(call.arguments as Map);
+        commands.add(args);
+        return args['command'] == 'bindBinary' ? 42 : null;
+      });
+    });
+
+    tearDown(() {
+      messenger.setMockMessageHandler(binaryName, null);
+    });
+
+    /// Answer every request with [status] and [payload].
+    void answer({
+      int status = BinaryStatus.ok,
+      List<double> payload = const [],
+    }) {
+      messenger.setMockMessageHandler(binaryName, (data) async {
+        final request = BinaryMessage.decode(data!)!;
+        return BinaryMessage(
+          opcode: request.opcode,
+          handle: request.handle,
+          flags: status,
+          payload: payload,
+        ).encode();
+      });
+    }
+
+    int bindCount() =>
+        commands.where((c) => c['command'] == 'bindBinary').length;
+
+    test('binds once, then answers from the binary reply', () async {
+      answer(payload: const [1, 2, 3, 4]);
+
+      final first = await bridge.sendBinary('w1', BinaryOpcode.getBounds);
+      final second = await bridge.sendBinary('w1', BinaryOpcode.getBounds);
+
+      expect(bindCount(), 1);
+      expect(commands.single['service'], 'frame');
+      expect(commands.single['windowId'], 'w1');
+      expect(first!.handle, 42);
+      expect(first.payload.take(4), [1, 2, 3, 4]);
+      expect(second, isNotNull);
+    });
+
+    test('returns null and stops trying without a binary channel', () async {
+      expect(await bridge.sendBinary('w1', BinaryOpcode.getBounds), isNull);
+      expect(await bridge.sendBinary('w2', BinaryOpcode.getBounds), isNull);
+
+      expect(bindCount(), 1);
+    });
+
+    test('binds again after the window went away', () async {
+      answer(status: BinaryStatus.notFound);
+      expect(await bridge.sendBinary('w1', BinaryOpcode.getBounds), isNull);
+
+      answer();
+      expect(await bridge.sendBinary('w1', BinaryOpcode.getBounds), isNotNull);
+      expect(bindCount(), 2);
+    });
+
+    test('drag moves arrive as frame moved events', () async {
+      answer();
+      await bridge.sendBinary('w1', BinaryOpcode.getBounds);
+      final events = <NativeEvent>[];
+      bridge.subscribe('frame', events.add);
+
+      await messenger.handlePlatformMessage(
+        binaryName,
+        const BinaryMessage(
+          opcode: BinaryOpcode.dragMoved,
+          handle: 42,
+          payload: [10, 20],
+        ).encode(),
+        (_) {},
+      );
+
+      expect(events, hasLength(1));
+      expect(events.single.event, 'moved');
+      expect(events.single.windowId, 'w1');
+      expect(events.single.data, {'x': 10.0, 'y': 20.0});
+    });
+
+    test('events for unbound handles are dropped', () async {
+      final events = <NativeEvent>[];
+      bridge.subscribeAll(events.add);
+
+      await messenger.handlePlatformMessage(
+        binaryName,
+        const BinaryMessage(opcode: BinaryOpcode.dragMoved, handle: 7)
+            .encode(),
+        (_) {},
+      );
+
+      expect(events, isEmpty);
+    });
+  });
+
+  group('Batch', () {
+    test('sendBatch sends all commands in one batch call', () async {
+      final calls = <MethodCall>[];
+
+      TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+          .setMockMethodCallHandler(channel, (call) async {
+        calls.add(call);
+        return [
+          {'ok': true, 'value': null},
+          {'ok': true, 'value': true},
+        ];
+      });
+
+      await bridge.sendBatch(const [
+        NativeCommand(
+          service: 'frame',
+          command: 'setPosition',
+          windowId: 'test-1',
+          params: {'x': 10.0, 'y': 20.0},
+        ),
+        NativeCommand(
+          service: 'visibility',
+          command: 'show',
+          windowId: 'test-1',
+        ),
+      ]);
+
+      expect(calls, hasLength(1));
+      expect(calls.single.method, 'batch');
+      final args = Map<String, dynamic>.from(calls.single.arguments as Map);
+      final commands = args['commands'] as List;
+      expect(commands, hasLength(2));
+      expect(commands[0]['service'], 'frame');
+      expect(commands[0]['command'], 'setPosition');
+      expect(commands[0]['params']['x'], 10.0);
+      expect(commands[1]['service'], 'visibility');
+      expect(commands[1]['windowId'], 'test-1');
+    });
+
+    test('sendBatch keeps per-command errors', () async {
+      TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+          .setMockMethodCallHandler(channel, (call) async {
+        return [
+          {'ok': false, 'code': 'NOT_FOUND', 'message': 'Window not found'},
+          {'ok': true, 'value': 42},
+        ];
+      });
+
+      final results = await bridge.sendBatch(const [
+        NativeCommand(service: 'frame', command: 'getSize', windowId: 'x'),
+        NativeCommand(service: 'zorder', command: 'getZIndex', windowId: 'y'),
+      ]);
+
+      expect(results, hasLength(2));
+      expect(results[0].ok, isFalse);
+      expect(results[0].code, 'NOT_FOUND');
+      expect(results[0].message, 'Window not found');
+      expect(results[1].ok, isTrue);
+      expect(results[1].value, 42);
+    });
+
+    test('sendBatch with no commands skips the channel', () async {
+      var called = false;
+
+      TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+          .setMockMethodCallHandler(channel, (call) async {
+        called = true;
+        return null;
+      });
+
+      final results = await bridge.sendBatch(const []);
+
+      expect(results, isEmpty);
+      expect(called, isFalse);
+    });
+  });
+
+  group('Read-only queries', () {
+    late _FakeQueries queries;
+    late NativeBridge local;
+    late List<MethodCall> calls;
+
+    setUp(() {
+      queries = _FakeQueries();
+      local = NativeBridge(
+        channelName: channelName,
+        commandTimeout: const Duration(seconds: 2),
+        queries: queries,
+      );
+      calls = [];
+      TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+          .setMockMethodCallHandler(channel, (call) async {
+        calls.add(call);
+        return false;
+      });
+    });
+
+    tearDown(() => local.dispose());
+
+    test('classifies only state reads as read-only', () {
+      expect(
+        ReadOnlyQueries.isReadOnly(const NativeCommand(
+            service: 'frame', command: 'getBounds', windowId: 'w')),
+        isTrue,
+      );
+      expect(
+        ReadOnlyQueries.isReadOnly(const NativeCommand(
+            service: 'screen', command: 'getCursorPosition')),
+        isTrue,
+      );
+      expect(
+        ReadOnlyQueries.isReadOnly(const NativeCommand(
+            service: 'frame', command: 'setPosition', windowId: 'w')),
+        isFalse,
+      );
+    });
+
+    test('answers read-only commands without the channel', () async {
+      queries.answers['window.exists'] = true;
+
+      final exists = await local.send<bool>(const NativeCommand(
+        service: 'window',
+        command: 'exists',
+        windowId: 'w',
+      ));
+
+      expect(exists, isTrue);
+      expect(calls, isEmpty);
+      expect(local.answersQueriesLocally, isTrue);
+    });
+
+    test('sends a query it cannot answer to native', () async {
+      final exists = await local.send<bool>(const NativeCommand(
+        service: 'window',
+        command: 'exists',
+        windowId: 'w',
+      ));
+
+      expect(exists, isFalse);
+      expect(calls, hasLength(1));
+    });
+
+    test('never answers other commands locally', () async {
+      queries.answers['window.destroy'] = true;
+
+      await local.send<void>(const NativeCommand(
+        service: 'window',
+        command: 'destroy',
+        windowId: 'w',
+      ));
+
+      expect(queries.asked, isEmpty);
+      expect(calls, hasLength(1));
+    });
+
+    test('queues a query behind a command in flight for its window',
+        () async {
+      queries.answers['visibility.isVisible'] = true;
+      final release = Completer<void>();
+      TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+          .setMockMethodCallHandler(channel, (call) async {
+        calls.add(call);
+        final args = call.arguments as Map;
+        if (args['command'] == 'show') await release.future;
+        return true;
+      });
+
+      final show = local.send<void>(const NativeCommand(
+        service: 'visibility',
+        command: 'show',
+        windowId: 'w',
+      ));
+      await local.send<bool>(const NativeCommand(
+        service: 'visibility',
+        command: 'isVisible',
+        windowId: 'w',
+      ));
+      await local.send<bool>(const NativeCommand(
+        service: 'visibility',
+        command: 'isVisible',
+        windowId: 'other',
+      ));
+      release.complete();
+      await show;
+
+      // 'w' went to native behind show; 'other' was answered locally.
+      expect(queries.asked, ['other']);
+      expect(
+        calls.map((c) => (c.arguments as Map)['command']),
+        ['show', 'isVisible'],
+      );
+
+      await local.send<bool>(const NativeCommand(
+        service: 'visibility',
+        command: 'isVisible',
+        windowId: 'w',
+      ));
+      expect(queries.asked, ['other', 'w']);
+    });
+  });
+}
+
+/// Answers from [answers] keyed by 'service.command'; records the window
+/// of every query it was asked.
+class _FakeQueries implements ReadOnlyQueries {
+  final answers = <String, Object?>{};
+  final asked = <String?>[];
+
+  @override
+  LocalAnswer? answer(NativeCommand command) {
+    asked.add(command.windowId);
+    final key = '${command.service}.${command.command}';
+    return answers.containsKey(key) ? (value: answers[key]) : null;
+  }
 }
 
 /// Simulate a native event being sent to the Dart side via MethodChannel.
@@ -430,3 +856,12 @@ Future<void> _simulateNativeEvent(
   await TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
       .handlePlatformMessage(channel.name, message, (_) {});
 }
+
+/// Simulate a coalesced `events` delivery from native.
+Future<void> _simulateNativeEvents(
+    MethodChannel channel, List<Map<String, dynamic>> events) async {
+  final message =
+      const StandardMethodCodec().encodeMethodCall(MethodCall('events', events));
+  await TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+      .handlePlatformMessage(channel.name, message, (_) {});
+}
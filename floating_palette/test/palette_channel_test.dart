@@ -0,0 +1,69 @@
+import 'package:flutter/services.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:floating_palette/src/runner/palette_channel.dart';
+
+void main() {
+  TestWidgetsFlutterBinding.ensureInitialized();
+
+  const entry = MethodChannel('floating_palette/entry');
+  const channel = PaletteChannel('floating_palette/self');
+  final messenger =
+      TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger;
+
+  late List<String> log;
+
+  setUp(() {
+    log = [];
+    PaletteChannel.resetForTesting();
+    messenger.setMockMethodCallHandler(channel, (call) async {
+      log.add(call.method);
+      return {'width': 1.0};
+    });
+  });
+
+  tearDown(() {
+    messenger.setMockMethodCallHandler(entry, null);
+    messenger.setMockMethodCallHandler(channel, null);
+  });
+
+  group('PaletteChannel', () {
+    test('opens the native channel once, before the first call', () async {
+      messenger.setMockMethodCallHandler(entry, (call) async {
+        log.add('${call.method}:${call.arguments}');
+        return null;
+      });
+
+      await channel.invokeMethod<void>('startDrag');
+      await channel.invokeMapMethod<String, dynamic>('getSize');
+
+      expect(log, [
+        'openChannel:floating_palette/self',
+        'startDrag',
+        'getSize',
+      ]);
+    });
+
+    test('treats a missing openChannel as already open', () async {
+      final result = await channel.invokeMapMethod<String, dynamic>('getSize');
+
+      expect(result, {'width': 1.0});
+      expect(log, ['getSize']);
+    });
+
+    test('retries opening after a failure', () async {
+      var fail = true;
+      messenger.setMockMethodCallHandler(entry, (call) async {
+        log.add(call.method);
+        if (fail) throw PlatformException(code: 'ERROR');
+        return null;
+      });
+
+      await expectLater(channel.invokeMethod<void>('startDrag'),
+          throwsA(isA<PlatformException>()));
+      fail = false;
+      await channel.invokeMethod<void>('startDrag');
+
+      expect(log, ['openChannel', 'openChannel', 'startDrag']);
+    });
+  });
+}
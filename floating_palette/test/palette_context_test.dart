@@ -1,3 +1,5 @@
+import 'dart:typed_data';
+
 import 'package:flutter/services.dart';
 import 'package:flutter_test/flutter_test.dart';
 import 'package:floating_palette/src/events/palette_event.dart';
@@ -114,6 +116,26 @@ void main() {
       expect(received[0].$2, equals({'key': 'value'}));
     });
 
+    test('onBytes receives binary messages', () async {
+      PaletteContext.init('bytes-palette');
+      final ctx = PaletteContext.current;
+
+      final received = <(String, Uint8List)>[];
+      final messages = <String>[];
+      ctx.onBytes((type, data) => received.add((type, data)));
+      ctx.onMessage((type, _) => messages.add(type));
+
+      await _simulateIncomingMessageRaw({
+        'type': 'selection',
+        'data': Uint8List.fromList([1, 2, 3]),
+      });
+
+      expect(received.length, equals(1));
+      expect(received[0].$1, equals('selection'));
+      expect(received[0].$2, equals([1, 2, 3]));
+      expect(messages, isEmpty);
+    });
+
     test('on<T> receives typed events', () async {
       PaletteContext.init('typed-palette');
       final ctx = PaletteContext.current;
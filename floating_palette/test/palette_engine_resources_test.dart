@@ -0,0 +1,47 @@
+import 'package:flutter/painting.dart';
+import 'package:flutter/services.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:floating_palette/src/runner/palette_engine_resources.dart';
+
+void main() {
+  TestWidgetsFlutterBinding.ensureInitialized();
+
+  group('PaletteEngineResources', () {
+    final skiaCalls = <MethodCall>[];
+
+    setUp(() {
+      skiaCalls.clear();
+      TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+          .setMockMethodCallHandler(SystemChannels.skia, (call) async {
+        skiaCalls.add(call);
+        return null;
+      });
+    });
+
+    tearDown(() {
+      TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+          .setMockMethodCallHandler(SystemChannels.skia, null);
+    });
+
+    test('configure caps the image cache and the GPU cache', () async {
+      await PaletteEngineResources.configure();
+
+      final cache = PaintingBinding.instance.imageCache;
+      expect(cache.maximumSizeBytes,
+          equals(PaletteEngineResources.imageCacheBytes));
+      expect(cache.maximumSize,
+          equals(PaletteEngineResources.imageCacheEntries));
+      expect(skiaCalls, hasLength(1));
+      expect(skiaCalls.single.method, equals('Skia.setResourceCacheMaxBytes'));
+      expect(skiaCalls.single.arguments,
+          equals(PaletteEngineResources.gpuCacheBytes));
+    });
+
+    test('configure tolerates a renderer without a Skia channel', () async {
+      TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+          .setMockMethodCallHandler(SystemChannels.skia, null);
+
+      await expectLater(PaletteEngineResources.configure(), completes);
+    });
+  });
+}
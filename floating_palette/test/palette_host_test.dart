@@ -140,6 +140,47 @@ void main() {
       expect(mock.wasCalledFor('window', 'destroy', 'orphan-window'), true);
     });
 
+    test('recover() accepts the full native snapshot entry', () async {
+      final host = PaletteHost.forTesting(bridge: mock);
+      final controller = host.palette('follower');
+
+      mock.stubResponse('host', 'getSnapshot', [
+        {
+          'id': 'follower',
+          'handle': 65537,
+          'engine': 12345678,
+          'visible': true,
+          'focused': false,
+          'x': 10.0,
+          'y': 20.0,
+          'width': 200.0,
+          'height': 100.0,
+          'zIndex': 0,
+          'topmost': true,
+          'keepAlive': true,
+          'draggable': true,
+          'snap': {
+            'targetId': 'target',
+            'followerEdge': 'top',
+            'targetEdge': 'bottom',
+            'alignment': 'center',
+            'gap': 4.0,
+            'hidden': false,
+            'config': {
+              'onTargetHidden': 'hideFollower',
+              'onTargetDestroyed': 'hideAndDetach',
+            },
+          },
+        },
+      ]);
+
+      await host.recover();
+
+      expect(controller.isVisible, true);
+      expect(controller.isWarm, true);
+      expect(mock.wasCalled('window', 'destroy'), false);
+    });
+
     test('recover() handles empty snapshot', () async {
       final host = PaletteHost.forTesting(bridge: mock);
       host.palette('test');
@@ -258,6 +258,29 @@ void main() {
     });
   });
 
+  group('onActiveAppChanged', () {
+    test('fires callback with parsed ActiveAppInfo', () {
+      ActiveAppInfo? received;
+      client.onActiveAppChanged((app) => received = app);
+
+      mock.simulateEvent(const NativeEvent(
+        service: 'screen',
+        event: 'activeAppChanged',
+        data: {
+          'x': 100.0,
+          'y': 50.0,
+          'width': 800.0,
+          'height': 600.0,
+          'appName': 'notepad.exe',
+        },
+      ));
+
+      expect(received, isNotNull);
+      expect(received!.bounds, equals(const Rect.fromLTWH(100, 50, 800, 600)));
+      expect(received!.appName, equals('notepad.exe'));
+    });
+  });
+
   group('onWindowScreenChanged', () {
     test('fires callback with parsed screen index', () {
       int? received;
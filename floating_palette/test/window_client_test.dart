@@ -72,6 +72,24 @@ void main() {
       expect(cmd.params['keepAlive'], isTrue);
     });
 
+    test('passes suspendAfter in milliseconds, -1 for never', () async {
+      await client.create(
+        'w1',
+        appearance: const PaletteAppearance(),
+        size: const PaletteSize(width: 200),
+        suspendAfter: const Duration(seconds: 5),
+      );
+      await client.create(
+        'w2',
+        appearance: const PaletteAppearance(),
+        size: const PaletteSize(width: 200),
+        suspendAfter: null,
+      );
+
+      expect(mock.sentCommands[0].params['suspendAfterMs'], equals(5000));
+      expect(mock.sentCommands[1].params['suspendAfterMs'], equals(-1));
+    });
+
     test('returns window ID from stub', () async {
       // stubDefaults sets up a handler that returns the windowId
       final result = await client.create(
@@ -100,6 +118,94 @@ void main() {
     });
   });
 
+  // ════════════════════════════════════════════════════════════════════════════
+  // createMany / destroyMany
+  // ════════════════════════════════════════════════════════════════════════════
+
+  group('createMany', () {
+    test('sends every window in one command with create params', () async {
+      await client.createMany([
+        const WindowSpec(
+          'w1',
+          appearance: PaletteAppearance(),
+          size: PaletteSize(width: 200),
+        ),
+        const WindowSpec(
+          'w2',
+          appearance: PaletteAppearance(),
+          size: PaletteSize(width: 300),
+          entryPoint: 'customEntry',
+          keepAlive: true,
+          suspendAfter: null,
+        ),
+      ]);
+
+      expect(mock.sentCommands, hasLength(1));
+      final cmd = mock.sentCommands.first;
+      expect(cmd.service, equals('window'));
+      expect(cmd.command, equals('createMany'));
+      expect(cmd.windowId, isNull);
+      final windows = cmd.params['windows'] as List;
+      expect(windows, hasLength(2));
+      expect(windows[0]['id'], equals('w1'));
+      expect(windows[0]['entryPoint'], equals('paletteMain'));
+      expect(windows[0]['width'], equals(200.0));
+      expect(windows[1]['id'], equals('w2'));
+      expect(windows[1]['entryPoint'], equals('customEntry'));
+      expect(windows[1]['keepAlive'], isTrue);
+      expect(windows[1]['suspendAfterMs'], equals(-1));
+    });
+
+    test('parses created ids and failures', () async {
+      mock.stubResponse('window', 'createMany', {
+        'created': ['w1'],
+        'failed': {'w2': 'ALREADY_EXISTS'},
+      });
+
+      final result = await client.createMany([
+        const WindowSpec(
+          'w1',
+          appearance: PaletteAppearance(),
+          size: PaletteSize(width: 200),
+        ),
+        const WindowSpec(
+          'w2',
+          appearance: PaletteAppearance(),
+          size: PaletteSize(width: 200),
+        ),
+      ]);
+
+      expect(result.created, equals(['w1']));
+      expect(result.failed, equals({'w2': 'ALREADY_EXISTS'}));
+    });
+
+    test('returns empty results when native returns null', () async {
+      final result = await client.createMany(const []);
+
+      expect(result.created, isEmpty);
+      expect(result.failed, isEmpty);
+    });
+  });
+
+  group('destroyMany', () {
+    test('sends ids and parses the result', () async {
+      mock.stubResponse('window', 'destroyMany', {
+        'destroyed': ['w1', 'w2'],
+        'failed': {'missing': 'NOT_FOUND'},
+      });
+
+      final result = await client.destroyMany(['w1', 'w2', 'missing']);
+
+      expect(mock.sentCommands, hasLength(1));
+      final cmd = mock.sentCommands.first;
+      expect(cmd.command, equals('destroyMany'));
+      expect(cmd.windowId, isNull);
+      expect(cmd.params['ids'], equals(['w1', 'w2', 'missing']));
+      expect(result.destroyed, equals(['w1', 'w2']));
+      expect(result.failed, equals({'missing': 'NOT_FOUND'}));
+    });
+  });
+
   // ════════════════════════════════════════════════════════════════════════════
   // exists
   // ════════════════════════════════════════════════════════════════════════════
@@ -137,6 +243,22 @@ void main() {
     });
   });
 
+  // ════════════════════════════════════════════════════════════════════════════
+  // configurePool
+  // ════════════════════════════════════════════════════════════════════════════
+
+  group('configurePool', () {
+    test('sends size without windowId', () async {
+      await client.configurePool(2);
+
+      final cmd = mock.sentCommands.first;
+      expect(cmd.service, equals('window'));
+      expect(cmd.command, equals('configurePool'));
+      expect(cmd.windowId, isNull);
+      expect(cmd.params['size'], equals(2));
+    });
+  });
+
   // ════════════════════════════════════════════════════════════════════════════
   // Events
   // ════════════════════════════════════════════════════════════════════════════
@@ -202,4 +324,23 @@ void main() {
       expect(fired, isTrue);
     });
   });
+
+  group('onSuspended / onResumed', () {
+    test('fire on the matching events', () {
+      final events = <String>[];
+      client.onSuspended('w1', () => events.add('suspended'));
+      client.onResumed('w1', () => events.add('resumed'));
+
+      for (final event in ['suspended', 'resumed']) {
+        mock.simulateEvent(NativeEvent(
+          service: 'window',
+          event: event,
+          windowId: 'w1',
+          data: const {},
+        ));
+      }
+
+      expect(events, equals(['suspended', 'resumed']));
+    });
+  });
 }
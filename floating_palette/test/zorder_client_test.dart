@@ -186,6 +186,33 @@ void main() {
     });
   });
 
+  // ════════════════════════════════════════════════════════════════════════════
+  // apply
+  // ════════════════════════════════════════════════════════════════════════════
+
+  group('apply', () {
+    test('sends the whole order in one command', () async {
+      await client.apply(['a', 'b', 'c']);
+
+      expect(mock.sentCommands, hasLength(1));
+      final cmd = mock.sentCommands.first;
+      expect(cmd.service, equals('zorder'));
+      expect(cmd.command, equals('apply'));
+      expect(cmd.windowId, isNull);
+      expect(cmd.params['order'], equals(['a', 'b', 'c']));
+    });
+
+    test('returns the number of palettes moved', () async {
+      mock.stubResponse('zorder', 'apply', {'moved': 2});
+
+      expect(await client.apply(['a', 'b', 'c']), equals(2));
+    });
+
+    test('returns 0 on null response', () async {
+      expect(await client.apply(['a']), equals(0));
+    });
+  });
+
   // ════════════════════════════════════════════════════════════════════════════
   // Events
   // ════════════════════════════════════════════════════════════════════════════
@@ -0,0 +1,92 @@
+#include "alloc_counter.h"
+
+#include <malloc.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace floating_palette {
+namespace bench {
+
+namespace {
+
+std::atomic<uint64_t> allocations{0};
+std::atomic<uint64_t> bytes{0};
+
+void Count(size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+void* Allocate(size_t size) {
+  Count(size);
+  return std::malloc(size ? size : 1);
+}
+
+void* AllocateAligned(size_t size, std::align_val_t alignment) {
+  Count(size);
+  return _aligned_malloc(size ? size : 1, static_cast<size_t>(alignment));
+}
+
+}  // namespace
+
+AllocationCount AllocationsSoFar() {
+  AllocationCount count;
+  count.allocations = allocations.load(std::memory_order_relaxed);
+  count.bytes = bytes.load(std::memory_order_relaxed);
+  return count;
+}
+
+}  // namespace bench
+}  // namespace floating_palette
+
+using floating_palette::bench::Allocate;
+using floating_palette::bench::AllocateAligned;
+
+void* operator new(size_t size) {
+  if (void* block = Allocate(size)) return block;
+  throw std::bad_alloc();
+}
+void* operator new[](size_t size) {
+  if (void* block = Allocate(size)) return block;
+  throw std::bad_alloc();
+}
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return Allocate(size);
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return Allocate(size);
+}
+void* operator new(size_t size, std::align_val_t alignment) {
+  if (void* block = AllocateAligned(size, alignment)) return block;
+  throw std::bad_alloc();
+}
+void* operator new[](size_t size, std::align_val_t alignment) {
+  if (void* block = AllocateAligned(size, alignment)) return block;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* block) noexcept { std::free(block); }
+void operator delete[](void* block) noexcept { std::free(block); }
+void operator delete(void* block, size_t) noexcept { std::free(block); }
+void operator delete[](void* block, size_t) noexcept { std::free(block); }
+void operator delete(void* block, const std::nothrow_t&) noexcept {
+  std::free(block);
+}
+void operator delete[](void* block, const std::nothrow_t&) noexcept {
+  std::free(block);
+}
+void operator delete(void* block, std::align_val_t) noexcept {
+  _aligned_free(block);
+}
+void operator delete[](void* block, std::align_val_t) noexcept {
+  _aligned_free(block);
+}
+void operator delete(void* block, size_t, std::align_val_t) noexcept {
+  _aligned_free(block);
+}
+void operator delete[](void* block, size_t, std::align_val_t) noexcept {
+  _aligned_free(block);
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+namespace floating_palette {
+namespace bench {
+
+/// Running totals of heap allocations made through operator new in this
+/// executable. The bench replaces the global operator new and delete
+/// (alloc_counter.cpp), so plugin code, the Flutter C++ wrapper and the
+/// standard library all count; allocations inside flutter_windows.dll
+/// don't.
+struct AllocationCount {
+  uint64_t allocations = 0;
+  uint64_t bytes = 0;
+};
+
+/// Totals so far, all threads. Subtract two readings around the code being
+/// measured.
+AllocationCount AllocationsSoFar();
+
+}  // namespace bench
+}  // namespace floating_palette
@@ -0,0 +1,14 @@
+#include <windows.h>
+
+#include <benchmark/benchmark.h>
+
+int main(int argc, char** argv) {
+  // Per-monitor DPI, as in a Flutter runner, so DPI and frame queries take
+  // the same paths they do in an app.
+  SetProcessDpiAwarenessContext(DPI_AWARENESS_CONTEXT_PER_MONITOR_AWARE_V2);
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,260 @@
+#include <benchmark/benchmark.h>
+#include <flutter/method_call.h>
+#include <flutter/method_channel.h>
+#include <flutter/standard_method_codec.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../core/binary_codec.h"
+#include "../floating_palette_plugin.h"
+#include "../services/animation_service.h"
+#include "../services/binary_channel.h"
+#include "../services/frame_service.h"
+#include "alloc_counter.h"
+#include "fixtures.h"
+
+namespace floating_palette {
+namespace bench {
+
+namespace {
+
+constexpr char kChannelName[] = "floating_palette";
+
+/// The plugin as RegisterWithRegistrar builds it, minus the registrar: the
+/// method channel sits on a BenchMessenger, and every call is an encoded
+/// message delivered to the handler the plugin installed, so it pays for
+/// decoding, routing and the encoded reply like an engine message does.
+///
+/// With no registrar the plugin's own binary channel has no messenger, so
+/// a BinaryChannel over a standalone FrameService stands in for it; a
+/// binary request goes through the same HandleMessage either way.
+class BenchPlugin {
+ public:
+  using Channel = flutter::MethodChannel<flutter::EncodableValue>;
+
+  BenchPlugin()
+      : plugin_(nullptr,
+                std::make_unique<Channel>(
+                    &messenger_, kChannelName,
+                    &flutter::StandardMethodCodec::GetInstance())),
+        binary_channel_(&messenger_, &frame_service_,
+                        animation_service_.engine()),
+        windows_(16) {}
+
+  void Call(const std::vector<uint8_t>& message) const {
+    messenger_.Deliver(kChannelName, message);
+  }
+
+  void CallBinary(const std::vector<uint8_t>& message) const {
+    messenger_.Deliver(BinaryChannel::kChannelName, message);
+  }
+
+  WindowHandle handle(size_t index) const { return windows_.handles()[index]; }
+
+ private:
+  BenchMessenger messenger_;
+  FloatingPalettePlugin plugin_;
+  FrameService frame_service_;
+  AnimationService animation_service_;
+  BinaryChannel binary_channel_;
+  BenchWindows windows_;
+};
+
+std::unique_ptr<BenchPlugin> plugin;
+
+void CreatePlugin(const benchmark::State&) {
+  plugin = std::make_unique<BenchPlugin>();
+}
+void DestroyPlugin(const benchmark::State&) { plugin.reset(); }
+
+flutter::EncodableMap CommandArgs(const char* service, const char* command,
+                                  const char* window_id) {
+  flutter::EncodableMap args{
+      {flutter::EncodableValue("service"), flutter::EncodableValue(service)},
+      {flutter::EncodableValue("command"), flutter::EncodableValue(command)},
+      {flutter::EncodableValue("params"),
+       flutter::EncodableValue(flutter::EncodableMap{})},
+  };
+  if (window_id) {
+    args[flutter::EncodableValue("windowId")] =
+        flutter::EncodableValue(window_id);
+  }
+  return args;
+}
+
+std::vector<uint8_t> Encode(const char* method, flutter::EncodableValue args) {
+  flutter::MethodCall<flutter::EncodableValue> call(
+      method, std::make_unique<flutter::EncodableValue>(std::move(args)));
+  return *flutter::StandardMethodCodec::GetInstance().EncodeMethodCall(call);
+}
+
+std::vector<uint8_t> Command(const char* service, const char* command,
+                             const char* window_id) {
+  return Encode("command", flutter::EncodableValue(
+                               CommandArgs(service, command, window_id)));
+}
+
+void BM_Dispatch_HostPing(benchmark::State& state) {
+  auto call = Command("host", "ping", nullptr);
+  for (auto _ : state) plugin->Call(call);
+}
+BENCHMARK(BM_Dispatch_HostPing)
+    ->Setup(CreatePlugin)
+    ->Teardown(DestroyPlugin);
+
+void BM_Dispatch_FrameGetBounds(benchmark::State& state) {
+  auto call = Command("frame", "getBounds", "bench-3");
+  for (auto _ : state) plugin->Call(call);
+}
+BENCHMARK(BM_Dispatch_FrameGetBounds)
+    ->Setup(CreatePlugin)
+    ->Teardown(DestroyPlugin);
+
+/// The same query as BM_Dispatch_FrameGetBounds on the binary channel.
+void BM_Dispatch_BinaryGetBounds(benchmark::State& state) {
+  BinaryMessage request;
+  request.opcode = static_cast<uint16_t>(BinaryOp::kGetBounds);
+  request.handle = plugin->handle(3);
+  std::vector<uint8_t> bytes(kBinaryMessageSize);
+  EncodeBinaryMessage(request, bytes.data());
+  for (auto _ : state) plugin->CallBinary(bytes);
+}
+BENCHMARK(BM_Dispatch_BinaryGetBounds)
+    ->Setup(CreatePlugin)
+    ->Teardown(DestroyPlugin);
+
+void BM_Dispatch_UnknownService(benchmark::State& state) {
+  auto call = Command("nope", "ping", nullptr);
+  for (auto _ : state) plugin->Call(call);
+}
+BENCHMARK(BM_Dispatch_UnknownService)
+    ->Setup(CreatePlugin)
+    ->Teardown(DestroyPlugin);
+
+/// One "batch" call of range(0) frame/getBounds entries.
+void BM_Dispatch_Batch(benchmark::State& state) {
+  flutter::EncodableList commands;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    std::string id = "bench-" + std::to_string(i % 16);
+    commands.push_back(
+        flutter::EncodableValue(CommandArgs("frame", "getBounds", id.c_str())));
+  }
+  flutter::EncodableMap args{
+      {flutter::EncodableValue("commands"),
+       flutter::EncodableValue(std::move(commands))},
+  };
+  auto call = Encode("batch", flutter::EncodableValue(std::move(args)));
+  for (auto _ : state) plugin->Call(call);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Dispatch_Batch)
+    ->Arg(8)
+    ->Arg(64)
+    ->Setup(CreatePlugin)
+    ->Teardown(DestroyPlugin);
+
+/// `count` string entries, the shape of a message/send or applyAppearance
+/// payload. Values are longer than any small-string buffer, so copying
+/// one allocates as it would for real data.
+flutter::EncodableMap Payload(int64_t count) {
+  flutter::EncodableMap payload;
+  for (int64_t i = 0; i < count; ++i) {
+    payload[flutter::EncodableValue("key-" + std::to_string(i))] =
+        flutter::EncodableValue("value-" + std::to_string(i) +
+                                "-padded-past-the-sso-buffer");
+  }
+  return payload;
+}
+
+/// Heap traffic to decode `message`, which every path pays the same.
+AllocationCount DecodeCost(const std::vector<uint8_t>& message) {
+  AllocationCount start = AllocationsSoFar();
+  {
+    auto call =
+        flutter::StandardMethodCodec::GetInstance().DecodeMethodCall(message);
+    benchmark::DoNotOptimize(call);
+  }
+  AllocationCount end = AllocationsSoFar();
+  return {end.allocations - start.allocations, end.bytes - start.bytes};
+}
+
+/// Deliver `message` each iteration and report heap traffic per call from
+/// the operator new hook (alloc_counter.h): allocs/bytes_per_call for the
+/// whole channel call, and dispatch_allocs/dispatch_bytes for everything
+/// after decoding, i.e. what HandleMethodCall, Dispatch and the reply add.
+///
+/// With `copied` set, each call also copies `params` first. That is the
+/// copy HandleMethodCall made of the decoded params before handing them to
+/// a service; the borrowed path no longer does, so the bench reproduces it
+/// to put the two paths side by side.
+void CountDispatchAllocations(benchmark::State& state,
+                              const std::vector<uint8_t>& message,
+                              const flutter::EncodableMap* copied) {
+  const AllocationCount decode = DecodeCost(message);
+  const AllocationCount start = AllocationsSoFar();
+  for (auto _ : state) {
+    if (copied) {
+      flutter::EncodableMap params = *copied;
+      benchmark::DoNotOptimize(params);
+    }
+    plugin->Call(message);
+  }
+  const AllocationCount end = AllocationsSoFar();
+
+  const double calls = static_cast<double>(state.iterations());
+  const double allocations =
+      static_cast<double>(end.allocations - start.allocations);
+  const double bytes = static_cast<double>(end.bytes - start.bytes);
+  state.counters["allocs_per_call"] = allocations / calls;
+  state.counters["bytes_per_call"] = bytes / calls;
+  state.counters["dispatch_allocs"] = allocations / calls - decode.allocations;
+  state.counters["dispatch_bytes"] = bytes / calls - decode.bytes;
+}
+
+/// A command with no params: Dispatch gets the shared EmptyParams().
+void BM_DispatchAllocs_NoParams(benchmark::State& state) {
+  flutter::EncodableMap args = CommandArgs("host", "ping", nullptr);
+  args.erase(flutter::EncodableValue("params"));
+  CountDispatchAllocations(
+      state, Encode("command", flutter::EncodableValue(std::move(args))),
+      nullptr);
+}
+BENCHMARK(BM_DispatchAllocs_NoParams)
+    ->Setup(CreatePlugin)
+    ->Teardown(DestroyPlugin);
+
+/// A range(0)-entry params map borrowed from the decoded call.
+void BM_DispatchAllocs_Borrowed(benchmark::State& state) {
+  flutter::EncodableMap args = CommandArgs("host", "ping", nullptr);
+  args[flutter::EncodableValue("params")] =
+      flutter::EncodableValue(Payload(state.range(0)));
+  CountDispatchAllocations(
+      state, Encode("command", flutter::EncodableValue(std::move(args))),
+      nullptr);
+}
+BENCHMARK(BM_DispatchAllocs_Borrowed)
+    ->Arg(16)
+    ->Arg(256)
+    ->Setup(CreatePlugin)
+    ->Teardown(DestroyPlugin);
+
+/// The same call on the old path, which copied the params map.
+void BM_DispatchAllocs_Copied(benchmark::State& state) {
+  const flutter::EncodableMap params = Payload(state.range(0));
+  flutter::EncodableMap args = CommandArgs("host", "ping", nullptr);
+  args[flutter::EncodableValue("params")] = flutter::EncodableValue(params);
+  CountDispatchAllocations(
+      state, Encode("command", flutter::EncodableValue(std::move(args))),
+      &params);
+}
+BENCHMARK(BM_DispatchAllocs_Copied)
+    ->Arg(16)
+    ->Arg(256)
+    ->Setup(CreatePlugin)
+    ->Teardown(DestroyPlugin);
+
+}  // namespace
+}  // namespace bench
+}  // namespace floating_palette
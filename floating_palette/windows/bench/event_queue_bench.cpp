@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+#include <flutter/encodable_value.h>
+#include <flutter/method_call.h>
+#include <flutter/standard_method_codec.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../core/event_queue.h"
+
+namespace floating_palette {
+namespace bench {
+
+namespace {
+
+/// Encodes each flushed batch the way the plugin's channel does
+/// (InvokeMethod("events", [...])), minus the messenger.
+void EncodeBatch(flutter::EncodableList events) {
+  flutter::MethodCall<flutter::EncodableValue> call(
+      "events",
+      std::make_unique<flutter::EncodableValue>(std::move(events)));
+  auto encoded =
+      flutter::StandardMethodCodec::GetInstance().EncodeMethodCall(call);
+  benchmark::DoNotOptimize(encoded);
+}
+
+flutter::EncodableMap MoveData(int i) {
+  return flutter::EncodableMap{
+      {flutter::EncodableValue("x"), flutter::EncodableValue(i * 1.0)},
+      {flutter::EncodableValue("y"), flutter::EncodableValue(i * 2.0)},
+      {flutter::EncodableValue("width"), flutter::EncodableValue(240.0)},
+      {flutter::EncodableValue("height"), flutter::EncodableValue(180.0)},
+  };
+}
+
+/// One frame's worth of events from range(0) palettes, pushed, flushed
+/// and encoded.
+void BM_EventQueue_PushFlushEncode(benchmark::State& state) {
+  EventQueue queue(EncodeBatch);
+  std::vector<std::string> ids;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    ids.push_back("bench-" + std::to_string(i));
+  }
+  flutter::EncodableMap data = MoveData(1);
+  for (auto _ : state) {
+    for (const std::string& id : ids) queue.Push("frame", "moved", &id, data);
+    queue.Flush();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EventQueue_PushFlushEncode)->Arg(1)->Arg(16);
+
+/// A drag: many moves for one palette between flushes, which coalesce
+/// into the last one.
+void BM_EventQueue_CoalescedMoves(benchmark::State& state) {
+  EventQueue queue(EncodeBatch);
+  const std::string id = "bench-0";
+  std::vector<flutter::EncodableMap> moves;
+  for (int i = 0; i < 8; ++i) moves.push_back(MoveData(i));
+  for (auto _ : state) {
+    for (const auto& data : moves) queue.Push("frame", "moved", &id, data);
+    queue.Flush();
+  }
+  state.SetItemsProcessed(state.iterations() * 8);
+}
+BENCHMARK(BM_EventQueue_CoalescedMoves);
+
+}  // namespace
+}  // namespace bench
+}  // namespace floating_palette
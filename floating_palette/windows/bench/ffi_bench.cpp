@@ -0,0 +1,129 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+#include "../ffi/ffi_interface.h"
+#include "fixtures.h"
+
+namespace floating_palette {
+namespace bench {
+
+namespace {
+
+std::unique_ptr<BenchWindows> windows;
+
+void CreateWindows(const benchmark::State& state) {
+  windows = std::make_unique<BenchWindows>(
+      state.range(0) > 0 ? static_cast<size_t>(state.range(0)) : 16);
+}
+void DestroyWindows(const benchmark::State&) { windows.reset(); }
+
+void BM_Ffi_GetWindowFrame(benchmark::State& state) {
+  double x, y, width, height;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        FloatingPalette_GetWindowFrame("bench-3", &x, &y, &width, &height));
+  }
+}
+BENCHMARK(BM_Ffi_GetWindowFrame)
+    ->Setup(CreateWindows)
+    ->Teardown(DestroyWindows);
+
+void BM_Ffi_ResolveHandle(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(FloatingPalette_ResolveHandle("bench-3"));
+  }
+}
+BENCHMARK(BM_Ffi_ResolveHandle)
+    ->Setup(CreateWindows)
+    ->Teardown(DestroyWindows);
+
+void BM_Ffi_GetWindowFrameByHandle(benchmark::State& state) {
+  int32_t handle = static_cast<int32_t>(windows->handles()[3]);
+  double x, y, width, height;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(FloatingPalette_GetWindowFrameByHandle(
+        handle, &x, &y, &width, &height));
+  }
+}
+BENCHMARK(BM_Ffi_GetWindowFrameByHandle)
+    ->Setup(CreateWindows)
+    ->Teardown(DestroyWindows);
+
+/// One call for range(0) frames.
+void BM_Ffi_GetWindowFramesByHandle(benchmark::State& state) {
+  std::vector<FloatingPaletteFrame> frames(windows->handles().size());
+  for (size_t i = 0; i < frames.size(); ++i) {
+    frames[i].handle = static_cast<int32_t>(windows->handles()[i]);
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(FloatingPalette_GetWindowFramesByHandle(
+        frames.data(), static_cast<int32_t>(frames.size())));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Ffi_GetWindowFramesByHandle)
+    ->Arg(16)
+    ->Arg(128)
+    ->Setup(CreateWindows)
+    ->Teardown(DestroyWindows);
+
+void BM_Ffi_GetScreenCount(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(FloatingPalette_GetScreenCount());
+  }
+}
+BENCHMARK(BM_Ffi_GetScreenCount);
+
+void BM_Ffi_GetScreenBounds(benchmark::State& state) {
+  double x, y, width, height;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        FloatingPalette_GetScreenBounds(0, &x, &y, &width, &height));
+  }
+}
+BENCHMARK(BM_Ffi_GetScreenBounds);
+
+void BM_Ffi_GetCursorPosition(benchmark::State& state) {
+  double x, y;
+  for (auto _ : state) {
+    FloatingPalette_GetCursorPosition(&x, &y);
+    benchmark::DoNotOptimize(x);
+  }
+}
+BENCHMARK(BM_Ffi_GetCursorPosition);
+
+/// Placement at the cursor, solved but not applied: the one call that
+/// replaces the cursor, screen, scale and frame queries above.
+void BM_Ffi_SolvePlacement(benchmark::State& state) {
+  FloatingPalettePlacement placement{};
+  placement.handle = static_cast<int32_t>(windows->handles()[3]);
+  placement.offset_y = 8;
+  placement.flags = FLOATING_PALETTE_PLACEMENT_AVOID_EDGES;
+  FloatingPaletteFrame frame;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        FloatingPalette_SolvePlacement(&placement, &frame));
+  }
+}
+BENCHMARK(BM_Ffi_SolvePlacement)
+    ->Setup(CreateWindows)
+    ->Teardown(DestroyWindows);
+
+/// The read-only query path: bounds, visibility and focus in one call.
+void BM_Ffi_QueryWindow(benchmark::State& state) {
+  int32_t handle = static_cast<int32_t>(windows->handles()[3]);
+  FloatingPaletteWindowState window_state;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        FloatingPalette_QueryWindow(handle, &window_state));
+  }
+}
+BENCHMARK(BM_Ffi_QueryWindow)
+    ->Setup(CreateWindows)
+    ->Teardown(DestroyWindows);
+
+}  // namespace
+}  // namespace bench
+}  // namespace floating_palette
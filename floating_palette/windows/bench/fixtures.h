@@ -0,0 +1,92 @@
+#pragma once
+
+#include <windows.h>
+
+#include <flutter/binary_messenger.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../core/window_store.h"
+
+namespace floating_palette {
+namespace bench {
+
+/// Messenger with no engine on the other end. Outgoing messages (events,
+/// replies) are encoded as usual and dropped. The handlers channels
+/// register are kept, so Deliver() feeds an encoded message through the
+/// same path an engine message takes: codec, channel handler, plugin.
+class BenchMessenger : public flutter::BinaryMessenger {
+ public:
+  void Send(const std::string& channel, const uint8_t* message,
+            size_t message_size,
+            flutter::BinaryReply reply = nullptr) const override {}
+  void SetMessageHandler(const std::string& channel,
+                         flutter::BinaryMessageHandler handler) override {
+    if (handler) {
+      handlers_[channel] = std::move(handler);
+    } else {
+      handlers_.erase(channel);
+    }
+  }
+
+  /// Hand `message` to `channel`'s handler; its reply is dropped. False if
+  /// nothing is registered on `channel`.
+  bool Deliver(const std::string& channel,
+               const std::vector<uint8_t>& message) const {
+    auto it = handlers_.find(channel);
+    if (it == handlers_.end()) return false;
+    it->second(message.data(), message.size(), reply_);
+    return true;
+  }
+
+ private:
+  std::map<std::string, flutter::BinaryMessageHandler> handlers_;
+  flutter::BinaryReply reply_ = [](const uint8_t*, size_t) {};
+};
+
+/// `count` hidden top-level windows stored as palettes "bench-0".. with
+/// refreshed frame caches, laid out in a grid. No Flutter engines: the
+/// store, frame and snap paths only need the HWND. Removed on destruction.
+class BenchWindows {
+ public:
+  explicit BenchWindows(size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+      auto window = std::make_unique<PaletteWindow>();
+      window->id = "bench-" + std::to_string(i);
+      int x = static_cast<int>(i % 16) * 220;
+      int y = static_cast<int>(i / 16) * 160;
+      window->hwnd =
+          CreateWindowExW(WS_EX_TOOLWINDOW, L"STATIC", L"", WS_POPUP, x, y,
+                          200, 140, nullptr, nullptr,
+                          GetModuleHandle(nullptr), nullptr);
+      window->frame.Refresh(window->hwnd);
+      ids_.push_back(window->id);
+      hwnds_.push_back(window->hwnd);
+      handles_.push_back(
+          WindowStore::Instance().Store(window->id, std::move(window)));
+    }
+  }
+
+  ~BenchWindows() {
+    for (const std::string& id : ids_) WindowStore::Instance().Remove(id);
+    for (HWND hwnd : hwnds_) DestroyWindow(hwnd);
+  }
+
+  BenchWindows(const BenchWindows&) = delete;
+  BenchWindows& operator=(const BenchWindows&) = delete;
+
+  const std::vector<std::string>& ids() const { return ids_; }
+  const std::vector<WindowHandle>& handles() const { return handles_; }
+
+ private:
+  std::vector<std::string> ids_;
+  std::vector<HWND> hwnds_;
+  std::vector<WindowHandle> handles_;
+};
+
+}  // namespace bench
+}  // namespace floating_palette
@@ -0,0 +1,55 @@
+#include <benchmark/benchmark.h>
+
+#include "../core/clock.h"
+#include "../core/glass_animation_driver.h"
+
+namespace floating_palette {
+namespace bench {
+
+namespace {
+
+constexpr char kWindowId[] = "bench-glass";
+
+/// A buffer mid-animation, as Dart leaves it after starting one.
+void CreateBuffer(const benchmark::State&) {
+  GlassAnimationBuffer* buffer =
+      GlassAnimationDriver::Instance().CreateBuffer(kWindowId, 0);
+  buffer->animation_id = 1;
+  buffer->is_animating = 1;
+  buffer->curve_type = 0;
+  buffer->start_x = 0;
+  buffer->start_y = 0;
+  buffer->start_width = 200;
+  buffer->start_height = 140;
+  buffer->target_x = 40;
+  buffer->target_y = 20;
+  buffer->target_width = 320;
+  buffer->target_height = 240;
+  buffer->corner_radius = 12;
+  buffer->start_time = MonotonicSeconds();
+  // Long enough that every read interpolates.
+  buffer->duration = 3600;
+  buffer->window_height = 480;
+  buffer->animation_id_post = 1;
+}
+void DestroyBuffer(const benchmark::State&) {
+  GlassAnimationDriver::Instance().DestroyAllBuffers(kWindowId);
+}
+
+/// The per-tick read: seqlock check and interpolation. Two threads is the
+/// compositor tick plus a concurrent FFI reader.
+void BM_Glass_ReadAnimatedBounds(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        GlassAnimationDriver::Instance().ReadAnimatedBounds(kWindowId, 0));
+  }
+}
+BENCHMARK(BM_Glass_ReadAnimatedBounds)
+    ->Threads(1)
+    ->Threads(2)
+    ->Setup(CreateBuffer)
+    ->Teardown(DestroyBuffer);
+
+}  // namespace
+}  // namespace bench
+}  // namespace floating_palette
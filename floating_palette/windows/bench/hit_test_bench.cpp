@@ -0,0 +1,61 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "../core/hit_test_mask.h"
+
+namespace floating_palette {
+namespace bench {
+
+namespace {
+
+/// Publish range(0) interactive rects in a column, as a palette with a
+/// list of cards over a transparent window would.
+void PublishColumn(HitTestMask& mask, int64_t count) {
+  HitTestMaskBuffer* buffer = mask.Publish();
+  buffer->frame_id_post = 1;
+  buffer->mode = static_cast<uint32_t>(PassthroughMode::kInteractive);
+  buffer->rect_count = static_cast<uint32_t>(count);
+  for (int64_t i = 0; i < count; ++i) {
+    float* rect = &buffer->rects[i * 4];
+    rect[0] = 8;
+    rect[1] = 8 + 40.0f * i;
+    rect[2] = 300;
+    rect[3] = 32;
+  }
+  buffer->frame_id = 1;
+}
+
+/// One WM_NCHITTEST against an unchanged mask of range(0) rects, the
+/// pointer sweeping over cards and the gaps between them.
+void BM_HitTest_Lookup(benchmark::State& state) {
+  HitTestMask mask;
+  PublishColumn(mask, state.range(0));
+  float y = 0;
+  const float height = 40.0f * state.range(0) + 16;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(mask.PassesThrough(150, y));
+    y += 3;
+    if (y > height) y = 0;
+  }
+}
+BENCHMARK(BM_HitTest_Lookup)->Arg(4)->Arg(128);
+
+/// A hit test right after Dart republished the mask (copy + lookup).
+void BM_HitTest_Republished(benchmark::State& state) {
+  HitTestMask mask;
+  PublishColumn(mask, state.range(0));
+  HitTestMaskBuffer* buffer = mask.Publish();
+  uint64_t frame_id = 1;
+  for (auto _ : state) {
+    ++frame_id;
+    buffer->frame_id_post = frame_id;
+    buffer->frame_id = frame_id;
+    benchmark::DoNotOptimize(mask.PassesThrough(150, 20));
+  }
+}
+BENCHMARK(BM_HitTest_Republished)->Arg(4)->Arg(128);
+
+}  // namespace
+}  // namespace bench
+}  // namespace floating_palette
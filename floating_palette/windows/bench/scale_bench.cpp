@@ -0,0 +1,178 @@
+#include <windows.h>
+#include <psapi.h>
+
+#include <benchmark/benchmark.h>
+#include <flutter/method_result_functions.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../services/window_service.h"
+
+namespace floating_palette {
+namespace bench {
+
+namespace {
+
+constexpr double kMiB = 1024.0 * 1024.0;
+
+struct ProcessUsage {
+  double working_set_mib = 0;
+  double peak_working_set_mib = 0;
+  double kernel_handles = 0;
+  double user_objects = 0;
+  double gdi_objects = 0;
+};
+
+ProcessUsage SampleUsage() {
+  ProcessUsage usage;
+  HANDLE process = GetCurrentProcess();
+  PROCESS_MEMORY_COUNTERS memory = {};
+  if (GetProcessMemoryInfo(process, &memory, sizeof(memory))) {
+    usage.working_set_mib = memory.WorkingSetSize / kMiB;
+    usage.peak_working_set_mib = memory.PeakWorkingSetSize / kMiB;
+  }
+  DWORD handles = 0;
+  if (GetProcessHandleCount(process, &handles)) {
+    usage.kernel_handles = handles;
+  }
+  usage.user_objects = GetGuiResources(process, GR_USEROBJECTS);
+  usage.gdi_objects = GetGuiResources(process, GR_GDIOBJECTS);
+  return usage;
+}
+
+/// Whether engines can start here: EnginePool loads data\flutter_assets
+/// relative to the executable, which only exists when the bench is run
+/// from a built app's output directory.
+bool EnginesAvailable() {
+  wchar_t path[MAX_PATH];
+  DWORD length = GetModuleFileNameW(nullptr, path, MAX_PATH);
+  if (length == 0 || length == MAX_PATH) return false;
+  std::wstring assets(path, length);
+  assets.erase(assets.find_last_of(L'\\') + 1);
+  assets += L"data\\flutter_assets";
+  DWORD attributes = GetFileAttributesW(assets.c_str());
+  return attributes != INVALID_FILE_ATTRIBUTES &&
+         (attributes & FILE_ATTRIBUTE_DIRECTORY);
+}
+
+/// Run `command` on `service` and return its success value (null on an
+/// error reply).
+flutter::EncodableValue Run(WindowService& service, const char* command,
+                            const flutter::EncodableMap& params) {
+  using Result = flutter::MethodResultFunctions<flutter::EncodableValue>;
+  flutter::EncodableValue reply;
+  service.Handle(command, nullptr, params,
+                 std::make_unique<Result>(
+                     [&reply](const flutter::EncodableValue* value) {
+                       if (value) reply = *value;
+                     },
+                     nullptr, nullptr));
+  return reply;
+}
+
+/// Entry count of the list or map under `key` in a createMany reply.
+size_t CountOf(const flutter::EncodableValue& reply, const char* key) {
+  const auto* map = std::get_if<flutter::EncodableMap>(&reply);
+  if (!map) return 0;
+  auto it = map->find(flutter::EncodableValue(key));
+  if (it == map->end()) return 0;
+  if (const auto* list = std::get_if<flutter::EncodableList>(&it->second)) {
+    return list->size();
+  }
+  if (const auto* codes = std::get_if<flutter::EncodableMap>(&it->second)) {
+    return codes->size();
+  }
+  return 0;
+}
+
+/// window/createMany then window/destroyMany for state.range(0) palettes
+/// per iteration, through WindowService::Handle: the native half of a
+/// workspace restore followed by closing it.
+///
+/// Engines only start when the bench runs beside a built app's assets
+/// (EnginesAvailable). Anywhere else every window comes back
+/// ENGINE_FAILED, so no panel is created and the timing covers parameter
+/// checks, id interning and the failed engine start alone. The benchmark
+/// is then registered as *_NoEngines and labelled with the failure count,
+/// so the gap shows in the results and not only here.
+///
+/// Counters: created / engine_failed per createMany; working_set_mib /
+/// kernel_handles / user_objects / gdi_objects with every palette live
+/// (max over the run), peak_working_set_mib for the process, and *_leaked
+/// as the difference after teardown. USER objects are capped at 10,000
+/// per process by default (USERProcessHandleQuota), which bounds how many
+/// palettes a host can ever hold.
+void BM_Scale_CreateManyDestroyMany(benchmark::State& state) {
+  const size_t count = static_cast<size_t>(state.range(0));
+  flutter::EncodableList specs;
+  flutter::EncodableList ids;
+  for (size_t i = 0; i < count; ++i) {
+    std::string id = "scale-" + std::to_string(i);
+    specs.emplace_back(flutter::EncodableMap{
+        {flutter::EncodableValue("id"), flutter::EncodableValue(id)},
+        {flutter::EncodableValue("width"), flutter::EncodableValue(200.0)},
+    });
+    ids.emplace_back(id);
+  }
+  const flutter::EncodableMap create_params{
+      {flutter::EncodableValue("windows"), flutter::EncodableValue(specs)}};
+  const flutter::EncodableMap destroy_params{
+      {flutter::EncodableValue("ids"), flutter::EncodableValue(ids)}};
+
+  WindowService service(nullptr);
+  ProcessUsage before = SampleUsage();
+  ProcessUsage live;
+  size_t created = 0;
+  size_t failed = 0;
+
+  for (auto _ : state) {
+    flutter::EncodableValue reply = Run(service, "createMany", create_params);
+    created = CountOf(reply, "created");
+    failed = CountOf(reply, "failed");
+
+    ProcessUsage usage = SampleUsage();
+    live.working_set_mib = std::max(live.working_set_mib,
+                                    usage.working_set_mib);
+    live.kernel_handles = std::max(live.kernel_handles, usage.kernel_handles);
+    live.user_objects = std::max(live.user_objects, usage.user_objects);
+    live.gdi_objects = std::max(live.gdi_objects, usage.gdi_objects);
+
+    Run(service, "destroyMany", destroy_params);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+  if (created < count) {
+    state.SetLabel("no engines: " + std::to_string(failed) + "/" +
+                   std::to_string(count) + " failed to start");
+  }
+
+  ProcessUsage after = SampleUsage();
+  state.counters["created"] = static_cast<double>(created);
+  state.counters["engine_failed"] = static_cast<double>(failed);
+  state.counters["working_set_mib"] = live.working_set_mib;
+  state.counters["peak_working_set_mib"] = after.peak_working_set_mib;
+  state.counters["kernel_handles"] = live.kernel_handles;
+  state.counters["user_objects"] = live.user_objects;
+  state.counters["gdi_objects"] = live.gdi_objects;
+  state.counters["kernel_handles_leaked"] =
+      after.kernel_handles - before.kernel_handles;
+  state.counters["user_objects_leaked"] =
+      after.user_objects - before.user_objects;
+  state.counters["gdi_objects_leaked"] =
+      after.gdi_objects - before.gdi_objects;
+}
+
+// Registered at startup under a name that says whether engines ran.
+benchmark::internal::Benchmark* const scale_benchmark [[maybe_unused]] =
+    benchmark::RegisterBenchmark(
+        EnginesAvailable() ? "BM_Scale_CreateManyDestroyMany"
+                           : "BM_Scale_CreateManyDestroyMany_NoEngines",
+        BM_Scale_CreateManyDestroyMany)
+        ->Arg(100)
+        ->Arg(200);
+
+}  // namespace
+}  // namespace bench
+}  // namespace floating_palette
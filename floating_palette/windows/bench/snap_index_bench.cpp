@@ -0,0 +1,59 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "../core/snap_index.h"
+
+namespace floating_palette {
+namespace bench {
+
+namespace {
+
+constexpr SnapEdgeMask kAllEdges =
+    EdgeBit(SnapEdge::kTop) | EdgeBit(SnapEdge::kBottom) |
+    EdgeBit(SnapEdge::kLeft) | EdgeBit(SnapEdge::kRight);
+
+/// range(0) palettes of 200x140 in a grid with 20px gutters.
+std::vector<SnapIndex::Target> GridTargets(int64_t count) {
+  std::vector<SnapIndex::Target> targets;
+  for (int64_t i = 0; i < count; ++i) {
+    LONG x = static_cast<LONG>(i % 32) * 220;
+    LONG y = static_cast<LONG>(i / 32) * 160;
+    targets.push_back(
+        {"bench-" + std::to_string(i), RECT{x, y, x + 200, y + 140},
+         kAllEdges});
+  }
+  return targets;
+}
+
+/// One drag tick: the dragged palette sits in a gutter, near several
+/// edges.
+void BM_SnapIndex_FindNearest(benchmark::State& state) {
+  SnapIndex index;
+  index.Rebuild(GridTargets(state.range(0)));
+  const std::unordered_set<std::string> excluded{"dragged"};
+  const RECT dragged{206, 150, 406, 290};
+  SnapIndex::Match match;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(index.FindNearest(dragged, kAllEdges, 12,
+                                               excluded, nullptr, &match));
+  }
+}
+BENCHMARK(BM_SnapIndex_FindNearest)->Arg(16)->Arg(256)->Arg(1024);
+
+void BM_SnapIndex_Rebuild(benchmark::State& state) {
+  SnapIndex index;
+  const std::vector<SnapIndex::Target> targets = GridTargets(state.range(0));
+  for (auto _ : state) {
+    index.Rebuild(targets);
+    benchmark::DoNotOptimize(index.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SnapIndex_Rebuild)->Arg(16)->Arg(256)->Arg(1024);
+
+}  // namespace
+}  // namespace bench
+}  // namespace floating_palette
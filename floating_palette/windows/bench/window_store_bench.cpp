@@ -0,0 +1,120 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../core/id_table.h"
+#include "../core/window_store.h"
+#include "fixtures.h"
+
+namespace floating_palette {
+namespace bench {
+
+namespace {
+
+std::unique_ptr<BenchWindows> windows;
+
+void CreateWindows(const benchmark::State&) {
+  windows = std::make_unique<BenchWindows>(64);
+}
+void DestroyWindows(const benchmark::State&) { windows.reset(); }
+
+/// Handle lookups, the FFI path; lock-free reads of the slot table.
+void BM_WindowStore_GetByHandle(benchmark::State& state) {
+  const std::vector<WindowHandle>& handles = windows->handles();
+  size_t i = state.thread_index();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        WindowStore::Instance().Get(handles[i++ % handles.size()]));
+  }
+}
+BENCHMARK(BM_WindowStore_GetByHandle)
+    ->Threads(1)
+    ->Threads(2)
+    ->Threads(4)
+    ->Threads(8)
+    ->Setup(CreateWindows)
+    ->Teardown(DestroyWindows);
+
+/// String lookups, the method-channel path.
+void BM_WindowStore_GetById(benchmark::State& state) {
+  const std::vector<std::string>& ids = windows->ids();
+  size_t i = state.thread_index();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        WindowStore::Instance().Get(ids[i++ % ids.size()]));
+  }
+}
+BENCHMARK(BM_WindowStore_GetById)
+    ->Threads(1)
+    ->Threads(2)
+    ->Threads(4)
+    ->Threads(8)
+    ->Setup(CreateWindows)
+    ->Teardown(DestroyWindows);
+
+/// All(): what every broadcast and z-order pass starts with.
+void BM_WindowStore_Snapshot(benchmark::State& state) {
+  std::vector<PaletteWindow*> all;
+  for (auto _ : state) {
+    WindowStore::Instance().Snapshot(&all);
+    benchmark::DoNotOptimize(all.data());
+  }
+}
+BENCHMARK(BM_WindowStore_Snapshot)
+    ->Setup(CreateWindows)
+    ->Teardown(DestroyWindows);
+
+/// Handle lookups from every thread but one, while thread 0 stores and
+/// removes a palette each iteration (create/destroy during drags).
+void BM_WindowStore_GetDuringChurn(benchmark::State& state) {
+  const std::vector<WindowHandle>& handles = windows->handles();
+  if (state.thread_index() == 0) {
+    for (auto _ : state) {
+      auto window = std::make_unique<PaletteWindow>();
+      window->id = "bench-churn";
+      WindowStore::Instance().Store(window->id, std::move(window));
+      WindowStore::Instance().Remove("bench-churn");
+    }
+    return;
+  }
+  size_t i = state.thread_index();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        WindowStore::Instance().Get(handles[i++ % handles.size()]));
+  }
+}
+BENCHMARK(BM_WindowStore_GetDuringChurn)
+    ->Threads(2)
+    ->Threads(4)
+    ->Setup(CreateWindows)
+    ->Teardown(DestroyWindows);
+
+/// A palette record from the slab and back, as create/destroy and the
+/// engine pool do.
+void BM_PaletteWindow_Allocate(benchmark::State& state) {
+  for (auto _ : state) {
+    auto window = std::make_unique<PaletteWindow>();
+    benchmark::DoNotOptimize(window.get());
+  }
+}
+BENCHMARK(BM_PaletteWindow_Allocate);
+
+/// Interning an id already in the table (every coalescable event push).
+void BM_IdTable_Intern(benchmark::State& state) {
+  const std::vector<std::string>& ids = windows->ids();
+  size_t i = state.thread_index();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(IdTable::Instance().Intern(ids[i++ % ids.size()]));
+  }
+}
+BENCHMARK(BM_IdTable_Intern)
+    ->Threads(1)
+    ->Threads(4)
+    ->Setup(CreateWindows)
+    ->Teardown(DestroyWindows);
+
+}  // namespace
+}  // namespace bench
+}  // namespace floating_palette
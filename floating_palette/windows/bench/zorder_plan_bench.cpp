@@ -0,0 +1,42 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "../core/zorder_plan.h"
+
+namespace floating_palette {
+namespace bench {
+
+namespace {
+
+/// A zorder/apply of range(0) palettes whose current stacking is a random
+/// permutation of the desired one (the worst realistic case).
+void BM_ZOrder_PlanShuffled(benchmark::State& state) {
+  std::vector<int> ranks(static_cast<size_t>(state.range(0)));
+  std::iota(ranks.begin(), ranks.end(), 0);
+  std::shuffle(ranks.begin(), ranks.end(), std::mt19937(42));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(PlanZOrder(ranks).size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ZOrder_PlanShuffled)->Arg(15)->Arg(256);
+
+/// Raising one palette of a range(0) stack: a single move.
+void BM_ZOrder_PlanRaiseOne(benchmark::State& state) {
+  std::vector<int> ranks(static_cast<size_t>(state.range(0)));
+  std::iota(ranks.begin(), ranks.end(), 0);
+  std::rotate(ranks.begin(), ranks.end() - 1, ranks.end());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(PlanZOrder(ranks).size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ZOrder_PlanRaiseOne)->Arg(15)->Arg(256);
+
+}  // namespace
+}  // namespace bench
+}  // namespace floating_palette
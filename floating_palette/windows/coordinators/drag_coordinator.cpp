@@ -1,21 +1,350 @@
 #include "drag_coordinator.h"
 
+#include <algorithm>
+
+#include "../core/clock.h"
+#include "../core/desktop_capture.h"
+#include "../core/event_filter.h"
+#include "../core/id_table.h"
 #include "../core/logger.h"
+#include "../core/metrics.h"
+#include "../core/palette_panel.h"
+#include "../services/binary_channel.h"
 
 namespace floating_palette {
 
+namespace {
+
+constexpr UINT kMoveFlags =
+    SWP_NOSIZE | SWP_NOZORDER | SWP_NOOWNERZORDER | SWP_NOACTIVATE;
+
+bool PrimaryButtonDown() {
+  int key = GetSystemMetrics(SM_SWAPBUTTON) ? VK_RBUTTON : VK_LBUTTON;
+  return (GetAsyncKeyState(key) & 0x8000) != 0;
+}
+
+/// GetMouseMovePointsEx reports display points as unsigned 16-bit values;
+/// monitors left of or above the primary come back wrapped.
+int UnwrapCoordinate(int value) {
+  return value > 32767 ? value - 65536 : value;
+}
+
+}  // namespace
+
 void DragCoordinator::SetDelegate(DragCoordinatorDelegate* delegate) {
   delegate_ = delegate;
 }
 
 void DragCoordinator::StartDrag(const std::string& id,
                                 PaletteWindow* window) {
-  // TODO: Implement Win32 drag handling
-  FP_LOG("Frame", "startDrag stub called for " + id);
+  if (is_dragging_) {
+    FP_LOG("Frame", "startDrag ignored: already dragging");
+    return;
+  }
+  if (!window || !window->hwnd) return;
+  if (!window->draggable) {
+    FP_LOG("Frame", "startDrag ignored: dragging disabled for ", id);
+    return;
+  }
+  // The call arrives after Dart saw the pan start; if the button is up by
+  // now, a capture would only start a drag nobody is holding.
+  if (!PrimaryButtonDown()) return;
+
+  HWND hwnd = window->hwnd;
+  POINT cursor;
+  GetCursorPos(&cursor);
+  BeginDrag(id, hwnd);
+  if (!is_dragging_) return;
+
+  const RECT start = drag_frame_;
+  grab_ = POINT{cursor.x - start.left, cursor.y - start.top};
+  const double scale = GetDpiForWindow(hwnd) / 96.0;
+  last_move_point_ = cursor;
+  last_move_time_ = static_cast<DWORD>(GetMessageTime());
+  last_progress_time_ = MonotonicSeconds();
+  EmitFrameEvent("dragStarted", scale);
+
+  SetCapture(hwnd);
+  DesktopCapture::SetInteractive(hwnd, true);
+  bool completed = RunDragLoop(hwnd);
+  if (GetCapture() == hwnd) ReleaseCapture();
+  DesktopCapture::SetInteractive(hwnd, false);
+  if (!is_dragging_) return;  // The window was destroyed mid-drag.
+
+  if (!completed && is_dragging_) {
+    UpdateDrag(POINT{start.left, start.top});
+  }
+  SettleDpi(POINT{drag_frame_.left + grab_.x, drag_frame_.top + grab_.y},
+            true);
+  // The drag may have ended on a monitor with another scale.
+  const double end_scale = GetDpiForWindow(hwnd) / 96.0;
+  // The Flutter view lost the button-up to our capture; hand it one so its
+  // pointer state doesn't stay pressed.
+  if (HWND view = GetWindow(hwnd, GW_CHILD)) {
+    POINT client;
+    GetCursorPos(&client);
+    ScreenToClient(view, &client);
+    PostMessage(view, WM_LBUTTONUP, 0, MAKELPARAM(client.x, client.y));
+  }
+
+  POINT velocity = completed ? ReleaseVelocity() : POINT{0, 0};
+  EmitFrameEvent("dragEnded", end_scale,
+                 flutter::EncodableMap{
+                     {flutter::EncodableValue("velocityX"),
+                      flutter::EncodableValue(velocity.x / end_scale)},
+                     {flutter::EncodableValue("velocityY"),
+                      flutter::EncodableValue(velocity.y / end_scale)},
+                     {flutter::EncodableValue("cancelled"),
+                      flutter::EncodableValue(!completed)},
+                 });
+  EndDrag();
+}
+
+bool DragCoordinator::RunDragLoop(HWND hwnd) {
+  MSG msg;
+  while (is_dragging_) {
+    BOOL got = GetMessage(&msg, nullptr, 0, 0);
+    if (got <= 0) {
+      // Leave WM_QUIT for the application's own loop.
+      if (got == 0) PostQuitMessage(static_cast<int>(msg.wParam));
+      return false;
+    }
+    switch (msg.message) {
+      case WM_MOUSEMOVE:
+        last_move_point_ = msg.pt;
+        last_move_time_ = msg.time;
+        TrackPointer();
+        if (!PrimaryButtonDown()) return true;  // Missed the button-up.
+        continue;
+      case WM_LBUTTONUP:
+        TrackPointer();
+        return true;
+      case WM_KEYDOWN:
+        if (msg.wParam == VK_ESCAPE) return false;
+        continue;
+      case WM_RBUTTONDOWN:
+        return false;
+    }
+    TranslateMessage(&msg);
+    DispatchMessage(&msg);
+    // Something else took the mouse (another window, a system dialog).
+    if (GetCapture() != hwnd) return true;
+  }
+  return true;
+}
+
+void DragCoordinator::TrackPointer() {
+  // The cursor position now, not the one in the (possibly older) message.
+  POINT cursor;
+  if (!GetCursorPos(&cursor)) return;
+  UpdateDrag(POINT{cursor.x - grab_.x, cursor.y - grab_.y});
+  SettleDpi(cursor, false);
+
+  double now = MonotonicSeconds();
+  if (now - last_progress_time_ >= kProgressInterval) {
+    last_progress_time_ = now;
+    // The scale the panel is laid out at, which trails the monitor's
+    // while a crossing is held.
+    EmitMoved((drag_window_ ? drag_window_->layout_dpi
+                            : GetDpiForWindow(drag_hwnd_)) /
+              96.0);
+  }
+}
+
+void DragCoordinator::SettleDpi(POINT pivot, bool release) {
+  PaletteWindow* window = drag_window_;
+  if (!is_dragging_ || !window) return;
+  const UINT from = window->layout_dpi;
+  RECT frame;
+  const bool resized =
+      release ? PalettePanel::ReleaseDpi(drag_hwnd_, *window, pivot, &frame)
+              : PalettePanel::SettleDpi(drag_hwnd_, *window, pivot, &frame);
+  if (!resized) return;
+
+  // Scaled about the pivot: keep the grab point under the cursor and the
+  // group in proportion (its members apply their own DPI as they cross).
+  grab_ = POINT{pivot.x - frame.left, pivot.y - frame.top};
+  const UINT to = window->layout_dpi;
+  for (GroupMember& member : group_) {
+    member.offset.x = MulDiv(member.offset.x, to, from);
+    member.offset.y = MulDiv(member.offset.y, to, from);
+  }
+  drag_frame_ = frame;
+  FP_LOG("Drag", *active_drag_id_, " crossed to ", to, " dpi");
+  if (delegate_) delegate_->DragMoved(*active_drag_id_, drag_frame_);
+}
+
+POINT DragCoordinator::ReleaseVelocity() const {
+  MOUSEMOVEPOINT anchor = {};
+  anchor.x = last_move_point_.x & 0xFFFF;
+  anchor.y = last_move_point_.y & 0xFFFF;
+  anchor.time = last_move_time_;
+  MOUSEMOVEPOINT history[64];
+  int count = GetMouseMovePointsEx(sizeof(anchor), &anchor, history, 64,
+                                   GMMP_USE_DISPLAY_POINTS);
+  if (count < 2) return POINT{0, 0};
+
+  // history[0] is the newest sample; walk back to the oldest one still
+  // inside the window.
+  int oldest = 0;
+  for (int i = 1; i < count; ++i) {
+    if (history[0].time - history[i].time > kVelocityWindowMs) break;
+    oldest = i;
+  }
+  DWORD elapsed_ms = history[0].time - history[oldest].time;
+  if (elapsed_ms == 0) return POINT{0, 0};
+  double dx = UnwrapCoordinate(history[0].x) -
+              UnwrapCoordinate(history[oldest].x);
+  double dy = UnwrapCoordinate(history[0].y) -
+              UnwrapCoordinate(history[oldest].y);
+  return POINT{static_cast<LONG>(dx * 1000 / elapsed_ms),
+               static_cast<LONG>(dy * 1000 / elapsed_ms)};
+}
+
+void DragCoordinator::EmitFrameEvent(const char* event,
+                                     double scale,
+                                     flutter::EncodableMap extra) {
+  if (!event_sink_ ||
+      !EventFilter::Instance().Wants("frame", event, active_drag_id_)) {
+    return;
+  }
+  extra[flutter::EncodableValue("x")] =
+      flutter::EncodableValue(drag_frame_.left / scale);
+  extra[flutter::EncodableValue("y")] =
+      flutter::EncodableValue(drag_frame_.top / scale);
+  event_sink_("frame", event, active_drag_id_, extra);
+}
+
+void DragCoordinator::EmitMoved(double scale) {
+  if (binary_channel_ &&
+      EventFilter::Instance().Wants("frame", "moved", active_drag_id_) &&
+      binary_channel_->SendDragMoved(drag_handle_, drag_frame_.left / scale,
+                                     drag_frame_.top / scale)) {
+    return;
+  }
+  EmitFrameEvent("moved", scale);
 }
 
 bool DragCoordinator::IsDragging(const std::string& id) const {
-  return is_dragging_ && active_drag_id_ == id;
+  return is_dragging_ && *active_drag_id_ == id;
+}
+
+void DragCoordinator::WindowDestroyed(const std::string& id, HWND hwnd) {
+  if (!is_dragging_) return;
+  if (*active_drag_id_ == id) {
+    // The loop sees this after the current message and unwinds.
+    is_dragging_ = false;
+    drag_window_ = nullptr;
+    group_.clear();
+    FP_LOG("Frame", "drag cancelled: ", id, " destroyed");
+    return;
+  }
+  group_.erase(std::remove_if(group_.begin(), group_.end(),
+                              [hwnd](const GroupMember& member) {
+                                return member.hwnd == hwnd;
+                              }),
+               group_.end());
+}
+
+void DragCoordinator::BeginDrag(const std::string& id, HWND hwnd) {
+  if (is_dragging_) EndDrag();
+  if (!hwnd || !GetWindowRect(hwnd, &drag_frame_)) return;
+  active_drag_id_ = IdTable::Instance().Intern(id);
+  drag_handle_ = WindowStore::Instance().Resolve(id);
+  drag_hwnd_ = hwnd;
+  drag_window_ =
+      PalettePanel::IsPanel(hwnd) ? PalettePanel::FromHwnd(hwnd) : nullptr;
+  grab_ = {};
+  is_dragging_ = true;
+  if (drag_window_) PalettePanel::HoldDpi(*drag_window_);
+  if (delegate_) delegate_->DragBegan(id);
+  // After DragBegan: a dragged follower may have just been released from
+  // its group.
+  CaptureGroup();
+}
+
+void DragCoordinator::UpdateDrag(POINT position) {
+  if (!is_dragging_) return;
+  if (position.x == drag_frame_.left && position.y == drag_frame_.top) return;
+  ApplyGroupMove(position);
+  OffsetRect(&drag_frame_, position.x - drag_frame_.left,
+             position.y - drag_frame_.top);
+  if (delegate_) delegate_->DragMoved(*active_drag_id_, drag_frame_);
+}
+
+void DragCoordinator::EndDrag() {
+  if (!is_dragging_) return;
+  // A no-op if StartDrag already released it.
+  SettleDpi(POINT{drag_frame_.left + grab_.x, drag_frame_.top + grab_.y},
+            true);
+  is_dragging_ = false;
+  const std::string* id = active_drag_id_;
+  active_drag_id_ = nullptr;
+  drag_handle_ = kInvalidWindowHandle;
+  drag_hwnd_ = nullptr;
+  drag_window_ = nullptr;
+  group_.clear();
+  if (delegate_) delegate_->DragEnded(*id, drag_frame_);
+}
+
+void DragCoordinator::CaptureGroup() {
+  group_.clear();
+  follower_ids_.clear();
+  if (delegate_) delegate_->CollectFollowers(*active_drag_id_, &follower_ids_);
+  for (const std::string& follower_id : follower_ids_) {
+    PaletteWindow* follower = WindowStore::Instance().Get(follower_id);
+    if (!follower || !follower->hwnd || follower->hwnd == drag_hwnd_) {
+      continue;
+    }
+    FrameSnapshot frame;
+    if (!follower->frame.Load(&frame)) continue;
+    group_.push_back(GroupMember{
+        follower->hwnd, POINT{frame.physical.left - drag_frame_.left,
+                              frame.physical.top - drag_frame_.top}});
+  }
+  if (!group_.empty()) {
+    FP_LOG("Drag", *active_drag_id_, " drags a group of ",
+           group_.size() + 1);
+  }
+}
+
+void DragCoordinator::ApplyGroupMove(POINT position) {
+  if (group_.empty()) {
+    SetWindowPos(drag_hwnd_, nullptr, position.x, position.y, 0, 0,
+                 kMoveFlags);
+    Metrics::Instance().RecordWindowPos();
+    return;
+  }
+
+  // One transaction for the whole group: the window manager repositions
+  // (and DWM composes) every window together.
+  HDWP batch = BeginDeferWindowPos(static_cast<int>(group_.size() + 1));
+  if (batch) {
+    batch = DeferWindowPos(batch, drag_hwnd_, nullptr, position.x,
+                           position.y, 0, 0, kMoveFlags);
+  }
+  for (const GroupMember& member : group_) {
+    if (!batch) break;
+    batch = DeferWindowPos(batch, member.hwnd, nullptr,
+                           position.x + member.offset.x,
+                           position.y + member.offset.y, 0, 0, kMoveFlags);
+  }
+  if (batch && EndDeferWindowPos(batch)) {
+    Metrics::Instance().RecordWindowPosBatch(group_.size() + 1);
+    return;
+  }
+
+  // A failed DeferWindowPos discards the batch; fall back to moving each
+  // window so the group still ends up in place.
+  FP_LOG("Drag", "DeferWindowPos failed; moving group individually");
+  SetWindowPos(drag_hwnd_, nullptr, position.x, position.y, 0, 0,
+               kMoveFlags);
+  Metrics::Instance().RecordWindowPos();
+  for (const GroupMember& member : group_) {
+    SetWindowPos(member.hwnd, nullptr, position.x + member.offset.x,
+                 position.y + member.offset.y, 0, 0, kMoveFlags);
+    Metrics::Instance().RecordWindowPos();
+  }
 }
 
 }  // namespace floating_palette
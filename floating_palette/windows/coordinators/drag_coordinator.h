@@ -3,10 +3,13 @@
 #include <windows.h>
 
 #include <string>
+#include <vector>
+
+#include "../core/window_store.h"
 
 namespace floating_palette {
 
-struct PaletteWindow;
+class BinaryChannel;
 
 /// Delegate that receives drag lifecycle callbacks.
 class DragCoordinatorDelegate {
@@ -15,19 +18,109 @@ class DragCoordinatorDelegate {
   virtual void DragBegan(const std::string& id) = 0;
   virtual void DragMoved(const std::string& id, const RECT& frame) = 0;
   virtual void DragEnded(const std::string& id, const RECT& frame) = 0;
+
+  /// Palettes that move rigidly with `id` (its snap followers, followers of
+  /// those, ...), not including `id`. Queried once per drag, after
+  /// DragBegan.
+  virtual void CollectFollowers(const std::string& id,
+                                std::vector<std::string>* out) {}
 };
 
 /// Owns the entire drag lifecycle for palette windows.
+///
+/// StartDrag runs a native modal loop on the platform thread: the panel
+/// captures the mouse and every pointer move repositions the window
+/// straight from here, so a drag stays glued to the cursor however busy
+/// the Dart UI isolate is. Dart only hears about it through "frame"
+/// events: dragStarted, throttled moved, and dragEnded (with the release
+/// velocity from the system's full-rate mouse-move history).
+///
+/// A drag moves the dragged palette and its whole snap group together:
+/// follower offsets are captured when the drag begins, and each move
+/// positions every window in one DeferWindowPos batch, so followers land in
+/// the same frame as the leader instead of trailing it one
+/// WM_WINDOWPOSCHANGED per level.
+///
+/// The dragged panel's DPI is held for the drag (PalettePanel::HoldDpi):
+/// crossing onto a monitor with a different scale applies the new DPI
+/// once, when most of the panel is across, scaled about the cursor, and a
+/// panel straddling the boundary keeps its scale instead of bouncing.
 class DragCoordinator {
  public:
   void SetDelegate(DragCoordinatorDelegate* delegate);
+  void SetEventSink(EventSink sink) { event_sink_ = std::move(sink); }
+  /// Where "moved" goes for windows bound to the binary channel.
+  void SetBinaryChannel(BinaryChannel* channel) { binary_channel_ = channel; }
+
+  /// Drag `window` with the primary button until it is released, Escape
+  /// cancels, or capture is lost. Returns when the drag is over; no-op if
+  /// the button is already up, the window isn't draggable or another drag
+  /// is running. Platform thread only.
   void StartDrag(const std::string& id, PaletteWindow* window);
   bool IsDragging(const std::string& id) const;
 
+  /// A window is about to be destroyed: end its drag without the usual
+  /// callbacks, or drop it from the dragged group.
+  void WindowDestroyed(const std::string& id, HWND hwnd);
+
+  /// Drag lifecycle, driven by whatever tracks the pointer. BeginDrag
+  /// notifies the delegate and snapshots the group; UpdateDrag moves the
+  /// group so the dragged window's top-left is at `position` (physical
+  /// screen pixels); EndDrag notifies the delegate with the final frame.
+  void BeginDrag(const std::string& id, HWND hwnd);
+  void UpdateDrag(POINT position);
+  void EndDrag();
+
  private:
+  /// Longest gap between "moved" events sent to Dart during a drag.
+  static constexpr double kProgressInterval = 1.0 / 30;
+  /// Span of mouse-move history the release velocity is measured over.
+  static constexpr DWORD kVelocityWindowMs = 50;
+
+  struct GroupMember {
+    HWND hwnd;
+    /// Top-left relative to the dragged window's top-left.
+    POINT offset;
+  };
+
   DragCoordinatorDelegate* delegate_ = nullptr;
-  std::string active_drag_id_;
+  EventSink event_sink_;
+  BinaryChannel* binary_channel_ = nullptr;
+  /// Interned (IdTable); null when no drag is running.
+  const std::string* active_drag_id_ = nullptr;
+  WindowHandle drag_handle_ = kInvalidWindowHandle;
   bool is_dragging_ = false;
+  HWND drag_hwnd_ = nullptr;
+  /// The dragged panel's window, whose DPI is held; null for other windows.
+  PaletteWindow* drag_window_ = nullptr;
+  RECT drag_frame_ = {};
+  /// Cursor relative to the dragged window's top-left.
+  POINT grab_ = {};
+  /// Reused across drags.
+  std::vector<GroupMember> group_;
+  std::vector<std::string> follower_ids_;
+
+  /// Last WM_MOUSEMOVE seen by the loop, as the anchor for
+  /// GetMouseMovePointsEx.
+  POINT last_move_point_ = {};
+  DWORD last_move_time_ = 0;
+  double last_progress_time_ = 0;
+
+  void CaptureGroup();
+  void ApplyGroupMove(POINT position);
+
+  /// Pump messages until the drag ends. Returns false if it was cancelled.
+  bool RunDragLoop(HWND hwnd);
+  void TrackPointer();
+  /// Apply the dragged panel's held DPI change about `pivot` once it has
+  /// settled, or (`release`) whatever is held at the end of the drag.
+  void SettleDpi(POINT pivot, bool release);
+  /// Release velocity in physical pixels per second.
+  POINT ReleaseVelocity() const;
+  void EmitFrameEvent(const char* event, double scale,
+                      flutter::EncodableMap extra = {});
+  /// Throttled "moved": binary for a bound window, else an event.
+  void EmitMoved(double scale);
 };
 
 }  // namespace floating_palette
@@ -0,0 +1,256 @@
+#include "active_app_tracker.h"
+
+#include <dwmapi.h>
+
+#include <future>
+#include <utility>
+
+#include "palette_panel.h"
+
+namespace floating_palette {
+
+namespace {
+
+constexpr wchar_t kTrackerClassName[] = L"FloatingPaletteActiveApp";
+
+bool SameRect(const RECT& a, const RECT& b) {
+  return a.left == b.left && a.top == b.top && a.right == b.right &&
+         a.bottom == b.bottom;
+}
+
+}  // namespace
+
+// static
+ActiveAppTracker& ActiveAppTracker::Instance() {
+  static ActiveAppTracker instance;
+  return instance;
+}
+
+void ActiveAppTracker::Start(Listener listener) {
+  listener_ = std::move(listener);
+  if (worker_.joinable()) return;
+
+  WNDCLASSEXW wc = {};
+  wc.cbSize = sizeof(wc);
+  wc.lpfnWndProc = MessageWndProc;
+  wc.hInstance = GetModuleHandle(nullptr);
+  wc.lpszClassName = kTrackerClassName;
+  RegisterClassExW(&wc);
+  message_window_ =
+      CreateWindowExW(0, kTrackerClassName, L"", 0, 0, 0, 0, 0, HWND_MESSAGE,
+                      nullptr, GetModuleHandle(nullptr), nullptr);
+
+  // Wait for the worker's message queue so Stop can always reach it.
+  std::promise<void> ready;
+  std::future<void> started = ready.get_future();
+  worker_ = std::thread([this, &ready] {
+    MSG msg;
+    PeekMessage(&msg, nullptr, WM_USER, WM_USER, PM_NOREMOVE);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      worker_thread_id_ = GetCurrentThreadId();
+    }
+    ready.set_value();
+    Run();
+  });
+  started.wait();
+}
+
+void ActiveAppTracker::Stop() {
+  listener_ = nullptr;
+  if (!worker_.joinable()) return;
+  PostThreadMessage(worker_thread_id_, WM_QUIT, 0, 0);
+  worker_.join();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    worker_thread_id_ = 0;
+    snapshot_ = Snapshot{};
+  }
+  if (message_window_) {
+    DestroyWindow(message_window_);
+    message_window_ = nullptr;
+  }
+  notify_posted_.store(false);
+}
+
+ActiveAppTracker::Snapshot ActiveAppTracker::Current() const {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (worker_thread_id_) return snapshot_;
+  }
+  // Not tracking (no ScreenService yet): answer directly, uncached.
+  Snapshot snapshot;
+  HWND hwnd = GetForegroundWindow();
+  if (!hwnd || !QueryBounds(hwnd, &snapshot.bounds)) return snapshot;
+  snapshot.valid = true;
+  GetWindowThreadProcessId(hwnd, &snapshot.process_id);
+  HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE,
+                               snapshot.process_id);
+  if (process) {
+    snapshot.identifier = QueryProcessName(process);
+    CloseHandle(process);
+  }
+  return snapshot;
+}
+
+void ActiveAppTracker::Run() {
+  foreground_hook_ = SetWinEventHook(
+      EVENT_SYSTEM_FOREGROUND, EVENT_SYSTEM_FOREGROUND, nullptr, OnWinEvent,
+      0, 0, WINEVENT_OUTOFCONTEXT);
+  OnForeground(GetForegroundWindow());
+
+  MSG msg;
+  while (GetMessage(&msg, nullptr, 0, 0) > 0) {
+    TranslateMessage(&msg);
+    DispatchMessage(&msg);
+  }
+
+  if (location_hook_) UnhookWinEvent(location_hook_);
+  if (foreground_hook_) UnhookWinEvent(foreground_hook_);
+  location_hook_ = foreground_hook_ = nullptr;
+  hooked_process_ = 0;
+  foreground_ = nullptr;
+  for (auto& [id, cached] : processes_) CloseHandle(cached.process);
+  processes_.clear();
+}
+
+void ActiveAppTracker::OnForeground(HWND hwnd) {
+  // Focusing a palette leaves the app it floats over as the active one.
+  if (!hwnd || PalettePanel::IsPanel(hwnd)) return;
+  foreground_ = hwnd;
+  DWORD process_id = 0;
+  GetWindowThreadProcessId(hwnd, &process_id);
+  HookLocation(process_id);
+  Publish();
+}
+
+void ActiveAppTracker::HookLocation(DWORD process_id) {
+  if (process_id == hooked_process_ && location_hook_) return;
+  if (location_hook_) UnhookWinEvent(location_hook_);
+  location_hook_ = SetWinEventHook(
+      EVENT_OBJECT_LOCATIONCHANGE, EVENT_OBJECT_LOCATIONCHANGE, nullptr,
+      OnWinEvent, process_id, 0, WINEVENT_OUTOFCONTEXT);
+  hooked_process_ = process_id;
+}
+
+void ActiveAppTracker::Publish() {
+  Snapshot next;
+  next.valid = IsWindow(foreground_) && QueryBounds(foreground_, &next.bounds);
+  if (next.valid) {
+    GetWindowThreadProcessId(foreground_, &next.process_id);
+    next.identifier = NameFor(next.process_id);
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (next.valid == snapshot_.valid &&
+        next.process_id == snapshot_.process_id &&
+        SameRect(next.bounds, snapshot_.bounds)) {
+      return;
+    }
+    next.generation = snapshot_.generation + 1;
+    snapshot_ = std::move(next);
+  }
+  if (!notify_posted_.exchange(true) && message_window_) {
+    PostMessage(message_window_, kChangedMessage, 0, 0);
+  }
+}
+
+const std::string& ActiveAppTracker::NameFor(DWORD process_id) {
+  auto it = processes_.find(process_id);
+  if (it != processes_.end()) {
+    if (WaitForSingleObject(it->second.process, 0) == WAIT_TIMEOUT) {
+      return it->second.name;
+    }
+    // Exited; the PID is free to be reused once the handle closes.
+    CloseHandle(it->second.process);
+    processes_.erase(it);
+  }
+  if (processes_.size() >= kMaxCachedProcesses) {
+    for (auto entry = processes_.begin(); entry != processes_.end();) {
+      CloseHandle(entry->second.process);
+      entry = processes_.erase(entry);
+    }
+  }
+
+  CachedProcess cached;
+  cached.process = OpenProcess(
+      PROCESS_QUERY_LIMITED_INFORMATION | SYNCHRONIZE, FALSE, process_id);
+  if (!cached.process) {
+    static const std::string empty;
+    return empty;
+  }
+  cached.name = QueryProcessName(cached.process);
+  return processes_.emplace(process_id, std::move(cached)).first->second.name;
+}
+
+void ActiveAppTracker::Notify() {
+  notify_posted_.store(false);
+  const ULONGLONG now = GetTickCount64();
+  const ULONGLONG since = now - last_notify_;
+  if (since < kNotifyIntervalMs) {
+    // Trailing edge: the timer delivers whatever is current then.
+    SetTimer(message_window_, kThrottleTimer,
+             static_cast<UINT>(kNotifyIntervalMs - since), nullptr);
+    return;
+  }
+  KillTimer(message_window_, kThrottleTimer);
+  last_notify_ = now;
+  if (listener_) listener_(Current());
+}
+
+// static
+bool ActiveAppTracker::QueryBounds(HWND hwnd, RECT* bounds) {
+  if (IsIconic(hwnd)) return false;
+  if (SUCCEEDED(DwmGetWindowAttribute(hwnd, DWMWA_EXTENDED_FRAME_BOUNDS,
+                                      bounds, sizeof(*bounds)))) {
+    return true;
+  }
+  return GetWindowRect(hwnd, bounds) != FALSE;
+}
+
+// static
+std::string ActiveAppTracker::QueryProcessName(HANDLE process) {
+  wchar_t path[MAX_PATH];
+  DWORD length = MAX_PATH;
+  if (!QueryFullProcessImageNameW(process, 0, path, &length)) return {};
+  const wchar_t* name = path;
+  for (DWORD i = 0; i < length; ++i) {
+    if (path[i] == L'\\') name = path + i + 1;
+  }
+  const int wide_length = static_cast<int>(path + length - name);
+  const int size = WideCharToMultiByte(CP_UTF8, 0, name, wide_length, nullptr,
+                                       0, nullptr, nullptr);
+  std::string utf8(size, '\0');
+  WideCharToMultiByte(CP_UTF8, 0, name, wide_length, utf8.data(), size,
+                      nullptr, nullptr);
+  return utf8;
+}
+
+// static
+void CALLBACK ActiveAppTracker::OnWinEvent(HWINEVENTHOOK hook, DWORD event,
+                                           HWND hwnd, LONG object_id,
+                                           LONG child_id, DWORD thread,
+                                           DWORD time) {
+  ActiveAppTracker& self = Instance();
+  if (event == EVENT_SYSTEM_FOREGROUND) {
+    self.OnForeground(hwnd);
+  } else if (event == EVENT_OBJECT_LOCATIONCHANGE &&
+             object_id == OBJID_WINDOW && child_id == CHILDID_SELF &&
+             hwnd == self.foreground_) {
+    self.Publish();
+  }
+}
+
+// static
+LRESULT CALLBACK ActiveAppTracker::MessageWndProc(HWND hwnd, UINT message,
+                                                  WPARAM wparam,
+                                                  LPARAM lparam) {
+  if (message == kChangedMessage ||
+      (message == WM_TIMER && wparam == kThrottleTimer)) {
+    Instance().Notify();
+    return 0;
+  }
+  return DefWindowProc(hwnd, message, wparam, lparam);
+}
+
+}  // namespace floating_palette
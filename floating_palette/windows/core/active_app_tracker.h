@@ -0,0 +1,108 @@
+#pragma once
+
+#include <windows.h>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace floating_palette {
+
+/// The foreground application window: its bounds and process name, kept
+/// current by WinEvent hooks instead of queried on every call.
+///
+/// A worker thread owns the hooks (out-of-context WinEvent callbacks are
+/// delivered to the installing thread's message loop):
+/// EVENT_SYSTEM_FOREGROUND for activation, and EVENT_OBJECT_LOCATIONCHANGE
+/// for moves and resizes. The location hook is scoped to the foreground
+/// process and reinstalled when it changes, so the system-wide stream of
+/// caret and cursor location events never reaches us. Process names are
+/// cached per PID; the cache holds a process handle, which both detects
+/// exit and keeps the PID from being reused under a stale name.
+///
+/// Palette panels never count as the active app.
+///
+/// Readers (FFI, ScreenService) copy the latest Snapshot. Changes are
+/// reported to the platform thread through the listener, at most once per
+/// kNotifyIntervalMs; the last change in a burst is always delivered.
+class ActiveAppTracker {
+ public:
+  struct Snapshot {
+    bool valid = false;
+    /// Visible frame (without the invisible resize borders), physical px.
+    RECT bounds = {};
+    DWORD process_id = 0;
+    /// Executable name, e.g. "notepad.exe" (UTF-8).
+    std::string identifier;
+    /// Bumped on every change.
+    uint64_t generation = 0;
+  };
+
+  /// Platform thread; receives the current snapshot.
+  using Listener = std::function<void(const Snapshot& snapshot)>;
+
+  static ActiveAppTracker& Instance();
+
+  /// Start tracking and deliver changes to `listener`. Platform thread.
+  void Start(Listener listener);
+  /// Stop tracking and drop the listener. Platform thread.
+  void Stop();
+
+  /// The latest snapshot. Any thread. Before Start, queried directly.
+  Snapshot Current() const;
+
+ private:
+  static constexpr UINT kChangedMessage = WM_APP + 1;
+  static constexpr UINT_PTR kThrottleTimer = 1;
+  static constexpr DWORD kNotifyIntervalMs = 50;
+  static constexpr size_t kMaxCachedProcesses = 32;
+
+  struct CachedProcess {
+    HANDLE process = nullptr;
+    std::string name;
+  };
+
+  ActiveAppTracker() = default;
+
+  // Worker thread.
+  void Run();
+  void OnForeground(HWND hwnd);
+  void Publish();
+  void HookLocation(DWORD process_id);
+  const std::string& NameFor(DWORD process_id);
+
+  // Platform thread.
+  void Notify();
+
+  /// Bounds of `hwnd`, or false if it is minimized or gone.
+  static bool QueryBounds(HWND hwnd, RECT* bounds);
+  static std::string QueryProcessName(HANDLE process);
+
+  static void CALLBACK OnWinEvent(HWINEVENTHOOK hook, DWORD event, HWND hwnd,
+                                  LONG object_id, LONG child_id, DWORD thread,
+                                  DWORD time);
+  static LRESULT CALLBACK MessageWndProc(HWND hwnd, UINT message,
+                                         WPARAM wparam, LPARAM lparam);
+
+  mutable std::mutex mutex_;
+  Snapshot snapshot_;
+
+  Listener listener_;
+  HWND message_window_ = nullptr;
+  std::atomic<bool> notify_posted_{false};
+  ULONGLONG last_notify_ = 0;
+
+  std::thread worker_;
+  DWORD worker_thread_id_ = 0;
+  HWINEVENTHOOK foreground_hook_ = nullptr;
+  HWINEVENTHOOK location_hook_ = nullptr;
+  DWORD hooked_process_ = 0;
+  HWND foreground_ = nullptr;
+  std::unordered_map<DWORD, CachedProcess> processes_;
+};
+
+}  // namespace floating_palette
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace floating_palette {
+
+/// Easing curves shared by window animations and the glass animation
+/// buffer. The first four values match GlassAnimationCurve in
+/// src/ffi_interface.h and must stay in sync with it.
+enum class AnimationCurve : uint8_t {
+  kLinear = 0,        // t
+  kEaseOut = 1,       // 1 - (1-t)^2
+  kEaseOutCubic = 2,  // 1 - (1-t)^3
+  kEaseInOut = 3,     // t < 0.5 ? 2t^2 : 1 - (-2t+2)^2/2
+  kEaseIn = 4,        // t^2 (animation service only)
+};
+
+/// Curve from an AnimationClient curve name. Unknown names fall back to
+/// easeInOut, like the macOS service.
+inline AnimationCurve ParseAnimationCurve(const std::string& name) {
+  if (name == "linear") return AnimationCurve::kLinear;
+  if (name == "easeIn") return AnimationCurve::kEaseIn;
+  if (name == "easeOut") return AnimationCurve::kEaseOut;
+  if (name == "easeOutCubic") return AnimationCurve::kEaseOutCubic;
+  return AnimationCurve::kEaseInOut;
+}
+
+/// Map linear progress `t` in [0, 1] through `curve`.
+inline double ApplyAnimationCurve(AnimationCurve curve, double t) {
+  if (t <= 0.0) return 0.0;
+  if (t >= 1.0) return 1.0;
+  switch (curve) {
+    case AnimationCurve::kLinear:
+      return t;
+    case AnimationCurve::kEaseOut:
+      return 1.0 - (1.0 - t) * (1.0 - t);
+    case AnimationCurve::kEaseOutCubic: {
+      double inv = 1.0 - t;
+      return 1.0 - inv * inv * inv;
+    }
+    case AnimationCurve::kEaseInOut: {
+      if (t < 0.5) return 2.0 * t * t;
+      double u = -2.0 * t + 2.0;
+      return 1.0 - u * u / 2.0;
+    }
+    case AnimationCurve::kEaseIn:
+      return t * t;
+  }
+  return t;
+}
+
+}  // namespace floating_palette
@@ -0,0 +1,405 @@
+#include "animation_engine.h"
+
+#include <dwmapi.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "clock.h"
+#include "logger.h"
+#include "metrics.h"
+#include "trace.h"
+
+namespace floating_palette {
+
+namespace {
+
+constexpr wchar_t kAnimationClassName[] = L"FloatingPaletteAnimation";
+
+// Fallback frame interval when DwmFlush fails (composition unavailable).
+constexpr DWORD kFallbackFrameMs = 16;
+
+}  // namespace
+
+std::optional<AnimatedProperty> ParseAnimatedProperty(const std::string& name) {
+  if (name == "x") return AnimatedProperty::kX;
+  if (name == "y") return AnimatedProperty::kY;
+  if (name == "width") return AnimatedProperty::kWidth;
+  if (name == "height") return AnimatedProperty::kHeight;
+  if (name == "opacity" || name == "alpha") return AnimatedProperty::kOpacity;
+  return std::nullopt;
+}
+
+const char* AnimatedPropertyName(AnimatedProperty property) {
+  switch (property) {
+    case AnimatedProperty::kX:
+      return "x";
+    case AnimatedProperty::kY:
+      return "y";
+    case AnimatedProperty::kWidth:
+      return "width";
+    case AnimatedProperty::kHeight:
+      return "height";
+    case AnimatedProperty::kOpacity:
+      return "opacity";
+  }
+  return "";
+}
+
+AnimationEngine::AnimationEngine(CompletionHandler on_complete)
+    : on_complete_(std::move(on_complete)) {
+  WNDCLASSEXW wc = {};
+  wc.cbSize = sizeof(wc);
+  wc.lpfnWndProc = MessageWndProc;
+  wc.hInstance = GetModuleHandle(nullptr);
+  wc.lpszClassName = kAnimationClassName;
+  RegisterClassExW(&wc);
+
+  message_window_ =
+      CreateWindowExW(0, kAnimationClassName, L"", 0, 0, 0, 0, 0, HWND_MESSAGE,
+                      nullptr, GetModuleHandle(nullptr), nullptr);
+  SetWindowLongPtr(message_window_, GWLP_USERDATA,
+                   reinterpret_cast<LONG_PTR>(this));
+
+  vsync_thread_ = std::thread(&AnimationEngine::VsyncLoop, this);
+}
+
+AnimationEngine::~AnimationEngine() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+  }
+  wake_.notify_one();
+  if (vsync_thread_.joinable()) vsync_thread_.join();
+
+  if (message_window_) {
+    SetWindowLongPtr(message_window_, GWLP_USERDATA, 0);
+    DestroyWindow(message_window_);
+  }
+}
+
+bool AnimationEngine::Start(const std::string& window_id,
+                            const std::vector<Spec>& specs,
+                            std::optional<double> start_time) {
+  auto& store = WindowStore::Instance();
+  WindowHandle handle = store.Resolve(window_id);
+  PaletteWindow* window = store.Get(handle);
+  if (!window) return false;
+
+  double now = start_time.value_or(MonotonicSeconds());
+  for (const auto& spec : specs) {
+    Track* track = FindTrack(handle, spec.property);
+    // Retarget from the in-flight value rather than jumping back to the
+    // window's last applied value.
+    double from = spec.from.value_or(track ? track->current
+                                           : ReadCurrent(*window, spec.property));
+    if (!track) {
+      tracks_.push_back(Track{});
+      track = &tracks_.back();
+    }
+    track->handle = handle;
+    track->window_id = window_id;
+    track->property = spec.property;
+    track->from = from;
+    track->to = spec.to;
+    track->start_time = now;
+    track->duration = std::max(spec.duration, 0.0);
+    track->curve = spec.curve;
+    track->repeat = std::max(spec.repeat, 1);
+    track->auto_reverse = spec.auto_reverse;
+    track->current = from;
+  }
+
+  if (!tracks_.empty()) SetActive(true);
+  return true;
+}
+
+void AnimationEngine::Stop(const std::string& window_id,
+                           std::optional<AnimatedProperty> property) {
+  tracks_.erase(std::remove_if(tracks_.begin(), tracks_.end(),
+                               [&](const Track& track) {
+                                 return track.window_id == window_id &&
+                                        (!property ||
+                                         track.property == *property);
+                               }),
+                tracks_.end());
+  if (tracks_.empty()) SetActive(false);
+}
+
+void AnimationEngine::StopAll(const std::string* window_id) {
+  if (window_id) {
+    Stop(*window_id, std::nullopt);
+    return;
+  }
+  tracks_.clear();
+  SetActive(false);
+}
+
+bool AnimationEngine::IsAnimating(
+    const std::string& window_id,
+    std::optional<AnimatedProperty> property) const {
+  return std::any_of(tracks_.begin(), tracks_.end(), [&](const Track& track) {
+    return track.window_id == window_id &&
+           (!property || track.property == *property);
+  });
+}
+
+AnimationEngine::Track* AnimationEngine::FindTrack(WindowHandle handle,
+                                                   AnimatedProperty property) {
+  for (auto& track : tracks_) {
+    if (track.handle == handle && track.property == property) return &track;
+  }
+  return nullptr;
+}
+
+// static
+double AnimationEngine::ReadCurrent(const PaletteWindow& window,
+                                    AnimatedProperty property) {
+  if (property == AnimatedProperty::kOpacity) {
+    if (!(GetWindowLong(window.hwnd, GWL_EXSTYLE) & WS_EX_LAYERED)) return 1.0;
+    BYTE alpha = 255;
+    DWORD flags = 0;
+    if (!GetLayeredWindowAttributes(window.hwnd, nullptr, &alpha, &flags) ||
+        !(flags & LWA_ALPHA)) {
+      return 1.0;
+    }
+    return alpha / 255.0;
+  }
+
+  RECT rect;
+  GetWindowRect(window.hwnd, &rect);
+  switch (property) {
+    case AnimatedProperty::kX:
+      return rect.left;
+    case AnimatedProperty::kY:
+      return rect.top;
+    case AnimatedProperty::kWidth:
+      return rect.right - rect.left;
+    case AnimatedProperty::kHeight:
+      return rect.bottom - rect.top;
+    default:
+      return 0.0;
+  }
+}
+
+// static
+double AnimationEngine::Sample(const Track& track, double now,
+                               bool* finished) {
+  // One iteration is forward (and back, with autoReverse); like macOS, an
+  // auto-reversing animation settles on `from`.
+  double leg = track.duration;
+  int legs_per_iteration = track.auto_reverse ? 2 : 1;
+  double total = leg * legs_per_iteration * track.repeat;
+  double elapsed = now - track.start_time;
+
+  if (leg <= 0.0 || elapsed >= total) {
+    *finished = true;
+    return track.auto_reverse ? track.from : track.to;
+  }
+  *finished = false;
+
+  double legs = elapsed / leg;
+  double leg_index = std::floor(legs);
+  double t = legs - leg_index;
+  bool reversed =
+      track.auto_reverse && (static_cast<int64_t>(leg_index) % 2 == 1);
+  double eased = ApplyAnimationCurve(track.curve, reversed ? 1.0 - t : t);
+  return track.from + (track.to - track.from) * eased;
+}
+
+void AnimationEngine::SetActive(bool active) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (active_ == active) return;
+    active_ = active;
+  }
+  if (active) wake_.notify_one();
+}
+
+void AnimationEngine::VsyncLoop() {
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      wake_.wait(lock, [this] { return active_ || shutdown_; });
+      if (shutdown_) return;
+    }
+
+    // Blocks until the next composition pass, i.e. once per refresh.
+    if (FAILED(DwmFlush())) Sleep(kFallbackFrameMs);
+
+    // Skip the post while the previous tick is still queued so a busy
+    // platform thread sees one tick, not a backlog.
+    if (!tick_pending_.exchange(true, std::memory_order_acq_rel)) {
+      if (!PostMessage(message_window_, kTickMessage, 0, 0)) {
+        tick_pending_.store(false, std::memory_order_release);
+      }
+    } else {
+      Metrics::Instance().RecordAnimationFrameDropped();
+      trace::AnimationFrameDropped();
+    }
+  }
+}
+
+void AnimationEngine::Tick() {
+  tick_pending_.store(false, std::memory_order_release);
+  if (tracks_.empty()) return;
+  Metrics::Instance().RecordAnimationFrame();
+
+  double now = MonotonicSeconds();
+  auto& store = WindowStore::Instance();
+
+  // Completions fire after all tracks are applied and removed, so a handler
+  // that starts a follow-up animation sees a consistent track list.
+  std::vector<std::pair<std::string, AnimatedProperty>> completed;
+  std::vector<const Track*> window_tracks;
+
+  // Group by window: one frame update per window, all flushed together.
+  frame_updates_.clear();
+  std::vector<bool> done(tracks_.size(), false);
+  std::vector<bool> visited(tracks_.size(), false);
+  for (size_t i = 0; i < tracks_.size(); ++i) {
+    if (visited[i]) continue;
+    WindowHandle handle = tracks_[i].handle;
+    window_tracks.clear();
+    for (size_t j = i; j < tracks_.size(); ++j) {
+      if (visited[j] || tracks_[j].handle != handle) continue;
+      visited[j] = true;
+      bool finished = false;
+      tracks_[j].current = Sample(tracks_[j], now, &finished);
+      done[j] = finished;
+      window_tracks.push_back(&tracks_[j]);
+    }
+
+    PaletteWindow* window = store.Get(handle);
+    if (!window) {
+      // Window destroyed mid-animation: drop silently.
+      for (const Track* track : window_tracks) {
+        done[track - tracks_.data()] = true;
+      }
+      continue;
+    }
+    Apply(*window, window_tracks);
+    for (const Track* track : window_tracks) {
+      if (done[track - tracks_.data()]) {
+        completed.emplace_back(track->window_id, track->property);
+      }
+    }
+  }
+
+  FlushFrameUpdates();
+
+  size_t write = 0;
+  for (size_t read = 0; read < tracks_.size(); ++read) {
+    if (done[read]) continue;
+    if (write != read) tracks_[write] = std::move(tracks_[read]);
+    ++write;
+  }
+  tracks_.resize(write);
+  if (tracks_.empty()) SetActive(false);
+
+  for (const auto& [window_id, property] : completed) {
+    FP_LOG("Animation", "complete ", window_id, " ",
+           AnimatedPropertyName(property));
+    if (on_complete_) on_complete_(window_id, property);
+  }
+}
+
+void AnimationEngine::Apply(PaletteWindow& window,
+                            const std::vector<const Track*>& tracks) {
+  RECT rect;
+  GetWindowRect(window.hwnd, &rect);
+  int x = rect.left;
+  int y = rect.top;
+  int width = rect.right - rect.left;
+  int height = rect.bottom - rect.top;
+  bool moved = false;
+  bool sized = false;
+
+  for (const Track* track : tracks) {
+    int value = static_cast<int>(std::lround(track->current));
+    switch (track->property) {
+      case AnimatedProperty::kX:
+        moved |= value != x;
+        x = value;
+        break;
+      case AnimatedProperty::kY:
+        moved |= value != y;
+        y = value;
+        break;
+      case AnimatedProperty::kWidth:
+        sized |= value != width;
+        width = std::max(value, 0);
+        break;
+      case AnimatedProperty::kHeight:
+        sized |= value != height;
+        height = std::max(value, 0);
+        break;
+      case AnimatedProperty::kOpacity: {
+        double alpha = std::clamp(track->current, 0.0, 1.0);
+        // The compositor fades without redrawing the panel; the layered
+        // alpha is only the fallback when DirectComposition is missing.
+        if (window.composition.SetOpacity(window, alpha, 0,
+                                          AnimationCurve::kLinear)) {
+          break;
+        }
+        LONG ex_style = GetWindowLong(window.hwnd, GWL_EXSTYLE);
+        if (!(ex_style & WS_EX_LAYERED)) {
+          SetWindowLong(window.hwnd, GWL_EXSTYLE, ex_style | WS_EX_LAYERED);
+        }
+        SetLayeredWindowAttributes(
+            window.hwnd, 0, static_cast<BYTE>(std::lround(alpha * 255.0)),
+            LWA_ALPHA);
+        break;
+      }
+    }
+  }
+
+  if (!moved && !sized) return;
+  UINT flags = SWP_NOZORDER | SWP_NOOWNERZORDER | SWP_NOACTIVATE;
+  if (!moved) flags |= SWP_NOMOVE;
+  if (!sized) flags |= SWP_NOSIZE;
+  frame_updates_.push_back({window.hwnd, x, y, width, height, flags});
+}
+
+void AnimationEngine::FlushFrameUpdates() {
+  if (frame_updates_.empty()) return;
+  ++frame_count_;
+  batched_window_count_ += frame_updates_.size();
+  trace::AnimationFrame(frame_updates_.size());
+
+  HDWP batch = BeginDeferWindowPos(static_cast<int>(frame_updates_.size()));
+  size_t deferred = 0;
+  for (; batch && deferred < frame_updates_.size(); ++deferred) {
+    const auto& update = frame_updates_[deferred];
+    // DeferWindowPos frees the batch on failure and returns null.
+    batch = DeferWindowPos(batch, update.hwnd, nullptr, update.x, update.y,
+                           update.width, update.height, update.flags);
+  }
+  if (batch && EndDeferWindowPos(batch)) {
+    Metrics::Instance().RecordWindowPosBatch(frame_updates_.size());
+    return;
+  }
+
+  // The batch failed (e.g. a window died mid-tick): apply the rest
+  // individually so no window misses this frame.
+  FP_LOG("Animation", "DeferWindowPos failed, applying individually");
+  for (const auto& update : frame_updates_) {
+    SetWindowPos(update.hwnd, nullptr, update.x, update.y, update.width,
+                 update.height, update.flags);
+    Metrics::Instance().RecordWindowPos();
+  }
+}
+
+// static
+LRESULT CALLBACK AnimationEngine::MessageWndProc(HWND hwnd, UINT message,
+                                                 WPARAM wparam, LPARAM lparam) {
+  if (message == kTickMessage) {
+    auto* engine = reinterpret_cast<AnimationEngine*>(
+        GetWindowLongPtr(hwnd, GWLP_USERDATA));
+    if (engine) engine->Tick();
+    return 0;
+  }
+  return DefWindowProc(hwnd, message, wparam, lparam);
+}
+
+}  // namespace floating_palette
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <windows.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "animation_curve.h"
+#include "window_store.h"
+
+namespace floating_palette {
+
+/// Window properties the native engine can animate. Frame values are in the
+/// same physical-pixel space as FloatingPalette_GetWindowFrame; opacity is
+/// 0..1 (applied through CompositionLayer, or the layered-window alpha
+/// where DirectComposition is unavailable).
+enum class AnimatedProperty { kX, kY, kWidth, kHeight, kOpacity };
+
+std::optional<AnimatedProperty> ParseAnimatedProperty(const std::string& name);
+const char* AnimatedPropertyName(AnimatedProperty property);
+
+/// Native, vsync-driven animation timeline shared by every palette window.
+///
+/// Dart sends one command per animation (or one per group of windows); the
+/// engine interpolates on every display refresh until done. A worker thread
+/// blocks in DwmFlush() (which returns once per composition, i.e. at the
+/// display rate) and posts a tick to the platform thread, where values are
+/// computed and applied. With no active tracks the worker sleeps on a
+/// condition variable, so an idle engine causes no wakeups.
+///
+/// Each tick moves every animating window in a single
+/// BeginDeferWindowPos/EndDeferWindowPos batch, so a fan-out of several
+/// palettes repositions atomically once per frame instead of once per
+/// window.
+///
+/// Starting an animation on a (window, property) that is already animating
+/// retargets it: without an explicit `from`, it continues from the current
+/// in-flight value.
+///
+/// Platform thread only, except for the internal worker.
+class AnimationEngine {
+ public:
+  struct Spec {
+    AnimatedProperty property;
+    std::optional<double> from;
+    double to = 0.0;
+    double duration = 0.3;  // seconds
+    AnimationCurve curve = AnimationCurve::kEaseInOut;
+    int repeat = 1;
+    bool auto_reverse = false;
+  };
+
+  /// Called on the platform thread when a track runs to completion (not
+  /// when it is stopped or retargeted).
+  using CompletionHandler = std::function<void(const std::string& window_id,
+                                               AnimatedProperty property)>;
+
+  explicit AnimationEngine(CompletionHandler on_complete);
+  ~AnimationEngine();
+
+  AnimationEngine(const AnimationEngine&) = delete;
+  AnimationEngine& operator=(const AnimationEngine&) = delete;
+
+  /// Start (or retarget) `specs` on one window with a shared start time.
+  /// Pass the same `start_time` (MonotonicSeconds) to several calls to run
+  /// them on one timeline; by default they start now. Returns false if the
+  /// window doesn't exist.
+  bool Start(const std::string& window_id, const std::vector<Spec>& specs,
+             std::optional<double> start_time = std::nullopt);
+
+  /// Stop one property, or all of the window's properties if nullopt. The
+  /// window keeps its current in-flight value.
+  void Stop(const std::string& window_id,
+            std::optional<AnimatedProperty> property);
+
+  /// Stop a window's animations, or every animation if `window_id` is null.
+  void StopAll(const std::string* window_id);
+
+  bool IsAnimating(const std::string& window_id,
+                   std::optional<AnimatedProperty> property) const;
+
+  /// Number of ticks that moved at least one window, and the windows those
+  /// batches covered (windows / frames ~= fan-out per frame).
+  uint64_t frame_count() const { return frame_count_; }
+  uint64_t batched_window_count() const { return batched_window_count_; }
+
+ private:
+  static constexpr UINT kTickMessage = WM_APP + 4;
+
+  struct Track {
+    WindowHandle handle;
+    std::string window_id;
+    AnimatedProperty property;
+    double from;
+    double to;
+    double start_time;
+    double duration;
+    AnimationCurve curve;
+    int repeat;
+    bool auto_reverse;
+    double current;
+  };
+
+  /// A pending frame change for one window, applied in the per-tick batch.
+  struct FrameUpdate {
+    HWND hwnd;
+    int x;
+    int y;
+    int width;
+    int height;
+    UINT flags;
+  };
+
+  CompletionHandler on_complete_;
+  std::vector<Track> tracks_;
+  std::vector<FrameUpdate> frame_updates_;
+  uint64_t frame_count_ = 0;
+  uint64_t batched_window_count_ = 0;
+  HWND message_window_ = nullptr;
+
+  // Worker state.
+  std::thread vsync_thread_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  bool active_ = false;
+  bool shutdown_ = false;
+  std::atomic<bool> tick_pending_{false};
+
+  Track* FindTrack(WindowHandle handle, AnimatedProperty property);
+  static double ReadCurrent(const PaletteWindow& window,
+                            AnimatedProperty property);
+  static double Sample(const Track& track, double now, bool* finished);
+
+  void SetActive(bool active);
+  void VsyncLoop();
+  void Tick();
+  void Apply(PaletteWindow& window, const std::vector<const Track*>& tracks);
+  void FlushFrameUpdates();
+
+  static LRESULT CALLBACK MessageWndProc(HWND hwnd, UINT message,
+                                         WPARAM wparam, LPARAM lparam);
+};
+
+}  // namespace floating_palette
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <flutter/encodable_value.h>
+#include <flutter/method_result.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace floating_palette {
+
+/// Collects per-command results of a `batch` call and answers it once
+/// every command has completed, synchronously or not.
+///
+/// Each command gets its own Slot() result. A slot destroyed without a
+/// reply (a handler path that forgot to answer) fills its entry with a
+/// NO_REPLY error, so a dropped result can't leave the batch, and the Dart
+/// future awaiting it, hanging. Platform thread only.
+class BatchCollector {
+ public:
+  using Result = flutter::MethodResult<flutter::EncodableValue>;
+
+  BatchCollector(size_t count, std::unique_ptr<Result> result)
+      : results_(count), remaining_(count), result_(std::move(result)) {}
+
+  BatchCollector(const BatchCollector&) = delete;
+  BatchCollector& operator=(const BatchCollector&) = delete;
+
+  /// The result for command `index`. Keeps the collector alive until it
+  /// replies or is destroyed.
+  static std::unique_ptr<Result> Slot(
+      const std::shared_ptr<BatchCollector>& self,
+      size_t index) {
+    return std::make_unique<SlotResult>(self, index);
+  }
+
+  /// Batch entries: {ok, value} or {ok, code, message}.
+  static flutter::EncodableValue SuccessEntry(
+      const flutter::EncodableValue* value) {
+    return flutter::EncodableValue(flutter::EncodableMap{
+        {flutter::EncodableValue("ok"), flutter::EncodableValue(true)},
+        {flutter::EncodableValue("value"),
+         value ? *value : flutter::EncodableValue()},
+    });
+  }
+
+  static flutter::EncodableValue ErrorEntry(const std::string& code,
+                                            const std::string& message) {
+    return flutter::EncodableValue(flutter::EncodableMap{
+        {flutter::EncodableValue("ok"), flutter::EncodableValue(false)},
+        {flutter::EncodableValue("code"), flutter::EncodableValue(code)},
+        {flutter::EncodableValue("message"),
+         flutter::EncodableValue(message)},
+    });
+  }
+
+ private:
+  class SlotResult : public Result {
+   public:
+    SlotResult(std::shared_ptr<BatchCollector> collector, size_t index)
+        : collector_(std::move(collector)), index_(index) {}
+
+    ~SlotResult() override {
+      if (collector_) {
+        collector_->Complete(index_,
+                             ErrorEntry("NO_REPLY", "Command never replied"));
+      }
+    }
+
+   protected:
+    void SuccessInternal(const flutter::EncodableValue* value) override {
+      Reply(SuccessEntry(value));
+    }
+    void ErrorInternal(const std::string& code, const std::string& message,
+                       const flutter::EncodableValue*) override {
+      Reply(ErrorEntry(code, message));
+    }
+    void NotImplementedInternal() override {
+      Reply(ErrorEntry("NOT_IMPLEMENTED", "Command not implemented"));
+    }
+
+   private:
+    /// First reply wins; the collector is released with it.
+    void Reply(flutter::EncodableValue value) {
+      if (!collector_) return;
+      std::shared_ptr<BatchCollector> collector = std::move(collector_);
+      collector->Complete(index_, std::move(value));
+    }
+
+    std::shared_ptr<BatchCollector> collector_;
+    size_t index_;
+  };
+
+  void Complete(size_t index, flutter::EncodableValue value) {
+    results_[index] = std::move(value);
+    if (--remaining_ == 0) {
+      result_->Success(flutter::EncodableValue(std::move(results_)));
+    }
+  }
+
+  flutter::EncodableList results_;
+  size_t remaining_;
+  std::unique_ptr<Result> result_;
+};
+
+}  // namespace floating_palette
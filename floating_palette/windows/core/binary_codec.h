@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace floating_palette {
+
+/// Fixed-layout messages for the `floating_palette/binary` channel, which
+/// carries the highest-rate traffic (frame set/get, animation start/stop,
+/// drag and snap-follower updates) without StandardMethodCodec maps.
+///
+/// Every message, in both directions, is exactly kBinaryMessageSize bytes,
+/// little-endian:
+///
+///   offset  size  field
+///        0     2  opcode (BinaryOp)
+///        2     2  flags: request options, or a BinaryStatus in a reply
+///        4     4  window handle (WindowHandle)
+///        8     4  arg: duration in ms, or a second window handle
+///       12    24  payload: six float32, meaning set by the opcode
+///
+/// A request is answered with its own opcode and a status in flags. Events
+/// use opcodes from 0x80 and expect no reply. Encoding and decoding copy
+/// into caller storage and never allocate.
+///
+/// Must stay in sync with lib/src/bridge/binary_codec.dart.
+enum class BinaryOp : uint16_t {
+  // Requests (Dart -> native). Logical pixels.
+  kSetPosition = 1,    // x, y (top-left)
+  kSetSize = 2,        // width, height
+  kSetBounds = 3,      // x, y, width, height
+  kGetBounds = 4,      // reply: x, y, width, height
+  kAnimate = 5,        // property (AnimatedProperty), to, from
+  kStopAnimation = 6,  // property; kBinaryFlagAllProperties for every one
+
+  // Events (native -> Dart).
+  kDragMoved = 0x81,         // x, y
+  kFollowerDragging = 0x82,  // arg: target handle; distance, x, y, w, h
+};
+
+/// Request flags. The animation curve (AnimationCurve) rides in the high
+/// byte; arg is the duration in ms, 0 for the service default.
+constexpr uint16_t kBinaryFlagAnimate = 1 << 0;
+constexpr uint16_t kBinaryFlagHasFrom = 1 << 1;
+constexpr uint16_t kBinaryFlagAllProperties = 1 << 2;
+constexpr int kBinaryCurveShift = 8;
+
+/// Reply status, in flags.
+enum class BinaryStatus : uint16_t {
+  kOk = 0,
+  kNotFound = 1,
+  kInvalidParams = 2,
+  kUnknownOpcode = 3,
+};
+
+struct BinaryMessage {
+  uint16_t opcode = 0;
+  uint16_t flags = 0;
+  int32_t handle = 0;
+  int32_t arg = 0;
+  float payload[6] = {};
+};
+
+// Naturally aligned, so no packing pragma is needed; Windows targets are
+// all little-endian, so the struct is the wire format.
+static_assert(sizeof(BinaryMessage) == 36, "BinaryMessage wire layout");
+constexpr size_t kBinaryMessageSize = sizeof(BinaryMessage);
+
+/// Decode one message; false unless `size` is exactly one message.
+inline bool DecodeBinaryMessage(const uint8_t* data,
+                                size_t size,
+                                BinaryMessage* out) {
+  if (!data || size != kBinaryMessageSize) return false;
+  std::memcpy(out, data, kBinaryMessageSize);
+  return true;
+}
+
+inline void EncodeBinaryMessage(const BinaryMessage& message,
+                                uint8_t (&out)[kBinaryMessageSize]) {
+  std::memcpy(out, &message, kBinaryMessageSize);
+}
+
+}  // namespace floating_palette
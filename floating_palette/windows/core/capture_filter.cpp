@@ -0,0 +1,241 @@
+#include "capture_filter.h"
+
+#include <d3dcompiler.h>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include "logger.h"
+
+namespace floating_palette {
+
+namespace {
+
+// Fullscreen triangle from SV_VertexID; no vertex buffer.
+//
+// ps_down is the dual-Kawase downsample (centre weighted 4, plus four
+// diagonal taps half a source texel out, each a bilinear 2x2 average), so
+// halving the size doesn't alias. ps_blur is a Kawase pass: four bilinear
+// taps `offset + 0.5` texels out along the diagonals.
+constexpr char kShaderSource[] = R"(
+Texture2D source : register(t0);
+SamplerState linear_clamp : register(s0);
+cbuffer Params : register(b0) {
+  float2 texel;
+  float offset;
+  float padding;
+};
+struct VsOut {
+  float4 position : SV_Position;
+  float2 uv : TEXCOORD0;
+};
+VsOut vs_main(uint id : SV_VertexID) {
+  VsOut o;
+  o.uv = float2((id << 1) & 2, id & 2);
+  o.position = float4(o.uv * float2(2, -2) + float2(-1, 1), 0, 1);
+  return o;
+}
+float4 ps_down(VsOut i) : SV_Target {
+  float2 h = texel * 0.5;
+  float4 sum = source.Sample(linear_clamp, i.uv) * 4;
+  sum += source.Sample(linear_clamp, i.uv - h);
+  sum += source.Sample(linear_clamp, i.uv + h);
+  sum += source.Sample(linear_clamp, i.uv + float2(h.x, -h.y));
+  sum += source.Sample(linear_clamp, i.uv - float2(h.x, -h.y));
+  return sum / 8;
+}
+float4 ps_blur(VsOut i) : SV_Target {
+  float2 d = texel * (offset + 0.5);
+  float4 sum = source.Sample(linear_clamp, i.uv + float2(-d.x, -d.y));
+  sum += source.Sample(linear_clamp, i.uv + float2(d.x, -d.y));
+  sum += source.Sample(linear_clamp, i.uv + float2(-d.x, d.y));
+  sum += source.Sample(linear_clamp, i.uv + d);
+  return sum * 0.25;
+}
+)";
+
+// Kawase offsets per pass; growing offsets widen the kernel without more
+// taps.
+constexpr float kKawaseOffsets[] = {0, 1, 2, 2, 3, 4, 5, 6};
+constexpr int kMaxBlurPasses =
+    static_cast<int>(sizeof(kKawaseOffsets) / sizeof(kKawaseOffsets[0]));
+
+winrt::com_ptr<ID3DBlob> Compile(const char* entry, const char* target) {
+  winrt::com_ptr<ID3DBlob> code;
+  winrt::com_ptr<ID3DBlob> errors;
+  HRESULT hr = D3DCompile(kShaderSource, sizeof(kShaderSource) - 1,
+                          "capture_filter", nullptr, nullptr, entry, target,
+                          D3DCOMPILE_OPTIMIZATION_LEVEL3, 0, code.put(),
+                          errors.put());
+  if (FAILED(hr)) {
+    std::string message = errors ? std::string(static_cast<const char*>(
+                                                   errors->GetBufferPointer()),
+                                               errors->GetBufferSize())
+                                 : std::string("D3DCompile failed");
+    FP_LOG("Capture", "shader ", entry, ": ", message);
+    return nullptr;
+  }
+  return code;
+}
+
+int PowerOfTwoFactor(int downsample) {
+  int factor = 1;
+  while (factor * 2 <= std::clamp(downsample, 1, 8)) factor *= 2;
+  return factor;
+}
+
+}  // namespace
+
+bool CaptureFilter::Initialize(ID3D11Device* device) {
+  device_.copy_from(device);
+
+  auto vs = Compile("vs_main", "vs_4_0");
+  auto down = Compile("ps_down", "ps_4_0");
+  auto blur = Compile("ps_blur", "ps_4_0");
+  if (!vs || !down || !blur) return false;
+
+  if (FAILED(device->CreateVertexShader(vs->GetBufferPointer(),
+                                        vs->GetBufferSize(), nullptr,
+                                        vertex_shader_.put())) ||
+      FAILED(device->CreatePixelShader(down->GetBufferPointer(),
+                                       down->GetBufferSize(), nullptr,
+                                       downsample_shader_.put())) ||
+      FAILED(device->CreatePixelShader(blur->GetBufferPointer(),
+                                       blur->GetBufferSize(), nullptr,
+                                       blur_shader_.put()))) {
+    return false;
+  }
+
+  D3D11_SAMPLER_DESC sampler = {};
+  sampler.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+  sampler.AddressU = D3D11_TEXTURE_ADDRESS_CLAMP;
+  sampler.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
+  sampler.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
+  sampler.MaxLOD = D3D11_FLOAT32_MAX;
+  if (FAILED(device->CreateSamplerState(&sampler, sampler_.put()))) {
+    return false;
+  }
+
+  D3D11_BUFFER_DESC params = {};
+  params.ByteWidth = sizeof(Params);
+  params.Usage = D3D11_USAGE_DEFAULT;
+  params.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+  return SUCCEEDED(device->CreateBuffer(&params, nullptr, params_.put()));
+}
+
+bool CaptureFilter::CreateSurface(UINT width, UINT height, Surface* surface) {
+  if (surface->texture && surface->width == width &&
+      surface->height == height) {
+    return true;
+  }
+  *surface = Surface{};
+  D3D11_TEXTURE2D_DESC desc = {};
+  desc.Width = width;
+  desc.Height = height;
+  desc.MipLevels = 1;
+  desc.ArraySize = 1;
+  desc.Format = DXGI_FORMAT_B8G8R8A8_UNORM;
+  desc.SampleDesc.Count = 1;
+  desc.Usage = D3D11_USAGE_DEFAULT;
+  desc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET;
+  if (FAILED(device_->CreateTexture2D(&desc, nullptr,
+                                      surface->texture.put())) ||
+      FAILED(device_->CreateShaderResourceView(surface->texture.get(), nullptr,
+                                               surface->srv.put())) ||
+      FAILED(device_->CreateRenderTargetView(surface->texture.get(), nullptr,
+                                             surface->rtv.put()))) {
+    *surface = Surface{};
+    return false;
+  }
+  surface->width = width;
+  surface->height = height;
+  return true;
+}
+
+ID3D11Texture2D* CaptureFilter::PrepareInput(Scratch* scratch, UINT width,
+                                             UINT height, int downsample) {
+  int factor = PowerOfTwoFactor(downsample);
+  bool resized = scratch->input.width != width ||
+                 scratch->input.height != height ||
+                 scratch->downsample != factor;
+  if (!CreateSurface(width, height, &scratch->input)) return nullptr;
+  if (resized) {
+    scratch->downsample = factor;
+    scratch->levels.clear();
+    UINT level_width = width;
+    UINT level_height = height;
+    for (int f = factor; f > 1; f /= 2) {
+      level_width = std::max<UINT>(1, (level_width + 1) / 2);
+      level_height = std::max<UINT>(1, (level_height + 1) / 2);
+      scratch->levels.emplace_back();
+      if (!CreateSurface(level_width, level_height,
+                         &scratch->levels.back())) {
+        scratch->levels.clear();
+        scratch->downsample = 0;
+        return nullptr;
+      }
+    }
+  }
+  return scratch->input.texture.get();
+}
+
+void CaptureFilter::Draw(ID3D11DeviceContext* context, const Surface& source,
+                         const Surface& target, ID3D11PixelShader* shader,
+                         float offset) {
+  Params params = {{1.0f / source.width, 1.0f / source.height}, offset, 0};
+  context->UpdateSubresource(params_.get(), 0, nullptr, &params, 0, 0);
+
+  // Unbind the previous pass's source before it becomes a target.
+  ID3D11ShaderResourceView* no_srv = nullptr;
+  context->PSSetShaderResources(0, 1, &no_srv);
+  ID3D11RenderTargetView* rtv = target.rtv.get();
+  context->OMSetRenderTargets(1, &rtv, nullptr);
+  D3D11_VIEWPORT viewport = {0, 0, static_cast<float>(target.width),
+                             static_cast<float>(target.height), 0, 1};
+  context->RSSetViewports(1, &viewport);
+
+  ID3D11ShaderResourceView* srv = source.srv.get();
+  context->PSSetShader(shader, nullptr, 0);
+  context->PSSetShaderResources(0, 1, &srv);
+  context->Draw(3, 0);
+}
+
+const CaptureFilter::Surface& CaptureFilter::Run(ID3D11DeviceContext* context,
+                                                 Scratch* scratch,
+                                                 int blur_passes) {
+  context->IASetInputLayout(nullptr);
+  context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+  context->VSSetShader(vertex_shader_.get(), nullptr, 0);
+  ID3D11Buffer* params = params_.get();
+  context->PSSetConstantBuffers(0, 1, &params);
+  ID3D11SamplerState* sampler = sampler_.get();
+  context->PSSetSamplers(0, 1, &sampler);
+
+  Surface* current = &scratch->input;
+  for (Surface& level : scratch->levels) {
+    Draw(context, *current, level, downsample_shader_.get(), 0);
+    current = &level;
+  }
+
+  int passes = std::clamp(blur_passes, 0, kMaxBlurPasses);
+  if (passes > 0 &&
+      CreateSurface(current->width, current->height, &scratch->ping)) {
+    // Ping-pong between the last level and `ping`.
+    Surface* front = current;
+    Surface* back = &scratch->ping;
+    for (int i = 0; i < passes; ++i) {
+      Draw(context, *front, *back, blur_shader_.get(), kKawaseOffsets[i]);
+      std::swap(front, back);
+    }
+    current = front;
+  }
+
+  ID3D11ShaderResourceView* no_srv = nullptr;
+  context->PSSetShaderResources(0, 1, &no_srv);
+  ID3D11RenderTargetView* no_rtv = nullptr;
+  context->OMSetRenderTargets(1, &no_rtv, nullptr);
+  return *current;
+}
+
+}  // namespace floating_palette
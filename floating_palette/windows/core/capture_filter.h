@@ -0,0 +1,75 @@
+#pragma once
+
+#include <d3d11.h>
+#include <winrt/base.h>
+
+#include <vector>
+
+namespace floating_palette {
+
+/// GPU post-processing for captured backdrops: a dual-Kawase downsample
+/// chain followed by Kawase blur passes, all at the reduced size.
+///
+/// Flutter then samples a pre-blurred texture a 16th the size (at 1/4)
+/// instead of running a BackdropFilter over a full-resolution one. The
+/// upscale back to the palette's size happens for free in Flutter's
+/// bilinear texture sampling.
+///
+/// Not thread-safe; callers serialize use of the device context.
+class CaptureFilter {
+ public:
+  /// A render target with the views the passes need.
+  struct Surface {
+    winrt::com_ptr<ID3D11Texture2D> texture;
+    winrt::com_ptr<ID3D11ShaderResourceView> srv;
+    winrt::com_ptr<ID3D11RenderTargetView> rtv;
+    UINT width = 0;
+    UINT height = 0;
+  };
+
+  /// Per-capture intermediate surfaces, rebuilt when the input size or the
+  /// downsample factor changes.
+  struct Scratch {
+    Surface input;
+    std::vector<Surface> levels;
+    /// Ping-pong partner for the blur passes at the final size.
+    Surface ping;
+    int downsample = 0;
+  };
+
+  /// Compiles the shaders. False if the device or the runtime compiler
+  /// (d3dcompiler_47) is unavailable; callers fall back to unfiltered
+  /// output.
+  bool Initialize(ID3D11Device* device);
+
+  /// Size `scratch` for a `width` x `height` input reduced by `downsample`
+  /// (rounded down to a power of two, 1-8) and return the texture to copy
+  /// the captured region into.
+  ID3D11Texture2D* PrepareInput(Scratch* scratch, UINT width, UINT height,
+                                int downsample);
+
+  /// Run the downsample chain and `blur_passes` Kawase passes over the
+  /// prepared input. Returns the surface holding the result.
+  const Surface& Run(ID3D11DeviceContext* context, Scratch* scratch,
+                     int blur_passes);
+
+ private:
+  struct Params {
+    float texel[2];
+    float offset;
+    float padding;
+  };
+
+  bool CreateSurface(UINT width, UINT height, Surface* surface);
+  void Draw(ID3D11DeviceContext* context, const Surface& source,
+            const Surface& target, ID3D11PixelShader* shader, float offset);
+
+  winrt::com_ptr<ID3D11Device> device_;
+  winrt::com_ptr<ID3D11VertexShader> vertex_shader_;
+  winrt::com_ptr<ID3D11PixelShader> downsample_shader_;
+  winrt::com_ptr<ID3D11PixelShader> blur_shader_;
+  winrt::com_ptr<ID3D11SamplerState> sampler_;
+  winrt::com_ptr<ID3D11Buffer> params_;
+};
+
+}  // namespace floating_palette
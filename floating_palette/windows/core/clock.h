@@ -0,0 +1,21 @@
+#pragma once
+
+#include <windows.h>
+
+namespace floating_palette {
+
+/// Monotonic high-resolution time in seconds (QueryPerformanceCounter).
+/// Same clock as FloatingPalette_GetCurrentTime, so timestamps written by
+/// Dart into shared buffers compare directly against native ticks.
+inline double MonotonicSeconds() {
+  static const double frequency = [] {
+    LARGE_INTEGER freq;
+    QueryPerformanceFrequency(&freq);
+    return static_cast<double>(freq.QuadPart);
+  }();
+  LARGE_INTEGER counter;
+  QueryPerformanceCounter(&counter);
+  return static_cast<double>(counter.QuadPart) / frequency;
+}
+
+}  // namespace floating_palette
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace floating_palette {
+
+/// 64-bit FNV-1a hash of a service or command name.
+///
+/// constexpr so names can be used as `case` labels: dispatch is a switch
+/// on a compile-time hash (integer compares, as the labels are sparse)
+/// plus one string compare, instead of a chain of string compares. Two
+/// known names colliding within a switch is a compile error (duplicate
+/// case).
+///
+/// Names switched on come from Dart, so an arbitrary string can land on a
+/// known case. Each case compares the name it stands for before acting:
+///
+///   case HashCommand("show"):
+///     if (command != "show") break;  // Falls out to the unknown path.
+///
+/// Service Handle() methods return whether the command was one of theirs.
+constexpr uint64_t HashCommand(std::string_view name) {
+  uint64_t hash = 14695981039346656037ull;
+  for (char c : name) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+/// Hash of a (service, event) pair, for switching on outgoing events.
+constexpr uint64_t EventKind(std::string_view service,
+                             std::string_view event) {
+  return HashCommand(service) ^ (HashCommand(event) * 31);
+}
+
+}  // namespace floating_palette
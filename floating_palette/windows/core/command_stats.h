@@ -0,0 +1,59 @@
+#pragma once
+
+#include <flutter/encodable_value.h>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include "command_hash.h"
+
+namespace floating_palette {
+
+/// Per-command call counters for the `floating_palette` channel.
+///
+/// Keyed by the combined service/command hash, so recording a known
+/// command is one hash lookup and an increment; names are stored once, on
+/// first sight. Only commands a service recognized are recorded, so the
+/// table is bounded by the command set. Platform thread only.
+class CommandStats {
+ public:
+  /// Count a routed command.
+  void Record(const std::string& service, const std::string& command) {
+    uint64_t key = HashCommand(service) ^ (HashCommand(command) * 31);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+      it = entries_.emplace(key, Entry{service, command, 0}).first;
+    }
+    ++it->second.count;
+  }
+
+  /// List of {service, command, count} maps.
+  flutter::EncodableList Snapshot() const {
+    flutter::EncodableList list;
+    list.reserve(entries_.size());
+    for (const auto& [key, entry] : entries_) {
+      list.push_back(flutter::EncodableValue(flutter::EncodableMap{
+          {flutter::EncodableValue("service"),
+           flutter::EncodableValue(entry.service)},
+          {flutter::EncodableValue("command"),
+           flutter::EncodableValue(entry.command)},
+          {flutter::EncodableValue("count"),
+           flutter::EncodableValue(static_cast<int64_t>(entry.count))},
+      }));
+    }
+    return list;
+  }
+
+  void Reset() { entries_.clear(); }
+
+ private:
+  struct Entry {
+    std::string service;
+    std::string command;
+    uint64_t count;
+  };
+  std::unordered_map<uint64_t, Entry> entries_;
+};
+
+}  // namespace floating_palette
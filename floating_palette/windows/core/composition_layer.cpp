@@ -0,0 +1,336 @@
+#include "composition_layer.h"
+
+#include <dcomp.h>
+#include <dwmapi.h>
+#include <winrt/base.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include "clock.h"
+#include "logger.h"
+#include "reveal_pipeline.h"
+#include "window_store.h"
+
+namespace floating_palette {
+
+namespace {
+
+constexpr wchar_t kProxyClassName[] = L"FloatingPaletteTransform";
+
+// One device for every palette; created on first use.
+IDCompositionDesktopDevice* Device() {
+  static winrt::com_ptr<IDCompositionDesktopDevice> device = [] {
+    winrt::com_ptr<IDCompositionDesktopDevice> created;
+    HRESULT hr = DCompositionCreateDevice2(
+        nullptr, __uuidof(IDCompositionDesktopDevice), created.put_void());
+    if (FAILED(hr)) {
+      FP_LOG("Transform", "DCompositionCreateDevice2 failed: ",
+             static_cast<uint32_t>(hr));
+      created = nullptr;
+    }
+    return created;
+  }();
+  return device.get();
+}
+
+void RegisterProxyClassOnce(WNDPROC proc) {
+  static bool registered = false;
+  if (registered) return;
+  WNDCLASSEXW wc = {};
+  wc.cbSize = sizeof(wc);
+  wc.lpfnWndProc = proc;
+  wc.hInstance = GetModuleHandle(nullptr);
+  wc.lpszClassName = kProxyClassName;
+  RegisterClassExW(&wc);
+  registered = true;
+}
+
+void SetDwmCloak(HWND hwnd, bool cloaked) {
+  BOOL value = cloaked ? TRUE : FALSE;
+  DwmSetWindowAttribute(hwnd, DWMWA_CLOAK, &value, sizeof(value));
+}
+
+/// `from` to `to` over `seconds` along `curve`. Every curve is a
+/// polynomial in time, so it maps exactly onto cubic segments and DWM
+/// evaluates it without any callback.
+winrt::com_ptr<IDCompositionAnimation> MakeAnimation(double from, double to,
+                                                     double seconds,
+                                                     AnimationCurve curve) {
+  winrt::com_ptr<IDCompositionAnimation> animation;
+  if (FAILED(Device()->CreateAnimation(animation.put()))) return nullptr;
+  const double d = seconds;
+  const double delta = to - from;
+  auto add = [&](double begin, double c0, double c1, double c2, double c3) {
+    animation->AddCubic(begin, static_cast<float>(c0), static_cast<float>(c1),
+                        static_cast<float>(c2), static_cast<float>(c3));
+  };
+  switch (curve) {
+    case AnimationCurve::kLinear:
+      add(0, from, delta / d, 0, 0);
+      break;
+    case AnimationCurve::kEaseIn:  // u^2
+      add(0, from, 0, delta / (d * d), 0);
+      break;
+    case AnimationCurve::kEaseOut:  // 2u - u^2
+      add(0, from, 2 * delta / d, -delta / (d * d), 0);
+      break;
+    case AnimationCurve::kEaseOutCubic:  // 3u - 3u^2 + u^3
+      add(0, from, 3 * delta / d, -3 * delta / (d * d),
+          delta / (d * d * d));
+      break;
+    case AnimationCurve::kEaseInOut:  // 2u^2, then 1/2 + 2s - 2s^2
+      add(0, from, 0, 2 * delta / (d * d), 0);
+      add(d / 2, from + delta / 2, 2 * delta / d, -2 * delta / (d * d), 0);
+      break;
+  }
+  animation->End(d, static_cast<float>(to));
+  return animation;
+}
+
+}  // namespace
+
+struct CompositionLayer::State {
+  HWND proxy = nullptr;
+  winrt::com_ptr<IDCompositionTarget> target;
+  winrt::com_ptr<IDCompositionVisual2> visual;
+  winrt::com_ptr<IUnknown> surface;
+  winrt::com_ptr<IDCompositionScaleTransform> scale;
+  winrt::com_ptr<IDCompositionRotateTransform> rotate;
+  winrt::com_ptr<IDCompositionTransform> group;
+  winrt::com_ptr<IDCompositionEffectGroup> effect;
+};
+
+CompositionLayer::CompositionLayer() = default;
+
+CompositionLayer::~CompositionLayer() { Destroy(nullptr); }
+
+// static
+bool CompositionLayer::IsSupported() { return Device() != nullptr; }
+
+bool CompositionLayer::SetTransform(PaletteWindow& window,
+                                    const Transform& transform,
+                                    int duration_ms, AnimationCurve curve) {
+  const Values from = Current();
+  target_ = transform;
+  if (!state_ && transform.IsIdentity()) return true;
+  if (!state_ && !Create(window)) return false;
+
+  from_ = from;
+  to_ = ValuesOf(transform);
+  start_ = MonotonicSeconds();
+  duration_ = duration_ms > 0 ? duration_ms / 1000.0 : 0.0;
+  curve_ = curve;
+
+  State& state = *state_;
+  bool animated = false;
+  if (duration_ > 0) {
+    auto scale_x = MakeAnimation(from_.scale_x, to_.scale_x, duration_, curve);
+    auto scale_y = MakeAnimation(from_.scale_y, to_.scale_y, duration_, curve);
+    auto angle = MakeAnimation(from_.degrees, to_.degrees, duration_, curve);
+    auto opacity =
+        MakeAnimation(from_.opacity, to_.opacity, duration_, curve);
+    if (scale_x && scale_y && angle && opacity) {
+      state.scale->SetScaleX(scale_x.get());
+      state.scale->SetScaleY(scale_y.get());
+      state.rotate->SetAngle(angle.get());
+      state.effect->SetOpacity(opacity.get());
+      animated = true;
+    }
+  }
+  if (!animated) {
+    duration_ = 0.0;
+    state.scale->SetScaleX(static_cast<float>(to_.scale_x));
+    state.scale->SetScaleY(static_cast<float>(to_.scale_y));
+    state.rotate->SetAngle(static_cast<float>(to_.degrees));
+    state.effect->SetOpacity(static_cast<float>(to_.opacity));
+  }
+  FP_LOG("Transform", "transform ", window.id, " scale=", transform.scale,
+         " degrees=", transform.degrees, " opacity=", transform.opacity,
+         " ms=", animated ? duration_ms : 0);
+
+  KillTimer(state.proxy, kSettleTimer);
+  if (transform.IsIdentity() && !animated) {
+    Settle(window);
+    return true;
+  }
+  Sync(window);  // Commits.
+  if (transform.IsIdentity()) {
+    SetTimer(state.proxy, kSettleTimer, duration_ms + kSettleMarginMs,
+             nullptr);
+  }
+  return true;
+}
+
+bool CompositionLayer::SetOpacity(PaletteWindow& window, double opacity,
+                                  int duration_ms, AnimationCurve curve) {
+  Transform transform = target_;
+  transform.opacity = std::clamp(opacity, 0.0, 1.0);
+  return SetTransform(window, transform, duration_ms, curve);
+}
+
+void CompositionLayer::Sync(PaletteWindow& window) {
+  if (!state_ || !window.hwnd) return;
+  State& state = *state_;
+  FrameSnapshot frame;
+  if (!RevealPipeline::IsShown(window) || !window.frame.Load(&frame)) {
+    ShowWindow(state.proxy, SW_HIDE);
+    return;
+  }
+
+  const RECT& panel = frame.physical;
+  const double width = panel.right - panel.left;
+  const double height = panel.bottom - panel.top;
+  const float center_x =
+      static_cast<float>((target_.anchor_x + 1.0) / 2.0 * width);
+  const float center_y =
+      static_cast<float>((target_.anchor_y + 1.0) / 2.0 * height);
+  state.scale->SetCenterX(center_x);
+  state.scale->SetCenterY(center_y);
+  state.rotate->SetCenterX(center_x);
+  state.rotate->SetCenterY(center_y);
+
+  // The proxy covers every point the content reaches between the two
+  // states: the panel itself when shrinking (entrance / exit), more when
+  // growing or rotating.
+  RECT bounds = panel;
+  const double reach =
+      std::max({std::abs(from_.scale_x), std::abs(to_.scale_x),
+                std::abs(from_.scale_y), std::abs(to_.scale_y)});
+  const bool rotating = from_.degrees != 0.0 || to_.degrees != 0.0;
+  if (reach > 1.0 || rotating) {
+    double extent_x = std::max<double>(center_x, width - center_x) * reach;
+    double extent_y = std::max<double>(center_y, height - center_y) * reach;
+    if (rotating) extent_x = extent_y = std::hypot(extent_x, extent_y);
+    const double origin_x = panel.left + center_x;
+    const double origin_y = panel.top + center_y;
+    bounds.left = std::min<LONG>(
+        bounds.left, static_cast<LONG>(std::floor(origin_x - extent_x)));
+    bounds.top = std::min<LONG>(
+        bounds.top, static_cast<LONG>(std::floor(origin_y - extent_y)));
+    bounds.right = std::max<LONG>(
+        bounds.right, static_cast<LONG>(std::ceil(origin_x + extent_x)));
+    bounds.bottom = std::max<LONG>(
+        bounds.bottom, static_cast<LONG>(std::ceil(origin_y + extent_y)));
+  }
+  state.visual->SetOffsetX(static_cast<float>(panel.left - bounds.left));
+  state.visual->SetOffsetY(static_cast<float>(panel.top - bounds.top));
+
+  // Directly above the panel.
+  HWND above = GetWindow(window.hwnd, GW_HWNDPREV);
+  UINT flags = SWP_NOACTIVATE | SWP_SHOWWINDOW | SWP_NOOWNERZORDER;
+  if (above == state.proxy) flags |= SWP_NOZORDER;
+  SetWindowPos(state.proxy, above ? above : HWND_TOPMOST, bounds.left,
+               bounds.top, bounds.right - bounds.left,
+               bounds.bottom - bounds.top, flags);
+  SetDwmCloak(window.hwnd, true);
+  Device()->Commit();
+}
+
+bool CompositionLayer::Create(PaletteWindow& window) {
+  IDCompositionDesktopDevice* device = Device();
+  if (!device || !window.hwnd) return false;
+  RegisterProxyClassOnce(ProxyWndProc);
+
+  auto state = std::make_unique<State>();
+  state->proxy = CreateWindowExW(
+      WS_EX_NOREDIRECTIONBITMAP | WS_EX_TOOLWINDOW | WS_EX_NOACTIVATE |
+          WS_EX_TOPMOST,
+      kProxyClassName, L"", WS_POPUP, 0, 0, 0, 0, nullptr, nullptr,
+      GetModuleHandle(nullptr), nullptr);
+  if (!state->proxy) return false;
+
+  HRESULT hr = device->CreateTargetForHwnd(state->proxy, TRUE,
+                                           state->target.put());
+  if (SUCCEEDED(hr)) hr = device->CreateVisual(state->visual.put());
+  if (SUCCEEDED(hr)) {
+    hr = device->CreateSurfaceFromHwnd(window.hwnd, state->surface.put());
+  }
+  if (SUCCEEDED(hr)) hr = device->CreateScaleTransform(state->scale.put());
+  if (SUCCEEDED(hr)) hr = device->CreateRotateTransform(state->rotate.put());
+  if (SUCCEEDED(hr)) {
+    IDCompositionTransform* parts[] = {state->scale.get(),
+                                       state->rotate.get()};
+    hr = device->CreateTransformGroup(parts, 2, state->group.put());
+  }
+  if (SUCCEEDED(hr)) hr = device->CreateEffectGroup(state->effect.put());
+  if (FAILED(hr)) {
+    FP_LOG("Transform", "composition setup failed: ",
+           static_cast<uint32_t>(hr));
+    DestroyWindow(state->proxy);
+    return false;
+  }
+  state->visual->SetContent(state->surface.get());
+  state->visual->SetTransform(state->group.get());
+  state->visual->SetEffect(state->effect.get());
+  state->target->SetRoot(state->visual.get());
+  SetWindowLongPtr(state->proxy, GWLP_USERDATA,
+                   reinterpret_cast<LONG_PTR>(&window));
+  state_ = std::move(state);
+  return true;
+}
+
+void CompositionLayer::Settle(PaletteWindow& window) {
+  if (!state_ || !target_.IsIdentity()) return;
+  Destroy(&window);
+}
+
+void CompositionLayer::Destroy(PaletteWindow* window) {
+  if (!state_) return;
+  std::unique_ptr<State> state = std::move(state_);
+  // The panel shows itself again unless it is hidden by cloaking.
+  if (window && window->hwnd &&
+      !window->cloaked.load(std::memory_order_relaxed)) {
+    SetDwmCloak(window->hwnd, false);
+  }
+  SetWindowLongPtr(state->proxy, GWLP_USERDATA, 0);
+  DestroyWindow(state->proxy);
+  from_ = to_ = Values{};
+  duration_ = 0.0;
+}
+
+CompositionLayer::Values CompositionLayer::Current() const {
+  if (!state_) return ValuesOf(target_);
+  if (duration_ <= 0.0) return to_;
+  const double t = (MonotonicSeconds() - start_) / duration_;
+  if (t >= 1.0) return to_;
+  const double k = ApplyAnimationCurve(curve_, t);
+  return Values{from_.scale_x + (to_.scale_x - from_.scale_x) * k,
+                from_.scale_y + (to_.scale_y - from_.scale_y) * k,
+                from_.degrees + (to_.degrees - from_.degrees) * k,
+                from_.opacity + (to_.opacity - from_.opacity) * k};
+}
+
+// static
+CompositionLayer::Values CompositionLayer::ValuesOf(
+    const Transform& transform) {
+  return Values{transform.flip_horizontal ? -transform.scale : transform.scale,
+                transform.flip_vertical ? -transform.scale : transform.scale,
+                transform.degrees, transform.opacity};
+}
+
+// static
+LRESULT CALLBACK CompositionLayer::ProxyWndProc(HWND hwnd, UINT message,
+                                                WPARAM wparam, LPARAM lparam) {
+  switch (message) {
+    case WM_NCHITTEST:
+      // Input goes to the untransformed panel beneath.
+      return HTTRANSPARENT;
+    case WM_MOUSEACTIVATE:
+      return MA_NOACTIVATE;
+    case WM_TIMER:
+      if (wparam == kSettleTimer) {
+        KillTimer(hwnd, kSettleTimer);
+        auto* window = reinterpret_cast<PaletteWindow*>(
+            GetWindowLongPtr(hwnd, GWLP_USERDATA));
+        if (window) window->composition.Settle(*window);
+        return 0;
+      }
+      break;
+    case WM_CLOSE:
+      return 0;
+  }
+  return DefWindowProc(hwnd, message, wparam, lparam);
+}
+
+}  // namespace floating_palette
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <windows.h>
+
+#include <memory>
+
+#include "animation_curve.h"
+
+namespace floating_palette {
+
+struct PaletteWindow;
+
+/// Compositor-side presentation of a palette: scale, rotation, flip and
+/// opacity applied by DirectComposition instead of by the palette's engine.
+///
+/// While a transform is set, a click-through proxy window sits directly
+/// above the panel and hosts one DirectComposition visual whose content is
+/// the panel's own surface (CreateSurfaceFromHwnd), transformed around the
+/// anchor. The panel stays exactly where and as large as it was, cloaked
+/// so only the proxy's copy shows. The Flutter viewport never changes
+/// size, so there is no relayout and no new frame; an animated transform
+/// or fade is a DirectComposition animation run by DWM, costing no Flutter
+/// frame and no per-frame work here. Opacity in particular never goes
+/// through a layered window, whose alpha makes DWM redraw the panel's
+/// redirection surface. Back at identity the proxy is dropped and
+/// the panel uncloaked.
+///
+/// Pointer input still hit-tests the untransformed panel (the proxy
+/// answers HTTRANSPARENT), which is what entrance and exit animations
+/// want.
+///
+/// Platform thread only.
+class CompositionLayer {
+ public:
+  struct Transform {
+    double scale = 1.0;
+    double degrees = 0.0;
+    bool flip_horizontal = false;
+    bool flip_vertical = false;
+    /// Alignment of the transform origin: -1 (left / top) to 1.
+    double anchor_x = 0.0;
+    double anchor_y = 0.0;
+    /// 0 (invisible) to 1.
+    double opacity = 1.0;
+
+    bool IsIdentity() const {
+      return scale == 1.0 && degrees == 0.0 && !flip_horizontal &&
+             !flip_vertical && opacity == 1.0;
+    }
+  };
+
+  CompositionLayer();
+  ~CompositionLayer();
+
+  CompositionLayer(const CompositionLayer&) = delete;
+  CompositionLayer& operator=(const CompositionLayer&) = delete;
+
+  /// DirectComposition is available.
+  static bool IsSupported();
+
+  /// Move to `transform`, animated over `duration_ms` (0: at once) from
+  /// wherever the previous one currently is. False if the compositor is
+  /// unavailable.
+  bool SetTransform(PaletteWindow& window, const Transform& transform,
+                    int duration_ms, AnimationCurve curve);
+
+  /// Keep the current transform, fade to `opacity`.
+  bool SetOpacity(PaletteWindow& window, double opacity, int duration_ms,
+                  AnimationCurve curve);
+
+  /// The last transform set (the end state of a running animation).
+  const Transform& transform() const { return target_; }
+
+  /// A proxy is presenting the panel, which is therefore cloaked.
+  bool active() const { return state_ != nullptr; }
+
+  /// Follow the panel's position, size, z-order and visibility.
+  void Sync(PaletteWindow& window);
+
+ private:
+  /// Effective per-axis scale (negative when flipped), angle and opacity.
+  struct Values {
+    double scale_x = 1.0;
+    double scale_y = 1.0;
+    double degrees = 0.0;
+    double opacity = 1.0;
+  };
+  struct State;
+
+  static constexpr UINT_PTR kSettleTimer = 1;
+  /// Slack after an animation's end before the proxy is dropped.
+  static constexpr UINT kSettleMarginMs = 32;
+
+  bool Create(PaletteWindow& window);
+  /// The animation ended: drop the proxy if back at identity.
+  void Settle(PaletteWindow& window);
+  void Destroy(PaletteWindow* window);
+  /// Where the (possibly animating) transform is now.
+  Values Current() const;
+
+  static Values ValuesOf(const Transform& transform);
+  static LRESULT CALLBACK ProxyWndProc(HWND hwnd, UINT message, WPARAM wparam,
+                                       LPARAM lparam);
+
+  std::unique_ptr<State> state_;
+  Transform target_;
+  Values from_;
+  Values to_;
+  double start_ = 0.0;
+  double duration_ = 0.0;
+  AnimationCurve curve_ = AnimationCurve::kLinear;
+};
+
+}  // namespace floating_palette
@@ -0,0 +1,785 @@
+#include "desktop_capture.h"
+
+#include <d3d11.h>
+#include <dxgi1_2.h>
+#include <flutter_windows.h>
+#include <windows.graphics.capture.interop.h>
+#include <windows.graphics.directx.direct3d11.interop.h>
+#include <winrt/Windows.Foundation.h>
+#include <winrt/Windows.Foundation.Collections.h>
+#include <winrt/Windows.Graphics.Capture.h>
+#include <winrt/Windows.Graphics.DirectX.Direct3D11.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "capture_filter.h"
+#include "clock.h"
+#include "logger.h"
+#include "metrics.h"
+#include "palette_panel.h"
+#include "trace.h"
+#include "window_store.h"
+
+namespace floating_palette {
+
+namespace {
+
+namespace wgc = winrt::Windows::Graphics::Capture;
+namespace wgdx = winrt::Windows::Graphics::DirectX;
+
+constexpr wgdx::DirectXPixelFormat kCaptureFormat =
+    wgdx::DirectXPixelFormat::B8G8R8A8UIntNormalized;
+// Surfaces in the frame pool; two lets the next frame land while one is
+// being copied.
+constexpr int32_t kPoolBuffers = 2;
+// A palette counts as moving for this long after its last position change,
+// so programmatic moves (animations, snapping) get the drag rate too.
+constexpr double kMotionHoldSeconds = 0.25;
+// Output textures per palette: one Flutter shows, one published and
+// waiting, one being written.
+constexpr int kRingSize = 3;
+// A published frame sampled later than this (about two 60 Hz frames)
+// counts as late.
+constexpr double kLateFrameSeconds = 0.034;
+
+double IntervalForRate(int rate) { return 1.0 / std::clamp(rate, 1, 60); }
+
+// Size reduction a config asks for (CaptureFilter rounds it to a power of
+// two); 1 is full resolution.
+int DownsampleFor(const DesktopCaptureConfig& config) {
+  if (config.output == CaptureOutput::kBlurred) return config.downsample;
+  if (config.pixel_ratio <= 0 || config.pixel_ratio >= 1) return 1;
+  return static_cast<int>(1.0 / config.pixel_ratio);
+}
+
+bool IntersectsAny(const std::vector<RECT>& regions, const RECT& rect) {
+  for (const RECT& region : regions) {
+    if (region.left < rect.right && rect.left < region.right &&
+        region.top < rect.bottom && rect.top < region.bottom) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// The adapter the palette's Flutter engine renders with (owned reference),
+// or null for a window that isn't a palette.
+winrt::com_ptr<IDXGIAdapter> FlutterAdapterFor(HWND hwnd) {
+  winrt::com_ptr<IDXGIAdapter> adapter;
+  PaletteWindow* window = PalettePanel::FromHwnd(hwnd);
+  if (window && window->view_controller) {
+    adapter.attach(FlutterDesktopViewGetGraphicsAdapter(
+        FlutterDesktopViewControllerGetView(window->view_controller)));
+  }
+  return adapter;
+}
+
+class CaptureClient;
+
+/// One output texture in a palette's ring.
+struct TextureSlot {
+  winrt::com_ptr<ID3D11Texture2D> texture;
+  HANDLE shared_handle = nullptr;
+  UINT width = 0;
+  UINT height = 0;
+  /// MonotonicSeconds() when published (ring_mutex).
+  double published = 0;
+};
+
+/// One Windows.Graphics.Capture session per monitor, shared by every
+/// palette on it. Fields are guarded by the hub mutex except where noted.
+struct MonitorSession {
+  HMONITOR monitor = nullptr;
+  /// Top-left of the monitor in virtual-screen pixels.
+  POINT origin{0, 0};
+  wgc::GraphicsCaptureItem item{nullptr};
+  wgc::Direct3D11CaptureFramePool pool{nullptr};
+  wgc::GraphicsCaptureSession session{nullptr};
+  wgc::Direct3D11CaptureFramePool::FrameArrived_revoker frame_arrived;
+  winrt::Windows::Graphics::SizeInt32 pool_size{0, 0};
+  /// Set when the last palette leaves; the session is closed outside the
+  /// lock and any in-flight frame is ignored.
+  bool closed = false;
+  /// Frames carry dirty regions (GraphicsCaptureDirtyRegionMode).
+  bool dirty_regions = false;
+  /// Session accepts MinUpdateInterval; last value set.
+  bool pacing = true;
+  double min_update_interval = 0;
+  std::vector<CaptureClient*> clients;
+
+  /// Not under the hub mutex: closing may wait for an in-flight
+  /// FrameArrived, which takes it.
+  void Close() {
+    frame_arrived.revoke();
+    try {
+      if (session) session.Close();
+      if (pool) pool.Close();
+    } catch (const winrt::hresult_error&) {
+    }
+  }
+};
+
+/// One palette's view of a monitor capture. Everything except the
+/// construction-time config and the ring indices is guarded by the hub
+/// mutex.
+class CaptureClient : public DesktopCapture {
+ public:
+  CaptureClient(HWND hwnd, const DesktopCaptureConfig& config,
+                FrameCallback on_frame)
+      : hwnd(hwnd),
+        config(config),
+        on_frame(std::move(on_frame)),
+        still_interval(IntervalForRate(config.frame_rate)),
+        moving_interval(IntervalForRate(config.drag_frame_rate)) {}
+
+  ~CaptureClient() override { Stop(); }
+
+  void Stop() override;
+  const FlutterDesktopGpuSurfaceDescriptor* ObtainDescriptor(
+      size_t width, size_t height) override;
+  const DesktopCaptureStats& Stats() const override { return stats; }
+
+  const HWND hwnd;
+  const DesktopCaptureConfig config;
+  const FrameCallback on_frame;
+  const double still_interval;
+  const double moving_interval;
+
+  MonitorSession* session = nullptr;
+  /// Region to capture in virtual-screen pixels (window rect + padding).
+  RECT screen_roi{0, 0, 0, 0};
+  /// Monitor-relative rect of the last copy.
+  RECT copied_roi{0, 0, 0, 0};
+  double last_move = 0;
+  double last_copy = 0;
+  bool interactive = false;
+  bool excluded = false;
+
+  /// Something has been copied since the capture started.
+  bool has_output = false;
+
+  /// Downsample / blur intermediates (filtered output only).
+  CaptureFilter::Scratch scratch;
+
+  /// Output ring. A slot's texture is only (re)created or written by the
+  /// capture thread while it is neither `ready` nor `displayed`.
+  std::array<TextureSlot, kRingSize> slots;
+  /// Guards the indices below and `published`. Held only to swap indices,
+  /// never across GPU work.
+  std::mutex ring_mutex;
+  /// Newest published frame Flutter hasn't taken yet, or -1.
+  int ready = -1;
+  /// Frame Flutter last took and may still be showing, or -1.
+  int displayed = -1;
+  /// MarkTextureFrameAvailable issued and not yet answered by
+  /// ObtainDescriptor.
+  bool mark_pending = false;
+  /// Raster thread only.
+  FlutterDesktopGpuSurfaceDescriptor descriptor{};
+
+  DesktopCaptureStats stats;
+};
+
+/// Owns the D3D device, the per-monitor sessions and the palette clients.
+class CaptureHub {
+ public:
+  static CaptureHub& Instance() {
+    // Never destroyed: frame callbacks on capture threads may still hold
+    // `this` during DLL unload.
+    static CaptureHub* hub = new CaptureHub();
+    return *hub;
+  }
+
+  std::shared_ptr<DesktopCapture> Start(HWND hwnd,
+                                        const DesktopCaptureConfig& config,
+                                        DesktopCapture::FrameCallback on_frame,
+                                        std::string* error);
+  void Remove(CaptureClient* client);
+  void WindowMoved(HWND hwnd);
+  void SetInteractive(HWND hwnd, bool interactive);
+
+ private:
+  CaptureHub() = default;
+
+  bool EnsureDeviceLocked(HWND hwnd, std::string* error);
+  void AttachLocked(CaptureClient* client, HMONITOR monitor);
+  std::shared_ptr<MonitorSession> DetachLocked(CaptureClient* client);
+  void UpdateRoiLocked(CaptureClient* client);
+  void UpdatePacingLocked(MonitorSession& session, double now);
+  bool EnsureSlotLocked(TextureSlot& slot, UINT width, UINT height);
+  CaptureFilter* FilterLocked();
+  bool CopyLocked(CaptureClient* client, TextureSlot& slot,
+                  ID3D11Texture2D* source, const D3D11_BOX& box);
+  void OnFrameArrived(MonitorSession& session,
+                      const wgc::Direct3D11CaptureFramePool& pool);
+
+  std::mutex mutex_;
+  winrt::com_ptr<ID3D11Device> device_;
+  winrt::com_ptr<ID3D11DeviceContext> context_;
+  wgdx::Direct3D11::IDirect3DDevice winrt_device_{nullptr};
+  /// Shaders for filtered output, built on first use per device.
+  std::unique_ptr<CaptureFilter> filter_;
+  bool filter_failed_ = false;
+  std::map<HMONITOR, std::shared_ptr<MonitorSession>> monitors_;
+  std::map<HWND, CaptureClient*> clients_;
+  /// clients_.size(), readable without the lock (WindowMoved fast path).
+  std::atomic<size_t> client_count_{0};
+};
+
+void CaptureClient::Stop() { CaptureHub::Instance().Remove(this); }
+
+// Index of a slot the capture thread may write: neither waiting for Flutter
+// nor being shown. One always exists with three slots.
+int FreeSlot(CaptureClient* client) {
+  std::lock_guard<std::mutex> lock(client->ring_mutex);
+  for (int i = 0; i < kRingSize; ++i) {
+    if (i != client->ready && i != client->displayed) return i;
+  }
+  return -1;
+}
+
+// Make `index` the frame Flutter takes next, replacing one it never took.
+// True if Flutter should be told; false while an earlier notification is
+// still waiting for its frame (that frame will pick this one up).
+bool PublishSlot(CaptureClient* client, int index, double now) {
+  std::lock_guard<std::mutex> lock(client->ring_mutex);
+  if (client->ready >= 0) {
+    client->stats.frames_dropped.fetch_add(1, std::memory_order_relaxed);
+  }
+  client->ready = index;
+  client->slots[index].published = now;
+  if (client->mark_pending) return false;
+  client->mark_pending = true;
+  return true;
+}
+
+// Raster thread. Only takes the ring lock, so it never waits on a frame
+// being copied.
+const FlutterDesktopGpuSurfaceDescriptor* CaptureClient::ObtainDescriptor(
+    size_t width, size_t height) {
+  std::lock_guard<std::mutex> lock(ring_mutex);
+  mark_pending = false;
+  if (ready >= 0) {
+    double age = MonotonicSeconds() - slots[ready].published;
+    stats.frames_presented.fetch_add(1, std::memory_order_relaxed);
+    if (age > kLateFrameSeconds) {
+      stats.frames_late.fetch_add(1, std::memory_order_relaxed);
+    }
+    displayed = ready;
+    ready = -1;
+  }
+  if (displayed < 0) return nullptr;
+  const TextureSlot& slot = slots[displayed];
+  descriptor.struct_size = sizeof(descriptor);
+  descriptor.handle = slot.shared_handle;
+  descriptor.width = slot.width;
+  descriptor.height = slot.height;
+  descriptor.visible_width = slot.width;
+  descriptor.visible_height = slot.height;
+  descriptor.format = kFlutterDesktopPixelFormatBGRA8888;
+  descriptor.release_callback = nullptr;
+  descriptor.release_context = nullptr;
+  return &descriptor;
+}
+
+// Caller holds mutex_.
+bool CaptureHub::EnsureDeviceLocked(HWND hwnd, std::string* error) {
+  if (device_) return true;
+  // On the adapter Flutter renders with: the shared output textures then
+  // never cross adapters (hybrid-GPU laptops), and the driver keeps one
+  // adapter's state for the process.
+  winrt::com_ptr<IDXGIAdapter> adapter = FlutterAdapterFor(hwnd);
+  HRESULT hr = D3D11CreateDevice(
+      adapter.get(),
+      adapter ? D3D_DRIVER_TYPE_UNKNOWN : D3D_DRIVER_TYPE_HARDWARE, nullptr,
+      D3D11_CREATE_DEVICE_BGRA_SUPPORT, nullptr, 0, D3D11_SDK_VERSION,
+      device_.put(), nullptr, context_.put());
+  if (FAILED(hr)) {
+    *error = "D3D11CreateDevice failed";
+    device_ = nullptr;
+    context_ = nullptr;
+    return false;
+  }
+  try {
+    auto dxgi_device = device_.as<IDXGIDevice>();
+    winrt::com_ptr<::IInspectable> inspectable;
+    winrt::check_hresult(CreateDirect3D11DeviceFromDXGIDevice(
+        dxgi_device.get(), inspectable.put()));
+    winrt_device_ = inspectable.as<wgdx::Direct3D11::IDirect3DDevice>();
+  } catch (const winrt::hresult_error& e) {
+    *error = winrt::to_string(e.message());
+    device_ = nullptr;
+    context_ = nullptr;
+    return false;
+  }
+  return true;
+}
+
+// Caller holds mutex_. Throws winrt::hresult_error if the monitor can't be
+// captured.
+void CaptureHub::AttachLocked(CaptureClient* client, HMONITOR monitor) {
+  std::shared_ptr<MonitorSession>& slot = monitors_[monitor];
+  if (!slot) {
+    auto session = std::make_shared<MonitorSession>();
+    session->monitor = monitor;
+    MONITORINFO info = {};
+    info.cbSize = sizeof(info);
+    GetMonitorInfo(monitor, &info);
+    session->origin = {info.rcMonitor.left, info.rcMonitor.top};
+
+    try {
+      auto interop = winrt::get_activation_factory<wgc::GraphicsCaptureItem,
+                                                   IGraphicsCaptureItemInterop>();
+      winrt::check_hresult(interop->CreateForMonitor(
+          monitor, winrt::guid_of<wgc::GraphicsCaptureItem>(),
+          winrt::put_abi(session->item)));
+
+      session->pool_size = session->item.Size();
+      session->pool = wgc::Direct3D11CaptureFramePool::CreateFreeThreaded(
+          winrt_device_, kCaptureFormat, kPoolBuffers, session->pool_size);
+      std::weak_ptr<MonitorSession> weak = session;
+      session->frame_arrived = session->pool.FrameArrived(
+          winrt::auto_revoke,
+          [this, weak](const wgc::Direct3D11CaptureFramePool& pool,
+                       const winrt::Windows::Foundation::IInspectable&) {
+            if (auto locked = weak.lock()) OnFrameArrived(*locked, pool);
+          });
+
+      session->session = session->pool.CreateCaptureSession(session->item);
+      if (auto session2 =
+              session->session.try_as<wgc::IGraphicsCaptureSession2>()) {
+        session2.IsCursorCaptureEnabled(false);
+      }
+      if (auto session3 =
+              session->session.try_as<wgc::IGraphicsCaptureSession3>()) {
+        try {
+          session3.IsBorderRequired(false);
+        } catch (const winrt::hresult_error&) {
+          // Borderless capture not granted; the yellow border stays.
+        }
+      }
+      try {
+        // Windows 11 24H2: frames report what changed, which is what lets
+        // a still palette skip frames that don't touch it.
+        session->session.DirtyRegionMode(
+            wgc::GraphicsCaptureDirtyRegionMode::ReportOnly);
+        session->dirty_regions = true;
+      } catch (const winrt::hresult_error&) {
+        session->dirty_regions = false;
+      }
+      session->session.StartCapture();
+    } catch (...) {
+      monitors_.erase(monitor);
+      throw;
+    }
+    slot = std::move(session);
+    FP_LOG("Capture", "monitor session started");
+  }
+  slot->clients.push_back(client);
+  client->session = slot.get();
+  UpdatePacingLocked(*slot, MonotonicSeconds());
+}
+
+// Caller holds mutex_. Returns the session if `client` was its last
+// palette; the caller closes it after unlocking.
+std::shared_ptr<MonitorSession> CaptureHub::DetachLocked(
+    CaptureClient* client) {
+  MonitorSession* session = client->session;
+  client->session = nullptr;
+  if (!session) return nullptr;
+  auto& clients = session->clients;
+  clients.erase(std::remove(clients.begin(), clients.end(), client),
+                clients.end());
+  if (!clients.empty()) {
+    UpdatePacingLocked(*session, MonotonicSeconds());
+    return nullptr;
+  }
+  auto it = monitors_.find(session->monitor);
+  if (it == monitors_.end()) return nullptr;
+  std::shared_ptr<MonitorSession> orphan = std::move(it->second);
+  monitors_.erase(it);
+  orphan->closed = true;
+  return orphan;
+}
+
+// Caller holds mutex_.
+void CaptureHub::UpdateRoiLocked(CaptureClient* client) {
+  RECT window;
+  if (!GetWindowRect(client->hwnd, &window)) return;
+  const DesktopCaptureConfig& config = client->config;
+  double scale = GetDpiForWindow(client->hwnd) / 96.0;
+  auto px = [scale](double value) {
+    return static_cast<LONG>(std::lround(value * scale));
+  };
+  RECT roi = window;
+  if (config.has_region) {
+    roi.left = window.left + px(config.region_x);
+    roi.top = window.top + px(config.region_y);
+    roi.right = roi.left + px(config.region_width);
+    roi.bottom = roi.top + px(config.region_height);
+  }
+  roi.left -= px(config.padding_left);
+  roi.top -= px(config.padding_top);
+  roi.right += px(config.padding_right);
+  roi.bottom += px(config.padding_bottom);
+  client->screen_roi = roi;
+}
+
+// Caller holds mutex_. Ask the session for frames no faster than its
+// fastest palette currently needs (Windows 11 24H2; no-op before).
+void CaptureHub::UpdatePacingLocked(MonitorSession& session, double now) {
+  if (!session.pacing || session.clients.empty()) return;
+  double interval = 1.0;
+  for (const CaptureClient* client : session.clients) {
+    bool moving =
+        client->interactive || now - client->last_move < kMotionHoldSeconds;
+    interval = std::min(interval, moving ? client->moving_interval
+                                         : client->still_interval);
+  }
+  if (interval == session.min_update_interval) return;
+  try {
+    session.session.MinUpdateInterval(
+        std::chrono::duration_cast<winrt::Windows::Foundation::TimeSpan>(
+            std::chrono::duration<double>(interval)));
+    session.min_update_interval = interval;
+  } catch (const winrt::hresult_error&) {
+    session.pacing = false;
+  }
+}
+
+std::shared_ptr<DesktopCapture> CaptureHub::Start(
+    HWND hwnd, const DesktopCaptureConfig& config,
+    DesktopCapture::FrameCallback on_frame, std::string* error) {
+  auto client = std::make_shared<CaptureClient>(hwnd, config,
+                                                std::move(on_frame));
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (clients_.count(hwnd)) {
+      *error = "Window is already being captured";
+      return nullptr;
+    }
+    if (!EnsureDeviceLocked(hwnd, error)) return nullptr;
+    UpdateRoiLocked(client.get());
+    try {
+      AttachLocked(client.get(),
+                   MonitorFromWindow(hwnd, MONITOR_DEFAULTTONEAREST));
+    } catch (const winrt::hresult_error& e) {
+      *error = winrt::to_string(e.message());
+      return nullptr;
+    }
+    clients_[hwnd] = client.get();
+    client_count_.store(clients_.size(), std::memory_order_release);
+  }
+
+  if (config.exclude_self) {
+    // WDA_EXCLUDEFROMCAPTURE (Windows 10 2004+) keeps the palette out of
+    // its own backdrop.
+    bool excluded = SetWindowDisplayAffinity(hwnd, WDA_EXCLUDEFROMCAPTURE) != 0;
+    if (!excluded) FP_LOG("Capture", "exclude self unavailable");
+    std::lock_guard<std::mutex> lock(mutex_);
+    client->excluded = excluded;
+  }
+  return client;
+}
+
+void CaptureHub::Remove(CaptureClient* client) {
+  std::shared_ptr<MonitorSession> orphan;
+  bool excluded = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = clients_.find(client->hwnd);
+    if (it == clients_.end() || it->second != client) return;
+    clients_.erase(it);
+    client_count_.store(clients_.size(), std::memory_order_release);
+    orphan = DetachLocked(client);
+    excluded = client->excluded;
+    client->excluded = false;
+    if (clients_.empty()) {
+      // Targets keep their own device reference until Flutter lets go.
+      filter_.reset();
+      filter_failed_ = false;
+      winrt_device_ = nullptr;
+      context_ = nullptr;
+      device_ = nullptr;
+    }
+  }
+  if (orphan) orphan->Close();
+  if (excluded && IsWindow(client->hwnd)) {
+    SetWindowDisplayAffinity(client->hwnd, WDA_NONE);
+  }
+}
+
+void CaptureHub::WindowMoved(HWND hwnd) {
+  if (client_count_.load(std::memory_order_acquire) == 0) return;
+  std::shared_ptr<MonitorSession> orphan;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = clients_.find(hwnd);
+    if (it == clients_.end()) return;
+    CaptureClient* client = it->second;
+    double now = MonotonicSeconds();
+    UpdateRoiLocked(client);
+    client->last_move = now;
+
+    // Crossed onto another monitor: switch to (or start) its session.
+    HMONITOR monitor = MonitorFromWindow(hwnd, MONITOR_DEFAULTTONEAREST);
+    if (!client->session || client->session->monitor != monitor) {
+      orphan = DetachLocked(client);
+      try {
+        AttachLocked(client, monitor);
+      } catch (const winrt::hresult_error& e) {
+        // Retried on the next move.
+        FP_LOG("Capture", "monitor switch failed: ",
+               winrt::to_string(e.message()));
+      }
+    } else {
+      UpdatePacingLocked(*client->session, now);
+    }
+  }
+  if (orphan) orphan->Close();
+}
+
+void CaptureHub::SetInteractive(HWND hwnd, bool interactive) {
+  if (client_count_.load(std::memory_order_acquire) == 0) return;
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = clients_.find(hwnd);
+  if (it == clients_.end()) return;
+  CaptureClient* client = it->second;
+  client->interactive = interactive;
+  client->last_move = MonotonicSeconds();
+  if (client->session) UpdatePacingLocked(*client->session, client->last_move);
+}
+
+// Caller holds mutex_.
+bool CaptureHub::EnsureSlotLocked(TextureSlot& slot, UINT width,
+                                  UINT height) {
+  if (slot.texture && width == slot.width && height == slot.height) {
+    return true;
+  }
+  D3D11_TEXTURE2D_DESC desc = {};
+  desc.Width = width;
+  desc.Height = height;
+  desc.MipLevels = 1;
+  desc.ArraySize = 1;
+  desc.Format = DXGI_FORMAT_B8G8R8A8_UNORM;
+  desc.SampleDesc.Count = 1;
+  desc.Usage = D3D11_USAGE_DEFAULT;
+  desc.BindFlags = D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET;
+  // Legacy shared handle: what kFlutterDesktopGpuSurfaceTypeDxgiSharedHandle
+  // opens on ANGLE's device.
+  desc.MiscFlags = D3D11_RESOURCE_MISC_SHARED;
+
+  winrt::com_ptr<ID3D11Texture2D> texture;
+  if (FAILED(device_->CreateTexture2D(&desc, nullptr, texture.put()))) {
+    return false;
+  }
+  HANDLE handle = nullptr;
+  auto resource = texture.try_as<IDXGIResource>();
+  if (!resource || FAILED(resource->GetSharedHandle(&handle))) return false;
+
+  slot.texture = std::move(texture);
+  slot.width = width;
+  slot.height = height;
+  slot.shared_handle = handle;
+  return true;
+}
+
+// Caller holds mutex_.
+CaptureFilter* CaptureHub::FilterLocked() {
+  if (filter_) return filter_.get();
+  if (filter_failed_ || !device_) return nullptr;
+  auto filter = std::make_unique<CaptureFilter>();
+  if (!filter->Initialize(device_.get())) {
+    FP_LOG("Capture", "GPU filter unavailable; delivering unfiltered frames");
+    filter_failed_ = true;
+    return nullptr;
+  }
+  filter_ = std::move(filter);
+  return filter_.get();
+}
+
+// Caller holds mutex_. Copy `box` of the captured surface into the client's
+// output `slot`, through the downsample / blur passes when configured.
+bool CaptureHub::CopyLocked(CaptureClient* client, TextureSlot& slot,
+                            ID3D11Texture2D* source, const D3D11_BOX& box) {
+  const DesktopCaptureConfig& config = client->config;
+  int downsample = DownsampleFor(config);
+  int passes =
+      config.output == CaptureOutput::kBlurred ? config.blur_passes : 0;
+  UINT width = box.right - box.left;
+  UINT height = box.bottom - box.top;
+
+  CaptureFilter* filter =
+      downsample > 1 || passes > 0 ? FilterLocked() : nullptr;
+  if (filter) {
+    ID3D11Texture2D* input =
+        filter->PrepareInput(&client->scratch, width, height, downsample);
+    if (!input) return false;
+    context_->CopySubresourceRegion(input, 0, 0, 0, 0, source, 0, &box);
+    const CaptureFilter::Surface& result =
+        filter->Run(context_.get(), &client->scratch, passes);
+    if (!EnsureSlotLocked(slot, result.width, result.height)) return false;
+    context_->CopyResource(slot.texture.get(), result.texture.get());
+    return true;
+  }
+
+  if (!EnsureSlotLocked(slot, width, height)) return false;
+  context_->CopySubresourceRegion(slot.texture.get(), 0, 0, 0, 0, source, 0,
+                                  &box);
+  return true;
+}
+
+// Capture worker thread (one per monitor session).
+void CaptureHub::OnFrameArrived(MonitorSession& session,
+                                const wgc::Direct3D11CaptureFramePool& pool) {
+  try {
+    wgc::Direct3D11CaptureFrame frame = pool.TryGetNextFrame();
+    if (!frame) return;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (session.closed || !device_) return;
+
+    auto content = frame.ContentSize();
+    if (content.Width != session.pool_size.Width ||
+        content.Height != session.pool_size.Height) {
+      // Display mode changed; this frame is sized for the old surfaces.
+      session.pool_size = content;
+      pool.Recreate(winrt_device_, kCaptureFormat, kPoolBuffers, content);
+      return;
+    }
+
+    std::vector<RECT> dirty;
+    bool have_dirty = false;
+    if (session.dirty_regions) {
+      try {
+        for (const auto& region : frame.DirtyRegions()) {
+          dirty.push_back({region.X, region.Y, region.X + region.Width,
+                           region.Y + region.Height});
+        }
+        have_dirty = true;
+      } catch (const winrt::hresult_error&) {
+        session.dirty_regions = false;
+      }
+    }
+
+    double now = MonotonicSeconds();
+    winrt::com_ptr<ID3D11Texture2D> source;
+    std::vector<std::pair<CaptureClient*, int>> published;
+    for (CaptureClient* client : session.clients) {
+      client->stats.frames_arrived.fetch_add(1, std::memory_order_relaxed);
+      bool moving =
+          client->interactive || now - client->last_move < kMotionHoldSeconds;
+      double interval =
+          moving ? client->moving_interval : client->still_interval;
+      if (now - client->last_copy < interval) {
+        client->stats.frames_throttled.fetch_add(1, std::memory_order_relaxed);
+        continue;
+      }
+
+      RECT roi = client->screen_roi;
+      OffsetRect(&roi, -session.origin.x, -session.origin.y);
+      roi.left = std::clamp<LONG>(roi.left, 0, content.Width);
+      roi.top = std::clamp<LONG>(roi.top, 0, content.Height);
+      roi.right = std::clamp<LONG>(roi.right, roi.left, content.Width);
+      roi.bottom = std::clamp<LONG>(roi.bottom, roi.top, content.Height);
+      UINT width = static_cast<UINT>(roi.right - roi.left);
+      UINT height = static_cast<UINT>(roi.bottom - roi.top);
+      if (width == 0 || height == 0) continue;
+
+      // Nothing moved and nothing changed underneath: the texture Flutter
+      // already has is still right.
+      bool moved = !client->has_output || !EqualRect(&roi, &client->copied_roi);
+      if (!moved && have_dirty && client->config.adaptive_frame_rate &&
+          !IntersectsAny(dirty, roi)) {
+        client->stats.frames_static.fetch_add(1, std::memory_order_relaxed);
+        continue;
+      }
+
+      if (!source) {
+        auto access = frame.Surface().as<
+            ::Windows::Graphics::DirectX::Direct3D11::
+                IDirect3DDxgiInterfaceAccess>();
+        winrt::check_hresult(
+            access->GetInterface(__uuidof(ID3D11Texture2D), source.put_void()));
+      }
+      D3D11_BOX box = {static_cast<UINT>(roi.left),
+                       static_cast<UINT>(roi.top),
+                       0,
+                       static_cast<UINT>(roi.right),
+                       static_cast<UINT>(roi.bottom),
+                       1};
+      int slot = FreeSlot(client);
+      if (slot < 0 || !CopyLocked(client, client->slots[slot], source.get(),
+                                  box)) {
+        continue;
+      }
+      client->has_output = true;
+      client->copied_roi = roi;
+      client->last_copy = now;
+      client->stats.frames_copied.fetch_add(1, std::memory_order_relaxed);
+      Metrics::Instance().RecordCaptureFrame();
+      trace::CaptureFrame(width, height);
+      published.emplace_back(client, slot);
+    }
+
+    if (!published.empty()) {
+      // Submit before publishing so the copies are on the GPU before
+      // Flutter samples the shared textures from its own device.
+      context_->Flush();
+      for (const auto& [client, slot] : published) {
+        if (PublishSlot(client, slot, now) && client->on_frame) {
+          client->on_frame();
+        }
+      }
+    }
+    UpdatePacingLocked(session, now);
+  } catch (const winrt::hresult_error& e) {
+    FP_LOG("Capture", "frame failed: ", winrt::to_string(e.message()));
+  }
+}
+
+}  // namespace
+
+// static
+bool DesktopCapture::IsSupported() {
+  static const bool supported = [] {
+    try {
+      return wgc::GraphicsCaptureSession::IsSupported();
+    } catch (const winrt::hresult_error&) {
+      return false;  // Runtime class not registered (pre-1903).
+    }
+  }();
+  return supported;
+}
+
+// static
+std::shared_ptr<DesktopCapture> DesktopCapture::Start(
+    HWND hwnd, const DesktopCaptureConfig& config, FrameCallback on_frame,
+    std::string* error) {
+  if (!IsSupported()) {
+    *error = "Windows.Graphics.Capture is not supported";
+    return nullptr;
+  }
+  auto capture =
+      CaptureHub::Instance().Start(hwnd, config, std::move(on_frame), error);
+  if (capture) FP_LOG("Capture", "started");
+  return capture;
+}
+
+// static
+void DesktopCapture::WindowMoved(HWND hwnd) {
+  CaptureHub::Instance().WindowMoved(hwnd);
+}
+
+// static
+void DesktopCapture::SetInteractive(HWND hwnd, bool interactive) {
+  CaptureHub::Instance().SetInteractive(hwnd, interactive);
+}
+
+}  // namespace floating_palette
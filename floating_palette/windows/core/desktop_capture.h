@@ -0,0 +1,140 @@
+#pragma once
+
+#include <windows.h>
+
+#include <flutter_texture_registrar.h>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace floating_palette {
+
+/// What the texture handed to Flutter contains.
+enum class CaptureOutput {
+  /// The region as captured (optionally reduced by pixel_ratio).
+  kRaw,
+  /// Downsampled and blurred on the GPU, ready to show as a backdrop.
+  kBlurred,
+};
+
+/// Capture parameters (see BackgroundCaptureConfig.toMap in Dart).
+struct DesktopCaptureConfig {
+  /// Upper bound on copied frames per second while the palette is still
+  /// (1-60).
+  int frame_rate = 30;
+  /// Upper bound while the palette is being dragged or moved (1-60).
+  int drag_frame_rate = 60;
+  /// Skip frames whose dirty regions miss this palette's rect, so a static
+  /// backdrop costs nothing. Needs dirty-region reporting (Windows 11
+  /// 24H2); otherwise every frame the monitor produces is a candidate.
+  bool adaptive_frame_rate = true;
+  /// kRaw: output scale relative to the window's physical size, rounded
+  /// down to 1, 1/2, 1/4 or 1/8.
+  double pixel_ratio = 1.0;
+  CaptureOutput output = CaptureOutput::kRaw;
+  /// kBlurred: size reduction per axis (1, 2, 4 or 8).
+  int downsample = 4;
+  /// kBlurred: Kawase passes at the reduced size (0-8).
+  int blur_passes = 4;
+  /// Hide the palette itself from the capture.
+  bool exclude_self = true;
+  /// Extra margin around the window, in logical pixels.
+  double padding_top = 0;
+  double padding_right = 0;
+  double padding_bottom = 0;
+  double padding_left = 0;
+  /// Capture this rect (logical pixels, relative to the window's top-left)
+  /// instead of the window rect. It follows the window like the default.
+  bool has_region = false;
+  double region_x = 0;
+  double region_y = 0;
+  double region_width = 0;
+  double region_height = 0;
+};
+
+/// Counters for one capture.
+struct DesktopCaptureStats {
+  /// Frames delivered by the capture API.
+  std::atomic<uint64_t> frames_arrived{0};
+  /// Frames copied into the shared texture and published to Flutter.
+  std::atomic<uint64_t> frames_copied{0};
+  /// Frames dropped because they came in faster than the current rate.
+  std::atomic<uint64_t> frames_throttled{0};
+  /// Frames skipped because nothing changed behind the palette.
+  std::atomic<uint64_t> frames_static{0};
+  /// Copied frames replaced by a newer one before Flutter sampled them.
+  std::atomic<uint64_t> frames_dropped{0};
+  /// Frames Flutter sampled, and those it sampled more than a display
+  /// frame after they were published.
+  std::atomic<uint64_t> frames_presented{0};
+  std::atomic<uint64_t> frames_late{0};
+};
+
+/// Desktop capture behind a palette window, delivered as a GPU surface
+/// (Windows port of the ScreenCaptureKit provider).
+///
+/// Uses Windows.Graphics.Capture with a free-threaded
+/// Direct3D11CaptureFramePool, one session per monitor shared by every
+/// palette on it. Each frame, each palette's region of interest (its window
+/// rect plus padding, or an explicit region) is copied GPU-side into its own
+/// texture created with a DXGI shared handle, which Flutter opens as a
+/// kFlutterDesktopGpuSurfaceTexture. Pixels never come back to the CPU. In
+/// kBlurred mode the copy goes through CaptureFilter first, so Flutter gets
+/// a small pre-blurred texture instead of blurring a full-size one.
+///
+/// The region follows the window: the panel reports every position change
+/// (WindowMoved), which also moves the palette to another monitor's session
+/// when it crosses over. The rate adapts: moving palettes copy at
+/// drag_frame_rate, still ones at frame_rate, and frames whose dirty
+/// regions miss the palette are skipped.
+///
+/// Output is triple-buffered: the capture thread copies into a free slot
+/// while Flutter holds the one it is showing, and publishing replaces any
+/// frame Flutter hasn't picked up yet instead of queueing it. The slot
+/// handoff is a short lock around indices, so the raster thread never waits
+/// on a capture frame.
+///
+/// Frames arrive on capture worker threads; `on_frame` is called there
+/// when a frame is published and Flutter has consumed the previous
+/// notification (so at most once per Flutter frame), and never after
+/// Stop() returns. ObtainDescriptor is called by Flutter on the raster
+/// thread.
+class DesktopCapture {
+ public:
+  using FrameCallback = std::function<void()>;
+
+  /// Windows.Graphics.Capture is available (Windows 10 1903+).
+  static bool IsSupported();
+
+  /// Start capturing behind `hwnd`. Returns null and sets `error` on
+  /// failure. Platform thread.
+  static std::shared_ptr<DesktopCapture> Start(
+      HWND hwnd, const DesktopCaptureConfig& config, FrameCallback on_frame,
+      std::string* error);
+
+  /// The window's position or size changed (platform thread). Cheap when
+  /// nothing captures it.
+  static void WindowMoved(HWND hwnd);
+
+  /// Interactive move in progress (system move loop or drag): holds the
+  /// drag rate until cleared.
+  static void SetInteractive(HWND hwnd, bool interactive);
+
+  virtual ~DesktopCapture() = default;
+
+  /// Stop capturing. Idempotent; any thread.
+  virtual void Stop() = 0;
+
+  /// GpuSurfaceTexture callback: the newest published frame's shared
+  /// handle (which then stays untouched until a newer one is taken), or
+  /// null before the first frame.
+  virtual const FlutterDesktopGpuSurfaceDescriptor* ObtainDescriptor(
+      size_t width, size_t height) = 0;
+
+  virtual const DesktopCaptureStats& Stats() const = 0;
+};
+
+}  // namespace floating_palette
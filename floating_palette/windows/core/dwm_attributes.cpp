@@ -0,0 +1,86 @@
+#include "dwm_attributes.h"
+
+namespace floating_palette {
+
+namespace {
+
+bool SameMargins(const MARGINS& a, const MARGINS& b) {
+  return a.cxLeftWidth == b.cxLeftWidth && a.cxRightWidth == b.cxRightWidth &&
+         a.cyTopHeight == b.cyTopHeight &&
+         a.cyBottomHeight == b.cyBottomHeight;
+}
+
+}  // namespace
+
+// static
+DwmAttributeStats& DwmAttributes::Stats() {
+  static DwmAttributeStats stats;
+  return stats;
+}
+
+template <typename T>
+void DwmAttributes::Set(HWND hwnd, DWMWINDOWATTRIBUTE attribute,
+                        Cached<T>& cached, T value) {
+  auto& stats = Stats();
+  if (cached.known && cached.value == value) {
+    stats.skipped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  // Cached even on failure (attribute unsupported on this build): retrying
+  // the same value would fail the same way.
+  DwmSetWindowAttribute(hwnd, attribute, &value, sizeof(value));
+  cached.known = true;
+  cached.value = value;
+  stats.applied.fetch_add(1, std::memory_order_relaxed);
+}
+
+void DwmAttributes::SetCornerPreference(HWND hwnd,
+                                        DWM_WINDOW_CORNER_PREFERENCE value) {
+  Set(hwnd, DWMWA_WINDOW_CORNER_PREFERENCE, corner_, value);
+}
+
+void DwmAttributes::SetBorderColor(HWND hwnd, COLORREF value) {
+  Set(hwnd, DWMWA_BORDER_COLOR, border_color_, value);
+}
+
+void DwmAttributes::SetBackdrop(HWND hwnd, DWM_SYSTEMBACKDROP_TYPE value) {
+  Set(hwnd, DWMWA_SYSTEMBACKDROP_TYPE, backdrop_, value);
+}
+
+void DwmAttributes::SetDarkMode(HWND hwnd, bool value) {
+  Set(hwnd, DWMWA_USE_IMMERSIVE_DARK_MODE, dark_mode_,
+      value ? TRUE : FALSE);
+}
+
+void DwmAttributes::SetFrameMargins(HWND hwnd, const MARGINS& value) {
+  auto& stats = Stats();
+  if (margins_.known && SameMargins(margins_.value, value)) {
+    stats.skipped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  DwmExtendFrameIntoClientArea(hwnd, &value);
+  margins_.known = true;
+  margins_.value = value;
+  stats.applied.fetch_add(1, std::memory_order_relaxed);
+}
+
+void DwmAttributes::Apply(HWND hwnd, const PanelAppearance& appearance) {
+  SetCornerPreference(hwnd, appearance.corner);
+  SetBorderColor(hwnd, appearance.transparent ? DWMWA_COLOR_NONE
+                                              : appearance.border_color);
+  if (glass_) return;
+
+  // A frame extended over the whole client area lets DWM draw the backdrop
+  // (or the desktop) behind Flutter's transparent pixels. Otherwise a
+  // one-pixel margin is what gives a borderless popup its DWM shadow.
+  MARGINS margins{0, 0, 0, 0};
+  if (appearance.transparent || appearance.backdrop != DWMSBT_NONE) {
+    margins = MARGINS{-1, -1, -1, -1};
+  } else if (appearance.shadow) {
+    margins = MARGINS{0, 0, 0, 1};
+  }
+  SetFrameMargins(hwnd, margins);
+  SetBackdrop(hwnd, appearance.backdrop);
+}
+
+}  // namespace floating_palette
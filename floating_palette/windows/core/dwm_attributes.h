@@ -0,0 +1,78 @@
+#pragma once
+
+#include <windows.h>
+#include <dwmapi.h>
+
+#include <atomic>
+#include <cstdint>
+
+namespace floating_palette {
+
+/// Counters for DWM attribute writes.
+struct DwmAttributeStats {
+  /// DwmSetWindowAttribute / DwmExtendFrameIntoClientArea calls made.
+  std::atomic<uint64_t> applied{0};
+  /// Writes skipped because DWM already had the value.
+  std::atomic<uint64_t> skipped{0};
+};
+
+/// A palette's appearance as requested through AppearanceService. Kept on
+/// the window so a single setter (setShadow, say) can recompute the
+/// attributes that depend on several settings.
+struct PanelAppearance {
+  DWM_WINDOW_CORNER_PREFERENCE corner = DWMWCP_DEFAULT;
+  bool shadow = true;
+  bool transparent = false;
+  /// DWMWA_COLOR_DEFAULT unless a background color was set.
+  COLORREF border_color = DWMWA_COLOR_DEFAULT;
+  /// System backdrop (setBlur).
+  DWM_SYSTEMBACKDROP_TYPE backdrop = DWMSBT_NONE;
+};
+
+/// DWM attributes as last applied to a palette panel.
+///
+/// Every setter compares with the cached value and only calls DWM when it
+/// differs: each DWM write recomposes the window, and appearance passes
+/// (theme switches) reapply the same values to every palette. Both the
+/// appearance service and the glass backdrop write through here, so the
+/// cache stays the single record of what DWM has.
+///
+/// Platform thread only.
+class DwmAttributes {
+ public:
+  void SetCornerPreference(HWND hwnd, DWM_WINDOW_CORNER_PREFERENCE value);
+  void SetBorderColor(HWND hwnd, COLORREF value);
+  void SetBackdrop(HWND hwnd, DWM_SYSTEMBACKDROP_TYPE value);
+  void SetDarkMode(HWND hwnd, bool value);
+  void SetFrameMargins(HWND hwnd, const MARGINS& value);
+
+  /// Apply `appearance`, writing only the attributes that change. While
+  /// glass is on, frame margins and backdrop are left to the glass.
+  void Apply(HWND hwnd, const PanelAppearance& appearance);
+
+  /// GlassBackdrop owns frame margins and backdrop while `enabled`.
+  void set_glass(bool enabled) { glass_ = enabled; }
+
+  static DwmAttributeStats& Stats();
+
+ private:
+  template <typename T>
+  struct Cached {
+    bool known = false;
+    T value{};
+  };
+
+  /// Write `value` as `attribute` unless `cached` already holds it.
+  template <typename T>
+  static void Set(HWND hwnd, DWMWINDOWATTRIBUTE attribute, Cached<T>& cached,
+                  T value);
+
+  Cached<DWM_WINDOW_CORNER_PREFERENCE> corner_;
+  Cached<COLORREF> border_color_;
+  Cached<DWM_SYSTEMBACKDROP_TYPE> backdrop_;
+  Cached<BOOL> dark_mode_;
+  Cached<MARGINS> margins_;
+  bool glass_ = false;
+};
+
+}  // namespace floating_palette
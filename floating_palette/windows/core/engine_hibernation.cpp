@@ -0,0 +1,114 @@
+#include "engine_hibernation.h"
+
+#include <memory>
+
+#include "../services/window_channel_router.h"
+#include "logger.h"
+#include "palette_panel.h"
+
+namespace floating_palette {
+
+namespace {
+
+// Handled by the services binding in every engine.
+constexpr char kSystemChannel[] = "flutter/system";
+
+}  // namespace
+
+EngineHibernation& EngineHibernation::Instance() {
+  static EngineHibernation* hibernation = new EngineHibernation();
+  return *hibernation;
+}
+
+void EngineHibernation::Hidden(PaletteWindow& window) {
+  if (!window.keep_alive || window.frames_paused) return;
+  // Cloaked windows still count as visible to the engine, which would keep
+  // it "resumed" and producing frames nobody sees.
+  SendLifecycle(window, "hidden");
+  window.frames_paused = true;
+  if (window.suspend_after_ms >= 0) {
+    SetTimer(window.hwnd, kIdleTimerId,
+             static_cast<UINT>(window.suspend_after_ms), OnIdleTimer);
+  }
+}
+
+void EngineHibernation::Wake(PaletteWindow& window) {
+  if (!window.frames_paused) return;
+  KillTimer(window.hwnd, kIdleTimerId);
+  window.frames_paused = false;
+
+  if (window.suspended) {
+    window.suspended = false;
+    // Back to full size; the engine reallocates its swap chain and renders
+    // a frame ahead of the reveal.
+    HWND view = GetWindow(window.hwnd, GW_CHILD);
+    RECT client;
+    if (view && GetClientRect(window.hwnd, &client)) {
+      MoveWindow(view, 0, 0, client.right, client.bottom, TRUE);
+    }
+    FP_LOG("Window", "resumed: ", window.id);
+    Emit("resumed", window.id);
+  }
+  SendLifecycle(window, "resumed");
+}
+
+void EngineHibernation::Forget(PaletteWindow& window) {
+  if (window.hwnd) KillTimer(window.hwnd, kIdleTimerId);
+  window.frames_paused = false;
+  window.suspended = false;
+}
+
+void EngineHibernation::Suspend(PaletteWindow& window) {
+  if (!window.frames_paused || window.suspended) return;
+  window.suspended = true;
+
+  // Hidden rather than cloaked: DWM releases the redirection surface. The
+  // cloak stays set, so IsShown remains false either way.
+  ShowWindow(window.hwnd, SW_HIDE);
+  // The engine sizes its swap chain to the view; a one-pixel view leaves
+  // next to nothing allocated. Resized before pausing so the engine can
+  // still complete the resize frame.
+  if (HWND view = GetWindow(window.hwnd, GW_CHILD)) {
+    MoveWindow(view, 0, 0, 1, 1, FALSE);
+  }
+  SendMemoryPressure(window);
+  SendLifecycle(window, "paused");
+
+  FP_LOG("Window", "suspended: ", window.id);
+  Emit("suspended", window.id);
+}
+
+void EngineHibernation::Emit(const char* event, const std::string& id) {
+  if (event_sink_) event_sink_("window", event, &id, flutter::EncodableMap{});
+}
+
+// static
+void EngineHibernation::SendLifecycle(PaletteWindow& window,
+                                      const char* state) {
+  // Over the self channel: the palette runner swallows hidden/paused on
+  // flutter/lifecycle so focus loss never freezes a palette.
+  WindowChannelRouter::EnsureSelfChannel(&window);
+  if (!window.self_channel) return;
+  window.self_channel->InvokeMethod(
+      "setLifecycleState", std::make_unique<flutter::EncodableValue>(state));
+}
+
+// static
+void EngineHibernation::SendMemoryPressure(PaletteWindow& window) {
+  // JSONMessageCodec; the framework clears its image cache.
+  static constexpr char kMessage[] = R"({"type":"memoryPressure"})";
+  if (!window.registrar) return;
+  window.registrar->messenger()->Send(
+      kSystemChannel, reinterpret_cast<const uint8_t*>(kMessage),
+      sizeof(kMessage) - 1);
+}
+
+// static
+void CALLBACK EngineHibernation::OnIdleTimer(HWND hwnd, UINT message,
+                                             UINT_PTR id, DWORD time) {
+  KillTimer(hwnd, id);
+  PaletteWindow* window = PalettePanel::FromHwnd(hwnd);
+  if (window) Instance().Suspend(*window);
+}
+
+}  // namespace floating_palette
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <windows.h>
+
+#include <string>
+
+#include "window_store.h"
+
+namespace floating_palette {
+
+/// Idle engine suspension for hidden keep-alive palettes.
+///
+/// A keep-alive palette hides by cloaking (see RevealPipeline), which keeps
+/// its engine, raster surface and caches live. On hide its framework is
+/// told the app is hidden (PaletteSelf "setLifecycleState"), which stops
+/// frame scheduling and mutes tickers.
+/// If it stays hidden for `suspend_after_ms`, it is suspended: the panel is
+/// really hidden (DWM drops its redirection surface), the Flutter view is
+/// shrunk so the engine resizes its swap chain to a single pixel, the image
+/// cache is flushed (memory pressure) and the lifecycle goes to paused.
+/// Showing it again restores the view and resumes the engine before the
+/// reveal waits for its first frame.
+///
+/// Dart sees only the "window" "suspended" / "resumed" events.
+///
+/// Platform thread only.
+class EngineHibernation {
+ public:
+  static EngineHibernation& Instance();
+
+  EngineHibernation(const EngineHibernation&) = delete;
+  EngineHibernation& operator=(const EngineHibernation&) = delete;
+
+  void SetEventSink(EventSink sink) { event_sink_ = std::move(sink); }
+
+  /// A keep-alive window was hidden: pause frames and arm the idle timer.
+  void Hidden(PaletteWindow& window);
+
+  /// The window is about to be shown: cancel the timer, resume the engine.
+  void Wake(PaletteWindow& window);
+
+  /// Stop tracking a window that is being destroyed.
+  void Forget(PaletteWindow& window);
+
+ private:
+  static constexpr UINT_PTR kIdleTimerId = 0x4842;  // 'HB'
+
+  EngineHibernation() = default;
+
+  void Suspend(PaletteWindow& window);
+  void Emit(const char* event, const std::string& id);
+
+  static void SendLifecycle(PaletteWindow& window, const char* state);
+  static void SendMemoryPressure(PaletteWindow& window);
+  static void CALLBACK OnIdleTimer(HWND hwnd, UINT message, UINT_PTR id,
+                                   DWORD time);
+
+  EventSink event_sink_;
+};
+
+}  // namespace floating_palette
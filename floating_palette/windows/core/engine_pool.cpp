@@ -0,0 +1,179 @@
+#include "engine_pool.h"
+
+#include <flutter/plugin_registrar_windows.h>
+#include <flutter_windows.h>
+
+#include "../services/window_channel_router.h"
+#include "logger.h"
+#include "palette_panel.h"
+#include "window_store.h"
+
+namespace floating_palette {
+
+namespace {
+
+constexpr wchar_t kPoolClassName[] = L"FloatingPaletteEnginePool";
+
+// Relative to the runner executable, as laid out by the Flutter tool.
+constexpr wchar_t kAssetsPath[] = L"data\\flutter_assets";
+constexpr wchar_t kIcuDataPath[] = L"data\\icudtl.dat";
+constexpr wchar_t kAotLibraryPath[] = L"data\\app.so";
+
+}  // namespace
+
+EnginePool::EnginePool() {
+  WNDCLASSEXW wc = {};
+  wc.cbSize = sizeof(wc);
+  wc.lpfnWndProc = MessageWndProc;
+  wc.hInstance = GetModuleHandle(nullptr);
+  wc.lpszClassName = kPoolClassName;
+  RegisterClassExW(&wc);
+
+  message_window_ =
+      CreateWindowExW(0, kPoolClassName, L"", 0, 0, 0, 0, 0, HWND_MESSAGE,
+                      nullptr, GetModuleHandle(nullptr), nullptr);
+  SetWindowLongPtr(message_window_, GWLP_USERDATA,
+                   reinterpret_cast<LONG_PTR>(this));
+}
+
+EnginePool::~EnginePool() {
+  if (message_window_) {
+    SetWindowLongPtr(message_window_, GWLP_USERDATA, 0);
+    DestroyWindow(message_window_);
+  }
+  while (!warm_.empty()) {
+    Release(std::move(warm_.front()));
+    warm_.pop_front();
+  }
+}
+
+void EnginePool::SetTargetSize(size_t size) {
+  target_size_ = size;
+  Trim();
+  ScheduleRefill();
+}
+
+std::unique_ptr<PaletteWindow> EnginePool::Acquire(
+    const std::string& id,
+    const std::string& entry_point) {
+  std::unique_ptr<PaletteWindow> window;
+  if (entry_point == kDefaultEntryPoint && !warm_.empty()) {
+    window = std::move(warm_.front());
+    warm_.pop_front();
+    FP_LOG("Window", "pool hit: ", id);
+  } else {
+    FP_LOG("Window", "pool miss (cold start): ", id);
+    window = Spawn(entry_point);
+  }
+
+  ScheduleRefill();
+  if (!window) return nullptr;
+
+  window->id = id;
+  if (window->pending_id_result) {
+    window->pending_id_result->Success(flutter::EncodableValue(id));
+    window->pending_id_result.reset();
+  }
+  return window;
+}
+
+// static
+void EnginePool::Release(std::unique_ptr<PaletteWindow> window) {
+  if (!window) return;
+  window->pending_id_result.reset();
+  WindowChannelRouter::TeardownChannels(window.get());
+  if (window->hwnd) {
+    SetWindowLongPtr(window->hwnd, GWLP_USERDATA, 0);
+  }
+  // Destroys the Flutter view HWND and shuts the engine down.
+  if (window->view_controller) {
+    FlutterDesktopViewControllerDestroy(window->view_controller);
+  }
+  if (window->hwnd) {
+    DestroyWindow(window->hwnd);
+  }
+}
+
+std::unique_ptr<PaletteWindow> EnginePool::Spawn(
+    const std::string& entry_point) {
+  auto window = std::make_unique<PaletteWindow>();
+
+  FlutterDesktopEngineProperties properties = {};
+  properties.assets_path = kAssetsPath;
+  properties.icu_data_path = kIcuDataPath;
+  properties.aot_library_path = kAotLibraryPath;
+  properties.dart_entrypoint = entry_point.c_str();
+
+  FlutterDesktopEngineRef engine = FlutterDesktopEngineCreate(&properties);
+  if (!engine) {
+    FP_LOG("Window", "FlutterDesktopEngineCreate failed");
+    return nullptr;
+  }
+
+  // Takes ownership of the engine and runs it.
+  window->view_controller =
+      FlutterDesktopViewControllerCreate(kInitialWidth, kInitialHeight, engine);
+  if (!window->view_controller) {
+    FP_LOG("Window", "FlutterDesktopViewControllerCreate failed");
+    return nullptr;
+  }
+  window->engine = FlutterDesktopViewControllerGetEngine(window->view_controller);
+
+  window->hwnd =
+      PalettePanel::Create(window.get(), kInitialWidth, kInitialHeight);
+  if (!window->hwnd) {
+    Release(std::move(window));
+    return nullptr;
+  }
+  PalettePanel::AttachView(
+      window->hwnd, FlutterDesktopViewGetHWND(FlutterDesktopViewControllerGetView(
+                        window->view_controller)));
+
+  window->registrar =
+      flutter::PluginRegistrarManager::GetInstance()
+          ->GetRegistrar<flutter::PluginRegistrarWindows>(
+              FlutterDesktopEngineGetPluginRegistrar(window->engine,
+                                                     "FloatingPalettePlugin"));
+  WindowChannelRouter::SetupChannels(window.get());
+  return window;
+}
+
+void EnginePool::ScheduleRefill() {
+  if (refill_scheduled_ || warm_.size() >= target_size_ || !message_window_) {
+    return;
+  }
+  refill_scheduled_ = true;
+  PostMessage(message_window_, kRefillMessage, 0, 0);
+}
+
+void EnginePool::RefillOne() {
+  refill_scheduled_ = false;
+  if (warm_.size() >= target_size_) return;
+
+  auto window = Spawn(kDefaultEntryPoint);
+  if (!window) return;  // Don't spin on a broken setup.
+  warm_.push_back(std::move(window));
+  FP_LOG("Window", "pool warm=", warm_.size());
+  ScheduleRefill();
+}
+
+void EnginePool::Trim() {
+  while (warm_.size() > target_size_) {
+    Release(std::move(warm_.back()));
+    warm_.pop_back();
+  }
+}
+
+// static
+LRESULT CALLBACK EnginePool::MessageWndProc(HWND hwnd, UINT message,
+                                            WPARAM wparam, LPARAM lparam) {
+  if (message == kRefillMessage) {
+    auto* pool =
+        reinterpret_cast<EnginePool*>(GetWindowLongPtr(hwnd, GWLP_USERDATA));
+    if (pool) pool->RefillOne();
+    return 0;
+  }
+  return DefWindowProc(hwnd, message, wparam, lparam);
+}
+
+}  // namespace floating_palette
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <windows.h>
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <string>
+
+namespace floating_palette {
+
+struct PaletteWindow;
+
+/// Pool of pre-spun palette engines.
+///
+/// Each warm entry is a complete PaletteWindow with no id yet: engine running
+/// the default entry point, Flutter view attached to a hidden panel, entry
+/// channel registered. The palette's Dart side blocks in `getPaletteId`
+/// until Acquire() assigns an id, so handing out a warm window skips engine
+/// and isolate startup entirely.
+///
+/// Engines and HWNDs must be created on the platform thread, so refill runs
+/// one spawn per posted message: the create that drained the pool returns
+/// first, and other messages interleave between spawns.
+class EnginePool {
+ public:
+  /// Dart entry point generated by floating_palette_generator.
+  static constexpr char kDefaultEntryPoint[] = "paletteMain";
+
+  EnginePool();
+  ~EnginePool();
+
+  EnginePool(const EnginePool&) = delete;
+  EnginePool& operator=(const EnginePool&) = delete;
+
+  /// Number of warm windows to keep ready. 0 disables pre-warming.
+  void SetTargetSize(size_t size);
+  size_t target_size() const { return target_size_; }
+  size_t warm_count() const { return warm_.size(); }
+
+  /// Hand out a window for `id`. Draws from the pool when `entry_point` is
+  /// the default; otherwise (or when empty) cold-starts a new engine.
+  /// Returns nullptr if the engine could not be started.
+  std::unique_ptr<PaletteWindow> Acquire(const std::string& id,
+                                         const std::string& entry_point);
+
+  /// Shut down a window's engine and destroy its panel.
+  static void Release(std::unique_ptr<PaletteWindow> window);
+
+ private:
+  static constexpr UINT kRefillMessage = WM_APP + 1;
+  static constexpr int kInitialWidth = 300;
+  static constexpr int kInitialHeight = 200;
+
+  size_t target_size_ = 0;
+  bool refill_scheduled_ = false;
+  HWND message_window_ = nullptr;
+  std::deque<std::unique_ptr<PaletteWindow>> warm_;
+
+  std::unique_ptr<PaletteWindow> Spawn(const std::string& entry_point);
+  void ScheduleRefill();
+  void RefillOne();
+  void Trim();
+
+  static LRESULT CALLBACK MessageWndProc(HWND hwnd, UINT message,
+                                         WPARAM wparam, LPARAM lparam);
+};
+
+}  // namespace floating_palette
@@ -0,0 +1,85 @@
+#include "event_filter.h"
+
+#include "logger.h"
+
+namespace floating_palette {
+
+namespace {
+
+bool NameMatches(const std::string& pattern, std::string_view name) {
+  return pattern == "*" || pattern == name;
+}
+
+}  // namespace
+
+// static
+EventFilter& EventFilter::Instance() {
+  static EventFilter instance;
+  return instance;
+}
+
+void EventFilter::Subscribe(const std::string& service,
+                            const std::string& event,
+                            const std::string* window_id) {
+  active_ = true;
+  if (!subscriptions_
+           .insert(Subscription{service, event,
+                                window_id ? *window_id : std::string()})
+           .second) {
+    return;
+  }
+  Rebuild();
+  FP_LOG("Plugin", "subscribe ", service, "/", event, " ",
+         window_id ? *window_id : std::string("*"));
+}
+
+void EventFilter::Unsubscribe(const std::string& service,
+                              const std::string& event,
+                              const std::string* window_id) {
+  // Filtering stays on: with no subscriptions left, nothing is wanted.
+  if (subscriptions_.erase(Subscription{
+          service, event, window_id ? *window_id : std::string()}) == 0) {
+    return;
+  }
+  Rebuild();
+}
+
+bool EventFilter::Match(std::string_view service,
+                        std::string_view event,
+                        const std::string* window_id) const {
+  const uint64_t kind = EventKind(service, event);
+  for (size_t slot = 0; slot < kSlots.size(); ++slot) {
+    if (kSlots[slot].kind != kind) continue;
+    if (any_window_.test(slot)) return true;
+    return window_id && windows_[slot].count(*window_id) > 0;
+  }
+  for (const Subscription& subscription : subscriptions_) {
+    if (NameMatches(subscription.service, service) &&
+        NameMatches(subscription.event, event) &&
+        (subscription.window_id.empty() ||
+         (window_id && subscription.window_id == *window_id))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void EventFilter::Rebuild() {
+  any_window_.reset();
+  for (size_t slot = 0; slot < kSlots.size(); ++slot) {
+    windows_[slot].clear();
+    for (const Subscription& subscription : subscriptions_) {
+      if (!NameMatches(subscription.service, kSlots[slot].service) ||
+          !NameMatches(subscription.event, kSlots[slot].event)) {
+        continue;
+      }
+      if (subscription.window_id.empty()) {
+        any_window_.set(slot);
+      } else {
+        windows_[slot].insert(subscription.window_id);
+      }
+    }
+  }
+}
+
+}  // namespace floating_palette
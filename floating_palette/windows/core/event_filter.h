@@ -0,0 +1,101 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <string_view>
+
+#include "command_hash.h"
+
+namespace floating_palette {
+
+/// The events Dart listens to (host/subscribe), so emitters can drop the
+/// rest before building any data.
+///
+/// Nothing is filtered until the first subscription: a host that never
+/// subscribes sees every event, as before. From then on an event is sent
+/// when a subscription matches its service and event ("*" matches any) and
+/// either names no window or names the event's window.
+///
+/// The high-rate kinds in kSlots (frame and drag moves, snap proximity,
+/// screen and active-app changes) each own a bit, so Wants() for them is
+/// a bit test; other kinds are rare and matched against the subscription
+/// list. High-rate emitters call Wants() before building their
+/// EncodableMap, so an unwanted event allocates nothing; SendEvent checks
+/// everything else.
+///
+/// Platform thread only.
+class EventFilter {
+ public:
+  static EventFilter& Instance();
+
+  /// Add or remove interest in `event` of `service` ("*" for any), for
+  /// every window or only `window_id`. Repeats are no-ops.
+  void Subscribe(const std::string& service,
+                 const std::string& event,
+                 const std::string* window_id);
+  void Unsubscribe(const std::string& service,
+                   const std::string& event,
+                   const std::string* window_id);
+
+  /// Whether Dart listens to `event` of `service` for `window_id`.
+  bool Wants(std::string_view service,
+             std::string_view event,
+             const std::string* window_id) const {
+    return !active_ || Match(service, event, window_id);
+  }
+
+  bool active() const { return active_; }
+  size_t subscription_count() const { return subscriptions_.size(); }
+
+ private:
+  struct Subscription {
+    std::string service;
+    std::string event;
+    std::string window_id;  // Empty: every window.
+
+    bool operator<(const Subscription& other) const {
+      if (service != other.service) return service < other.service;
+      if (event != other.event) return event < other.event;
+      return window_id < other.window_id;
+    }
+  };
+
+  struct Slot {
+    std::string_view service;
+    std::string_view event;
+    uint64_t kind;
+  };
+
+  static constexpr std::array<Slot, 7> kSlots = {{
+      {"frame", "moved", EventKind("frame", "moved")},
+      {"frame", "resized", EventKind("frame", "resized")},
+      {"snap", "proximityUpdated", EventKind("snap", "proximityUpdated")},
+      {"snap", "followerDragging", EventKind("snap", "followerDragging")},
+      {"screen", "screensChanged", EventKind("screen", "screensChanged")},
+      {"screen", "activeAppChanged",
+       EventKind("screen", "activeAppChanged")},
+      {"visibility", "opacityChanged",
+       EventKind("visibility", "opacityChanged")},
+  }};
+
+  EventFilter() = default;
+
+  bool Match(std::string_view service,
+             std::string_view event,
+             const std::string* window_id) const;
+  /// Recompute the slot bits from subscriptions_.
+  void Rebuild();
+
+  bool active_ = false;
+  std::set<Subscription> subscriptions_;
+  /// Slots some subscription wants for every window.
+  std::bitset<kSlots.size()> any_window_;
+  /// Windows named by per-window subscriptions, per slot.
+  std::array<std::set<std::string>, kSlots.size()> windows_;
+};
+
+}  // namespace floating_palette
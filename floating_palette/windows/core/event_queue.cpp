@@ -0,0 +1,137 @@
+#include "event_queue.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "command_hash.h"
+#include "id_table.h"
+#include "metrics.h"
+
+namespace floating_palette {
+
+namespace {
+
+constexpr wchar_t kQueueClassName[] = L"FloatingPaletteEventQueue";
+
+}  // namespace
+
+EventQueue::EventQueue(FlushHandler on_flush) : on_flush_(std::move(on_flush)) {
+  WNDCLASSEXW wc = {};
+  wc.cbSize = sizeof(wc);
+  wc.lpfnWndProc = MessageWndProc;
+  wc.hInstance = GetModuleHandle(nullptr);
+  wc.lpszClassName = kQueueClassName;
+  RegisterClassExW(&wc);
+
+  message_window_ =
+      CreateWindowExW(0, kQueueClassName, L"", 0, 0, 0, 0, 0, HWND_MESSAGE,
+                      nullptr, GetModuleHandle(nullptr), nullptr);
+  SetWindowLongPtr(message_window_, GWLP_USERDATA,
+                   reinterpret_cast<LONG_PTR>(this));
+}
+
+EventQueue::~EventQueue() {
+  if (message_window_) {
+    SetWindowLongPtr(message_window_, GWLP_USERDATA, 0);
+    DestroyWindow(message_window_);
+  }
+}
+
+// static
+bool EventQueue::IsCoalescable(uint64_t kind) {
+  switch (kind) {
+    case EventKind("frame", "moved"):
+    case EventKind("frame", "resized"):
+    case EventKind("snap", "proximityUpdated"):
+    case EventKind("snap", "followerDragging"):
+    case EventKind("visibility", "opacityChanged"):
+      return true;
+    default:
+      return false;
+  }
+}
+
+void EventQueue::Push(const std::string& service,
+                      const std::string& event,
+                      const std::string* window_id,
+                      const flutter::EncodableMap& data) {
+  flutter::EncodableMap args{
+      {flutter::EncodableValue("service"), flutter::EncodableValue(service)},
+      {flutter::EncodableValue("event"), flutter::EncodableValue(event)},
+      {flutter::EncodableValue("windowId"),
+       window_id ? flutter::EncodableValue(*window_id)
+                 : flutter::EncodableValue()},
+      {flutter::EncodableValue("data"), flutter::EncodableValue(data)},
+  };
+
+  Metrics::Instance().RecordEvent();
+  uint64_t kind = EventKind(service, event);
+  if (!IsCoalescable(kind)) {
+    slots_.clear();
+    pending_.emplace_back(std::move(args));
+    ScheduleFlush();
+    return;
+  }
+
+  const std::string* id =
+      window_id ? IdTable::Instance().Intern(*window_id) : nullptr;
+  for (auto& slot : slots_) {
+    if (slot.kind == kind && slot.window_id == id) {
+      // Drop the stale entry and queue the new one at the tail; replacing
+      // it in place would deliver it ahead of events emitted before it.
+      pending_[slot.index] = flutter::EncodableValue();
+      ++dropped_;
+      slot.index = pending_.size();
+      pending_.emplace_back(std::move(args));
+      ++coalesced_count_;
+      Metrics::Instance().RecordEventCoalesced();
+      return;
+    }
+  }
+  slots_.push_back(Slot{kind, id, pending_.size()});
+  pending_.emplace_back(std::move(args));
+  ScheduleFlush();
+}
+
+void EventQueue::Flush() {
+  flush_scheduled_ = false;
+  if (pending_.empty()) return;
+
+  flutter::EncodableList events;
+  events.swap(pending_);
+  slots_.clear();
+  if (dropped_) {
+    events.erase(std::remove_if(events.begin(), events.end(),
+                                [](const flutter::EncodableValue& event) {
+                                  return event.IsNull();
+                                }),
+                 events.end());
+    dropped_ = 0;
+  }
+  Metrics::Instance().RecordEventFlush();
+  on_flush_(std::move(events));
+}
+
+void EventQueue::ScheduleFlush() {
+  if (flush_scheduled_) return;
+  if (!message_window_) {
+    Flush();
+    return;
+  }
+  flush_scheduled_ = true;
+  PostMessage(message_window_, kFlushMessage, 0, 0);
+}
+
+// static
+LRESULT CALLBACK EventQueue::MessageWndProc(HWND hwnd, UINT message,
+                                            WPARAM wparam, LPARAM lparam) {
+  if (message == kFlushMessage) {
+    auto* queue =
+        reinterpret_cast<EventQueue*>(GetWindowLongPtr(hwnd, GWLP_USERDATA));
+    if (queue) queue->Flush();
+    return 0;
+  }
+  return DefWindowProc(hwnd, message, wparam, lparam);
+}
+
+}  // namespace floating_palette
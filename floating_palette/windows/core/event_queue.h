@@ -0,0 +1,81 @@
+#pragma once
+
+#include <windows.h>
+
+#include <flutter/encodable_value.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace floating_palette {
+
+/// Outgoing event queue for the `floating_palette` channel.
+///
+/// Events are queued as they are emitted and handed to the flush handler
+/// as one ordered list on the next message-loop turn, so a burst of drag or
+/// frame updates costs one channel hop.
+///
+/// Continuous, last-value-wins events (frame moved/resized, snap proximity
+/// and follower updates, opacity changes) drop the still-pending event of
+/// the same kind for the same window, and the new one joins the tail. The
+/// delivered list is therefore always a subsequence of emission order:
+/// moved, resized, moved arrives as [resized, moved], never with the later
+/// move ahead of the resize. Every other event is a barrier: it is never
+/// coalesced, and nothing queued before it is merged with anything queued
+/// after it, so shown/hidden/destroyed always land in emission order
+/// relative to the updates around them.
+///
+/// Platform thread only.
+class EventQueue {
+ public:
+  using FlushHandler = std::function<void(flutter::EncodableList events)>;
+
+  explicit EventQueue(FlushHandler on_flush);
+  ~EventQueue();
+
+  EventQueue(const EventQueue&) = delete;
+  EventQueue& operator=(const EventQueue&) = delete;
+
+  void Push(const std::string& service,
+            const std::string& event,
+            const std::string* window_id,
+            const flutter::EncodableMap& data);
+
+  /// Deliver everything pending now.
+  void Flush();
+
+  size_t pending_count() const { return pending_.size() - dropped_; }
+  uint64_t coalesced_count() const { return coalesced_count_; }
+
+ private:
+  static constexpr UINT kFlushMessage = WM_APP + 2;
+
+  struct Slot {
+    uint64_t kind;
+    /// Interned (IdTable), so matching is a pointer compare; null for
+    /// events without a window.
+    const std::string* window_id;
+    size_t index;
+  };
+
+  FlushHandler on_flush_;
+  HWND message_window_ = nullptr;
+  bool flush_scheduled_ = false;
+  /// Coalesced-away entries are left null until Flush compacts them, so
+  /// the indices in slots_ stay valid.
+  flutter::EncodableList pending_;
+  size_t dropped_ = 0;
+  std::vector<Slot> slots_;  // Coalescable events since the last barrier.
+  uint64_t coalesced_count_ = 0;
+
+  static bool IsCoalescable(uint64_t kind);
+  void ScheduleFlush();
+
+  static LRESULT CALLBACK MessageWndProc(HWND hwnd, UINT message,
+                                         WPARAM wparam, LPARAM lparam);
+};
+
+}  // namespace floating_palette
@@ -0,0 +1,180 @@
+#include "frame_batch.h"
+
+#include "logger.h"
+#include "metrics.h"
+#include "palette_panel.h"
+#include "trace.h"
+
+namespace floating_palette {
+
+namespace {
+
+constexpr wchar_t kFrameBatchClassName[] = L"FloatingPaletteFrameBatch";
+
+constexpr UINT kBaseFlags = SWP_NOZORDER | SWP_NOOWNERZORDER | SWP_NOACTIVATE;
+
+// SWP_ flags taking `hwnd` to `target`, or 0 if it is already there.
+UINT FlagsFor(HWND hwnd, const RECT& target) {
+  RECT current;
+  FrameSnapshot snapshot;
+  PaletteWindow* window = PalettePanel::FromHwnd(hwnd);
+  if (window && window->frame.Load(&snapshot)) {
+    current = snapshot.physical;
+  } else if (!GetWindowRect(hwnd, &current)) {
+    return kBaseFlags;
+  }
+  bool moved = current.left != target.left || current.top != target.top;
+  bool sized = current.right - current.left != target.right - target.left ||
+               current.bottom - current.top != target.bottom - target.top;
+  if (!moved && !sized) return 0;
+  UINT flags = kBaseFlags;
+  if (!moved) flags |= SWP_NOMOVE;
+  // Old client bits are stale at a new size; Flutter repaints anyway.
+  flags |= sized ? SWP_NOCOPYBITS : SWP_NOSIZE;
+  return flags;
+}
+
+}  // namespace
+
+// static
+FrameBatch& FrameBatch::Instance() {
+  // Never destroyed, like GlassBackdrop.
+  static FrameBatch* batch = new FrameBatch();
+  return *batch;
+}
+
+// static
+FrameBatchStats& FrameBatch::Stats() {
+  static FrameBatchStats stats;
+  return stats;
+}
+
+FrameBatch::FrameBatch() {
+  WNDCLASSEXW wc = {};
+  wc.cbSize = sizeof(wc);
+  wc.lpfnWndProc = MessageWndProc;
+  wc.hInstance = GetModuleHandle(nullptr);
+  wc.lpszClassName = kFrameBatchClassName;
+  RegisterClassExW(&wc);
+
+  message_window_ = CreateWindowExW(0, kFrameBatchClassName, L"", 0, 0, 0, 0,
+                                    0, HWND_MESSAGE, nullptr,
+                                    GetModuleHandle(nullptr), nullptr);
+  SetWindowLongPtr(message_window_, GWLP_USERDATA,
+                   reinterpret_cast<LONG_PTR>(this));
+}
+
+// static
+void FrameBatch::Apply(const std::vector<Change>& changes) {
+  struct Move {
+    const Change* change;
+    UINT flags;
+  };
+  std::vector<Move> moves;
+  moves.reserve(changes.size());
+  auto& stats = Stats();
+  for (const Change& change : changes) {
+    if (!change.hwnd) continue;
+    UINT flags = FlagsFor(change.hwnd, change.frame);
+    if (!flags) {
+      stats.unchanged.fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+    moves.push_back(Move{&change, flags});
+  }
+  if (moves.empty()) return;
+  stats.batches.fetch_add(1, std::memory_order_relaxed);
+  stats.windows.fetch_add(moves.size(), std::memory_order_relaxed);
+
+  HDWP batch = BeginDeferWindowPos(static_cast<int>(moves.size()));
+  for (const Move& move : moves) {
+    if (!batch) break;
+    const RECT& f = move.change->frame;
+    // DeferWindowPos frees the batch on failure and returns null.
+    batch = DeferWindowPos(batch, move.change->hwnd, nullptr, f.left, f.top,
+                           f.right - f.left, f.bottom - f.top, move.flags);
+  }
+  if (batch && EndDeferWindowPos(batch)) {
+    Metrics::Instance().RecordWindowPosBatch(moves.size());
+    trace::FrameBatchApplied(changes.size(), moves.size(), true);
+    return;
+  }
+
+  FP_LOG("Frame", "DeferWindowPos failed; applying frames individually");
+  stats.fallbacks.fetch_add(1, std::memory_order_relaxed);
+  for (const Move& move : moves) {
+    const RECT& f = move.change->frame;
+    SetWindowPos(move.change->hwnd, nullptr, f.left, f.top, f.right - f.left,
+                 f.bottom - f.top, move.flags);
+    Metrics::Instance().RecordWindowPos();
+  }
+  trace::FrameBatchApplied(changes.size(), moves.size(), false);
+}
+
+bool FrameBatch::Request(const WindowHandle* handles, const RECT* frames,
+                         size_t count) {
+  auto& store = WindowStore::Instance();
+  for (size_t i = 0; i < count; ++i) {
+    if (!store.Get(handles[i])) return false;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < count; ++i) {
+      bool replaced = false;
+      for (Pending& pending : pending_) {
+        if (pending.handle != handles[i]) continue;
+        pending.frame = frames[i];
+        replaced = true;
+        break;
+      }
+      if (!replaced) pending_.push_back(Pending{handles[i], frames[i]});
+    }
+  }
+  ScheduleApply();
+  return true;
+}
+
+void FrameBatch::ScheduleApply() {
+  if (apply_posted_.exchange(true, std::memory_order_acq_rel)) return;
+  if (!PostMessage(message_window_, kApplyMessage, 0, 0)) {
+    apply_posted_.store(false, std::memory_order_release);
+  }
+}
+
+// Platform thread.
+void FrameBatch::ApplyPending() {
+  // Clear first: a request racing this apply posts again rather than being
+  // lost.
+  apply_posted_.store(false, std::memory_order_release);
+  std::vector<Pending> pending;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending.swap(pending_);
+  }
+
+  // Windows destroyed since the request are skipped.
+  auto& store = WindowStore::Instance();
+  std::vector<Change> changes;
+  changes.reserve(pending.size());
+  for (const Pending& entry : pending) {
+    PaletteWindow* window = store.Get(entry.handle);
+    if (window && window->hwnd) {
+      changes.push_back(Change{window->hwnd, entry.frame});
+    }
+  }
+  Apply(changes);
+}
+
+// static
+LRESULT CALLBACK FrameBatch::MessageWndProc(HWND hwnd, UINT message,
+                                            WPARAM wparam, LPARAM lparam) {
+  if (message == kApplyMessage) {
+    auto* batch = reinterpret_cast<FrameBatch*>(
+        GetWindowLongPtr(hwnd, GWLP_USERDATA));
+    if (batch) batch->ApplyPending();
+    return 0;
+  }
+  return DefWindowProc(hwnd, message, wparam, lparam);
+}
+
+}  // namespace floating_palette
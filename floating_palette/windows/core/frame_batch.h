@@ -0,0 +1,83 @@
+#pragma once
+
+#include <windows.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "window_store.h"
+
+namespace floating_palette {
+
+/// Counters for batched frame changes.
+struct FrameBatchStats {
+  /// Batches applied (one window-manager transaction each).
+  std::atomic<uint64_t> batches{0};
+  /// Windows repositioned across all batches.
+  std::atomic<uint64_t> windows{0};
+  /// Entries skipped because the window was already at that frame.
+  std::atomic<uint64_t> unchanged{0};
+  /// Batches that fell back to one SetWindowPos per window.
+  std::atomic<uint64_t> fallbacks{0};
+};
+
+/// Applies a whole arrangement of palette frames in one
+/// BeginDeferWindowPos/EndDeferWindowPos transaction, so the window manager
+/// moves every window together and DWM composes the layout once instead of
+/// once per palette (no intermediate, half-moved frames on screen).
+///
+/// Channel commands run on the platform thread and call Apply directly.
+/// FFI requests arrive from the Dart UI thread; they are recorded and
+/// applied on the platform thread by a posted message, and a window
+/// requested again before that keeps only its latest frame.
+class FrameBatch {
+ public:
+  /// A target frame for one window, in physical screen pixels.
+  struct Change {
+    HWND hwnd;
+    RECT frame;
+  };
+
+  /// First use must be on the platform thread (see the plugin ctor).
+  static FrameBatch& Instance();
+
+  FrameBatch(const FrameBatch&) = delete;
+  FrameBatch& operator=(const FrameBatch&) = delete;
+
+  /// Move and size every window in `changes` at once. Windows already at
+  /// their target frame are left alone. Platform thread only.
+  static void Apply(const std::vector<Change>& changes);
+
+  /// Record physical frames for `count` windows and queue one apply.
+  /// All-or-nothing: returns false, recording nothing, if any handle is
+  /// stale. Any thread.
+  bool Request(const WindowHandle* handles, const RECT* frames, size_t count);
+
+  static FrameBatchStats& Stats();
+
+ private:
+  static constexpr UINT kApplyMessage = WM_APP + 7;
+
+  struct Pending {
+    WindowHandle handle;
+    RECT frame;
+  };
+
+  FrameBatch();
+
+  void ScheduleApply();
+  void ApplyPending();
+
+  static LRESULT CALLBACK MessageWndProc(HWND hwnd, UINT message,
+                                         WPARAM wparam, LPARAM lparam);
+
+  HWND message_window_ = nullptr;
+  std::mutex mutex_;
+  std::vector<Pending> pending_;
+  std::atomic<bool> apply_posted_{false};
+};
+
+}  // namespace floating_palette
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <windows.h>
+
+#include <atomic>
+#include <cstdint>
+
+namespace floating_palette {
+
+/// A palette's frame as of its last move, resize or DPI change.
+struct FrameSnapshot {
+  /// Screen rect in physical pixels (what FFI geometry reports).
+  RECT physical = {};
+  /// Logical frame (physical / DPI scale), what channels report.
+  double x = 0;
+  double y = 0;
+  double width = 0;
+  double height = 0;
+  UINT dpi = 96;
+};
+
+/// Seqlock-protected frame cache for one palette window.
+///
+/// The panel's window procedure refreshes it on WM_WINDOWPOSCHANGED and
+/// when it applies a DPI change (platform thread, the only writer).
+/// Readers on any thread get a consistent snapshot from plain loads,
+/// without GetWindowRect, GetDpiForWindow or a unit conversion per query;
+/// a reader that overlaps a write just retries.
+class FrameCache {
+ public:
+  /// Re-read the window's rect and DPI. Platform thread only.
+  void Refresh(HWND hwnd) {
+    if (hwnd) Refresh(hwnd, GetDpiForWindow(hwnd));
+  }
+
+  /// Re-read the window's rect, at the DPI its content is laid out for.
+  /// Platform thread only.
+  void Refresh(HWND hwnd, UINT dpi) {
+    RECT rect;
+    if (!hwnd || !GetWindowRect(hwnd, &rect)) return;
+    Store(rect, dpi);
+  }
+
+  /// Platform thread only.
+  void Store(const RECT& physical, UINT dpi) {
+    if (dpi == 0) dpi = 96;
+    const double scale = dpi / 96.0;
+    uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    left_.store(physical.left, std::memory_order_relaxed);
+    top_.store(physical.top, std::memory_order_relaxed);
+    right_.store(physical.right, std::memory_order_relaxed);
+    bottom_.store(physical.bottom, std::memory_order_relaxed);
+    x_.store(physical.left / scale, std::memory_order_relaxed);
+    y_.store(physical.top / scale, std::memory_order_relaxed);
+    width_.store((physical.right - physical.left) / scale,
+                 std::memory_order_relaxed);
+    height_.store((physical.bottom - physical.top) / scale,
+                  std::memory_order_relaxed);
+    dpi_.store(dpi, std::memory_order_relaxed);
+    sequence_.store(sequence + 2, std::memory_order_release);
+  }
+
+  /// Any thread. False until the first Store.
+  bool Load(FrameSnapshot* out) const {
+    while (true) {
+      uint32_t before = sequence_.load(std::memory_order_acquire);
+      if (before == 0) return false;
+      if (before & 1) {
+        YieldProcessor();
+        continue;
+      }
+      out->physical.left = left_.load(std::memory_order_relaxed);
+      out->physical.top = top_.load(std::memory_order_relaxed);
+      out->physical.right = right_.load(std::memory_order_relaxed);
+      out->physical.bottom = bottom_.load(std::memory_order_relaxed);
+      out->x = x_.load(std::memory_order_relaxed);
+      out->y = y_.load(std::memory_order_relaxed);
+      out->width = width_.load(std::memory_order_relaxed);
+      out->height = height_.load(std::memory_order_relaxed);
+      out->dpi = dpi_.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (sequence_.load(std::memory_order_relaxed) == before) return true;
+    }
+  }
+
+ private:
+  /// Odd while a write is in progress; 0 until the first.
+  std::atomic<uint32_t> sequence_{0};
+  std::atomic<LONG> left_{0};
+  std::atomic<LONG> top_{0};
+  std::atomic<LONG> right_{0};
+  std::atomic<LONG> bottom_{0};
+  std::atomic<double> x_{0};
+  std::atomic<double> y_{0};
+  std::atomic<double> width_{0};
+  std::atomic<double> height_{0};
+  std::atomic<UINT> dpi_{96};
+};
+
+}  // namespace floating_palette
@@ -0,0 +1,287 @@
+#include "glass_animation_driver.h"
+
+#include <dwmapi.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+#include "animation_curve.h"
+#include "clock.h"
+#include "logger.h"
+
+namespace floating_palette {
+
+namespace {
+
+constexpr wchar_t kGlassAnimationClassName[] = L"FloatingPaletteGlassAnimation";
+
+// Fallback frame interval when DwmFlush fails (composition unavailable).
+constexpr DWORD kFallbackFrameMs = 16;
+
+// Single 8-byte load with acquire ordering. The id fields sit at offsets 0
+// and 72 of a heap block, so they are naturally aligned despite the packing.
+uint64_t LoadId(const GlassAnimationBuffer* buffer, size_t offset) {
+  uint64_t value = *reinterpret_cast<const volatile uint64_t*>(
+      reinterpret_cast<const char*>(buffer) + offset);
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return value;
+}
+
+AnimationCurve CurveFromBuffer(uint8_t curve_type) {
+  // GlassAnimationCurve values; anything else falls back to the Dart default.
+  if (curve_type <= static_cast<uint8_t>(AnimationCurve::kEaseInOut)) {
+    return static_cast<AnimationCurve>(curve_type);
+  }
+  return AnimationCurve::kEaseOutCubic;
+}
+
+}  // namespace
+
+// static
+GlassAnimationDriver& GlassAnimationDriver::Instance() {
+  // Never destroyed: joining the tick thread from static destruction (DLL
+  // unload, under the loader lock) would deadlock. First use must be on the
+  // platform thread, which owns the delivery window (see the plugin ctor).
+  static GlassAnimationDriver* driver = new GlassAnimationDriver();
+  return *driver;
+}
+
+GlassAnimationDriver::GlassAnimationDriver() {
+  WNDCLASSEXW wc = {};
+  wc.cbSize = sizeof(wc);
+  wc.lpfnWndProc = MessageWndProc;
+  wc.hInstance = GetModuleHandle(nullptr);
+  wc.lpszClassName = kGlassAnimationClassName;
+  RegisterClassExW(&wc);
+
+  message_window_ = CreateWindowExW(0, kGlassAnimationClassName, L"", 0, 0, 0,
+                                    0, 0, HWND_MESSAGE, nullptr,
+                                    GetModuleHandle(nullptr), nullptr);
+  SetWindowLongPtr(message_window_, GWLP_USERDATA,
+                   reinterpret_cast<LONG_PTR>(this));
+
+  tick_thread_ = std::thread(&GlassAnimationDriver::TickLoop, this);
+}
+
+GlassAnimationDriver::~GlassAnimationDriver() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+  }
+  wake_.notify_one();
+  if (tick_thread_.joinable()) tick_thread_.join();
+
+  if (message_window_) {
+    SetWindowLongPtr(message_window_, GWLP_USERDATA, 0);
+    DestroyWindow(message_window_);
+  }
+}
+
+GlassAnimationBuffer* GlassAnimationDriver::CreateBuffer(
+    const std::string& window_id, int32_t layer_id) {
+  auto buffer = std::make_unique<GlassAnimationBuffer>();
+  std::memset(buffer.get(), 0, sizeof(GlassAnimationBuffer));
+  GlassAnimationBuffer* ptr = buffer.get();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry& entry = buffers_[{window_id, layer_id}];
+    entry = Entry{};
+    entry.buffer = std::move(buffer);
+  }
+  wake_.notify_one();
+  FP_LOG("Glass", "animation buffer created ", window_id, " layer ",
+         layer_id);
+  return ptr;
+}
+
+void GlassAnimationDriver::DestroyBuffer(const std::string& window_id,
+                                         int32_t layer_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  buffers_.erase({window_id, layer_id});
+}
+
+void GlassAnimationDriver::DestroyAllBuffers(const std::string& window_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = buffers_.lower_bound({window_id, INT32_MIN});
+  while (it != buffers_.end() && it->first.first == window_id) {
+    it = buffers_.erase(it);
+  }
+}
+
+bool GlassAnimationDriver::HasBuffer(const std::string& window_id,
+                                     int32_t layer_id) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return buffers_.count({window_id, layer_id}) > 0;
+}
+
+size_t GlassAnimationDriver::buffer_count() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return buffers_.size();
+}
+
+std::optional<AnimatedBounds> GlassAnimationDriver::ReadAnimatedBounds(
+    const std::string& window_id, int32_t layer_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = buffers_.find({window_id, layer_id});
+  if (it == buffers_.end()) return std::nullopt;
+  return Read(it->second);
+}
+
+void GlassAnimationDriver::SetFrameObserver(FrameObserver observer) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  frame_observer_ = std::move(observer);
+}
+
+void GlassAnimationDriver::SetFrameObserverActive(bool active) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (frame_observer_active_ == active) return;
+    frame_observer_active_ = active;
+  }
+  if (active) wake_.notify_one();
+}
+
+void GlassAnimationDriver::SetListener(BoundsListener listener) {
+  listener_ = std::move(listener);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    has_listener_ = static_cast<bool>(listener_);
+  }
+  wake_.notify_one();
+}
+
+// Caller holds mutex_.
+std::optional<AnimatedBounds> GlassAnimationDriver::Read(Entry& entry) {
+  stats_.reads.fetch_add(1, std::memory_order_relaxed);
+  const GlassAnimationBuffer* shared = entry.buffer.get();
+
+  // Dart writes animationIdPost, then the payload, then animationId. Read in
+  // the opposite order so a write that starts mid-copy shows up as a
+  // mismatch.
+  uint64_t pre_id =
+      LoadId(shared, offsetof(GlassAnimationBuffer, animation_id));
+  GlassAnimationBuffer copy;
+  std::memcpy(&copy, shared, sizeof(copy));
+  std::atomic_thread_fence(std::memory_order_acquire);
+  uint64_t post_id =
+      LoadId(shared, offsetof(GlassAnimationBuffer, animation_id_post));
+
+  if (pre_id != post_id || pre_id == 0) {
+    if (pre_id != post_id) {
+      stats_.torn_reads.fetch_add(1, std::memory_order_relaxed);
+    }
+    // No consistent data this frame; hold the last good bounds.
+    if (!entry.last_bounds) return std::nullopt;
+    AnimatedBounds held = *entry.last_bounds;
+    held.is_complete = true;
+    return held;
+  }
+  entry.last_id = pre_id;
+
+  AnimatedBounds bounds;
+  bounds.corner_radius = copy.corner_radius;
+  if (!copy.is_animating) {
+    bounds.x = copy.target_x;
+    bounds.y = copy.target_y;
+    bounds.width = copy.target_width;
+    bounds.height = copy.target_height;
+    bounds.is_complete = true;
+    entry.last_bounds = bounds;
+    return bounds;
+  }
+
+  double progress = copy.duration > 0
+                        ? (MonotonicSeconds() - copy.start_time) / copy.duration
+                        : 1.0;
+  bounds.is_complete = progress >= 1.0;
+  double t = ApplyAnimationCurve(CurveFromBuffer(copy.curve_type),
+                                 std::clamp(progress, 0.0, 1.0));
+  auto lerp = [t](float from, float to) {
+    return static_cast<float>(from + (to - from) * t);
+  };
+  bounds.x = lerp(copy.start_x, copy.target_x);
+  bounds.y = lerp(copy.start_y, copy.target_y);
+  bounds.width = lerp(copy.start_width, copy.target_width);
+  bounds.height = lerp(copy.start_height, copy.target_height);
+  entry.last_bounds = bounds;
+  return bounds;
+}
+
+void GlassAnimationDriver::TickLoop() {
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      wake_.wait(lock, [this] {
+        return (has_listener_ && !buffers_.empty()) ||
+               frame_observer_active_ || shutdown_;
+      });
+      if (shutdown_) return;
+    }
+
+    // Dart writes without calling in, so poll once per composition while
+    // anything has a consumer.
+    if (FAILED(DwmFlush())) Sleep(kFallbackFrameMs);
+
+    bool queued = false;
+    bool observe = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      observe = frame_observer_active_ && frame_observer_;
+      for (auto& [key, entry] : buffers_) {
+        if (!has_listener_) break;
+        auto bounds = Read(entry);
+        if (!bounds || bounds == entry.delivered) continue;
+        entry.delivered = bounds;
+        // Replace a still-undelivered update for the same layer.
+        auto pending = std::find_if(
+            pending_.begin(), pending_.end(),
+            [&key = key](const auto& item) { return item.first == key; });
+        if (pending != pending_.end()) {
+          pending->second = *bounds;
+        } else {
+          pending_.emplace_back(key, *bounds);
+        }
+        queued = true;
+      }
+    }
+
+    if (queued && !deliver_posted_.exchange(true, std::memory_order_acq_rel)) {
+      if (!PostMessage(message_window_, kDeliverMessage, 0, 0)) {
+        deliver_posted_.store(false, std::memory_order_release);
+      }
+    }
+    // Outside the lock: the observer takes its own locks. frame_observer_
+    // is only assigned before activation, so reading it here is safe.
+    if (observe) frame_observer_();
+  }
+}
+
+void GlassAnimationDriver::Deliver() {
+  deliver_posted_.store(false, std::memory_order_release);
+  std::vector<std::pair<Key, AnimatedBounds>> updates;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    updates.swap(pending_);
+  }
+  if (!listener_) return;
+  for (const auto& [key, bounds] : updates) {
+    stats_.delivered.fetch_add(1, std::memory_order_relaxed);
+    listener_(key.first, key.second, bounds);
+  }
+}
+
+// static
+LRESULT CALLBACK GlassAnimationDriver::MessageWndProc(HWND hwnd, UINT message,
+                                                      WPARAM wparam,
+                                                      LPARAM lparam) {
+  if (message == kDeliverMessage) {
+    auto* driver = reinterpret_cast<GlassAnimationDriver*>(
+        GetWindowLongPtr(hwnd, GWLP_USERDATA));
+    if (driver) driver->Deliver();
+    return 0;
+  }
+  return DefWindowProc(hwnd, message, wparam, lparam);
+}
+
+}  // namespace floating_palette
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <windows.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace floating_palette {
+
+/// Memory layout of the GlassAnimationBuffer in src/ffi_interface.h (packed,
+/// 80 bytes; see glass_animation_bridge.dart). Dart writes it, native reads.
+#pragma pack(push, 1)
+struct GlassAnimationBuffer {
+  uint64_t animation_id;
+  uint8_t is_animating;
+  uint8_t curve_type;
+  uint8_t padding[2];
+  float start_x;
+  float start_y;
+  float start_width;
+  float start_height;
+  float target_x;
+  float target_y;
+  float target_width;
+  float target_height;
+  float corner_radius;
+  double start_time;
+  double duration;
+  float window_height;
+  uint8_t padding2[4];
+  uint64_t animation_id_post;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(GlassAnimationBuffer) == 80,
+              "GlassAnimationBuffer must match the Dart @Packed(1) layout");
+static_assert(offsetof(GlassAnimationBuffer, start_time) == 48,
+              "GlassAnimationBuffer must match the Dart @Packed(1) layout");
+static_assert(offsetof(GlassAnimationBuffer, animation_id_post) == 72,
+              "GlassAnimationBuffer must match the Dart @Packed(1) layout");
+
+/// Bounds resolved from an animation buffer, in Flutter logical pixels
+/// relative to the window's client area (Y=0 at top).
+struct AnimatedBounds {
+  float x = 0;
+  float y = 0;
+  float width = 0;
+  float height = 0;
+  float corner_radius = 0;
+  /// Animation finished (or static bounds); consumers can cache.
+  bool is_complete = true;
+
+  bool operator==(const AnimatedBounds& other) const {
+    return x == other.x && y == other.y && width == other.width &&
+           height == other.height && corner_radius == other.corner_radius &&
+           is_complete == other.is_complete;
+  }
+  bool operator!=(const AnimatedBounds& other) const {
+    return !(*this == other);
+  }
+};
+
+/// Counters for the animation buffer reader.
+struct GlassAnimationStats {
+  /// Buffer reads on the compositor tick.
+  std::atomic<uint64_t> reads{0};
+  /// Reads discarded because Dart was mid-write (animationId !=
+  /// animationIdPost).
+  std::atomic<uint64_t> torn_reads{0};
+  /// Bound changes delivered to the listener.
+  std::atomic<uint64_t> delivered{0};
+};
+
+/// Native reader for GlassAnimationBuffer (Windows port of
+/// GlassAnimationDriver.swift).
+///
+/// Dart writes an animation's start/target bounds once; the driver
+/// interpolates them on the compositor tick so glass bounds follow the
+/// Flutter content with no per-frame FFI. A worker thread waits on
+/// DwmFlush() while any buffer exists and a listener is set (or a frame
+/// observer is active), and sleeps otherwise. Reads are seqlock-style: animationId, payload,
+/// animationIdPost; a mismatch means Dart was mid-write and the frame is
+/// skipped (and counted).
+///
+/// Changed bounds are handed to the listener on the platform thread, at
+/// most once per tick per buffer.
+class GlassAnimationDriver {
+ public:
+  /// Called on the platform thread with the latest bounds for a layer.
+  using BoundsListener = std::function<void(const std::string& window_id,
+                                            int32_t layer_id,
+                                            const AnimatedBounds& bounds)>;
+
+  static GlassAnimationDriver& Instance();
+
+  GlassAnimationDriver(const GlassAnimationDriver&) = delete;
+  GlassAnimationDriver& operator=(const GlassAnimationDriver&) = delete;
+
+  /// Allocate a zeroed buffer for (window, layer), replacing any existing
+  /// one. The pointer stays valid until DestroyBuffer.
+  GlassAnimationBuffer* CreateBuffer(const std::string& window_id,
+                                     int32_t layer_id);
+  void DestroyBuffer(const std::string& window_id, int32_t layer_id);
+  void DestroyAllBuffers(const std::string& window_id);
+  bool HasBuffer(const std::string& window_id, int32_t layer_id) const;
+
+  /// Current bounds for a layer: interpolated while animating, the target
+  /// when static, or the last good bounds on a torn read. nullopt if the
+  /// buffer doesn't exist or Dart hasn't written it yet. Any thread.
+  std::optional<AnimatedBounds> ReadAnimatedBounds(const std::string& window_id,
+                                                   int32_t layer_id);
+
+  /// Platform thread only.
+  void SetListener(BoundsListener listener);
+
+  /// Extra work for the tick thread, run once per composition while
+  /// active, so other shared-buffer readers (glass path buffers) poll on
+  /// the same tick instead of running their own. Set once, before the first
+  /// SetFrameObserverActive(true).
+  using FrameObserver = std::function<void()>;
+  void SetFrameObserver(FrameObserver observer);
+  /// Any thread.
+  void SetFrameObserverActive(bool active);
+
+  const GlassAnimationStats& Stats() const { return stats_; }
+  size_t buffer_count() const;
+
+ private:
+  static constexpr UINT kDeliverMessage = WM_APP + 5;
+
+  using Key = std::pair<std::string, int32_t>;
+
+  struct Entry {
+    std::unique_ptr<GlassAnimationBuffer> buffer;
+    uint64_t last_id = 0;
+    std::optional<AnimatedBounds> last_bounds;
+    /// Last bounds handed to the listener (tick thread only).
+    std::optional<AnimatedBounds> delivered;
+  };
+
+  GlassAnimationDriver();
+  ~GlassAnimationDriver();
+
+  std::optional<AnimatedBounds> Read(Entry& entry);
+  void TickLoop();
+  void Deliver();
+
+  static LRESULT CALLBACK MessageWndProc(HWND hwnd, UINT message,
+                                         WPARAM wparam, LPARAM lparam);
+
+  mutable std::mutex mutex_;
+  std::condition_variable wake_;
+  std::map<Key, Entry> buffers_;
+  std::vector<std::pair<Key, AnimatedBounds>> pending_;
+  bool shutdown_ = false;
+
+  BoundsListener listener_;
+  bool has_listener_ = false;
+  FrameObserver frame_observer_;
+  bool frame_observer_active_ = false;
+  std::atomic<bool> deliver_posted_{false};
+  HWND message_window_ = nullptr;
+  std::thread tick_thread_;
+  GlassAnimationStats stats_;
+};
+
+}  // namespace floating_palette
@@ -0,0 +1,566 @@
+#include "glass_backdrop.h"
+
+#include <dwmapi.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "logger.h"
+#include "window_store.h"
+
+namespace floating_palette {
+
+namespace {
+
+constexpr wchar_t kGlassBackdropClassName[] = L"FloatingPaletteGlassBackdrop";
+
+// Line segments per quadratic/cubic when flattening a path into a region.
+constexpr int kCurveSegments = 16;
+
+uint64_t LoadFrameId(const GlassPathBuffer* buffer, size_t offset) {
+  // frameId sits at offset 0 of a heap block (naturally aligned);
+  // frameIdPost at 9236 is only 4-aligned, so go through memcpy.
+  uint64_t value;
+  std::memcpy(&value, reinterpret_cast<const char*>(buffer) + offset,
+              sizeof(value));
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return value;
+}
+
+// Normalized path coordinates are quantized to 1/65536 of the bounding box
+// so float noise from translating the points doesn't defeat the shape match.
+constexpr double kShapeQuantization = 65536.0;
+
+// FNV-1a, continuing from `hash` (see HashCommand).
+uint64_t HashBytes(uint64_t hash, const void* data, size_t size) {
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+// Material indices follow GlassMaskService.swift
+// (hudWindow, sidebar, popover, menu, sheet).
+DWM_SYSTEMBACKDROP_TYPE BackdropForMaterial(int32_t material) {
+  switch (material) {
+    case 1:  // sidebar
+      return DWMSBT_MAINWINDOW;  // Mica
+    case 4:  // sheet
+      return DWMSBT_TABBEDWINDOW;  // Mica Alt
+    default:  // hudWindow, popover, menu
+      return DWMSBT_TRANSIENTWINDOW;  // Acrylic
+  }
+}
+
+}  // namespace
+
+// static
+GlassBackdrop& GlassBackdrop::Instance() {
+  // Never destroyed, like GlassAnimationDriver; first use must be on the
+  // platform thread (see the plugin ctor).
+  static GlassBackdrop* backdrop = new GlassBackdrop();
+  return *backdrop;
+}
+
+GlassBackdrop::GlassBackdrop() {
+  WNDCLASSEXW wc = {};
+  wc.cbSize = sizeof(wc);
+  wc.lpfnWndProc = MessageWndProc;
+  wc.hInstance = GetModuleHandle(nullptr);
+  wc.lpszClassName = kGlassBackdropClassName;
+  RegisterClassExW(&wc);
+
+  message_window_ = CreateWindowExW(0, kGlassBackdropClassName, L"", 0, 0, 0,
+                                    0, 0, HWND_MESSAGE, nullptr,
+                                    GetModuleHandle(nullptr), nullptr);
+  SetWindowLongPtr(message_window_, GWLP_USERDATA,
+                   reinterpret_cast<LONG_PTR>(this));
+
+  auto& driver = GlassAnimationDriver::Instance();
+  driver.SetFrameObserver([this] { PollPathBuffers(); });
+  driver.SetListener([this](const std::string& window_id, int32_t layer_id,
+                            const AnimatedBounds& bounds) {
+    OnAnimatedBounds(window_id, layer_id, bounds);
+  });
+}
+
+// static
+bool GlassBackdrop::IsSupported() {
+  static const bool supported = [] {
+    // GetVersionEx is manifest-dependent; RtlGetVersion reports the real
+    // build.
+    using RtlGetVersionFn = LONG(WINAPI*)(OSVERSIONINFOW*);
+    auto rtl_get_version = reinterpret_cast<RtlGetVersionFn>(
+        GetProcAddress(GetModuleHandleW(L"ntdll.dll"), "RtlGetVersion"));
+    if (!rtl_get_version) return false;
+    OSVERSIONINFOW info = {};
+    info.dwOSVersionInfoSize = sizeof(info);
+    if (rtl_get_version(&info) != 0) return false;
+    return info.dwMajorVersion > 10 ||
+           (info.dwMajorVersion == 10 && info.dwBuildNumber >= 22621);
+  }();
+  return supported;
+}
+
+GlassPathBuffer* GlassBackdrop::CreateBuffer(const std::string& window_id,
+                                             int32_t layer_id) {
+  auto buffer = std::make_unique<GlassPathBuffer>();
+  std::memset(buffer.get(), 0, sizeof(GlassPathBuffer));
+  GlassPathBuffer* ptr = buffer.get();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  Layer& layer = windows_[window_id].layers[layer_id];
+  layer.buffer = std::move(buffer);
+  layer.seen_frame_id = 0;
+  layer.built_frame_id = 0;
+  layer.path_dirty = false;
+  layer.shape.clear();
+  layer.path_hash = 0;
+  layer.shape_hash = 0;
+  layer.unit_shape.clear();
+  UpdateTickLocked();
+  return ptr;
+}
+
+void GlassBackdrop::DestroyBuffer(const std::string& window_id,
+                                  int32_t layer_id) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = windows_.find(window_id);
+    if (it == windows_.end()) return;
+    it->second.layers.erase(layer_id);
+    it->second.clip_dirty = true;
+    UpdateTickLocked();
+  }
+  ScheduleApply();
+}
+
+void GlassBackdrop::SetEnabled(const std::string& window_id, bool enabled) {
+  FP_LOG("Glass", enabled ? "enable " : "disable ", window_id);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    WindowGlass& glass = windows_[window_id];
+    if (glass.enabled == enabled) return;
+    glass.enabled = enabled;
+    glass.style_dirty = true;
+    glass.clip_dirty = true;
+    // Re-read whatever Dart already published.
+    for (auto& [layer_id, layer] : glass.layers) layer.seen_frame_id = 0;
+    UpdateTickLocked();
+  }
+  ScheduleApply();
+}
+
+void GlassBackdrop::SetMaterial(const std::string& window_id,
+                                int32_t layer_id, int32_t material) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    WindowGlass& glass = windows_[window_id];
+    glass.layers[layer_id].material = material;
+    glass.style_dirty = true;
+  }
+  ScheduleApply();
+}
+
+void GlassBackdrop::SetDark(const std::string& window_id, int32_t layer_id,
+                            bool is_dark) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    WindowGlass& glass = windows_[window_id];
+    glass.layers[layer_id].dark = is_dark;
+    glass.style_dirty = true;
+  }
+  ScheduleApply();
+}
+
+void GlassBackdrop::SetTintOpacity(const std::string& window_id,
+                                   int32_t layer_id, float opacity,
+                                   float corner_radius) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Layer& layer = windows_[window_id].layers[layer_id];
+  layer.tint_opacity = opacity;
+  layer.tint_corner_radius = corner_radius;
+}
+
+void GlassBackdrop::Cleanup(const std::string& window_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  windows_.erase(window_id);
+  UpdateTickLocked();
+}
+
+// Caller holds mutex_.
+void GlassBackdrop::UpdateTickLocked() {
+  bool needed = false;
+  for (const auto& [id, glass] : windows_) {
+    if (!glass.enabled) continue;
+    for (const auto& [layer_id, layer] : glass.layers) {
+      if (layer.buffer) {
+        needed = true;
+        break;
+      }
+    }
+    if (needed) break;
+  }
+  GlassAnimationDriver::Instance().SetFrameObserverActive(needed);
+}
+
+// Tick thread. Only compares ids; the path itself is copied once, on the
+// platform thread, when it changed.
+void GlassBackdrop::PollPathBuffers() {
+  bool changed = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& [id, glass] : windows_) {
+      if (!glass.enabled) continue;
+      for (auto& [layer_id, layer] : glass.layers) {
+        if (!layer.buffer) continue;
+        uint64_t pre_id =
+            LoadFrameId(layer.buffer.get(), offsetof(GlassPathBuffer, frame_id));
+        if (pre_id == 0 || pre_id == layer.seen_frame_id) continue;
+        uint64_t post_id = LoadFrameId(
+            layer.buffer.get(), offsetof(GlassPathBuffer, frame_id_post));
+        if (pre_id != post_id) {
+          stats_.torn_reads.fetch_add(1, std::memory_order_relaxed);
+          continue;  // Retry next tick.
+        }
+        layer.seen_frame_id = pre_id;
+        layer.path_dirty = true;
+        glass.paths_dirty = true;
+        changed = true;
+      }
+    }
+  }
+  if (changed) ScheduleApply();
+}
+
+void GlassBackdrop::OnAnimatedBounds(const std::string& window_id,
+                                     int32_t layer_id,
+                                     const AnimatedBounds& bounds) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = windows_.find(window_id);
+    if (it == windows_.end() || !it->second.enabled) return;
+    it->second.layers[layer_id].animated = bounds;
+    it->second.clip_dirty = true;
+  }
+  // Already on the platform thread; apply in this delivery.
+  ApplyPending();
+}
+
+void GlassBackdrop::ScheduleApply() {
+  if (apply_posted_.exchange(true, std::memory_order_acq_rel)) return;
+  if (!PostMessage(message_window_, kApplyMessage, 0, 0)) {
+    apply_posted_.store(false, std::memory_order_release);
+  }
+}
+
+// Platform thread.
+void GlassBackdrop::ApplyPending() {
+  apply_posted_.store(false, std::memory_order_release);
+  auto& store = WindowStore::Instance();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& [id, glass] : windows_) {
+    if (!glass.style_dirty && !glass.clip_dirty && !glass.paths_dirty) {
+      continue;
+    }
+    PaletteWindow* window = store.Get(id);
+    if (!window || !window->hwnd) continue;
+    if (glass.paths_dirty) {
+      glass.paths_dirty = false;
+      // A republish of the same geometry leaves the region alone.
+      if (UpdateShapes(glass)) glass.clip_dirty = true;
+    }
+    if (glass.style_dirty) {
+      glass.style_dirty = false;
+      ApplyStyle(*window, glass);
+    }
+    if (glass.clip_dirty) {
+      glass.clip_dirty = false;
+      ApplyClip(window->hwnd, id, glass);
+    }
+  }
+}
+
+// Platform thread, caller holds mutex_. Copies republished path buffers and
+// refreshes the layers' cached shapes; returns whether any shape changed.
+bool GlassBackdrop::UpdateShapes(WindowGlass& glass) {
+  bool changed = false;
+  for (auto& [layer_id, layer] : glass.layers) {
+    if (!layer.path_dirty || !layer.buffer) continue;
+    layer.path_dirty = false;
+    uint64_t pre_id =
+        LoadFrameId(layer.buffer.get(), offsetof(GlassPathBuffer, frame_id));
+    GlassPathBuffer copy;
+    std::memcpy(&copy, layer.buffer.get(), sizeof(copy));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t post_id = LoadFrameId(layer.buffer.get(),
+                                   offsetof(GlassPathBuffer, frame_id_post));
+    if (pre_id != post_id) {
+      // Dart started the next publish mid-copy; the tick will pick it up.
+      stats_.torn_reads.fetch_add(1, std::memory_order_relaxed);
+      layer.seen_frame_id = 0;
+      continue;
+    }
+
+    PathKey key = HashPath(copy);
+    if (layer.built_frame_id != 0 && key.path_hash == layer.path_hash) {
+      layer.built_frame_id = pre_id;
+      stats_.identical_paths.fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+
+    if (layer.built_frame_id != 0 && key.extent > 0 &&
+        key.shape_hash == layer.shape_hash && !layer.unit_shape.empty()) {
+      // Same shape, moved or uniformly scaled: flattening is affine, so
+      // mapping the cached unit flattening is exact.
+      layer.shape = layer.unit_shape;
+      for (auto& polygon : layer.shape) {
+        for (auto& [x, y] : polygon) {
+          x = key.origin_x + x * key.extent;
+          y = key.origin_y + y * key.extent;
+        }
+      }
+      stats_.transformed_paths.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      std::vector<Polygon> shape;
+      if (!FlattenPath(copy, &shape)) continue;
+      layer.shape = std::move(shape);
+      layer.unit_shape.clear();
+      if (key.extent > 0) {
+        layer.unit_shape = layer.shape;
+        for (auto& polygon : layer.unit_shape) {
+          for (auto& [x, y] : polygon) {
+            x = (x - key.origin_x) / key.extent;
+            y = (y - key.origin_y) / key.extent;
+          }
+        }
+      }
+    }
+    layer.path_hash = key.path_hash;
+    layer.shape_hash = key.shape_hash;
+    layer.built_frame_id = pre_id;
+    stats_.path_updates.fetch_add(1, std::memory_order_relaxed);
+    changed = true;
+  }
+  return changed;
+}
+
+void GlassBackdrop::ApplyStyle(PaletteWindow& window,
+                               const WindowGlass& glass) {
+  // One backdrop per HWND: the lowest layer's material and appearance win.
+  int32_t material = 0;
+  bool dark = false;
+  if (!glass.layers.empty()) {
+    material = glass.layers.begin()->second.material;
+    dark = glass.layers.begin()->second.dark;
+  }
+
+  // Written through the window's DWM cache so a republish with the same
+  // style costs nothing. Glass off hands margins and backdrop back to the
+  // appearance the palette asked for.
+  HWND hwnd = window.hwnd;
+  window.dwm.set_glass(glass.enabled);
+  window.dwm.SetDarkMode(hwnd, dark);
+  if (!glass.enabled) {
+    window.dwm.Apply(hwnd, window.appearance);
+    return;
+  }
+  // Extending the frame over the whole client area lets DWM draw the
+  // backdrop behind Flutter's transparent pixels.
+  window.dwm.SetFrameMargins(hwnd, MARGINS{-1, -1, -1, -1});
+  window.dwm.SetBackdrop(hwnd, BackdropForMaterial(material));
+}
+
+void GlassBackdrop::ApplyClip(HWND hwnd, const std::string& window_id,
+                              WindowGlass& glass) {
+  if (!glass.enabled) {
+    SetWindowRgn(hwnd, nullptr, TRUE);
+    return;
+  }
+
+  double scale = GetDpiForWindow(hwnd) / 96.0;
+  auto px = [scale](float value) {
+    return static_cast<LONG>(std::lround(value * scale));
+  };
+
+  HRGN region = nullptr;
+  auto add = [&region](HRGN part) {
+    if (!part) return;
+    if (!region) {
+      region = part;
+      return;
+    }
+    CombineRgn(region, region, part, RGN_OR);
+    DeleteObject(part);
+  };
+
+  auto& driver = GlassAnimationDriver::Instance();
+  std::vector<POINT> points;
+  std::vector<INT> counts;
+  for (const auto& [layer_id, layer] : glass.layers) {
+    // Native animation takes priority over the published path, as on macOS.
+    if (layer.animated && driver.HasBuffer(window_id, layer_id)) {
+      const AnimatedBounds& b = *layer.animated;
+      LONG diameter = px(b.corner_radius * 2);
+      add(CreateRoundRectRgn(px(b.x), px(b.y), px(b.x + b.width),
+                             px(b.y + b.height), diameter, diameter));
+      continue;
+    }
+    if (layer.shape.empty()) continue;
+    points.clear();
+    counts.clear();
+    for (const auto& polygon : layer.shape) {
+      for (const auto& [x, y] : polygon) points.push_back({px(x), px(y)});
+      counts.push_back(static_cast<INT>(polygon.size()));
+    }
+    add(CreatePolyPolygonRgn(points.data(), counts.data(),
+                             static_cast<int>(counts.size()), WINDING));
+  }
+
+  // A null region (no geometry yet) leaves the whole window as glass. The
+  // system takes ownership of `region`.
+  SetWindowRgn(hwnd, region, TRUE);
+  stats_.region_rebuilds.fetch_add(1, std::memory_order_relaxed);
+}
+
+// static
+bool GlassBackdrop::FlattenPath(const GlassPathBuffer& buffer,
+                                std::vector<Polygon>* out) {
+  size_t command_count =
+      std::min<size_t>(buffer.command_count, GlassPathBuffer::kMaxCommands);
+  size_t float_count =
+      std::min<size_t>(static_cast<size_t>(buffer.point_count) * 2,
+                       GlassPathBuffer::kMaxFloats);
+  const float* p = buffer.points;
+  size_t index = 0;
+  Polygon current;
+  std::pair<float, float> pen{0.0f, 0.0f};
+
+  auto finish = [&] {
+    if (current.size() >= 3) out->push_back(std::move(current));
+    current.clear();
+  };
+
+  for (size_t i = 0; i < command_count; ++i) {
+    switch (buffer.commands[i]) {
+      case 0:  // moveTo
+        if (index + 2 > float_count) return !out->empty();
+        finish();
+        pen = {p[index], p[index + 1]};
+        current.push_back(pen);
+        index += 2;
+        break;
+      case 1:  // lineTo
+        if (index + 2 > float_count) return !out->empty();
+        pen = {p[index], p[index + 1]};
+        current.push_back(pen);
+        index += 2;
+        break;
+      case 2: {  // quadTo
+        if (index + 4 > float_count) return !out->empty();
+        float cx = p[index], cy = p[index + 1];
+        float x = p[index + 2], y = p[index + 3];
+        for (int s = 1; s <= kCurveSegments; ++s) {
+          float t = static_cast<float>(s) / kCurveSegments;
+          float u = 1.0f - t;
+          current.emplace_back(u * u * pen.first + 2 * u * t * cx + t * t * x,
+                               u * u * pen.second + 2 * u * t * cy + t * t * y);
+        }
+        pen = {x, y};
+        index += 4;
+        break;
+      }
+      case 3: {  // cubicTo
+        if (index + 6 > float_count) return !out->empty();
+        float c1x = p[index], c1y = p[index + 1];
+        float c2x = p[index + 2], c2y = p[index + 3];
+        float x = p[index + 4], y = p[index + 5];
+        for (int s = 1; s <= kCurveSegments; ++s) {
+          float t = static_cast<float>(s) / kCurveSegments;
+          float u = 1.0f - t;
+          float a = u * u * u, b = 3 * u * u * t, c = 3 * u * t * t,
+                d = t * t * t;
+          current.emplace_back(a * pen.first + b * c1x + c * c2x + d * x,
+                               a * pen.second + b * c1y + c * c2y + d * y);
+        }
+        pen = {x, y};
+        index += 6;
+        break;
+      }
+      case 4:  // close
+        if (!current.empty()) pen = current.front();
+        finish();
+        break;
+      default:
+        break;
+    }
+  }
+  finish();
+  return true;
+}
+
+// static
+GlassBackdrop::PathKey GlassBackdrop::HashPath(const GlassPathBuffer& buffer) {
+  size_t command_count =
+      std::min<size_t>(buffer.command_count, GlassPathBuffer::kMaxCommands);
+  size_t float_count =
+      std::min<size_t>(static_cast<size_t>(buffer.point_count) * 2,
+                       GlassPathBuffer::kMaxFloats);
+  const float* p = buffer.points;
+
+  uint64_t commands = HashBytes(14695981039346656037ull, buffer.commands,
+                                command_count);
+  PathKey key{};
+  key.path_hash = HashBytes(commands, p, float_count * sizeof(float));
+
+  if (float_count == 0) {
+    key.shape_hash = key.path_hash;
+    return key;
+  }
+  float min_x = p[0], max_x = p[0], min_y = p[1], max_y = p[1];
+  for (size_t i = 2; i + 1 < float_count; i += 2) {
+    min_x = std::min(min_x, p[i]);
+    max_x = std::max(max_x, p[i]);
+    min_y = std::min(min_y, p[i + 1]);
+    max_y = std::max(max_y, p[i + 1]);
+  }
+  key.origin_x = min_x;
+  key.origin_y = min_y;
+  key.extent = std::max(max_x - min_x, max_y - min_y);
+  if (!(key.extent > 0) || !std::isfinite(key.extent)) {
+    key.extent = 0;
+    key.shape_hash = key.path_hash;
+    return key;
+  }
+
+  uint64_t shape = commands;
+  for (size_t i = 0; i + 1 < float_count; i += 2) {
+    int32_t q[2] = {
+        static_cast<int32_t>(std::lround((p[i] - min_x) / key.extent *
+                                         kShapeQuantization)),
+        static_cast<int32_t>(std::lround((p[i + 1] - min_y) / key.extent *
+                                         kShapeQuantization)),
+    };
+    shape = HashBytes(shape, q, sizeof(q));
+  }
+  key.shape_hash = shape;
+  return key;
+}
+
+// static
+LRESULT CALLBACK GlassBackdrop::MessageWndProc(HWND hwnd, UINT message,
+                                               WPARAM wparam, LPARAM lparam) {
+  if (message == kApplyMessage) {
+    auto* backdrop = reinterpret_cast<GlassBackdrop*>(
+        GetWindowLongPtr(hwnd, GWLP_USERDATA));
+    if (backdrop) backdrop->ApplyPending();
+    return 0;
+  }
+  return DefWindowProc(hwnd, message, wparam, lparam);
+}
+
+}  // namespace floating_palette
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <windows.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "glass_animation_driver.h"
+
+namespace floating_palette {
+
+struct PaletteWindow;
+
+/// Memory layout of the glass path buffer written by glass_path_bridge.dart
+/// (packed, 9244 bytes; same as GlassPathBuffer.swift). Note this is larger
+/// than the legacy struct in src/ffi_interface.h; the Dart layout is the
+/// one both readers follow.
+#pragma pack(push, 1)
+struct GlassPathBuffer {
+  static constexpr size_t kMaxCommands = 1024;
+  static constexpr size_t kMaxFloats = 2048;
+
+  uint64_t frame_id;
+  uint32_t command_count;
+  uint8_t commands[kMaxCommands];
+  uint32_t point_count;
+  float points[kMaxFloats];
+  float window_height;
+  uint64_t frame_id_post;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(GlassPathBuffer) == 9244,
+              "GlassPathBuffer must match the Dart @Packed(1) layout");
+static_assert(offsetof(GlassPathBuffer, points) == 1040,
+              "GlassPathBuffer must match the Dart @Packed(1) layout");
+static_assert(offsetof(GlassPathBuffer, frame_id_post) == 9236,
+              "GlassPathBuffer must match the Dart @Packed(1) layout");
+
+/// Counters for the glass backdrop.
+struct GlassBackdropStats {
+  /// Path buffer publishes picked up (frameId changed, consistent read).
+  std::atomic<uint64_t> path_updates{0};
+  /// Path reads skipped because Dart was mid-write.
+  std::atomic<uint64_t> torn_reads{0};
+  /// Window regions rebuilt (once per changed window per tick at most).
+  std::atomic<uint64_t> region_rebuilds{0};
+  /// Publishes whose commands and points matched the cached path exactly;
+  /// no flattening and no region rebuild.
+  std::atomic<uint64_t> identical_paths{0};
+  /// Publishes that were a translation / uniform scale of the cached path;
+  /// the cached flattening was transformed instead of recomputed.
+  std::atomic<uint64_t> transformed_paths{0};
+};
+
+/// Windows glass effect: a DWM system backdrop (acrylic / mica) clipped to
+/// the shape Flutter publishes (port of GlassMaskService.swift).
+///
+/// The backdrop is the window's DWMWA_SYSTEMBACKDROP_TYPE with the frame
+/// extended over the client area, so DWM composites the blur itself. The
+/// clip is a window region built from the layers' GlassPathBuffers, or from
+/// native-interpolated bounds while a GlassAnimationDriver animation runs.
+///
+/// Geometry is only rebuilt when something changed: path buffers are polled
+/// on the glass compositor tick by comparing frameId (no copy), and a
+/// changed buffer is copied once on the platform thread. Dart bumps frameId
+/// on every publish, so the copy is then fingerprinted: an identical path
+/// (same commands and point bits) keeps the current region, and a path that
+/// is only a translation / uniform scale of the cached one reuses its
+/// flattening through a transform. Unchanged frames touch nothing.
+///
+/// FFI entry points call in from the Dart UI thread; all HWND work is
+/// posted to the platform thread.
+class GlassBackdrop {
+ public:
+  static GlassBackdrop& Instance();
+
+  GlassBackdrop(const GlassBackdrop&) = delete;
+  GlassBackdrop& operator=(const GlassBackdrop&) = delete;
+
+  /// DWM system backdrops need Windows 11 22H2 (build 22621) or later.
+  static bool IsSupported();
+
+  GlassPathBuffer* CreateBuffer(const std::string& window_id, int32_t layer_id);
+  void DestroyBuffer(const std::string& window_id, int32_t layer_id);
+
+  void SetEnabled(const std::string& window_id, bool enabled);
+  void SetMaterial(const std::string& window_id, int32_t layer_id,
+                   int32_t material);
+  void SetDark(const std::string& window_id, int32_t layer_id, bool is_dark);
+  /// Stored for parity with macOS; the system backdrop has no tint layer,
+  /// and Flutter paints any tint itself.
+  void SetTintOpacity(const std::string& window_id, int32_t layer_id,
+                      float opacity, float corner_radius);
+
+  /// Drop all glass state for a destroyed window (platform thread).
+  void Cleanup(const std::string& window_id);
+
+  const GlassBackdropStats& Stats() const { return stats_; }
+
+ private:
+  static constexpr UINT kApplyMessage = WM_APP + 6;
+
+  /// A flattened subpath in logical pixels.
+  using Polygon = std::vector<std::pair<float, float>>;
+
+  struct Layer {
+    std::unique_ptr<GlassPathBuffer> buffer;
+    /// Last frameId seen on the tick (tick thread).
+    uint64_t seen_frame_id = 0;
+    /// Last frameId flattened into `shape` (platform thread).
+    uint64_t built_frame_id = 0;
+    bool path_dirty = false;
+    std::vector<Polygon> shape;
+    /// Geometry cache (platform thread): hash of the raw commands + points,
+    /// hash of the commands + points normalized to their bounding box, and
+    /// `shape` in that normalized space (p - origin) / extent.
+    uint64_t path_hash = 0;
+    uint64_t shape_hash = 0;
+    std::vector<Polygon> unit_shape;
+    std::optional<AnimatedBounds> animated;
+    int32_t material = 0;
+    bool dark = false;
+    float tint_opacity = 0;
+    float tint_corner_radius = 16;
+  };
+
+  struct WindowGlass {
+    bool enabled = false;
+    /// Backdrop attributes (material / dark / enabled) need reapplying.
+    bool style_dirty = false;
+    /// Some layer's path buffer was republished; its geometry may or may
+    /// not have changed.
+    bool paths_dirty = false;
+    /// Clip needs rebuilding.
+    bool clip_dirty = false;
+    std::map<int32_t, Layer> layers;
+  };
+
+  GlassBackdrop();
+
+  void PollPathBuffers();
+  void ScheduleApply();
+  void ApplyPending();
+  bool UpdateShapes(WindowGlass& glass);
+  void ApplyStyle(PaletteWindow& window, const WindowGlass& glass);
+  void ApplyClip(HWND hwnd, const std::string& window_id, WindowGlass& glass);
+  void OnAnimatedBounds(const std::string& window_id, int32_t layer_id,
+                        const AnimatedBounds& bounds);
+  void UpdateTickLocked();
+
+  static bool FlattenPath(const GlassPathBuffer& buffer,
+                          std::vector<Polygon>* out);
+
+  /// Path fingerprint. `extent` is the larger bounding box side (0 for an
+  /// empty or degenerate path, in which case shape_hash == path_hash).
+  struct PathKey {
+    uint64_t path_hash;
+    uint64_t shape_hash;
+    float origin_x;
+    float origin_y;
+    float extent;
+  };
+  static PathKey HashPath(const GlassPathBuffer& buffer);
+
+  static LRESULT CALLBACK MessageWndProc(HWND hwnd, UINT message,
+                                         WPARAM wparam, LPARAM lparam);
+
+  std::mutex mutex_;
+  std::map<std::string, WindowGlass> windows_;
+  std::atomic<bool> apply_posted_{false};
+  HWND message_window_ = nullptr;
+  GlassBackdropStats stats_;
+};
+
+}  // namespace floating_palette
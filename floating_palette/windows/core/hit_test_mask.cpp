@@ -0,0 +1,144 @@
+#include "hit_test_mask.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace floating_palette {
+
+namespace {
+
+uint64_t LoadFrameId(const HitTestMaskBuffer* buffer, size_t offset) {
+  // Both ids are 8-aligned in a heap block, but go through memcpy like the
+  // glass path reader so the packed layout never matters.
+  uint64_t value;
+  std::memcpy(&value, reinterpret_cast<const char*>(buffer) + offset,
+              sizeof(value));
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return value;
+}
+
+}  // namespace
+
+HitTestMask::HitTestMask() : buffer_(std::make_unique<HitTestMaskBuffer>()) {
+  std::memset(buffer_.get(), 0, sizeof(HitTestMaskBuffer));
+}
+
+// static
+HitTestStats& HitTestMask::Stats() {
+  static HitTestStats stats;
+  return stats;
+}
+
+HitTestMaskBuffer* HitTestMask::Publish() {
+  if (!published_.load(std::memory_order_acquire)) {
+    std::memset(buffer_.get(), 0, sizeof(HitTestMaskBuffer));
+    publish_generation_.fetch_add(1, std::memory_order_relaxed);
+    published_.store(true, std::memory_order_release);
+  }
+  return buffer_.get();
+}
+
+void HitTestMask::Unpublish() {
+  published_.store(false, std::memory_order_release);
+}
+
+void HitTestMask::SetStatic(PassthroughMode mode, std::vector<Rect> rects) {
+  static_.Assign(mode, std::move(rects));
+}
+
+bool HitTestMask::PassesThrough(float x, float y) {
+  const Mask& mask = Current();
+  if (mask.mode == PassthroughMode::kNone) return false;
+
+  auto& stats = Stats();
+  stats.hit_tests.fetch_add(1, std::memory_order_relaxed);
+  bool through;
+  switch (mask.mode) {
+    case PassthroughMode::kRegions:
+      through = mask.Contains(x, y);
+      break;
+    case PassthroughMode::kInteractive:
+      through = !mask.Contains(x, y);
+      break;
+    default:
+      through = true;
+  }
+  if (through) stats.passthrough_hits.fetch_add(1, std::memory_order_relaxed);
+  return through;
+}
+
+PassthroughMode HitTestMask::mode() { return Current().mode; }
+
+const HitTestMask::Mask& HitTestMask::Current() {
+  if (!published_.load(std::memory_order_acquire)) return static_;
+
+  uint32_t generation = publish_generation_.load(std::memory_order_relaxed);
+  if (generation != seen_generation_) {
+    seen_generation_ = generation;
+    seen_frame_id_ = 0;
+    shared_.Assign(PassthroughMode::kNone, {});
+  }
+
+  const HitTestMaskBuffer* buffer = buffer_.get();
+  uint64_t frame_id =
+      LoadFrameId(buffer, offsetof(HitTestMaskBuffer, frame_id));
+  // Not written yet: the static mask still applies.
+  if (frame_id == 0 && seen_frame_id_ == 0) return static_;
+  if (frame_id == seen_frame_id_) return shared_;
+
+  auto mode = static_cast<PassthroughMode>(buffer->mode);
+  uint32_t count = std::min<uint32_t>(
+      buffer->rect_count, static_cast<uint32_t>(HitTestMaskBuffer::kMaxRects));
+  std::vector<Rect> rects;
+  rects.reserve(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    const float* r = &buffer->rects[i * 4];
+    if (!(r[2] > 0) || !(r[3] > 0)) continue;
+    rects.push_back(Rect{r[0], r[1], r[0] + r[2], r[1] + r[3]});
+  }
+
+  auto& stats = Stats();
+  if (LoadFrameId(buffer, offsetof(HitTestMaskBuffer, frame_id_post)) !=
+      frame_id) {
+    // Dart is mid-write; keep the last good mask and retry next time.
+    stats.torn_reads.fetch_add(1, std::memory_order_relaxed);
+    return seen_frame_id_ ? shared_ : static_;
+  }
+  if (mode > PassthroughMode::kAll) mode = PassthroughMode::kNone;
+  shared_.Assign(mode, std::move(rects));
+  seen_frame_id_ = frame_id;
+  stats.mask_updates.fetch_add(1, std::memory_order_relaxed);
+  return shared_;
+}
+
+void HitTestMask::Mask::Assign(PassthroughMode new_mode,
+                               std::vector<Rect> new_rects) {
+  mode = new_mode;
+  rects = std::move(new_rects);
+  bounds = {0, 0, 0, 0};
+  if (rects.empty()) return;
+  bounds = rects.front();
+  for (const Rect& rect : rects) {
+    bounds.left = std::min(bounds.left, rect.left);
+    bounds.top = std::min(bounds.top, rect.top);
+    bounds.right = std::max(bounds.right, rect.right);
+    bounds.bottom = std::max(bounds.bottom, rect.bottom);
+  }
+}
+
+bool HitTestMask::Mask::Contains(float x, float y) const {
+  if (x < bounds.left || x >= bounds.right || y < bounds.top ||
+      y >= bounds.bottom) {
+    return false;
+  }
+  for (const Rect& rect : rects) {
+    if (x >= rect.left && x < rect.right && y >= rect.top &&
+        y < rect.bottom) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace floating_palette
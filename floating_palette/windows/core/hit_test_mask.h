@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace floating_palette {
+
+/// What a palette's hit-test rects mean. Must match PassthroughMode in
+/// hit_test_mask_bridge.dart.
+enum class PassthroughMode : uint32_t {
+  /// Every point hits the palette (rects ignored).
+  kNone = 0,
+  /// Points inside a rect pass through to the window underneath.
+  kRegions = 1,
+  /// Only points inside a rect hit the palette; the rest passes through.
+  kInteractive = 2,
+  /// Every point passes through (rects ignored).
+  kAll = 3,
+};
+
+/// Memory layout of the hit-test mask written by hit_test_mask_bridge.dart
+/// (packed, 2072 bytes). Same publish protocol as GlassPathBuffer:
+/// frameIdPost, payload, then frameId; a reader that sees them differ
+/// skips the frame. Rects are x, y, width, height in logical pixels
+/// relative to the palette's top-left corner.
+#pragma pack(push, 1)
+struct HitTestMaskBuffer {
+  static constexpr size_t kMaxRects = 128;
+
+  uint64_t frame_id;
+  uint32_t mode;
+  uint32_t rect_count;
+  float rects[kMaxRects * 4];
+  uint64_t frame_id_post;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(HitTestMaskBuffer) == 2072,
+              "HitTestMaskBuffer must match the Dart @Packed(1) layout");
+static_assert(offsetof(HitTestMaskBuffer, rects) == 16,
+              "HitTestMaskBuffer must match the Dart @Packed(1) layout");
+static_assert(offsetof(HitTestMaskBuffer, frame_id_post) == 2064,
+              "HitTestMaskBuffer must match the Dart @Packed(1) layout");
+
+/// Counters for pointer passthrough.
+struct HitTestStats {
+  /// WM_NCHITTEST lookups answered from a mask.
+  std::atomic<uint64_t> hit_tests{0};
+  /// Lookups that let the point through (HTTRANSPARENT).
+  std::atomic<uint64_t> passthrough_hits{0};
+  /// Mask publishes picked up (frameId changed, consistent read).
+  std::atomic<uint64_t> mask_updates{0};
+  /// Mask reads skipped because Dart was mid-write.
+  std::atomic<uint64_t> torn_reads{0};
+};
+
+/// Pointer passthrough mask for one palette window.
+///
+/// Two sources: setPassthrough over the input channel (a static mask), and
+/// a shared-memory buffer that Dart republishes as its layout changes. Once
+/// the buffer is published and written it wins over the static mask.
+///
+/// The panel answers every WM_NCHITTEST from the cached rect list: the
+/// buffer is only copied when its frameId moved, so a hit test is a frameId
+/// load, a bounds check and a short rect scan, with no channel traffic and
+/// no window style change per pointer move.
+class HitTestMask {
+ public:
+  /// Logical pixels relative to the palette's top-left corner.
+  struct Rect {
+    float left;
+    float top;
+    float right;
+    float bottom;
+  };
+
+  HitTestMask();
+
+  HitTestMask(const HitTestMask&) = delete;
+  HitTestMask& operator=(const HitTestMask&) = delete;
+
+  /// Start reading the shared buffer and return it (zeroed when it wasn't
+  /// already published). Valid for the window's lifetime. Any thread.
+  HitTestMaskBuffer* Publish();
+  /// Fall back to the static mask. Any thread.
+  void Unpublish();
+
+  /// Platform thread.
+  void SetStatic(PassthroughMode mode, std::vector<Rect> rects);
+
+  /// Whether a point in logical pixels relative to the palette passes
+  /// through. Platform thread.
+  bool PassesThrough(float x, float y);
+  /// Platform thread.
+  PassthroughMode mode();
+
+  /// The panel is click-through (WS_EX_TRANSPARENT) for whole-window
+  /// passthrough; see PalettePanel. Platform thread.
+  bool click_through = false;
+  /// WS_EX_LAYERED was added for click-through and should be removed with
+  /// it. Platform thread.
+  bool added_layered = false;
+
+  static HitTestStats& Stats();
+
+ private:
+  struct Mask {
+    PassthroughMode mode = PassthroughMode::kNone;
+    std::vector<Rect> rects;
+    /// Union of `rects`, for a quick reject.
+    Rect bounds = {0, 0, 0, 0};
+
+    void Assign(PassthroughMode new_mode, std::vector<Rect> new_rects);
+    bool Contains(float x, float y) const;
+  };
+
+  /// Copy the buffer if it was republished. Platform thread.
+  const Mask& Current();
+
+  std::unique_ptr<HitTestMaskBuffer> buffer_;
+  /// Bumped by Publish, so a re-published buffer restarting its frameIds
+  /// isn't mistaken for one already read.
+  std::atomic<uint32_t> publish_generation_{0};
+  std::atomic<bool> published_{false};
+
+  uint32_t seen_generation_ = 0;
+  uint64_t seen_frame_id_ = 0;
+  Mask static_;
+  Mask shared_;
+};
+
+}  // namespace floating_palette
@@ -0,0 +1,34 @@
+#include "id_table.h"
+
+#include <mutex>
+
+namespace floating_palette {
+
+IdTable& IdTable::Instance() {
+  static IdTable table;
+  return table;
+}
+
+const std::string* IdTable::Intern(std::string_view id) {
+  if (const std::string* found = Find(id)) return found;
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  // Another thread may have added it between the two locks.
+  auto it = index_.find(id);
+  if (it != index_.end()) return it->second;
+  const std::string* interned = &ids_.emplace_back(id);
+  index_.emplace(std::string_view(*interned), interned);
+  return interned;
+}
+
+const std::string* IdTable::Find(std::string_view id) const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  auto it = index_.find(id);
+  return it != index_.end() ? it->second : nullptr;
+}
+
+size_t IdTable::size() const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  return ids_.size();
+}
+
+}  // namespace floating_palette
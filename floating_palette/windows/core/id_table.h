@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace floating_palette {
+
+/// Interned palette ids.
+///
+/// Each distinct id is stored once, at an address that never changes, so
+/// state that outlives a single call (the active drag, EventQueue's
+/// coalescing slots) holds a `const std::string*` and compares pointers
+/// instead of copying and comparing strings. The pointer doubles as the
+/// `window_id` EventSink takes.
+///
+/// Entries are never freed: palette ids are a small set declared in Dart
+/// and reused across create/destroy, and an interned pointer must stay
+/// valid after its window is gone. Thread-safe; only the first Intern of
+/// an id takes the exclusive lock.
+class IdTable {
+ public:
+  static IdTable& Instance();
+
+  /// The canonical copy of `id`, added on first use.
+  const std::string* Intern(std::string_view id);
+  /// The canonical copy of `id`, or nullptr if it was never interned.
+  const std::string* Find(std::string_view id) const;
+
+  size_t size() const;
+
+ private:
+  IdTable() = default;
+
+  mutable std::shared_mutex mutex_;
+  /// Deque elements never move, so the views keyed below stay valid.
+  std::deque<std::string> ids_;
+  std::unordered_map<std::string_view, const std::string*> index_;
+};
+
+}  // namespace floating_palette
@@ -0,0 +1,205 @@
+#include "keyboard_route.h"
+
+#include <flutter_windows.h>
+#include <imm.h>
+
+#include <algorithm>
+
+#include "logger.h"
+#include "reveal_pipeline.h"
+
+namespace floating_palette {
+
+namespace {
+
+bool IsKeyDown(UINT message) {
+  return message == WM_KEYDOWN || message == WM_SYSKEYDOWN;
+}
+
+bool IsKeyUp(UINT message) {
+  return message == WM_KEYUP || message == WM_SYSKEYUP;
+}
+
+bool IsChar(UINT message) {
+  return message == WM_CHAR || message == WM_SYSCHAR ||
+         message == WM_DEADCHAR || message == WM_SYSDEADCHAR ||
+         message == WM_UNICHAR;
+}
+
+bool IsComposition(UINT message) {
+  return message == WM_IME_STARTCOMPOSITION ||
+         message == WM_IME_COMPOSITION || message == WM_IME_ENDCOMPOSITION ||
+         message == WM_IME_CHAR;
+}
+
+}  // namespace
+
+// static
+KeyboardRoute& KeyboardRoute::Instance() {
+  static KeyboardRoute instance;
+  return instance;
+}
+
+// static
+KeyboardRouteStats& KeyboardRoute::Stats() {
+  static KeyboardRouteStats stats;
+  return stats;
+}
+
+bool KeyboardRoute::Capture(HWND host_view, PaletteWindow& window,
+                            bool all_keys, const std::vector<UINT>& keys) {
+  if (!host_view || !window.view_controller) return false;
+  HWND view = FlutterDesktopViewGetHWND(
+      FlutterDesktopViewControllerGetView(window.view_controller));
+  if (!view) return false;
+
+  Route route;
+  route.window = window.handle;
+  route.view = view;
+  route.view_proc =
+      reinterpret_cast<WNDPROC>(GetWindowLongPtr(view, GWLP_WNDPROC));
+  route.all_keys = all_keys;
+  if (all_keys) {
+    // The context stays valid for the view's lifetime; the route only
+    // borrows it.
+    route.ime_context = ImmGetContext(view);
+    if (route.ime_context) ImmReleaseContext(view, route.ime_context);
+  }
+  for (UINT key : keys) {
+    if (key < route.keys.size()) route.keys.set(key);
+  }
+
+  routes_.erase(std::remove_if(routes_.begin(), routes_.end(),
+                               [&](const Route& r) {
+                                 return r.window == window.handle;
+                               }),
+                routes_.end());
+  routes_.push_back(route);
+  if (!host_view_) Attach(host_view);
+  BindInputContext();
+  FP_LOG("Input", "keyboard captured: ", window.id, " allKeys=", all_keys,
+         " keys=", keys.size());
+  return true;
+}
+
+void KeyboardRoute::Release(WindowHandle window) {
+  auto it = std::find_if(routes_.begin(), routes_.end(),
+                         [&](const Route& r) { return r.window == window; });
+  if (it == routes_.end()) return;
+  routes_.erase(it);
+  // Ups for keys still held now reach the host, which synthesizes the
+  // missing downs; better than sending them to a released palette.
+  down_.reset();
+  route_chars_ = false;
+  BindInputContext();
+  if (routes_.empty()) Detach();
+}
+
+bool KeyboardRoute::IsCaptured(WindowHandle window) const {
+  return std::any_of(routes_.begin(), routes_.end(),
+                     [&](const Route& r) { return r.window == window; });
+}
+
+bool KeyboardRoute::Forward(UINT message, WPARAM wparam, LPARAM lparam,
+                            LRESULT* result) {
+  if (routes_.empty()) return false;
+  const Route& route = routes_.back();
+  auto& stats = Stats();
+
+  if (IsKeyDown(message)) {
+    const size_t key = wparam & 0xFF;
+    route_chars_ = route.all_keys || route.keys.test(key);
+    if (route_chars_ && !Live(route)) {
+      stats.skipped_hidden.fetch_add(1, std::memory_order_relaxed);
+      route_chars_ = false;
+    }
+    if (!route_chars_) return false;
+    down_.set(key);
+  } else if (IsKeyUp(message)) {
+    const size_t key = wparam & 0xFF;
+    if (!down_.test(key)) return false;
+    down_.reset(key);
+  } else if (IsChar(message)) {
+    if (!route_chars_) return false;
+  } else if (IsComposition(message)) {
+    if (!ime_lent_) return false;
+    stats.ime_routed.fetch_add(1, std::memory_order_relaxed);
+    *result = CallWindowProc(route.view_proc, route.view, message, wparam,
+                             lparam);
+    return true;
+  } else {
+    return false;
+  }
+
+  stats.keys_routed.fetch_add(1, std::memory_order_relaxed);
+  *result =
+      CallWindowProc(route.view_proc, route.view, message, wparam, lparam);
+  return true;
+}
+
+// static
+bool KeyboardRoute::Live(const Route& route) {
+  bool shown = false;
+  WindowStore::Instance().WithWindow(route.window, [&](PaletteWindow& w) {
+    shown = !w.suspended && RevealPipeline::IsShown(w);
+  });
+  return shown;
+}
+
+void KeyboardRoute::Attach(HWND host_view) {
+  host_view_ = host_view;
+  host_proc_ = reinterpret_cast<WNDPROC>(SetWindowLongPtr(
+      host_view, GWLP_WNDPROC, reinterpret_cast<LONG_PTR>(HostViewProc)));
+}
+
+void KeyboardRoute::Detach() {
+  if (!host_view_) return;
+  if (ime_lent_) {
+    ImmAssociateContext(host_view_, host_ime_context_);
+    ime_lent_ = false;
+  }
+  // Only unhook if nobody subclassed the view after us; otherwise stay in
+  // the chain as a pass-through.
+  if (GetWindowLongPtr(host_view_, GWLP_WNDPROC) ==
+      reinterpret_cast<LONG_PTR>(HostViewProc)) {
+    SetWindowLongPtr(host_view_, GWLP_WNDPROC,
+                     reinterpret_cast<LONG_PTR>(host_proc_));
+    host_view_ = nullptr;
+    host_proc_ = nullptr;
+  }
+  down_.reset();
+  route_chars_ = false;
+}
+
+void KeyboardRoute::BindInputContext() {
+  if (!host_view_) return;
+  HIMC wanted = routes_.empty() ? nullptr : routes_.back().ime_context;
+  if (wanted) {
+    HIMC previous = ImmAssociateContext(host_view_, wanted);
+    if (!ime_lent_) host_ime_context_ = previous;
+    ime_lent_ = true;
+  } else if (ime_lent_) {
+    ImmAssociateContext(host_view_, host_ime_context_);
+    ime_lent_ = false;
+  }
+}
+
+// static
+LRESULT CALLBACK KeyboardRoute::HostViewProc(HWND hwnd, UINT message,
+                                             WPARAM wparam, LPARAM lparam) {
+  KeyboardRoute& self = Instance();
+  LRESULT result;
+  if (self.Forward(message, wparam, lparam, &result)) return result;
+
+  WNDPROC original = self.host_proc_;
+  if (message == WM_NCDESTROY) {
+    SetWindowLongPtr(hwnd, GWLP_WNDPROC, reinterpret_cast<LONG_PTR>(original));
+    self.routes_.clear();
+    self.host_view_ = nullptr;
+    self.host_proc_ = nullptr;
+    self.ime_lent_ = false;
+  }
+  return CallWindowProc(original, hwnd, message, wparam, lparam);
+}
+
+}  // namespace floating_palette
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <windows.h>
+
+#include <atomic>
+#include <bitset>
+#include <cstdint>
+#include <vector>
+
+#include "window_store.h"
+
+namespace floating_palette {
+
+/// Counters for keyboard capture.
+struct KeyboardRouteStats {
+  /// Key messages (down, up, char) handed to a palette view.
+  std::atomic<uint64_t> keys_routed{0};
+  /// IME composition messages handed to a palette view.
+  std::atomic<uint64_t> ime_routed{0};
+  /// Key downs a capture wanted but left with the host because the palette
+  /// wasn't shown.
+  std::atomic<uint64_t> skipped_hidden{0};
+};
+
+/// Routes the host's keyboard input into a capturing palette's engine.
+///
+/// Palettes never activate, so keystrokes land on the host's Flutter view.
+/// While a palette has the keyboard captured, the host view's window
+/// procedure (subclassed on first capture) hands the wanted key messages
+/// straight to the palette view's window procedure, which feeds them to
+/// that palette's engine: its focused TextField or Shortcuts see the key
+/// in the same message, with no host Dart handler, channel hop or
+/// allocation in between. The route (target view, its window procedure,
+/// the wanted virtual keys) is bound at capture time; a keystroke costs a
+/// bit test, a shown check and a direct call.
+///
+/// WM_CHAR and friends follow their key down. A key up goes wherever its
+/// key down went. An all-keys capture also lends the palette's input
+/// context to the host view, so IME composition is written into the
+/// palette's context and its composition messages go to the palette.
+///
+/// Captures stack: the latest one gets the keys until it is released.
+///
+/// Platform thread only.
+class KeyboardRoute {
+ public:
+  static KeyboardRoute& Instance();
+
+  KeyboardRoute(const KeyboardRoute&) = delete;
+  KeyboardRoute& operator=(const KeyboardRoute&) = delete;
+
+  /// Route keys from `host_view` into `window`'s view. With `all_keys`
+  /// every key (and IME composition) goes to the palette; otherwise only
+  /// the virtual keys in `keys`. Re-capturing replaces the window's route
+  /// and makes it the active one. False if the window has no view.
+  bool Capture(HWND host_view, PaletteWindow& window, bool all_keys,
+               const std::vector<UINT>& keys);
+
+  /// Drop `window`'s route, if any. Restores the host view once no route
+  /// is left.
+  void Release(WindowHandle window);
+
+  bool IsCaptured(WindowHandle window) const;
+
+  static KeyboardRouteStats& Stats();
+
+ private:
+  struct Route {
+    WindowHandle window = kInvalidWindowHandle;
+    HWND view = nullptr;
+    WNDPROC view_proc = nullptr;
+    /// The palette view's input context; null unless all keys.
+    HIMC ime_context = nullptr;
+    bool all_keys = false;
+    std::bitset<256> keys;
+  };
+
+  KeyboardRoute() = default;
+
+  /// Handle `message` for the host view if the active route wants it.
+  bool Forward(UINT message, WPARAM wparam, LPARAM lparam, LRESULT* result);
+  /// The palette behind `route` is shown (not hidden, cloaked or gone).
+  static bool Live(const Route& route);
+
+  void Attach(HWND host_view);
+  void Detach();
+  /// Give the host view the active route's input context, or its own back.
+  void BindInputContext();
+
+  static LRESULT CALLBACK HostViewProc(HWND hwnd, UINT message, WPARAM wparam,
+                                       LPARAM lparam);
+
+  HWND host_view_ = nullptr;
+  WNDPROC host_proc_ = nullptr;
+  /// The host view's own input context while a palette's is lent to it.
+  HIMC host_ime_context_ = nullptr;
+  bool ime_lent_ = false;
+
+  /// Active route last.
+  std::vector<Route> routes_;
+  /// Virtual keys whose key down went to a palette.
+  std::bitset<256> down_;
+  /// The last key down went to a palette, so its characters follow it.
+  bool route_chars_ = false;
+};
+
+}  // namespace floating_palette
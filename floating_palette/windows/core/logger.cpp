@@ -0,0 +1,212 @@
+#include "logger.h"
+
+#include <windows.h>
+
+#include <mutex>
+#include <thread>
+
+namespace floating_palette {
+
+std::atomic<uint32_t> Logger::enabled_{kLogAllCategories};
+
+void LogLine::Append(double value) {
+  auto [end, error] =
+      std::to_chars(text_ + length_, text_ + kCapacity, value,
+                    std::chars_format::general, 6);
+  if (error == std::errc()) {
+    length_ = end - text_;
+    text_[length_] = '\0';
+  }
+}
+
+namespace {
+
+void OutputLine(const char* category, std::string_view text) {
+  // "[floating_palette:" + category + "] " + text + "\n"
+  char buffer[LogLine::kCapacity + 48];
+  LogLine prefix;
+  prefix.Append("[floating_palette:");
+  prefix.Append(category);
+  prefix.Append("] ");
+  size_t length = prefix.view().copy(buffer, sizeof(buffer) - 2);
+  length += text.copy(buffer + length, sizeof(buffer) - 2 - length);
+  buffer[length++] = '\n';
+  buffer[length] = '\0';
+  OutputDebugStringA(buffer);
+}
+
+/// Bounded multi-producer, single-consumer ring of formatted lines (one
+/// sequence number per slot). Producers never block: a full ring drops
+/// the line and counts it. The consumer is the drain thread.
+class LogRing {
+ public:
+  static constexpr size_t kSlots = 256;
+
+  static LogRing& Instance() {
+    static LogRing* ring = new LogRing();
+    return *ring;
+  }
+
+  void Start() {
+    std::lock_guard<std::mutex> lock(lifecycle_mutex_);
+    if (starts_++ > 0 || !wake_) return;
+    stopping_.store(false, std::memory_order_relaxed);
+    thread_ = std::thread([this] { Run(); });
+    running_.store(true, std::memory_order_release);
+  }
+
+  void Stop() {
+    std::lock_guard<std::mutex> lock(lifecycle_mutex_);
+    if (starts_ == 0 || --starts_ > 0 || !thread_.joinable()) return;
+    running_.store(false, std::memory_order_release);
+    stopping_.store(true, std::memory_order_release);
+    SetEvent(wake_);
+    thread_.join();
+    Drain();
+  }
+
+  /// False when no drain thread is running; the caller writes directly.
+  bool Push(const char* category, const LogLine& line) {
+    if (!running_.load(std::memory_order_acquire)) return false;
+
+    uint64_t position = tail_.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+      slot = &slots_[position % kSlots];
+      uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+      auto lag = static_cast<int64_t>(sequence - position);
+      if (lag == 0 &&
+          tail_.compare_exchange_weak(position, position + 1,
+                                      std::memory_order_relaxed)) {
+        break;
+      }
+      if (lag < 0) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+      if (lag != 0) position = tail_.load(std::memory_order_relaxed);
+    }
+
+    slot->category = category;
+    slot->length = line.view().copy(slot->text, LogLine::kCapacity);
+    slot->sequence.store(position + 1, std::memory_order_release);
+
+    // One wake-up per drain pass, not per line.
+    if (!wake_pending_.exchange(true, std::memory_order_acq_rel)) {
+      SetEvent(wake_);
+    }
+    return true;
+  }
+
+ private:
+  struct Slot {
+    std::atomic<uint64_t> sequence{0};
+    const char* category = nullptr;
+    size_t length = 0;
+    char text[LogLine::kCapacity];
+  };
+
+  // The event lives as long as the process: a producer that saw the ring
+  // running may still signal it after Stop.
+  LogRing() : wake_(CreateEventW(nullptr, FALSE, FALSE, nullptr)) {
+    for (size_t i = 0; i < kSlots; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  void Run() {
+    while (!stopping_.load(std::memory_order_acquire)) {
+      WaitForSingleObject(wake_, INFINITE);
+      wake_pending_.store(false, std::memory_order_release);
+      Drain();
+    }
+  }
+
+  void Drain() {
+    for (;;) {
+      Slot& slot = slots_[head_ % kSlots];
+      if (slot.sequence.load(std::memory_order_acquire) != head_ + 1) break;
+      OutputLine(slot.category, std::string_view(slot.text, slot.length));
+      slot.sequence.store(head_ + kSlots, std::memory_order_release);
+      ++head_;
+    }
+    uint64_t dropped = dropped_.exchange(0, std::memory_order_relaxed);
+    if (dropped) {
+      LogLine line;
+      line.Append(dropped);
+      line.Append(" lines dropped (log ring full)");
+      OutputLine("Plugin", line.view());
+    }
+  }
+
+  HANDLE wake_;
+  Slot slots_[kSlots];
+  std::atomic<uint64_t> tail_{0};
+  uint64_t head_ = 0;  // Drain thread (or Stop, after the join).
+  std::atomic<uint64_t> dropped_{0};
+  std::atomic<bool> wake_pending_{false};
+  std::atomic<bool> running_{false};
+  std::atomic<bool> stopping_{false};
+  std::thread thread_;
+  std::mutex lifecycle_mutex_;
+  int starts_ = 0;
+};
+
+}  // namespace
+
+// static
+void Logger::Start() {
+  // Once per process, so a later plugin instance doesn't undo a runtime
+  // change.
+  static const bool environment_applied = [] {
+    char names[256];
+    DWORD length = GetEnvironmentVariableA("FLOATING_PALETTE_LOG", names,
+                                           sizeof(names));
+    if (length > 0 && length < sizeof(names)) {
+      SetEnabledCategories(ParseCategories(std::string_view(names, length)));
+    }
+    return true;
+  }();
+  (void)environment_applied;
+#ifdef _DEBUG
+  LogRing::Instance().Start();
+#endif
+}
+
+// static
+void Logger::Stop() {
+#ifdef _DEBUG
+  LogRing::Instance().Stop();
+#endif
+}
+
+// static
+uint32_t Logger::ParseCategories(std::string_view names) {
+  uint32_t mask = 0;
+  while (!names.empty()) {
+    size_t comma = names.find(',');
+    std::string_view name = names.substr(0, comma);
+    names = comma == std::string_view::npos ? std::string_view()
+                                            : names.substr(comma + 1);
+    while (!name.empty() && name.front() == ' ') name.remove_prefix(1);
+    while (!name.empty() && name.back() == ' ') name.remove_suffix(1);
+    if (name == "all") {
+      mask = kLogAllCategories;
+    } else if (name != "none") {
+      mask |= LogCategoryBit(name);
+    }
+  }
+  return mask;
+}
+
+// static
+void Logger::Write(const char* category, const LogLine& line) {
+  if (trace::Enabled(0)) trace::Log(category, line.c_str());
+#ifdef _DEBUG
+  if (!LogRing::Instance().Push(category, line)) {
+    OutputLine(category, line.view());
+  }
+#endif
+}
+
+}  // namespace floating_palette
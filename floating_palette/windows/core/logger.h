@@ -1,40 +1,189 @@
 #pragma once
 
-/// Debug-only logging via OutputDebugStringA.
+/// Logging to ETW (release and debug) and, in debug builds, to
+/// OutputDebugStringA.
 ///
 /// Usage:
-///   FP_LOG("Window", "create id=" + id);
+///   FP_LOG("Window", "create id=", id, " width=", width);
+///
+/// Pieces (strings, integers, doubles) are formatted into a fixed stack
+/// buffer only when the category is enabled, so a disabled FP_LOG costs an
+/// inline check and an enabled one never allocates. Debug output goes
+/// through a pre-allocated ring that a background thread drains, so the
+/// caller never waits on OutputDebugStringA.
+///
+/// Filtering:
+///   Compile time: define FP_LOG_CATEGORIES to a mask of LogCategory bits
+///   (CMake: -DFP_LOG_CATEGORIES=0x...); excluded categories compile away.
+///   Runtime: Logger::SetEnabledCategories, host/setLogCategories, or the
+///   FLOATING_PALETTE_LOG environment variable ("Window,Frame", "all",
+///   "none") read at startup.
 ///
 /// Viewing logs:
-///   Use DebugView (Sysinternals) or Visual Studio Output window.
-///   Filter by "[floating_palette:" prefix.
+///   Release: record the provider (see core/trace.h) and open it in WPA.
+///   Debug: DebugView (Sysinternals) or the Visual Studio Output window,
+///   filtered by the "[floating_palette:" prefix.
 
-#ifdef _DEBUG
+#include <atomic>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
 
-#include <windows.h>
+#include "trace.h"
 
-#include <sstream>
-#include <string>
+#ifndef FP_LOG_CATEGORIES
+#define FP_LOG_CATEGORIES 0xFFFFFFFFu
+#endif
 
 namespace floating_palette {
 
-inline void LogMessage(const char* category, const char* message) {
-  std::ostringstream oss;
-  oss << "[floating_palette:" << category << "] " << message << "\n";
-  OutputDebugStringA(oss.str().c_str());
-}
+/// One bit per FP_LOG category name.
+enum LogCategory : uint32_t {
+  kLogWindow = 1u << 0,
+  kLogVisibility = 1u << 1,
+  kLogFrame = 1u << 2,
+  kLogDrag = 1u << 3,
+  kLogTransform = 1u << 4,
+  kLogAnimation = 1u << 5,
+  kLogInput = 1u << 6,
+  kLogFocus = 1u << 7,
+  kLogZOrder = 1u << 8,
+  kLogAppearance = 1u << 9,
+  kLogScreen = 1u << 10,
+  kLogCapture = 1u << 11,
+  kLogGlass = 1u << 12,
+  kLogMessage = 1u << 13,
+  kLogSnap = 1u << 14,
+  kLogPlugin = 1u << 15,
+};
 
-inline void LogMessage(const char* category, const std::string& message) {
-  LogMessage(category, message.c_str());
+constexpr uint32_t kLogAllCategories = 0xFFFFu;
+
+struct LogCategoryName {
+  const char* name;
+  LogCategory bit;
+};
+
+constexpr LogCategoryName kLogCategoryNames[] = {
+    {"Window", kLogWindow},         {"Visibility", kLogVisibility},
+    {"Frame", kLogFrame},           {"Drag", kLogDrag},
+    {"Transform", kLogTransform},   {"Animation", kLogAnimation},
+    {"Input", kLogInput},           {"Focus", kLogFocus},
+    {"ZOrder", kLogZOrder},         {"Appearance", kLogAppearance},
+    {"Screen", kLogScreen},         {"Capture", kLogCapture},
+    {"Glass", kLogGlass},           {"Message", kLogMessage},
+    {"Snap", kLogSnap},             {"Plugin", kLogPlugin},
+};
+
+/// Bit for `name`, or 0 if it isn't a category. Usable at compile time.
+constexpr uint32_t LogCategoryBit(std::string_view name) {
+  for (const LogCategoryName& entry : kLogCategoryNames) {
+    if (name == entry.name) return entry.bit;
+  }
+  return 0;
 }
 
-}  // namespace floating_palette
+/// One formatted line in a fixed buffer; longer lines are truncated.
+class LogLine {
+ public:
+  static constexpr size_t kCapacity = 240;
 
-#define FP_LOG(category, message) \
-  ::floating_palette::LogMessage(category, message)
+  LogLine() { text_[0] = '\0'; }
 
-#else
+  void Append(std::string_view text) {
+    size_t n = text.size() < kCapacity - length_ ? text.size()
+                                                 : kCapacity - length_;
+    text.copy(text_ + length_, n);
+    length_ += n;
+    text_[length_] = '\0';
+  }
+  void Append(const char* text) { Append(std::string_view(text)); }
+  void Append(bool value) { Append(value ? "true" : "false"); }
+  void Append(char value) { Append(std::string_view(&value, 1)); }
+  void Append(double value);
+
+  template <typename T,
+            std::enable_if_t<std::is_integral_v<T> &&
+                                 !std::is_same_v<T, bool> &&
+                                 !std::is_same_v<T, char>,
+                             int> = 0>
+  void Append(T value) {
+    auto [end, error] = std::to_chars(text_ + length_, text_ + kCapacity,
+                                      value);
+    if (error == std::errc()) {
+      length_ = end - text_;
+      text_[length_] = '\0';
+    }
+  }
+
+  std::string_view view() const { return std::string_view(text_, length_); }
+  const char* c_str() const { return text_; }
 
-#define FP_LOG(category, message) ((void)0)
+ private:
+  char text_[kCapacity + 1];
+  size_t length_ = 0;
+};
 
+/// Runtime category mask and the debug output ring.
+class Logger {
+ public:
+  /// Start and stop the drain thread; reference counted, one pair per
+  /// plugin instance. Before Start and after the last Stop, debug lines
+  /// are written synchronously. Start also applies FLOATING_PALETTE_LOG.
+  static void Start();
+  static void Stop();
+
+  static uint32_t EnabledCategories() {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+  static void SetEnabledCategories(uint32_t mask) {
+    enabled_.store(mask & kLogAllCategories, std::memory_order_relaxed);
+  }
+
+  /// Mask for a comma-separated list of names, "all" or "none".
+  static uint32_t ParseCategories(std::string_view names);
+
+  /// Whether an FP_LOG in `category` would produce output right now.
+  static bool Enabled(uint32_t category) {
+    if (!(EnabledCategories() & category)) return false;
+#ifdef _DEBUG
+    return true;
+#else
+    return trace::Enabled(0);
 #endif
+  }
+
+  /// Any thread. Called by FP_LOG once the line is formatted.
+  static void Write(const char* category, const LogLine& line);
+
+ private:
+  static std::atomic<uint32_t> enabled_;
+};
+
+namespace log_internal {
+
+template <typename... Pieces>
+void Format(LogLine& line, const Pieces&... pieces) {
+  (line.Append(pieces), ...);
+}
+
+}  // namespace log_internal
+
+}  // namespace floating_palette
+
+#define FP_LOG(category, ...)                                                 \
+  do {                                                                        \
+    constexpr uint32_t fp_log_category =                                      \
+        ::floating_palette::LogCategoryBit(category);                         \
+    static_assert(fp_log_category != 0, "Unknown FP_LOG category");           \
+    if constexpr ((fp_log_category & (FP_LOG_CATEGORIES)) != 0) {             \
+      if (::floating_palette::Logger::Enabled(fp_log_category)) {             \
+        ::floating_palette::LogLine fp_log_line;                              \
+        ::floating_palette::log_internal::Format(fp_log_line, __VA_ARGS__);   \
+        ::floating_palette::Logger::Write(category, fp_log_line);             \
+      }                                                                       \
+    }                                                                         \
+  } while (0)
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <flutter/byte_streams.h>
+#include <flutter/encodable_value.h>
+#include <flutter/standard_codec_serializer.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace floating_palette {
+
+/// ByteStreamWriter that appends to a vector.
+class VectorStreamWriter : public flutter::ByteStreamWriter {
+ public:
+  explicit VectorStreamWriter(std::vector<uint8_t>* buffer)
+      : buffer_(buffer) {}
+
+  void WriteByte(uint8_t byte) override { buffer_->push_back(byte); }
+
+  void WriteBytes(const uint8_t* bytes, size_t length) override {
+    buffer_->insert(buffer_->end(), bytes, bytes + length);
+  }
+
+  void WriteAlignment(uint8_t alignment) override {
+    size_t mod = buffer_->size() % alignment;
+    if (mod) buffer_->resize(buffer_->size() + alignment - mod, 0);
+  }
+
+ private:
+  std::vector<uint8_t>* buffer_;
+};
+
+/// A string-keyed argument borrowed from already-decoded params; null
+/// encodes as an empty map (what the Dart side expects for missing data).
+using BorrowedArg = std::pair<const char*, const flutter::EncodableValue*>;
+
+/// Encode a StandardMethodCodec method call whose arguments are a map of
+/// `args`, writing each value straight from where it already lives.
+///
+/// MethodChannel::InvokeMethod needs an owned EncodableValue, which means
+/// deep-copying the forwarded payload before it is serialized. This writes
+/// the same bytes in one pass with no intermediate tree; a Uint8List value
+/// is a single memcpy. `size_hint` reserves the buffer up front.
+inline void EncodeMethodCall(const std::string& method,
+                             std::initializer_list<BorrowedArg> args,
+                             std::vector<uint8_t>* out,
+                             size_t size_hint = 0) {
+  // StandardMessageCodec type tag for maps.
+  constexpr uint8_t kMapTag = 13;
+
+  out->clear();
+  out->reserve(size_hint + method.size() + 64);
+  VectorStreamWriter stream(out);
+  const auto& serializer = flutter::StandardCodecSerializer::GetInstance();
+
+  serializer.WriteValue(flutter::EncodableValue(method), &stream);
+
+  // Map header: tag, then the entry count. Counts under 254 are a single
+  // byte in the codec's size encoding; argument lists here are a handful.
+  stream.WriteByte(kMapTag);
+  stream.WriteByte(static_cast<uint8_t>(args.size()));
+  const flutter::EncodableValue empty_map{flutter::EncodableMap{}};
+  for (const auto& [key, value] : args) {
+    serializer.WriteValue(flutter::EncodableValue(key), &stream);
+    serializer.WriteValue(value ? *value : empty_map, &stream);
+  }
+}
+
+}  // namespace floating_palette
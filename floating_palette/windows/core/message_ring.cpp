@@ -0,0 +1,191 @@
+#include "message_ring.h"
+
+#include <climits>
+#include <cstring>
+
+#include "logger.h"
+
+namespace floating_palette {
+
+namespace {
+
+uint32_t RoundCapacity(uint32_t requested) {
+  uint32_t capacity = MessageRing::kMinCapacity;
+  while (capacity < requested && capacity < MessageRing::kMaxCapacity) {
+    capacity <<= 1;
+  }
+  return capacity;
+}
+
+}  // namespace
+
+MessageRing::MessageRing(uint32_t capacity)
+    : capacity_(RoundCapacity(capacity)),
+      data_(std::make_unique<uint8_t[]>(capacity_)) {}
+
+MessageRingWriteResult MessageRing::Write(const uint8_t* data,
+                                          uint32_t length) {
+  uint64_t need = RecordBytes(length);
+  if (need > capacity_) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return MessageRingWriteResult::kDropped;
+  }
+
+  uint64_t write = write_pos_.load(std::memory_order_relaxed);
+  uint64_t read = read_pos_.load(std::memory_order_acquire);
+  uint64_t offset = write & (capacity_ - 1);
+  // Records never straddle the end: skip the tail (always >= 8 bytes, as
+  // offsets are 8-aligned) behind a wrap marker.
+  uint64_t tail = capacity_ - offset;
+  uint64_t skip = tail < need ? tail : 0;
+  if (write + skip + need - read > capacity_) {
+    overflowed_.fetch_add(1, std::memory_order_relaxed);
+    return MessageRingWriteResult::kOverflowed;
+  }
+  if (skip) {
+    std::memcpy(data_.get() + offset, &kWrapMarker, kHeaderBytes);
+    write += skip;
+    offset = 0;
+  }
+  std::memcpy(data_.get() + offset, &length, kHeaderBytes);
+  if (length) std::memcpy(data_.get() + offset + kHeaderBytes, data, length);
+
+  // seq_cst pairs with the consumer arming the doorbell and re-checking
+  // write_pos_, so a write can't slip between its check and its arm
+  // without one side seeing the other.
+  write_pos_.store(write + need, std::memory_order_seq_cst);
+  sent_.fetch_add(1, std::memory_order_relaxed);
+
+  if (doorbell_armed_.load(std::memory_order_seq_cst) &&
+      doorbell_armed_.exchange(0, std::memory_order_seq_cst)) {
+    if (MessageRingDoorbell doorbell =
+            doorbell_.load(std::memory_order_acquire)) {
+      doorbell();
+    }
+  }
+  return MessageRingWriteResult::kOk;
+}
+
+MessageRingReadResult MessageRing::Read(uint8_t* out, uint32_t out_capacity,
+                                        uint32_t* out_length) {
+  for (;;) {
+    uint64_t read = read_pos_.load(std::memory_order_relaxed);
+    uint64_t write = write_pos_.load(std::memory_order_acquire);
+    if (read == write) {
+      if (doorbell_armed_.load(std::memory_order_relaxed)) {
+        return MessageRingReadResult::kEmpty;
+      }
+      doorbell_armed_.store(1, std::memory_order_seq_cst);
+      if (write_pos_.load(std::memory_order_seq_cst) == read) {
+        return MessageRingReadResult::kEmpty;
+      }
+      // A write landed before the arm was visible; take it now. The
+      // doorbell stays armed, so at worst the consumer gets one spurious
+      // wakeup and finds the ring empty.
+      continue;
+    }
+
+    uint64_t offset = read & (capacity_ - 1);
+    uint32_t length;
+    std::memcpy(&length, data_.get() + offset, kHeaderBytes);
+    if (length == kWrapMarker) {
+      read_pos_.store(read + (capacity_ - offset), std::memory_order_release);
+      continue;
+    }
+    *out_length = length;
+    if (length > out_capacity) return MessageRingReadResult::kTooSmall;
+    if (length) std::memcpy(out, data_.get() + offset + kHeaderBytes, length);
+    read_pos_.store(read + RecordBytes(length), std::memory_order_release);
+    received_.fetch_add(1, std::memory_order_relaxed);
+    return MessageRingReadResult::kOk;
+  }
+}
+
+void MessageRing::SetDoorbell(MessageRingDoorbell doorbell) {
+  doorbell_.store(doorbell, std::memory_order_release);
+}
+
+MessageRing::Stats MessageRing::GetStats() const {
+  return {sent_.load(std::memory_order_relaxed),
+          received_.load(std::memory_order_relaxed),
+          dropped_.load(std::memory_order_relaxed),
+          overflowed_.load(std::memory_order_relaxed)};
+}
+
+// static
+MessageRings& MessageRings::Instance() {
+  static MessageRings rings;
+  return rings;
+}
+
+MessageRing* MessageRings::Open(const std::string& window_id,
+                                int32_t channel, uint32_t capacity) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Entry& entry = rings_[{window_id, channel}];
+  if (!entry.ring) {
+    entry.ring = std::make_unique<MessageRing>(capacity);
+    FP_LOG("Message", "ring created ", window_id, " channel ", channel,
+           " capacity ", entry.ring->capacity());
+  }
+  ++entry.opens;
+  return entry.ring.get();
+}
+
+void MessageRings::Close(const MessageRing* ring) {
+  if (!ring) return;
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& [key, entry] : rings_) {
+    if (entry.ring.get() == ring) {
+      if (entry.opens) --entry.opens;
+      return;
+    }
+  }
+  for (auto it = retired_.begin(); it != retired_.end(); ++it) {
+    if (it->ring.get() != ring) continue;
+    if (--it->opens == 0) retired_.erase(it);
+    return;
+  }
+}
+
+void MessageRings::Destroy(const std::string& window_id, int32_t channel) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = rings_.find({window_id, channel});
+  if (it == rings_.end()) return;
+  RetireLocked(std::move(it->second));
+  rings_.erase(it);
+}
+
+void MessageRings::DestroyAll(const std::string& window_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = rings_.lower_bound({window_id, INT32_MIN});
+  while (it != rings_.end() && it->first.first == window_id) {
+    RetireLocked(std::move(it->second));
+    it = rings_.erase(it);
+  }
+}
+
+void MessageRings::RetireLocked(Entry entry) {
+  if (entry.opens) retired_.push_back(std::move(entry));
+}
+
+MessageRing::Stats MessageRings::TotalStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  MessageRing::Stats total{0, 0, 0, 0};
+  auto add = [&total](const Entry& entry) {
+    MessageRing::Stats stats = entry.ring->GetStats();
+    total.sent += stats.sent;
+    total.received += stats.received;
+    total.dropped += stats.dropped;
+    total.overflowed += stats.overflowed;
+  };
+  for (const auto& entry : rings_) add(entry.second);
+  for (const auto& entry : retired_) add(entry);
+  return total;
+}
+
+size_t MessageRings::ring_count() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return rings_.size() + retired_.size();
+}
+
+}  // namespace floating_palette
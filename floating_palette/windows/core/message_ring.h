@@ -0,0 +1,155 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace floating_palette {
+
+/// Invoked after a write when the consumer has asked to be woken (see
+/// MessageRing::Read). Dart passes a NativeCallable.listener, which may be
+/// called from any thread and posts to the consumer's isolate.
+using MessageRingDoorbell = void (*)(void);
+
+/// Outcome of MessageRing::Write (FFI values; keep in sync with Dart).
+enum class MessageRingWriteResult : int32_t {
+  kOk = 0,
+  /// Ring full right now; the message was not written.
+  kOverflowed = 1,
+  /// Message larger than the ring can ever hold; not written.
+  kDropped = 2,
+};
+
+/// Outcome of MessageRing::Read (FFI values; keep in sync with Dart).
+enum class MessageRingReadResult : int32_t {
+  kEmpty = 0,
+  kOk = 1,
+  /// The next message doesn't fit the caller's buffer; it stays queued and
+  /// its length is reported.
+  kTooSmall = 2,
+};
+
+/// Single-producer, single-consumer byte ring shared by two isolates in
+/// this process (typically the host engine and one palette engine), so
+/// high-rate messages skip the platform thread entirely.
+///
+/// Records are a uint32 length followed by the payload, padded to 8 bytes;
+/// a record that would straddle the end is preceded by a wrap marker.
+/// Positions only grow; the producer owns `write_pos_` and the consumer
+/// `read_pos_`, each published with release / read with acquire. Same
+/// shared-memory idea as GlassPathBuffer, but accessed through FFI calls so
+/// both sides use real atomics rather than plain Dart stores.
+///
+/// Doorbell: a consumer that finds the ring empty arms it; the next write
+/// disarms it and rings once. Draining until empty before waiting again
+/// means one wakeup per burst, never one per message.
+class MessageRing {
+ public:
+  /// `capacity` is rounded up to a power of two within
+  /// [kMinCapacity, kMaxCapacity].
+  explicit MessageRing(uint32_t capacity);
+
+  static constexpr uint32_t kMinCapacity = 4 * 1024;
+  static constexpr uint32_t kMaxCapacity = 64 * 1024 * 1024;
+
+  /// Producer side.
+  MessageRingWriteResult Write(const uint8_t* data, uint32_t length);
+
+  /// Consumer side. Copies the oldest message into `out` and sets
+  /// `*out_length`. kEmpty also arms the doorbell.
+  MessageRingReadResult Read(uint8_t* out, uint32_t out_capacity,
+                             uint32_t* out_length);
+
+  /// Consumer side. Null clears it.
+  void SetDoorbell(MessageRingDoorbell doorbell);
+
+  uint32_t capacity() const { return capacity_; }
+
+  struct Stats {
+    uint64_t sent;
+    uint64_t received;
+    uint64_t dropped;
+    uint64_t overflowed;
+  };
+  Stats GetStats() const;
+
+ private:
+  static constexpr uint32_t kWrapMarker = 0xFFFFFFFFu;
+  static constexpr uint32_t kHeaderBytes = sizeof(uint32_t);
+
+  static uint64_t RecordBytes(uint32_t length) {
+    return (uint64_t{kHeaderBytes} + length + 7) & ~uint64_t{7};
+  }
+
+  const uint32_t capacity_;
+  std::unique_ptr<uint8_t[]> data_;
+
+  // Producer and consumer cursors on separate cache lines.
+  alignas(64) std::atomic<uint64_t> write_pos_{0};
+  std::atomic<uint64_t> sent_{0};
+  std::atomic<uint64_t> dropped_{0};
+  std::atomic<uint64_t> overflowed_{0};
+
+  alignas(64) std::atomic<uint64_t> read_pos_{0};
+  std::atomic<uint64_t> received_{0};
+
+  alignas(64) std::atomic<uint32_t> doorbell_armed_{0};
+  std::atomic<MessageRingDoorbell> doorbell_{nullptr};
+};
+
+/// Rings by (window id, channel). Channel 0 is host → palette, 1 is
+/// palette → host; callers may use others for palette ↔ palette links.
+/// Thread-safe.
+///
+/// Each Open is one end and must be matched by a Close; the ring pointer
+/// stays valid until then. A ring is freed only once every end has closed
+/// and it has been destroyed (Destroy, or DestroyAll when its window goes),
+/// so an isolate still inside Read or Write never sees freed memory. A
+/// destroyed ring that is still open leaves the (window id, channel) slot,
+/// so the next Open there gets a fresh ring.
+class MessageRings {
+ public:
+  static MessageRings& Instance();
+
+  /// Open an end of the ring for (window_id, channel), creating it with
+  /// `capacity` if it doesn't exist yet. The second end gets the first's
+  /// ring and its capacity.
+  MessageRing* Open(const std::string& window_id, int32_t channel,
+                    uint32_t capacity);
+
+  /// Close one end opened by Open. Unknown pointers are ignored.
+  void Close(const MessageRing* ring);
+
+  /// Free the ring once both ends have closed it.
+  void Destroy(const std::string& window_id, int32_t channel);
+  /// Destroy every ring of a window. Call after its engine has shut down,
+  /// so the palette's ends are closed.
+  void DestroyAll(const std::string& window_id);
+
+  /// Totals across rings that haven't been freed.
+  MessageRing::Stats TotalStats() const;
+  size_t ring_count() const;
+
+ private:
+  MessageRings() = default;
+
+  struct Entry {
+    std::unique_ptr<MessageRing> ring;
+    uint32_t opens = 0;
+  };
+
+  /// Frees `entry` if no end has it open, else moves it to `retired_`.
+  void RetireLocked(Entry entry);
+
+  mutable std::mutex mutex_;
+  std::map<std::pair<std::string, int32_t>, Entry> rings_;
+  /// Destroyed rings waiting for their last end to close.
+  std::vector<Entry> retired_;
+};
+
+}  // namespace floating_palette
@@ -0,0 +1,183 @@
+#include "metrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+
+#include "clock.h"
+#include "command_hash.h"
+
+namespace floating_palette {
+
+namespace {
+
+// Slot order for MetricsSnapshot::services; the last one is "other".
+constexpr const char* kServiceNames[MetricsSnapshot::kServiceCount] = {
+    "window",     "visibility", "frame",  "transform",
+    "animation",  "input",      "focus",  "zorder",
+    "appearance", "screen",     "backgroundCapture",
+    "message",    "host",       "snap",   "hotkey",
+    "other",
+};
+
+size_t ServiceIndex(uint64_t service_hash) {
+  switch (service_hash) {
+    case HashCommand("window"): return 0;
+    case HashCommand("visibility"): return 1;
+    case HashCommand("frame"): return 2;
+    case HashCommand("transform"): return 3;
+    case HashCommand("animation"): return 4;
+    case HashCommand("input"): return 5;
+    case HashCommand("focus"): return 6;
+    case HashCommand("zorder"): return 7;
+    case HashCommand("appearance"): return 8;
+    case HashCommand("screen"): return 9;
+    case HashCommand("backgroundCapture"): return 10;
+    case HashCommand("message"): return 11;
+    case HashCommand("host"): return 12;
+    case HashCommand("snap"): return 13;
+    case HashCommand("hotkey"): return 14;
+    default: return MetricsSnapshot::kServiceCount - 1;
+  }
+}
+
+// Bucket 0 is under 1 us; bucket i > 0 covers [2^((i-1)/4), 2^(i/4)) us.
+size_t BucketFor(double us, size_t bucket_count) {
+  if (us < 1.0) return 0;
+  auto bucket = static_cast<size_t>(std::floor(4.0 * std::log2(us))) + 1;
+  return std::min(bucket, bucket_count - 1);
+}
+
+double BucketUpperMs(size_t bucket) {
+  return std::exp2(bucket / 4.0) / 1000.0;
+}
+
+}  // namespace
+
+// static
+Metrics& Metrics::Instance() {
+  static Metrics* metrics = new Metrics();
+  return *metrics;
+}
+
+// static
+const char* Metrics::ServiceName(size_t index) {
+  return index < MetricsSnapshot::kServiceCount ? kServiceNames[index]
+                                                : nullptr;
+}
+
+void Metrics::RecordCommand(uint64_t service_hash, double seconds) {
+  ServiceCounters& service = services_[ServiceIndex(service_hash)];
+  const double us = std::max(0.0, seconds * 1e6);
+  service.commands.fetch_add(1, std::memory_order_relaxed);
+  service.buckets[BucketFor(us, kBuckets)].fetch_add(
+      1, std::memory_order_relaxed);
+
+  const auto rounded = static_cast<uint64_t>(us);
+  uint64_t max = service.max_us.load(std::memory_order_relaxed);
+  while (rounded > max && !service.max_us.compare_exchange_weak(
+                              max, rounded, std::memory_order_relaxed)) {
+  }
+}
+
+void Metrics::RecordCaptureFrame() {
+  Bump(capture_frames_);
+  const auto second = static_cast<int64_t>(MonotonicSeconds());
+  int64_t current = capture_second_.load(std::memory_order_relaxed);
+  if (second != current &&
+      capture_second_.compare_exchange_strong(current, second,
+                                              std::memory_order_relaxed)) {
+    // Whoever rolls the second over carries the finished count forward
+    // (or zero after a gap); a frame racing the rollover may land in
+    // either second.
+    uint64_t finished =
+        capture_second_frames_.exchange(0, std::memory_order_relaxed);
+    capture_previous_second_frames_.store(second == current + 1 ? finished : 0,
+                                          std::memory_order_relaxed);
+  }
+  Bump(capture_second_frames_);
+}
+
+void Metrics::Read(MetricsSnapshot* out) const {
+  for (size_t i = 0; i < MetricsSnapshot::kServiceCount; ++i) {
+    const ServiceCounters& counters = services_[i];
+    MetricsSnapshot::Service& service = out->services[i];
+
+    uint32_t buckets[kBuckets];
+    uint64_t total = 0;
+    for (size_t b = 0; b < kBuckets; ++b) {
+      buckets[b] = counters.buckets[b].load(std::memory_order_relaxed);
+      total += buckets[b];
+    }
+    service.commands = counters.commands.load(std::memory_order_relaxed);
+    service.max_ms =
+        counters.max_us.load(std::memory_order_relaxed) / 1000.0;
+    service.p50_ms = 0;
+    service.p99_ms = 0;
+    if (total == 0) continue;
+
+    // Smallest bucket covering each rank.
+    const uint64_t p50_rank = (total + 1) / 2;
+    const uint64_t p99_rank = total - total / 100;
+    uint64_t seen = 0;
+    bool have_p50 = false;
+    for (size_t b = 0; b < kBuckets; ++b) {
+      seen += buckets[b];
+      if (!have_p50 && seen >= p50_rank) {
+        service.p50_ms = BucketUpperMs(b);
+        have_p50 = true;
+      }
+      if (seen >= p99_rank) {
+        service.p99_ms = BucketUpperMs(b);
+        break;
+      }
+    }
+    // The top bucket is open-ended; don't report past what was seen.
+    service.p50_ms = std::min(service.p50_ms, service.max_ms);
+    service.p99_ms = std::min(service.p99_ms, service.max_ms);
+  }
+
+  auto load = [](const std::atomic<uint64_t>& counter) {
+    return counter.load(std::memory_order_relaxed);
+  };
+  out->events_emitted = load(events_emitted_);
+  out->events_coalesced = load(events_coalesced_);
+  out->event_flushes = load(event_flushes_);
+  out->window_pos_calls = load(window_pos_calls_);
+  out->window_pos_batches = load(window_pos_batches_);
+  out->window_pos_batched_windows = load(window_pos_batched_windows_);
+  out->animation_frames = load(animation_frames_);
+  out->animation_frames_dropped = load(animation_frames_dropped_);
+  out->capture_frames = load(capture_frames_);
+
+  // The last full second, if the capture is still running.
+  const auto now = static_cast<int64_t>(MonotonicSeconds());
+  const int64_t second = capture_second_.load(std::memory_order_relaxed);
+  if (second == now) {
+    out->capture_fps = static_cast<double>(
+        load(capture_previous_second_frames_));
+  } else if (second == now - 1) {
+    out->capture_fps = static_cast<double>(load(capture_second_frames_));
+  } else {
+    out->capture_fps = 0;
+  }
+}
+
+void Metrics::Reset() {
+  for (ServiceCounters& service : services_) {
+    service.commands.store(0, std::memory_order_relaxed);
+    service.max_us.store(0, std::memory_order_relaxed);
+    for (auto& bucket : service.buckets) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+  }
+  for (std::atomic<uint64_t>* counter :
+       {&events_emitted_, &events_coalesced_, &event_flushes_,
+        &window_pos_calls_, &window_pos_batches_,
+        &window_pos_batched_windows_, &animation_frames_,
+        &animation_frames_dropped_, &capture_frames_}) {
+    counter->store(0, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace floating_palette
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace floating_palette {
+
+/// Point-in-time copy of Metrics. Plain data, so the FFI getter can copy
+/// it straight out (see FloatingPaletteMetrics in src/ffi_interface.h).
+struct MetricsSnapshot {
+  static constexpr size_t kServiceCount = 16;
+
+  struct Service {
+    uint64_t commands = 0;
+    /// Handler time on the platform thread, milliseconds (histogram bucket
+    /// upper bounds, so within ~19% of the true value).
+    double p50_ms = 0;
+    double p99_ms = 0;
+    double max_ms = 0;
+  };
+
+  Service services[kServiceCount];
+  uint64_t events_emitted = 0;
+  uint64_t events_coalesced = 0;
+  /// Channel messages the events went out in.
+  uint64_t event_flushes = 0;
+  /// Individual SetWindowPos calls, and DeferWindowPos transactions with
+  /// the windows they moved.
+  uint64_t window_pos_calls = 0;
+  uint64_t window_pos_batches = 0;
+  uint64_t window_pos_batched_windows = 0;
+  /// AnimationEngine ticks applied, and display refreshes skipped because
+  /// the platform thread hadn't taken the previous tick yet.
+  uint64_t animation_frames = 0;
+  uint64_t animation_frames_dropped = 0;
+  /// Background capture frames published to Flutter, in total and over
+  /// the last full second (all captures together).
+  uint64_t capture_frames = 0;
+  double capture_fps = 0;
+};
+
+/// Process-wide native cost counters, cheap enough to leave on in release
+/// builds.
+///
+/// Every counter is a relaxed atomic bumped where the work happens; there
+/// are no locks and nothing allocates. Command latencies go into a
+/// per-service log-scale histogram (four buckets per power of two of
+/// microseconds), and percentiles are computed only when read. Readers on
+/// any thread get a snapshot that is consistent per counter, not across
+/// counters.
+class Metrics {
+ public:
+  static Metrics& Instance();
+
+  Metrics(const Metrics&) = delete;
+  Metrics& operator=(const Metrics&) = delete;
+
+  /// Display name of service slot `index` (the last slot collects unknown
+  /// services), or null past the end.
+  static const char* ServiceName(size_t index);
+
+  /// Platform thread. `service_hash` is HashCommand(service) for a known
+  /// service, 0 otherwise.
+  void RecordCommand(uint64_t service_hash, double seconds);
+
+  void RecordEvent() { Bump(events_emitted_); }
+  void RecordEventCoalesced() { Bump(events_coalesced_); }
+  void RecordEventFlush() { Bump(event_flushes_); }
+
+  void RecordWindowPos() { Bump(window_pos_calls_); }
+  void RecordWindowPosBatch(size_t windows) {
+    Bump(window_pos_batches_);
+    window_pos_batched_windows_.fetch_add(windows, std::memory_order_relaxed);
+  }
+
+  void RecordAnimationFrame() { Bump(animation_frames_); }
+  void RecordAnimationFrameDropped() { Bump(animation_frames_dropped_); }
+
+  /// Any capture thread.
+  void RecordCaptureFrame();
+
+  void Read(MetricsSnapshot* out) const;
+  void Reset();
+
+ private:
+  static constexpr size_t kBuckets = 96;
+
+  struct ServiceCounters {
+    std::atomic<uint64_t> commands{0};
+    std::atomic<uint64_t> max_us{0};
+    std::atomic<uint32_t> buckets[kBuckets] = {};
+  };
+
+  Metrics() = default;
+
+  static void Bump(std::atomic<uint64_t>& counter) {
+    counter.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  ServiceCounters services_[MetricsSnapshot::kServiceCount];
+  std::atomic<uint64_t> events_emitted_{0};
+  std::atomic<uint64_t> events_coalesced_{0};
+  std::atomic<uint64_t> event_flushes_{0};
+  std::atomic<uint64_t> window_pos_calls_{0};
+  std::atomic<uint64_t> window_pos_batches_{0};
+  std::atomic<uint64_t> window_pos_batched_windows_{0};
+  std::atomic<uint64_t> animation_frames_{0};
+  std::atomic<uint64_t> animation_frames_dropped_{0};
+  std::atomic<uint64_t> capture_frames_{0};
+  /// Whole MonotonicSeconds() second being counted, its frames so far, and
+  /// the count for the second before it.
+  std::atomic<int64_t> capture_second_{0};
+  std::atomic<uint64_t> capture_second_frames_{0};
+  std::atomic<uint64_t> capture_previous_second_frames_{0};
+};
+
+}  // namespace floating_palette
@@ -0,0 +1,193 @@
+#include "monitor_topology.h"
+
+#include <shellscalingapi.h>
+
+#include <algorithm>
+#include <climits>
+
+#include "logger.h"
+
+namespace floating_palette {
+
+namespace {
+
+std::string WideToUtf8(const wchar_t* wide) {
+  int length =
+      WideCharToMultiByte(CP_UTF8, 0, wide, -1, nullptr, 0, nullptr, nullptr);
+  if (length <= 1) return std::string();
+  std::string utf8(static_cast<size_t>(length - 1), '\0');
+  WideCharToMultiByte(CP_UTF8, 0, wide, -1, utf8.data(), length, nullptr,
+                      nullptr);
+  return utf8;
+}
+
+BOOL CALLBACK CollectMonitor(HMONITOR monitor, HDC, LPRECT, LPARAM data) {
+  auto* monitors = reinterpret_cast<std::vector<MonitorInfo>*>(data);
+
+  MONITORINFOEXW info = {};
+  info.cbSize = sizeof(info);
+  if (!GetMonitorInfoW(monitor, reinterpret_cast<LPMONITORINFO>(&info))) {
+    return TRUE;
+  }
+
+  MonitorInfo entry;
+  entry.monitor = monitor;
+  entry.bounds = info.rcMonitor;
+  entry.work_area = info.rcWork;
+  entry.is_primary = (info.dwFlags & MONITORINFOF_PRIMARY) != 0;
+  entry.name = WideToUtf8(info.szDevice);
+
+  UINT dpi_x = 96, dpi_y = 96;
+  if (SUCCEEDED(GetDpiForMonitor(monitor, MDT_EFFECTIVE_DPI, &dpi_x, &dpi_y))) {
+    entry.dpi = dpi_x;
+  }
+  entry.scale_factor = entry.dpi / 96.0;
+
+  monitors->push_back(std::move(entry));
+  return TRUE;
+}
+
+}  // namespace
+
+MonitorTopology::MonitorTopology()
+    : current_(std::make_shared<const Snapshot>()) {
+  Refresh();
+}
+
+void MonitorTopology::Refresh() {
+  auto snapshot = std::make_shared<Snapshot>();
+  snapshot->generation = Current()->generation + 1;
+  EnumDisplayMonitors(nullptr, nullptr, CollectMonitor,
+                      reinterpret_cast<LPARAM>(&snapshot->monitors));
+
+  std::sort(snapshot->monitors.begin(), snapshot->monitors.end(),
+            [](const MonitorInfo& a, const MonitorInfo& b) {
+              if (a.is_primary != b.is_primary) return a.is_primary;
+              if (a.bounds.left != b.bounds.left) {
+                return a.bounds.left < b.bounds.left;
+              }
+              return a.bounds.top < b.bounds.top;
+            });
+
+  BuildIndex(snapshot.get());
+
+  FP_LOG("Screen", "topology generation ", snapshot->generation, ": ",
+         snapshot->monitors.size(), " monitor(s)");
+
+  std::atomic_store_explicit(
+      &current_, std::shared_ptr<const Snapshot>(std::move(snapshot)),
+      std::memory_order_release);
+}
+
+// static
+bool MonitorTopology::IsTopologyMessage(UINT message, WPARAM wparam) {
+  switch (message) {
+    case WM_DISPLAYCHANGE:
+    case WM_DPICHANGED:
+      return true;
+    case WM_SETTINGCHANGE:
+      return wparam == SPI_SETWORKAREA;
+    default:
+      return false;
+  }
+}
+
+// static
+void MonitorTopology::BuildIndex(Snapshot* snapshot) {
+  const auto& monitors = snapshot->monitors;
+
+  snapshot->by_handle.reserve(monitors.size());
+  for (size_t i = 0; i < monitors.size(); ++i) {
+    snapshot->by_handle.emplace_back(monitors[i].monitor, static_cast<int>(i));
+  }
+  std::sort(snapshot->by_handle.begin(), snapshot->by_handle.end());
+
+  std::vector<LONG> edges;
+  edges.reserve(monitors.size() * 2);
+  for (const auto& monitor : monitors) {
+    edges.push_back(monitor.bounds.left);
+    edges.push_back(monitor.bounds.right);
+  }
+  std::sort(edges.begin(), edges.end());
+  edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+  for (size_t e = 0; e + 1 < edges.size(); ++e) {
+    Snapshot::Slab slab{edges[e], edges[e + 1], {}};
+    for (size_t i = 0; i < monitors.size(); ++i) {
+      const RECT& bounds = monitors[i].bounds;
+      if (bounds.left <= slab.left && bounds.right >= slab.right) {
+        slab.spans.push_back({bounds.top, bounds.bottom, static_cast<int>(i)});
+      }
+    }
+    // Gaps between monitors leave empty slabs; keep them so the slab
+    // search stays a plain binary search over contiguous edges.
+    std::sort(slab.spans.begin(), slab.spans.end(),
+              [](const Snapshot::Span& a, const Snapshot::Span& b) {
+                return a.top < b.top;
+              });
+    snapshot->slabs.push_back(std::move(slab));
+  }
+}
+
+int MonitorTopology::Snapshot::IndexOf(HMONITOR monitor) const {
+  auto it = std::lower_bound(
+      by_handle.begin(), by_handle.end(), monitor,
+      [](const std::pair<HMONITOR, int>& entry, HMONITOR value) {
+        return entry.first < value;
+      });
+  return it != by_handle.end() && it->first == monitor ? it->second : -1;
+}
+
+int MonitorTopology::Snapshot::IndexAtPoint(POINT point) const {
+  // Last slab whose left edge is <= x.
+  auto slab = std::upper_bound(
+      slabs.begin(), slabs.end(), point.x,
+      [](LONG x, const Slab& s) { return x < s.left; });
+  if (slab == slabs.begin()) return -1;
+  --slab;
+  if (point.x >= slab->right) return -1;
+
+  const auto& spans = slab->spans;
+  auto span = std::upper_bound(
+      spans.begin(), spans.end(), point.y,
+      [](LONG y, const Span& s) { return y < s.top; });
+  if (span == spans.begin()) return -1;
+  --span;
+  return point.y < span->bottom ? span->index : -1;
+}
+
+int MonitorTopology::Snapshot::IndexForRect(const RECT& rect) const {
+  POINT center = {rect.left + (rect.right - rect.left) / 2,
+                  rect.top + (rect.bottom - rect.top) / 2};
+  int index = IndexAtPoint(center);
+  if (index >= 0) return index;
+
+  // Center is off-screen (straddling a gap or outside the desktop).
+  int64_t best_area = 0;
+  int64_t best_distance = INT64_MAX;
+  int nearest = -1;
+  for (size_t i = 0; i < monitors.size(); ++i) {
+    const RECT& bounds = monitors[i].bounds;
+    RECT overlap;
+    if (IntersectRect(&overlap, &rect, &bounds)) {
+      int64_t area = static_cast<int64_t>(overlap.right - overlap.left) *
+                     (overlap.bottom - overlap.top);
+      if (area > best_area) {
+        best_area = area;
+        index = static_cast<int>(i);
+      }
+    }
+    int64_t dx = std::max<int64_t>(
+        {0, bounds.left - center.x, center.x - bounds.right});
+    int64_t dy = std::max<int64_t>(
+        {0, bounds.top - center.y, center.y - bounds.bottom});
+    int64_t distance = dx * dx + dy * dy;
+    if (distance < best_distance) {
+      best_distance = distance;
+      nearest = static_cast<int>(i);
+    }
+  }
+  return index >= 0 ? index : nearest;
+}
+
+}  // namespace floating_palette
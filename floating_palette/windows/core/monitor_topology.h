@@ -0,0 +1,118 @@
+#pragma once
+
+#include <windows.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace floating_palette {
+
+/// One connected monitor, in physical virtual-screen pixels.
+struct MonitorInfo {
+  HMONITOR monitor = nullptr;
+  RECT bounds = {};
+  /// Bounds minus the taskbar and docked app bars.
+  RECT work_area = {};
+  UINT dpi = 96;
+  double scale_factor = 1.0;
+  bool is_primary = false;
+  std::string name;
+};
+
+/// Cached monitor topology.
+///
+/// Enumerated once and then only on display, DPI or work-area changes
+/// (ScreenService feeds it those messages). Readers get an immutable
+/// snapshot through an atomic shared_ptr, so FFI queries cost a load and an
+/// index instead of EnumDisplayMonitors/GetDpiForMonitor. A reader on any
+/// thread keeps its snapshot alive for as long as it holds the pointer, so
+/// a refresh never frees one out from under it.
+///
+/// Screen indexes are stable for a given topology: the primary monitor is
+/// 0, the rest are ordered by left then top edge.
+class MonitorTopology {
+ public:
+  struct Snapshot {
+    uint64_t generation = 0;
+    std::vector<MonitorInfo> monitors;
+
+    /// (HMONITOR, index) sorted by handle, for binary-search IndexOf.
+    std::vector<std::pair<HMONITOR, int>> by_handle;
+
+    /// Vertical slabs between consecutive distinct monitor left/right
+    /// edges. Monitors don't overlap, so within a slab the covering
+    /// monitors are disjoint in y and sorted by top: a point lookup is two
+    /// binary searches.
+    struct Span {
+      LONG top;
+      LONG bottom;
+      int index;
+    };
+    struct Slab {
+      LONG left;
+      LONG right;
+      std::vector<Span> spans;
+    };
+    std::vector<Slab> slabs;
+
+    /// Index of `monitor`, or -1. O(log n).
+    int IndexOf(HMONITOR monitor) const;
+
+    /// Index of the monitor containing `point`, or -1 if none does.
+    /// O(log n), no Win32 calls.
+    int IndexAtPoint(POINT point) const;
+
+    /// Index of the monitor a window with bounds `rect` belongs on: the one
+    /// containing its center, else the one it overlaps most, else the
+    /// nearest (MONITOR_DEFAULTTONEAREST semantics). -1 only if there are
+    /// no monitors. No Win32 calls.
+    int IndexForRect(const RECT& rect) const;
+  };
+
+  static MonitorTopology& Instance() {
+    static MonitorTopology topology;
+    return topology;
+  }
+
+  /// Current snapshot, owned jointly with the caller. Take it once and
+  /// resolve both an index and the monitor it names from it; two calls
+  /// may straddle a refresh.
+  std::shared_ptr<const Snapshot> Current() const {
+    return std::atomic_load_explicit(&current_, std::memory_order_acquire);
+  }
+
+  /// Bumped on every refresh; compare to detect topology changes.
+  uint64_t generation() const {
+    return Current()->generation;
+  }
+
+  /// Re-enumerate monitors and publish a new snapshot. Platform thread only.
+  void Refresh();
+
+  /// Whether a top-level window message invalidates the topology.
+  static bool IsTopologyMessage(UINT message, WPARAM wparam);
+
+  /// Snapshot lookups against the current snapshot, for callers that only
+  /// need the index.
+  int IndexOf(HMONITOR monitor) const { return Current()->IndexOf(monitor); }
+  int IndexAtPoint(POINT point) const {
+    return Current()->IndexAtPoint(point);
+  }
+  int IndexForRect(const RECT& rect) const {
+    return Current()->IndexForRect(rect);
+  }
+
+ private:
+  MonitorTopology();
+
+  static void BuildIndex(Snapshot* snapshot);
+
+  // Only touched through std::atomic_load/atomic_store.
+  std::shared_ptr<const Snapshot> current_;
+};
+
+}  // namespace floating_palette
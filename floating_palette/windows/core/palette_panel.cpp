@@ -0,0 +1,446 @@
+#include "palette_panel.h"
+
+#include <flutter_windows.h>
+#include <windowsx.h>
+
+#include <cmath>
+#include <cstring>
+
+#include "desktop_capture.h"
+#include "logger.h"
+#include "metrics.h"
+#include "monitor_topology.h"
+#include "reveal_pipeline.h"
+#include "window_store.h"
+
+namespace floating_palette {
+
+namespace {
+
+constexpr wchar_t kPanelClassName[] = L"FloatingPalettePanel";
+// Window property holding the Flutter view's original window procedure.
+constexpr wchar_t kViewProcProperty[] = L"FloatingPaletteViewProc";
+
+// See PalettePanel::ZOrderEpoch. Platform thread only.
+uint64_t zorder_epoch = 0;
+
+uint64_t PackSize(double width, double height) {
+  float w = static_cast<float>(width);
+  float h = static_cast<float>(height);
+  uint32_t w_bits, h_bits;
+  std::memcpy(&w_bits, &w, sizeof(w_bits));
+  std::memcpy(&h_bits, &h, sizeof(h_bits));
+  return (static_cast<uint64_t>(w_bits) << 32) | h_bits;
+}
+
+void UnpackSize(uint64_t packed, float* width, float* height) {
+  uint32_t w_bits = static_cast<uint32_t>(packed >> 32);
+  uint32_t h_bits = static_cast<uint32_t>(packed);
+  std::memcpy(width, &w_bits, sizeof(w_bits));
+  std::memcpy(height, &h_bits, sizeof(h_bits));
+}
+
+/// Share of `rect` on monitors at `dpi`.
+double ShareAtDpi(const RECT& rect, UINT dpi) {
+  const double area = static_cast<double>(rect.right - rect.left) *
+                      (rect.bottom - rect.top);
+  if (area <= 0) return 0;
+  double covered = 0;
+  const auto topology = MonitorTopology::Instance().Current();
+  for (const MonitorInfo& monitor : topology->monitors) {
+    RECT overlap;
+    if (monitor.dpi == dpi &&
+        IntersectRect(&overlap, &rect, &monitor.bounds)) {
+      covered += static_cast<double>(overlap.right - overlap.left) *
+                 (overlap.bottom - overlap.top);
+    }
+  }
+  return covered / area;
+}
+
+}  // namespace
+
+void PalettePanel::RegisterClassOnce() {
+  static bool registered = false;
+  if (registered) return;
+
+  WNDCLASSEXW wc = {};
+  wc.cbSize = sizeof(wc);
+  wc.style = CS_HREDRAW | CS_VREDRAW;
+  wc.lpfnWndProc = WndProc;
+  wc.hInstance = GetModuleHandle(nullptr);
+  wc.hCursor = LoadCursor(nullptr, IDC_ARROW);
+  wc.lpszClassName = kPanelClassName;
+  RegisterClassExW(&wc);
+  registered = true;
+}
+
+HWND PalettePanel::Create(PaletteWindow* window, int width, int height) {
+  RegisterClassOnce();
+
+  HWND hwnd = CreateWindowExW(
+      WS_EX_TOOLWINDOW | WS_EX_NOACTIVATE | WS_EX_TOPMOST, kPanelClassName,
+      L"", WS_POPUP | WS_CLIPCHILDREN, 0, 0, width, height, nullptr, nullptr,
+      GetModuleHandle(nullptr), nullptr);
+  if (!hwnd) {
+    FP_LOG("Window", "CreateWindowExW failed");
+    return nullptr;
+  }
+  SetWindowLongPtr(hwnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(window));
+  window->layout_dpi = GetDpiForWindow(hwnd);
+  // Creation-time WM_WINDOWPOSCHANGED came before the user data was set.
+  window->frame.Refresh(hwnd, window->layout_dpi);
+  return hwnd;
+}
+
+void PalettePanel::AttachView(HWND panel, HWND view) {
+  SetParent(view, panel);
+  if (!GetPropW(view, kViewProcProperty)) {
+    auto original = SetWindowLongPtr(view, GWLP_WNDPROC,
+                                     reinterpret_cast<LONG_PTR>(ViewWndProc));
+    SetPropW(view, kViewProcProperty, reinterpret_cast<HANDLE>(original));
+  }
+  RECT client;
+  GetClientRect(panel, &client);
+  MoveWindow(view, 0, 0, client.right - client.left,
+             client.bottom - client.top, TRUE);
+  ShowWindow(view, SW_SHOW);
+}
+
+PaletteWindow* PalettePanel::FromHwnd(HWND hwnd) {
+  return reinterpret_cast<PaletteWindow*>(
+      GetWindowLongPtr(hwnd, GWLP_USERDATA));
+}
+
+// static
+bool PalettePanel::IsPanel(HWND hwnd) {
+  wchar_t class_name[64];
+  return GetClassNameW(hwnd, class_name, 64) > 0 &&
+         wcscmp(class_name, kPanelClassName) == 0;
+}
+
+// static
+void PalettePanel::SetClickThrough(HWND hwnd, PaletteWindow& window,
+                                   bool enabled) {
+  HitTestMask& mask = window.hit_test;
+  if (mask.click_through == enabled) return;
+  mask.click_through = enabled;
+
+  LONG ex_style = GetWindowLong(hwnd, GWL_EXSTYLE);
+  if (enabled) {
+    // WS_EX_TRANSPARENT only passes clicks to other windows when layered.
+    if (!(ex_style & WS_EX_LAYERED)) {
+      ex_style |= WS_EX_LAYERED;
+      SetWindowLong(hwnd, GWL_EXSTYLE, ex_style);
+      SetLayeredWindowAttributes(hwnd, 0, 255, LWA_ALPHA);
+      mask.added_layered = true;
+    }
+    SetWindowLong(hwnd, GWL_EXSTYLE, ex_style | WS_EX_TRANSPARENT);
+    return;
+  }
+  ex_style &= ~WS_EX_TRANSPARENT;
+  if (mask.added_layered) {
+    mask.added_layered = false;
+    // Keep the layer if an opacity animation has since used it.
+    BYTE alpha = 255;
+    DWORD flags = 0;
+    GetLayeredWindowAttributes(hwnd, nullptr, &alpha, &flags);
+    if (alpha == 255) ex_style &= ~WS_EX_LAYERED;
+  }
+  SetWindowLong(hwnd, GWL_EXSTYLE, ex_style);
+}
+
+// static
+bool PalettePanel::PassesThrough(PaletteWindow& window, POINT screen) {
+  FrameSnapshot frame;
+  if (!window.frame.Load(&frame) || !PtInRect(&frame.physical, screen)) {
+    return false;
+  }
+  // Borderless popup: the window and client origins coincide.
+  const float scale = frame.dpi / 96.0f;
+  return window.hit_test.PassesThrough(
+      (screen.x - frame.physical.left) / scale,
+      (screen.y - frame.physical.top) / scale);
+}
+
+// static
+ResizeStats& PalettePanel::Stats() {
+  static ResizeStats stats;
+  return stats;
+}
+
+// static
+uint64_t PalettePanel::ZOrderEpoch() { return zorder_epoch; }
+
+// static
+void PalettePanel::RequestResize(PaletteWindow& window, double width,
+                                 double height) {
+  auto& stats = Stats();
+  stats.requested.fetch_add(1, std::memory_order_relaxed);
+  window.pending_size.store(PackSize(width, height),
+                            std::memory_order_release);
+  if (window.resize_posted.exchange(true, std::memory_order_acq_rel)) {
+    // An apply is already queued; it will pick up this size instead.
+    stats.coalesced.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  if (!window.hwnd || !PostMessage(window.hwnd, kApplyResizeMessage, 0, 0)) {
+    window.resize_posted.store(false, std::memory_order_release);
+  }
+}
+
+// static
+void PalettePanel::ApplyPendingResize(HWND hwnd, PaletteWindow* window) {
+  // Clear first: a request racing this apply posts again rather than being
+  // lost (at worst that later apply finds the size unchanged).
+  window->resize_posted.store(false, std::memory_order_release);
+  auto& stats = Stats();
+  if (window->dpi_settling || window->held_dpi) {
+    // Measured at the old scale, or about to be: apply the latest size
+    // once the DPI change has settled instead of resizing mid-crossing.
+    window->resize_deferred = true;
+    stats.deferred.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  float width, height;
+  UnpackSize(window->pending_size.load(std::memory_order_acquire), &width,
+             &height);
+
+  double scale = window->layout_dpi / 96.0;
+  int physical_width = static_cast<int>(std::lround(width * scale));
+  int physical_height = static_cast<int>(std::lround(height * scale));
+
+  RECT rect;
+  GetWindowRect(hwnd, &rect);
+  if (rect.right - rect.left == physical_width &&
+      rect.bottom - rect.top == physical_height) {
+    stats.unchanged.fetch_add(1, std::memory_order_relaxed);
+    if (window->is_pending_reveal) {
+      RevealPipeline::Instance().ContentSized(*window, false);
+    }
+    return;
+  }
+
+  // Keep the top-left fixed. NOCOPYBITS: the old client bits are stale at
+  // the new size, and Flutter repaints the whole surface anyway.
+  SetWindowPos(hwnd, nullptr, 0, 0, physical_width, physical_height,
+               SWP_NOMOVE | SWP_NOZORDER | SWP_NOOWNERZORDER |
+                   SWP_NOACTIVATE | SWP_NOCOPYBITS);
+  Metrics::Instance().RecordWindowPos();
+  stats.applied.fetch_add(1, std::memory_order_relaxed);
+  if (window->is_pending_reveal) {
+    RevealPipeline::Instance().ContentSized(*window, true);
+  }
+}
+
+// static
+SIZE PalettePanel::ContentSizeAt(HWND hwnd, const PaletteWindow& window,
+                                 UINT dpi) {
+  RECT rect = {};
+  GetWindowRect(hwnd, &rect);
+  const UINT from = window.layout_dpi ? window.layout_dpi : 96;
+  // Borderless popup: no non-client area, so the whole window scales.
+  return SIZE{MulDiv(rect.right - rect.left, dpi, from),
+              MulDiv(rect.bottom - rect.top, dpi, from)};
+}
+
+// static
+void PalettePanel::OnDpiChanged(HWND hwnd, PaletteWindow& window, UINT dpi,
+                                const RECT& suggested) {
+  if (window.dpi_held) {
+    // Settled by the drag; a change back to the laid-out DPI cancels.
+    window.held_dpi = dpi == window.layout_dpi ? 0 : dpi;
+    return;
+  }
+  if (dpi == window.layout_dpi) return;
+  ApplyDpi(hwnd, window, dpi, POINT{suggested.left, suggested.top}, false);
+}
+
+// static
+void PalettePanel::ApplyDpi(HWND hwnd, PaletteWindow& window, UINT dpi,
+                            POINT origin, bool notify_view) {
+  const SIZE size = ContentSizeAt(hwnd, window, dpi);
+  window.layout_dpi = dpi;
+  window.held_dpi = 0;
+  // Resizes arriving until the settle timer fires were measured around
+  // the change; the latest is applied then, once.
+  window.dpi_settling = true;
+  SetTimer(hwnd, kDpiSettleTimer, kDpiSettleMs, nullptr);
+
+  SetWindowPos(hwnd, nullptr, origin.x, origin.y, size.cx, size.cy,
+               SWP_NOZORDER | SWP_NOOWNERZORDER | SWP_NOACTIVATE);
+  Metrics::Instance().RecordWindowPos();
+  Stats().dpi_changes.fetch_add(1, std::memory_order_relaxed);
+  if (notify_view) {
+    if (HWND view = GetWindow(hwnd, GW_CHILD)) {
+      SendMessage(view, WM_DPICHANGED_AFTERPARENT, 0, 0);
+    }
+  }
+}
+
+// static
+bool PalettePanel::ApplyHeldDpi(HWND hwnd, PaletteWindow& window,
+                                POINT pivot, RECT* frame) {
+  RECT rect;
+  if (!window.held_dpi || !GetWindowRect(hwnd, &rect)) return false;
+  const UINT dpi = window.held_dpi;
+  const UINT from = window.layout_dpi ? window.layout_dpi : 96;
+  // About the pivot, so the point under the cursor stays under it.
+  const POINT origin{pivot.x + MulDiv(rect.left - pivot.x, dpi, from),
+                     pivot.y + MulDiv(rect.top - pivot.y, dpi, from)};
+  ApplyDpi(hwnd, window, dpi, origin, true);
+  if (frame) GetWindowRect(hwnd, frame);
+  return true;
+}
+
+// static
+void PalettePanel::HoldDpi(PaletteWindow& window) { window.dpi_held = true; }
+
+// static
+bool PalettePanel::SettleDpi(HWND hwnd, PaletteWindow& window, POINT pivot,
+                             RECT* frame) {
+  RECT rect;
+  if (!window.dpi_held || !window.held_dpi || !GetWindowRect(hwnd, &rect) ||
+      ShareAtDpi(rect, window.held_dpi) < kDpiApplyShare) {
+    return false;
+  }
+  return ApplyHeldDpi(hwnd, window, pivot, frame);
+}
+
+// static
+bool PalettePanel::ReleaseDpi(HWND hwnd, PaletteWindow& window, POINT pivot,
+                              RECT* frame) {
+  if (!window.dpi_held) return false;
+  window.dpi_held = false;
+  return ApplyHeldDpi(hwnd, window, pivot, frame);
+}
+
+// static
+LRESULT CALLBACK PalettePanel::WndProc(HWND hwnd, UINT message, WPARAM wparam,
+                                       LPARAM lparam) {
+  PaletteWindow* window = FromHwnd(hwnd);
+
+  // The panel owns its size across DPI changes; answered before Flutter,
+  // which may consume the messages.
+  if (window && message == WM_GETDPISCALEDSIZE) {
+    *reinterpret_cast<SIZE*>(lparam) =
+        ContentSizeAt(hwnd, *window, static_cast<UINT>(wparam));
+    return TRUE;
+  }
+  if (window && message == WM_DPICHANGED) {
+    OnDpiChanged(hwnd, *window, LOWORD(wparam),
+                 *reinterpret_cast<const RECT*>(lparam));
+    return 0;
+  }
+
+  // Give Flutter first look (DPI, font and theme changes).
+  if (window && window->view_controller) {
+    LRESULT result;
+    if (FlutterDesktopViewControllerHandleTopLevelWindowProc(
+            window->view_controller, hwnd, message, wparam, lparam,
+            &result)) {
+      return result;
+    }
+  }
+
+  switch (message) {
+    case kApplyResizeMessage:
+      if (window) ApplyPendingResize(hwnd, window);
+      return 0;
+    case WM_SIZE: {
+      HWND child = GetWindow(hwnd, GW_CHILD);
+      if (!child || wparam == SIZE_MINIMIZED) return 0;
+      // A suspended view stays shrunk until EngineHibernation::Wake.
+      if (window && window->suspended) return 0;
+      // Only relayout Flutter when the client size actually changed;
+      // position-only and repeated WM_SIZEs would otherwise each trigger a
+      // full resize of the view.
+      RECT client;
+      GetClientRect(child, &client);
+      int width = LOWORD(lparam);
+      int height = HIWORD(lparam);
+      if (client.right - client.left != width ||
+          client.bottom - client.top != height) {
+        MoveWindow(child, 0, 0, width, height, TRUE);
+      }
+      return 0;
+    }
+    case WM_NCHITTEST:
+      // Reached after the Flutter view answered HTTRANSPARENT, or on the
+      // panel's own pixels. HTTRANSPARENT hands the point on to the
+      // windows beneath on this thread.
+      if (window && PassesThrough(*window, {GET_X_LPARAM(lparam),
+                                            GET_Y_LPARAM(lparam)})) {
+        return HTTRANSPARENT;
+      }
+      break;
+    case WM_TIMER:
+      if (wparam == kDpiSettleTimer) {
+        KillTimer(hwnd, kDpiSettleTimer);
+        if (window) {
+          window->dpi_settling = false;
+          if (window->resize_deferred) {
+            window->resize_deferred = false;
+            ApplyPendingResize(hwnd, window);
+          }
+        }
+        return 0;
+      }
+      break;
+    case WM_WINDOWPOSCHANGED:
+      if (window) {
+        window->frame.Refresh(hwnd, window->layout_dpi);
+        window->composition.Sync(*window);
+      }
+      if (!(reinterpret_cast<const WINDOWPOS*>(lparam)->flags &
+            SWP_NOZORDER)) {
+        ++zorder_epoch;
+      }
+      // Background capture regions follow the window.
+      DesktopCapture::WindowMoved(hwnd);
+      break;  // DefWindowProc still sends WM_SIZE / WM_MOVE.
+    case WM_ENTERSIZEMOVE:
+      DesktopCapture::SetInteractive(hwnd, true);
+      break;
+    case WM_EXITSIZEMOVE:
+      DesktopCapture::SetInteractive(hwnd, false);
+      break;
+    case WM_SETFOCUS: {
+      HWND child = GetWindow(hwnd, GW_CHILD);
+      if (child) SetFocus(child);
+      return 0;
+    }
+    case WM_CLOSE:
+      // Palettes are destroyed by WindowService, never by the user.
+      return 0;
+  }
+  return DefWindowProc(hwnd, message, wparam, lparam);
+}
+
+// static
+LRESULT CALLBACK PalettePanel::ViewWndProc(HWND hwnd, UINT message,
+                                           WPARAM wparam, LPARAM lparam) {
+  auto original =
+      reinterpret_cast<WNDPROC>(GetPropW(hwnd, kViewProcProperty));
+  if (message == WM_NCHITTEST) {
+    // Unset (0) while the window is being released.
+    PaletteWindow* window = FromHwnd(GetParent(hwnd));
+    if (window && PassesThrough(*window, {GET_X_LPARAM(lparam),
+                                          GET_Y_LPARAM(lparam)})) {
+      return HTTRANSPARENT;  // Falls through to the panel.
+    }
+  } else if (message == WM_DPICHANGED_AFTERPARENT) {
+    // A held change (see HoldDpi) reaches the view when it is applied.
+    PaletteWindow* window = FromHwnd(GetParent(hwnd));
+    if (window && window->dpi_held &&
+        GetDpiForWindow(hwnd) != window->layout_dpi) {
+      return 0;
+    }
+  } else if (message == WM_NCDESTROY) {
+    SetWindowLongPtr(hwnd, GWLP_WNDPROC, reinterpret_cast<LONG_PTR>(original));
+    RemovePropW(hwnd, kViewProcProperty);
+  }
+  return CallWindowProc(original, hwnd, message, wparam, lparam);
+}
+
+}  // namespace floating_palette
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <windows.h>
+
+#include <atomic>
+#include <cstdint>
+
+namespace floating_palette {
+
+struct PaletteWindow;
+
+/// Counters for the FFI resize path (SizeReporter).
+struct ResizeStats {
+  /// Resize requests received.
+  std::atomic<uint64_t> requested{0};
+  /// Requests superseded by a newer one before being applied.
+  std::atomic<uint64_t> coalesced{0};
+  /// Applies skipped because the physical size was already current.
+  std::atomic<uint64_t> unchanged{0};
+  /// SetWindowPos calls actually made.
+  std::atomic<uint64_t> applied{0};
+  /// Applies held back until a DPI transition settled.
+  std::atomic<uint64_t> deferred{0};
+  /// DPI changes applied to a panel's size (once per monitor crossing).
+  std::atomic<uint64_t> dpi_changes{0};
+};
+
+/// Top-level host window for a palette's Flutter view.
+///
+/// Borderless, non-activating tool window (no taskbar button). The Flutter
+/// view HWND is re-parented into it and kept sized to the client area.
+/// GWLP_USERDATA holds the owning PaletteWindow.
+///
+/// Content-driven resizes arrive from the Dart UI thread via FFI. They are
+/// recorded on the window and applied on the platform thread by a posted
+/// message, so every request that lands before the platform thread gets to
+/// it collapses into one SetWindowPos with the latest size.
+///
+/// Pointer passthrough: the panel and its Flutter view answer WM_NCHITTEST
+/// from the window's HitTestMask, and a pass-through point gets
+/// HTTRANSPARENT. Windows only forwards HTTRANSPARENT to windows of the
+/// same thread, so regions pass clicks to the host's own windows beneath,
+/// not to other apps. Whole-window passthrough (setPassthrough with no
+/// regions) also makes the panel click-through (WS_EX_TRANSPARENT), the
+/// one way a click reaches another process; that is a single style change
+/// per setPassthrough, never per pointer move.
+///
+/// Per-monitor DPI: the panel owns its size, so WM_GETDPISCALEDSIZE is
+/// answered from the content size it is laid out for, and WM_DPICHANGED
+/// resizes it once to that size at the new DPI. While a drag holds the
+/// panel's DPI (HoldDpi), changes are only recorded and the Flutter view
+/// isn't told; the drag applies the latest one once the panel is mostly on
+/// monitors at that DPI (SettleDpi), so a panel straddling a boundary
+/// doesn't bounce between scales. For a moment after each applied change,
+/// FFI resizes are held back and then applied once, so SizeReporter's
+/// relayout at the new scale can't feed another resize into the crossing.
+class PalettePanel {
+ public:
+  /// Create a hidden panel of the given physical size.
+  static HWND Create(PaletteWindow* window, int width, int height);
+
+  /// Re-parent the Flutter view into the panel and fit it to the client area.
+  static void AttachView(HWND panel, HWND view);
+
+  static PaletteWindow* FromHwnd(HWND hwnd);
+
+  /// Whether `hwnd` is a palette panel, by window class. Any thread.
+  static bool IsPanel(HWND hwnd);
+
+  /// Make the whole panel click-through (WS_EX_TRANSPARENT) or not, for
+  /// whole-window passthrough. Platform thread.
+  static void SetClickThrough(HWND hwnd, PaletteWindow& window, bool enabled);
+
+  /// Record a resize to `width` x `height` logical pixels and queue an apply
+  /// if none is pending. Safe from any thread while `window` is live (call
+  /// under WindowStore::WithWindow).
+  static void RequestResize(PaletteWindow& window, double width,
+                            double height);
+
+  /// Hold DPI changes of a panel that is being dragged. Platform thread.
+  static void HoldDpi(PaletteWindow& window);
+  /// While held: apply the DPI Windows moved the panel to once at least
+  /// kDpiApplyShare of it is on monitors at that DPI. The panel is scaled
+  /// about `pivot` (physical screen pixels, e.g. the cursor). Returns true
+  /// with the new frame if it resized. Platform thread.
+  static bool SettleDpi(HWND hwnd, PaletteWindow& window, POINT pivot,
+                        RECT* frame);
+  /// End the hold, applying any DPI change still held, as SettleDpi.
+  static bool ReleaseDpi(HWND hwnd, PaletteWindow& window, POINT pivot,
+                         RECT* frame);
+
+  static ResizeStats& Stats();
+
+  /// Bumped whenever any panel's z-order changes (WM_WINDOWPOSCHANGED
+  /// without SWP_NOZORDER). Platform thread.
+  static uint64_t ZOrderEpoch();
+
+ private:
+  static constexpr UINT kApplyResizeMessage = WM_APP + 3;
+  static constexpr UINT_PTR kDpiSettleTimer = 2;
+  /// FFI resizes held back after a DPI change (a few frames at 60 Hz).
+  static constexpr UINT kDpiSettleMs = 100;
+  /// Share of a dragged panel that must be on monitors at a held DPI
+  /// before it is applied; above Windows' one half, for hysteresis.
+  static constexpr double kDpiApplyShare = 0.6;
+
+  static void ApplyPendingResize(HWND hwnd, PaletteWindow* window);
+  /// Physical size of the panel's content at `dpi`.
+  static SIZE ContentSizeAt(HWND hwnd, const PaletteWindow& window, UINT dpi);
+  static void OnDpiChanged(HWND hwnd, PaletteWindow& window, UINT dpi,
+                           const RECT& suggested);
+  /// Lay the panel out for `dpi` at `origin`, and hold FFI resizes back
+  /// for kDpiSettleMs. `notify_view` tells the Flutter view, which heard
+  /// nothing while the change was held.
+  static void ApplyDpi(HWND hwnd, PaletteWindow& window, UINT dpi,
+                       POINT origin, bool notify_view);
+  static bool ApplyHeldDpi(HWND hwnd, PaletteWindow& window, POINT pivot,
+                           RECT* frame);
+  /// `screen` in physical pixels.
+  static bool PassesThrough(PaletteWindow& window, POINT screen);
+  static LRESULT CALLBACK WndProc(HWND hwnd, UINT message, WPARAM wparam,
+                                  LPARAM lparam);
+  /// Subclass of the Flutter view: the view covers the client area, so it
+  /// gets WM_NCHITTEST before the panel does.
+  static LRESULT CALLBACK ViewWndProc(HWND hwnd, UINT message, WPARAM wparam,
+                                      LPARAM lparam);
+  static void RegisterClassOnce();
+};
+
+}  // namespace floating_palette
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <flutter/encodable_value.h>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <variant>
+
+namespace floating_palette {
+
+/// Typed lookups into command params.
+///
+/// Dart may send whole-number doubles as ints (and large ints as int64), so
+/// numeric getters accept any numeric variant.
+
+inline const flutter::EncodableValue* FindParam(
+    const flutter::EncodableMap& params,
+    const char* key) {
+  auto it = params.find(flutter::EncodableValue(key));
+  return it != params.end() ? &it->second : nullptr;
+}
+
+inline std::optional<double> GetDouble(const flutter::EncodableMap& params,
+                                       const char* key) {
+  const auto* value = FindParam(params, key);
+  if (!value) return std::nullopt;
+  if (const auto* d = std::get_if<double>(value)) return *d;
+  if (const auto* i = std::get_if<int32_t>(value)) return *i;
+  if (const auto* l = std::get_if<int64_t>(value)) {
+    return static_cast<double>(*l);
+  }
+  return std::nullopt;
+}
+
+inline std::optional<int64_t> GetInt(const flutter::EncodableMap& params,
+                                     const char* key) {
+  const auto* value = FindParam(params, key);
+  if (!value) return std::nullopt;
+  if (const auto* i = std::get_if<int32_t>(value)) return *i;
+  if (const auto* l = std::get_if<int64_t>(value)) return *l;
+  if (const auto* d = std::get_if<double>(value)) {
+    return static_cast<int64_t>(*d);
+  }
+  return std::nullopt;
+}
+
+inline std::optional<bool> GetBool(const flutter::EncodableMap& params,
+                                   const char* key) {
+  const auto* value = FindParam(params, key);
+  if (!value) return std::nullopt;
+  if (const auto* b = std::get_if<bool>(value)) return *b;
+  return std::nullopt;
+}
+
+inline const std::string* GetString(const flutter::EncodableMap& params,
+                                    const char* key) {
+  const auto* value = FindParam(params, key);
+  return value ? std::get_if<std::string>(value) : nullptr;
+}
+
+}  // namespace floating_palette
@@ -0,0 +1,86 @@
+#include "placement_solver.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "monitor_topology.h"
+
+namespace floating_palette {
+
+namespace {
+
+/// Start of the palette on one axis. `anchor` 0, 1 or 2 puts the target at
+/// the palette's start, middle or end; [min, max) is the work area.
+LONG SolveAxis(LONG target, LONG offset, int anchor, LONG extent, LONG min,
+               LONG max, bool avoid_edges) {
+  const LONG start = target + offset - anchor * extent / 2;
+  if (!avoid_edges) return start;
+  if ((start < min || start + extent > max) && anchor != 1) {
+    // Mirror about the target, so a palette below the cursor opens above
+    // it near the bottom edge, if that fits.
+    const LONG flipped = target - offset - (2 - anchor) * extent / 2;
+    if (flipped >= min && flipped + extent <= max) return flipped;
+  }
+  // A palette larger than the work area keeps its top-left edge visible.
+  return std::max(min, std::min(start, max - extent));
+}
+
+LONG Scale(double logical, double scale) {
+  return static_cast<LONG>(std::lround(logical * scale));
+}
+
+}  // namespace
+
+bool SolvePlacement(const PlacementRequest& request, PlacementResult* out) {
+  if (request.anchor < 0 || request.anchor > 8) return false;
+
+  const auto topology = MonitorTopology::Instance().Current();
+  const auto& monitors = topology->monitors;
+  if (monitors.empty()) return false;
+
+  POINT target = request.point;
+  int index = -1;
+  switch (request.target) {
+    case PlacementTarget::kScreen: {
+      // Primary is always index 0.
+      const RECT& area = monitors[0].work_area;
+      target = {(area.left + area.right) / 2, (area.top + area.bottom) / 2};
+      index = 0;
+      break;
+    }
+    case PlacementTarget::kCursor:
+      if (!GetCursorPos(&target)) target = {};
+      [[fallthrough]];
+    case PlacementTarget::kPoint:
+      index = topology->IndexAtPoint(target);
+      if (index < 0) {
+        index = topology->IndexForRect(
+            {target.x, target.y, target.x + 1, target.y + 1});
+      }
+      break;
+  }
+  // All lookups above ran against one snapshot, and it has at least one
+  // monitor, so `index` is in range.
+
+  const MonitorInfo& monitor = monitors[index];
+  const double scale = monitor.scale_factor;
+  const LONG width = request.width > 0 ? Scale(request.width, scale)
+                                       : request.current_size.cx;
+  const LONG height = request.height > 0 ? Scale(request.height, scale)
+                                         : request.current_size.cy;
+  const RECT& area = monitor.work_area;
+
+  const LONG left =
+      SolveAxis(target.x, Scale(request.offset_x, scale), request.anchor % 3,
+                width, area.left, area.right, request.avoid_edges);
+  const LONG top =
+      SolveAxis(target.y, Scale(request.offset_y, scale), request.anchor / 3,
+                height, area.top, area.bottom, request.avoid_edges);
+
+  out->frame = {left, top, left + width, top + height};
+  out->monitor = index;
+  out->scale_factor = scale;
+  return true;
+}
+
+}  // namespace floating_palette
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <windows.h>
+
+namespace floating_palette {
+
+/// What a placement is anchored to.
+enum class PlacementTarget {
+  kCursor = 0,  // the cursor, read at solve time
+  kScreen = 1,  // the center of the primary monitor's work area
+  kPoint = 2,   // PlacementRequest::point
+};
+
+/// An anchored placement: the `anchor` point of the palette lands on the
+/// target point plus the offset.
+struct PlacementRequest {
+  PlacementTarget target = PlacementTarget::kCursor;
+  /// Row-major from the top-left, as Dart's Anchor: 0 topLeft, 1 topCenter,
+  /// 2 topRight, 3 centerLeft, ... 8 bottomRight.
+  int anchor = 0;
+  /// kPoint only. Physical screen pixels.
+  POINT point = {};
+  /// Logical pixels, scaled by the DPI of the monitor the target is on.
+  double offset_x = 0;
+  double offset_y = 0;
+  /// Palette size in logical pixels, scaled like the offset; a dimension
+  /// <= 0 takes the window's `current_size` (physical) instead.
+  double width = 0;
+  double height = 0;
+  SIZE current_size = {};
+  /// Flip to the opposite anchor on an axis that overflows the work area,
+  /// then clamp into it.
+  bool avoid_edges = true;
+};
+
+struct PlacementResult {
+  /// Physical screen pixels.
+  RECT frame = {};
+  /// Monitor the target is on (MonitorTopology index).
+  int monitor = -1;
+  /// Scale factor of that monitor.
+  double scale_factor = 1.0;
+};
+
+/// Solve `request` against the cached MonitorTopology: no Win32 calls
+/// beyond GetCursorPos for a kCursor target. False only if there are no
+/// monitors or the anchor is out of range.
+bool SolvePlacement(const PlacementRequest& request, PlacementResult* out);
+
+}  // namespace floating_palette
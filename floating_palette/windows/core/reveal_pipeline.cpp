@@ -0,0 +1,145 @@
+#include "reveal_pipeline.h"
+
+#include <dwmapi.h>
+#include <flutter_windows.h>
+
+#include <cstdint>
+
+#include "engine_hibernation.h"
+#include "logger.h"
+#include "palette_panel.h"
+#include "window_store.h"
+
+namespace floating_palette {
+
+RevealPipeline& RevealPipeline::Instance() {
+  static RevealPipeline* pipeline = new RevealPipeline();
+  return *pipeline;
+}
+
+void RevealPipeline::SetListener(RevealedListener listener) {
+  listener_ = std::move(listener);
+}
+
+void RevealPipeline::Begin(PaletteWindow& window) {
+  if (window.is_pending_reveal || !window.hwnd) return;
+  EngineHibernation::Instance().Wake(window);
+  window.is_pending_reveal = true;
+
+  // Hidden by cloaking (keep-alive): the surface still holds a frame.
+  window.reveal_from_warm = IsWindowVisible(window.hwnd) != FALSE;
+  SetCloaked(window, true);
+  if (!window.reveal_from_warm) ShowWindow(window.hwnd, SW_SHOWNOACTIVATE);
+
+  // The size report comes back through the FFI resize path, which calls
+  // ContentSized once it is applied.
+  if (window.entry_channel) {
+    window.entry_channel->InvokeMethod("forceResize", nullptr);
+  }
+  SetTimer(window.hwnd, kSafetyTimerId, kSafetyTimeoutMs, OnSafetyTimer);
+  FP_LOG("Visibility", "reveal pending: ", window.id,
+         window.reveal_from_warm ? " (warm)" : "");
+}
+
+void RevealPipeline::BeginWarm(PaletteWindow& window) {
+  if (window.is_pending_reveal || !window.hwnd) return;
+  // Suspended windows are SW_HIDE'd, so this also excludes them.
+  if (!window.keep_alive || !IsWindowVisible(window.hwnd) ||
+      !window.cloaked.load(std::memory_order_relaxed)) {
+    Begin(window);
+    return;
+  }
+  EngineHibernation::Instance().Wake(window);
+  window.is_pending_reveal = true;
+  FP_LOG("Visibility", "warm reveal: ", window.id);
+  Finish(window);
+}
+
+void RevealPipeline::ContentSized(PaletteWindow& window, bool changed) {
+  if (!window.is_pending_reveal) return;
+  if (!changed && window.reveal_from_warm) {
+    // Same size as the frame already on the surface.
+    Finish(window);
+    return;
+  }
+  window.reveal_from_warm = false;
+
+  // Flutter lays out synchronously on resize, so the next presented frame
+  // is at this size. Force one in case nothing else schedules it.
+  FlutterDesktopEngineSetNextFrameCallback(
+      window.engine, OnNextFrame,
+      reinterpret_cast<void*>(static_cast<intptr_t>(window.handle)));
+  FlutterDesktopViewControllerForceRedraw(window.view_controller);
+}
+
+void RevealPipeline::Finish(PaletteWindow& window) {
+  if (!window.is_pending_reveal) return;
+  window.is_pending_reveal = false;
+  window.reveal_from_warm = false;
+  KillTimer(window.hwnd, kSafetyTimerId);
+  SetCloaked(window, false);
+  FP_LOG("Visibility", "revealed: ", window.id);
+  if (listener_) listener_(window);
+}
+
+void RevealPipeline::Cancel(PaletteWindow& window) {
+  if (!window.is_pending_reveal) return;
+  // A next-frame callback may still be armed; it finds nothing pending.
+  window.is_pending_reveal = false;
+  window.reveal_from_warm = false;
+  KillTimer(window.hwnd, kSafetyTimerId);
+}
+
+void RevealPipeline::Hide(PaletteWindow& window) {
+  Cancel(window);
+  if (!window.hwnd) return;
+  if (window.keep_alive) {
+    // Stays WS_VISIBLE: DWM keeps the composition surface and last frame.
+    SetCloaked(window, true);
+    EngineHibernation::Instance().Hidden(window);
+  } else {
+    ShowWindow(window.hwnd, SW_HIDE);
+  }
+}
+
+// static
+bool RevealPipeline::IsShown(const PaletteWindow& window) {
+  return window.hwnd && IsWindowVisible(window.hwnd) &&
+         !window.cloaked.load(std::memory_order_acquire);
+}
+
+// static
+void RevealPipeline::SetCloaked(PaletteWindow& window, bool cloaked) {
+  if (!window.hwnd) return;
+  // A transformed panel stays cloaked; its composition proxy shows or
+  // hides in its place.
+  BOOL value = cloaked || window.composition.active() ? TRUE : FALSE;
+  DwmSetWindowAttribute(window.hwnd, DWMWA_CLOAK, &value, sizeof(value));
+  window.cloaked.store(cloaked, std::memory_order_release);
+  window.composition.Sync(window);
+}
+
+// static
+void RevealPipeline::OnNextFrame(void* user_data) {
+  // Runs on the platform thread. The handle goes stale if the window was
+  // destroyed in the meantime.
+  auto handle =
+      static_cast<WindowHandle>(reinterpret_cast<intptr_t>(user_data));
+  PaletteWindow* window = WindowStore::Instance().Get(handle);
+  if (!window || !window->is_pending_reveal) return;
+  // A newer size is queued; its apply arms another frame.
+  if (window->resize_posted.load(std::memory_order_acquire)) return;
+  Instance().Finish(*window);
+}
+
+// static
+void CALLBACK RevealPipeline::OnSafetyTimer(HWND hwnd, UINT message,
+                                            UINT_PTR id, DWORD time) {
+  KillTimer(hwnd, id);
+  PaletteWindow* window = PalettePanel::FromHwnd(hwnd);
+  if (!window || !window->is_pending_reveal) return;
+  FP_LOG("Visibility", "reveal timeout: ", window->id);
+  Instance().Finish(*window);
+}
+
+}  // namespace floating_palette
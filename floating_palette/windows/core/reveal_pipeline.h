@@ -0,0 +1,82 @@
+#pragma once
+
+#include <windows.h>
+
+#include <functional>
+#include <string>
+
+namespace floating_palette {
+
+struct PaletteWindow;
+
+/// Show-after-first-frame reveal for palette panels.
+///
+/// Show makes the panel visible but DWM-cloaked (DWMWA_CLOAK): the Flutter
+/// view has a live, correctly sized surface to render into while nothing
+/// reaches the screen. The palette is asked to re-report its content size
+/// ("forceResize"); once that size is applied, the next presented frame
+/// (the engine's next-frame callback) uncloaks the panel. The user never
+/// sees the white first frame, the default size or the relayout to the
+/// real one, and the panel is shown once, already sized.
+///
+/// A keep-alive palette hides by cloaking, so its swap chain and last frame
+/// stay warm: re-showing it at the same size uncloaks straight away with no
+/// new frame. A safety timer reveals a palette whose engine never reports
+/// or presents.
+///
+/// Platform thread only.
+class RevealPipeline {
+ public:
+  /// Called when a pending window is uncloaked.
+  using RevealedListener = std::function<void(PaletteWindow& window)>;
+
+  static RevealPipeline& Instance();
+
+  RevealPipeline(const RevealPipeline&) = delete;
+  RevealPipeline& operator=(const RevealPipeline&) = delete;
+
+  void SetListener(RevealedListener listener);
+
+  /// Cloak, show (without activating) and wait for content. No-op while a
+  /// reveal is already pending.
+  void Begin(PaletteWindow& window);
+
+  /// Begin, except that a cloaked keep-alive window is uncloaked right
+  /// away: its surface still holds its last frame at its current size, so
+  /// nothing waits on the palette engine (hotkey show). A suspended window
+  /// has lost that surface and takes the normal path.
+  void BeginWarm(PaletteWindow& window);
+
+  /// The palette's content size was applied (`changed`) or found current;
+  /// called by the resize path while a reveal is pending.
+  void ContentSized(PaletteWindow& window, bool changed);
+
+  /// Uncloak now and notify the listener. No-op unless pending.
+  void Finish(PaletteWindow& window);
+
+  /// Stop waiting without revealing (hide, destroy).
+  void Cancel(PaletteWindow& window);
+
+  /// Hide: cloak a keep-alive window (surface stays warm), SW_HIDE others.
+  void Hide(PaletteWindow& window);
+
+  /// Visible to the user: WS_VISIBLE and not cloaked by us. Any thread.
+  static bool IsShown(const PaletteWindow& window);
+
+  static void SetCloaked(PaletteWindow& window, bool cloaked);
+
+ private:
+  /// Longest a cloaked window waits for its size report and frame.
+  static constexpr UINT kSafetyTimeoutMs = 250;
+  static constexpr UINT_PTR kSafetyTimerId = 0x5256;  // 'RV'
+
+  RevealPipeline() = default;
+
+  static void OnNextFrame(void* user_data);
+  static void CALLBACK OnSafetyTimer(HWND hwnd, UINT message, UINT_PTR id,
+                                     DWORD time);
+
+  RevealedListener listener_;
+};
+
+}  // namespace floating_palette
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace floating_palette {
+
+/// Storage for fixed-size `T` records, carved from chunks of `kChunkSize`
+/// and recycled through an intrusive free list.
+///
+/// A record never moves once allocated, and records allocated together sit
+/// next to each other in one chunk instead of wherever the heap put them,
+/// so a walk over many of them touches few cache lines. Allocate and Free
+/// only hand out raw storage; construction stays with the caller (usually
+/// a class-specific operator new). Chunks are released with the slab.
+/// Thread-safe.
+template <typename T, size_t kChunkSize = 16>
+class Slab {
+ public:
+  Slab() = default;
+  Slab(const Slab&) = delete;
+  Slab& operator=(const Slab&) = delete;
+
+  /// Uninitialized storage for one T.
+  void* Allocate() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!free_) Grow();
+    Record* record = free_;
+    free_ = record->next;
+    ++live_;
+    return record->bytes;
+  }
+
+  /// Return storage from Allocate (already destroyed). Null is a no-op.
+  void Free(void* storage) {
+    if (!storage) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto* record = static_cast<Record*>(storage);
+    record->next = free_;
+    free_ = record;
+    --live_;
+  }
+
+  size_t live() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return live_;
+  }
+
+  size_t capacity() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return chunks_.size() * kChunkSize;
+  }
+
+ private:
+  union Record {
+    Record* next;
+    alignas(T) unsigned char bytes[sizeof(T)];
+  };
+
+  void Grow() {
+    chunks_.push_back(std::make_unique<Record[]>(kChunkSize));
+    Record* chunk = chunks_.back().get();
+    // Linked in address order, so consecutive allocations are adjacent.
+    for (size_t i = 0; i + 1 < kChunkSize; ++i) chunk[i].next = &chunk[i + 1];
+    chunk[kChunkSize - 1].next = free_;
+    free_ = chunk;
+  }
+
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<Record[]>> chunks_;
+  Record* free_ = nullptr;
+  size_t live_ = 0;
+};
+
+}  // namespace floating_palette
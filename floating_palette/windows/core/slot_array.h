@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "window_store.h"
+
+namespace floating_palette {
+
+/// Per-window state kept in a flat array indexed by WindowStore slot,
+/// parallel to the store's own slot table. A service walking many windows
+/// (or the same one every drag tick) reads contiguous memory with no
+/// string hashing or map nodes in between.
+///
+/// Each entry remembers the handle it was written for. An entry left by a
+/// destroyed window reads as absent once its slot is reused, and is reset
+/// on the next write, so a service doesn't have to forget state on every
+/// destroy to stay correct. Not thread-safe; owned by one thread.
+template <typename T>
+class SlotArray {
+ public:
+  /// The entry for `handle`, or nullptr if none was written for it.
+  T* Find(WindowHandle handle) {
+    size_t slot = WindowStore::SlotIndex(handle);
+    if (handle == kInvalidWindowHandle || slot >= handles_.size() ||
+        handles_[slot] != handle) {
+      return nullptr;
+    }
+    return &values_[slot];
+  }
+  const T* Find(WindowHandle handle) const {
+    return const_cast<SlotArray*>(this)->Find(handle);
+  }
+
+  /// The entry for `handle`, value-initialized if it wasn't there (or was
+  /// left by an earlier window in the same slot).
+  T& operator[](WindowHandle handle) {
+    size_t slot = WindowStore::SlotIndex(handle);
+    if (slot >= handles_.size()) {
+      handles_.resize(slot + 1, kInvalidWindowHandle);
+      values_.resize(slot + 1);
+    }
+    if (handles_[slot] != handle) {
+      handles_[slot] = handle;
+      values_[slot] = T();
+    }
+    return values_[slot];
+  }
+
+  void Erase(WindowHandle handle) {
+    size_t slot = WindowStore::SlotIndex(handle);
+    if (slot < handles_.size() && handles_[slot] == handle) {
+      handles_[slot] = kInvalidWindowHandle;
+      values_[slot] = T();
+    }
+  }
+
+  void Clear() {
+    handles_.clear();
+    values_.clear();
+  }
+
+ private:
+  std::vector<WindowHandle> handles_;
+  std::vector<T> values_;
+};
+
+}  // namespace floating_palette
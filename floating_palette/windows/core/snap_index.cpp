@@ -0,0 +1,121 @@
+#include "snap_index.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace floating_palette {
+
+namespace {
+
+constexpr SnapEdge kEdges[] = {SnapEdge::kTop, SnapEdge::kBottom,
+                               SnapEdge::kLeft, SnapEdge::kRight};
+
+bool IsHorizontal(SnapEdge edge) {
+  return edge == SnapEdge::kTop || edge == SnapEdge::kBottom;
+}
+
+LONG EdgeCoord(const RECT& rect, SnapEdge edge) {
+  switch (edge) {
+    case SnapEdge::kTop: return rect.top;
+    case SnapEdge::kBottom: return rect.bottom;
+    case SnapEdge::kLeft: return rect.left;
+    case SnapEdge::kRight: return rect.right;
+  }
+  return 0;
+}
+
+}  // namespace
+
+bool ParseSnapEdge(const std::string& name, SnapEdge* out) {
+  for (SnapEdge edge : kEdges) {
+    if (name == SnapEdgeName(edge)) {
+      *out = edge;
+      return true;
+    }
+  }
+  return false;
+}
+
+const char* SnapEdgeName(SnapEdge edge) {
+  switch (edge) {
+    case SnapEdge::kTop: return "top";
+    case SnapEdge::kBottom: return "bottom";
+    case SnapEdge::kLeft: return "left";
+    case SnapEdge::kRight: return "right";
+  }
+  return "";
+}
+
+void SnapIndex::Rebuild(std::vector<Target> targets) {
+  targets_ = std::move(targets);
+  for (auto& list : edges_) list.clear();
+
+  for (uint32_t i = 0; i < targets_.size(); ++i) {
+    const Target& target = targets_[i];
+    for (SnapEdge edge : kEdges) {
+      if (!(target.accepts & EdgeBit(edge))) continue;
+      const RECT& f = target.frame;
+      Edge entry;
+      entry.coord = EdgeCoord(f, edge);
+      entry.span_begin = IsHorizontal(edge) ? f.left : f.top;
+      entry.span_end = IsHorizontal(edge) ? f.right : f.bottom;
+      entry.target = i;
+      edges_[static_cast<uint8_t>(edge)].push_back(entry);
+    }
+  }
+  for (auto& list : edges_) {
+    std::sort(list.begin(), list.end(), [](const Edge& a, const Edge& b) {
+      return a.coord < b.coord;
+    });
+  }
+}
+
+void SnapIndex::Clear() {
+  targets_.clear();
+  for (auto& list : edges_) list.clear();
+}
+
+bool SnapIndex::FindNearest(const RECT& dragged,
+                            SnapEdgeMask from,
+                            LONG threshold,
+                            const std::unordered_set<std::string>& excluded,
+                            const std::unordered_set<std::string>* allowed,
+                            Match* out) const {
+  bool found = false;
+  for (SnapEdge dragged_edge : kEdges) {
+    if (!(from & EdgeBit(dragged_edge))) continue;
+    SnapEdge target_edge = OppositeEdge(dragged_edge);
+    const auto& list = edges_[static_cast<uint8_t>(target_edge)];
+
+    LONG coord = EdgeCoord(dragged, dragged_edge);
+    LONG span_begin = IsHorizontal(dragged_edge) ? dragged.left : dragged.top;
+    LONG span_end =
+        IsHorizontal(dragged_edge) ? dragged.right : dragged.bottom;
+
+    auto it = std::lower_bound(
+        list.begin(), list.end(), coord - threshold,
+        [](const Edge& e, LONG value) { return e.coord < value; });
+    for (; it != list.end() && it->coord <= coord + threshold; ++it) {
+      LONG distance = std::labs(it->coord - coord);
+      if (distance >= threshold) continue;
+      if (found && distance >= out->distance) continue;
+      // The edges have to face each other, not just line up.
+      if (std::min(span_end, it->span_end) -
+              std::max(span_begin, it->span_begin) <= 0) {
+        continue;
+      }
+      const Target& target = targets_[it->target];
+      if (excluded.count(target.id)) continue;
+      if (allowed && !allowed->count(target.id)) continue;
+
+      out->target_id = &target.id;
+      out->dragged_edge = dragged_edge;
+      out->target_edge = target_edge;
+      out->distance = distance;
+      found = true;
+    }
+  }
+  return found;
+}
+
+}  // namespace floating_palette
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <windows.h>
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace floating_palette {
+
+/// A palette edge, as named on the Dart side (SnapEdge.name).
+enum class SnapEdge : uint8_t { kTop = 0, kBottom = 1, kLeft = 2, kRight = 3 };
+
+/// Bit set of SnapEdge values (bit = 1 << edge).
+using SnapEdgeMask = uint8_t;
+
+constexpr SnapEdgeMask EdgeBit(SnapEdge edge) {
+  return static_cast<SnapEdgeMask>(1u << static_cast<uint8_t>(edge));
+}
+
+/// The edge that can snap against `edge` (top ↔ bottom, left ↔ right).
+constexpr SnapEdge OppositeEdge(SnapEdge edge) {
+  switch (edge) {
+    case SnapEdge::kTop: return SnapEdge::kBottom;
+    case SnapEdge::kBottom: return SnapEdge::kTop;
+    case SnapEdge::kLeft: return SnapEdge::kRight;
+    case SnapEdge::kRight: return SnapEdge::kLeft;
+  }
+  return SnapEdge::kTop;
+}
+
+bool ParseSnapEdge(const std::string& name, SnapEdge* out);
+const char* SnapEdgeName(SnapEdge edge);
+
+/// Nearest-edge lookup over the frames of palettes that accept snaps.
+///
+/// Each accepted edge of each target goes into a per-edge list sorted by
+/// its coordinate (y for top/bottom, x for left/right). A query binary
+/// searches the list opposite each edge the dragged palette can snap from
+/// and only looks at edges within the threshold, so a drag tick costs
+/// O(log n + k) with no GetWindowRect calls. Frames are captured when the
+/// index is rebuilt; the owner rebuilds it when windows show, hide or
+/// finish moving, never per tick.
+class SnapIndex {
+ public:
+  struct Target {
+    std::string id;
+    /// Screen rect in physical pixels.
+    RECT frame;
+    SnapEdgeMask accepts = 0;
+  };
+
+  struct Match {
+    const std::string* target_id = nullptr;
+    SnapEdge dragged_edge = SnapEdge::kTop;
+    SnapEdge target_edge = SnapEdge::kBottom;
+    /// Physical pixels.
+    LONG distance = 0;
+  };
+
+  /// Replace the indexed targets.
+  void Rebuild(std::vector<Target> targets);
+  void Clear();
+
+  /// Closest target edge strictly within `threshold` pixels of one of
+  /// `dragged`'s `from` edges, whose span overlaps the dragged frame on the
+  /// other axis. Skips targets in `excluded` (the dragged palette and its
+  /// group, whose entries are stale) and, when `allowed` is set, targets
+  /// not in it. `out->target_id` points into the index and is valid until
+  /// the next Rebuild.
+  bool FindNearest(const RECT& dragged,
+                   SnapEdgeMask from,
+                   LONG threshold,
+                   const std::unordered_set<std::string>& excluded,
+                   const std::unordered_set<std::string>* allowed,
+                   Match* out) const;
+
+  size_t size() const { return targets_.size(); }
+
+ private:
+  struct Edge {
+    LONG coord;
+    /// Extent along the edge (x range for top/bottom, y range for sides).
+    LONG span_begin;
+    LONG span_end;
+    uint32_t target;
+  };
+
+  std::vector<Target> targets_;
+  /// Indexed by SnapEdge, each sorted by coord.
+  std::vector<Edge> edges_[4];
+};
+
+}  // namespace floating_palette
@@ -0,0 +1,163 @@
+#include "trace.h"
+
+#include <evntprov.h>
+
+#include <cstring>
+
+// Name hash of "FloatingPalette"; see trace.h.
+TRACELOGGING_DEFINE_PROVIDER(g_floating_palette_trace_provider,
+                             "FloatingPalette",
+                             (0xf61143bc, 0x72da, 0x5a52, 0xa9, 0x98, 0xaa,
+                              0x70, 0x26, 0xdc, 0xf6, 0x70));
+
+namespace floating_palette {
+namespace trace {
+
+namespace {
+
+int registrations = 0;
+
+struct CategoryKeyword {
+  const char* category;
+  uint64_t keyword;
+};
+
+constexpr CategoryKeyword kCategoryKeywords[] = {
+    {"Window", kWindow},       {"Visibility", kWindow},
+    {"Focus", kWindow},        {"ZOrder", kWindow},
+    {"Appearance", kWindow},   {"Glass", kWindow},
+    {"Frame", kFrame},         {"Drag", kFrame},
+    {"Transform", kFrame},     {"Snap", kSnap},
+    {"Capture", kCapture},     {"Animation", kAnimation},
+};
+
+}  // namespace
+
+void Register() {
+  if (registrations++ == 0) {
+    TraceLoggingRegister(g_floating_palette_trace_provider);
+  }
+}
+
+void Unregister() {
+  if (registrations > 0 && --registrations == 0) {
+    TraceLoggingUnregister(g_floating_palette_trace_provider);
+  }
+}
+
+uint64_t KeywordForCategory(const char* category) {
+  for (const CategoryKeyword& entry : kCategoryKeywords) {
+    if (std::strcmp(entry.category, category) == 0) return entry.keyword;
+  }
+  return kOther;
+}
+
+// TraceLogging keywords are compile-time constants, so each keyword needs
+// its own write site.
+#define FP_TRACE_LOG(keyword)                                         \
+  TraceLoggingWrite(g_floating_palette_trace_provider, "Log",         \
+                    TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),        \
+                    TraceLoggingKeyword(keyword),                     \
+                    TraceLoggingString(category, "Category"),         \
+                    TraceLoggingString(message, "Message"))
+
+void Log(const char* category, const char* message) {
+  switch (KeywordForCategory(category)) {
+    case kWindow: FP_TRACE_LOG(kWindow); break;
+    case kFrame: FP_TRACE_LOG(kFrame); break;
+    case kSnap: FP_TRACE_LOG(kSnap); break;
+    case kCapture: FP_TRACE_LOG(kCapture); break;
+    case kAnimation: FP_TRACE_LOG(kAnimation); break;
+    default: FP_TRACE_LOG(kOther); break;
+  }
+}
+
+#undef FP_TRACE_LOG
+
+CommandActivity::CommandActivity(const std::string& service,
+                                 const std::string& command) {
+  if (!Enabled(kCommand, WINEVENT_LEVEL_INFO)) return;
+  if (EventActivityIdControl(EVENT_ACTIVITY_CTRL_CREATE_ID, &id_) != 0) {
+    return;
+  }
+  active_ = true;
+  TraceLoggingWriteActivity(g_floating_palette_trace_provider, "Command",
+                            &id_, nullptr,
+                            TraceLoggingOpcode(WINEVENT_OPCODE_START),
+                            TraceLoggingLevel(WINEVENT_LEVEL_INFO),
+                            TraceLoggingKeyword(kCommand),
+                            TraceLoggingString(service.c_str(), "Service"),
+                            TraceLoggingString(command.c_str(), "Command"));
+  // Swap in our ID; the caller's comes back in the destructor.
+  previous_ = id_;
+  EventActivityIdControl(EVENT_ACTIVITY_CTRL_GET_SET_ID, &previous_);
+}
+
+CommandActivity::~CommandActivity() {
+  if (!active_) return;
+  EventActivityIdControl(EVENT_ACTIVITY_CTRL_SET_ID, &previous_);
+  TraceLoggingWriteActivity(g_floating_palette_trace_provider, "Command",
+                            &id_, nullptr,
+                            TraceLoggingOpcode(WINEVENT_OPCODE_STOP),
+                            TraceLoggingLevel(WINEVENT_LEVEL_INFO),
+                            TraceLoggingKeyword(kCommand));
+}
+
+void WriteWindowCreated(const std::string& id, int32_t handle) {
+  TraceLoggingWrite(g_floating_palette_trace_provider, "WindowCreated",
+                    TraceLoggingLevel(WINEVENT_LEVEL_INFO),
+                    TraceLoggingKeyword(kWindow),
+                    TraceLoggingString(id.c_str(), "Id"),
+                    TraceLoggingInt32(handle, "Handle"));
+}
+
+void WriteWindowDestroyed(const std::string& id) {
+  TraceLoggingWrite(g_floating_palette_trace_provider, "WindowDestroyed",
+                    TraceLoggingLevel(WINEVENT_LEVEL_INFO),
+                    TraceLoggingKeyword(kWindow),
+                    TraceLoggingString(id.c_str(), "Id"));
+}
+
+void WriteFrameBatchApplied(size_t requested, size_t moved, bool deferred) {
+  TraceLoggingWrite(g_floating_palette_trace_provider, "FrameBatch",
+                    TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                    TraceLoggingKeyword(kFrame),
+                    TraceLoggingUInt32(static_cast<uint32_t>(requested),
+                                       "Requested"),
+                    TraceLoggingUInt32(static_cast<uint32_t>(moved), "Moved"),
+                    TraceLoggingBool(deferred, "Deferred"));
+}
+
+void WriteSnapFollowerMoved(const std::string& follower_id, int32_t x,
+                            int32_t y) {
+  TraceLoggingWrite(g_floating_palette_trace_provider, "SnapFollowerMoved",
+                    TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                    TraceLoggingKeyword(kSnap),
+                    TraceLoggingString(follower_id.c_str(), "Follower"),
+                    TraceLoggingInt32(x, "X"), TraceLoggingInt32(y, "Y"));
+}
+
+void WriteCaptureFrame(uint32_t width, uint32_t height) {
+  TraceLoggingWrite(g_floating_palette_trace_provider, "CaptureFrame",
+                    TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                    TraceLoggingKeyword(kCapture),
+                    TraceLoggingUInt32(width, "Width"),
+                    TraceLoggingUInt32(height, "Height"));
+}
+
+void WriteAnimationFrame(size_t windows) {
+  TraceLoggingWrite(g_floating_palette_trace_provider, "AnimationFrame",
+                    TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                    TraceLoggingKeyword(kAnimation),
+                    TraceLoggingUInt32(static_cast<uint32_t>(windows),
+                                       "Windows"));
+}
+
+void WriteAnimationFrameDropped() {
+  TraceLoggingWrite(g_floating_palette_trace_provider, "AnimationFrameDropped",
+                    TraceLoggingLevel(WINEVENT_LEVEL_INFO),
+                    TraceLoggingKeyword(kAnimation));
+}
+
+}  // namespace trace
+}  // namespace floating_palette
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <windows.h>
+
+#include <TraceLoggingProvider.h>
+#include <winmeta.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// ETW provider "FloatingPalette", {f61143bc-72da-5a52-a998-aa7026dcf670}
+/// (the EventSource hash of the name, so `tracelog -guid #FloatingPalette`
+/// and WPR profiles can name it instead of the GUID).
+///
+/// Recording, alongside DWM and Flutter raster traces in WPA:
+///   tracelog -start fp -f fp.etl -guid #FloatingPalette -level 5
+///   tracelog -stop fp
+/// Filter with -flags using the keywords below.
+TRACELOGGING_DECLARE_PROVIDER(g_floating_palette_trace_provider);
+
+namespace floating_palette {
+namespace trace {
+
+/// ETW keywords, one per subsystem. FP_LOG categories map onto these (see
+/// KeywordForCategory); keyword 0x40 carries the categories that fit none.
+enum Keyword : uint64_t {
+  kWindow = 0x1,
+  kFrame = 0x2,
+  kSnap = 0x4,
+  kCapture = 0x8,
+  kAnimation = 0x10,
+  /// Start/stop activity around every channel command.
+  kCommand = 0x20,
+  kOther = 0x40,
+};
+
+/// Register the provider on first call; Unregister when the last caller
+/// leaves. One pair per plugin instance. Platform thread.
+void Register();
+void Unregister();
+
+/// Whether any session wants `keyword` at `level`. An inline load and
+/// compare: callers check it before building strings or fields, so a
+/// trace point costs nearly nothing while no session is listening.
+inline bool Enabled(uint64_t keyword,
+                    unsigned char level = WINEVENT_LEVEL_VERBOSE) {
+  return TraceLoggingProviderEnabled(g_floating_palette_trace_provider, level,
+                                     keyword);
+}
+
+uint64_t KeywordForCategory(const char* category);
+
+/// FP_LOG as an ETW event "Log" {Category, Message}.
+void Log(const char* category, const char* message);
+inline void Log(const char* category, const std::string& message) {
+  Log(category, message.c_str());
+}
+
+/// Brackets one channel command with "Command" start/stop events sharing a
+/// fresh activity ID, and makes that ID the thread's current activity, so
+/// events written while the handler runs are nested under it in WPA.
+class CommandActivity {
+ public:
+  CommandActivity(const std::string& service, const std::string& command);
+  ~CommandActivity();
+
+  CommandActivity(const CommandActivity&) = delete;
+  CommandActivity& operator=(const CommandActivity&) = delete;
+
+ private:
+  bool active_ = false;
+  GUID id_{};
+  GUID previous_{};
+};
+
+// Structured events. Each checks its keyword inline first.
+
+void WriteWindowCreated(const std::string& id, int32_t handle);
+void WriteWindowDestroyed(const std::string& id);
+void WriteFrameBatchApplied(size_t requested, size_t moved, bool deferred);
+void WriteSnapFollowerMoved(const std::string& follower_id, int32_t x,
+                            int32_t y);
+void WriteCaptureFrame(uint32_t width, uint32_t height);
+void WriteAnimationFrame(size_t windows);
+void WriteAnimationFrameDropped();
+
+inline void WindowCreated(const std::string& id, int32_t handle) {
+  if (Enabled(kWindow)) WriteWindowCreated(id, handle);
+}
+inline void WindowDestroyed(const std::string& id) {
+  if (Enabled(kWindow)) WriteWindowDestroyed(id);
+}
+inline void FrameBatchApplied(size_t requested, size_t moved, bool deferred) {
+  if (Enabled(kFrame)) WriteFrameBatchApplied(requested, moved, deferred);
+}
+inline void SnapFollowerMoved(const std::string& follower_id, int32_t x,
+                              int32_t y) {
+  if (Enabled(kSnap)) WriteSnapFollowerMoved(follower_id, x, y);
+}
+inline void CaptureFrame(uint32_t width, uint32_t height) {
+  if (Enabled(kCapture)) WriteCaptureFrame(width, height);
+}
+inline void AnimationFrame(size_t windows) {
+  if (Enabled(kAnimation)) WriteAnimationFrame(windows);
+}
+inline void AnimationFrameDropped() {
+  if (Enabled(kAnimation)) WriteAnimationFrameDropped();
+}
+
+}  // namespace trace
+}  // namespace floating_palette
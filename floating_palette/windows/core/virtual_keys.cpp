@@ -0,0 +1,83 @@
+#include "virtual_keys.h"
+
+namespace floating_palette {
+
+namespace {
+
+// Flutter's plane for keys without a printable character.
+constexpr int64_t kUnprintablePlane = 0x00100000000;
+
+}  // namespace
+
+UINT VirtualKeyForLogicalKey(int64_t key_id) {
+  // Printable keys: the id is the (lowercase) code point.
+  if (key_id >= 'a' && key_id <= 'z') {
+    return static_cast<UINT>('A' + (key_id - 'a'));
+  }
+  if (key_id >= '0' && key_id <= '9') return static_cast<UINT>(key_id);
+  switch (key_id) {
+    case ' ':
+      return VK_SPACE;
+    case ',':
+      return VK_OEM_COMMA;
+    case '.':
+      return VK_OEM_PERIOD;
+    case '-':
+      return VK_OEM_MINUS;
+    case '=':
+      return VK_OEM_PLUS;
+    case ';':
+      return VK_OEM_1;
+    case '/':
+      return VK_OEM_2;
+    case '`':
+      return VK_OEM_3;
+    case '[':
+      return VK_OEM_4;
+    case '\\':
+      return VK_OEM_5;
+    case ']':
+      return VK_OEM_6;
+    case '\'':
+      return VK_OEM_7;
+  }
+
+  const int64_t code = key_id - kUnprintablePlane;
+  if (code >= 0x801 && code <= 0x818) {  // F1-F24
+    return static_cast<UINT>(VK_F1 + (code - 0x801));
+  }
+  switch (code) {
+    case 0x008:
+      return VK_BACK;
+    case 0x009:
+      return VK_TAB;
+    case 0x00d:
+      return VK_RETURN;
+    case 0x01b:
+      return VK_ESCAPE;
+    case 0x07f:
+      return VK_DELETE;
+    case 0x301:
+      return VK_DOWN;
+    case 0x302:
+      return VK_LEFT;
+    case 0x303:
+      return VK_RIGHT;
+    case 0x304:
+      return VK_UP;
+    case 0x305:
+      return VK_END;
+    case 0x306:
+      return VK_HOME;
+    case 0x307:
+      return VK_NEXT;
+    case 0x308:
+      return VK_PRIOR;
+    case 0x407:
+      return VK_INSERT;
+    default:
+      return 0;
+  }
+}
+
+}  // namespace floating_palette
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <windows.h>
+
+#include <cstdint>
+
+namespace floating_palette {
+
+/// Virtual-key code for a Flutter LogicalKeyboardKey id, 0 if there is
+/// none. Covers letters, digits, punctuation, F1-F24, and the editing and
+/// navigation keys.
+UINT VirtualKeyForLogicalKey(int64_t key_id);
+
+}  // namespace floating_palette
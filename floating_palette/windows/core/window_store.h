@@ -3,12 +3,25 @@
 #include <windows.h>
 
 #include <flutter/encodable_value.h>
+#include <flutter/method_channel.h>
+#include <flutter/plugin_registrar_windows.h>
+#include <flutter_windows.h>
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
+
+#include "composition_layer.h"
+#include "dwm_attributes.h"
+#include "frame_cache.h"
+#include "hit_test_mask.h"
+#include "slab.h"
 
 namespace floating_palette {
 
@@ -20,19 +33,121 @@ using EventSink = std::function<void(
     const std::string* window_id,
     const flutter::EncodableMap& data)>;
 
-/// Represents a palette window with its native handle.
+/// Generation-checked integer handle to a stored window (see WindowStore).
+/// Stable for the window's lifetime; 0 is never a valid handle.
+using WindowHandle = int32_t;
+constexpr WindowHandle kInvalidWindowHandle = 0;
+
+/// Represents a palette window with its native handle and Flutter engine.
+///
+/// Allocated from a Slab (see PaletteWindowSlab), so make_unique and
+/// unique_ptr work as usual while records keep stable addresses and sit
+/// together in memory.
 struct PaletteWindow {
+  static void* operator new(size_t size);
+  static void operator delete(void* storage, size_t size);
+
+  /// Empty while the window sits warm in the EnginePool.
   std::string id;
+  /// Set by WindowStore::Store; kInvalidWindowHandle while not stored.
+  WindowHandle handle = kInvalidWindowHandle;
+  /// Top-level palette panel hosting the Flutter view.
   HWND hwnd = nullptr;
-  // Future: FlutterDesktopEngineRef, FlutterDesktopViewRef
+  /// Owns the engine; destroying it shuts the engine down.
+  FlutterDesktopViewControllerRef view_controller = nullptr;
+  FlutterDesktopEngineRef engine = nullptr;
+  /// Registrar on the palette engine (per-palette channels live here).
+  flutter::PluginRegistrarWindows* registrar = nullptr;
+
+  /// Entry channel (floating_palette/entry) on the palette engine.
+  std::unique_ptr<flutter::MethodChannel<flutter::EncodableValue>>
+      entry_channel;
+  /// Messenger channel (floating_palette/messenger) on the palette engine.
+  std::unique_ptr<flutter::MethodChannel<flutter::EncodableValue>>
+      messenger_channel;
+  /// Self channel (floating_palette/self) on the palette engine.
+  std::unique_ptr<flutter::MethodChannel<flutter::EncodableValue>>
+      self_channel;
+  /// getPaletteId call parked until the pool hands this window out.
+  std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>>
+      pending_id_result;
+
+  /// Kept current by the panel's window procedure; see FrameCache.
+  FrameCache frame;
+  /// Pointer passthrough answered in WM_NCHITTEST; see HitTestMask.
+  HitTestMask hit_test;
+  /// Compositor transform (scale, rotation, flip); see CompositionLayer.
+  CompositionLayer composition;
+  /// Appearance requested by AppearanceService, and the DWM attributes
+  /// last applied to the panel; see DwmAttributes.
+  PanelAppearance appearance;
+  DwmAttributes dwm;
+
+  /// Latest FFI-requested size (logical px, two packed floats) and whether
+  /// an apply message is already queued for it. Written from the Dart UI
+  /// thread, consumed on the platform thread; see PalettePanel.
+  std::atomic<uint64_t> pending_size{0};
+  std::atomic<bool> resize_posted{false};
+
+  /// DPI the panel's size and Flutter view are laid out for; a DPI Windows
+  /// moved the panel to while a drag held it (0 if none); and whether FFI
+  /// resizes are being held back around a DPI change. Platform thread; see
+  /// PalettePanel.
+  UINT layout_dpi = 96;
+  UINT held_dpi = 0;
+  bool dpi_held = false;
+  bool dpi_settling = false;
+  bool resize_deferred = false;
+
+  /// Shown cloaked, waiting for its sized first frame; see RevealPipeline.
   bool is_pending_reveal = false;
+  /// The pending reveal started from a cloaked keep-alive surface.
+  bool reveal_from_warm = false;
+  /// DWMWA_CLOAK as last set by RevealPipeline (read from any thread).
+  std::atomic<bool> cloaked{false};
   bool should_focus = true;
   bool draggable = true;
   bool keep_alive = false;
+  /// Dart bound the window to the binary channel (frame/bindBinary): its
+  /// drag and snap-follower updates are sent there; see BinaryChannel.
+  bool binary_bound = false;
+  /// Hidden keep-alive idle time before suspension (ms, < 0 never), and
+  /// the hibernation state; see EngineHibernation.
+  int suspend_after_ms = 30000;
+  bool frames_paused = false;
+  bool suspended = false;
 };
 
+/// Storage behind PaletteWindow's operator new. Never destroyed: the store
+/// and the engine pool may still free windows during static destruction.
+inline Slab<PaletteWindow>& PaletteWindowSlab() {
+  static auto* slab = new Slab<PaletteWindow>();
+  return *slab;
+}
+
+inline void* PaletteWindow::operator new(size_t size) {
+  if (size != sizeof(PaletteWindow)) return ::operator new(size);
+  return PaletteWindowSlab().Allocate();
+}
+
+inline void PaletteWindow::operator delete(void* storage, size_t size) {
+  if (size != sizeof(PaletteWindow)) {
+    ::operator delete(storage);
+    return;
+  }
+  PaletteWindowSlab().Free(storage);
+}
+
 /// Stores and tracks all palette windows.
 /// Single source of truth for window handles. Thread-safe.
+///
+/// Read-mostly: lookups and iteration take a shared lock, so the platform
+/// thread and FFI callers never contend with each other, only with
+/// create/destroy. Windows live in a dense slot vector; each stored window
+/// also gets a generation-checked WindowHandle that resolves without any
+/// string hashing and goes stale when the window is removed. The slot index
+/// inside a handle is dense and reused, so per-window service state can
+/// live in a SlotArray beside the store instead of in maps keyed by id.
 class WindowStore {
  public:
   static WindowStore& Instance() {
@@ -40,50 +155,165 @@ class WindowStore {
     return store;
   }
 
-  PaletteWindow* Get(const std::string& id) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = windows_.find(id);
-    return it != windows_.end() ? it->second.get() : nullptr;
+  PaletteWindow* Get(const std::string& id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = index_.find(id);
+    return it != index_.end() ? slots_[it->second].window.get() : nullptr;
+  }
+
+  /// nullptr if the handle is stale or was never issued.
+  PaletteWindow* Get(WindowHandle handle) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    const Slot* slot = SlotFor(handle);
+    return slot ? slot->window.get() : nullptr;
+  }
+
+  /// Run `fn(PaletteWindow&)` under the shared lock if `handle` is live.
+  /// The window can't be destroyed while `fn` runs, which makes this the
+  /// safe way to touch a window from a non-platform thread. Returns false
+  /// for a stale handle.
+  template <typename Fn>
+  bool WithWindow(WindowHandle handle, Fn&& fn) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    const Slot* slot = SlotFor(handle);
+    if (!slot) return false;
+    fn(*slot->window);
+    return true;
+  }
+
+  /// Handle for `id`, or kInvalidWindowHandle if not stored.
+  WindowHandle Resolve(const std::string& id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = index_.find(id);
+    return it != index_.end() ? MakeHandle(it->second) : kInvalidWindowHandle;
   }
 
-  bool Exists(const std::string& id) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return windows_.count(id) > 0;
+  /// Slot index encoded in `handle`; dense, below the number of windows
+  /// ever stored at once. See SlotArray.
+  static size_t SlotIndex(WindowHandle handle) {
+    return static_cast<uint32_t>(handle) & kIndexMask;
   }
 
-  void Store(const std::string& id, std::unique_ptr<PaletteWindow> window) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    windows_[id] = std::move(window);
+  bool Exists(const std::string& id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return index_.count(id) > 0;
+  }
+
+  size_t Count() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return index_.size();
+  }
+
+  /// Store `window` under `id`, replacing any window already there (whose
+  /// handle goes stale). Returns the new handle, also written to
+  /// `window->handle`.
+  WindowHandle Store(const std::string& id,
+                     std::unique_ptr<PaletteWindow> window) {
+    std::unique_ptr<PaletteWindow> replaced;
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    uint32_t index;
+    auto it = index_.find(id);
+    if (it != index_.end()) {
+      index = it->second;
+      replaced = std::move(slots_[index].window);
+      BumpGeneration(slots_[index]);
+    } else if (!free_.empty()) {
+      index = free_.back();
+      free_.pop_back();
+      index_.emplace(id, index);
+    } else {
+      index = static_cast<uint32_t>(slots_.size());
+      slots_.push_back(Slot{});
+      index_.emplace(id, index);
+    }
+    WindowHandle handle = MakeHandle(index);
+    window->handle = handle;
+    slots_[index].window = std::move(window);
+    return handle;
   }
 
   std::unique_ptr<PaletteWindow> Remove(const std::string& id) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = windows_.find(id);
-    if (it == windows_.end()) return nullptr;
-    auto window = std::move(it->second);
-    windows_.erase(it);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = index_.find(id);
+    if (it == index_.end()) return nullptr;
+    uint32_t index = it->second;
+    index_.erase(it);
+    auto window = std::move(slots_[index].window);
+    BumpGeneration(slots_[index]);
+    free_.push_back(index);
+    window->handle = kInvalidWindowHandle;
     return window;
   }
 
   void Clear() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    windows_.clear();
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    // Keep generations so outstanding handles stay stale.
+    for (uint32_t i = 0; i < slots_.size(); ++i) {
+      if (!slots_[i].window) continue;
+      slots_[i].window.reset();
+      BumpGeneration(slots_[i]);
+      free_.push_back(i);
+    }
+    index_.clear();
   }
 
-  // Returns snapshot of all windows (raw pointers, caller must not store).
-  std::unordered_map<std::string, PaletteWindow*> All() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    std::unordered_map<std::string, PaletteWindow*> result;
-    for (auto& [id, window] : windows_) {
-      result[id] = window.get();
+  /// Visit every stored window under the shared lock, without allocating.
+  /// `fn(PaletteWindow&)` must not create or destroy windows; copy what it
+  /// needs (or use Snapshot) when it has to.
+  template <typename Fn>
+  void ForEach(Fn&& fn) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    for (const auto& slot : slots_) {
+      if (slot.window) fn(*slot.window);
     }
-    return result;
+  }
+
+  /// Fill `out` with raw pointers to all windows (caller must not store
+  /// them). Reuses `out`'s capacity, so a long-lived vector makes repeated
+  /// snapshots allocation-free.
+  void Snapshot(std::vector<PaletteWindow*>* out) const {
+    out->clear();
+    ForEach([out](PaletteWindow& window) { out->push_back(&window); });
   }
 
  private:
+  // Handle layout: low 16 bits slot index, next 15 bits generation (never
+  // 0), so the handle is always a positive int32_t and 0 is never issued.
+  static constexpr uint32_t kIndexBits = 16;
+  static constexpr uint32_t kIndexMask = (1u << kIndexBits) - 1;
+  static constexpr uint32_t kGenerationMask = 0x7FFF;
+
+  struct Slot {
+    std::unique_ptr<PaletteWindow> window;
+    uint32_t generation = 1;
+  };
+
   WindowStore() = default;
-  std::mutex mutex_;
-  std::unordered_map<std::string, std::unique_ptr<PaletteWindow>> windows_;
+
+  WindowHandle MakeHandle(uint32_t index) const {
+    return static_cast<WindowHandle>((slots_[index].generation << kIndexBits) |
+                                     index);
+  }
+
+  const Slot* SlotFor(WindowHandle handle) const {
+    if (handle <= 0) return nullptr;
+    uint32_t raw = static_cast<uint32_t>(handle);
+    uint32_t index = raw & kIndexMask;
+    if (index >= slots_.size()) return nullptr;
+    const Slot& slot = slots_[index];
+    if (!slot.window || slot.generation != (raw >> kIndexBits)) return nullptr;
+    return &slot;
+  }
+
+  static void BumpGeneration(Slot& slot) {
+    slot.generation = (slot.generation + 1) & kGenerationMask;
+    if (slot.generation == 0) slot.generation = 1;
+  }
+
+  mutable std::shared_mutex mutex_;
+  std::vector<Slot> slots_;
+  std::vector<uint32_t> free_;
+  std::unordered_map<std::string, uint32_t> index_;
 };
 
 }  // namespace floating_palette
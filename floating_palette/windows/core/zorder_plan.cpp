@@ -0,0 +1,43 @@
+#include "zorder_plan.h"
+
+#include <algorithm>
+
+namespace floating_palette {
+
+std::vector<ZOrderMove> PlanZOrder(const std::vector<int>& current_rank) {
+  const size_t count = current_rank.size();
+
+  // Longest strictly increasing run of ranks (patience sorting): tails[k]
+  // is the index ending the best run of length k + 1 so far.
+  std::vector<size_t> tails;
+  std::vector<int> previous(count, -1);
+  for (size_t i = 0; i < count; ++i) {
+    int rank = current_rank[i];
+    if (rank < 0) continue;
+    auto slot = std::lower_bound(
+        tails.begin(), tails.end(), rank,
+        [&](size_t index, int value) { return current_rank[index] < value; });
+    if (slot != tails.begin()) previous[i] = static_cast<int>(*(slot - 1));
+    if (slot == tails.end()) {
+      tails.push_back(i);
+    } else {
+      *slot = i;
+    }
+  }
+
+  std::vector<bool> stays(count, false);
+  for (int i = tails.empty() ? -1 : static_cast<int>(tails.back()); i >= 0;
+       i = previous[i]) {
+    stays[i] = true;
+  }
+
+  std::vector<ZOrderMove> moves;
+  for (size_t i = 0; i < count; ++i) {
+    if (stays[i]) continue;
+    moves.push_back({i, i == 0 ? ZOrderMove::kGroupTop
+                               : static_cast<int>(i - 1)});
+  }
+  return moves;
+}
+
+}  // namespace floating_palette
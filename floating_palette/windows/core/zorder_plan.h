@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace floating_palette {
+
+/// One z-order move: place `desired[window]` directly below
+/// `desired[after]`, or, for `after == kGroupTop`, above every other window
+/// in the group.
+struct ZOrderMove {
+  static constexpr int kGroupTop = -1;
+  size_t window;
+  int after;
+};
+
+/// Fewest moves that turn the current stacking of a group of windows into
+/// `desired` (top to bottom).
+///
+/// `current_rank[i]` is where `desired[i]` sits in the current stacking
+/// (any increasing measure, top first), or -1 if unknown; unknown windows
+/// always move. The windows whose current ranks form the longest
+/// increasing run through `desired` already have the right relative order
+/// and stay put; every other window is inserted below its predecessor in
+/// `desired`. Moves are listed top to bottom, so applying them in order
+/// (including in one DeferWindowPos batch) always inserts below a window
+/// that is already in place.
+///
+/// A window already at the top of the group that should stay there is
+/// never moved, so a kGroupTop anchor is always a window outside the group.
+std::vector<ZOrderMove> PlanZOrder(const std::vector<int>& current_rank);
+
+}  // namespace floating_palette
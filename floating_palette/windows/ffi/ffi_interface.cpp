@@ -1,6 +1,23 @@
 #include "ffi_interface.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "../core/active_app_tracker.h"
+#include "../core/clock.h"
+#include "../core/frame_batch.h"
+#include "../core/glass_animation_driver.h"
+#include "../core/glass_backdrop.h"
+#include "../core/hit_test_mask.h"
 #include "../core/logger.h"
+#include "../core/message_ring.h"
+#include "../core/metrics.h"
+#include "../core/monitor_topology.h"
+#include "../core/palette_panel.h"
+#include "../core/placement_solver.h"
+#include "../core/reveal_pipeline.h"
 #include "../core/window_store.h"
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -9,24 +26,117 @@
 
 void FloatingPalette_ResizeWindow(const char* window_id, double width,
                                   double height) {
-  // TODO: Resize HWND via SetWindowPos
-  FP_LOG("FFI", "ResizeWindow stub");
+  if (!window_id) return;
+  FloatingPalette_ResizeWindowByHandle(
+      FloatingPalette_ResolveHandle(window_id), width, height);
 }
 
 bool FloatingPalette_GetWindowFrame(const char* window_id, double* out_x,
                                     double* out_y, double* out_width,
                                     double* out_height) {
-  // TODO: GetWindowRect
+  int32_t handle = window_id ? FloatingPalette_ResolveHandle(window_id) : 0;
+  return FloatingPalette_GetWindowFrameByHandle(handle, out_x, out_y,
+                                                out_width, out_height);
+}
+
+bool FloatingPalette_IsWindowVisible(const char* window_id) {
+  if (!window_id) return false;
+  return FloatingPalette_IsWindowVisibleByHandle(
+      FloatingPalette_ResolveHandle(window_id));
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// WINDOW HANDLES
+// ═══════════════════════════════════════════════════════════════════════════
+
+int32_t FloatingPalette_ResolveHandle(const char* window_id) {
+  if (!window_id) return floating_palette::kInvalidWindowHandle;
+  return floating_palette::WindowStore::Instance().Resolve(window_id);
+}
+
+bool FloatingPalette_ResizeWindowByHandle(int32_t handle, double width,
+                                          double height) {
+  // Called on the Dart UI thread mid-layout: record and let the platform
+  // thread apply it, never block here on a cross-thread SetWindowPos.
+  return floating_palette::WindowStore::Instance().WithWindow(
+      handle, [&](floating_palette::PaletteWindow& window) {
+        floating_palette::PalettePanel::RequestResize(window, width, height);
+      });
+}
+
+bool FloatingPalette_GetWindowFrameByHandle(int32_t handle, double* out_x,
+                                            double* out_y, double* out_width,
+                                            double* out_height) {
   if (out_x) *out_x = 0;
   if (out_y) *out_y = 0;
   if (out_width) *out_width = 0;
   if (out_height) *out_height = 0;
-  return false;
+
+  // Cached by the window procedure; no Win32 call or cross-thread
+  // message from the caller's (usually the Dart UI) thread.
+  floating_palette::FrameSnapshot frame;
+  bool loaded = false;
+  floating_palette::WindowStore::Instance().WithWindow(
+      handle, [&](floating_palette::PaletteWindow& window) {
+        loaded = window.frame.Load(&frame);
+      });
+  if (!loaded) return false;
+
+  const RECT& rect = frame.physical;
+  if (out_x) *out_x = static_cast<double>(rect.left);
+  if (out_y) *out_y = static_cast<double>(rect.top);
+  if (out_width) *out_width = static_cast<double>(rect.right - rect.left);
+  if (out_height) *out_height = static_cast<double>(rect.bottom - rect.top);
+  return true;
 }
 
-bool FloatingPalette_IsWindowVisible(const char* window_id) {
-  // TODO: IsWindowVisible(hwnd)
-  return false;
+bool FloatingPalette_SetWindowFramesByHandle(
+    const FloatingPaletteFrame* frames, int32_t count) {
+  if (!frames || count <= 0) return count == 0;
+  std::vector<floating_palette::WindowHandle> handles(count);
+  std::vector<RECT> rects(count);
+  for (int32_t i = 0; i < count; ++i) {
+    const FloatingPaletteFrame& frame = frames[i];
+    handles[i] = frame.handle;
+    rects[i].left = static_cast<LONG>(std::lround(frame.x));
+    rects[i].top = static_cast<LONG>(std::lround(frame.y));
+    rects[i].right =
+        rects[i].left + static_cast<LONG>(std::lround(frame.width));
+    rects[i].bottom =
+        rects[i].top + static_cast<LONG>(std::lround(frame.height));
+  }
+  // Usually the Dart UI thread: recorded here, applied on the platform
+  // thread as one batch.
+  return floating_palette::FrameBatch::Instance().Request(
+      handles.data(), rects.data(), static_cast<size_t>(count));
+}
+
+int32_t FloatingPalette_GetWindowFramesByHandle(FloatingPaletteFrame* frames,
+                                                int32_t count) {
+  if (!frames) return 0;
+  int32_t found = 0;
+  for (int32_t i = 0; i < count; ++i) {
+    FloatingPaletteFrame& frame = frames[i];
+    if (FloatingPalette_GetWindowFrameByHandle(frame.handle, &frame.x,
+                                               &frame.y, &frame.width,
+                                               &frame.height)) {
+      ++found;
+    } else {
+      frame.handle = floating_palette::kInvalidWindowHandle;
+    }
+  }
+  return found;
+}
+
+bool FloatingPalette_IsWindowVisibleByHandle(int32_t handle) {
+  // Dart isolate thread: read under the store's lock so a destroy on the
+  // platform thread can't free the window mid-check.
+  bool shown = false;
+  floating_palette::WindowStore::Instance().WithWindow(
+      handle, [&](floating_palette::PaletteWindow& window) {
+        shown = floating_palette::RevealPipeline::IsShown(window);
+      });
+  return shown;
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -47,48 +157,72 @@ void FloatingPalette_GetCursorPosition(double* out_x, double* out_y) {
 int32_t FloatingPalette_GetCursorScreen(void) {
   POINT pt;
   if (!GetCursorPos(&pt)) return -1;
-
-  HMONITOR monitor = MonitorFromPoint(pt, MONITOR_DEFAULTTONULL);
-  if (!monitor) return -1;
-
-  // TODO: Map HMONITOR to screen index
-  return 0;
+  return floating_palette::MonitorTopology::Instance().IndexAtPoint(pt);
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
 // SCREEN INFO
+// Served from the cached MonitorTopology snapshot: no Win32 calls.
 // ═══════════════════════════════════════════════════════════════════════════
 
+namespace {
+
+/// Monitor `screen_index` of `topology`, or null. The caller holds the
+/// snapshot for as long as it reads the result.
+const floating_palette::MonitorInfo* ScreenAt(
+    const floating_palette::MonitorTopology::Snapshot& topology,
+    int32_t screen_index) {
+  const auto& monitors = topology.monitors;
+  if (screen_index < 0 ||
+      static_cast<size_t>(screen_index) >= monitors.size()) {
+    return nullptr;
+  }
+  return &monitors[screen_index];
+}
+
+bool WriteRect(const RECT* rect, double* out_x, double* out_y,
+               double* out_width, double* out_height) {
+  if (out_x) *out_x = rect ? static_cast<double>(rect->left) : 0;
+  if (out_y) *out_y = rect ? static_cast<double>(rect->top) : 0;
+  if (out_width) {
+    *out_width = rect ? static_cast<double>(rect->right - rect->left) : 0;
+  }
+  if (out_height) {
+    *out_height = rect ? static_cast<double>(rect->bottom - rect->top) : 0;
+  }
+  return rect != nullptr;
+}
+
+}  // namespace
+
 int32_t FloatingPalette_GetScreenCount(void) {
-  return GetSystemMetrics(SM_CMONITORS);
+  return static_cast<int32_t>(
+      floating_palette::MonitorTopology::Instance().Current()->monitors.size());
 }
 
 bool FloatingPalette_GetScreenBounds(int32_t screen_index, double* out_x,
                                      double* out_y, double* out_width,
                                      double* out_height) {
-  // TODO: Enumerate monitors and return bounds for given index
-  if (out_x) *out_x = 0;
-  if (out_y) *out_y = 0;
-  if (out_width) *out_width = 0;
-  if (out_height) *out_height = 0;
-  return false;
+  const auto topology = floating_palette::MonitorTopology::Instance().Current();
+  const auto* screen = ScreenAt(*topology, screen_index);
+  return WriteRect(screen ? &screen->bounds : nullptr, out_x, out_y,
+                   out_width, out_height);
 }
 
 bool FloatingPalette_GetScreenVisibleBounds(int32_t screen_index,
                                             double* out_x, double* out_y,
                                             double* out_width,
                                             double* out_height) {
-  // TODO: SystemParametersInfo(SPI_GETWORKAREA, ...) for given monitor
-  if (out_x) *out_x = 0;
-  if (out_y) *out_y = 0;
-  if (out_width) *out_width = 0;
-  if (out_height) *out_height = 0;
-  return false;
+  const auto topology = floating_palette::MonitorTopology::Instance().Current();
+  const auto* screen = ScreenAt(*topology, screen_index);
+  return WriteRect(screen ? &screen->work_area : nullptr, out_x, out_y,
+                   out_width, out_height);
 }
 
 double FloatingPalette_GetScreenScaleFactor(int32_t screen_index) {
-  // TODO: GetDpiForMonitor for given monitor
-  return 1.0;
+  const auto topology = floating_palette::MonitorTopology::Instance().Current();
+  const auto* screen = ScreenAt(*topology, screen_index);
+  return screen ? screen->scale_factor : 1.0;
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -98,12 +232,11 @@ double FloatingPalette_GetScreenScaleFactor(int32_t screen_index) {
 bool FloatingPalette_GetActiveAppBounds(double* out_x, double* out_y,
                                         double* out_width,
                                         double* out_height) {
-  HWND fg = GetForegroundWindow();
-  if (!fg) return false;
-
-  RECT rect;
-  if (!GetWindowRect(fg, &rect)) return false;
+  // Kept current by WinEvent hooks; no window or process queries here.
+  const auto app = floating_palette::ActiveAppTracker::Instance().Current();
+  if (!app.valid) return false;
 
+  const RECT& rect = app.bounds;
   if (out_x) *out_x = static_cast<double>(rect.left);
   if (out_y) *out_y = static_cast<double>(rect.top);
   if (out_width) *out_width = static_cast<double>(rect.right - rect.left);
@@ -113,50 +246,334 @@ bool FloatingPalette_GetActiveAppBounds(double* out_x, double* out_y,
 
 int32_t FloatingPalette_GetActiveAppIdentifier(char* out_buffer,
                                                int32_t buffer_size) {
-  // TODO: GetForegroundWindow → GetWindowThreadProcessId → process name
-  if (out_buffer && buffer_size > 0) {
-    out_buffer[0] = '\0';
+  if (!out_buffer || buffer_size <= 0) return 0;
+  const auto app = floating_palette::ActiveAppTracker::Instance().Current();
+  const int32_t length = static_cast<int32_t>(
+      std::min<size_t>(app.identifier.size(), buffer_size - 1));
+  std::memcpy(out_buffer, app.identifier.data(), length);
+  out_buffer[length] = '\0';
+  return length;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// PLACEMENT
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool FloatingPalette_SolvePlacement(const FloatingPalettePlacement* placement,
+                                    FloatingPaletteFrame* out_frame) {
+  if (out_frame) *out_frame = FloatingPaletteFrame{};
+  if (!placement || placement->target < 0 || placement->target > 2) {
+    return false;
   }
-  return 0;
+
+  // The window's cached frame: its size when the spec gives none.
+  floating_palette::FrameSnapshot current;
+  bool loaded = false;
+  floating_palette::WindowStore::Instance().WithWindow(
+      placement->handle, [&](floating_palette::PaletteWindow& window) {
+        loaded = window.frame.Load(&current);
+      });
+  if (!loaded) return false;
+
+  floating_palette::PlacementRequest request;
+  request.target =
+      static_cast<floating_palette::PlacementTarget>(placement->target);
+  request.anchor = placement->anchor;
+  request.point = {static_cast<LONG>(std::lround(placement->x)),
+                   static_cast<LONG>(std::lround(placement->y))};
+  request.offset_x = placement->offset_x;
+  request.offset_y = placement->offset_y;
+  request.width = placement->width;
+  request.height = placement->height;
+  request.current_size = {current.physical.right - current.physical.left,
+                          current.physical.bottom - current.physical.top};
+  request.avoid_edges =
+      (placement->flags & FLOATING_PALETTE_PLACEMENT_AVOID_EDGES) != 0;
+
+  floating_palette::PlacementResult result;
+  if (!floating_palette::SolvePlacement(request, &result)) return false;
+
+  if (placement->flags & FLOATING_PALETTE_PLACEMENT_APPLY) {
+    const floating_palette::WindowHandle handle = placement->handle;
+    if (!floating_palette::FrameBatch::Instance().Request(&handle,
+                                                          &result.frame, 1)) {
+      return false;
+    }
+  }
+
+  if (out_frame) {
+    const RECT& frame = result.frame;
+    out_frame->handle = placement->handle;
+    out_frame->x = static_cast<double>(frame.left);
+    out_frame->y = static_cast<double>(frame.top);
+    out_frame->width = static_cast<double>(frame.right - frame.left);
+    out_frame->height = static_cast<double>(frame.bottom - frame.top);
+  }
+  return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// WINDOW QUERIES
+// The read-only commands' answers, under the store's shared lock only: no
+// platform-thread hop, so a query never waits on an animation tick or a
+// capture starting up.
+// ═══════════════════════════════════════════════════════════════════════════
+
+bool FloatingPalette_QueryWindow(int32_t handle,
+                                 FloatingPaletteWindowState* out_state) {
+  if (!out_state) return false;
+  *out_state = FloatingPaletteWindowState{};
+  const HWND foreground = GetForegroundWindow();
+  return floating_palette::WindowStore::Instance().WithWindow(
+      handle, [&](floating_palette::PaletteWindow& window) {
+        out_state->handle = handle;
+        floating_palette::FrameSnapshot frame;
+        if (window.frame.Load(&frame)) {
+          out_state->flags |= FLOATING_PALETTE_WINDOW_HAS_FRAME;
+          out_state->x = frame.x;
+          out_state->y = frame.y;
+          out_state->width = frame.width;
+          out_state->height = frame.height;
+        }
+        if (floating_palette::RevealPipeline::IsShown(window)) {
+          out_state->flags |= FLOATING_PALETTE_WINDOW_VISIBLE;
+        }
+        if (window.hwnd && window.hwnd == foreground) {
+          out_state->flags |= FLOATING_PALETTE_WINDOW_FOCUSED;
+        }
+      });
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
-// GLASS MASK EFFECT (no-op stubs — macOS-only feature)
+// GLASS MASK EFFECT (DWM system backdrop: core/glass_backdrop.h)
 // ═══════════════════════════════════════════════════════════════════════════
 
 void* FloatingPalette_CreateGlassPathBuffer(const char* window_id) {
-  return nullptr;
+  return FloatingPalette_CreateGlassPathBufferLayer(window_id, 0);
+}
+
+void* FloatingPalette_CreateGlassPathBufferLayer(const char* window_id,
+                                                 int32_t layer_id) {
+  if (!window_id) return nullptr;
+  return floating_palette::GlassBackdrop::Instance().CreateBuffer(window_id,
+                                                                  layer_id);
+}
+
+void FloatingPalette_DestroyGlassPathBuffer(const char* window_id) {
+  FloatingPalette_DestroyGlassPathBufferLayer(window_id, 0);
 }
 
-void FloatingPalette_DestroyGlassPathBuffer(const char* window_id) {}
+void FloatingPalette_DestroyGlassPathBufferLayer(const char* window_id,
+                                                 int32_t layer_id) {
+  if (!window_id) return;
+  floating_palette::GlassBackdrop::Instance().DestroyBuffer(window_id,
+                                                            layer_id);
+}
 
-void FloatingPalette_SetGlassEnabled(const char* window_id, bool enabled) {}
+void FloatingPalette_SetGlassEnabled(const char* window_id, bool enabled) {
+  if (!window_id) return;
+  floating_palette::GlassBackdrop::Instance().SetEnabled(window_id, enabled);
+}
 
 void FloatingPalette_SetGlassMaterial(const char* window_id,
-                                      int32_t material) {}
+                                      int32_t material) {
+  FloatingPalette_SetGlassMaterialLayer(window_id, 0, material);
+}
+
+void FloatingPalette_SetGlassMaterialLayer(const char* window_id,
+                                           int32_t layer_id,
+                                           int32_t material) {
+  if (!window_id) return;
+  floating_palette::GlassBackdrop::Instance().SetMaterial(window_id, layer_id,
+                                                          material);
+}
+
+void FloatingPalette_SetGlassDark(const char* window_id, bool is_dark) {
+  FloatingPalette_SetGlassDarkLayer(window_id, 0, is_dark);
+}
 
-void FloatingPalette_SetGlassDark(const char* window_id, bool is_dark) {}
+void FloatingPalette_SetGlassDarkLayer(const char* window_id,
+                                       int32_t layer_id,
+                                       bool is_dark) {
+  if (!window_id) return;
+  floating_palette::GlassBackdrop::Instance().SetDark(window_id, layer_id,
+                                                      is_dark);
+}
 
 void FloatingPalette_SetGlassTintOpacity(const char* window_id, float opacity,
-                                         float corner_radius) {}
+                                         float corner_radius) {
+  FloatingPalette_SetGlassTintOpacityLayer(window_id, 0, opacity,
+                                           corner_radius);
+}
+
+void FloatingPalette_SetGlassTintOpacityLayer(const char* window_id,
+                                              int32_t layer_id,
+                                              float opacity,
+                                              float corner_radius) {
+  if (!window_id) return;
+  floating_palette::GlassBackdrop::Instance().SetTintOpacity(
+      window_id, layer_id, opacity, corner_radius);
+}
 
 // ═══════════════════════════════════════════════════════════════════════════
-// GLASS ANIMATION (no-op stubs — macOS-only feature)
+// GLASS ANIMATION
 // ═══════════════════════════════════════════════════════════════════════════
 
 double FloatingPalette_GetCurrentTime(void) {
   // High-resolution timer (equivalent to CACurrentMediaTime on macOS)
-  LARGE_INTEGER freq, counter;
-  QueryPerformanceFrequency(&freq);
-  QueryPerformanceCounter(&counter);
-  return static_cast<double>(counter.QuadPart) /
-         static_cast<double>(freq.QuadPart);
+  return floating_palette::MonotonicSeconds();
 }
 
 void* FloatingPalette_CreateAnimationBuffer(const char* window_id,
                                             int32_t layer_id) {
-  return nullptr;
+  if (!window_id) return nullptr;
+  return floating_palette::GlassAnimationDriver::Instance().CreateBuffer(
+      window_id, layer_id);
 }
 
 void FloatingPalette_DestroyAnimationBuffer(const char* window_id,
-                                            int32_t layer_id) {}
+                                            int32_t layer_id) {
+  if (!window_id) return;
+  floating_palette::GlassAnimationDriver::Instance().DestroyBuffer(window_id,
+                                                                   layer_id);
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// MESSAGE RINGS
+// ═══════════════════════════════════════════════════════════════════════════
+
+void* FloatingPalette_CreateMessageRing(const char* window_id,
+                                        uint32_t capacity) {
+  return FloatingPalette_CreateMessageRingChannel(window_id, 0, capacity);
+}
+
+void* FloatingPalette_CreateMessageRingChannel(const char* window_id,
+                                               int32_t channel,
+                                               uint32_t capacity) {
+  if (!window_id) return nullptr;
+  return floating_palette::MessageRings::Instance().Open(window_id, channel,
+                                                         capacity);
+}
+
+void FloatingPalette_CloseMessageRing(void* ring) {
+  floating_palette::MessageRings::Instance().Close(
+      static_cast<const floating_palette::MessageRing*>(ring));
+}
+
+void FloatingPalette_DestroyMessageRing(const char* window_id,
+                                        int32_t channel) {
+  if (!window_id) return;
+  floating_palette::MessageRings::Instance().Destroy(window_id, channel);
+}
+
+int32_t FloatingPalette_MessageRingWrite(void* ring, const uint8_t* data,
+                                         uint32_t length) {
+  if (!ring || (!data && length)) {
+    return static_cast<int32_t>(
+        floating_palette::MessageRingWriteResult::kDropped);
+  }
+  return static_cast<int32_t>(
+      static_cast<floating_palette::MessageRing*>(ring)->Write(data, length));
+}
+
+int32_t FloatingPalette_MessageRingRead(void* ring, uint8_t* out_buffer,
+                                        uint32_t buffer_size,
+                                        uint32_t* out_length) {
+  if (!ring || !out_length || (!out_buffer && buffer_size)) {
+    return static_cast<int32_t>(
+        floating_palette::MessageRingReadResult::kEmpty);
+  }
+  return static_cast<int32_t>(
+      static_cast<floating_palette::MessageRing*>(ring)->Read(
+          out_buffer, buffer_size, out_length));
+}
+
+void FloatingPalette_SetMessageRingDoorbell(void* ring,
+                                            void (*doorbell)(void)) {
+  if (!ring) return;
+  static_cast<floating_palette::MessageRing*>(ring)->SetDoorbell(doorbell);
+}
+
+void FloatingPalette_GetMessageRingStats(void* ring, uint64_t* out_sent,
+                                         uint64_t* out_received,
+                                         uint64_t* out_dropped,
+                                         uint64_t* out_overflowed) {
+  floating_palette::MessageRing::Stats stats{0, 0, 0, 0};
+  if (ring) {
+    stats = static_cast<floating_palette::MessageRing*>(ring)->GetStats();
+  }
+  if (out_sent) *out_sent = stats.sent;
+  if (out_received) *out_received = stats.received;
+  if (out_dropped) *out_dropped = stats.dropped;
+  if (out_overflowed) *out_overflowed = stats.overflowed;
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// HIT-TEST MASKS
+// ═══════════════════════════════════════════════════════════════════════════
+
+void* FloatingPalette_CreateHitTestMask(const char* window_id) {
+  if (!window_id) return nullptr;
+  // The buffer lives in the PaletteWindow, so it stays valid (if unread)
+  // after Destroy, until the window itself goes.
+  floating_palette::HitTestMaskBuffer* buffer = nullptr;
+  floating_palette::WindowStore::Instance().WithWindow(
+      FloatingPalette_ResolveHandle(window_id),
+      [&](floating_palette::PaletteWindow& window) {
+        buffer = window.hit_test.Publish();
+      });
+  return buffer;
+}
+
+void FloatingPalette_DestroyHitTestMask(const char* window_id) {
+  if (!window_id) return;
+  floating_palette::WindowStore::Instance().WithWindow(
+      FloatingPalette_ResolveHandle(window_id),
+      [](floating_palette::PaletteWindow& window) {
+        window.hit_test.Unpublish();
+      });
+}
+
+// ═══════════════════════════════════════════════════════════════════════════
+// METRICS
+// ═══════════════════════════════════════════════════════════════════════════
+
+void FloatingPalette_GetMetrics(FloatingPaletteMetrics* out) {
+  if (!out) return;
+  floating_palette::MetricsSnapshot metrics;
+  floating_palette::Metrics::Instance().Read(&metrics);
+  out->events_emitted = metrics.events_emitted;
+  out->events_coalesced = metrics.events_coalesced;
+  out->event_flushes = metrics.event_flushes;
+  out->window_pos_calls = metrics.window_pos_calls;
+  out->window_pos_batches = metrics.window_pos_batches;
+  out->window_pos_batched_windows = metrics.window_pos_batched_windows;
+  out->animation_frames = metrics.animation_frames;
+  out->animation_frames_dropped = metrics.animation_frames_dropped;
+  out->capture_frames = metrics.capture_frames;
+  out->capture_fps = metrics.capture_fps;
+}
+
+int32_t FloatingPalette_GetServiceMetrics(FloatingPaletteServiceMetrics* out,
+                                          int32_t capacity) {
+  constexpr auto kCount =
+      static_cast<int32_t>(floating_palette::MetricsSnapshot::kServiceCount);
+  if (!out || capacity <= 0) return kCount;
+  floating_palette::MetricsSnapshot metrics;
+  floating_palette::Metrics::Instance().Read(&metrics);
+  for (int32_t i = 0; i < kCount && i < capacity; ++i) {
+    const auto& service = metrics.services[i];
+    out[i] = FloatingPaletteServiceMetrics{service.commands, service.p50_ms,
+                                           service.p99_ms, service.max_ms};
+  }
+  return kCount;
+}
+
+const char* FloatingPalette_GetMetricsServiceName(int32_t index) {
+  if (index < 0) return nullptr;
+  return floating_palette::Metrics::ServiceName(static_cast<size_t>(index));
+}
+
+void FloatingPalette_ResetMetrics(void) {
+  floating_palette::Metrics::Instance().Reset();
+}
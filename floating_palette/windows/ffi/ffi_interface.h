@@ -8,7 +8,12 @@
 /// - Cursor position queries
 /// - Screen bounds queries
 /// - Active app bounds queries
-/// - Glass mask effect (no-op stubs on Windows)
+/// - Anchored placement in one call
+/// - Read-only window queries (bounds, visibility, focus)
+/// - Glass effect: DWM system backdrop clipped to the GlassPathBuffer
+///   paths of each layer (GlassBackdrop)
+/// - Shared-memory message rings between engines
+/// - Pointer passthrough hit-test masks
 ///
 /// IMPORTANT: Keep function signatures in sync with src/ffi_interface.h
 
@@ -40,6 +45,47 @@ __declspec(dllexport) bool FloatingPalette_GetWindowFrame(
 __declspec(dllexport) bool FloatingPalette_IsWindowVisible(
     const char* window_id);
 
+// ═══════════════════════════════════════════════════════════════════════════
+// WINDOW HANDLES
+// ═══════════════════════════════════════════════════════════════════════════
+
+__declspec(dllexport) int32_t FloatingPalette_ResolveHandle(
+    const char* window_id);
+
+__declspec(dllexport) bool FloatingPalette_ResizeWindowByHandle(
+    int32_t handle,
+    double width,
+    double height);
+
+__declspec(dllexport) bool FloatingPalette_GetWindowFrameByHandle(
+    int32_t handle,
+    double* out_x,
+    double* out_y,
+    double* out_width,
+    double* out_height);
+
+__declspec(dllexport) bool FloatingPalette_IsWindowVisibleByHandle(
+    int32_t handle);
+
+// Must match FloatingPaletteFrame in src/ffi_interface.h.
+typedef struct {
+  int32_t handle;
+  double x;
+  double y;
+  double width;
+  double height;
+} FloatingPaletteFrame;
+
+/// Applied on the platform thread as one DeferWindowPos batch
+/// (core/frame_batch.h). Physical pixels.
+__declspec(dllexport) bool FloatingPalette_SetWindowFramesByHandle(
+    const FloatingPaletteFrame* frames,
+    int32_t count);
+
+__declspec(dllexport) int32_t FloatingPalette_GetWindowFramesByHandle(
+    FloatingPaletteFrame* frames,
+    int32_t count);
+
 // ═══════════════════════════════════════════════════════════════════════════
 // CURSOR POSITION
 // ═══════════════════════════════════════════════════════════════════════════
@@ -88,15 +134,76 @@ __declspec(dllexport) int32_t FloatingPalette_GetActiveAppIdentifier(
     int32_t buffer_size);
 
 // ═══════════════════════════════════════════════════════════════════════════
-// GLASS MASK EFFECT (no-op stubs — macOS-only feature)
+// PLACEMENT (core/placement_solver.h)
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define FLOATING_PALETTE_PLACEMENT_AVOID_EDGES 1
+#define FLOATING_PALETTE_PLACEMENT_APPLY 2
+
+// Must match FloatingPalettePlacement in src/ffi_interface.h.
+typedef struct {
+  int32_t handle;
+  int32_t target;
+  int32_t anchor;
+  int32_t flags;
+  double x;
+  double y;
+  double offset_x;
+  double offset_y;
+  double width;
+  double height;
+} FloatingPalettePlacement;
+
+/// Solved against the cached MonitorTopology. With
+/// FLOATING_PALETTE_PLACEMENT_APPLY the frame goes through FrameBatch like
+/// FloatingPalette_SetWindowFramesByHandle. Physical pixels.
+__declspec(dllexport) bool FloatingPalette_SolvePlacement(
+    const FloatingPalettePlacement* placement,
+    FloatingPaletteFrame* out_frame);
+
+// ═══════════════════════════════════════════════════════════════════════════
+// WINDOW QUERIES
+// ═══════════════════════════════════════════════════════════════════════════
+
+#define FLOATING_PALETTE_WINDOW_VISIBLE 1
+#define FLOATING_PALETTE_WINDOW_FOCUSED 2
+#define FLOATING_PALETTE_WINDOW_HAS_FRAME 4
+
+// Must match FloatingPaletteWindowState in src/ffi_interface.h.
+typedef struct {
+  int32_t handle;
+  int32_t flags;
+  double x;
+  double y;
+  double width;
+  double height;
+} FloatingPaletteWindowState;
+
+/// Served from the window's FrameCache and RevealPipeline state on the
+/// calling thread, never the platform thread. Logical pixels, matching
+/// frame/getBounds.
+__declspec(dllexport) bool FloatingPalette_QueryWindow(
+    int32_t handle,
+    FloatingPaletteWindowState* out_state);
+
+// ═══════════════════════════════════════════════════════════════════════════
+// GLASS MASK EFFECT (DWM system backdrop: core/glass_backdrop.h)
 // ═══════════════════════════════════════════════════════════════════════════
 
 __declspec(dllexport) void* FloatingPalette_CreateGlassPathBuffer(
     const char* window_id);
 
+__declspec(dllexport) void* FloatingPalette_CreateGlassPathBufferLayer(
+    const char* window_id,
+    int32_t layer_id);
+
 __declspec(dllexport) void FloatingPalette_DestroyGlassPathBuffer(
     const char* window_id);
 
+__declspec(dllexport) void FloatingPalette_DestroyGlassPathBufferLayer(
+    const char* window_id,
+    int32_t layer_id);
+
 __declspec(dllexport) void FloatingPalette_SetGlassEnabled(
     const char* window_id,
     bool enabled);
@@ -105,17 +212,33 @@ __declspec(dllexport) void FloatingPalette_SetGlassMaterial(
     const char* window_id,
     int32_t material);
 
+__declspec(dllexport) void FloatingPalette_SetGlassMaterialLayer(
+    const char* window_id,
+    int32_t layer_id,
+    int32_t material);
+
 __declspec(dllexport) void FloatingPalette_SetGlassDark(
     const char* window_id,
     bool is_dark);
 
+__declspec(dllexport) void FloatingPalette_SetGlassDarkLayer(
+    const char* window_id,
+    int32_t layer_id,
+    bool is_dark);
+
 __declspec(dllexport) void FloatingPalette_SetGlassTintOpacity(
     const char* window_id,
     float opacity,
     float corner_radius);
 
+__declspec(dllexport) void FloatingPalette_SetGlassTintOpacityLayer(
+    const char* window_id,
+    int32_t layer_id,
+    float opacity,
+    float corner_radius);
+
 // ═══════════════════════════════════════════════════════════════════════════
-// GLASS ANIMATION (no-op stubs — macOS-only feature)
+// GLASS ANIMATION (native reader: core/glass_animation_driver.h)
 // ═══════════════════════════════════════════════════════════════════════════
 
 __declspec(dllexport) double FloatingPalette_GetCurrentTime(void);
@@ -128,6 +251,95 @@ __declspec(dllexport) void FloatingPalette_DestroyAnimationBuffer(
     const char* window_id,
     int32_t layer_id);
 
+// ═══════════════════════════════════════════════════════════════════════════
+// MESSAGE RINGS (shared-memory SPSC transport: core/message_ring.h)
+// ═══════════════════════════════════════════════════════════════════════════
+
+__declspec(dllexport) void* FloatingPalette_CreateMessageRing(
+    const char* window_id,
+    uint32_t capacity);
+
+__declspec(dllexport) void* FloatingPalette_CreateMessageRingChannel(
+    const char* window_id,
+    int32_t channel,
+    uint32_t capacity);
+
+__declspec(dllexport) void FloatingPalette_CloseMessageRing(void* ring);
+
+__declspec(dllexport) void FloatingPalette_DestroyMessageRing(
+    const char* window_id,
+    int32_t channel);
+
+__declspec(dllexport) int32_t FloatingPalette_MessageRingWrite(
+    void* ring,
+    const uint8_t* data,
+    uint32_t length);
+
+__declspec(dllexport) int32_t FloatingPalette_MessageRingRead(
+    void* ring,
+    uint8_t* out_buffer,
+    uint32_t buffer_size,
+    uint32_t* out_length);
+
+__declspec(dllexport) void FloatingPalette_SetMessageRingDoorbell(
+    void* ring,
+    void (*doorbell)(void));
+
+__declspec(dllexport) void FloatingPalette_GetMessageRingStats(
+    void* ring,
+    uint64_t* out_sent,
+    uint64_t* out_received,
+    uint64_t* out_dropped,
+    uint64_t* out_overflowed);
+
+// ═══════════════════════════════════════════════════════════════════════════
+// HIT-TEST MASKS (pointer passthrough: core/hit_test_mask.h)
+// ═══════════════════════════════════════════════════════════════════════════
+
+__declspec(dllexport) void* FloatingPalette_CreateHitTestMask(
+    const char* window_id);
+
+__declspec(dllexport) void FloatingPalette_DestroyHitTestMask(
+    const char* window_id);
+
+// ═══════════════════════════════════════════════════════════════════════════
+// METRICS (core/metrics.h)
+// ═══════════════════════════════════════════════════════════════════════════
+
+// Must match FloatingPaletteServiceMetrics in src/ffi_interface.h.
+typedef struct {
+  uint64_t commands;
+  double p50_ms;
+  double p99_ms;
+  double max_ms;
+} FloatingPaletteServiceMetrics;
+
+// Must match FloatingPaletteMetrics in src/ffi_interface.h.
+typedef struct {
+  uint64_t events_emitted;
+  uint64_t events_coalesced;
+  uint64_t event_flushes;
+  uint64_t window_pos_calls;
+  uint64_t window_pos_batches;
+  uint64_t window_pos_batched_windows;
+  uint64_t animation_frames;
+  uint64_t animation_frames_dropped;
+  uint64_t capture_frames;
+  double capture_fps;
+} FloatingPaletteMetrics;
+
+__declspec(dllexport) void FloatingPalette_GetMetrics(
+    FloatingPaletteMetrics* out);
+
+__declspec(dllexport) int32_t FloatingPalette_GetServiceMetrics(
+    FloatingPaletteServiceMetrics* out,
+    int32_t capacity);
+
+__declspec(dllexport) const char* FloatingPalette_GetMetricsServiceName(
+    int32_t index);
+
+__declspec(dllexport) void FloatingPalette_ResetMetrics(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -6,27 +6,59 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <variant>
+#include <vector>
 
 #include "coordinators/drag_coordinator.h"
+#include "core/batch_collector.h"
+#include "core/clock.h"
+#include "core/command_hash.h"
+#include "core/command_stats.h"
+#include "core/engine_hibernation.h"
+#include "core/event_filter.h"
+#include "core/event_queue.h"
+#include "core/frame_batch.h"
+#include "core/glass_animation_driver.h"
+#include "core/glass_backdrop.h"
 #include "core/logger.h"
+#include "core/metrics.h"
+#include "core/trace.h"
 #include "services/animation_service.h"
 #include "services/appearance_service.h"
 #include "services/background_capture_service.h"
+#include "services/binary_channel.h"
 #include "services/focus_service.h"
 #include "services/frame_service.h"
 #include "services/host_service.h"
+#include "services/hotkey_service.h"
 #include "services/input_service.h"
 #include "services/message_service.h"
 #include "services/screen_service.h"
 #include "services/snap_service.h"
 #include "services/transform_service.h"
 #include "services/visibility_service.h"
+#include "services/window_channel_router.h"
 #include "services/window_service.h"
 #include "services/zorder_service.h"
 
 namespace floating_palette {
 
+namespace {
+
+const flutter::EncodableMap& EmptyParams() {
+  static const flutter::EncodableMap empty;
+  return empty;
+}
+
+const std::string* GetStringField(const flutter::EncodableMap& map,
+                                  const char* key) {
+  auto it = map.find(flutter::EncodableValue(key));
+  return it != map.end() ? std::get_if<std::string>(&it->second) : nullptr;
+}
+
+}  // namespace
+
 // static
 void FloatingPalettePlugin::RegisterWithRegistrar(
     flutter::PluginRegistrarWindows* registrar) {
@@ -36,23 +68,37 @@ void FloatingPalettePlugin::RegisterWithRegistrar(
 
   auto plugin = std::make_unique<FloatingPalettePlugin>(
       registrar, std::move(channel));
-
-  plugin->channel_->SetMethodCallHandler(
-      [plugin_ptr = plugin.get()](const auto& call, auto result) {
-        plugin_ptr->HandleMethodCall(call, std::move(result));
-      });
-
   registrar->AddPlugin(std::move(plugin));
 }
 
 FloatingPalettePlugin::FloatingPalettePlugin(
     flutter::PluginRegistrarWindows* registrar,
     std::unique_ptr<flutter::MethodChannel<flutter::EncodableValue>> channel)
-    : registrar_(registrar), channel_(std::move(channel)) {
+    : registrar_(registrar),
+      channel_(std::move(channel)),
+      command_stats_(std::make_unique<CommandStats>()) {
+  trace::Register();
+  Logger::Start();
+  event_queue_ = std::make_unique<EventQueue>(
+      [this](flutter::EncodableList events) {
+        channel_->InvokeMethod(
+            "events",
+            std::make_unique<flutter::EncodableValue>(std::move(events)));
+      });
   InitializeServices();
+  // Installed here rather than in RegisterWithRegistrar, so a plugin built
+  // on any messenger (the benchmarks') answers calls the same way.
+  channel_->SetMethodCallHandler([this](const auto& call, auto result) {
+    HandleMethodCall(call, std::move(result));
+  });
 }
 
-FloatingPalettePlugin::~FloatingPalettePlugin() = default;
+FloatingPalettePlugin::~FloatingPalettePlugin() {
+  // Palette channels may outlive the plugin briefly during shutdown.
+  WindowChannelRouter::SetServices({});
+  Logger::Stop();
+  trace::Unregister();
+}
 
 void FloatingPalettePlugin::InitializeServices() {
   // Create event sink
@@ -63,12 +109,20 @@ void FloatingPalettePlugin::InitializeServices() {
     SendEvent(service, event, window_id, data);
   };
 
+  // Glass buffers are created over FFI from the Dart UI thread; construct
+  // the readers here so their delivery windows live on this one.
+  GlassAnimationDriver::Instance();
+  GlassBackdrop::Instance();
+  // Batched frame requests arrive over FFI the same way.
+  FrameBatch::Instance();
+
   // Initialize all services
   window_service_ = std::make_unique<WindowService>(registrar_);
   window_service_->SetEventSink(event_sink);
 
   visibility_service_ = std::make_unique<VisibilityService>();
   visibility_service_->SetEventSink(event_sink);
+  EngineHibernation::Instance().SetEventSink(event_sink);
 
   frame_service_ = std::make_unique<FrameService>();
   frame_service_->SetEventSink(event_sink);
@@ -79,7 +133,7 @@ void FloatingPalettePlugin::InitializeServices() {
   animation_service_ = std::make_unique<AnimationService>();
   animation_service_->SetEventSink(event_sink);
 
-  input_service_ = std::make_unique<InputService>();
+  input_service_ = std::make_unique<InputService>(registrar_);
   input_service_->SetEventSink(event_sink);
 
   focus_service_ = std::make_unique<FocusService>();
@@ -91,7 +145,7 @@ void FloatingPalettePlugin::InitializeServices() {
   appearance_service_ = std::make_unique<AppearanceService>();
   appearance_service_->SetEventSink(event_sink);
 
-  screen_service_ = std::make_unique<ScreenService>();
+  screen_service_ = std::make_unique<ScreenService>(registrar_);
   screen_service_->SetEventSink(event_sink);
 
   background_capture_service_ =
@@ -103,13 +157,18 @@ void FloatingPalettePlugin::InitializeServices() {
 
   host_service_ = std::make_unique<HostService>();
   host_service_->SetEventSink(event_sink);
+  host_service_->SetCommandStats(command_stats_.get());
 
   snap_service_ = std::make_unique<SnapService>();
   snap_service_->SetEventSink(event_sink);
 
+  hotkey_service_ = std::make_unique<HotkeyService>();
+  hotkey_service_->SetEventSink(event_sink);
+
   // Create DragCoordinator and wire it up
   drag_coordinator_ = std::make_unique<DragCoordinator>();
   drag_coordinator_->SetDelegate(snap_service_.get());
+  drag_coordinator_->SetEventSink(event_sink);
 
   // Wire cross-service references
   window_service_->SetBackgroundCaptureService(
@@ -121,14 +180,32 @@ void FloatingPalettePlugin::InitializeServices() {
 
   frame_service_->SetSnapService(snap_service_.get());
   frame_service_->SetDragCoordinator(drag_coordinator_.get());
+  frame_service_->SetAnimationEngine(animation_service_->engine());
 
   visibility_service_->SetSnapService(snap_service_.get());
+
+  hotkey_service_->SetVisibilityService(visibility_service_.get());
+
+  host_service_->SetSnapService(snap_service_.get());
+
+  binary_channel_ = std::make_unique<BinaryChannel>(
+      registrar_ ? registrar_->messenger() : nullptr, frame_service_.get(),
+      animation_service_->engine());
+  // Events queued on the method channel go out ahead of binary ones.
+  binary_channel_->SetBeforeSend([this] { event_queue_->Flush(); });
+  drag_coordinator_->SetBinaryChannel(binary_channel_.get());
+  snap_service_->SetBinaryChannel(binary_channel_.get());
+
+  WindowChannelRouter::SetServices({event_sink, snap_service_.get(),
+                                    drag_coordinator_.get(),
+                                    background_capture_service_.get()});
 }
 
 void FloatingPalettePlugin::HandleMethodCall(
     const flutter::MethodCall<flutter::EncodableValue>& method_call,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  if (method_call.method_name() != "command") {
+  const bool is_batch = method_call.method_name() == "batch";
+  if (!is_batch && method_call.method_name() != "command") {
     result->NotImplemented();
     return;
   }
@@ -140,6 +217,11 @@ void FloatingPalettePlugin::HandleMethodCall(
     return;
   }
 
+  if (is_batch) {
+    HandleBatch(*args, std::move(result));
+    return;
+  }
+
   // Extract service name
   auto service_it = args->find(flutter::EncodableValue("service"));
   if (service_it == args->end() ||
@@ -166,66 +248,164 @@ void FloatingPalettePlugin::HandleMethodCall(
     window_id = &std::get<std::string>(window_id_it->second);
   }
 
-  // Extract params (default to empty map)
-  flutter::EncodableMap params;
+  // Extract params (default to empty map). Bound by reference into the
+  // call's arguments: large payloads (message/send, applyAppearance) are
+  // never copied on the way to a service.
   auto params_it = args->find(flutter::EncodableValue("params"));
-  if (params_it != args->end() &&
-      std::holds_alternative<flutter::EncodableMap>(params_it->second)) {
-    params = std::get<flutter::EncodableMap>(params_it->second);
+  const auto* params =
+      params_it != args->end()
+          ? std::get_if<flutter::EncodableMap>(&params_it->second)
+          : nullptr;
+
+  Dispatch(service, command, window_id, params ? *params : EmptyParams(),
+           std::move(result));
+}
+
+void FloatingPalettePlugin::HandleBatch(
+    const flutter::EncodableMap& args,
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  auto commands_it = args.find(flutter::EncodableValue("commands"));
+  const auto* commands =
+      commands_it != args.end()
+          ? std::get_if<flutter::EncodableList>(&commands_it->second)
+          : nullptr;
+  if (!commands) {
+    result->Error("INVALID_PARAMS", "batch requires a commands list");
+    return;
   }
+  if (commands->empty()) {
+    result->Success(flutter::EncodableValue(flutter::EncodableList{}));
+    return;
+  }
+
+  // Commands run in order in this turn. Each gets its own result slot, so a
+  // failing command reports its error without affecting the others.
+  auto collector =
+      std::make_shared<BatchCollector>(commands->size(), std::move(result));
+  for (size_t i = 0; i < commands->size(); ++i) {
+    auto slot = BatchCollector::Slot(collector, i);
+
+    const auto* entry = std::get_if<flutter::EncodableMap>(&(*commands)[i]);
+    const std::string* service =
+        entry ? GetStringField(*entry, "service") : nullptr;
+    const std::string* command =
+        entry ? GetStringField(*entry, "command") : nullptr;
+    if (!service || !command) {
+      slot->Error("INVALID_PARAMS",
+                  "Batch entry " + std::to_string(i) +
+                      " requires service and command");
+      continue;
+    }
+
+    const std::string* window_id = GetStringField(*entry, "windowId");
+    auto params_it = entry->find(flutter::EncodableValue("params"));
+    const auto* params =
+        params_it != entry->end()
+            ? std::get_if<flutter::EncodableMap>(&params_it->second)
+            : nullptr;
+
+    Dispatch(*service, *command, window_id,
+             params ? *params : EmptyParams(), std::move(slot));
+  }
+}
 
-  // Route to appropriate service
-  if (service == "window") {
-    window_service_->Handle(command, window_id, params, std::move(result));
-  } else if (service == "visibility") {
-    visibility_service_->Handle(command, window_id, params, std::move(result));
-  } else if (service == "frame") {
-    frame_service_->Handle(command, window_id, params, std::move(result));
-  } else if (service == "transform") {
-    transform_service_->Handle(command, window_id, params, std::move(result));
-  } else if (service == "animation") {
-    animation_service_->Handle(command, window_id, params, std::move(result));
-  } else if (service == "input") {
-    input_service_->Handle(command, window_id, params, std::move(result));
-  } else if (service == "focus") {
-    focus_service_->Handle(command, window_id, params, std::move(result));
-  } else if (service == "zorder") {
-    zorder_service_->Handle(command, window_id, params, std::move(result));
-  } else if (service == "appearance") {
-    appearance_service_->Handle(command, window_id, params, std::move(result));
-  } else if (service == "screen") {
-    screen_service_->Handle(command, window_id, params, std::move(result));
-  } else if (service == "backgroundCapture") {
-    background_capture_service_->Handle(command, window_id, params,
-                                        std::move(result));
-  } else if (service == "message") {
-    message_service_->Handle(command, window_id, params, std::move(result));
-  } else if (service == "host") {
-    host_service_->Handle(command, window_id, params, std::move(result));
-  } else if (service == "snap") {
-    snap_service_->Handle(command, window_id, params, std::move(result));
-  } else {
+void FloatingPalettePlugin::Dispatch(
+    const std::string& service,
+    const std::string& command,
+    const std::string* window_id,
+    const flutter::EncodableMap& params,
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  // Handler time only: a command that answers later (deferred result) is
+  // measured up to its return, a modal drag loop for as long as it runs.
+  const uint64_t service_hash = HashCommand(service);
+  const double start = MonotonicSeconds();
+  trace::CommandActivity activity(service, command);
+
+  // Route to appropriate service. A case checks the name as well as the
+  // hash, so a name that merely collides with a known one is unknown.
+  bool routed = false;
+  switch (service_hash) {
+    case HashCommand("window"):
+      if (service != "window") break;
+      routed = window_service_->Handle(command, window_id, params, std::move(result));
+      break;
+    case HashCommand("visibility"):
+      if (service != "visibility") break;
+      routed = visibility_service_->Handle(command, window_id, params, std::move(result));
+      break;
+    case HashCommand("frame"):
+      if (service != "frame") break;
+      routed = frame_service_->Handle(command, window_id, params, std::move(result));
+      break;
+    case HashCommand("transform"):
+      if (service != "transform") break;
+      routed = transform_service_->Handle(command, window_id, params, std::move(result));
+      break;
+    case HashCommand("animation"):
+      if (service != "animation") break;
+      routed = animation_service_->Handle(command, window_id, params, std::move(result));
+      break;
+    case HashCommand("input"):
+      if (service != "input") break;
+      routed = input_service_->Handle(command, window_id, params, std::move(result));
+      break;
+    case HashCommand("focus"):
+      if (service != "focus") break;
+      routed = focus_service_->Handle(command, window_id, params, std::move(result));
+      break;
+    case HashCommand("zorder"):
+      if (service != "zorder") break;
+      routed = zorder_service_->Handle(command, window_id, params, std::move(result));
+      break;
+    case HashCommand("appearance"):
+      if (service != "appearance") break;
+      routed = appearance_service_->Handle(command, window_id, params, std::move(result));
+      break;
+    case HashCommand("screen"):
+      if (service != "screen") break;
+      routed = screen_service_->Handle(command, window_id, params, std::move(result));
+      break;
+    case HashCommand("backgroundCapture"):
+      if (service != "backgroundCapture") break;
+      routed = background_capture_service_->Handle(command, window_id, params, std::move(result));
+      break;
+    case HashCommand("message"):
+      if (service != "message") break;
+      routed = message_service_->Handle(command, window_id, params, std::move(result));
+      break;
+    case HashCommand("host"):
+      if (service != "host") break;
+      routed = host_service_->Handle(command, window_id, params, std::move(result));
+      break;
+    case HashCommand("snap"):
+      if (service != "snap") break;
+      routed = snap_service_->Handle(command, window_id, params, std::move(result));
+      break;
+    case HashCommand("hotkey"):
+      if (service != "hotkey") break;
+      routed = hotkey_service_->Handle(command, window_id, params, std::move(result));
+      break;
+  }
+  // Still holding the result: no service took it.
+  const bool known_service = !result;
+  if (!known_service) {
     result->Error("UNKNOWN_SERVICE", "Unknown service: " + service);
   }
+  Metrics::Instance().RecordCommand(known_service ? service_hash : 0,
+                                    MonotonicSeconds() - start);
+  // Only names a service recognized: callers choose these strings, and an
+  // unknown one mustn't add a stats entry.
+  if (routed) command_stats_->Record(service, command);
 }
 
 void FloatingPalettePlugin::SendEvent(const std::string& service,
                                       const std::string& event,
                                       const std::string* window_id,
                                       const flutter::EncodableMap& data) {
-  flutter::EncodableMap args;
-  args[flutter::EncodableValue("service")] = flutter::EncodableValue(service);
-  args[flutter::EncodableValue("event")] = flutter::EncodableValue(event);
-  if (window_id) {
-    args[flutter::EncodableValue("windowId")] =
-        flutter::EncodableValue(*window_id);
-  } else {
-    args[flutter::EncodableValue("windowId")] = flutter::EncodableValue();
-  }
-  args[flutter::EncodableValue("data")] = flutter::EncodableValue(data);
-
-  channel_->InvokeMethod("event",
-                         std::make_unique<flutter::EncodableValue>(args));
+  // High-rate emitters already asked before building `data`; this catches
+  // everything else.
+  if (!EventFilter::Instance().Wants(service, event, window_id)) return;
+  event_queue_->Push(service, event, window_id, data);
 }
 
 }  // namespace floating_palette
@@ -11,10 +11,14 @@ namespace floating_palette {
 class AnimationService;
 class AppearanceService;
 class BackgroundCaptureService;
+class BinaryChannel;
+class CommandStats;
 class DragCoordinator;
+class EventQueue;
 class FocusService;
 class FrameService;
 class HostService;
+class HotkeyService;
 class InputService;
 class MessageService;
 class ScreenService;
@@ -31,19 +35,24 @@ class ZOrderService;
 /// - Native executes (stateless service primitives)
 ///
 /// Commands come in via method channel, get routed to services.
-/// Events go back via method channel.
-class FloatingPalettePlugin {
+/// Events go back via method channel, coalesced into one `events` list per
+/// message-loop turn. Frame set/get, animation start/stop and drag updates
+/// for bound windows also have a fixed-layout binary channel; see
+/// BinaryChannel.
+class FloatingPalettePlugin : public flutter::Plugin {
  public:
   static void RegisterWithRegistrar(
       flutter::PluginRegistrarWindows* registrar);
 
   FloatingPalettePlugin(flutter::PluginRegistrarWindows* registrar,
                         std::unique_ptr<flutter::MethodChannel<flutter::EncodableValue>> channel);
-  ~FloatingPalettePlugin();
+  ~FloatingPalettePlugin() override;
 
  private:
   flutter::PluginRegistrarWindows* registrar_;
   std::unique_ptr<flutter::MethodChannel<flutter::EncodableValue>> channel_;
+  std::unique_ptr<CommandStats> command_stats_;
+  std::unique_ptr<EventQueue> event_queue_;
 
   // Services
   std::unique_ptr<WindowService> window_service_;
@@ -60,12 +69,28 @@ class FloatingPalettePlugin {
   std::unique_ptr<MessageService> message_service_;
   std::unique_ptr<HostService> host_service_;
   std::unique_ptr<SnapService> snap_service_;
+  std::unique_ptr<HotkeyService> hotkey_service_;
   std::unique_ptr<DragCoordinator> drag_coordinator_;
+  // Last: unregisters before the services it calls into go away.
+  std::unique_ptr<BinaryChannel> binary_channel_;
 
   void InitializeServices();
   void HandleMethodCall(
       const flutter::MethodCall<flutter::EncodableValue>& method_call,
       std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+  /// Run an ordered list of commands in one channel hop. Answers with one
+  /// {ok, value} or {ok, code, message} entry per command.
+  void HandleBatch(
+      const flutter::EncodableMap& args,
+      std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+  /// Route one command to its service. `params` is borrowed from the
+  /// incoming call and must outlive synchronous handling only.
+  void Dispatch(
+      const std::string& service,
+      const std::string& command,
+      const std::string* window_id,
+      const flutter::EncodableMap& params,
+      std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
   void SendEvent(const std::string& service,
                  const std::string& event,
                  const std::string* window_id,
@@ -1,34 +1,138 @@
 #include "animation_service.h"
 
+#include <variant>
+
+#include "../core/clock.h"
+#include "../core/command_hash.h"
 #include "../core/logger.h"
+#include "../core/param_utils.h"
 
 namespace floating_palette {
 
-void AnimationService::Handle(
+namespace {
+
+constexpr int64_t kDefaultDurationMs = 300;
+
+std::optional<AnimatedProperty> GetProperty(const flutter::EncodableMap& params) {
+  const std::string* name = GetString(params, "property");
+  return name ? ParseAnimatedProperty(*name) : std::nullopt;
+}
+
+const flutter::EncodableList* GetList(const flutter::EncodableMap& params,
+                                      const char* key) {
+  const auto* value = FindParam(params, key);
+  return value ? std::get_if<flutter::EncodableList>(value) : nullptr;
+}
+
+// Specs for an `animations` list ({property, from, to}); entries with an
+// unknown property or no target are skipped.
+std::vector<AnimationEngine::Spec> ParseSpecs(
+    const flutter::EncodableList& animations, double duration,
+    AnimationCurve curve) {
+  std::vector<AnimationEngine::Spec> specs;
+  specs.reserve(animations.size());
+  for (const auto& entry : animations) {
+    const auto* animation = std::get_if<flutter::EncodableMap>(&entry);
+    if (!animation) continue;
+    auto property = GetProperty(*animation);
+    auto to = GetDouble(*animation, "to");
+    if (!property || !to) continue;
+
+    AnimationEngine::Spec spec;
+    spec.property = *property;
+    spec.from = GetDouble(*animation, "from");
+    spec.to = *to;
+    spec.duration = duration;
+    spec.curve = curve;
+    specs.push_back(spec);
+  }
+  return specs;
+}
+
+}  // namespace
+
+AnimationService::AnimationService()
+    : engine_(std::make_unique<AnimationEngine>(
+          [this](const std::string& window_id, AnimatedProperty property) {
+            EmitComplete(window_id, AnimatedPropertyName(property));
+          })) {}
+
+bool AnimationService::Handle(
     const std::string& command,
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  if (command == "animate") {
-    Animate(window_id, params, std::move(result));
-  } else if (command == "animateMultiple") {
-    AnimateMultiple(window_id, params, std::move(result));
-  } else if (command == "stop") {
-    Stop(window_id, std::move(result));
-  } else if (command == "stopAll") {
-    StopAll(std::move(result));
-  } else if (command == "isAnimating") {
-    IsAnimating(window_id, std::move(result));
-  } else {
-    result->Error("UNKNOWN_COMMAND", "Unknown animation command: " + command);
+  switch (HashCommand(command)) {
+    case HashCommand("animate"):
+      if (command != "animate") break;
+      Animate(window_id, params, std::move(result));
+      return true;
+    case HashCommand("animateMultiple"):
+      if (command != "animateMultiple") break;
+      AnimateMultiple(window_id, params, std::move(result));
+      return true;
+    case HashCommand("animateGroup"):
+      if (command != "animateGroup") break;
+      AnimateGroup(params, std::move(result));
+      return true;
+    case HashCommand("stop"):
+      if (command != "stop") break;
+      Stop(window_id, params, std::move(result));
+      return true;
+    case HashCommand("stopAll"):
+      if (command != "stopAll") break;
+      StopAll(window_id, std::move(result));
+      return true;
+    case HashCommand("isAnimating"):
+      if (command != "isAnimating") break;
+      IsAnimating(window_id, params, std::move(result));
+      return true;
+    case HashCommand("getStats"):
+      if (command != "getStats") break;
+      GetStats(std::move(result));
+      return true;
   }
+  result->Error("UNKNOWN_COMMAND", "Unknown animation command: " + command);
+  return false;
 }
 
 void AnimationService::Animate(
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  FP_LOG("Animation", "animate stub");
+  if (!window_id || !WindowStore::Instance().Exists(*window_id)) {
+    result->Error("NOT_FOUND", "Window not found");
+    return;
+  }
+  const std::string* name = GetString(params, "property");
+  auto to = GetDouble(params, "to");
+  if (!name || !to) {
+    result->Error("INVALID_PARAMS", "property required");
+    return;
+  }
+
+  auto property = ParseAnimatedProperty(*name);
+  if (!property) {
+    // Not animatable on Windows (e.g. scale); complete immediately so
+    // awaiting callers don't hang, matching macOS for unknown properties.
+    result->Success(flutter::EncodableValue());
+    EmitComplete(*window_id, *name);
+    return;
+  }
+
+  AnimationEngine::Spec spec;
+  spec.property = *property;
+  spec.from = GetDouble(params, "from");
+  spec.to = *to;
+  spec.duration =
+      GetInt(params, "durationMs").value_or(kDefaultDurationMs) / 1000.0;
+  const std::string* curve = GetString(params, "curve");
+  spec.curve = ParseAnimationCurve(curve ? *curve : "");
+  spec.repeat = static_cast<int>(
+      GetInt(params, "repeatCount").value_or(GetInt(params, "repeat").value_or(1)));
+  spec.auto_reverse = GetBool(params, "autoReverse").value_or(false);
+
+  engine_->Start(*window_id, {spec});
   result->Success(flutter::EncodableValue());
 }
 
@@ -36,27 +140,105 @@ void AnimationService::AnimateMultiple(
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  FP_LOG("Animation", "animateMultiple stub");
+  if (!window_id || !WindowStore::Instance().Exists(*window_id)) {
+    result->Error("NOT_FOUND", "Window not found");
+    return;
+  }
+  const auto* animations = GetList(params, "animations");
+  if (!animations) {
+    result->Error("INVALID_PARAMS", "animations array required");
+    return;
+  }
+
+  double duration =
+      GetInt(params, "durationMs").value_or(kDefaultDurationMs) / 1000.0;
+  const std::string* curve = GetString(params, "curve");
+
+  // All specs share one start time, so the properties move in lockstep.
+  auto specs =
+      ParseSpecs(*animations, duration, ParseAnimationCurve(curve ? *curve : ""));
+  engine_->Start(*window_id, specs);
+  result->Success(flutter::EncodableValue());
+}
+
+void AnimationService::AnimateGroup(
+    const flutter::EncodableMap& params,
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  const auto* windows = GetList(params, "windows");
+  if (!windows) {
+    result->Error("INVALID_PARAMS", "windows array required");
+    return;
+  }
+
+  double duration =
+      GetInt(params, "durationMs").value_or(kDefaultDurationMs) / 1000.0;
+  const std::string* curve_name = GetString(params, "curve");
+  AnimationCurve curve = ParseAnimationCurve(curve_name ? *curve_name : "");
+
+  // One start time for the whole fan-out: every window samples the same
+  // progress on each tick and lands in the same DeferWindowPos batch.
+  double start_time = MonotonicSeconds();
+  for (const auto& entry : *windows) {
+    const auto* group = std::get_if<flutter::EncodableMap>(&entry);
+    if (!group) continue;
+    const std::string* id = GetString(*group, "windowId");
+    const auto* animations = GetList(*group, "animations");
+    if (!id || !animations) continue;
+    // Missing windows are skipped; the rest of the group still runs.
+    engine_->Start(*id, ParseSpecs(*animations, duration, curve), start_time);
+  }
   result->Success(flutter::EncodableValue());
 }
 
 void AnimationService::Stop(
     const std::string* window_id,
+    const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  FP_LOG("Animation", "stop stub");
+  // No property stops everything on the window; an unknown one is a no-op.
+  auto property = GetProperty(params);
+  if (window_id && (property || !GetString(params, "property"))) {
+    engine_->Stop(*window_id, property);
+  }
   result->Success(flutter::EncodableValue());
 }
 
 void AnimationService::StopAll(
+    const std::string* window_id,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  FP_LOG("Animation", "stopAll stub");
+  engine_->StopAll(window_id);
   result->Success(flutter::EncodableValue());
 }
 
 void AnimationService::IsAnimating(
     const std::string* window_id,
+    const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  result->Success(flutter::EncodableValue(false));
+  auto property = GetProperty(params);
+  bool animating = window_id &&
+                   (property || !GetString(params, "property")) &&
+                   engine_->IsAnimating(*window_id, property);
+  result->Success(flutter::EncodableValue(animating));
+}
+
+void AnimationService::GetStats(
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  result->Success(flutter::EncodableValue(flutter::EncodableMap{
+      {flutter::EncodableValue("frames"),
+       flutter::EncodableValue(static_cast<int64_t>(engine_->frame_count()))},
+      {flutter::EncodableValue("batchedWindows"),
+       flutter::EncodableValue(
+           static_cast<int64_t>(engine_->batched_window_count()))},
+  }));
+}
+
+void AnimationService::EmitComplete(const std::string& window_id,
+                                    const std::string& property) {
+  if (!event_sink_) return;
+  event_sink_("animation", "complete", &window_id,
+              flutter::EncodableMap{
+                  {flutter::EncodableValue("property"),
+                   flutter::EncodableValue(property)},
+              });
 }
 
 }  // namespace floating_palette
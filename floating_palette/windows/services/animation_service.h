@@ -6,20 +6,29 @@
 #include <memory>
 #include <string>
 
+#include "../core/animation_engine.h"
 #include "../core/window_store.h"
 
 namespace floating_palette {
 
+/// Window frame and opacity animations, interpolated natively by
+/// AnimationEngine at the display refresh rate.
 class AnimationService {
  public:
+  AnimationService();
+
   void SetEventSink(EventSink sink) { event_sink_ = std::move(sink); }
-  void Handle(const std::string& command,
+  bool Handle(const std::string& command,
               const std::string* window_id,
               const flutter::EncodableMap& params,
               std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
 
+  /// Shared with FrameService for animated frame changes.
+  AnimationEngine* engine() const { return engine_.get(); }
+
  private:
   EventSink event_sink_;
+  std::unique_ptr<AnimationEngine> engine_;
 
   void Animate(const std::string* window_id,
                const flutter::EncodableMap& params,
@@ -27,11 +36,20 @@ class AnimationService {
   void AnimateMultiple(const std::string* window_id,
                        const flutter::EncodableMap& params,
                        std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+  void AnimateGroup(const flutter::EncodableMap& params,
+                    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
   void Stop(const std::string* window_id,
+            const flutter::EncodableMap& params,
             std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
-  void StopAll(std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+  void StopAll(const std::string* window_id,
+               std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
   void IsAnimating(const std::string* window_id,
+                   const flutter::EncodableMap& params,
                    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+
+  void GetStats(std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+
+  void EmitComplete(const std::string& window_id, const std::string& property);
 };
 
 }  // namespace floating_palette
@@ -1,78 +1,212 @@
 #include "appearance_service.h"
 
+#include "../core/command_hash.h"
 #include "../core/logger.h"
+#include "../core/param_utils.h"
 
 namespace floating_palette {
 
-void AppearanceService::Handle(
+namespace {
+
+// Windows 11 only offers two radii: 4px (small) and 8px.
+DWM_WINDOW_CORNER_PREFERENCE CornerForRadius(double radius) {
+  if (radius <= 0) return DWMWCP_DONOTROUND;
+  if (radius <= 4) return DWMWCP_ROUNDSMALL;
+  return DWMWCP_ROUND;
+}
+
+// DWM has a single shadow; every preset but none turns it on.
+bool ParseShadow(const std::string& name, bool* shadow) {
+  if (name == "none") {
+    *shadow = false;
+    return true;
+  }
+  if (name == "small" || name == "medium" || name == "large") {
+    *shadow = true;
+    return true;
+  }
+  return false;
+}
+
+// The background is Flutter's to paint; DWM only draws the 1px border
+// around rounded panels, which is tinted to match so it does not show.
+// A missing, null or fully transparent color gets the system border.
+COLORREF BorderForBackground(const flutter::EncodableMap& params,
+                             const char* key) {
+  auto argb = GetInt(params, key);
+  if (!argb || ((*argb >> 24) & 0xFF) == 0) return DWMWA_COLOR_DEFAULT;
+  return RGB((*argb >> 16) & 0xFF, (*argb >> 8) & 0xFF, *argb & 0xFF);
+}
+
+// macOS material names (see AppearanceClient.setBlur) mapped to the
+// nearest system backdrop, as GlassBackdrop does for glass materials.
+DWM_SYSTEMBACKDROP_TYPE BackdropForMaterial(const std::string& material) {
+  if (material == "sidebar" || material == "windowBackground" ||
+      material == "underWindowBackground") {
+    return DWMSBT_MAINWINDOW;  // Mica
+  }
+  if (material == "sheet" || material == "titlebar" ||
+      material == "headerView") {
+    return DWMSBT_TABBEDWINDOW;  // Mica Alt
+  }
+  return DWMSBT_TRANSIENTWINDOW;  // Acrylic
+}
+
+}  // namespace
+
+bool AppearanceService::Handle(
     const std::string& command,
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  if (command == "setCornerRadius") {
-    SetCornerRadius(window_id, params, std::move(result));
-  } else if (command == "setShadow") {
-    SetShadow(window_id, params, std::move(result));
-  } else if (command == "setBackgroundColor") {
-    SetBackgroundColor(window_id, params, std::move(result));
-  } else if (command == "setTransparent") {
-    SetTransparent(window_id, params, std::move(result));
-  } else if (command == "setBlur") {
-    SetBlur(window_id, params, std::move(result));
-  } else if (command == "applyAppearance") {
-    ApplyAppearance(window_id, params, std::move(result));
-  } else {
-    result->Error("UNKNOWN_COMMAND",
-                  "Unknown appearance command: " + command);
+  switch (HashCommand(command)) {
+    case HashCommand("setCornerRadius"):
+      if (command != "setCornerRadius") break;
+      SetCornerRadius(window_id, params, std::move(result));
+      return true;
+    case HashCommand("setShadow"):
+      if (command != "setShadow") break;
+      SetShadow(window_id, params, std::move(result));
+      return true;
+    case HashCommand("setBackgroundColor"):
+      if (command != "setBackgroundColor") break;
+      SetBackgroundColor(window_id, params, std::move(result));
+      return true;
+    case HashCommand("setTransparent"):
+      if (command != "setTransparent") break;
+      SetTransparent(window_id, params, std::move(result));
+      return true;
+    case HashCommand("setBlur"):
+      if (command != "setBlur") break;
+      SetBlur(window_id, params, std::move(result));
+      return true;
+    case HashCommand("applyAppearance"):
+      if (command != "applyAppearance") break;
+      ApplyAppearance(window_id, params, std::move(result));
+      return true;
+  }
+  result->Error("UNKNOWN_COMMAND", "Unknown appearance command: " + command);
+  return false;
+}
+
+PaletteWindow* AppearanceService::Find(
+    const std::string* window_id,
+    flutter::MethodResult<flutter::EncodableValue>& result) {
+  auto* window = window_id ? WindowStore::Instance().Get(*window_id) : nullptr;
+  if (!window || !window->hwnd) {
+    result.Error("NOT_FOUND", "Window not found");
+    return nullptr;
   }
+  return window;
+}
+
+void AppearanceService::Commit(
+    PaletteWindow& window,
+    const PanelAppearance& appearance,
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  window.appearance = appearance;
+  window.dwm.Apply(window.hwnd, appearance);
+  result->Success(flutter::EncodableValue());
 }
 
 void AppearanceService::SetCornerRadius(
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  FP_LOG("Appearance", "setCornerRadius stub");
-  result->Success(flutter::EncodableValue());
+  auto* window = Find(window_id, *result);
+  if (!window) return;
+  auto radius = GetDouble(params, "radius");
+  if (!radius) {
+    result->Error("INVALID_PARAMS", "radius required");
+    return;
+  }
+  PanelAppearance appearance = window->appearance;
+  appearance.corner = CornerForRadius(*radius);
+  Commit(*window, appearance, std::move(result));
 }
 
 void AppearanceService::SetShadow(
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  FP_LOG("Appearance", "setShadow stub");
-  result->Success(flutter::EncodableValue());
+  auto* window = Find(window_id, *result);
+  if (!window) return;
+  PanelAppearance appearance = window->appearance;
+  const std::string* shadow = GetString(params, "shadow");
+  if (!shadow || !ParseShadow(*shadow, &appearance.shadow)) {
+    result->Error("INVALID_PARAMS",
+                  "shadow (none|small|medium|large) required");
+    return;
+  }
+  Commit(*window, appearance, std::move(result));
 }
 
 void AppearanceService::SetBackgroundColor(
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  FP_LOG("Appearance", "setBackgroundColor stub");
-  result->Success(flutter::EncodableValue());
+  auto* window = Find(window_id, *result);
+  if (!window) return;
+  PanelAppearance appearance = window->appearance;
+  appearance.border_color = BorderForBackground(params, "color");
+  Commit(*window, appearance, std::move(result));
 }
 
 void AppearanceService::SetTransparent(
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  FP_LOG("Appearance", "setTransparent stub");
-  result->Success(flutter::EncodableValue());
+  auto* window = Find(window_id, *result);
+  if (!window) return;
+  auto transparent = GetBool(params, "transparent");
+  if (!transparent) {
+    result->Error("INVALID_PARAMS", "transparent required");
+    return;
+  }
+  PanelAppearance appearance = window->appearance;
+  appearance.transparent = *transparent;
+  Commit(*window, appearance, std::move(result));
 }
 
 void AppearanceService::SetBlur(
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  FP_LOG("Appearance", "setBlur stub");
-  result->Success(flutter::EncodableValue());
+  auto* window = Find(window_id, *result);
+  if (!window) return;
+  const std::string* material = GetString(params, "material");
+  PanelAppearance appearance = window->appearance;
+  appearance.backdrop =
+      GetBool(params, "enabled").value_or(true)
+          ? BackdropForMaterial(material ? *material : "hudWindow")
+          : DWMSBT_NONE;
+  Commit(*window, appearance, std::move(result));
 }
 
 void AppearanceService::ApplyAppearance(
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  FP_LOG("Appearance", "applyAppearance stub");
-  result->Success(flutter::EncodableValue());
+  auto* window = Find(window_id, *result);
+  if (!window) return;
+  // Palettes call this on every config push and theme switch with mostly
+  // unchanged values; DwmAttributes turns those into no DWM calls at all.
+  PanelAppearance appearance = window->appearance;
+  if (auto radius = GetDouble(params, "cornerRadius")) {
+    appearance.corner = CornerForRadius(*radius);
+  }
+  if (const std::string* shadow = GetString(params, "shadow")) {
+    if (!ParseShadow(*shadow, &appearance.shadow)) {
+      result->Error("INVALID_PARAMS", "shadow must be none|small|medium|large");
+      return;
+    }
+  }
+  if (auto transparent = GetBool(params, "transparent")) {
+    appearance.transparent = *transparent;
+  }
+  // A full config: no backgroundColor means none.
+  appearance.border_color = BorderForBackground(params, "backgroundColor");
+  Commit(*window, appearance, std::move(result));
 }
 
 }  // namespace floating_palette
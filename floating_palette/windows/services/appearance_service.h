@@ -13,7 +13,7 @@ namespace floating_palette {
 class AppearanceService {
  public:
   void SetEventSink(EventSink sink) { event_sink_ = std::move(sink); }
-  void Handle(const std::string& command,
+  bool Handle(const std::string& command,
               const std::string* window_id,
               const flutter::EncodableMap& params,
               std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
@@ -21,6 +21,14 @@ class AppearanceService {
  private:
   EventSink event_sink_;
 
+  /// The window for `window_id`, or nullptr after answering NOT_FOUND.
+  static PaletteWindow* Find(
+      const std::string* window_id,
+      flutter::MethodResult<flutter::EncodableValue>& result);
+  /// Record `appearance` and write whatever DWM attributes it changes.
+  static void Commit(PaletteWindow& window, const PanelAppearance& appearance,
+                     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+
   void SetCornerRadius(const std::string* window_id,
                        const flutter::EncodableMap& params,
                        std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
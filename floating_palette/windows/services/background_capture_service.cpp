@@ -1,6 +1,8 @@
 #include "background_capture_service.h"
 
+#include "../core/command_hash.h"
 #include "../core/logger.h"
+#include "../core/param_utils.h"
 
 namespace floating_palette {
 
@@ -8,25 +10,40 @@ BackgroundCaptureService::BackgroundCaptureService(
     flutter::PluginRegistrarWindows* registrar)
     : registrar_(registrar) {}
 
-void BackgroundCaptureService::Handle(
+bool BackgroundCaptureService::Handle(
     const std::string& command,
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  if (command == "checkPermission") {
-    CheckPermission(std::move(result));
-  } else if (command == "requestPermission") {
-    RequestPermission(std::move(result));
-  } else if (command == "start") {
-    Start(window_id, params, std::move(result));
-  } else if (command == "stop") {
-    Stop(window_id, std::move(result));
-  } else if (command == "getTextureId") {
-    GetTextureId(window_id, std::move(result));
-  } else {
-    result->Error("UNKNOWN_COMMAND",
-                  "Unknown backgroundCapture command: " + command);
+  switch (HashCommand(command)) {
+    case HashCommand("checkPermission"):
+      if (command != "checkPermission") break;
+      CheckPermission(std::move(result));
+      return true;
+    case HashCommand("requestPermission"):
+      if (command != "requestPermission") break;
+      RequestPermission(std::move(result));
+      return true;
+    case HashCommand("start"):
+      if (command != "start") break;
+      Start(window_id, params, std::move(result));
+      return true;
+    case HashCommand("stop"):
+      if (command != "stop") break;
+      Stop(window_id, std::move(result));
+      return true;
+    case HashCommand("getTextureId"):
+      if (command != "getTextureId") break;
+      GetTextureId(window_id, std::move(result));
+      return true;
+    case HashCommand("getStats"):
+      if (command != "getStats") break;
+      GetStats(window_id, std::move(result));
+      return true;
   }
+  result->Error("UNKNOWN_COMMAND",
+                "Unknown backgroundCapture command: " + command);
+  return false;
 }
 
 void BackgroundCaptureService::CheckPermission(
@@ -45,22 +62,189 @@ void BackgroundCaptureService::Start(
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  FP_LOG("Capture", "start stub");
-  result->Success(flutter::EncodableValue());
+  if (!window_id) {
+    result->Error("MISSING_ID", "Palette ID required");
+    return;
+  }
+  PaletteWindow* window = WindowStore::Instance().Get(*window_id);
+  if (!window || !window->hwnd) {
+    result->Error("NOT_FOUND", "Palette " + *window_id + " not found");
+    return;
+  }
+  if (sessions_.count(*window_id)) {
+    result->Error("ALREADY_CAPTURING",
+                  "Capture already active for " + *window_id);
+    return;
+  }
+
+  // Register on the palette's own engine so its Texture widget can see it.
+  flutter::PluginRegistrarWindows* owner =
+      window->registrar ? window->registrar : registrar_;
+  flutter::TextureRegistrar* textures =
+      owner ? owner->texture_registrar() : nullptr;
+  if (!textures) {
+    result->Error("NO_REGISTRY", "Texture registry not available");
+    return;
+  }
+
+  DesktopCaptureConfig config;
+  config.frame_rate =
+      static_cast<int>(GetInt(params, "frameRate").value_or(30));
+  config.pixel_ratio = GetDouble(params, "pixelRatio").value_or(1.0);
+  config.exclude_self = GetBool(params, "excludeSelf").value_or(true);
+  config.padding_top = GetDouble(params, "paddingTop").value_or(0);
+  config.padding_right = GetDouble(params, "paddingRight").value_or(0);
+  config.padding_bottom = GetDouble(params, "paddingBottom").value_or(0);
+  config.padding_left = GetDouble(params, "paddingLeft").value_or(0);
+  config.drag_frame_rate =
+      static_cast<int>(GetInt(params, "dragFrameRate").value_or(60));
+  config.adaptive_frame_rate =
+      GetBool(params, "adaptiveFrameRate").value_or(true);
+  const std::string* output = GetString(params, "output");
+  if (output && *output == "blurred") config.output = CaptureOutput::kBlurred;
+  config.downsample =
+      static_cast<int>(GetInt(params, "downsample").value_or(4));
+  config.blur_passes =
+      static_cast<int>(GetInt(params, "blurPasses").value_or(4));
+  if (const auto* region_value = FindParam(params, "region")) {
+    if (const auto* region =
+            std::get_if<flutter::EncodableMap>(region_value)) {
+      config.has_region = true;
+      config.region_x = GetDouble(*region, "x").value_or(0);
+      config.region_y = GetDouble(*region, "y").value_or(0);
+      config.region_width = GetDouble(*region, "width").value_or(0);
+      config.region_height = GetDouble(*region, "height").value_or(0);
+    }
+  }
+
+  auto session = std::make_shared<CaptureSession>();
+  session->textures = textures;
+  std::weak_ptr<CaptureSession> weak = session;
+  std::string error;
+  session->capture = DesktopCapture::Start(
+      window->hwnd, config,
+      [weak] {
+        auto session = weak.lock();
+        if (!session) return;
+        int64_t id = session->texture_id.load(std::memory_order_acquire);
+        if (id >= 0) session->textures->MarkTextureFrameAvailable(id);
+      },
+      &error);
+  if (!session->capture) {
+    result->Error("START_FAILED", error);
+    return;
+  }
+
+  std::shared_ptr<DesktopCapture> capture = session->capture;
+  session->texture =
+      std::make_unique<flutter::TextureVariant>(flutter::GpuSurfaceTexture(
+          kFlutterDesktopGpuSurfaceTypeDxgiSharedHandle,
+          [capture](size_t width, size_t height) {
+            return capture->ObtainDescriptor(width, height);
+          }));
+  int64_t texture_id = textures->RegisterTexture(session->texture.get());
+  if (texture_id < 0) {
+    capture->Stop();
+    result->Error("START_FAILED", "Texture registration failed");
+    return;
+  }
+  session->texture_id.store(texture_id, std::memory_order_release);
+  sessions_[*window_id] = std::move(session);
+
+  if (event_sink_) {
+    event_sink_("backgroundCapture", "started", window_id,
+                flutter::EncodableMap{
+                    {flutter::EncodableValue("textureId"),
+                     flutter::EncodableValue(texture_id)},
+                });
+  }
+  result->Success(flutter::EncodableValue(texture_id));
 }
 
 void BackgroundCaptureService::Stop(
     const std::string* window_id,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  FP_LOG("Capture", "stop stub");
+  if (!window_id) {
+    result->Error("MISSING_ID", "Palette ID required");
+    return;
+  }
+  auto it = sessions_.find(*window_id);
+  if (it == sessions_.end()) {
+    result->Error("NOT_CAPTURING", "No active capture for " + *window_id);
+    return;
+  }
+  StopSession(std::move(it->second));
+  sessions_.erase(it);
+  if (event_sink_) {
+    event_sink_("backgroundCapture", "stopped", window_id,
+                flutter::EncodableMap{});
+  }
   result->Success(flutter::EncodableValue());
 }
 
 void BackgroundCaptureService::GetTextureId(
     const std::string* window_id,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  // TODO: Return texture ID from Flutter texture registry
-  result->Success(flutter::EncodableValue(-1));
+  if (!window_id) {
+    result->Error("MISSING_ID", "Palette ID required");
+    return;
+  }
+  auto it = sessions_.find(*window_id);
+  if (it == sessions_.end()) {
+    result->Success(flutter::EncodableValue());
+    return;
+  }
+  result->Success(flutter::EncodableValue(
+      it->second->texture_id.load(std::memory_order_acquire)));
+}
+
+void BackgroundCaptureService::GetStats(
+    const std::string* window_id,
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  if (!window_id) {
+    result->Error("MISSING_ID", "Palette ID required");
+    return;
+  }
+  auto it = sessions_.find(*window_id);
+  if (it == sessions_.end()) {
+    result->Success(flutter::EncodableValue());
+    return;
+  }
+  const DesktopCaptureStats& stats = it->second->capture->Stats();
+  auto count = [](const std::atomic<uint64_t>& value) {
+    return flutter::EncodableValue(
+        static_cast<int64_t>(value.load(std::memory_order_relaxed)));
+  };
+  result->Success(flutter::EncodableValue(flutter::EncodableMap{
+      {flutter::EncodableValue("framesArrived"), count(stats.frames_arrived)},
+      {flutter::EncodableValue("framesCopied"), count(stats.frames_copied)},
+      {flutter::EncodableValue("framesThrottled"),
+       count(stats.frames_throttled)},
+      {flutter::EncodableValue("framesStatic"), count(stats.frames_static)},
+      {flutter::EncodableValue("framesDropped"), count(stats.frames_dropped)},
+      {flutter::EncodableValue("framesPresented"),
+       count(stats.frames_presented)},
+      {flutter::EncodableValue("framesLate"), count(stats.frames_late)},
+  }));
+}
+
+void BackgroundCaptureService::Cleanup(const std::string& window_id) {
+  auto it = sessions_.find(window_id);
+  if (it == sessions_.end()) return;
+  StopSession(std::move(it->second));
+  sessions_.erase(it);
+}
+
+void BackgroundCaptureService::StopSession(
+    std::shared_ptr<CaptureSession> session) {
+  // No frame callbacks after this returns.
+  session->capture->Stop();
+  int64_t id = session->texture_id.exchange(-1, std::memory_order_acq_rel);
+  if (id < 0) return;
+  // The raster thread may still be sampling; the session (texture variant
+  // and shared texture) lives until Flutter confirms the unregister.
+  session->textures->UnregisterTexture(id, [session] {});
+  FP_LOG("Capture", "stopped texture ", id);
 }
 
 }  // namespace floating_palette
@@ -4,9 +4,12 @@
 #include <flutter/plugin_registrar_windows.h>
 #include <flutter/standard_method_codec.h>
 
+#include <atomic>
+#include <map>
 #include <memory>
 #include <string>
 
+#include "../core/desktop_capture.h"
 #include "../core/window_store.h"
 
 namespace floating_palette {
@@ -16,14 +19,31 @@ class BackgroundCaptureService {
   explicit BackgroundCaptureService(flutter::PluginRegistrarWindows* registrar);
 
   void SetEventSink(EventSink sink) { event_sink_ = std::move(sink); }
-  void Handle(const std::string& command,
+  bool Handle(const std::string& command,
               const std::string* window_id,
               const flutter::EncodableMap& params,
               std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
 
+  /// Stop any capture for a window that is being destroyed (before its
+  /// engine goes away).
+  void Cleanup(const std::string& window_id);
+
  private:
+  /// One palette's capture and the Flutter texture it feeds.
+  struct CaptureSession {
+    std::shared_ptr<DesktopCapture> capture;
+    std::unique_ptr<flutter::TextureVariant> texture;
+    flutter::TextureRegistrar* textures = nullptr;
+    /// -1 until registered; read on the capture thread.
+    std::atomic<int64_t> texture_id{-1};
+  };
+
   flutter::PluginRegistrarWindows* registrar_;
   EventSink event_sink_;
+  /// Platform thread only.
+  std::map<std::string, std::shared_ptr<CaptureSession>> sessions_;
+
+  void StopSession(std::shared_ptr<CaptureSession> session);
 
   void CheckPermission(std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
   void RequestPermission(std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
@@ -34,6 +54,8 @@ class BackgroundCaptureService {
             std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
   void GetTextureId(const std::string* window_id,
                     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+  void GetStats(const std::string* window_id,
+                std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
 };
 
 }  // namespace floating_palette
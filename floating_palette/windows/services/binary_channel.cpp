@@ -0,0 +1,194 @@
+#include "binary_channel.h"
+
+#include <cmath>
+
+#include "../core/animation_curve.h"
+#include "../core/logger.h"
+#include "frame_service.h"
+
+namespace floating_palette {
+
+namespace {
+
+constexpr int32_t kDefaultAnimationMs = 300;
+constexpr int32_t kDefaultFrameMs = 200;
+
+/// Curve from the high byte of request flags; unknown values fall back to
+/// easeInOut, like unknown curve names.
+AnimationCurve CurveFromFlags(uint16_t flags) {
+  const auto value = static_cast<uint8_t>(flags >> kBinaryCurveShift);
+  return value <= static_cast<uint8_t>(AnimationCurve::kEaseIn)
+             ? static_cast<AnimationCurve>(value)
+             : AnimationCurve::kEaseInOut;
+}
+
+bool PropertyFromPayload(float value, AnimatedProperty* out) {
+  // Check the float before casting: converting NaN, an infinity or an
+  // out-of-range value to int is undefined.
+  if (!std::isfinite(value) || value < 0 ||
+      value > static_cast<float>(AnimatedProperty::kOpacity)) {
+    return false;
+  }
+  const int index = static_cast<int>(value);
+  if (index != value) return false;
+  *out = static_cast<AnimatedProperty>(index);
+  return true;
+}
+
+PaletteWindow* BoundWindow(WindowHandle handle) {
+  PaletteWindow* window = WindowStore::Instance().Get(handle);
+  return window && window->binary_bound ? window : nullptr;
+}
+
+}  // namespace
+
+BinaryChannel::BinaryChannel(flutter::BinaryMessenger* messenger,
+                             FrameService* frame_service,
+                             AnimationEngine* animation_engine)
+    : messenger_(messenger),
+      frame_service_(frame_service),
+      animation_engine_(animation_engine) {
+  if (!messenger_) return;
+  messenger_->SetMessageHandler(
+      channel_name_, [this](const uint8_t* message, size_t size,
+                           flutter::BinaryReply reply) {
+        HandleMessage(message, size, reply);
+      });
+}
+
+BinaryChannel::~BinaryChannel() {
+  if (messenger_) messenger_->SetMessageHandler(channel_name_, nullptr);
+}
+
+void BinaryChannel::HandleMessage(const uint8_t* message,
+                                  size_t size,
+                                  const flutter::BinaryReply& reply) {
+  BinaryMessage request;
+  BinaryMessage response;
+  if (!DecodeBinaryMessage(message, size, &request)) {
+    FP_LOG("Plugin", "binary: dropped ", size, "-byte message");
+    response.flags = static_cast<uint16_t>(BinaryStatus::kInvalidParams);
+  } else {
+    response.opcode = request.opcode;
+    response.handle = request.handle;
+    response.flags = static_cast<uint16_t>(Run(request, &response));
+  }
+  if (!reply) return;
+  uint8_t bytes[kBinaryMessageSize];
+  EncodeBinaryMessage(response, bytes);
+  reply(bytes, kBinaryMessageSize);
+}
+
+BinaryStatus BinaryChannel::Run(const BinaryMessage& request,
+                                BinaryMessage* reply) {
+  PaletteWindow* window = WindowStore::Instance().Get(request.handle);
+  if (!window || !window->hwnd) return BinaryStatus::kNotFound;
+  const float* p = request.payload;
+
+  switch (static_cast<BinaryOp>(request.opcode)) {
+    case BinaryOp::kSetPosition:
+    case BinaryOp::kSetSize:
+    case BinaryOp::kSetBounds: {
+      FrameService::FrameAnimation animation;
+      animation.animate = (request.flags & kBinaryFlagAnimate) != 0;
+      animation.duration =
+          (request.arg > 0 ? request.arg : kDefaultFrameMs) / 1000.0;
+      animation.curve = CurveFromFlags(request.flags);
+      bool found = false;
+      switch (static_cast<BinaryOp>(request.opcode)) {
+        case BinaryOp::kSetPosition:
+          found = frame_service_->SetPosition(window, p[0], p[1], animation);
+          break;
+        case BinaryOp::kSetSize:
+          found = frame_service_->SetSize(window, p[0], p[1], animation);
+          break;
+        default:
+          found = frame_service_->SetBounds(window, p[0], p[1], p[2], p[3],
+                                            animation);
+      }
+      return found ? BinaryStatus::kOk : BinaryStatus::kNotFound;
+    }
+
+    case BinaryOp::kGetBounds: {
+      FrameSnapshot frame;
+      if (!window->frame.Load(&frame)) return BinaryStatus::kNotFound;
+      reply->payload[0] = static_cast<float>(frame.x);
+      reply->payload[1] = static_cast<float>(frame.y);
+      reply->payload[2] = static_cast<float>(frame.width);
+      reply->payload[3] = static_cast<float>(frame.height);
+      return BinaryStatus::kOk;
+    }
+
+    case BinaryOp::kAnimate: {
+      AnimationEngine::Spec spec;
+      if (!PropertyFromPayload(p[0], &spec.property)) {
+        return BinaryStatus::kInvalidParams;
+      }
+      spec.to = p[1];
+      if (request.flags & kBinaryFlagHasFrom) spec.from = p[2];
+      spec.duration =
+          (request.arg > 0 ? request.arg : kDefaultAnimationMs) / 1000.0;
+      spec.curve = CurveFromFlags(request.flags);
+      animation_engine_->Start(window->id, {spec});
+      return BinaryStatus::kOk;
+    }
+
+    case BinaryOp::kStopAnimation: {
+      if (request.flags & kBinaryFlagAllProperties) {
+        animation_engine_->Stop(window->id, std::nullopt);
+        return BinaryStatus::kOk;
+      }
+      AnimatedProperty property;
+      if (!PropertyFromPayload(p[0], &property)) {
+        return BinaryStatus::kInvalidParams;
+      }
+      animation_engine_->Stop(window->id, property);
+      return BinaryStatus::kOk;
+    }
+
+    default:
+      return BinaryStatus::kUnknownOpcode;
+  }
+}
+
+bool BinaryChannel::SendDragMoved(WindowHandle handle, double x, double y) {
+  if (!messenger_ || !BoundWindow(handle)) return false;
+  BinaryMessage message;
+  message.opcode = static_cast<uint16_t>(BinaryOp::kDragMoved);
+  message.handle = handle;
+  message.payload[0] = static_cast<float>(x);
+  message.payload[1] = static_cast<float>(y);
+  Send(message);
+  return true;
+}
+
+bool BinaryChannel::SendFollowerDragging(const PaletteWindow* follower,
+                                         const PaletteWindow* target,
+                                         double distance,
+                                         const RECT& frame,
+                                         double scale) {
+  if (!messenger_ || !follower || !target || !follower->binary_bound ||
+      !target->binary_bound) {
+    return false;
+  }
+  BinaryMessage message;
+  message.opcode = static_cast<uint16_t>(BinaryOp::kFollowerDragging);
+  message.handle = follower->handle;
+  message.arg = target->handle;
+  message.payload[0] = static_cast<float>(distance);
+  message.payload[1] = static_cast<float>(frame.left / scale);
+  message.payload[2] = static_cast<float>(frame.top / scale);
+  message.payload[3] = static_cast<float>((frame.right - frame.left) / scale);
+  message.payload[4] = static_cast<float>((frame.bottom - frame.top) / scale);
+  Send(message);
+  return true;
+}
+
+void BinaryChannel::Send(const BinaryMessage& message) {
+  if (before_send_) before_send_();
+  uint8_t bytes[kBinaryMessageSize];
+  EncodeBinaryMessage(message, bytes);
+  messenger_->Send(channel_name_, bytes, kBinaryMessageSize);
+}
+
+}  // namespace floating_palette
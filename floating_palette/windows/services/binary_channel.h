@@ -0,0 +1,80 @@
+#pragma once
+
+#include <windows.h>
+
+#include <flutter/binary_messenger.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "../core/animation_engine.h"
+#include "../core/binary_codec.h"
+#include "../core/window_store.h"
+
+namespace floating_palette {
+
+class FrameService;
+
+/// The `floating_palette/binary` channel: fixed-layout BinaryMessages for
+/// the traffic that dominates a drag or an animated layout, next to the
+/// `floating_palette` method channel that carries everything else.
+///
+/// Requests (frame set/get, animation start/stop) are decoded in place and
+/// run through the same FrameService and AnimationEngine paths as their
+/// commands, and are answered from a stack buffer. Drag moves and
+/// snap-follower updates are sent here instead of as events for windows
+/// Dart has bound (frame/bindBinary); for the rest the callers fall back
+/// to the event sink.
+///
+/// Platform thread only.
+class BinaryChannel {
+ public:
+  static constexpr char kChannelName[] = "floating_palette/binary";
+
+  /// `messenger` may be null (benchmarks): requests can still be fed to
+  /// HandleMessage, and events are never sent.
+  BinaryChannel(flutter::BinaryMessenger* messenger,
+                FrameService* frame_service,
+                AnimationEngine* animation_engine);
+  ~BinaryChannel();
+
+  BinaryChannel(const BinaryChannel&) = delete;
+  BinaryChannel& operator=(const BinaryChannel&) = delete;
+
+  /// Runs before every event sent here, so events already queued on the
+  /// method channel reach Dart first.
+  void SetBeforeSend(std::function<void()> callback) {
+    before_send_ = std::move(callback);
+  }
+
+  void HandleMessage(const uint8_t* message,
+                     size_t size,
+                     const flutter::BinaryReply& reply);
+
+  /// Send a drag move (logical top-left). False if `handle` isn't bound,
+  /// so the caller emits frame/moved instead.
+  bool SendDragMoved(WindowHandle handle, double x, double y);
+  /// Send snap/followerDragging (frame in physical px). False unless both
+  /// windows are bound.
+  bool SendFollowerDragging(const PaletteWindow* follower,
+                            const PaletteWindow* target,
+                            double distance,
+                            const RECT& frame,
+                            double scale);
+
+ private:
+  BinaryStatus Run(const BinaryMessage& request, BinaryMessage* reply);
+  void Send(const BinaryMessage& message);
+
+  flutter::BinaryMessenger* messenger_;
+  /// Built once: the messenger takes a std::string, and the name is past
+  /// the small-string limit.
+  const std::string channel_name_{kChannelName};
+  FrameService* frame_service_;
+  AnimationEngine* animation_engine_;
+  std::function<void()> before_send_;
+};
+
+}  // namespace floating_palette
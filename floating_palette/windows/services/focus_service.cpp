@@ -1,29 +1,43 @@
 #include "focus_service.h"
 
+#include "../core/command_hash.h"
 #include "../core/logger.h"
 
 namespace floating_palette {
 
-void FocusService::Handle(
+bool FocusService::Handle(
     const std::string& command,
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  if (command == "focus") {
-    Focus(window_id, std::move(result));
-  } else if (command == "unfocus") {
-    Unfocus(window_id, std::move(result));
-  } else if (command == "setPolicy") {
-    SetPolicy(window_id, params, std::move(result));
-  } else if (command == "isFocused") {
-    IsFocused(window_id, std::move(result));
-  } else if (command == "focusMainWindow") {
-    FocusMainWindow(std::move(result));
-  } else if (command == "hideApp") {
-    HideApp(std::move(result));
-  } else {
-    result->Error("UNKNOWN_COMMAND", "Unknown focus command: " + command);
+  switch (HashCommand(command)) {
+    case HashCommand("focus"):
+      if (command != "focus") break;
+      Focus(window_id, std::move(result));
+      return true;
+    case HashCommand("unfocus"):
+      if (command != "unfocus") break;
+      Unfocus(window_id, std::move(result));
+      return true;
+    case HashCommand("setPolicy"):
+      if (command != "setPolicy") break;
+      SetPolicy(window_id, params, std::move(result));
+      return true;
+    case HashCommand("isFocused"):
+      if (command != "isFocused") break;
+      IsFocused(window_id, std::move(result));
+      return true;
+    case HashCommand("focusMainWindow"):
+      if (command != "focusMainWindow") break;
+      FocusMainWindow(std::move(result));
+      return true;
+    case HashCommand("hideApp"):
+      if (command != "hideApp") break;
+      HideApp(std::move(result));
+      return true;
   }
+  result->Error("UNKNOWN_COMMAND", "Unknown focus command: " + command);
+  return false;
 }
 
 void FocusService::Focus(
@@ -51,7 +65,10 @@ void FocusService::SetPolicy(
 void FocusService::IsFocused(
     const std::string* window_id,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  result->Success(flutter::EncodableValue(false));
+  // Same definition as FloatingPalette_QueryWindow and host/getSnapshot.
+  auto* window = window_id ? WindowStore::Instance().Get(*window_id) : nullptr;
+  result->Success(flutter::EncodableValue(
+      window && window->hwnd && window->hwnd == GetForegroundWindow()));
 }
 
 void FocusService::FocusMainWindow(
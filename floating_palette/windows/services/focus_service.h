@@ -13,7 +13,7 @@ namespace floating_palette {
 class FocusService {
  public:
   void SetEventSink(EventSink sink) { event_sink_ = std::move(sink); }
-  void Handle(const std::string& command,
+  bool Handle(const std::string& command,
               const std::string* window_id,
               const flutter::EncodableMap& params,
               std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
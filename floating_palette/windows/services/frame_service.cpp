@@ -1,40 +1,284 @@
 #include "frame_service.h"
 
+#include <cmath>
+#include <variant>
+
+#include "../coordinators/drag_coordinator.h"
+#include "../core/clock.h"
+#include "../core/command_hash.h"
+#include "../core/event_filter.h"
+#include "../core/frame_batch.h"
 #include "../core/logger.h"
+#include "../core/param_utils.h"
+#include "snap_service.h"
 
 namespace floating_palette {
 
-void FrameService::Handle(
+namespace {
+
+constexpr int64_t kDefaultDurationMs = 200;
+
+constexpr AnimatedProperty kFrameProperties[] = {
+    AnimatedProperty::kX, AnimatedProperty::kY, AnimatedProperty::kWidth,
+    AnimatedProperty::kHeight};
+
+LONG ToPhysical(double logical, double scale) {
+  return static_cast<LONG>(std::lround(logical * scale));
+}
+
+}  // namespace
+
+// static
+bool FrameService::LoadFrame(const std::string* window_id,
+                             FrameSnapshot* out) {
+  if (!window_id) return false;
+  PaletteWindow* window = WindowStore::Instance().Get(*window_id);
+  return window && window->frame.Load(out);
+}
+
+// static
+bool FrameService::LoadTarget(const std::string* window_id,
+                              FrameTarget* out) {
+  if (!window_id) return false;
+  return LoadTarget(WindowStore::Instance().Get(*window_id), out);
+}
+
+// static
+bool FrameService::LoadTarget(PaletteWindow* window, FrameTarget* out) {
+  if (!window || !window->hwnd || !window->frame.Load(&out->before)) {
+    return false;
+  }
+  out->id = window->id;
+  out->window = window;
+  out->frame = out->before.physical;
+  return true;
+}
+
+// static
+bool FrameService::ParseBounds(const flutter::EncodableMap& params,
+                               FrameTarget* target) {
+  auto x = GetDouble(params, "x");
+  auto y = GetDouble(params, "y");
+  auto width = GetDouble(params, "width");
+  auto height = GetDouble(params, "height");
+  if (!x || !y || !width || !height) return false;
+  BoundTarget(target, *x, *y, *width, *height);
+  return true;
+}
+
+// static
+void FrameService::MoveTarget(FrameTarget* target, double x, double y) {
+  const double scale = target->before.dpi / 96.0;
+  const RECT& current = target->before.physical;
+  target->frame.left = ToPhysical(x, scale);
+  target->frame.top = ToPhysical(y, scale);
+  target->frame.right = target->frame.left + (current.right - current.left);
+  target->frame.bottom = target->frame.top + (current.bottom - current.top);
+}
+
+// static
+void FrameService::ResizeTarget(FrameTarget* target, double width,
+                                double height) {
+  const double scale = target->before.dpi / 96.0;
+  target->frame = target->before.physical;
+  target->frame.right = target->frame.left + ToPhysical(width, scale);
+  target->frame.bottom = target->frame.top + ToPhysical(height, scale);
+}
+
+// static
+void FrameService::BoundTarget(FrameTarget* target, double x, double y,
+                               double width, double height) {
+  const double scale = target->before.dpi / 96.0;
+  target->frame.left = ToPhysical(x, scale);
+  target->frame.top = ToPhysical(y, scale);
+  target->frame.right = target->frame.left + ToPhysical(width, scale);
+  target->frame.bottom = target->frame.top + ToPhysical(height, scale);
+}
+
+// static
+FrameService::FrameAnimation FrameService::ParseAnimation(
+    const flutter::EncodableMap& params) {
+  FrameAnimation animation;
+  animation.animate = GetBool(params, "animate").value_or(false);
+  animation.duration =
+      GetInt(params, "durationMs").value_or(kDefaultDurationMs) / 1000.0;
+  const std::string* curve = GetString(params, "curve");
+  animation.curve = ParseAnimationCurve(curve ? *curve : "");
+  return animation;
+}
+
+// static
+flutter::EncodableMap FrameService::BoundsMap(const FrameSnapshot& frame) {
+  return flutter::EncodableMap{
+      {flutter::EncodableValue("x"), flutter::EncodableValue(frame.x)},
+      {flutter::EncodableValue("y"), flutter::EncodableValue(frame.y)},
+      {flutter::EncodableValue("width"), flutter::EncodableValue(frame.width)},
+      {flutter::EncodableValue("height"),
+       flutter::EncodableValue(frame.height)},
+  };
+}
+
+void FrameService::ApplyFrames(std::vector<FrameTarget>& targets,
+                               const FrameAnimation& animation) {
+  if (animation.animate && animation_engine_) {
+    AnimationEngine::Spec spec;
+    spec.duration = animation.duration;
+    spec.curve = animation.curve;
+    // One timeline, so an animated arrangement moves in lockstep (and the
+    // engine batches each tick).
+    const double start_time = MonotonicSeconds();
+    for (const FrameTarget& target : targets) {
+      const RECT& f = target.frame;
+      std::vector<AnimationEngine::Spec> specs(4, spec);
+      specs[0].property = AnimatedProperty::kX;
+      specs[0].to = f.left;
+      specs[1].property = AnimatedProperty::kY;
+      specs[1].to = f.top;
+      specs[2].property = AnimatedProperty::kWidth;
+      specs[2].to = f.right - f.left;
+      specs[3].property = AnimatedProperty::kHeight;
+      specs[3].to = f.bottom - f.top;
+      animation_engine_->Start(target.id, specs, start_time);
+    }
+    return;
+  }
+
+  std::vector<FrameBatch::Change> changes;
+  changes.reserve(targets.size());
+  for (const FrameTarget& target : targets) {
+    // A direct set wins over an in-flight frame animation.
+    if (animation_engine_) {
+      for (AnimatedProperty property : kFrameProperties) {
+        animation_engine_->Stop(target.id, property);
+      }
+    }
+    changes.push_back(FrameBatch::Change{target.window->hwnd, target.frame});
+  }
+  FrameBatch::Apply(changes);
+
+  // The window procedure refreshed each cache during the batch.
+  std::vector<std::string> moved_ids;
+  for (const FrameTarget& target : targets) {
+    FrameSnapshot after;
+    if (!target.window->frame.Load(&after)) continue;
+    const RECT& a = after.physical;
+    const RECT& b = target.before.physical;
+    const bool moved = a.left != b.left || a.top != b.top;
+    const bool resized = a.right - a.left != b.right - b.left ||
+                         a.bottom - a.top != b.bottom - b.top;
+    if (!moved && !resized) continue;
+    moved_ids.push_back(target.id);
+    if (!event_sink_) continue;
+    const auto& filter = EventFilter::Instance();
+    const bool send_moved = moved && filter.Wants("frame", "moved", &target.id);
+    const bool send_resized =
+        resized && filter.Wants("frame", "resized", &target.id);
+    if (!send_moved && !send_resized) continue;
+    flutter::EncodableMap data = BoundsMap(after);
+    data[flutter::EncodableValue("source")] =
+        flutter::EncodableValue("programmatic");
+    if (send_moved) event_sink_("frame", "moved", &target.id, data);
+    if (send_resized) event_sink_("frame", "resized", &target.id, data);
+  }
+  if (snap_service_ && !moved_ids.empty()) {
+    snap_service_->OnWindowsMoved(moved_ids);
+  }
+}
+
+bool FrameService::Handle(
     const std::string& command,
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  if (command == "setPosition") {
-    SetPosition(window_id, params, std::move(result));
-  } else if (command == "setSize") {
-    SetSize(window_id, params, std::move(result));
-  } else if (command == "setBounds") {
-    SetBounds(window_id, params, std::move(result));
-  } else if (command == "getPosition") {
-    GetPosition(window_id, std::move(result));
-  } else if (command == "getSize") {
-    GetSize(window_id, std::move(result));
-  } else if (command == "getBounds") {
-    GetBounds(window_id, std::move(result));
-  } else if (command == "startDrag") {
-    StartDrag(window_id, std::move(result));
-  } else if (command == "setDraggable") {
-    SetDraggable(window_id, params, std::move(result));
-  } else {
-    result->Error("UNKNOWN_COMMAND", "Unknown frame command: " + command);
+  switch (HashCommand(command)) {
+    case HashCommand("setPosition"):
+      if (command != "setPosition") break;
+      SetPosition(window_id, params, std::move(result));
+      return true;
+    case HashCommand("setSize"):
+      if (command != "setSize") break;
+      SetSize(window_id, params, std::move(result));
+      return true;
+    case HashCommand("setBounds"):
+      if (command != "setBounds") break;
+      SetBounds(window_id, params, std::move(result));
+      return true;
+    case HashCommand("getPosition"):
+      if (command != "getPosition") break;
+      GetPosition(window_id, std::move(result));
+      return true;
+    case HashCommand("getSize"):
+      if (command != "getSize") break;
+      GetSize(window_id, std::move(result));
+      return true;
+    case HashCommand("getBounds"):
+      if (command != "getBounds") break;
+      GetBounds(window_id, std::move(result));
+      return true;
+    case HashCommand("setBoundsMany"):
+      if (command != "setBoundsMany") break;
+      SetBoundsMany(params, std::move(result));
+      return true;
+    case HashCommand("getBoundsMany"):
+      if (command != "getBoundsMany") break;
+      GetBoundsMany(params, std::move(result));
+      return true;
+    case HashCommand("startDrag"):
+      if (command != "startDrag") break;
+      StartDrag(window_id, std::move(result));
+      return true;
+    case HashCommand("setDraggable"):
+      if (command != "setDraggable") break;
+      SetDraggable(window_id, params, std::move(result));
+      return true;
+    case HashCommand("bindBinary"):
+      if (command != "bindBinary") break;
+      BindBinary(window_id, std::move(result));
+      return true;
   }
+  result->Error("UNKNOWN_COMMAND", "Unknown frame command: " + command);
+  return false;
 }
 
 void FrameService::SetPosition(
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  FP_LOG("Frame", "setPosition stub");
+  FrameTarget target;
+  if (!LoadTarget(window_id, &target)) {
+    result->Error("NOT_FOUND", "Window not found");
+    return;
+  }
+  auto x = GetDouble(params, "x");
+  auto y = GetDouble(params, "y");
+  if (!x || !y) {
+    result->Error("INVALID_PARAMS", "x and y required");
+    return;
+  }
+
+  // The anchor names the point of the window that lands on (x, y).
+  const std::string* anchor_param = GetString(params, "anchor");
+  const std::string anchor = anchor_param ? *anchor_param : "topLeft";
+  const FrameSnapshot& before = target.before;
+  double left = *x;
+  double top = *y;
+  if (anchor.find("Right") != std::string::npos) {
+    left -= before.width;
+  } else if (anchor.find("Left") == std::string::npos &&
+             (anchor.find("center") != std::string::npos ||
+              anchor.find("Center") != std::string::npos)) {
+    left -= before.width / 2;
+  }
+  if (anchor.rfind("bottom", 0) == 0) {
+    top -= before.height;
+  } else if (anchor.rfind("center", 0) == 0) {
+    top -= before.height / 2;
+  }
+
+  MoveTarget(&target, left, top);
+
+  std::vector<FrameTarget> targets{std::move(target)};
+  ApplyFrames(targets, ParseAnimation(params));
   result->Success(flutter::EncodableValue());
 }
 
@@ -42,7 +286,23 @@ void FrameService::SetSize(
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  FP_LOG("Frame", "setSize stub");
+  FrameTarget target;
+  if (!LoadTarget(window_id, &target)) {
+    result->Error("NOT_FOUND", "Window not found");
+    return;
+  }
+  auto width = GetDouble(params, "width");
+  auto height = GetDouble(params, "height");
+  if (!width || !height) {
+    result->Error("INVALID_PARAMS", "width and height required");
+    return;
+  }
+
+  // Keeps the top-left fixed.
+  ResizeTarget(&target, *width, *height);
+
+  std::vector<FrameTarget> targets{std::move(target)};
+  ApplyFrames(targets, ParseAnimation(params));
   result->Success(flutter::EncodableValue());
 }
 
@@ -50,52 +310,197 @@ void FrameService::SetBounds(
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  FP_LOG("Frame", "setBounds stub");
+  FrameTarget target;
+  if (!LoadTarget(window_id, &target)) {
+    result->Error("NOT_FOUND", "Window not found");
+    return;
+  }
+  if (!ParseBounds(params, &target)) {
+    result->Error("INVALID_PARAMS", "x, y, width, height required");
+    return;
+  }
+
+  std::vector<FrameTarget> targets{std::move(target)};
+  ApplyFrames(targets, ParseAnimation(params));
+  result->Success(flutter::EncodableValue());
+}
+
+void FrameService::SetBoundsMany(
+    const flutter::EncodableMap& params,
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  const auto* value = FindParam(params, "frames");
+  const auto* frames =
+      value ? std::get_if<flutter::EncodableList>(value) : nullptr;
+  if (!frames) {
+    result->Error("INVALID_PARAMS", "frames (list) required");
+    return;
+  }
+
+  // Validate the whole arrangement before touching any window, so a bad
+  // entry never leaves the layout half applied.
+  std::vector<FrameTarget> targets;
+  targets.reserve(frames->size());
+  for (const auto& entry : *frames) {
+    const auto* frame = std::get_if<flutter::EncodableMap>(&entry);
+    const std::string* id = frame ? GetString(*frame, "id") : nullptr;
+    if (!id) {
+      result->Error("INVALID_PARAMS", "Each frame needs an id");
+      return;
+    }
+    FrameTarget target;
+    if (!LoadTarget(id, &target)) {
+      result->Error("NOT_FOUND", "Window not found: " + *id);
+      return;
+    }
+    if (!ParseBounds(*frame, &target)) {
+      result->Error("INVALID_PARAMS",
+                    "x, y, width, height required for " + *id);
+      return;
+    }
+    targets.push_back(std::move(target));
+  }
+
+  ApplyFrames(targets, ParseAnimation(params));
   result->Success(flutter::EncodableValue());
 }
 
 void FrameService::GetPosition(
     const std::string* window_id,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  FrameSnapshot frame;
+  if (!LoadFrame(window_id, &frame)) {
+    result->Error("NOT_FOUND", "Window not found");
+    return;
+  }
   result->Success(flutter::EncodableValue(flutter::EncodableMap{
-      {flutter::EncodableValue("x"), flutter::EncodableValue(0.0)},
-      {flutter::EncodableValue("y"), flutter::EncodableValue(0.0)},
+      {flutter::EncodableValue("x"), flutter::EncodableValue(frame.x)},
+      {flutter::EncodableValue("y"), flutter::EncodableValue(frame.y)},
   }));
 }
 
 void FrameService::GetSize(
     const std::string* window_id,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  FrameSnapshot frame;
+  if (!LoadFrame(window_id, &frame)) {
+    result->Error("NOT_FOUND", "Window not found");
+    return;
+  }
   result->Success(flutter::EncodableValue(flutter::EncodableMap{
-      {flutter::EncodableValue("width"), flutter::EncodableValue(0.0)},
-      {flutter::EncodableValue("height"), flutter::EncodableValue(0.0)},
+      {flutter::EncodableValue("width"), flutter::EncodableValue(frame.width)},
+      {flutter::EncodableValue("height"),
+       flutter::EncodableValue(frame.height)},
   }));
 }
 
 void FrameService::GetBounds(
     const std::string* window_id,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  result->Success(flutter::EncodableValue(flutter::EncodableMap{
-      {flutter::EncodableValue("x"), flutter::EncodableValue(0.0)},
-      {flutter::EncodableValue("y"), flutter::EncodableValue(0.0)},
-      {flutter::EncodableValue("width"), flutter::EncodableValue(0.0)},
-      {flutter::EncodableValue("height"), flutter::EncodableValue(0.0)},
-  }));
+  FrameSnapshot frame;
+  if (!LoadFrame(window_id, &frame)) {
+    result->Error("NOT_FOUND", "Window not found");
+    return;
+  }
+  result->Success(flutter::EncodableValue(BoundsMap(frame)));
+}
+
+void FrameService::GetBoundsMany(
+    const flutter::EncodableMap& params,
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  const auto* value = FindParam(params, "ids");
+  const auto* ids =
+      value ? std::get_if<flutter::EncodableList>(value) : nullptr;
+  if (!ids) {
+    result->Error("INVALID_PARAMS", "ids (list) required");
+    return;
+  }
+  // Keyed by id; windows that don't exist are left out.
+  flutter::EncodableMap frames;
+  for (const auto& entry : *ids) {
+    const auto* id = std::get_if<std::string>(&entry);
+    FrameSnapshot frame;
+    if (!id || !LoadFrame(id, &frame)) continue;
+    frames.emplace(flutter::EncodableValue(*id),
+                   flutter::EncodableValue(BoundsMap(frame)));
+  }
+  result->Success(flutter::EncodableValue(std::move(frames)));
 }
 
 void FrameService::StartDrag(
     const std::string* window_id,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  FP_LOG("Frame", "startDrag stub");
+  PaletteWindow* window =
+      window_id ? WindowStore::Instance().Get(*window_id) : nullptr;
+  if (!window) {
+    result->Error("NOT_FOUND", "Window not found");
+    return;
+  }
+  // Answer first: the drag loop runs until the button is released.
   result->Success(flutter::EncodableValue());
+  if (drag_coordinator_) drag_coordinator_->StartDrag(*window_id, window);
 }
 
 void FrameService::SetDraggable(
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  FP_LOG("Frame", "setDraggable stub");
+  PaletteWindow* window =
+      window_id ? WindowStore::Instance().Get(*window_id) : nullptr;
+  if (!window) {
+    result->Error("NOT_FOUND", "Window not found");
+    return;
+  }
+  std::optional<bool> draggable = GetBool(params, "draggable");
+  if (!draggable) {
+    result->Error("INVALID_ARGS", "draggable (bool) required");
+    return;
+  }
+  window->draggable = *draggable;
   result->Success(flutter::EncodableValue());
 }
 
+void FrameService::BindBinary(
+    const std::string* window_id,
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  PaletteWindow* window =
+      window_id ? WindowStore::Instance().Get(*window_id) : nullptr;
+  if (!window || window->handle == kInvalidWindowHandle) {
+    result->Error("NOT_FOUND", "Window not found");
+    return;
+  }
+  window->binary_bound = true;
+  result->Success(flutter::EncodableValue(window->handle));
+}
+
+bool FrameService::SetPosition(PaletteWindow* window, double x, double y,
+                               const FrameAnimation& animation) {
+  FrameTarget target;
+  if (!LoadTarget(window, &target)) return false;
+  MoveTarget(&target, x, y);
+  std::vector<FrameTarget> targets{std::move(target)};
+  ApplyFrames(targets, animation);
+  return true;
+}
+
+bool FrameService::SetSize(PaletteWindow* window, double width,
+                           double height, const FrameAnimation& animation) {
+  FrameTarget target;
+  if (!LoadTarget(window, &target)) return false;
+  ResizeTarget(&target, width, height);
+  std::vector<FrameTarget> targets{std::move(target)};
+  ApplyFrames(targets, animation);
+  return true;
+}
+
+bool FrameService::SetBounds(PaletteWindow* window, double x, double y,
+                             double width, double height,
+                             const FrameAnimation& animation) {
+  FrameTarget target;
+  if (!LoadTarget(window, &target)) return false;
+  BoundTarget(&target, x, y, width, height);
+  std::vector<FrameTarget> targets{std::move(target)};
+  ApplyFrames(targets, animation);
+  return true;
+}
+
 }  // namespace floating_palette
@@ -5,7 +5,9 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "../core/animation_engine.h"
 #include "../core/window_store.h"
 
 namespace floating_palette {
@@ -16,7 +18,7 @@ class SnapService;
 class FrameService {
  public:
   void SetEventSink(EventSink sink) { event_sink_ = std::move(sink); }
-  void Handle(const std::string& command,
+  bool Handle(const std::string& command,
               const std::string* window_id,
               const flutter::EncodableMap& params,
               std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
@@ -25,11 +27,65 @@ class FrameService {
   void SetDragCoordinator(DragCoordinator* coordinator) {
     drag_coordinator_ = coordinator;
   }
+  /// Runs `animate: true` frame changes; without it they apply immediately.
+  void SetAnimationEngine(AnimationEngine* engine) {
+    animation_engine_ = engine;
+  }
+
+  /// How a frame change is applied: at once, or animated.
+  struct FrameAnimation {
+    bool animate = false;
+    double duration = 0.2;  // Seconds.
+    AnimationCurve curve = AnimationCurve::kEaseInOut;
+  };
+
+  /// Typed frame changes for the binary channel (logical px, top-left
+  /// anchored), with the same effects as the commands. False if the
+  /// window doesn't exist.
+  bool SetPosition(PaletteWindow* window, double x, double y,
+                   const FrameAnimation& animation);
+  bool SetSize(PaletteWindow* window, double width, double height,
+               const FrameAnimation& animation);
+  bool SetBounds(PaletteWindow* window, double x, double y, double width,
+                 double height, const FrameAnimation& animation);
 
  private:
+  /// One window's frame change: where it was and where it goes (physical).
+  struct FrameTarget {
+    std::string id;
+    PaletteWindow* window = nullptr;
+    FrameSnapshot before;
+    RECT frame = {};
+  };
+
+  /// Logical frame from the window's FrameCache; false if unknown.
+  static bool LoadFrame(const std::string* window_id, FrameSnapshot* out);
+  /// A target for the window, initially at its current frame; false if the
+  /// window doesn't exist.
+  static bool LoadTarget(const std::string* window_id, FrameTarget* out);
+  static bool LoadTarget(PaletteWindow* window, FrameTarget* out);
+  /// Set `target->frame` from logical {x, y, width, height} params.
+  static bool ParseBounds(const flutter::EncodableMap& params,
+                          FrameTarget* target);
+  /// Set `target->frame` from a logical frame; MoveTarget keeps the size,
+  /// ResizeTarget the top-left.
+  static void MoveTarget(FrameTarget* target, double x, double y);
+  static void ResizeTarget(FrameTarget* target, double width, double height);
+  static void BoundTarget(FrameTarget* target, double x, double y,
+                          double width, double height);
+  static FrameAnimation ParseAnimation(const flutter::EncodableMap& params);
+  static flutter::EncodableMap BoundsMap(const FrameSnapshot& frame);
+
+  /// Move every target in one FrameBatch (or one animation timeline when
+  /// `animation.animate` is set), then report programmatic moves/resizes
+  /// and let snap followers catch up.
+  void ApplyFrames(std::vector<FrameTarget>& targets,
+                   const FrameAnimation& animation);
+
   EventSink event_sink_;
   SnapService* snap_service_ = nullptr;
   DragCoordinator* drag_coordinator_ = nullptr;
+  AnimationEngine* animation_engine_ = nullptr;
 
   void SetPosition(const std::string* window_id,
                    const flutter::EncodableMap& params,
@@ -40,17 +96,27 @@ class FrameService {
   void SetBounds(const std::string* window_id,
                  const flutter::EncodableMap& params,
                  std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+  /// `frames`: [{id, x, y, width, height}], applied as one transaction.
+  void SetBoundsMany(const flutter::EncodableMap& params,
+                     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
   void GetPosition(const std::string* window_id,
                    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
   void GetSize(const std::string* window_id,
                std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
   void GetBounds(const std::string* window_id,
                  std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+  /// `ids` -> {id: {x, y, width, height}}; unknown ids are omitted.
+  void GetBoundsMany(const flutter::EncodableMap& params,
+                     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
   void StartDrag(const std::string* window_id,
                  std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
   void SetDraggable(const std::string* window_id,
                     const flutter::EncodableMap& params,
                     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+  /// Route the window's high-rate updates to the binary channel; answers
+  /// with its handle for binary requests.
+  void BindBinary(const std::string* window_id,
+                  std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
 };
 
 }  // namespace floating_palette
@@ -1,27 +1,81 @@
 #include "host_service.h"
 
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "../core/command_hash.h"
+#include "../core/command_stats.h"
+#include "../core/composition_layer.h"
+#include "../core/event_filter.h"
+#include "../core/glass_animation_driver.h"
+#include "../core/glass_backdrop.h"
+#include "../core/param_utils.h"
 #include "../core/logger.h"
+#include "../core/metrics.h"
+#include "../core/palette_panel.h"
+#include "../core/reveal_pipeline.h"
+#include "snap_service.h"
 
 namespace floating_palette {
 
-void HostService::Handle(
+bool HostService::Handle(
     const std::string& command,
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  if (command == "getProtocolVersion") {
-    GetProtocolVersion(std::move(result));
-  } else if (command == "getCapabilities") {
-    GetCapabilities(std::move(result));
-  } else if (command == "getServiceVersion") {
-    GetServiceVersion(params, std::move(result));
-  } else if (command == "getSnapshot") {
-    GetSnapshot(std::move(result));
-  } else if (command == "ping") {
-    Ping(std::move(result));
-  } else {
-    result->Error("UNKNOWN_COMMAND", "Unknown host command: " + command);
+  switch (HashCommand(command)) {
+    case HashCommand("getProtocolVersion"):
+      if (command != "getProtocolVersion") break;
+      GetProtocolVersion(std::move(result));
+      return true;
+    case HashCommand("getCapabilities"):
+      if (command != "getCapabilities") break;
+      GetCapabilities(std::move(result));
+      return true;
+    case HashCommand("getServiceVersion"):
+      if (command != "getServiceVersion") break;
+      GetServiceVersion(params, std::move(result));
+      return true;
+    case HashCommand("getSnapshot"):
+      if (command != "getSnapshot") break;
+      GetSnapshot(std::move(result));
+      return true;
+    case HashCommand("ping"):
+      if (command != "ping") break;
+      Ping(std::move(result));
+      return true;
+    case HashCommand("getCommandStats"):
+      if (command != "getCommandStats") break;
+      GetCommandStats(params, std::move(result));
+      return true;
+    case HashCommand("getResizeStats"):
+      if (command != "getResizeStats") break;
+      GetResizeStats(std::move(result));
+      return true;
+    case HashCommand("getGlassAnimationStats"):
+      if (command != "getGlassAnimationStats") break;
+      GetGlassAnimationStats(std::move(result));
+      return true;
+    case HashCommand("getMetrics"):
+      if (command != "getMetrics") break;
+      GetMetrics(params, std::move(result));
+      return true;
+    case HashCommand("setLogCategories"):
+      if (command != "setLogCategories") break;
+      SetLogCategories(params, std::move(result));
+      return true;
+    case HashCommand("subscribe"):
+      if (command != "subscribe") break;
+      Subscribe(window_id, params, true, std::move(result));
+      return true;
+    case HashCommand("unsubscribe"):
+      if (command != "unsubscribe") break;
+      Subscribe(window_id, params, false, std::move(result));
+      return true;
   }
+  result->Error("UNKNOWN_COMMAND", "Unknown host command: " + command);
+  return false;
 }
 
 void HostService::GetProtocolVersion(
@@ -40,11 +94,12 @@ void HostService::GetCapabilities(
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
   result->Success(flutter::EncodableValue(flutter::EncodableMap{
       {flutter::EncodableValue("blur"), flutter::EncodableValue(false)},
-      {flutter::EncodableValue("transform"), flutter::EncodableValue(false)},
+      {flutter::EncodableValue("transform"),
+       flutter::EncodableValue(CompositionLayer::IsSupported())},
       {flutter::EncodableValue("globalHotkeys"),
-       flutter::EncodableValue(false)},
+       flutter::EncodableValue(true)},
       {flutter::EncodableValue("glassEffect"),
-       flutter::EncodableValue(false)},
+       flutter::EncodableValue(GlassBackdrop::IsSupported())},
       {flutter::EncodableValue("multiMonitor"),
        flutter::EncodableValue(true)},
       {flutter::EncodableValue("contentSizing"),
@@ -72,8 +127,66 @@ void HostService::GetServiceVersion(
 
 void HostService::GetSnapshot(
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  // TODO: Return snapshot of all palette windows for hot restart recovery
-  result->Success(flutter::EncodableValue(flutter::EncodableList{}));
+  // Windows and engines outlive a Dart hot restart; this lets the new
+  // isolate adopt them (PaletteHost.recover) instead of rebuilding.
+  std::vector<PaletteWindow*> windows;
+  WindowStore::Instance().Snapshot(&windows);
+
+  // Front-to-back rank among palettes, from one walk of the z-order.
+  std::unordered_map<HWND, int64_t> z_ranks;
+  z_ranks.reserve(windows.size());
+  for (PaletteWindow* window : windows) {
+    if (window->hwnd) z_ranks.emplace(window->hwnd, -1);
+  }
+  int64_t rank = 0;
+  for (HWND hwnd = GetTopWindow(nullptr);
+       hwnd && rank < static_cast<int64_t>(z_ranks.size());
+       hwnd = GetWindow(hwnd, GW_HWNDNEXT)) {
+    auto it = z_ranks.find(hwnd);
+    if (it != z_ranks.end()) it->second = rank++;
+  }
+
+  const HWND foreground = GetForegroundWindow();
+  flutter::EncodableList snapshot;
+  snapshot.reserve(windows.size());
+  for (PaletteWindow* window : windows) {
+    if (window->id.empty() || !window->hwnd) continue;
+    FrameSnapshot frame;
+    window->frame.Load(&frame);
+    const bool topmost =
+        (GetWindowLongPtr(window->hwnd, GWL_EXSTYLE) & WS_EX_TOPMOST) != 0;
+    snapshot.push_back(flutter::EncodableValue(flutter::EncodableMap{
+        {flutter::EncodableValue("id"), flutter::EncodableValue(window->id)},
+        {flutter::EncodableValue("handle"),
+         flutter::EncodableValue(static_cast<int32_t>(window->handle))},
+        {flutter::EncodableValue("engine"),
+         flutter::EncodableValue(
+             static_cast<int64_t>(reinterpret_cast<intptr_t>(window->engine)))},
+        {flutter::EncodableValue("visible"),
+         flutter::EncodableValue(RevealPipeline::IsShown(*window))},
+        {flutter::EncodableValue("focused"),
+         flutter::EncodableValue(window->hwnd == foreground)},
+        {flutter::EncodableValue("x"), flutter::EncodableValue(frame.x)},
+        {flutter::EncodableValue("y"), flutter::EncodableValue(frame.y)},
+        {flutter::EncodableValue("width"),
+         flutter::EncodableValue(frame.width)},
+        {flutter::EncodableValue("height"),
+         flutter::EncodableValue(frame.height)},
+        {flutter::EncodableValue("zIndex"),
+         flutter::EncodableValue(z_ranks[window->hwnd])},
+        {flutter::EncodableValue("topmost"), flutter::EncodableValue(topmost)},
+        {flutter::EncodableValue("keepAlive"),
+         flutter::EncodableValue(window->keep_alive)},
+        {flutter::EncodableValue("suspended"),
+         flutter::EncodableValue(window->suspended)},
+        {flutter::EncodableValue("draggable"),
+         flutter::EncodableValue(window->draggable)},
+        {flutter::EncodableValue("snap"),
+         snap_service_ ? snap_service_->SnapLinkFor(window->id)
+                       : flutter::EncodableValue()},
+    }));
+  }
+  result->Success(flutter::EncodableValue(std::move(snapshot)));
 }
 
 void HostService::Ping(
@@ -81,4 +194,156 @@ void HostService::Ping(
   result->Success(flutter::EncodableValue(true));
 }
 
+void HostService::GetCommandStats(
+    const flutter::EncodableMap& params,
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  if (!command_stats_) {
+    result->Success(flutter::EncodableValue(flutter::EncodableList{}));
+    return;
+  }
+  auto snapshot = command_stats_->Snapshot();
+  if (GetBool(params, "reset").value_or(false)) {
+    command_stats_->Reset();
+  }
+  result->Success(flutter::EncodableValue(std::move(snapshot)));
+}
+
+void HostService::GetResizeStats(
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  const auto& stats = PalettePanel::Stats();
+  auto load = [](const std::atomic<uint64_t>& counter) {
+    return flutter::EncodableValue(
+        static_cast<int64_t>(counter.load(std::memory_order_relaxed)));
+  };
+  result->Success(flutter::EncodableValue(flutter::EncodableMap{
+      {flutter::EncodableValue("requested"), load(stats.requested)},
+      {flutter::EncodableValue("coalesced"), load(stats.coalesced)},
+      {flutter::EncodableValue("unchanged"), load(stats.unchanged)},
+      {flutter::EncodableValue("applied"), load(stats.applied)},
+      {flutter::EncodableValue("deferred"), load(stats.deferred)},
+      {flutter::EncodableValue("dpiChanges"), load(stats.dpi_changes)},
+  }));
+}
+
+void HostService::GetGlassAnimationStats(
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  const auto& driver = GlassAnimationDriver::Instance();
+  const auto& stats = driver.Stats();
+  const auto& paths = GlassBackdrop::Instance().Stats();
+  auto load = [](const std::atomic<uint64_t>& counter) {
+    return flutter::EncodableValue(
+        static_cast<int64_t>(counter.load(std::memory_order_relaxed)));
+  };
+  result->Success(flutter::EncodableValue(flutter::EncodableMap{
+      {flutter::EncodableValue("buffers"),
+       flutter::EncodableValue(static_cast<int64_t>(driver.buffer_count()))},
+      {flutter::EncodableValue("reads"), load(stats.reads)},
+      {flutter::EncodableValue("tornReads"), load(stats.torn_reads)},
+      {flutter::EncodableValue("delivered"), load(stats.delivered)},
+      {flutter::EncodableValue("pathUpdates"), load(paths.path_updates)},
+      {flutter::EncodableValue("pathTornReads"), load(paths.torn_reads)},
+      {flutter::EncodableValue("identicalPaths"), load(paths.identical_paths)},
+      {flutter::EncodableValue("transformedPaths"),
+       load(paths.transformed_paths)},
+      {flutter::EncodableValue("regionRebuilds"), load(paths.region_rebuilds)},
+  }));
+}
+
+void HostService::GetMetrics(
+    const flutter::EncodableMap& params,
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  MetricsSnapshot metrics;
+  Metrics::Instance().Read(&metrics);
+  if (GetBool(params, "reset").value_or(false)) {
+    Metrics::Instance().Reset();
+  }
+
+  auto count = [](uint64_t value) {
+    return flutter::EncodableValue(static_cast<int64_t>(value));
+  };
+  flutter::EncodableList services;
+  for (size_t i = 0; i < MetricsSnapshot::kServiceCount; ++i) {
+    const MetricsSnapshot::Service& service = metrics.services[i];
+    if (service.commands == 0) continue;
+    services.push_back(flutter::EncodableValue(flutter::EncodableMap{
+        {flutter::EncodableValue("service"),
+         flutter::EncodableValue(std::string(Metrics::ServiceName(i)))},
+        {flutter::EncodableValue("commands"), count(service.commands)},
+        {flutter::EncodableValue("p50Ms"),
+         flutter::EncodableValue(service.p50_ms)},
+        {flutter::EncodableValue("p99Ms"),
+         flutter::EncodableValue(service.p99_ms)},
+        {flutter::EncodableValue("maxMs"),
+         flutter::EncodableValue(service.max_ms)},
+    }));
+  }
+
+  result->Success(flutter::EncodableValue(flutter::EncodableMap{
+      {flutter::EncodableValue("services"),
+       flutter::EncodableValue(std::move(services))},
+      {flutter::EncodableValue("eventsEmitted"),
+       count(metrics.events_emitted)},
+      {flutter::EncodableValue("eventsCoalesced"),
+       count(metrics.events_coalesced)},
+      {flutter::EncodableValue("eventFlushes"), count(metrics.event_flushes)},
+      {flutter::EncodableValue("windowPosCalls"),
+       count(metrics.window_pos_calls)},
+      {flutter::EncodableValue("windowPosBatches"),
+       count(metrics.window_pos_batches)},
+      {flutter::EncodableValue("windowPosBatchedWindows"),
+       count(metrics.window_pos_batched_windows)},
+      {flutter::EncodableValue("animationFrames"),
+       count(metrics.animation_frames)},
+      {flutter::EncodableValue("animationFramesDropped"),
+       count(metrics.animation_frames_dropped)},
+      {flutter::EncodableValue("captureFrames"),
+       count(metrics.capture_frames)},
+      {flutter::EncodableValue("captureFps"),
+       flutter::EncodableValue(metrics.capture_fps)},
+  }));
+}
+
+void HostService::SetLogCategories(
+    const flutter::EncodableMap& params,
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  const auto* categories = GetString(params, "categories");
+  if (!categories) {
+    result->Error("INVALID_PARAMS",
+                  "categories required (e.g. \"Window,Frame\", \"all\")");
+    return;
+  }
+  uint32_t mask = Logger::ParseCategories(*categories);
+  Logger::SetEnabledCategories(mask);
+
+  // Echo the effective set, so a typo shows up as a missing name.
+  flutter::EncodableList enabled;
+  for (const LogCategoryName& entry : kLogCategoryNames) {
+    if (mask & entry.bit) {
+      enabled.push_back(flutter::EncodableValue(std::string(entry.name)));
+    }
+  }
+  result->Success(flutter::EncodableValue(std::move(enabled)));
+}
+
+void HostService::Subscribe(
+    const std::string* window_id,
+    const flutter::EncodableMap& params,
+    bool subscribe,
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  const auto* service = GetString(params, "service");
+  if (!service) {
+    result->Error("INVALID_PARAMS", "service required (\"*\" for any)");
+    return;
+  }
+  const auto* event = GetString(params, "event");
+  const std::string any = "*";
+  auto& filter = EventFilter::Instance();
+  if (subscribe) {
+    filter.Subscribe(*service, event ? *event : any, window_id);
+  } else {
+    filter.Unsubscribe(*service, event ? *event : any, window_id);
+  }
+  result->Success(flutter::EncodableValue());
+}
+
 }  // namespace floating_palette
@@ -10,16 +10,24 @@
 
 namespace floating_palette {
 
+class CommandStats;
+class SnapService;
+
 class HostService {
  public:
   void SetEventSink(EventSink sink) { event_sink_ = std::move(sink); }
-  void Handle(const std::string& command,
+  void SetCommandStats(CommandStats* stats) { command_stats_ = stats; }
+  /// Source of the snap links in getSnapshot.
+  void SetSnapService(SnapService* service) { snap_service_ = service; }
+  bool Handle(const std::string& command,
               const std::string* window_id,
               const flutter::EncodableMap& params,
               std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
 
  private:
   EventSink event_sink_;
+  CommandStats* command_stats_ = nullptr;
+  SnapService* snap_service_ = nullptr;
 
   static constexpr int kProtocolVersion = 1;
   static constexpr int kMinDartVersion = 1;
@@ -31,6 +39,19 @@ class HostService {
                          std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
   void GetSnapshot(std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
   void Ping(std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+  void GetCommandStats(const flutter::EncodableMap& params,
+                       std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+  void GetResizeStats(std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+  void GetGlassAnimationStats(std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+  void GetMetrics(const flutter::EncodableMap& params,
+                  std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+  void SetLogCategories(const flutter::EncodableMap& params,
+                        std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+  /// subscribe / unsubscribe: Dart's event interest; see EventFilter.
+  void Subscribe(const std::string* window_id,
+                 const flutter::EncodableMap& params,
+                 bool subscribe,
+                 std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
 };
 
 }  // namespace floating_palette
@@ -0,0 +1,243 @@
+#include "hotkey_service.h"
+
+#include <utility>
+
+#include "../core/command_hash.h"
+#include "../core/logger.h"
+#include "../core/param_utils.h"
+#include "../core/reveal_pipeline.h"
+#include "../core/virtual_keys.h"
+#include "visibility_service.h"
+
+namespace floating_palette {
+
+namespace {
+
+constexpr wchar_t kHotkeyClassName[] = L"FloatingPaletteHotkeys";
+
+// RegisterHotKey ids available to applications.
+constexpr int kMaxHotkeyId = 0xBFFF;
+
+UINT ModifierFor(const std::string& name) {
+  switch (HashCommand(name)) {
+    case HashCommand("control"):
+      return name == "control" ? MOD_CONTROL : 0;
+    case HashCommand("alt"):
+      return name == "alt" ? MOD_ALT : 0;
+    case HashCommand("shift"):
+      return name == "shift" ? MOD_SHIFT : 0;
+    case HashCommand("meta"):
+      return name == "meta" ? MOD_WIN : 0;
+    default:
+      return 0;
+  }
+}
+
+}  // namespace
+
+HotkeyService::HotkeyService() {
+  WNDCLASSEXW wc = {};
+  wc.cbSize = sizeof(wc);
+  wc.lpfnWndProc = MessageWndProc;
+  wc.hInstance = GetModuleHandle(nullptr);
+  wc.lpszClassName = kHotkeyClassName;
+  RegisterClassExW(&wc);
+
+  message_window_ =
+      CreateWindowExW(0, kHotkeyClassName, L"", 0, 0, 0, 0, 0, HWND_MESSAGE,
+                      nullptr, GetModuleHandle(nullptr), nullptr);
+  SetWindowLongPtr(message_window_, GWLP_USERDATA,
+                   reinterpret_cast<LONG_PTR>(this));
+}
+
+HotkeyService::~HotkeyService() {
+  if (!message_window_) return;
+  for (const auto& [id, binding] : bindings_) {
+    UnregisterHotKey(message_window_, id);
+  }
+  SetWindowLongPtr(message_window_, GWLP_USERDATA, 0);
+  DestroyWindow(message_window_);
+}
+
+bool HotkeyService::Handle(
+    const std::string& command,
+    const std::string* window_id,
+    const flutter::EncodableMap& params,
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  switch (HashCommand(command)) {
+    case HashCommand("register"):
+      if (command != "register") break;
+      Register(window_id, params, std::move(result));
+      return true;
+    case HashCommand("unregister"):
+      if (command != "unregister") break;
+      Unregister(params, std::move(result));
+      return true;
+    case HashCommand("unregisterAll"):
+      if (command != "unregisterAll") break;
+      UnregisterAll(std::move(result));
+      return true;
+  }
+  result->Error("UNKNOWN_COMMAND", "Unknown hotkey command: " + command);
+  return false;
+}
+
+void HotkeyService::Register(
+    const std::string* window_id,
+    const flutter::EncodableMap& params,
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  const std::string* hotkey_id = GetString(params, "hotkeyId");
+  auto key_id = GetInt(params, "keyId");
+  if (!hotkey_id || !key_id) {
+    result->Error("INVALID_PARAMS", "hotkeyId and keyId required");
+    return;
+  }
+  UINT virtual_key = VirtualKeyForLogicalKey(*key_id);
+  if (!virtual_key) {
+    result->Error("UNSUPPORTED_KEY", "No virtual key for keyId " +
+                                         std::to_string(*key_id));
+    return;
+  }
+
+  UINT modifiers = GetBool(params, "repeat").value_or(false) ? 0
+                                                             : MOD_NOREPEAT;
+  if (const auto* value = FindParam(params, "modifiers")) {
+    if (const auto* names = std::get_if<flutter::EncodableList>(value)) {
+      for (const auto& entry : *names) {
+        if (const auto* name = std::get_if<std::string>(&entry)) {
+          modifiers |= ModifierFor(*name);
+        }
+      }
+    }
+  }
+
+  Binding binding;
+  binding.hotkey_id = *hotkey_id;
+  binding.focus = GetBool(params, "focus").value_or(true);
+  if (window_id) binding.window_id = *window_id;
+  const std::string* action = GetString(params, "action");
+  if (!action) {
+    binding.action = window_id ? Action::kShow : Action::kNotify;
+  } else if (*action == "show" || *action == "toggle") {
+    if (!window_id) {
+      result->Error("INVALID_PARAMS", *action + " requires a windowId");
+      return;
+    }
+    binding.action = *action == "show" ? Action::kShow : Action::kToggle;
+  } else if (*action == "notify") {
+    binding.action = Action::kNotify;
+  } else {
+    result->Error("INVALID_PARAMS", "Unknown hotkey action: " + *action);
+    return;
+  }
+
+  // Replacing: free the old combination first, so re-registering the same
+  // keys under the same hotkeyId doesn't collide with itself.
+  Remove(*hotkey_id);
+
+  int id = next_id_;
+  while (bindings_.count(id)) id = id % kMaxHotkeyId + 1;
+  if (!RegisterHotKey(message_window_, id, modifiers, virtual_key)) {
+    DWORD error = GetLastError();
+    FP_LOG("Input", "RegisterHotKey failed: ", *hotkey_id, " error=",
+           static_cast<uint32_t>(error));
+    if (error == ERROR_HOTKEY_ALREADY_REGISTERED) {
+      result->Error("HOTKEY_IN_USE",
+                    "Key combination is registered by another application");
+    } else {
+      result->Error("REGISTER_FAILED",
+                    "RegisterHotKey failed: " + std::to_string(error));
+    }
+    return;
+  }
+  next_id_ = id % kMaxHotkeyId + 1;
+
+  FP_LOG("Input", "hotkey registered: ", *hotkey_id, " vk=", virtual_key,
+         " modifiers=", modifiers);
+  ids_[*hotkey_id] = id;
+  bindings_[id] = std::move(binding);
+  result->Success(flutter::EncodableValue());
+}
+
+void HotkeyService::Unregister(
+    const flutter::EncodableMap& params,
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  const std::string* hotkey_id = GetString(params, "hotkeyId");
+  if (!hotkey_id) {
+    result->Error("INVALID_PARAMS", "hotkeyId required");
+    return;
+  }
+  Remove(*hotkey_id);
+  result->Success(flutter::EncodableValue());
+}
+
+void HotkeyService::UnregisterAll(
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  for (const auto& [id, binding] : bindings_) {
+    UnregisterHotKey(message_window_, id);
+  }
+  bindings_.clear();
+  ids_.clear();
+  result->Success(flutter::EncodableValue());
+}
+
+void HotkeyService::Remove(const std::string& hotkey_id) {
+  auto it = ids_.find(hotkey_id);
+  if (it == ids_.end()) return;
+  UnregisterHotKey(message_window_, it->second);
+  bindings_.erase(it->second);
+  ids_.erase(it);
+}
+
+void HotkeyService::OnHotkey(int id) {
+  auto it = bindings_.find(id);
+  if (it == bindings_.end()) return;
+  Binding& binding = it->second;
+
+  // The reveal starts here, before Dart is told anything.
+  const char* outcome = "notified";
+  if (binding.action != Action::kNotify && visibility_service_) {
+    auto& store = WindowStore::Instance();
+    PaletteWindow* window = store.Get(binding.handle);
+    if (!window) {
+      binding.handle = store.Resolve(binding.window_id);
+      window = store.Get(binding.handle);
+    }
+    if (window && window->hwnd) {
+      if (binding.action == Action::kToggle && !window->is_pending_reveal &&
+          RevealPipeline::IsShown(*window)) {
+        visibility_service_->HidePalette(*window);
+        outcome = "hidden";
+      } else {
+        visibility_service_->ShowPalette(*window, binding.focus, true);
+        outcome = "shown";
+      }
+    }
+  }
+
+  FP_LOG("Input", "hotkey: ", binding.hotkey_id, " ", outcome);
+  if (event_sink_) {
+    event_sink_("hotkey", "triggered",
+                binding.window_id.empty() ? nullptr : &binding.window_id,
+                flutter::EncodableMap{
+                    {flutter::EncodableValue("hotkeyId"),
+                     flutter::EncodableValue(binding.hotkey_id)},
+                    {flutter::EncodableValue("action"),
+                     flutter::EncodableValue(outcome)},
+                });
+  }
+}
+
+// static
+LRESULT CALLBACK HotkeyService::MessageWndProc(HWND hwnd, UINT message,
+                                               WPARAM wparam, LPARAM lparam) {
+  if (message == WM_HOTKEY) {
+    auto* self = reinterpret_cast<HotkeyService*>(
+        GetWindowLongPtr(hwnd, GWLP_USERDATA));
+    if (self) self->OnHotkey(static_cast<int>(wparam));
+    return 0;
+  }
+  return DefWindowProc(hwnd, message, wparam, lparam);
+}
+
+}  // namespace floating_palette
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <windows.h>
+
+#include <flutter/method_channel.h>
+#include <flutter/standard_method_codec.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "../core/window_store.h"
+
+namespace floating_palette {
+
+class VisibilityService;
+
+/// System-wide hotkeys (RegisterHotKey), optionally bound to a palette.
+///
+/// WM_HOTKEY is posted by the system straight to a message-only window on
+/// the platform thread; no hook thread and no per-keystroke work. A hotkey
+/// bound to a palette shows (or toggles) it natively before Dart hears
+/// about it: a warm keep-alive palette is uncloaked in the same message,
+/// and only then is "hotkey" "triggered" queued for Dart. The path is
+/// WM_HOTKEY → reveal, instead of an event → Dart → show command round
+/// trip.
+///
+/// Commands:
+///   register {hotkeyId, keyId, modifiers?, action?, focus?, repeat?}
+///     with the palette as windowId. keyId is a Flutter LogicalKeyboardKey
+///     id, modifiers any of "control", "alt", "shift", "meta". action is
+///     "show" (default with a windowId), "toggle" or "notify" (default
+///     without one). Re-registering a hotkeyId replaces it.
+///   unregister {hotkeyId}, unregisterAll.
+class HotkeyService {
+ public:
+  HotkeyService();
+  ~HotkeyService();
+
+  HotkeyService(const HotkeyService&) = delete;
+  HotkeyService& operator=(const HotkeyService&) = delete;
+
+  void SetEventSink(EventSink sink) { event_sink_ = std::move(sink); }
+  void SetVisibilityService(VisibilityService* service) {
+    visibility_service_ = service;
+  }
+  bool Handle(const std::string& command,
+              const std::string* window_id,
+              const flutter::EncodableMap& params,
+              std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+
+ private:
+  enum class Action { kNotify, kShow, kToggle };
+
+  struct Binding {
+    std::string hotkey_id;
+    /// Empty for notify-only hotkeys.
+    std::string window_id;
+    /// Resolved on first trigger and again whenever it goes stale, so a
+    /// binding can name a palette created later.
+    WindowHandle handle = kInvalidWindowHandle;
+    Action action = Action::kNotify;
+    bool focus = true;
+  };
+
+  EventSink event_sink_;
+  VisibilityService* visibility_service_ = nullptr;
+  HWND message_window_ = nullptr;
+  /// Keyed by the RegisterHotKey id.
+  std::unordered_map<int, Binding> bindings_;
+  std::unordered_map<std::string, int> ids_;
+  int next_id_ = 1;
+
+  void Register(const std::string* window_id,
+                const flutter::EncodableMap& params,
+                std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+  void Unregister(const flutter::EncodableMap& params,
+                  std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+  void UnregisterAll(std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+
+  void Remove(const std::string& hotkey_id);
+  void OnHotkey(int id);
+
+  static LRESULT CALLBACK MessageWndProc(HWND hwnd, UINT message,
+                                         WPARAM wparam, LPARAM lparam);
+};
+
+}  // namespace floating_palette
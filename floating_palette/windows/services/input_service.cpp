@@ -1,42 +1,113 @@
 #include "input_service.h"
 
+#include <utility>
+#include <vector>
+
+#include "../core/command_hash.h"
+#include "../core/hit_test_mask.h"
+#include "../core/keyboard_route.h"
 #include "../core/logger.h"
+#include "../core/palette_panel.h"
+#include "../core/param_utils.h"
+#include "../core/virtual_keys.h"
 
 namespace floating_palette {
 
-void InputService::Handle(
+InputService::InputService(flutter::PluginRegistrarWindows* registrar)
+    : registrar_(registrar) {}
+
+HWND InputService::HostView() const {
+  if (!registrar_ || !registrar_->GetView()) return nullptr;
+  return registrar_->GetView()->GetNativeWindow();
+}
+
+void InputService::OnWindowDestroyed(PaletteWindow& window) {
+  KeyboardRoute::Instance().Release(window.handle);
+}
+
+bool InputService::Handle(
     const std::string& command,
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  if (command == "captureKeyboard") {
-    CaptureKeyboard(window_id, std::move(result));
-  } else if (command == "releaseKeyboard") {
-    ReleaseKeyboard(window_id, std::move(result));
-  } else if (command == "capturePointer") {
-    CapturePointer(window_id, std::move(result));
-  } else if (command == "releasePointer") {
-    ReleasePointer(window_id, std::move(result));
-  } else if (command == "setCursor") {
-    SetCursor(window_id, params, std::move(result));
-  } else if (command == "setPassthrough") {
-    SetPassthrough(window_id, params, std::move(result));
-  } else {
-    result->Error("UNKNOWN_COMMAND", "Unknown input command: " + command);
+  switch (HashCommand(command)) {
+    case HashCommand("captureKeyboard"):
+      if (command != "captureKeyboard") break;
+      CaptureKeyboard(window_id, params, std::move(result));
+      return true;
+    case HashCommand("releaseKeyboard"):
+      if (command != "releaseKeyboard") break;
+      ReleaseKeyboard(window_id, std::move(result));
+      return true;
+    case HashCommand("capturePointer"):
+      if (command != "capturePointer") break;
+      CapturePointer(window_id, std::move(result));
+      return true;
+    case HashCommand("releasePointer"):
+      if (command != "releasePointer") break;
+      ReleasePointer(window_id, std::move(result));
+      return true;
+    case HashCommand("setCursor"):
+      if (command != "setCursor") break;
+      SetCursor(window_id, params, std::move(result));
+      return true;
+    case HashCommand("setPassthrough"):
+      if (command != "setPassthrough") break;
+      SetPassthrough(window_id, params, std::move(result));
+      return true;
   }
+  result->Error("UNKNOWN_COMMAND", "Unknown input command: " + command);
+  return false;
 }
 
 void InputService::CaptureKeyboard(
     const std::string* window_id,
+    const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  FP_LOG("Input", "captureKeyboard stub");
+  auto* window = window_id ? WindowStore::Instance().Get(*window_id) : nullptr;
+  if (!window || !window->hwnd) {
+    result->Error("NOT_FOUND", "Window not found");
+    return;
+  }
+
+  // Key ids are mapped to virtual keys once here, so routing a keystroke
+  // is a bit test.
+  std::vector<UINT> keys;
+  const auto* value = FindParam(params, "keys");
+  const auto* key_ids =
+      value ? std::get_if<flutter::EncodableList>(value) : nullptr;
+  if (key_ids) {
+    keys.reserve(key_ids->size());
+    for (const auto& entry : *key_ids) {
+      int64_t key_id = 0;
+      if (const auto* i = std::get_if<int32_t>(&entry)) {
+        key_id = *i;
+      } else if (const auto* l = std::get_if<int64_t>(&entry)) {
+        key_id = *l;
+      }
+      if (UINT key = VirtualKeyForLogicalKey(key_id)) keys.push_back(key);
+    }
+  }
+  // No key list means every key.
+  bool all_keys = GetBool(params, "allKeys").value_or(false) || !key_ids;
+
+  if (!KeyboardRoute::Instance().Capture(HostView(), *window, all_keys,
+                                         keys)) {
+    result->Error("UNAVAILABLE", "No host view to capture keys from");
+    return;
+  }
   result->Success(flutter::EncodableValue());
 }
 
 void InputService::ReleaseKeyboard(
     const std::string* window_id,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  FP_LOG("Input", "releaseKeyboard stub");
+  // Releasing an unknown or already destroyed window is a no-op.
+  WindowHandle handle =
+      window_id ? WindowStore::Instance().Resolve(*window_id)
+                : kInvalidWindowHandle;
+  KeyboardRoute::Instance().Release(handle);
+  FP_LOG("Input", "keyboard released: ", window_id ? *window_id : "");
   result->Success(flutter::EncodableValue());
 }
 
@@ -66,7 +137,43 @@ void InputService::SetPassthrough(
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  FP_LOG("Input", "setPassthrough stub");
+  auto* window = window_id ? WindowStore::Instance().Get(*window_id) : nullptr;
+  if (!window || !window->hwnd) {
+    result->Error("NOT_FOUND", "Window not found");
+    return;
+  }
+
+  bool enabled = GetBool(params, "enabled").value_or(true);
+  const auto* value = FindParam(params, "regions");
+  const auto* regions =
+      value ? std::get_if<flutter::EncodableList>(value) : nullptr;
+
+  std::vector<HitTestMask::Rect> rects;
+  if (enabled && regions) {
+    rects.reserve(regions->size());
+    for (const auto& entry : *regions) {
+      const auto* region = std::get_if<flutter::EncodableMap>(&entry);
+      if (!region) continue;
+      float x = static_cast<float>(GetDouble(*region, "x").value_or(0));
+      float y = static_cast<float>(GetDouble(*region, "y").value_or(0));
+      float width = static_cast<float>(GetDouble(*region, "width").value_or(0));
+      float height =
+          static_cast<float>(GetDouble(*region, "height").value_or(0));
+      if (width <= 0 || height <= 0) continue;
+      rects.push_back(HitTestMask::Rect{x, y, x + width, y + height});
+    }
+  }
+
+  // Regions are answered per WM_NCHITTEST; a whole-window passthrough is
+  // one style change.
+  PassthroughMode mode = !enabled   ? PassthroughMode::kNone
+                         : regions ? PassthroughMode::kRegions
+                                   : PassthroughMode::kAll;
+  FP_LOG("Input", "setPassthrough ", *window_id, " mode=",
+         static_cast<int>(mode), " regions=", rects.size());
+  window->hit_test.SetStatic(mode, std::move(rects));
+  PalettePanel::SetClickThrough(window->hwnd, *window,
+                                mode == PassthroughMode::kAll);
   result->Success(flutter::EncodableValue());
 }
 
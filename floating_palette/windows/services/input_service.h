@@ -1,6 +1,7 @@
 #pragma once
 
 #include <flutter/method_channel.h>
+#include <flutter/plugin_registrar_windows.h>
 #include <flutter/standard_method_codec.h>
 
 #include <memory>
@@ -12,16 +13,26 @@ namespace floating_palette {
 
 class InputService {
  public:
+  explicit InputService(flutter::PluginRegistrarWindows* registrar);
+
   void SetEventSink(EventSink sink) { event_sink_ = std::move(sink); }
-  void Handle(const std::string& command,
+  bool Handle(const std::string& command,
               const std::string* window_id,
               const flutter::EncodableMap& params,
               std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
 
+  /// Drop a destroyed window's keyboard capture.
+  void OnWindowDestroyed(PaletteWindow& window);
+
  private:
+  flutter::PluginRegistrarWindows* registrar_;
   EventSink event_sink_;
 
+  /// The host's Flutter view, where keystrokes land (null without a view).
+  HWND HostView() const;
+
   void CaptureKeyboard(const std::string* window_id,
+                       const flutter::EncodableMap& params,
                        std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
   void ReleaseKeyboard(const std::string* window_id,
                        std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
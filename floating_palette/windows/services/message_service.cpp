@@ -1,27 +1,59 @@
 #include "message_service.h"
 
+#include <vector>
+
+#include "../core/command_hash.h"
 #include "../core/logger.h"
+#include "../core/message_encoder.h"
+#include "../core/param_utils.h"
 
 namespace floating_palette {
 
-void MessageService::Handle(
+bool MessageService::Handle(
     const std::string& command,
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  if (command == "send") {
-    Send(window_id, params, std::move(result));
-  } else {
-    result->Error("UNKNOWN_COMMAND", "Unknown message command: " + command);
+  switch (HashCommand(command)) {
+    case HashCommand("send"):
+      if (command != "send") break;
+      Send(window_id, params, std::move(result));
+      return true;
   }
+  result->Error("UNKNOWN_COMMAND", "Unknown message command: " + command);
+  return false;
 }
 
 void MessageService::Send(
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  // TODO: Route message to palette's messenger channel
-  FP_LOG("Message", "send stub");
+  PaletteWindow* window =
+      window_id ? WindowStore::Instance().Get(*window_id) : nullptr;
+  if (!window) {
+    result->Error("NOT_FOUND", "Window not found");
+    return;
+  }
+  // Sent raw: the host side needs no channel object, and the palette's
+  // handler doesn't depend on the native one being open.
+  if (!window->registrar) {
+    result->Error("NO_CHANNEL", "Messenger channel not available");
+    return;
+  }
+
+  // `params` still points into the host call's decoded arguments; encode
+  // the palette-bound `receive` call from it directly instead of copying
+  // `data` into a new argument tree for MethodChannel::InvokeMethod.
+  const flutter::EncodableValue empty_type{std::string()};
+  const flutter::EncodableValue* type = FindParam(params, "type");
+  const flutter::EncodableValue* data = FindParam(params, "data");
+  const auto* bytes =
+      data ? std::get_if<std::vector<uint8_t>>(data) : nullptr;
+  EncodeMethodCall("receive",
+                   {{"type", type ? type : &empty_type}, {"data", data}},
+                   &buffer_, bytes ? bytes->size() : 0);
+  window->registrar->messenger()->Send(kMessengerChannel, buffer_.data(),
+                                       buffer_.size());
   result->Success(flutter::EncodableValue());
 }
 
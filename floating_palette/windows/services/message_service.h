@@ -4,22 +4,30 @@
 #include <flutter/standard_method_codec.h>
 
 #include <memory>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 #include "../core/window_store.h"
 
 namespace floating_palette {
 
+/// Host → palette messaging over each palette's floating_palette/messenger
+/// channel (palette → host lands in WindowChannelRouter).
 class MessageService {
  public:
+  static constexpr char kMessengerChannel[] = "floating_palette/messenger";
+
   void SetEventSink(EventSink sink) { event_sink_ = std::move(sink); }
-  void Handle(const std::string& command,
+  bool Handle(const std::string& command,
               const std::string* window_id,
               const flutter::EncodableMap& params,
               std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
 
  private:
   EventSink event_sink_;
+  /// Reused encode buffer; the engine copies messages on Send.
+  std::vector<uint8_t> buffer_;
 
   void Send(const std::string* window_id,
             const flutter::EncodableMap& params,
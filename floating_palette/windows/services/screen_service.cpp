@@ -1,48 +1,200 @@
 #include "screen_service.h"
 
+#include "../core/active_app_tracker.h"
+#include "../core/command_hash.h"
+#include "../core/event_filter.h"
 #include "../core/logger.h"
+#include "../core/monitor_topology.h"
 
 namespace floating_palette {
 
-void ScreenService::Handle(
+namespace {
+
+flutter::EncodableValue RectToValue(const RECT& rect) {
+  return flutter::EncodableValue(flutter::EncodableMap{
+      {flutter::EncodableValue("x"),
+       flutter::EncodableValue(static_cast<double>(rect.left))},
+      {flutter::EncodableValue("y"),
+       flutter::EncodableValue(static_cast<double>(rect.top))},
+      {flutter::EncodableValue("width"),
+       flutter::EncodableValue(static_cast<double>(rect.right - rect.left))},
+      {flutter::EncodableValue("height"),
+       flutter::EncodableValue(static_cast<double>(rect.bottom - rect.top))},
+  });
+}
+
+// Bounds plus appName, as ActiveAppInfo.fromMap reads them.
+flutter::EncodableValue ActiveAppToValue(
+    const ActiveAppTracker::Snapshot& app) {
+  flutter::EncodableValue value = RectToValue(app.bounds);
+  std::get<flutter::EncodableMap>(value)[flutter::EncodableValue("appName")] =
+      flutter::EncodableValue(app.identifier);
+  return value;
+}
+
+}  // namespace
+
+ScreenService::ScreenService(flutter::PluginRegistrarWindows* registrar)
+    : registrar_(registrar) {
+  // Enumerate up front so the first FFI query doesn't pay for it.
+  MonitorTopology::Instance();
+  if (registrar_) {
+    window_proc_id_ = registrar_->RegisterTopLevelWindowProcDelegate(
+        [this](HWND hwnd, UINT message, WPARAM wparam, LPARAM lparam) {
+          return HandleTopLevelMessage(hwnd, message, wparam, lparam);
+        });
+  }
+  ActiveAppTracker::Instance().Start(
+      [this](const ActiveAppTracker::Snapshot& app) {
+        OnActiveAppChanged(app);
+      });
+}
+
+ScreenService::~ScreenService() {
+  ActiveAppTracker::Instance().Stop();
+  if (registrar_ && window_proc_id_) {
+    registrar_->UnregisterTopLevelWindowProcDelegate(window_proc_id_);
+  }
+}
+
+std::optional<LRESULT> ScreenService::HandleTopLevelMessage(HWND hwnd,
+                                                            UINT message,
+                                                            WPARAM wparam,
+                                                            LPARAM lparam) {
+  // Observe only; the runner still handles the message.
+  if (MonitorTopology::IsTopologyMessage(message, wparam)) {
+    RefreshTopology();
+  }
+  return std::nullopt;
+}
+
+void ScreenService::RefreshTopology() {
+  MonitorTopology::Instance().Refresh();
+  if (event_sink_ &&
+      EventFilter::Instance().Wants("screen", "screensChanged", nullptr)) {
+    event_sink_("screen", "screensChanged", nullptr,
+                flutter::EncodableMap{
+                    {flutter::EncodableValue("screens"),
+                     flutter::EncodableValue(ScreensToList())},
+                });
+  }
+}
+
+// static
+flutter::EncodableValue ScreenService::ScreenToValue(
+    int index,
+    const MonitorInfo& monitor) {
+  return flutter::EncodableValue(flutter::EncodableMap{
+      {flutter::EncodableValue("id"), flutter::EncodableValue(index)},
+      {flutter::EncodableValue("name"), flutter::EncodableValue(monitor.name)},
+      {flutter::EncodableValue("isPrimary"),
+       flutter::EncodableValue(monitor.is_primary)},
+      {flutter::EncodableValue("frame"), RectToValue(monitor.bounds)},
+      {flutter::EncodableValue("visibleFrame"),
+       RectToValue(monitor.work_area)},
+      {flutter::EncodableValue("scaleFactor"),
+       flutter::EncodableValue(monitor.scale_factor)},
+  });
+}
+
+// static
+flutter::EncodableList ScreenService::ScreensToList() {
+  const auto topology = MonitorTopology::Instance().Current();
+  const auto& monitors = topology->monitors;
+  flutter::EncodableList screens;
+  screens.reserve(monitors.size());
+  for (size_t i = 0; i < monitors.size(); ++i) {
+    screens.push_back(ScreenToValue(static_cast<int>(i), monitors[i]));
+  }
+  return screens;
+}
+
+bool ScreenService::Handle(
     const std::string& command,
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  if (command == "getScreens") {
-    GetScreens(std::move(result));
-  } else if (command == "getCurrentScreen") {
-    GetCurrentScreen(std::move(result));
-  } else if (command == "getWindowScreen") {
-    GetWindowScreen(window_id, std::move(result));
-  } else if (command == "moveToScreen") {
-    MoveToScreen(window_id, params, std::move(result));
-  } else if (command == "getCursorPosition") {
-    GetCursorPosition(std::move(result));
-  } else if (command == "getActiveAppBounds") {
-    GetActiveAppBounds(std::move(result));
-  } else {
-    result->Error("UNKNOWN_COMMAND", "Unknown screen command: " + command);
+  switch (HashCommand(command)) {
+    case HashCommand("getScreens"):
+      if (command != "getScreens") break;
+      GetScreens(std::move(result));
+      return true;
+    case HashCommand("getCurrentScreen"):
+      if (command != "getCurrentScreen") break;
+      GetCurrentScreen(window_id, std::move(result));
+      return true;
+    case HashCommand("getWindowScreen"):
+      if (command != "getWindowScreen") break;
+      GetWindowScreen(window_id, std::move(result));
+      return true;
+    case HashCommand("getCursorScreen"):
+      if (command != "getCursorScreen") break;
+      GetCursorScreen(std::move(result));
+      return true;
+    case HashCommand("moveToScreen"):
+      if (command != "moveToScreen") break;
+      MoveToScreen(window_id, params, std::move(result));
+      return true;
+    case HashCommand("getCursorPosition"):
+      if (command != "getCursorPosition") break;
+      GetCursorPosition(std::move(result));
+      return true;
+    case HashCommand("getActiveAppBounds"):
+      if (command != "getActiveAppBounds") break;
+      GetActiveAppBounds(std::move(result));
+      return true;
   }
+  result->Error("UNKNOWN_COMMAND", "Unknown screen command: " + command);
+  return false;
 }
 
 void ScreenService::GetScreens(
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  // TODO: Enumerate monitors via EnumDisplayMonitors
-  result->Success(flutter::EncodableValue(flutter::EncodableList{}));
+  result->Success(flutter::EncodableValue(ScreensToList()));
 }
 
 void ScreenService::GetCurrentScreen(
+    const std::string* window_id,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  // TODO: Get primary monitor info
-  result->Success(flutter::EncodableValue());
+  auto* window = window_id ? WindowStore::Instance().Get(*window_id) : nullptr;
+  if (!window) {
+    result->Error("NOT_FOUND", "Window not found");
+    return;
+  }
+
+  const auto topology = MonitorTopology::Instance().Current();
+  FrameSnapshot frame;
+  window->frame.Load(&frame);
+  int index = topology->IndexForRect(frame.physical);
+  if (index < 0) {
+    result->Success(flutter::EncodableValue());
+    return;
+  }
+  result->Success(ScreenToValue(index, topology->monitors[index]));
 }
 
 void ScreenService::GetWindowScreen(
     const std::string* window_id,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  // TODO: Get monitor containing the window
-  result->Success(flutter::EncodableValue());
+  auto* window = window_id ? WindowStore::Instance().Get(*window_id) : nullptr;
+  if (!window) {
+    result->Error("NOT_FOUND", "Window not found");
+    return;
+  }
+
+  FrameSnapshot frame;
+  window->frame.Load(&frame);
+  int index = MonitorTopology::Instance().IndexForRect(frame.physical);
+  result->Success(flutter::EncodableValue(index < 0 ? 0 : index));
+}
+
+void ScreenService::GetCursorScreen(
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  POINT pt;
+  int index = GetCursorPos(&pt)
+                  ? MonitorTopology::Instance().IndexAtPoint(pt)
+                  : -1;
+  result->Success(flutter::EncodableValue(index));
 }
 
 void ScreenService::MoveToScreen(
@@ -55,22 +207,30 @@ void ScreenService::MoveToScreen(
 
 void ScreenService::GetCursorPosition(
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  // TODO: GetCursorPos
+  POINT pt = {};
+  GetCursorPos(&pt);
   result->Success(flutter::EncodableValue(flutter::EncodableMap{
-      {flutter::EncodableValue("x"), flutter::EncodableValue(0.0)},
-      {flutter::EncodableValue("y"), flutter::EncodableValue(0.0)},
+      {flutter::EncodableValue("x"),
+       flutter::EncodableValue(static_cast<double>(pt.x))},
+      {flutter::EncodableValue("y"),
+       flutter::EncodableValue(static_cast<double>(pt.y))},
   }));
 }
 
 void ScreenService::GetActiveAppBounds(
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  // TODO: GetForegroundWindow + GetWindowRect
-  result->Success(flutter::EncodableValue(flutter::EncodableMap{
-      {flutter::EncodableValue("x"), flutter::EncodableValue(0.0)},
-      {flutter::EncodableValue("y"), flutter::EncodableValue(0.0)},
-      {flutter::EncodableValue("width"), flutter::EncodableValue(0.0)},
-      {flutter::EncodableValue("height"), flutter::EncodableValue(0.0)},
-  }));
+  const auto app = ActiveAppTracker::Instance().Current();
+  result->Success(app.valid ? ActiveAppToValue(app)
+                            : flutter::EncodableValue());
+}
+
+void ScreenService::OnActiveAppChanged(const ActiveAppTracker::Snapshot& app) {
+  if (!app.valid || !event_sink_ ||
+      !EventFilter::Instance().Wants("screen", "activeAppChanged", nullptr)) {
+    return;
+  }
+  event_sink_("screen", "activeAppChanged", nullptr,
+              std::get<flutter::EncodableMap>(ActiveAppToValue(app)));
 }
 
 }  // namespace floating_palette
@@ -1,30 +1,55 @@
 #pragma once
 
 #include <flutter/method_channel.h>
+#include <flutter/plugin_registrar_windows.h>
 #include <flutter/standard_method_codec.h>
 
 #include <memory>
+#include <optional>
 #include <string>
 
+#include "../core/active_app_tracker.h"
 #include "../core/window_store.h"
 
 namespace floating_palette {
 
+struct MonitorInfo;
+
 class ScreenService {
  public:
+  /// Watches the runner's top-level window for display, DPI and work-area
+  /// changes and refreshes MonitorTopology on them, and starts the
+  /// ActiveAppTracker that feeds activeAppChanged.
+  explicit ScreenService(flutter::PluginRegistrarWindows* registrar);
+  ~ScreenService();
+
   void SetEventSink(EventSink sink) { event_sink_ = std::move(sink); }
-  void Handle(const std::string& command,
+  bool Handle(const std::string& command,
               const std::string* window_id,
               const flutter::EncodableMap& params,
               std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
 
  private:
+  flutter::PluginRegistrarWindows* registrar_;
+  int window_proc_id_ = 0;
   EventSink event_sink_;
 
+  std::optional<LRESULT> HandleTopLevelMessage(HWND hwnd, UINT message,
+                                               WPARAM wparam, LPARAM lparam);
+  void RefreshTopology();
+  /// Throttled by the tracker; emits activeAppChanged.
+  void OnActiveAppChanged(const ActiveAppTracker::Snapshot& app);
+
+  static flutter::EncodableValue ScreenToValue(int index,
+                                               const MonitorInfo& monitor);
+  static flutter::EncodableList ScreensToList();
+
   void GetScreens(std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
-  void GetCurrentScreen(std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+  void GetCurrentScreen(const std::string* window_id,
+                        std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
   void GetWindowScreen(const std::string* window_id,
                        std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+  void GetCursorScreen(std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
   void MoveToScreen(const std::string* window_id,
                     const flutter::EncodableMap& params,
                     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
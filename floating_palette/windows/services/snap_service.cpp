@@ -1,49 +1,549 @@
 #include "snap_service.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include "../core/command_hash.h"
+#include "../core/clock.h"
+#include "../core/engine_hibernation.h"
+#include "../core/event_filter.h"
 #include "../core/logger.h"
+#include "../core/metrics.h"
+#include "../core/monitor_topology.h"
+#include "../core/param_utils.h"
+#include "../core/reveal_pipeline.h"
+#include "../core/trace.h"
+#include "binary_channel.h"
 
 namespace floating_palette {
 
-void SnapService::Handle(
+bool SnapService::Handle(
     const std::string& command,
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  if (command == "snap") {
-    Snap(window_id, params, std::move(result));
-  } else if (command == "detach") {
-    Detach(window_id, std::move(result));
-  } else if (command == "reSnap") {
-    ReSnap(window_id, std::move(result));
-  } else if (command == "getSnapDistance") {
-    GetSnapDistance(window_id, std::move(result));
-  } else if (command == "setAutoSnapConfig") {
-    SetAutoSnapConfig(window_id, params, std::move(result));
-  } else {
-    result->Error("UNKNOWN_COMMAND", "Unknown snap command: " + command);
+  switch (HashCommand(command)) {
+    case HashCommand("snap"):
+      if (command != "snap") break;
+      Snap(window_id, params, std::move(result));
+      return true;
+    case HashCommand("detach"):
+      if (command != "detach") break;
+      Detach(window_id, params, std::move(result));
+      return true;
+    case HashCommand("reSnap"):
+      if (command != "reSnap") break;
+      ReSnap(window_id, params, std::move(result));
+      return true;
+    case HashCommand("getSnapDistance"):
+      if (command != "getSnapDistance") break;
+      GetSnapDistance(window_id, params, std::move(result));
+      return true;
+    case HashCommand("setAutoSnapConfig"):
+      if (command != "setAutoSnapConfig") break;
+      SetAutoSnapConfig(window_id, params, std::move(result));
+      return true;
   }
+  result->Error("UNKNOWN_COMMAND", "Unknown snap command: " + command);
+  return false;
+}
+
+namespace {
+
+flutter::EncodableMap FrameToMap(const RECT& frame, double scale) {
+  return flutter::EncodableMap{
+      {flutter::EncodableValue("x"),
+       flutter::EncodableValue(frame.left / scale)},
+      {flutter::EncodableValue("y"),
+       flutter::EncodableValue(frame.top / scale)},
+      {flutter::EncodableValue("width"),
+       flutter::EncodableValue((frame.right - frame.left) / scale)},
+      {flutter::EncodableValue("height"),
+       flutter::EncodableValue((frame.bottom - frame.top) / scale)},
+  };
+}
+
+/// followerId param, falling back to the calling window.
+const std::string* FollowerId(const std::string* window_id,
+                              const flutter::EncodableMap& params) {
+  const std::string* id = GetString(params, "followerId");
+  return id ? id : window_id;
+}
+
+}  // namespace
+
+flutter::EncodableValue SnapService::SnapLinkFor(
+    const std::string& follower_id) const {
+  auto it = bindings_.find(follower_id);
+  if (it == bindings_.end()) return flutter::EncodableValue();
+  const SnapBinding& binding = it->second;
+  return flutter::EncodableValue(flutter::EncodableMap{
+      {flutter::EncodableValue("targetId"),
+       flutter::EncodableValue(binding.target_id)},
+      {flutter::EncodableValue("followerEdge"),
+       flutter::EncodableValue(SnapEdgeName(binding.follower_edge))},
+      {flutter::EncodableValue("targetEdge"),
+       flutter::EncodableValue(SnapEdgeName(binding.target_edge))},
+      {flutter::EncodableValue("alignment"),
+       flutter::EncodableValue(binding.alignment)},
+      {flutter::EncodableValue("gap"), flutter::EncodableValue(binding.gap)},
+      {flutter::EncodableValue("hidden"),
+       flutter::EncodableValue(hidden_followers_.count(follower_id) > 0)},
+      {flutter::EncodableValue("config"),
+       flutter::EncodableValue(flutter::EncodableMap{
+           {flutter::EncodableValue("onTargetHidden"),
+            flutter::EncodableValue(binding.on_target_hidden)},
+           {flutter::EncodableValue("onTargetDestroyed"),
+            flutter::EncodableValue(binding.on_target_destroyed)},
+       })},
+  });
 }
 
 void SnapService::OnWindowShown(const std::string& id) {
-  FP_LOG("Snap", "onWindowShown stub: " + id);
+  if (auto_snap_configs_.count(id)) InvalidateIndex();
+  // Bring back followers hidden along with this target.
+  for (const SnapBinding& binding : BindingsTargeting(id)) {
+    if (!hidden_followers_.erase(binding.follower_id)) continue;
+    PositionFollower(binding);
+    ShowFollower(binding.follower_id, true);
+  }
 }
 
 void SnapService::OnWindowHidden(const std::string& id) {
-  FP_LOG("Snap", "onWindowHidden stub: " + id);
+  if (auto_snap_configs_.count(id)) InvalidateIndex();
+  if (proximity_ && proximity_->target_id == id) {
+    ExitProximity(proximity_->dragged_id);
+  }
+  for (const SnapBinding& binding : BindingsTargeting(id)) {
+    HandleTargetHidden(binding);
+  }
+}
+
+void SnapService::OnWindowsMoved(const std::vector<std::string>& ids) {
+  // Followers placed by the same call keep the frame they were given.
+  std::unordered_set<std::string> placed(ids.begin(), ids.end());
+  std::vector<std::string> queue = ids;
+  for (size_t i = 0; i < queue.size(); ++i) {
+    const std::string id = queue[i];
+    if (auto_snap_configs_.count(id)) InvalidateIndex();
+    for (const SnapBinding& binding : BindingsTargeting(id)) {
+      if (hidden_followers_.count(binding.follower_id)) continue;
+      if (!placed.insert(binding.follower_id).second) continue;
+      PositionFollower(binding);
+      // Chains: the follower's own followers move with it.
+      queue.push_back(binding.follower_id);
+    }
+  }
+}
+
+void SnapService::OnWindowDestroyed(const std::string& id) {
+  bindings_.erase(id);
+  hidden_followers_.erase(id);
+  if (auto_snap_configs_.erase(id)) InvalidateIndex();
+  if (proximity_ && proximity_->target_id == id) {
+    ExitProximity(proximity_->dragged_id);
+  }
+  if (proximity_ && proximity_->dragged_id == id) proximity_.reset();
+  for (const SnapBinding& binding : BindingsTargeting(id)) {
+    HandleTargetDestroyed(binding);
+  }
 }
 
 // DragCoordinatorDelegate
 
 void SnapService::DragBegan(const std::string& id) {
-  FP_LOG("Snap", "dragBegan stub: " + id);
+  // Pay for any pending rebuild before the first move, not during it.
+  RebuildIndexIfDirty();
+  PaletteWindow* window = WindowStore::Instance().Get(id);
+  drag_handle_ = window ? window->handle : kInvalidWindowHandle;
+  drag_scale_ = window && window->hwnd
+                    ? GetDpiForWindow(window->hwnd) / 96.0
+                    : 1.0;
+  if (proximity_ && proximity_->dragged_id == id) proximity_.reset();
+  drag_group_ = {id};
 }
 
 void SnapService::DragMoved(const std::string& id, const RECT& frame) {
-  FP_LOG("Snap", "dragMoved stub: " + id);
+  auto it = bindings_.find(id);
+  if (it != bindings_.end()) {
+    HandleFollowerDrag(it->second, frame);
+    return;
+  }
+  if (InDetachCooldown(drag_handle_)) {
+    ExitProximity(id);
+    return;
+  }
+  CheckProximity(id, frame);
 }
 
 void SnapService::DragEnded(const std::string& id, const RECT& frame) {
-  FP_LOG("Snap", "dragEnded stub: " + id);
+  // The dragged palette's (and its group's) indexed frames are stale now.
+  for (const std::string& moved : drag_group_) {
+    if (auto_snap_configs_.count(moved)) InvalidateIndex();
+  }
+  drag_group_.clear();
+
+  // A follower that wasn't dragged far enough to detach snaps back.
+  auto it = bindings_.find(id);
+  if (it != bindings_.end()) {
+    PositionFollower(it->second);
+    Emit("snap", "snapped", id,
+         flutter::EncodableMap{
+             {flutter::EncodableValue("targetId"),
+              flutter::EncodableValue(it->second.target_id)},
+         });
+    return;
+  }
+
+  if (InDetachCooldown(drag_handle_)) {
+    ExitProximity(id);
+    return;
+  }
+
+  // Released in proximity: auto-snap.
+  if (proximity_ && proximity_->dragged_id == id) {
+    ProximityState proximity = std::move(*proximity_);
+    proximity_.reset();
+    if (!WindowStore::Instance().Exists(proximity.target_id)) return;
+    SnapBinding binding;
+    binding.follower_id = id;
+    binding.target_id = proximity.target_id;
+    binding.follower_edge = proximity.dragged_edge;
+    binding.target_edge = proximity.target_edge;
+    binding.alignment = "center";
+    binding.gap = 4;
+    binding.on_target_hidden = "hideFollower";
+    binding.on_target_destroyed = "hideAndDetach";
+    Bind(std::move(binding));
+  }
+}
+
+void SnapService::CollectFollowers(const std::string& id,
+                                   std::vector<std::string>* out) {
+  // Breadth-first over target -> follower links. `id` counts as visited so
+  // a bidirectional pair (or a longer cycle) terminates.
+  std::unordered_set<std::string> visited{id};
+  std::string target = id;
+  size_t next = out->size();
+  while (true) {
+    for (const auto& [follower_id, binding] : bindings_) {
+      if (binding.target_id != target) continue;
+      if (hidden_followers_.count(follower_id)) continue;
+      if (!visited.insert(follower_id).second) continue;
+      out->push_back(follower_id);
+    }
+    if (next == out->size()) break;
+    target = (*out)[next++];
+  }
+  // The group moves with the dragged palette; its indexed frames are stale
+  // for the rest of the drag.
+  drag_group_ = std::move(visited);
+}
+
+// Bindings
+
+void SnapService::Emit(const char* service,
+                       const char* event,
+                       const std::string& id,
+                       flutter::EncodableMap data) {
+  if (event_sink_) event_sink_(service, event, &id, data);
+}
+
+std::vector<SnapService::SnapBinding> SnapService::BindingsTargeting(
+    const std::string& target_id) {
+  std::vector<SnapBinding> out;
+  for (const auto& [follower_id, binding] : bindings_) {
+    if (binding.target_id == target_id) out.push_back(binding);
+  }
+  return out;
+}
+
+bool SnapService::CalculateSnapPosition(const SnapBinding& binding,
+                                        POINT* out) const {
+  PaletteWindow* target = WindowStore::Instance().Get(binding.target_id);
+  PaletteWindow* follower = WindowStore::Instance().Get(binding.follower_id);
+  FrameSnapshot target_frame, follower_frame;
+  if (!target || !follower || !target->frame.Load(&target_frame) ||
+      !follower->frame.Load(&follower_frame)) {
+    return false;
+  }
+  const RECT& t = target_frame.physical;
+  const RECT& f = follower_frame.physical;
+
+  const LONG width = f.right - f.left;
+  const LONG height = f.bottom - f.top;
+  const LONG gap =
+      static_cast<LONG>(std::lround(binding.gap * target_frame.dpi / 96.0));
+  LONG x = f.left;
+  LONG y = f.top;
+
+  // Screen y grows downward: a follower's top edge sits on the target's
+  // bottom edge.
+  if (binding.follower_edge == SnapEdge::kTop &&
+      binding.target_edge == SnapEdge::kBottom) {
+    y = t.bottom + gap;
+  } else if (binding.follower_edge == SnapEdge::kBottom &&
+             binding.target_edge == SnapEdge::kTop) {
+    y = t.top - height - gap;
+  } else if (binding.follower_edge == SnapEdge::kLeft &&
+             binding.target_edge == SnapEdge::kRight) {
+    x = t.right + gap;
+  } else if (binding.follower_edge == SnapEdge::kRight &&
+             binding.target_edge == SnapEdge::kLeft) {
+    x = t.left - width - gap;
+  }
+
+  bool vertical = binding.follower_edge == SnapEdge::kTop ||
+                  binding.follower_edge == SnapEdge::kBottom;
+  if (vertical) {
+    if (binding.alignment == "leading") {
+      x = t.left;
+    } else if (binding.alignment == "trailing") {
+      x = t.right - width;
+    } else {
+      x = (t.left + t.right) / 2 - width / 2;
+    }
+  } else {
+    if (binding.alignment == "leading") {
+      y = t.top;
+    } else if (binding.alignment == "trailing") {
+      y = t.bottom - height;
+    } else {
+      y = (t.top + t.bottom) / 2 - height / 2;
+    }
+  }
+
+  // Keep the follower on the target's monitor.
+  const auto topology = MonitorTopology::Instance().Current();
+  int index = topology->IndexForRect(t);
+  if (index >= 0) {
+    const RECT& work = topology->monitors[index].work_area;
+    x = std::max(work.left, std::min(x, work.right - width));
+    y = std::max(work.top, std::min(y, work.bottom - height));
+  }
+  *out = POINT{x, y};
+  return true;
+}
+
+void SnapService::PositionFollower(const SnapBinding& binding) {
+  POINT position;
+  if (!CalculateSnapPosition(binding, &position)) return;
+  PaletteWindow* follower = WindowStore::Instance().Get(binding.follower_id);
+  SetWindowPos(follower->hwnd, nullptr, position.x, position.y, 0, 0,
+               SWP_NOSIZE | SWP_NOZORDER | SWP_NOOWNERZORDER |
+                   SWP_NOACTIVATE);
+  Metrics::Instance().RecordWindowPos();
+  trace::SnapFollowerMoved(binding.follower_id, position.x, position.y);
+}
+
+double SnapService::SnapDistance(const SnapBinding& binding,
+                                 const RECT& frame) const {
+  POINT position;
+  if (!CalculateSnapPosition(binding, &position)) return 0;
+  PaletteWindow* follower = WindowStore::Instance().Get(binding.follower_id);
+  FrameSnapshot snapshot;
+  double scale = follower && follower->frame.Load(&snapshot)
+                     ? snapshot.dpi / 96.0
+                     : 1.0;
+  return std::hypot(frame.left - position.x, frame.top - position.y) / scale;
+}
+
+void SnapService::Bind(SnapBinding binding) {
+  std::string follower_id = binding.follower_id;
+  std::string target_id = binding.target_id;
+  auto& stored = bindings_[follower_id] = std::move(binding);
+  if (proximity_ && proximity_->dragged_id == follower_id) proximity_.reset();
+  PositionFollower(stored);
+  Emit("snap", "snapped", follower_id,
+       flutter::EncodableMap{
+           {flutter::EncodableValue("targetId"),
+            flutter::EncodableValue(target_id)},
+       });
+}
+
+void SnapService::DetachFollower(const std::string& follower_id) {
+  bindings_.erase(follower_id);
+  hidden_followers_.erase(follower_id);
+}
+
+bool SnapService::InDetachCooldown(WindowHandle handle) const {
+  const double* detached_at = detached_at_.Find(handle);
+  return detached_at &&
+         MonotonicSeconds() - *detached_at < kDetachCooldownSeconds;
+}
+
+void SnapService::HandleFollowerDrag(const SnapBinding& binding,
+                                     const RECT& frame) {
+  double distance = SnapDistance(binding, frame);
+  std::string follower_id = binding.follower_id;
+  if (EventFilter::Instance().Wants("snap", "followerDragging",
+                                    &follower_id)) {
+    const auto& store = WindowStore::Instance();
+    const bool sent =
+        binary_channel_ &&
+        binary_channel_->SendFollowerDragging(
+            store.Get(follower_id), store.Get(binding.target_id), distance,
+            frame, drag_scale_);
+    if (!sent) {
+      Emit("snap", "followerDragging", follower_id,
+           flutter::EncodableMap{
+               {flutter::EncodableValue("targetId"),
+                flutter::EncodableValue(binding.target_id)},
+               {flutter::EncodableValue("snapDistance"),
+                flutter::EncodableValue(distance)},
+               {flutter::EncodableValue("frame"),
+                flutter::EncodableValue(FrameToMap(frame, drag_scale_))},
+           });
+    }
+  }
+  if (distance <= kDetachThreshold) return;
+
+  DetachFollower(follower_id);
+  Emit("snap", "detached", follower_id,
+       flutter::EncodableMap{
+           {flutter::EncodableValue("reason"),
+            flutter::EncodableValue("draggedAway")},
+       });
+  if (proximity_ && proximity_->dragged_id == follower_id) proximity_.reset();
+  if (drag_handle_ != kInvalidWindowHandle) {
+    detached_at_[drag_handle_] = MonotonicSeconds();
+  }
+}
+
+void SnapService::ShowFollower(const std::string& id, bool show) {
+  PaletteWindow* window = WindowStore::Instance().Get(id);
+  if (!window || !window->hwnd) return;
+  if (show) {
+    EngineHibernation::Instance().Wake(*window);
+    ShowWindow(window->hwnd, SW_SHOWNOACTIVATE);
+    RevealPipeline::SetCloaked(*window, false);
+  } else {
+    RevealPipeline::Instance().Hide(*window);
+  }
+  Emit("visibility", show ? "shown" : "hidden", id, flutter::EncodableMap{});
+}
+
+void SnapService::HandleTargetHidden(const SnapBinding& binding) {
+  if (binding.on_target_hidden == "hideFollower") {
+    hidden_followers_.insert(binding.follower_id);
+    ShowFollower(binding.follower_id, false);
+  } else if (binding.on_target_hidden == "detach") {
+    DetachFollower(binding.follower_id);
+    Emit("snap", "detached", binding.follower_id,
+         flutter::EncodableMap{
+             {flutter::EncodableValue("reason"),
+              flutter::EncodableValue("targetHidden")},
+         });
+  }
+  // keepBinding: nothing to do until the target is shown again.
+}
+
+void SnapService::HandleTargetDestroyed(const SnapBinding& binding) {
+  if (binding.on_target_destroyed != "hideAndDetach" &&
+      binding.on_target_destroyed != "detach") {
+    return;
+  }
+  if (binding.on_target_destroyed == "hideAndDetach") {
+    ShowFollower(binding.follower_id, false);
+  }
+  DetachFollower(binding.follower_id);
+  Emit("snap", "detached", binding.follower_id,
+       flutter::EncodableMap{
+           {flutter::EncodableValue("reason"),
+            flutter::EncodableValue("targetDestroyed")},
+       });
+}
+
+// Proximity
+
+void SnapService::RebuildIndexIfDirty() {
+  if (!index_dirty_) return;
+  index_dirty_ = false;
+
+  std::vector<SnapIndex::Target> targets;
+  targets.reserve(auto_snap_configs_.size());
+  for (const auto& [id, config] : auto_snap_configs_) {
+    if (!config.accepts_snap_on) continue;
+    PaletteWindow* window = WindowStore::Instance().Get(id);
+    if (!window || !RevealPipeline::IsShown(*window)) continue;
+    FrameSnapshot frame;
+    if (!window->frame.Load(&frame)) continue;
+    SnapIndex::Target target;
+    target.frame = frame.physical;
+    target.id = id;
+    target.accepts = config.accepts_snap_on;
+    targets.push_back(std::move(target));
+  }
+  index_.Rebuild(std::move(targets));
+  FP_LOG("Snap", "index rebuilt: ", index_.size(), " targets");
+}
+
+void SnapService::CheckProximity(const std::string& dragged_id,
+                                 const RECT& frame) {
+  auto config_it = auto_snap_configs_.find(dragged_id);
+  if (config_it == auto_snap_configs_.end() ||
+      !config_it->second.can_snap_from) {
+    ExitProximity(dragged_id);
+    return;
+  }
+  const AutoSnapConfig& config = config_it->second;
+
+  RebuildIndexIfDirty();
+  SnapIndex::Match match;
+  LONG threshold =
+      static_cast<LONG>(config.proximity_threshold * drag_scale_ + 0.5);
+  bool found = index_.FindNearest(
+      frame, config.can_snap_from, threshold, drag_group_,
+      config.target_ids ? &*config.target_ids : nullptr, &match);
+  if (!found) {
+    ExitProximity(dragged_id);
+    return;
+  }
+
+  double distance = match.distance / drag_scale_;
+  if (proximity_ && proximity_->dragged_id == dragged_id &&
+      proximity_->target_id == *match.target_id &&
+      proximity_->dragged_edge == match.dragged_edge &&
+      proximity_->target_edge == match.target_edge) {
+    if (!EventFilter::Instance().Wants("snap", "proximityUpdated",
+                                       &dragged_id)) {
+      return;
+    }
+    Emit("snap", "proximityUpdated", dragged_id,
+         flutter::EncodableMap{
+             {flutter::EncodableValue("targetId"),
+              flutter::EncodableValue(*match.target_id)},
+             {flutter::EncodableValue("distance"),
+              flutter::EncodableValue(distance)},
+         });
+    return;
+  }
+
+  ExitProximity(dragged_id);
+  proximity_ = ProximityState{dragged_id, *match.target_id,
+                              match.dragged_edge, match.target_edge};
+  Emit("snap", "proximityEntered", dragged_id,
+       flutter::EncodableMap{
+           {flutter::EncodableValue("targetId"),
+            flutter::EncodableValue(*match.target_id)},
+           {flutter::EncodableValue("draggedEdge"),
+            flutter::EncodableValue(SnapEdgeName(match.dragged_edge))},
+           {flutter::EncodableValue("targetEdge"),
+            flutter::EncodableValue(SnapEdgeName(match.target_edge))},
+           {flutter::EncodableValue("distance"),
+            flutter::EncodableValue(distance)},
+       });
+}
+
+void SnapService::ExitProximity(const std::string& id) {
+  if (!proximity_ || proximity_->dragged_id != id) return;
+  ProximityState exited = std::move(*proximity_);
+  proximity_.reset();
+  Emit("snap", "proximityExited", exited.dragged_id,
+       flutter::EncodableMap{
+           {flutter::EncodableValue("targetId"),
+            flutter::EncodableValue(exited.target_id)},
+       });
 }
 
 // Commands
@@ -52,35 +552,164 @@ void SnapService::Snap(
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  FP_LOG("Snap", "snap stub");
+  const std::string* follower_id = GetString(params, "followerId");
+  const std::string* target_id = GetString(params, "targetId");
+  const std::string* follower_edge = GetString(params, "followerEdge");
+  const std::string* target_edge = GetString(params, "targetEdge");
+  if (!follower_id || !target_id || !follower_edge || !target_edge) {
+    result->Error("INVALID_PARAMS",
+                  "followerId, targetId, followerEdge, targetEdge required");
+    return;
+  }
+  if (*follower_id == *target_id) {
+    result->Error("INVALID_PARAMS", "Cannot snap a palette to itself");
+    return;
+  }
+  SnapBinding binding;
+  if (!ParseSnapEdge(*follower_edge, &binding.follower_edge) ||
+      !ParseSnapEdge(*target_edge, &binding.target_edge)) {
+    result->Error("INVALID_PARAMS", "Invalid edge: followerEdge=" +
+                                        *follower_edge +
+                                        ", targetEdge=" + *target_edge);
+    return;
+  }
+  if (!WindowStore::Instance().Exists(*follower_id) ||
+      !WindowStore::Instance().Exists(*target_id)) {
+    result->Error("NOT_FOUND", "Window not found: follower=" + *follower_id +
+                                   ", target=" + *target_id);
+    return;
+  }
+
+  binding.follower_id = *follower_id;
+  binding.target_id = *target_id;
+  const std::string* alignment = GetString(params, "alignment");
+  binding.alignment = alignment ? *alignment : "center";
+  binding.gap = GetDouble(params, "gap").value_or(0);
+  binding.on_target_hidden = "hideFollower";
+  binding.on_target_destroyed = "hideAndDetach";
+  if (const auto* config_value = FindParam(params, "config")) {
+    if (const auto* config = std::get_if<flutter::EncodableMap>(config_value)) {
+      if (const auto* hidden = GetString(*config, "onTargetHidden")) {
+        binding.on_target_hidden = *hidden;
+      }
+      if (const auto* destroyed = GetString(*config, "onTargetDestroyed")) {
+        binding.on_target_destroyed = *destroyed;
+      }
+    }
+  }
+  Bind(std::move(binding));
   result->Success(flutter::EncodableValue());
 }
 
 void SnapService::Detach(
     const std::string* window_id,
+    const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  FP_LOG("Snap", "detach stub");
+  const std::string* follower_id = FollowerId(window_id, params);
+  if (!follower_id) {
+    result->Error("INVALID_PARAMS", "followerId required");
+    return;
+  }
+  DetachFollower(*follower_id);
+  Emit("snap", "detached", *follower_id,
+       flutter::EncodableMap{
+           {flutter::EncodableValue("reason"),
+            flutter::EncodableValue("command")},
+       });
   result->Success(flutter::EncodableValue());
 }
 
 void SnapService::ReSnap(
     const std::string* window_id,
+    const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  FP_LOG("Snap", "reSnap stub");
+  const std::string* follower_id = FollowerId(window_id, params);
+  auto it = follower_id ? bindings_.find(*follower_id) : bindings_.end();
+  if (it == bindings_.end()) {
+    result->Error("NOT_FOUND", "No binding for follower");
+    return;
+  }
+  PositionFollower(it->second);
+  Emit("snap", "snapped", *follower_id,
+       flutter::EncodableMap{
+           {flutter::EncodableValue("targetId"),
+            flutter::EncodableValue(it->second.target_id)},
+       });
   result->Success(flutter::EncodableValue());
 }
 
 void SnapService::GetSnapDistance(
     const std::string* window_id,
+    const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  result->Success(flutter::EncodableValue(0.0));
+  const std::string* follower_id = FollowerId(window_id, params);
+  auto it = follower_id ? bindings_.find(*follower_id) : bindings_.end();
+  PaletteWindow* follower =
+      follower_id ? WindowStore::Instance().Get(*follower_id) : nullptr;
+  FrameSnapshot frame;
+  if (it == bindings_.end() || !follower || !follower->frame.Load(&frame)) {
+    result->Error("NOT_FOUND", "No binding for follower");
+    return;
+  }
+  result->Success(
+      flutter::EncodableValue(SnapDistance(it->second, frame.physical)));
 }
 
 void SnapService::SetAutoSnapConfig(
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  FP_LOG("Snap", "setAutoSnapConfig stub");
+  const std::string* palette_id = GetString(params, "paletteId");
+  if (!palette_id) palette_id = window_id;
+  const auto* config_value = FindParam(params, "config");
+  const auto* config_map =
+      config_value ? std::get_if<flutter::EncodableMap>(config_value)
+                   : nullptr;
+  if (!palette_id || !config_map) {
+    result->Error("INVALID_PARAMS", "paletteId and config required");
+    return;
+  }
+
+  auto edges = [config_map](const char* key) {
+    SnapEdgeMask mask = 0;
+    const auto* list_value = FindParam(*config_map, key);
+    const auto* list =
+        list_value ? std::get_if<flutter::EncodableList>(list_value)
+                   : nullptr;
+    if (!list) return mask;
+    for (const auto& item : *list) {
+      SnapEdge edge;
+      const auto* name = std::get_if<std::string>(&item);
+      if (name && ParseSnapEdge(*name, &edge)) mask |= EdgeBit(edge);
+    }
+    return mask;
+  };
+
+  AutoSnapConfig config;
+  config.accepts_snap_on = edges("acceptsSnapOn");
+  config.can_snap_from = edges("canSnapFrom");
+  if (const auto* ids_value = FindParam(*config_map, "targetIds")) {
+    if (const auto* ids = std::get_if<flutter::EncodableList>(ids_value)) {
+      config.target_ids.emplace();
+      for (const auto& item : *ids) {
+        if (const auto* id = std::get_if<std::string>(&item)) {
+          config.target_ids->insert(*id);
+        }
+      }
+    }
+  }
+  config.proximity_threshold =
+      GetDouble(*config_map, "proximityThreshold").value_or(50);
+  config.show_feedback = GetBool(*config_map, "showFeedback").value_or(true);
+
+  // Effectively disabled configs are removed.
+  if (!config.accepts_snap_on && !config.can_snap_from) {
+    auto_snap_configs_.erase(*palette_id);
+    ExitProximity(*palette_id);
+  } else {
+    auto_snap_configs_[*palette_id] = std::move(config);
+  }
+  InvalidateIndex();
   result->Success(flutter::EncodableValue());
 }
 
@@ -4,41 +4,148 @@
 #include <flutter/standard_method_codec.h>
 
 #include <memory>
+#include <optional>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "../coordinators/drag_coordinator.h"
+#include "../core/slot_array.h"
+#include "../core/snap_index.h"
 #include "../core/window_store.h"
 
 namespace floating_palette {
 
+class BinaryChannel;
+
 class SnapService : public DragCoordinatorDelegate {
  public:
   void SetEventSink(EventSink sink) { event_sink_ = std::move(sink); }
-  void Handle(const std::string& command,
+  /// Where followerDragging goes when both windows are bound to it.
+  void SetBinaryChannel(BinaryChannel* channel) { binary_channel_ = channel; }
+  bool Handle(const std::string& command,
               const std::string* window_id,
               const flutter::EncodableMap& params,
               std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
 
+  /// The window's binding as a follower, in snap command params
+  /// ({targetId, followerEdge, targetEdge, alignment, gap, config}), or
+  /// null if it isn't snapped. For HostService::GetSnapshot.
+  flutter::EncodableValue SnapLinkFor(const std::string& follower_id) const;
+
   // Called by VisibilityService when windows show/hide
   void OnWindowShown(const std::string& id);
   void OnWindowHidden(const std::string& id);
+  // Called by FrameService after programmatic moves/resizes
+  void OnWindowsMoved(const std::vector<std::string>& ids);
+  // Called by WindowService before a window is destroyed
+  void OnWindowDestroyed(const std::string& id);
 
   // DragCoordinatorDelegate
   void DragBegan(const std::string& id) override;
   void DragMoved(const std::string& id, const RECT& frame) override;
   void DragEnded(const std::string& id, const RECT& frame) override;
+  void CollectFollowers(const std::string& id,
+                        std::vector<std::string>* out) override;
 
  private:
+  /// A follower kept against one edge of its target. There are no OS-level
+  /// child windows to lean on (owned windows don't move with their owner),
+  /// so followers are positioned here and dragged as a group by
+  /// DragCoordinator.
+  struct SnapBinding {
+    std::string follower_id;
+    std::string target_id;
+    SnapEdge follower_edge;
+    SnapEdge target_edge;
+    std::string alignment;  // leading, center, trailing
+    /// Logical pixels.
+    double gap = 0;
+    std::string on_target_hidden;
+    std::string on_target_destroyed;
+  };
+
+  struct AutoSnapConfig {
+    SnapEdgeMask accepts_snap_on = 0;
+    SnapEdgeMask can_snap_from = 0;
+    /// Empty optional means any palette.
+    std::optional<std::unordered_set<std::string>> target_ids;
+    /// Logical pixels.
+    double proximity_threshold = 50;
+    bool show_feedback = true;
+  };
+
+  struct ProximityState {
+    std::string dragged_id;
+    std::string target_id;
+    SnapEdge dragged_edge;
+    SnapEdge target_edge;
+  };
+
+  /// Auto-detach distance for a dragged follower, and how long after a
+  /// detach it can't auto-snap again.
+  static constexpr double kDetachThreshold = 50;
+  static constexpr double kDetachCooldownSeconds = 0.3;
+
   EventSink event_sink_;
+  BinaryChannel* binary_channel_ = nullptr;
+  /// Keyed by follower id.
+  std::unordered_map<std::string, SnapBinding> bindings_;
+  std::unordered_set<std::string> hidden_followers_;
+  /// MonotonicSeconds of each palette's last detach as a follower. Checked
+  /// every drag tick, so indexed by slot rather than hashed by id.
+  SlotArray<double> detached_at_;
+  std::unordered_map<std::string, AutoSnapConfig> auto_snap_configs_;
+  std::optional<ProximityState> proximity_;
+
+  /// Frames of visible palettes that accept snaps. Marked dirty on
+  /// show / hide / move-end / config changes and rebuilt on the next drag,
+  /// so drag ticks only query it.
+  SnapIndex index_;
+  bool index_dirty_ = true;
+  /// The palette being dragged and its DPI scale, sampled at DragBegan.
+  WindowHandle drag_handle_ = kInvalidWindowHandle;
+  double drag_scale_ = 1.0;
+  /// The dragged palette and the followers moving with it; excluded from
+  /// proximity queries.
+  std::unordered_set<std::string> drag_group_;
+
+  void InvalidateIndex() { index_dirty_ = true; }
+  void RebuildIndexIfDirty();
+  void CheckProximity(const std::string& dragged_id, const RECT& frame);
+  /// Emit proximityExited and forget the state if it belongs to `id`.
+  void ExitProximity(const std::string& id);
+  bool InDetachCooldown(WindowHandle handle) const;
+
+  /// Where the follower's top-left belongs, in physical pixels.
+  bool CalculateSnapPosition(const SnapBinding& binding, POINT* out) const;
+  void PositionFollower(const SnapBinding& binding);
+  /// Logical distance from the follower's top-left to its snap position.
+  double SnapDistance(const SnapBinding& binding, const RECT& frame) const;
+  void DetachFollower(const std::string& follower_id);
+  void HandleFollowerDrag(const SnapBinding& binding, const RECT& frame);
+  void HandleTargetHidden(const SnapBinding& binding);
+  void HandleTargetDestroyed(const SnapBinding& binding);
+  /// Bindings whose target is `target_id` (copies; handlers may detach).
+  std::vector<SnapBinding> BindingsTargeting(const std::string& target_id);
+  /// Binding, reposition and "snapped" event.
+  void Bind(SnapBinding binding);
+  void ShowFollower(const std::string& id, bool show);
+  void Emit(const char* service, const char* event, const std::string& id,
+            flutter::EncodableMap data);
 
   void Snap(const std::string* window_id,
             const flutter::EncodableMap& params,
             std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
   void Detach(const std::string* window_id,
+              const flutter::EncodableMap& params,
               std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
   void ReSnap(const std::string* window_id,
+              const flutter::EncodableMap& params,
               std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
   void GetSnapDistance(const std::string* window_id,
+                       const flutter::EncodableMap& params,
                        std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
   void SetAutoSnapConfig(const std::string* window_id,
                          const flutter::EncodableMap& params,
@@ -1,72 +1,192 @@
 #include "transform_service.h"
 
-#include "../core/logger.h"
+#include "../core/animation_curve.h"
+#include "../core/command_hash.h"
+#include "../core/param_utils.h"
 
 namespace floating_palette {
 
-void TransformService::Handle(
+bool TransformService::Handle(
     const std::string& command,
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  if (command == "setScale") {
-    SetScale(window_id, params, std::move(result));
-  } else if (command == "setRotation") {
-    SetRotation(window_id, params, std::move(result));
-  } else if (command == "setFlip") {
-    SetFlip(window_id, params, std::move(result));
-  } else if (command == "reset") {
-    Reset(window_id, std::move(result));
-  } else if (command == "getScale") {
-    GetScale(window_id, std::move(result));
-  } else if (command == "getRotation") {
-    GetRotation(window_id, std::move(result));
-  } else {
-    result->Error("UNKNOWN_COMMAND", "Unknown transform command: " + command);
+  switch (HashCommand(command)) {
+    case HashCommand("setScale"):
+      if (command != "setScale") break;
+      SetScale(window_id, params, std::move(result));
+      return true;
+    case HashCommand("setRotation"):
+      if (command != "setRotation") break;
+      SetRotation(window_id, params, std::move(result));
+      return true;
+    case HashCommand("setFlip"):
+      if (command != "setFlip") break;
+      SetFlip(window_id, params, std::move(result));
+      return true;
+    case HashCommand("reset"):
+      if (command != "reset") break;
+      Reset(window_id, params, std::move(result));
+      return true;
+    case HashCommand("getScale"):
+      if (command != "getScale") break;
+      GetScale(window_id, std::move(result));
+      return true;
+    case HashCommand("getRotation"):
+      if (command != "getRotation") break;
+      GetRotation(window_id, std::move(result));
+      return true;
+    case HashCommand("getFlip"):
+      if (command != "getFlip") break;
+      GetFlip(window_id, std::move(result));
+      return true;
   }
+  result->Error("UNKNOWN_COMMAND", "Unknown transform command: " + command);
+  return false;
 }
 
 void TransformService::SetScale(
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  FP_LOG("Transform", "setScale stub");
-  result->Success(flutter::EncodableValue());
+  auto* window = window_id ? WindowStore::Instance().Get(*window_id) : nullptr;
+  if (!window || !window->hwnd) {
+    result->Error("NOT_FOUND", "Window not found");
+    return;
+  }
+  auto scale = GetDouble(params, "scale");
+  if (!scale || *scale < 0) {
+    result->Error("INVALID_PARAMS", "scale (non-negative) required");
+    return;
+  }
+  CompositionLayer::Transform transform = window->composition.transform();
+  transform.scale = *scale;
+  transform.anchor_x = GetDouble(params, "anchorX").value_or(0.0);
+  transform.anchor_y = GetDouble(params, "anchorY").value_or(0.0);
+  Apply(*window, transform, params, "scaled",
+        flutter::EncodableMap{
+            {flutter::EncodableValue("x"), flutter::EncodableValue(*scale)},
+            {flutter::EncodableValue("y"), flutter::EncodableValue(*scale)},
+        },
+        std::move(result));
 }
 
 void TransformService::SetRotation(
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  FP_LOG("Transform", "setRotation stub");
-  result->Success(flutter::EncodableValue());
+  auto* window = window_id ? WindowStore::Instance().Get(*window_id) : nullptr;
+  if (!window || !window->hwnd) {
+    result->Error("NOT_FOUND", "Window not found");
+    return;
+  }
+  auto degrees = GetDouble(params, "degrees");
+  if (!degrees) {
+    result->Error("INVALID_PARAMS", "degrees required");
+    return;
+  }
+  CompositionLayer::Transform transform = window->composition.transform();
+  transform.degrees = *degrees;
+  transform.anchor_x = GetDouble(params, "anchorX").value_or(0.0);
+  transform.anchor_y = GetDouble(params, "anchorY").value_or(0.0);
+  Apply(*window, transform, params, "rotated",
+        flutter::EncodableMap{
+            {flutter::EncodableValue("degrees"),
+             flutter::EncodableValue(*degrees)},
+        },
+        std::move(result));
 }
 
 void TransformService::SetFlip(
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  FP_LOG("Transform", "setFlip stub");
-  result->Success(flutter::EncodableValue());
+  auto* window = window_id ? WindowStore::Instance().Get(*window_id) : nullptr;
+  if (!window || !window->hwnd) {
+    result->Error("NOT_FOUND", "Window not found");
+    return;
+  }
+  bool horizontal = GetBool(params, "horizontal").value_or(false);
+  bool vertical = GetBool(params, "vertical").value_or(false);
+  CompositionLayer::Transform transform = window->composition.transform();
+  transform.flip_horizontal = horizontal;
+  transform.flip_vertical = vertical;
+  Apply(*window, transform, params, "flipped",
+        flutter::EncodableMap{
+            {flutter::EncodableValue("horizontal"),
+             flutter::EncodableValue(horizontal)},
+            {flutter::EncodableValue("vertical"),
+             flutter::EncodableValue(vertical)},
+        },
+        std::move(result));
 }
 
 void TransformService::Reset(
     const std::string* window_id,
+    const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  FP_LOG("Transform", "reset stub");
-  result->Success(flutter::EncodableValue());
+  auto* window = window_id ? WindowStore::Instance().Get(*window_id) : nullptr;
+  if (!window || !window->hwnd) {
+    result->Error("NOT_FOUND", "Window not found");
+    return;
+  }
+  CompositionLayer::Transform transform;
+  transform.anchor_x = window->composition.transform().anchor_x;
+  transform.anchor_y = window->composition.transform().anchor_y;
+  Apply(*window, transform, params, "reset", flutter::EncodableMap{},
+        std::move(result));
 }
 
 void TransformService::GetScale(
     const std::string* window_id,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  result->Success(flutter::EncodableValue(1.0));
+  auto* window = window_id ? WindowStore::Instance().Get(*window_id) : nullptr;
+  result->Success(flutter::EncodableValue(
+      window ? window->composition.transform().scale : 1.0));
 }
 
 void TransformService::GetRotation(
     const std::string* window_id,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  result->Success(flutter::EncodableValue(0.0));
+  auto* window = window_id ? WindowStore::Instance().Get(*window_id) : nullptr;
+  result->Success(flutter::EncodableValue(
+      window ? window->composition.transform().degrees : 0.0));
+}
+
+void TransformService::GetFlip(
+    const std::string* window_id,
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  auto* window = window_id ? WindowStore::Instance().Get(*window_id) : nullptr;
+  const bool horizontal =
+      window && window->composition.transform().flip_horizontal;
+  const bool vertical = window && window->composition.transform().flip_vertical;
+  result->Success(flutter::EncodableValue(flutter::EncodableMap{
+      {flutter::EncodableValue("horizontal"),
+       flutter::EncodableValue(horizontal)},
+      {flutter::EncodableValue("vertical"), flutter::EncodableValue(vertical)},
+  }));
+}
+
+void TransformService::Apply(
+    PaletteWindow& window,
+    const CompositionLayer::Transform& transform,
+    const flutter::EncodableMap& params,
+    const char* event,
+    flutter::EncodableMap data,
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  int duration_ms = 0;
+  if (GetBool(params, "animate").value_or(false)) {
+    duration_ms = static_cast<int>(GetInt(params, "durationMs").value_or(200));
+  }
+  const std::string* curve = GetString(params, "curve");
+  if (!window.composition.SetTransform(
+          window, transform, duration_ms,
+          curve ? ParseAnimationCurve(*curve) : AnimationCurve::kEaseInOut)) {
+    result->Error("UNSUPPORTED", "DirectComposition is unavailable");
+    return;
+  }
+  if (event_sink_) event_sink_("transform", event, &window.id, data);
+  result->Success(flutter::EncodableValue());
 }
 
 }  // namespace floating_palette
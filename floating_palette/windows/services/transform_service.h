@@ -10,10 +10,17 @@
 
 namespace floating_palette {
 
+/// Scale, rotation and flip, composited by DWM (see CompositionLayer): the
+/// panel and the Flutter viewport keep their size, so a transform or its
+/// animation never makes the palette engine lay out or render.
+///
+/// Commands take `animate`, `durationMs` (default 200) and `curve`; the
+/// "scaled" / "rotated" / "flipped" / "reset" event carries the target
+/// state as soon as it is applied.
 class TransformService {
  public:
   void SetEventSink(EventSink sink) { event_sink_ = std::move(sink); }
-  void Handle(const std::string& command,
+  bool Handle(const std::string& command,
               const std::string* window_id,
               const flutter::EncodableMap& params,
               std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
@@ -31,11 +38,22 @@ class TransformService {
                const flutter::EncodableMap& params,
                std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
   void Reset(const std::string* window_id,
+             const flutter::EncodableMap& params,
              std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
   void GetScale(const std::string* window_id,
                 std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
   void GetRotation(const std::string* window_id,
                    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+  void GetFlip(const std::string* window_id,
+               std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+
+  /// Apply `transform` to the window, answer `result` and emit `event`.
+  void Apply(PaletteWindow& window,
+             const CompositionLayer::Transform& transform,
+             const flutter::EncodableMap& params,
+             const char* event,
+             flutter::EncodableMap data,
+             std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
 };
 
 }  // namespace floating_palette
@@ -1,75 +1,202 @@
 #include "visibility_service.h"
 
+#include <algorithm>
+#include <cmath>
+
+#include "../core/animation_curve.h"
+#include "../core/command_hash.h"
 #include "../core/logger.h"
+#include "../core/param_utils.h"
+#include "../core/reveal_pipeline.h"
+#include "snap_service.h"
 
 namespace floating_palette {
 
-void VisibilityService::Handle(
+VisibilityService::VisibilityService() {
+  RevealPipeline::Instance().SetListener(
+      [this](PaletteWindow& window) { Reveal(window.id); });
+}
+
+VisibilityService::~VisibilityService() {
+  RevealPipeline::Instance().SetListener(nullptr);
+}
+
+bool VisibilityService::Handle(
     const std::string& command,
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  if (command == "show") {
-    Show(window_id, params, std::move(result));
-  } else if (command == "hide") {
-    Hide(window_id, params, std::move(result));
-  } else if (command == "setOpacity") {
-    SetOpacity(window_id, params, std::move(result));
-  } else if (command == "getOpacity") {
-    GetOpacity(window_id, std::move(result));
-  } else if (command == "reveal") {
-    DoReveal(window_id, std::move(result));
-  } else {
-    result->Error("UNKNOWN_COMMAND",
-                  "Unknown visibility command: " + command);
+  switch (HashCommand(command)) {
+    case HashCommand("show"):
+      if (command != "show") break;
+      Show(window_id, params, std::move(result));
+      return true;
+    case HashCommand("hide"):
+      if (command != "hide") break;
+      Hide(window_id, params, std::move(result));
+      return true;
+    case HashCommand("isVisible"):
+      if (command != "isVisible") break;
+      IsVisible(window_id, std::move(result));
+      return true;
+    case HashCommand("setOpacity"):
+      if (command != "setOpacity") break;
+      SetOpacity(window_id, params, std::move(result));
+      return true;
+    case HashCommand("getOpacity"):
+      if (command != "getOpacity") break;
+      GetOpacity(window_id, std::move(result));
+      return true;
+    case HashCommand("reveal"):
+      if (command != "reveal") break;
+      DoReveal(window_id, std::move(result));
+      return true;
   }
+  result->Error("UNKNOWN_COMMAND", "Unknown visibility command: " + command);
+  return false;
 }
 
 void VisibilityService::Reveal(const std::string& window_id) {
-  // TODO: Implement show-after-sized reveal pattern
-  FP_LOG("Visibility", "reveal stub: " + window_id);
+  PaletteWindow* window = WindowStore::Instance().Get(window_id);
+  if (!window || !window->hwnd) return;
+  if (window->should_focus) {
+    SetForegroundWindow(window->hwnd);
+    SetFocus(window->hwnd);
+  }
+  if (event_sink_) {
+    event_sink_("visibility", "shown", &window_id, flutter::EncodableMap{});
+  }
+  if (snap_service_) snap_service_->OnWindowShown(window_id);
 }
 
 void VisibilityService::Show(
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  // TODO: Show window with ShowWindow/SetWindowPos
-  FP_LOG("Visibility", "show stub");
+  auto* window = window_id ? WindowStore::Instance().Get(*window_id) : nullptr;
+  if (!window || !window->hwnd) {
+    result->Error("NOT_FOUND", "Window not found");
+    return;
+  }
+  ShowPalette(*window, GetBool(params, "focus").value_or(true), false);
   result->Success(flutter::EncodableValue());
 }
 
+void VisibilityService::ShowPalette(PaletteWindow& window, bool focus,
+                                    bool warm) {
+  window.should_focus = focus;
+  // "shown" follows once the first sized frame is on screen.
+  if (!RevealPipeline::IsShown(window) || window.is_pending_reveal) {
+    if (warm) {
+      RevealPipeline::Instance().BeginWarm(window);
+    } else {
+      RevealPipeline::Instance().Begin(window);
+    }
+  } else if (window.should_focus) {
+    SetForegroundWindow(window.hwnd);
+  }
+}
+
 void VisibilityService::Hide(
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  // TODO: Hide window
-  FP_LOG("Visibility", "hide stub");
+  auto* window = window_id ? WindowStore::Instance().Get(*window_id) : nullptr;
+  if (!window || !window->hwnd) {
+    result->Error("NOT_FOUND", "Window not found");
+    return;
+  }
+  HidePalette(*window);
   result->Success(flutter::EncodableValue());
 }
 
+void VisibilityService::HidePalette(PaletteWindow& window) {
+  RevealPipeline::Instance().Hide(window);
+  FP_LOG("Visibility", "hidden: ", window.id);
+  if (event_sink_) {
+    event_sink_("visibility", "hidden", &window.id, flutter::EncodableMap{});
+  }
+  if (snap_service_) snap_service_->OnWindowHidden(window.id);
+}
+
+void VisibilityService::IsVisible(
+    const std::string* window_id,
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  auto* window = window_id ? WindowStore::Instance().Get(*window_id) : nullptr;
+  result->Success(
+      flutter::EncodableValue(window && RevealPipeline::IsShown(*window)));
+}
+
 void VisibilityService::SetOpacity(
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  // TODO: Set window opacity via SetLayeredWindowAttributes
-  FP_LOG("Visibility", "setOpacity stub");
+  auto* window = window_id ? WindowStore::Instance().Get(*window_id) : nullptr;
+  if (!window || !window->hwnd) {
+    result->Error("NOT_FOUND", "Window not found");
+    return;
+  }
+  auto opacity = GetDouble(params, "opacity");
+  if (!opacity) {
+    result->Error("INVALID_PARAMS", "opacity required");
+    return;
+  }
+  const double value = std::clamp(*opacity, 0.0, 1.0);
+  int duration_ms = 0;
+  if (GetBool(params, "animate").value_or(false)) {
+    duration_ms = static_cast<int>(GetInt(params, "durationMs").value_or(200));
+  }
+  const std::string* curve = GetString(params, "curve");
+  // A DirectComposition fade runs entirely in DWM; see CompositionLayer.
+  if (!window->composition.SetOpacity(
+          *window, value, duration_ms,
+          curve ? ParseAnimationCurve(*curve) : AnimationCurve::kEaseInOut)) {
+    // No compositor: a constant layered alpha, never a per-pixel
+    // UpdateLayeredWindow copy of the surface. Not animated.
+    LONG ex_style = GetWindowLong(window->hwnd, GWL_EXSTYLE);
+    if (!(ex_style & WS_EX_LAYERED)) {
+      SetWindowLong(window->hwnd, GWL_EXSTYLE, ex_style | WS_EX_LAYERED);
+    }
+    SetLayeredWindowAttributes(window->hwnd, 0,
+                               static_cast<BYTE>(std::lround(value * 255.0)),
+                               LWA_ALPHA);
+  }
+  if (event_sink_) {
+    event_sink_("visibility", "opacityChanged", &window->id,
+                flutter::EncodableMap{
+                    {flutter::EncodableValue("opacity"),
+                     flutter::EncodableValue(value)},
+                });
+  }
   result->Success(flutter::EncodableValue());
 }
 
 void VisibilityService::GetOpacity(
     const std::string* window_id,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  // TODO: Get window opacity
-  result->Success(flutter::EncodableValue(1.0));
+  auto* window = window_id ? WindowStore::Instance().Get(*window_id) : nullptr;
+  if (!window || !window->hwnd) {
+    result->Success(flutter::EncodableValue(1.0));
+    return;
+  }
+  // The target of a running fade, like the transform getters.
+  double opacity = window->composition.transform().opacity;
+  BYTE alpha = 255;
+  DWORD flags = 0;
+  if ((GetWindowLong(window->hwnd, GWL_EXSTYLE) & WS_EX_LAYERED) &&
+      GetLayeredWindowAttributes(window->hwnd, nullptr, &alpha, &flags) &&
+      (flags & LWA_ALPHA)) {
+    opacity *= alpha / 255.0;
+  }
+  result->Success(flutter::EncodableValue(opacity));
 }
 
 void VisibilityService::DoReveal(
     const std::string* window_id,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  if (window_id) {
-    Reveal(*window_id);
-  }
+  // Stop waiting for the frame: uncloak now (Reveal runs via the listener).
+  auto* window = window_id ? WindowStore::Instance().Get(*window_id) : nullptr;
+  if (window) RevealPipeline::Instance().Finish(*window);
   result->Success(flutter::EncodableValue());
 }
 
@@ -14,16 +14,26 @@ class SnapService;
 
 class VisibilityService {
  public:
+  VisibilityService();
+  ~VisibilityService();
+
   void SetEventSink(EventSink sink) { event_sink_ = std::move(sink); }
-  void Handle(const std::string& command,
+  bool Handle(const std::string& command,
               const std::string* window_id,
               const flutter::EncodableMap& params,
               std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
 
   void SetSnapService(SnapService* service) { snap_service_ = service; }
 
+  /// A pending show finished: focus if requested and emit "shown".
   void Reveal(const std::string& window_id);
 
+  /// show / hide without a command, for native triggers (hotkeys). `warm`
+  /// uncloaks a keep-alive palette without waiting for a new frame (see
+  /// RevealPipeline::BeginWarm).
+  void ShowPalette(PaletteWindow& window, bool focus, bool warm);
+  void HidePalette(PaletteWindow& window);
+
  private:
   EventSink event_sink_;
   SnapService* snap_service_ = nullptr;
@@ -34,6 +44,8 @@ class VisibilityService {
   void Hide(const std::string* window_id,
             const flutter::EncodableMap& params,
             std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+  void IsVisible(const std::string* window_id,
+                 std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
   void SetOpacity(const std::string* window_id,
                   const flutter::EncodableMap& params,
                   std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
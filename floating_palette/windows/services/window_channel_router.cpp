@@ -1,17 +1,207 @@
 #include "window_channel_router.h"
 
+#include <flutter/method_channel.h>
+#include <flutter/standard_method_codec.h>
+
+#include <memory>
+
+#include "../coordinators/drag_coordinator.h"
 #include "../core/logger.h"
+#include "../core/param_utils.h"
+#include "background_capture_service.h"
+#include "message_service.h"
+#include "snap_service.h"
 
 namespace floating_palette {
 
-void WindowChannelRouter::SetupChannels(
-    flutter::PluginRegistrarWindows* registrar,
-    const std::string& window_id) {
-  // TODO: Set up per-palette channels once palette engines are implemented:
-  //   - floating_palette/entry     (forceResize, entry point config)
-  //   - floating_palette/messenger (host ↔ palette messaging)
-  //   - floating_palette/self      (palette → host self-commands)
-  FP_LOG("Plugin", "SetupChannels stub for " + window_id);
+namespace {
+
+// Platform thread only, like every channel handler.
+WindowChannelRouter::Services& CurrentServices() {
+  static WindowChannelRouter::Services services;
+  return services;
+}
+
+constexpr char kSelfChannel[] = "floating_palette/self";
+
+const flutter::EncodableMap& EmptyMap() {
+  static const flutter::EncodableMap empty;
+  return empty;
+}
+
+}  // namespace
+
+// static
+void WindowChannelRouter::SetServices(Services services) {
+  CurrentServices() = std::move(services);
+}
+
+void WindowChannelRouter::SetupChannels(PaletteWindow* window) {
+  if (!window || !window->registrar) return;
+
+  //   - floating_palette/entry (provides palette ID)
+  window->entry_channel =
+      std::make_unique<flutter::MethodChannel<flutter::EncodableValue>>(
+          window->registrar->messenger(), "floating_palette/entry",
+          &flutter::StandardMethodCodec::GetInstance());
+  window->entry_channel->SetMethodCallHandler(
+      [window](const auto& call, auto result) {
+        if (call.method_name() == "openChannel") {
+          const auto* name = std::get_if<std::string>(call.arguments());
+          if (name && *name == MessageService::kMessengerChannel) {
+            EnsureMessengerChannel(window);
+          } else if (name && *name == kSelfChannel) {
+            EnsureSelfChannel(window);
+          } else {
+            result->Error("INVALID_ARGS", "Unknown palette channel");
+            return;
+          }
+          result->Success(flutter::EncodableValue());
+          return;
+        }
+        if (call.method_name() != "getPaletteId") {
+          result->NotImplemented();
+          return;
+        }
+        if (window->id.empty()) {
+          // Warm pool engine: answer once the window is handed out.
+          window->pending_id_result = std::move(result);
+          return;
+        }
+        result->Success(flutter::EncodableValue(window->id));
+      });
+  FP_LOG("Plugin", "SetupChannels: entry channel ready");
+}
+
+// static
+void WindowChannelRouter::TeardownChannels(PaletteWindow* window) {
+  for (auto* channel : {&window->entry_channel, &window->messenger_channel,
+                        &window->self_channel}) {
+    if (*channel) (*channel)->SetMethodCallHandler(nullptr);
+    channel->reset();
+  }
+}
+
+//   - floating_palette/messenger (palette → host; host → palette `receive`
+//     calls are encoded by MessageService and sent on the same channel)
+// static
+void WindowChannelRouter::EnsureMessengerChannel(PaletteWindow* window) {
+  if (window->messenger_channel || !window->registrar) return;
+  FP_LOG("Plugin", "opening messenger channel");
+  window->messenger_channel =
+      std::make_unique<flutter::MethodChannel<flutter::EncodableValue>>(
+          window->registrar->messenger(), MessageService::kMessengerChannel,
+          &flutter::StandardMethodCodec::GetInstance());
+  window->messenger_channel->SetMethodCallHandler(
+      [window](const auto& call, auto result) {
+        if (window->id.empty()) {
+          result->Error("NOT_FOUND", "Palette has not been assigned an id");
+          return;
+        }
+        const std::string& id = window->id;
+        const Services& services = CurrentServices();
+        const auto* args =
+            std::get_if<flutter::EncodableMap>(call.arguments());
+        const flutter::EncodableMap& params = args ? *args : EmptyMap();
+        const std::string& method = call.method_name();
+
+        if (method == "send" || method == "notify") {
+          // Forwarded to the host by reference; the event queue takes the
+          // one copy it needs.
+          const std::string* type = GetString(params, "type");
+          const auto* data_value = FindParam(params, "data");
+          const auto* data =
+              data_value ? std::get_if<flutter::EncodableMap>(data_value)
+                         : nullptr;
+          if (type && services.event_sink) {
+            services.event_sink(method == "send" ? "message" : "event", *type,
+                                &id, data ? *data : EmptyMap());
+          }
+          result->Success(flutter::EncodableValue());
+        } else if (method == "requestHide") {
+          if (services.event_sink) {
+            services.event_sink("requestHide", "hide", &id, EmptyMap());
+          }
+          result->Success(flutter::EncodableValue());
+        } else if (method == "snap" || method == "setAutoSnapConfig" ||
+                   method == "detachSnap") {
+          if (!services.snap_service) {
+            result->Error("NOT_AVAILABLE", "Snap service not available");
+            return;
+          }
+          if (method == "detachSnap") {
+            services.snap_service->Handle(
+                "detach", &id,
+                flutter::EncodableMap{
+                    {flutter::EncodableValue("followerId"),
+                     flutter::EncodableValue(id)},
+                },
+                std::move(result));
+            return;
+          }
+          if (!args) {
+            result->Error("INVALID_ARGS", "Arguments required");
+            return;
+          }
+          services.snap_service->Handle(method, &id, params, std::move(result));
+        } else {
+          result->NotImplemented();
+        }
+      });
+}
+
+//   - floating_palette/self (palette → host commands about its own window)
+// static
+void WindowChannelRouter::EnsureSelfChannel(PaletteWindow* window) {
+  if (window->self_channel || !window->registrar) return;
+  FP_LOG("Plugin", "opening self channel");
+  window->self_channel =
+      std::make_unique<flutter::MethodChannel<flutter::EncodableValue>>(
+          window->registrar->messenger(), kSelfChannel,
+          &flutter::StandardMethodCodec::GetInstance());
+  window->self_channel->SetMethodCallHandler(
+      [window](const auto& call, auto result) {
+        if (window->id.empty()) {
+          result->Error("NOT_FOUND", "Palette has not been assigned an id");
+          return;
+        }
+        // Copied: a drag pumps messages, and the window may be destroyed
+        // before this handler returns.
+        const std::string id = window->id;
+        const Services& services = CurrentServices();
+        const auto* args =
+            std::get_if<flutter::EncodableMap>(call.arguments());
+        const flutter::EncodableMap& params = args ? *args : EmptyMap();
+        const std::string& method = call.method_name();
+
+        constexpr char kCapturePrefix[] = "backgroundCapture.";
+        constexpr size_t kCapturePrefixLength = sizeof(kCapturePrefix) - 1;
+
+        if (method == "startDrag") {
+          if (!services.drag_coordinator) {
+            result->Error("NOT_AVAILABLE", "Drag coordinator not available");
+            return;
+          }
+          // Answer first: the drag loop runs until the button is released.
+          DragCoordinator* coordinator = services.drag_coordinator;
+          result->Success(flutter::EncodableValue());
+          coordinator->StartDrag(id, window);
+        } else if (method.compare(0, kCapturePrefixLength, kCapturePrefix) ==
+                   0) {
+          // Capture started from the palette registers its texture on the
+          // palette's own engine (see BackgroundCaptureService::Start).
+          if (!services.background_capture_service) {
+            result->Error("NOT_AVAILABLE",
+                          "Background capture service not available");
+            return;
+          }
+          services.background_capture_service->Handle(
+              method.substr(kCapturePrefixLength), &id, params,
+              std::move(result));
+        } else {
+          result->NotImplemented();
+        }
+      });
 }
 
 }  // namespace floating_palette
@@ -4,20 +4,49 @@
 
 #include <string>
 
+#include "../core/window_store.h"
+
 namespace floating_palette {
 
+class BackgroundCaptureService;
+class DragCoordinator;
+class SnapService;
+
 /// Routes per-palette method channels (entry, messenger, self).
 ///
-/// Each palette window gets 3 channels:
+/// Each palette window has up to 3 channels:
 ///   - floating_palette/entry     (host → palette commands)
 ///   - floating_palette/messenger (host ↔ palette messaging)
 ///   - floating_palette/self      (palette → host self-commands)
 ///
-/// Not yet implemented — palette engines are not created on Windows.
+/// Only the entry channel is set up with the engine. The other two are
+/// opened on first use: by the palette through an entry `openChannel` call
+/// before its first call on them (PaletteChannel), or by the host through
+/// Ensure*Channel. Palettes that never message never register them.
 class WindowChannelRouter {
  public:
-  static void SetupChannels(flutter::PluginRegistrarWindows* registrar,
-                            const std::string& window_id);
+  /// Where palette-originated calls go. Set by the plugin once its
+  /// services exist and cleared before they are destroyed; channels read
+  /// it per call, so pool engines set up earlier pick it up too.
+  struct Services {
+    EventSink event_sink;
+    SnapService* snap_service = nullptr;
+    DragCoordinator* drag_coordinator = nullptr;
+    BackgroundCaptureService* background_capture_service = nullptr;
+  };
+  static void SetServices(Services services);
+
+  /// Set up channels on the palette engine's registrar. Called once per
+  /// engine, possibly before the window has been assigned an id (pool).
+  static void SetupChannels(PaletteWindow* window);
+
+  /// Open a channel if it isn't yet. No-op without a registrar.
+  static void EnsureMessengerChannel(PaletteWindow* window);
+  static void EnsureSelfChannel(PaletteWindow* window);
+
+  /// Unregister every channel's handler and drop the channels. Handlers
+  /// hold the window pointer, so this runs before the window is freed.
+  static void TeardownChannels(PaletteWindow* window);
 };
 
 }  // namespace floating_palette
@@ -1,28 +1,69 @@
 #include "window_service.h"
 
+#include <algorithm>
+#include <utility>
+
+#include "../coordinators/drag_coordinator.h"
+#include "../core/engine_pool.h"
+#include "../core/command_hash.h"
+#include "../core/engine_hibernation.h"
+#include "../core/glass_animation_driver.h"
+#include "../core/glass_backdrop.h"
+#include "../core/id_table.h"
 #include "../core/logger.h"
+#include "../core/message_ring.h"
+#include "../core/metrics.h"
+#include "../core/param_utils.h"
+#include "../core/reveal_pipeline.h"
+#include "../core/trace.h"
+#include "background_capture_service.h"
+#include "input_service.h"
+#include "snap_service.h"
 
 namespace floating_palette {
 
 WindowService::WindowService(flutter::PluginRegistrarWindows* registrar)
-    : registrar_(registrar) {}
+    : registrar_(registrar), engine_pool_(std::make_unique<EnginePool>()) {}
+
+WindowService::~WindowService() = default;
 
-void WindowService::Handle(
+bool WindowService::Handle(
     const std::string& command,
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  if (command == "create") {
-    Create(window_id, params, std::move(result));
-  } else if (command == "destroy") {
-    Destroy(window_id, params, std::move(result));
-  } else if (command == "exists") {
-    Exists(window_id, std::move(result));
-  } else if (command == "setEntryPoint") {
-    SetEntryPoint(window_id, params, std::move(result));
-  } else {
-    result->Error("UNKNOWN_COMMAND", "Unknown window command: " + command);
+  switch (HashCommand(command)) {
+    case HashCommand("create"):
+      if (command != "create") break;
+      Create(window_id, params, std::move(result));
+      return true;
+    case HashCommand("createMany"):
+      if (command != "createMany") break;
+      CreateMany(params, std::move(result));
+      return true;
+    case HashCommand("destroy"):
+      if (command != "destroy") break;
+      Destroy(window_id, params, std::move(result));
+      return true;
+    case HashCommand("destroyMany"):
+      if (command != "destroyMany") break;
+      DestroyMany(params, std::move(result));
+      return true;
+    case HashCommand("exists"):
+      if (command != "exists") break;
+      Exists(window_id, std::move(result));
+      return true;
+    case HashCommand("setEntryPoint"):
+      if (command != "setEntryPoint") break;
+      SetEntryPoint(window_id, params, std::move(result));
+      return true;
+    case HashCommand("configurePool"):
+      if (command != "configurePool") break;
+      ConfigurePool(params, std::move(result));
+      return true;
   }
+  result->Error("UNKNOWN_COMMAND", "Unknown window command: " + command);
+  return false;
 }
 
 void WindowService::Create(
@@ -37,9 +78,92 @@ void WindowService::Create(
     result->Error("ALREADY_EXISTS", "Window already exists: " + *window_id);
     return;
   }
-  // TODO: Create HWND, Flutter engine, register channels
-  FP_LOG("Window", "create stub: " + *window_id);
-  result->Success(flutter::EncodableValue());
+
+  auto window = StartWindow(*window_id, params);
+  if (!window) {
+    result->Error("ENGINE_FAILED", "Failed to start Flutter engine");
+    return;
+  }
+  RECT rect;
+  GetWindowRect(window->hwnd, &rect);
+  SetWindowPos(window->hwnd, nullptr, 0, 0, InitialWidth(*window, params),
+               rect.bottom - rect.top, kSizeFlags);
+  Metrics::Instance().RecordWindowPos();
+
+  RegisterWindow(window_id, std::move(window));
+  result->Success(flutter::EncodableValue(*window_id));
+}
+
+void WindowService::CreateMany(
+    const flutter::EncodableMap& params,
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  const auto* value = FindParam(params, "windows");
+  const auto* specs =
+      value ? std::get_if<flutter::EncodableList>(value) : nullptr;
+  if (!specs) {
+    result->Error("INVALID_PARAMS", "windows (list) required");
+    return;
+  }
+  std::vector<std::pair<const std::string*, const flutter::EncodableMap*>>
+      requested;
+  requested.reserve(specs->size());
+  for (const auto& entry : *specs) {
+    const auto* spec = std::get_if<flutter::EncodableMap>(&entry);
+    const std::string* id = spec ? GetString(*spec, "id") : nullptr;
+    if (!id) {
+      result->Error("INVALID_PARAMS", "Each window needs an id");
+      return;
+    }
+    requested.emplace_back(IdTable::Instance().Intern(*id), spec);
+  }
+
+  // Start every engine before touching any panel. Engines are created one
+  // after another on this thread, exactly as a loop of window/create calls
+  // would; what the batch saves is a channel round trip and a separate
+  // SetWindowPos per window, not engine startup time.
+  flutter::EncodableMap failed;
+  std::vector<std::pair<const std::string*, std::unique_ptr<PaletteWindow>>>
+      started;
+  std::vector<PanelUpdate> sizes;
+  for (const auto& [id, spec] : requested) {
+    bool duplicate = std::any_of(
+        started.begin(), started.end(),
+        [id = id](const auto& entry) { return entry.first == id; });
+    if (duplicate || WindowStore::Instance().Exists(*id)) {
+      failed.insert_or_assign(flutter::EncodableValue(*id),
+                              flutter::EncodableValue("ALREADY_EXISTS"));
+      continue;
+    }
+    auto window = StartWindow(*id, *spec);
+    if (!window) {
+      failed.insert_or_assign(flutter::EncodableValue(*id),
+                              flutter::EncodableValue("ENGINE_FAILED"));
+      continue;
+    }
+    RECT rect;
+    GetWindowRect(window->hwnd, &rect);
+    sizes.push_back({window->hwnd, InitialWidth(*window, *spec),
+                     rect.bottom - rect.top, kSizeFlags});
+    started.emplace_back(id, std::move(window));
+  }
+
+  // Size every panel in one transaction, then announce them together; the
+  // "created" events go out in the same EventQueue flush.
+  ApplyPanelUpdates(sizes);
+  flutter::EncodableList created;
+  created.reserve(started.size());
+  for (auto& [id, window] : started) {
+    RegisterWindow(id, std::move(window));
+    created.emplace_back(*id);
+  }
+  FP_LOG("Window", "createMany: ", created.size(), " created, ",
+         failed.size(), " failed");
+  result->Success(flutter::EncodableValue(flutter::EncodableMap{
+      {flutter::EncodableValue("created"),
+       flutter::EncodableValue(std::move(created))},
+      {flutter::EncodableValue("failed"),
+       flutter::EncodableValue(std::move(failed))},
+  }));
 }
 
 void WindowService::Destroy(
@@ -50,11 +174,155 @@ void WindowService::Destroy(
     result->Error("MISSING_ID", "windowId required");
     return;
   }
-  // TODO: Destroy window, engine, channels
-  FP_LOG("Window", "destroy stub: " + *window_id);
+  auto window = WindowStore::Instance().Remove(*window_id);
+  if (!window) {
+    result->Error("NOT_FOUND", "Window not found: " + *window_id);
+    return;
+  }
+  TearDown(window_id, std::move(window));
   result->Success(flutter::EncodableValue());
 }
 
+void WindowService::DestroyMany(
+    const flutter::EncodableMap& params,
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  const auto* value = FindParam(params, "ids");
+  const auto* ids =
+      value ? std::get_if<flutter::EncodableList>(value) : nullptr;
+  if (!ids) {
+    result->Error("INVALID_PARAMS", "ids (list) required");
+    return;
+  }
+  // Validate every entry before destroying anything, as createMany does. A
+  // repeated id is destroyed once, so it can't also come back NOT_FOUND.
+  std::vector<const std::string*> requested;
+  requested.reserve(ids->size());
+  for (const auto& entry : *ids) {
+    const auto* id = std::get_if<std::string>(&entry);
+    if (!id) {
+      result->Error("INVALID_PARAMS", "ids must be strings");
+      return;
+    }
+    bool duplicate = std::any_of(
+        requested.begin(), requested.end(),
+        [id](const std::string* seen) { return *seen == *id; });
+    if (!duplicate) requested.push_back(id);
+  }
+
+  flutter::EncodableList destroyed;
+  flutter::EncodableMap failed;
+  std::vector<std::pair<const std::string*, std::unique_ptr<PaletteWindow>>>
+      removed;
+  std::vector<PanelUpdate> hides;
+  for (const std::string* id : requested) {
+    auto window = WindowStore::Instance().Remove(*id);
+    if (!window) {
+      failed.insert_or_assign(flutter::EncodableValue(*id),
+                              flutter::EncodableValue("NOT_FOUND"));
+      continue;
+    }
+    hides.push_back({window->hwnd, 0, 0, kHideFlags});
+    removed.emplace_back(IdTable::Instance().Intern(*id), std::move(window));
+  }
+
+  // Hide the whole set at once: engine shutdown takes a while per window,
+  // and panels shouldn't vanish one by one while it runs.
+  ApplyPanelUpdates(hides);
+  for (auto& [id, window] : removed) {
+    TearDown(id, std::move(window));
+    destroyed.emplace_back(*id);
+  }
+  result->Success(flutter::EncodableValue(flutter::EncodableMap{
+      {flutter::EncodableValue("destroyed"),
+       flutter::EncodableValue(std::move(destroyed))},
+      {flutter::EncodableValue("failed"),
+       flutter::EncodableValue(std::move(failed))},
+  }));
+}
+
+std::unique_ptr<PaletteWindow> WindowService::StartWindow(
+    const std::string& id,
+    const flutter::EncodableMap& params) {
+  const auto* entry_point = GetString(params, "entryPoint");
+  auto window = engine_pool_->Acquire(
+      id, entry_point ? *entry_point : EnginePool::kDefaultEntryPoint);
+  if (!window) return nullptr;
+  window->keep_alive = GetBool(params, "keepAlive").value_or(false);
+  window->suspend_after_ms = static_cast<int>(
+      GetInt(params, "suspendAfterMs").value_or(window->suspend_after_ms));
+  return window;
+}
+
+// static
+int WindowService::InitialWidth(const PaletteWindow& window,
+                                const flutter::EncodableMap& params) {
+  // Height follows content via SizeReporter; only width is known up front.
+  double width = GetDouble(params, "width").value_or(400.0);
+  double scale = GetDpiForWindow(window.hwnd) / 96.0;
+  return static_cast<int>(width * scale);
+}
+
+// static
+void WindowService::ApplyPanelUpdates(
+    const std::vector<PanelUpdate>& updates) {
+  if (updates.empty()) return;
+  HDWP batch = BeginDeferWindowPos(static_cast<int>(updates.size()));
+  for (const PanelUpdate& update : updates) {
+    if (!batch) break;
+    batch = DeferWindowPos(batch, update.hwnd, nullptr, 0, 0, update.width,
+                           update.height, update.flags);
+  }
+  if (batch && EndDeferWindowPos(batch)) {
+    Metrics::Instance().RecordWindowPosBatch(updates.size());
+    return;
+  }
+
+  // A failed DeferWindowPos discards the batch; apply each update on its
+  // own so every panel still ends up right.
+  FP_LOG("Window", "DeferWindowPos failed; updating panels individually");
+  for (const PanelUpdate& update : updates) {
+    SetWindowPos(update.hwnd, nullptr, 0, 0, update.width, update.height,
+                 update.flags);
+    Metrics::Instance().RecordWindowPos();
+  }
+}
+
+void WindowService::RegisterWindow(const std::string* window_id,
+                                   std::unique_ptr<PaletteWindow> window) {
+  WindowHandle handle =
+      WindowStore::Instance().Store(*window_id, std::move(window));
+  trace::WindowCreated(*window_id, handle);
+  FP_LOG("Window", "created: ", *window_id);
+  if (event_sink_) {
+    event_sink_("window", "created", window_id, flutter::EncodableMap{});
+  }
+}
+
+void WindowService::TearDown(const std::string* window_id,
+                             std::unique_ptr<PaletteWindow> window) {
+  GlassAnimationDriver::Instance().DestroyAllBuffers(*window_id);
+  GlassBackdrop::Instance().Cleanup(*window_id);
+  if (background_capture_service_) {
+    background_capture_service_->Cleanup(*window_id);
+  }
+  if (drag_coordinator_) {
+    drag_coordinator_->WindowDestroyed(*window_id, window->hwnd);
+  }
+  if (snap_service_) snap_service_->OnWindowDestroyed(*window_id);
+  if (input_service_) input_service_->OnWindowDestroyed(*window);
+  RevealPipeline::Instance().Cancel(*window);
+  EngineHibernation::Instance().Forget(*window);
+  EnginePool::Release(std::move(window));
+  // The palette engine has shut down, so its ring ends are closed; rings
+  // the host still holds open are freed when it closes them.
+  MessageRings::Instance().DestroyAll(*window_id);
+  trace::WindowDestroyed(*window_id);
+  FP_LOG("Window", "destroyed: ", *window_id);
+  if (event_sink_) {
+    event_sink_("window", "destroyed", window_id, flutter::EncodableMap{});
+  }
+}
+
 void WindowService::Exists(
     const std::string* window_id,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
@@ -75,4 +343,16 @@ void WindowService::SetEntryPoint(
   result->Success(flutter::EncodableValue());
 }
 
+void WindowService::ConfigurePool(
+    const flutter::EncodableMap& params,
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  auto size = GetInt(params, "size");
+  if (!size || *size < 0) {
+    result->Error("INVALID_PARAMS", "size (non-negative int) required");
+    return;
+  }
+  engine_pool_->SetTargetSize(static_cast<size_t>(*size));
+  result->Success(flutter::EncodableValue());
+}
+
 }  // namespace floating_palette
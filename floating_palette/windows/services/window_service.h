@@ -1,11 +1,14 @@
 #pragma once
 
+#include <windows.h>
+
 #include <flutter/method_channel.h>
 #include <flutter/plugin_registrar_windows.h>
 #include <flutter/standard_method_codec.h>
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "../core/window_store.h"
 
@@ -13,16 +16,26 @@ namespace floating_palette {
 
 class BackgroundCaptureService;
 class DragCoordinator;
+class EnginePool;
 class FrameService;
 class InputService;
 class SnapService;
 
+/// Palette lifecycle: create, destroy and the engine pool.
+///
+/// `createMany` / `destroyMany` batch a whole workspace into one message.
+/// Engines and HWNDs can only be created on the platform thread, so a
+/// batch still starts its engines one at a time; it saves the per-window
+/// channel round trips and sizes (or hides) every panel in one
+/// DeferWindowPos transaction. A window that fails doesn't fail the batch;
+/// it's reported by id with its error code.
 class WindowService {
  public:
   explicit WindowService(flutter::PluginRegistrarWindows* registrar);
+  ~WindowService();
 
   void SetEventSink(EventSink sink) { event_sink_ = std::move(sink); }
-  void Handle(const std::string& command,
+  bool Handle(const std::string& command,
               const std::string* window_id,
               const flutter::EncodableMap& params,
               std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
@@ -45,18 +58,57 @@ class WindowService {
   SnapService* snap_service_ = nullptr;
   DragCoordinator* drag_coordinator_ = nullptr;
   InputService* input_service_ = nullptr;
+  std::unique_ptr<EnginePool> engine_pool_;
+
+  static constexpr UINT kSizeFlags =
+      SWP_NOMOVE | SWP_NOZORDER | SWP_NOACTIVATE;
+  static constexpr UINT kHideFlags =
+      SWP_HIDEWINDOW | SWP_NOMOVE | SWP_NOSIZE | SWP_NOZORDER |
+      SWP_NOACTIVATE;
+
+  /// One panel's SetWindowPos, applied as part of a batch.
+  struct PanelUpdate {
+    HWND hwnd;
+    int width;
+    int height;
+    UINT flags;
+  };
 
   void Create(const std::string* window_id,
               const flutter::EncodableMap& params,
               std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+  void CreateMany(const flutter::EncodableMap& params,
+                  std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
   void Destroy(const std::string* window_id,
                const flutter::EncodableMap& params,
                std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+  void DestroyMany(const flutter::EncodableMap& params,
+                   std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
   void Exists(const std::string* window_id,
               std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
   void SetEntryPoint(const std::string* window_id,
                      const flutter::EncodableMap& params,
                      std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+  void ConfigurePool(const flutter::EncodableMap& params,
+                     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+
+  /// Acquire an engine for `id` and apply the per-window options. Null if
+  /// the engine couldn't be started.
+  std::unique_ptr<PaletteWindow> StartWindow(
+      const std::string& id,
+      const flutter::EncodableMap& params);
+  /// The requested width in physical pixels at the panel's DPI.
+  static int InitialWidth(const PaletteWindow& window,
+                          const flutter::EncodableMap& params);
+  /// Apply `updates` in one DeferWindowPos batch, falling back to one
+  /// SetWindowPos each if the batch fails.
+  static void ApplyPanelUpdates(const std::vector<PanelUpdate>& updates);
+  /// Store a started window and announce it.
+  void RegisterWindow(const std::string* window_id,
+                      std::unique_ptr<PaletteWindow> window);
+  /// Release everything held for a removed window, then the window itself.
+  void TearDown(const std::string* window_id,
+                std::unique_ptr<PaletteWindow> window);
 };
 
 }  // namespace floating_palette
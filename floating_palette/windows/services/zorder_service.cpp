@@ -1,33 +1,208 @@
 #include "zorder_service.h"
 
+#include <algorithm>
+#include <climits>
+#include <unordered_set>
+
+#include "../core/command_hash.h"
 #include "../core/logger.h"
+#include "../core/metrics.h"
+#include "../core/palette_panel.h"
+#include "../core/param_utils.h"
+#include "../core/zorder_plan.h"
 
 namespace floating_palette {
 
-void ZOrderService::Handle(
+namespace {
+
+constexpr UINT kZOrderFlags = SWP_NOMOVE | SWP_NOSIZE | SWP_NOACTIVATE |
+                              SWP_NOOWNERZORDER;
+
+}  // namespace
+
+bool ZOrderService::Handle(
     const std::string& command,
     const std::string* window_id,
     const flutter::EncodableMap& params,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-  if (command == "bringToFront") {
-    BringToFront(window_id, std::move(result));
-  } else if (command == "sendToBack") {
-    SendToBack(window_id, std::move(result));
-  } else if (command == "moveAbove") {
-    MoveAbove(window_id, params, std::move(result));
-  } else if (command == "moveBelow") {
-    MoveBelow(window_id, params, std::move(result));
-  } else if (command == "setZIndex") {
-    SetZIndex(window_id, params, std::move(result));
-  } else if (command == "setLevel") {
-    SetLevel(window_id, params, std::move(result));
-  } else if (command == "pin") {
-    Pin(window_id, std::move(result));
-  } else if (command == "unpin") {
-    Unpin(window_id, std::move(result));
+  switch (HashCommand(command)) {
+    case HashCommand("bringToFront"):
+      if (command != "bringToFront") break;
+      BringToFront(window_id, std::move(result));
+      return true;
+    case HashCommand("sendToBack"):
+      if (command != "sendToBack") break;
+      SendToBack(window_id, std::move(result));
+      return true;
+    case HashCommand("moveAbove"):
+      if (command != "moveAbove") break;
+      MoveAbove(window_id, params, std::move(result));
+      return true;
+    case HashCommand("moveBelow"):
+      if (command != "moveBelow") break;
+      MoveBelow(window_id, params, std::move(result));
+      return true;
+    case HashCommand("setZIndex"):
+      if (command != "setZIndex") break;
+      SetZIndex(window_id, params, std::move(result));
+      return true;
+    case HashCommand("setLevel"):
+      if (command != "setLevel") break;
+      SetLevel(window_id, params, std::move(result));
+      return true;
+    case HashCommand("pin"):
+      if (command != "pin") break;
+      Pin(window_id, std::move(result));
+      return true;
+    case HashCommand("unpin"):
+      if (command != "unpin") break;
+      Unpin(window_id, std::move(result));
+      return true;
+    case HashCommand("apply"):
+      if (command != "apply") break;
+      Apply(params, std::move(result));
+      return true;
+  }
+  result->Error("UNKNOWN_COMMAND", "Unknown zorder command: " + command);
+  return false;
+}
+
+void ZOrderService::Apply(
+    const flutter::EncodableMap& params,
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  const auto* value = FindParam(params, "order");
+  const auto* order =
+      value ? std::get_if<flutter::EncodableList>(value) : nullptr;
+  if (!order) {
+    result->Error("INVALID_PARAMS", "order (list of ids) required");
+    return;
+  }
+
+  // Validate the whole stacking before moving anything.
+  std::vector<const std::string*> ids;
+  std::vector<HWND> desired;
+  std::unordered_set<HWND> seen;
+  ids.reserve(order->size());
+  desired.reserve(order->size());
+  for (const auto& entry : *order) {
+    const auto* id = std::get_if<std::string>(&entry);
+    if (!id) {
+      result->Error("INVALID_PARAMS", "order entries must be ids");
+      return;
+    }
+    PaletteWindow* window = WindowStore::Instance().Get(*id);
+    if (!window || !window->hwnd) {
+      result->Error("NOT_FOUND", "Window not found: " + *id);
+      return;
+    }
+    if (!seen.insert(window->hwnd).second) {
+      result->Error("INVALID_PARAMS", "Duplicate id in order: " + *id);
+      return;
+    }
+    ids.push_back(id);
+    desired.push_back(window->hwnd);
+  }
+
+  RefreshOrderCache();
+  std::vector<int> ranks;
+  ranks.reserve(desired.size());
+  HWND group_top = nullptr;
+  int group_top_rank = INT_MAX;
+  for (HWND hwnd : desired) {
+    auto it = cached_rank_.find(hwnd);
+    int rank = it != cached_rank_.end() ? it->second : -1;
+    ranks.push_back(rank);
+    if (rank >= 0 && rank < group_top_rank) {
+      group_top_rank = rank;
+      group_top = hwnd;
+    }
+  }
+
+  std::vector<ZOrderMove> moves = PlanZOrder(ranks);
+  if (moves.empty()) {
+    result->Success(flutter::EncodableValue(flutter::EncodableMap{
+        {flutter::EncodableValue("moved"), flutter::EncodableValue(0)},
+    }));
+    return;
+  }
+
+  // Above the group's current top: whatever sits directly over it. That is
+  // never a group member (see PlanZOrder).
+  auto insert_after = [&](const ZOrderMove& move) {
+    if (move.after != ZOrderMove::kGroupTop) return desired[move.after];
+    HWND above = group_top ? GetWindow(group_top, GW_HWNDPREV) : nullptr;
+    return above ? above : HWND_TOP;
+  };
+
+  // One transaction: DWM recomposes once for the whole reorder.
+  HDWP batch = BeginDeferWindowPos(static_cast<int>(moves.size()));
+  for (const ZOrderMove& move : moves) {
+    if (!batch) break;
+    batch = DeferWindowPos(batch, desired[move.window], insert_after(move), 0,
+                           0, 0, 0, kZOrderFlags);
+  }
+  if (batch && EndDeferWindowPos(batch)) {
+    Metrics::Instance().RecordWindowPosBatch(moves.size());
   } else {
-    result->Error("UNKNOWN_COMMAND", "Unknown zorder command: " + command);
+    // A failed DeferWindowPos discards the batch; the moves are still
+    // valid one at a time, in order.
+    FP_LOG("ZOrder", "DeferWindowPos failed; moving individually");
+    for (const ZOrderMove& move : moves) {
+      SetWindowPos(desired[move.window], insert_after(move), 0, 0, 0, 0,
+                   kZOrderFlags);
+      Metrics::Instance().RecordWindowPos();
+    }
+  }
+
+  // Keep the cache: replay the moves on it rather than walking the
+  // window list again next time.
+  for (const ZOrderMove& move : moves) {
+    HWND hwnd = desired[move.window];
+    cached_order_.erase(
+        std::find(cached_order_.begin(), cached_order_.end(), hwnd));
+    HWND anchor = move.after == ZOrderMove::kGroupTop ? group_top
+                                                      : desired[move.after];
+    auto at = std::find(cached_order_.begin(), cached_order_.end(), anchor);
+    if (move.after != ZOrderMove::kGroupTop && at != cached_order_.end()) {
+      ++at;
+    }
+    cached_order_.insert(at, hwnd);
+  }
+  cached_rank_.clear();
+  for (size_t i = 0; i < cached_order_.size(); ++i) {
+    cached_rank_[cached_order_[i]] = static_cast<int>(i);
+  }
+  cache_epoch_ = PalettePanel::ZOrderEpoch();
+
+  FP_LOG("ZOrder", "apply: ", moves.size(), " of ", desired.size(),
+         " moved");
+  if (event_sink_) {
+    for (const ZOrderMove& move : moves) {
+      event_sink_("zorder", "zOrderChanged", ids[move.window],
+                  flutter::EncodableMap{
+                      {flutter::EncodableValue("index"),
+                       flutter::EncodableValue(
+                           static_cast<int32_t>(move.window))},
+                  });
+    }
+  }
+  result->Success(flutter::EncodableValue(flutter::EncodableMap{
+      {flutter::EncodableValue("moved"),
+       flutter::EncodableValue(static_cast<int32_t>(moves.size()))},
+  }));
+}
+
+void ZOrderService::RefreshOrderCache() {
+  if (cache_epoch_ == PalettePanel::ZOrderEpoch()) return;
+  cached_order_.clear();
+  cached_rank_.clear();
+  for (HWND hwnd = GetTopWindow(nullptr); hwnd;
+       hwnd = GetWindow(hwnd, GW_HWNDNEXT)) {
+    if (!PalettePanel::FromHwnd(hwnd)) continue;
+    cached_rank_[hwnd] = static_cast<int>(cached_order_.size());
+    cached_order_.push_back(hwnd);
   }
+  cache_epoch_ = PalettePanel::ZOrderEpoch();
 }
 
 void ZOrderService::BringToFront(
@@ -3,17 +3,24 @@
 #include <flutter/method_channel.h>
 #include <flutter/standard_method_codec.h>
 
+#include <windows.h>
+
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "../core/window_store.h"
 
 namespace floating_palette {
 
+/// Window layering. `apply` takes a whole stacking (ids, top first) and
+/// reorders it with the fewest moves, in one DeferWindowPos batch.
 class ZOrderService {
  public:
   void SetEventSink(EventSink sink) { event_sink_ = std::move(sink); }
-  void Handle(const std::string& command,
+  bool Handle(const std::string& command,
               const std::string* window_id,
               const flutter::EncodableMap& params,
               std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
@@ -21,6 +28,16 @@ class ZOrderService {
  private:
   EventSink event_sink_;
 
+  /// Palette panels top to bottom, valid while `cache_epoch_` matches
+  /// PalettePanel::ZOrderEpoch.
+  std::vector<HWND> cached_order_;
+  std::unordered_map<HWND, int> cached_rank_;
+  uint64_t cache_epoch_ = UINT64_MAX;
+
+  void Apply(const flutter::EncodableMap& params,
+             std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+  void RefreshOrderCache();
+
   void BringToFront(const std::string* window_id,
                     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
   void SendToBack(const std::string* window_id,
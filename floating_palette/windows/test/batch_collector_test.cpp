@@ -0,0 +1,90 @@
+#include "core/batch_collector.h"
+
+#include <flutter/method_result_functions.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace floating_palette {
+namespace {
+
+using Result = flutter::MethodResult<flutter::EncodableValue>;
+
+/// A batch of `count` commands whose answer lands in `*reply`.
+std::shared_ptr<BatchCollector> MakeBatch(
+    size_t count,
+    std::optional<flutter::EncodableList>* reply) {
+  return std::make_shared<BatchCollector>(
+      count,
+      std::make_unique<flutter::MethodResultFunctions<flutter::EncodableValue>>(
+          [reply](const flutter::EncodableValue* value) {
+            *reply = std::get<flutter::EncodableList>(*value);
+          },
+          nullptr, nullptr));
+}
+
+const flutter::EncodableValue& Field(const flutter::EncodableValue& entry,
+                                     const char* key) {
+  return std::get<flutter::EncodableMap>(entry).at(
+      flutter::EncodableValue(key));
+}
+
+/// Answers every command it's handed.
+void ReplyingHandler(std::unique_ptr<Result> result) {
+  result->Success(flutter::EncodableValue(42));
+}
+
+/// Returns early without answering, as a handler with a forgotten reply
+/// on some path would.
+void DroppingHandler(std::unique_ptr<Result>) {}
+
+TEST(BatchCollectorTest, AnswersOnceEveryCommandReplied) {
+  std::optional<flutter::EncodableList> reply;
+  auto batch = MakeBatch(2, &reply);
+
+  ReplyingHandler(BatchCollector::Slot(batch, 0));
+  EXPECT_FALSE(reply);
+  BatchCollector::Slot(batch, 1)->Error("NOT_FOUND", "Window not found");
+
+  ASSERT_TRUE(reply);
+  ASSERT_EQ(reply->size(), 2u);
+  EXPECT_EQ(Field((*reply)[0], "ok"), flutter::EncodableValue(true));
+  EXPECT_EQ(Field((*reply)[0], "value"), flutter::EncodableValue(42));
+  EXPECT_EQ(Field((*reply)[1], "ok"), flutter::EncodableValue(false));
+  EXPECT_EQ(Field((*reply)[1], "code"), flutter::EncodableValue("NOT_FOUND"));
+}
+
+TEST(BatchCollectorTest, DroppedResultReportsNoReply) {
+  std::optional<flutter::EncodableList> reply;
+  auto batch = MakeBatch(2, &reply);
+
+  ReplyingHandler(BatchCollector::Slot(batch, 0));
+  DroppingHandler(BatchCollector::Slot(batch, 1));
+
+  ASSERT_TRUE(reply);
+  EXPECT_EQ(Field((*reply)[0], "ok"), flutter::EncodableValue(true));
+  EXPECT_EQ(Field((*reply)[1], "ok"), flutter::EncodableValue(false));
+  EXPECT_EQ(Field((*reply)[1], "code"), flutter::EncodableValue("NO_REPLY"));
+}
+
+TEST(BatchCollectorTest, DeferredReplyCompletesLater) {
+  std::optional<flutter::EncodableList> reply;
+  auto batch = MakeBatch(2, &reply);
+
+  std::unique_ptr<Result> deferred = BatchCollector::Slot(batch, 0);
+  ReplyingHandler(BatchCollector::Slot(batch, 1));
+  EXPECT_FALSE(reply);
+
+  deferred->Success(flutter::EncodableValue("later"));
+  ASSERT_TRUE(reply);
+  EXPECT_EQ(Field((*reply)[0], "value"), flutter::EncodableValue("later"));
+
+  // Destroying a slot that already replied adds nothing.
+  deferred.reset();
+  EXPECT_EQ(reply->size(), 2u);
+}
+
+}  // namespace
+}  // namespace floating_palette
@@ -0,0 +1,84 @@
+#include "core/event_queue.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/id_table.h"
+
+namespace floating_palette {
+namespace {
+
+/// "<event>:<x>" for each delivered event, in delivery order.
+std::vector<std::string> Describe(const flutter::EncodableList& events) {
+  std::vector<std::string> out;
+  for (const auto& event : events) {
+    const auto& args = std::get<flutter::EncodableMap>(event);
+    const auto& data = std::get<flutter::EncodableMap>(
+        args.at(flutter::EncodableValue("data")));
+    out.push_back(
+        std::get<std::string>(args.at(flutter::EncodableValue("event"))) +
+        ":" + std::to_string(std::get<int32_t>(data.at(
+                  flutter::EncodableValue("x")))));
+  }
+  return out;
+}
+
+flutter::EncodableMap Data(int32_t x) {
+  return {{flutter::EncodableValue("x"), flutter::EncodableValue(x)}};
+}
+
+class EventQueueTest : public ::testing::Test {
+ protected:
+  EventQueueTest()
+      : queue_([this](flutter::EncodableList events) {
+          delivered_.push_back(std::move(events));
+        }),
+        id_(IdTable::Instance().Intern("event-queue-test")) {}
+
+  std::vector<flutter::EncodableList> delivered_;
+  EventQueue queue_;
+  const std::string* id_;
+};
+
+TEST_F(EventQueueTest, CoalescedEventKeepsEmissionOrder) {
+  queue_.Push("frame", "moved", id_, Data(1));
+  queue_.Push("frame", "resized", id_, Data(2));
+  queue_.Push("frame", "moved", id_, Data(3));
+  EXPECT_EQ(queue_.pending_count(), 2u);
+  EXPECT_EQ(queue_.coalesced_count(), 1u);
+
+  queue_.Flush();
+  ASSERT_EQ(delivered_.size(), 1u);
+  EXPECT_EQ(Describe(delivered_[0]),
+            (std::vector<std::string>{"resized:2", "moved:3"}));
+}
+
+TEST_F(EventQueueTest, BarrierStopsCoalescing) {
+  queue_.Push("frame", "moved", id_, Data(1));
+  queue_.Push("visibility", "shown", id_, Data(2));
+  queue_.Push("frame", "moved", id_, Data(3));
+
+  queue_.Flush();
+  ASSERT_EQ(delivered_.size(), 1u);
+  EXPECT_EQ(Describe(delivered_[0]),
+            (std::vector<std::string>{"moved:1", "shown:2", "moved:3"}));
+  EXPECT_EQ(queue_.coalesced_count(), 0u);
+}
+
+TEST_F(EventQueueTest, CoalescesPerWindow) {
+  const std::string* other = IdTable::Instance().Intern("event-queue-other");
+  queue_.Push("frame", "moved", id_, Data(1));
+  queue_.Push("frame", "moved", other, Data(2));
+  queue_.Push("frame", "moved", id_, Data(3));
+
+  queue_.Flush();
+  ASSERT_EQ(delivered_.size(), 1u);
+  EXPECT_EQ(Describe(delivered_[0]),
+            (std::vector<std::string>{"moved:2", "moved:3"}));
+}
+
+}  // namespace
+}  // namespace floating_palette
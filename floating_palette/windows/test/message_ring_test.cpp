@@ -0,0 +1,242 @@
+#include "core/message_ring.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace floating_palette {
+namespace {
+
+/// A record whose header and payload fill exactly `bytes` of the ring.
+constexpr uint32_t PayloadFilling(uint32_t bytes) { return bytes - 4; }
+
+std::vector<uint8_t> Message(uint32_t length, uint8_t seed) {
+  std::vector<uint8_t> message(length);
+  for (uint32_t i = 0; i < length; ++i) {
+    message[i] = static_cast<uint8_t>(seed + i);
+  }
+  return message;
+}
+
+MessageRingWriteResult Write(MessageRing& ring,
+                             const std::vector<uint8_t>& message) {
+  return ring.Write(message.data(), static_cast<uint32_t>(message.size()));
+}
+
+/// Read's result and, on kOk, the message it returned.
+struct ReadResult {
+  MessageRingReadResult result;
+  std::vector<uint8_t> message;
+};
+
+ReadResult Read(MessageRing& ring, uint32_t capacity = 64 * 1024) {
+  std::vector<uint8_t> buffer(capacity);
+  uint32_t length = 0;
+  MessageRingReadResult result = ring.Read(buffer.data(), capacity, &length);
+  buffer.resize(result == MessageRingReadResult::kOk ? length : 0);
+  return {result, std::move(buffer)};
+}
+
+TEST(MessageRingTest, KeepsOrderAcrossTheWrapMarker) {
+  MessageRing ring(MessageRing::kMinCapacity);
+  ASSERT_EQ(ring.capacity(), 4096u);
+
+  // Three 1 KiB records fill the ring to 3 KiB. The next, larger record
+  // doesn't fit in the last 1 KiB, so it follows a wrap marker at offset 0.
+  const uint32_t length = PayloadFilling(1024);
+  for (uint8_t seed = 0; seed < 3; ++seed) {
+    ASSERT_EQ(Write(ring, Message(length, seed)), MessageRingWriteResult::kOk);
+  }
+  for (uint8_t seed = 0; seed < 3; ++seed) {
+    EXPECT_EQ(Read(ring).message, Message(length, seed));
+  }
+  for (uint8_t seed = 3; seed < 5; ++seed) {
+    ASSERT_EQ(Write(ring, Message(length + 100, seed)),
+              MessageRingWriteResult::kOk);
+  }
+  for (uint8_t seed = 3; seed < 5; ++seed) {
+    ReadResult read = Read(ring);
+    ASSERT_EQ(read.result, MessageRingReadResult::kOk);
+    EXPECT_EQ(read.message, Message(length + 100, seed));
+  }
+  EXPECT_EQ(Read(ring).result, MessageRingReadResult::kEmpty);
+}
+
+TEST(MessageRingTest, ReportsOverflowWhenFull) {
+  MessageRing ring(MessageRing::kMinCapacity);
+  const std::vector<uint8_t> quarter = Message(PayloadFilling(1024), 0);
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_EQ(Write(ring, quarter), MessageRingWriteResult::kOk);
+  }
+  EXPECT_EQ(Write(ring, Message(1, 0)), MessageRingWriteResult::kOverflowed);
+  EXPECT_EQ(ring.GetStats().overflowed, 1u);
+
+  // Reading one record frees exactly its space.
+  ASSERT_EQ(Read(ring).result, MessageRingReadResult::kOk);
+  EXPECT_EQ(Write(ring, quarter), MessageRingWriteResult::kOk);
+  EXPECT_EQ(ring.GetStats().sent, 5u);
+}
+
+TEST(MessageRingTest, DropsMessagesLargerThanTheRing) {
+  MessageRing ring(MessageRing::kMinCapacity);
+  EXPECT_EQ(Write(ring, Message(PayloadFilling(4096) + 1, 0)),
+            MessageRingWriteResult::kDropped);
+  EXPECT_EQ(ring.GetStats().dropped, 1u);
+  EXPECT_EQ(Read(ring).result, MessageRingReadResult::kEmpty);
+
+  // The largest record that fits still goes through.
+  EXPECT_EQ(Write(ring, Message(PayloadFilling(4096), 7)),
+            MessageRingWriteResult::kOk);
+  EXPECT_EQ(Read(ring).message, Message(PayloadFilling(4096), 7));
+}
+
+TEST(MessageRingTest, TooSmallBufferLeavesTheMessageQueued) {
+  MessageRing ring(MessageRing::kMinCapacity);
+  ASSERT_EQ(Write(ring, Message(100, 1)), MessageRingWriteResult::kOk);
+
+  uint8_t small[10];
+  uint32_t length = 0;
+  EXPECT_EQ(ring.Read(small, sizeof(small), &length),
+            MessageRingReadResult::kTooSmall);
+  EXPECT_EQ(length, 100u);
+  EXPECT_EQ(ring.GetStats().received, 0u);
+
+  EXPECT_EQ(Read(ring).message, Message(100, 1));
+  EXPECT_EQ(ring.GetStats().received, 1u);
+}
+
+TEST(MessageRingTest, CarriesZeroLengthMessages) {
+  MessageRing ring(MessageRing::kMinCapacity);
+  ASSERT_EQ(ring.Write(nullptr, 0), MessageRingWriteResult::kOk);
+  ASSERT_EQ(Write(ring, Message(3, 9)), MessageRingWriteResult::kOk);
+
+  uint32_t length = 1;
+  EXPECT_EQ(ring.Read(nullptr, 0, &length), MessageRingReadResult::kOk);
+  EXPECT_EQ(length, 0u);
+  EXPECT_EQ(Read(ring).message, Message(3, 9));
+  EXPECT_EQ(Read(ring).result, MessageRingReadResult::kEmpty);
+}
+
+std::atomic<int> doorbell_rings{0};
+void CountDoorbell() { doorbell_rings.fetch_add(1); }
+
+TEST(MessageRingTest, DoorbellRingsOncePerBurstAfterAnEmptyRead) {
+  doorbell_rings = 0;
+  MessageRing ring(MessageRing::kMinCapacity);
+  ring.SetDoorbell(&CountDoorbell);
+
+  // Not armed until the consumer has found the ring empty.
+  ASSERT_EQ(Write(ring, Message(8, 0)), MessageRingWriteResult::kOk);
+  EXPECT_EQ(doorbell_rings, 0);
+  ASSERT_EQ(Read(ring).result, MessageRingReadResult::kOk);
+  ASSERT_EQ(Read(ring).result, MessageRingReadResult::kEmpty);
+
+  for (uint8_t seed = 0; seed < 5; ++seed) {
+    ASSERT_EQ(Write(ring, Message(8, seed)), MessageRingWriteResult::kOk);
+  }
+  EXPECT_EQ(doorbell_rings, 1);
+
+  // Draining to empty re-arms it for the next burst.
+  while (Read(ring).result == MessageRingReadResult::kOk) {
+  }
+  for (uint8_t seed = 0; seed < 5; ++seed) {
+    ASSERT_EQ(Write(ring, Message(8, seed)), MessageRingWriteResult::kOk);
+  }
+  EXPECT_EQ(doorbell_rings, 2);
+
+  ring.SetDoorbell(nullptr);
+  while (Read(ring).result == MessageRingReadResult::kOk) {
+  }
+  ASSERT_EQ(Write(ring, Message(8, 0)), MessageRingWriteResult::kOk);
+  EXPECT_EQ(doorbell_rings, 2);
+}
+
+TEST(MessageRingTest, TwoThreadsDeliverEveryMessageInOrder) {
+  constexpr uint32_t kMessages = 200000;
+  MessageRing ring(MessageRing::kMinCapacity);
+
+  // Each message starts with its sequence number; lengths vary so records
+  // land on every 8-byte offset and the wrap marker is crossed many times.
+  auto length_of = [](uint32_t sequence) { return (sequence * 37) % 301; };
+
+  std::thread producer([&] {
+    std::vector<uint8_t> message;
+    for (uint32_t sequence = 0; sequence < kMessages;) {
+      uint32_t length = length_of(sequence) + 4;
+      message = Message(length, static_cast<uint8_t>(sequence));
+      std::memcpy(message.data(), &sequence, sizeof(sequence));
+      MessageRingWriteResult result = Write(ring, message);
+      if (result == MessageRingWriteResult::kOk) {
+        ++sequence;
+      } else {
+        ASSERT_EQ(result, MessageRingWriteResult::kOverflowed);
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  std::vector<uint8_t> buffer(1024);
+  uint32_t expected = 0;
+  while (expected < kMessages) {
+    uint32_t length = 0;
+    MessageRingReadResult result =
+        ring.Read(buffer.data(), static_cast<uint32_t>(buffer.size()),
+                  &length);
+    if (result == MessageRingReadResult::kEmpty) {
+      std::this_thread::yield();
+      continue;
+    }
+    ASSERT_EQ(result, MessageRingReadResult::kOk);
+    std::vector<uint8_t> want = Message(length_of(expected) + 4,
+                                        static_cast<uint8_t>(expected));
+    std::memcpy(want.data(), &expected, sizeof(expected));
+    ASSERT_EQ(std::vector<uint8_t>(buffer.begin(), buffer.begin() + length),
+              want)
+        << "message " << expected;
+    ++expected;
+  }
+  producer.join();
+
+  MessageRing::Stats stats = ring.GetStats();
+  EXPECT_EQ(stats.sent, kMessages);
+  EXPECT_EQ(stats.received, kMessages);
+  EXPECT_EQ(stats.dropped, 0u);
+}
+
+TEST(MessageRingsTest, FreesARingOnlyAfterBothEndsCloseAndItIsDestroyed) {
+  MessageRings& rings = MessageRings::Instance();
+  const size_t before = rings.ring_count();
+
+  MessageRing* host = rings.Open("message-ring-test", 0, 4096);
+  MessageRing* palette = rings.Open("message-ring-test", 0, 1 << 20);
+  ASSERT_EQ(host, palette);
+  EXPECT_EQ(palette->capacity(), 4096u);
+
+  // Destroyed while open: still valid for both ends, but a new Open gets a
+  // fresh ring.
+  rings.DestroyAll("message-ring-test");
+  EXPECT_EQ(rings.ring_count(), before + 1);
+  EXPECT_EQ(Write(*host, Message(8, 1)), MessageRingWriteResult::kOk);
+  EXPECT_EQ(Read(*palette).message, Message(8, 1));
+  MessageRing* fresh = rings.Open("message-ring-test", 0, 4096);
+  EXPECT_NE(fresh, host);
+
+  rings.Close(palette);
+  EXPECT_EQ(rings.ring_count(), before + 2);
+  rings.Close(host);
+  EXPECT_EQ(rings.ring_count(), before + 1);
+
+  // Closing every end of a live ring keeps it until it is destroyed.
+  rings.Close(fresh);
+  EXPECT_EQ(rings.ring_count(), before + 1);
+  rings.Destroy("message-ring-test", 0);
+  EXPECT_EQ(rings.ring_count(), before);
+}
+
+}  // namespace
+}  // namespace floating_palette
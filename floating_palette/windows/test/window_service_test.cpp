@@ -0,0 +1,105 @@
+#include "services/window_service.h"
+
+#include <flutter/method_result_functions.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "core/window_store.h"
+
+namespace floating_palette {
+namespace {
+
+/// What a command answered: the success value or the error code.
+struct Reply {
+  std::optional<flutter::EncodableValue> value;
+  std::string error;
+};
+
+std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> Capture(
+    Reply* reply) {
+  return std::make_unique<
+      flutter::MethodResultFunctions<flutter::EncodableValue>>(
+      [reply](const flutter::EncodableValue* value) {
+        reply->value = value ? *value : flutter::EncodableValue();
+      },
+      [reply](const std::string& code, const std::string&,
+              const flutter::EncodableValue*) { reply->error = code; },
+      nullptr);
+}
+
+const flutter::EncodableValue& Field(const flutter::EncodableValue& value,
+                                     const char* key) {
+  return std::get<flutter::EncodableMap>(value).at(
+      flutter::EncodableValue(key));
+}
+
+flutter::EncodableMap Ids(flutter::EncodableList ids) {
+  return {{flutter::EncodableValue("ids"),
+           flutter::EncodableValue(std::move(ids))}};
+}
+
+/// A stored palette with a plain hidden window and no engine, which
+/// destroy tears down like any other.
+void StoreWindow(const std::string& id) {
+  auto window = std::make_unique<PaletteWindow>();
+  window->id = id;
+  window->hwnd = CreateWindowExW(WS_EX_TOOLWINDOW, L"STATIC", L"", WS_POPUP,
+                                 0, 0, 200, 140, nullptr, nullptr,
+                                 GetModuleHandle(nullptr), nullptr);
+  WindowStore::Instance().Store(id, std::move(window));
+}
+
+TEST(WindowServiceTest, DestroyManyDestroysRepeatedIdOnce) {
+  WindowService service(nullptr);
+  StoreWindow("destroy-many-a");
+  StoreWindow("destroy-many-b");
+
+  Reply reply;
+  service.Handle("destroyMany", nullptr,
+                 Ids({flutter::EncodableValue("destroy-many-a"),
+                      flutter::EncodableValue("destroy-many-a"),
+                      flutter::EncodableValue("destroy-many-b"),
+                      flutter::EncodableValue("destroy-many-missing")}),
+                 Capture(&reply));
+
+  ASSERT_TRUE(reply.value);
+  EXPECT_EQ(Field(*reply.value, "destroyed"),
+            flutter::EncodableValue(flutter::EncodableList{
+                flutter::EncodableValue("destroy-many-a"),
+                flutter::EncodableValue("destroy-many-b"),
+            }));
+  EXPECT_EQ(Field(*reply.value, "failed"),
+            flutter::EncodableValue(flutter::EncodableMap{
+                {flutter::EncodableValue("destroy-many-missing"),
+                 flutter::EncodableValue("NOT_FOUND")},
+            }));
+  EXPECT_FALSE(WindowStore::Instance().Exists("destroy-many-a"));
+  EXPECT_FALSE(WindowStore::Instance().Exists("destroy-many-b"));
+}
+
+TEST(WindowServiceTest, DestroyManyRejectsNonStringIdsUpFront) {
+  WindowService service(nullptr);
+  StoreWindow("destroy-many-kept");
+
+  Reply reply;
+  service.Handle("destroyMany", nullptr,
+                 Ids({flutter::EncodableValue("destroy-many-kept"),
+                      flutter::EncodableValue(7)}),
+                 Capture(&reply));
+
+  EXPECT_FALSE(reply.value);
+  EXPECT_EQ(reply.error, "INVALID_PARAMS");
+  // Nothing was destroyed before the bad entry was seen.
+  EXPECT_TRUE(WindowStore::Instance().Exists("destroy-many-kept"));
+
+  Reply cleanup;
+  service.Handle("destroyMany", nullptr,
+                 Ids({flutter::EncodableValue("destroy-many-kept")}),
+                 Capture(&cleanup));
+}
+
+}  // namespace
+}  // namespace floating_palette